@@ -40,6 +40,8 @@
 #define PORTAB_SD1                  SD1
 #define PORTAB_SDCD1                SDCD1
 
+#define PORTAB_CHFS_SECTORS         5U
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
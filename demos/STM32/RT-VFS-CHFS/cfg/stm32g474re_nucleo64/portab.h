@@ -39,6 +39,8 @@
 #define PORTAB_SD1                  LPSD1
 #define PORTAB_SPI1                 SPID2
 
+#define PORTAB_CHFS_SECTORS         64U
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
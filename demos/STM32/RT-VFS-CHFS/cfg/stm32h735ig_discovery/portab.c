@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #include "portab.h"
@@ -30,10 +32,19 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#define RAMFLASH_SIZE   (PORTAB_CHFS_SECTORS * PORTAB_CHFS_SECTOR_SIZE)
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
 
+static const struct BaseFlashVMT ramflash_vmt;
+
+/**
+ * @brief   RAM flash emulation hosting the ChibiFS volume.
+ */
+BaseFlash portab_ramflash = {&ramflash_vmt, FLASH_READY};
+
 /*===========================================================================*/
 /* Module local types.                                                       */
 /*===========================================================================*/
@@ -42,16 +53,146 @@
 /* Module local variables.                                                   */
 /*===========================================================================*/
 
+static uint8_t ramflash_area[RAMFLASH_SIZE];
+
+static const flash_descriptor_t ramflash_descriptor = {
+  .attributes       = FLASH_ATTR_ERASED_IS_ONE,
+  .page_size        = 4U,
+  .sectors_count    = PORTAB_CHFS_SECTORS,
+  .sectors          = NULL,
+  .sectors_size     = PORTAB_CHFS_SECTOR_SIZE,
+  .address          = NULL,
+  .size             = RAMFLASH_SIZE
+};
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+static const flash_descriptor_t *ramflash_get_descriptor(void *instance) {
+
+  (void)instance;
+
+  return &ramflash_descriptor;
+}
+
+static flash_error_t ramflash_read(void *instance, flash_offset_t offset,
+                                   size_t n, uint8_t *rp) {
+
+  (void)instance;
+
+  if ((offset > RAMFLASH_SIZE) || (n > RAMFLASH_SIZE - offset)) {
+    return FLASH_ERROR_READ;
+  }
+  memcpy(rp, &ramflash_area[offset], n);
+
+  return FLASH_NO_ERROR;
+}
+
+/*
+ * Programming can only clear bits, like on a real flash.
+ */
+static flash_error_t ramflash_program(void *instance, flash_offset_t offset,
+                                      size_t n, const uint8_t *pp) {
+
+  (void)instance;
+
+  if ((offset > RAMFLASH_SIZE) || (n > RAMFLASH_SIZE - offset)) {
+    return FLASH_ERROR_PROGRAM;
+  }
+  while (n > 0U) {
+    ramflash_area[offset++] &= *pp++;
+    n--;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t ramflash_start_erase_all(void *instance) {
+
+  (void)instance;
+
+  memset(ramflash_area, 0xFF, RAMFLASH_SIZE);
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t ramflash_start_erase_sector(void *instance,
+                                                 flash_sector_t sector) {
+
+  (void)instance;
+
+  if (sector >= PORTAB_CHFS_SECTORS) {
+    return FLASH_ERROR_ERASE;
+  }
+  memset(&ramflash_area[sector * PORTAB_CHFS_SECTOR_SIZE], 0xFF,
+         PORTAB_CHFS_SECTOR_SIZE);
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t ramflash_query_erase(void *instance, uint32_t *msec) {
+
+  (void)instance;
+
+  if (msec != NULL) {
+    *msec = 0U;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t ramflash_verify_erase(void *instance,
+                                           flash_sector_t sector) {
+  const uint8_t *p;
+  size_t i;
+
+  (void)instance;
+
+  p = &ramflash_area[sector * PORTAB_CHFS_SECTOR_SIZE];
+  for (i = 0U; i < PORTAB_CHFS_SECTOR_SIZE; i++) {
+    if (p[i] != 0xFFU) {
+      return FLASH_ERROR_VERIFY;
+    }
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t ramflash_acquire_exclusive(void *instance) {
+
+  (void)instance;
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t ramflash_release_exclusive(void *instance) {
+
+  (void)instance;
+
+  return FLASH_NO_ERROR;
+}
+
+static const struct BaseFlashVMT ramflash_vmt = {
+  (size_t)0,
+  ramflash_get_descriptor,
+  ramflash_read,
+  ramflash_program,
+  ramflash_start_erase_all,
+  ramflash_start_erase_sector,
+  ramflash_query_erase,
+  ramflash_verify_erase,
+  ramflash_acquire_exclusive,
+  ramflash_release_exclusive
+};
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
 
 void portab_setup(void) {
 
+  memset(ramflash_area, 0xFF, RAMFLASH_SIZE);
 }
 
 /** @} */
@@ -40,6 +40,12 @@
 #define PORTAB_SD1                  SD3
 #define PORTAB_SDCD1                SDCD1
 
+/* There is no EFL driver for this device, the ChibiFS volume is placed on
+   a RAM flash emulation and it is formatted on each boot.*/
+#define PORTAB_CHFS_FLASH           (&portab_ramflash)
+#define PORTAB_CHFS_SECTORS         16U
+#define PORTAB_CHFS_SECTOR_SIZE     4096U
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -60,6 +66,8 @@
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+extern BaseFlash portab_ramflash;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -40,6 +40,8 @@
 #define PORTAB_SD1                  SD2
 #define PORTAB_SDCD1                SDCD1
 
+#define PORTAB_CHFS_SECTORS         64U
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
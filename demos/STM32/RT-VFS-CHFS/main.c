@@ -27,76 +27,17 @@
 #include "portab.h"
 
 /*===========================================================================*/
-/* Card insertion monitor.                                                   */
+/* Flash related.                                                            */
 /*===========================================================================*/
 
 /* FS mounted and ready.*/
 static bool fs_ready = false;
 
-/**
- * @brief   Card event sources.
- */
-static event_source_t inserted_event, removed_event;
-
-#define POLLING_INTERVAL                10
-#define POLLING_DELAY                   10
-
-/**
- * @brief   Card monitor timer.
- */
-static virtual_timer_t tmr;
-
-/**
- * @brief   Debounce counter.
- */
-static unsigned cnt;
-
-/**
- * @brief   Insertion monitor timer callback function.
- *
- * @param[in] p         pointer to the @p BaseBlockDevice object
- *
- * @notapi
- */
-static void tmrfunc(virtual_timer_t *vtp, void *p) {
-  BaseBlockDevice *bbdp = p;
-
-  chSysLockFromISR();
-  if (cnt > 0) {
-    if (blkIsInserted(bbdp)) {
-      if (--cnt == 0) {
-        chEvtBroadcastI(&inserted_event);
-      }
-    }
-    else
-      cnt = POLLING_INTERVAL;
-  }
-  else {
-    if (!blkIsInserted(bbdp)) {
-      cnt = POLLING_INTERVAL;
-      chEvtBroadcastI(&removed_event);
-    }
-  }
-  chVTSetI(vtp, TIME_MS2I(POLLING_DELAY), tmrfunc, bbdp);
-  chSysUnlockFromISR();
-}
-
-/**
- * @brief   Polling monitor start.
- *
- * @param[in] p         pointer to an object implementing @p BaseBlockDevice
- *
- * @notapi
- */
-static void tmr_init(void *p) {
-
-  chEvtObjectInit(&inserted_event);
-  chEvtObjectInit(&removed_event);
-  chSysLock();
-  cnt = POLLING_INTERVAL;
-  chVTSetI(&tmr, TIME_MS2I(POLLING_DELAY), tmrfunc, p);
-  chSysUnlock();
-}
+/* ChibiFS configuration, the volume is placed on the last sectors of the
+   internal flash, the base sector depends on the flash banks setup and is
+   computed at runtime. Boards without an EFL driver provide a flash device
+   through PORTAB_CHFS_FLASH instead.*/
+static chfs_config_t chfscfg;
 
 /*===========================================================================*/
 /* VFS related.                                                              */
@@ -151,59 +92,6 @@ static xshell_manager_t sm1;
 
 static xshell_t *xshp = NULL;
 
-#if !HAL_USE_SDC
-static uint8_t __nocache_mmcbuf[MMC_BUFFER_SIZE];
-mmc_spi_driver_t MMCD1;
-
-/* MMC/SD over SPI driver configuration.*/
-static MMCConfig mmccfg = {&PORTAB_SPI1, &ls_spicfg, &hs_spicfg};
-#endif
-
-/*
- * Card insertion event.
- */
-static void InsertHandler(eventid_t id) {
-  msg_t err;
-
-  (void)id;
-
-#if HAL_USE_SDC
-  if (sdcConnect(&PORTAB_SDCD1)) {
-    return;
-  }
-#else
-  if (mmcConnect(&MMCD1)) {
-    return;
-  }
-#endif
-
-  err = chfsdrvMount(&chfs_driver);
-  if (CH_RET_IS_ERROR(err)) {
-#if HAL_USE_SDC
-    sdcDisconnect(&PORTAB_SDCD1);
-#else
-    mmcDisconnect(&MMCD1);
-#endif
-    return;
-  }
-  fs_ready = true;
-}
-
-/*
- * Card removal event.
- */
-static void RemoveHandler(eventid_t id) {
-
-  (void)id;
-
-#if HAL_USE_SDC
-  sdcDisconnect(&PORTAB_SDCD1);
-#else
-  mmcDisconnect(&MMCD1);
-#endif
-  fs_ready = false;
-}
-
 /*
  * Shell exit event.
  */
@@ -235,10 +123,8 @@ static THD_FUNCTION(thd1_func, arg) {
 int main(void) {
   vfs_file_node_c *file1;
   msg_t msg;
-  event_listener_t el0, el1, el2;
+  event_listener_t el0;
   static const evhandler_t evhndl[] = {
-    InsertHandler,
-    RemoveHandler,
     ShellHandler
   };
 
@@ -263,19 +149,19 @@ int main(void) {
                                NORMALPRIO + 10, thd1_func, NULL, NULL);
   chThdSpawnRunning(&thd1, &thd1_desc);
 
-#if HAL_USE_SDC
-  /* Activates the SDC driver using default configuration.*/
-  sdcStart(&PORTAB_SDCD1, NULL);
-
-  /* Activates the card insertion monitor.*/
-  tmr_init(&PORTAB_SDCD1);
+#if defined(PORTAB_CHFS_FLASH)
+  /* Board-provided flash device, the ChibiFS volume is on its first
+     sectors.*/
+  chfscfg.flp     = PORTAB_CHFS_FLASH;
+  chfscfg.sectors = PORTAB_CHFS_SECTORS;
+  chfscfg.base    = 0U;
 #else
-  /* Activates the MMC_SPI driver.*/
-  mmcObjectInit(&MMCD1, __nocache_mmcbuf);
-  mmcStart(&MMCD1, &mmccfg);
-
-  /* Activates the card insertion monitor.*/
-  tmr_init(&MMCD1);
+  /* Activates the EFL driver, the ChibiFS volume is on the last sectors.*/
+  eflStart(&EFLD1, NULL);
+  chfscfg.flp     = (BaseFlash *)&EFLD1;
+  chfscfg.sectors = PORTAB_CHFS_SECTORS;
+  chfscfg.base    = flashGetDescriptor(chfscfg.flp)->sectors_count -
+                    PORTAB_CHFS_SECTORS;
 #endif
 
   /* Activates the SIO driver and a null stream.*/
@@ -283,11 +169,25 @@ int main(void) {
   nullObjectInit(&nullstream);
 
   /* Initialization of the VFS ChibiFS driver object.*/
-  chfsdrvObjectInit(&chfs_driver, NULL);
+  chfsdrvObjectInit(&chfs_driver, &chfscfg);
 
   /* Initialization of the VFS stream driver object.*/
   stmdrvObjectInit(&dev_driver, &streams[0]);
 
+  /* Mounting the file system, if it fails then formatting and retrying.*/
+  msg = chfsdrvMount(&chfs_driver);
+  if (CH_RET_IS_ERROR(msg)) {
+    msg = chfsdrvFormat(&chfs_driver);
+    if (CH_RET_IS_ERROR(msg)) {
+      chSysHalt("CHFS format failed");
+    }
+    msg = chfsdrvMount(&chfs_driver);
+    if (CH_RET_IS_ERROR(msg)) {
+      chSysHalt("CHFS mount failed");
+    }
+  }
+  fs_ready = true;
+
   /* Initializing an overlay VFS object overlaying the LittleFS driver.*/
   ovldrvObjectInit(&root_overlay_driver, (vfs_driver_c *)&chfs_driver, NULL);
 
@@ -307,9 +207,7 @@ int main(void) {
   xshellObjectInit(&sm1, &cfg1);
 
   /* Normal main() thread activity, spawning shells.*/
-  chEvtRegister(&inserted_event, &el0, 0);
-  chEvtRegister(&removed_event, &el1, 1);
-  chEvtRegister(&sm1.events, &el2, 2);
+  chEvtRegister(&sm1.events, &el0, 0);
   while (true) {
     if (xshp == NULL) {
       /* Spawning a shell.*/
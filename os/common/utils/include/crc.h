@@ -0,0 +1,141 @@
+/*
+    ChibiOS - Copyright (C) 2006,2007,2008,2009,2010,2011,2012,2013,2014,
+              2015,2016,2017,2018,2019,2020,2021 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    crc.h
+ * @brief   CRC utilities header file.
+ *
+ * @addtogroup UTILS_CRC
+ * @{
+ */
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Constants for configuration options
+ * @{
+ */
+/**
+ * @brief   Generic 'false' preprocessor boolean constant.
+ */
+#if !defined(FALSE) || defined(__DOXYGEN__)
+#define FALSE                               0
+#endif
+
+/**
+ * @brief   Generic 'true' preprocessor boolean constant.
+ */
+#if !defined(TRUE) || defined(__DOXYGEN__)
+#define TRUE                                1
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of bytes processed for each step of the software kernels.
+ * @details Valid values are 1, 4 and 8. Each slice requires a 256 entries
+ *          lookup table for each CRC type, 512 bytes for CRC16 and 1kB for
+ *          CRC32.
+ */
+#if !defined(CRC_CFG_SLICES) || defined(__DOXYGEN__)
+#define CRC_CFG_SLICES                      4
+#endif
+
+/**
+ * @brief   Enables the use of a hardware CRC16 engine.
+ * @details If enabled then the application must provide the function
+ *          @p crc16_hw(), it is invoked for buffers larger than
+ *          @p CRC_CFG_HW_THRESHOLD.
+ */
+#if !defined(CRC_CFG_USE_HW_CRC16) || defined(__DOXYGEN__)
+#define CRC_CFG_USE_HW_CRC16                FALSE
+#endif
+
+/**
+ * @brief   Enables the use of a hardware CRC32 engine.
+ * @details If enabled then the application must provide the function
+ *          @p crc32_hw(), it is invoked for buffers larger than
+ *          @p CRC_CFG_HW_THRESHOLD.
+ */
+#if !defined(CRC_CFG_USE_HW_CRC32) || defined(__DOXYGEN__)
+#define CRC_CFG_USE_HW_CRC32                FALSE
+#endif
+
+/**
+ * @brief   Minimum buffer size handed to the hardware engines.
+ * @details Smaller buffers are processed in software, setup of an engine
+ *          is usually not worth it for few bytes.
+ */
+#if !defined(CRC_CFG_HW_THRESHOLD) || defined(__DOXYGEN__)
+#define CRC_CFG_HW_THRESHOLD                32U
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CRC_CFG_SLICES != 1) && (CRC_CFG_SLICES != 4) && (CRC_CFG_SLICES != 8)
+#error "invalid CRC_CFG_SLICES value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint16_t crc16(uint16_t crc, const void *data, size_t n);
+  uint32_t crc32(uint32_t crc, const void *data, size_t n);
+#if CRC_CFG_USE_HW_CRC16 == TRUE
+  uint16_t crc16_hw(uint16_t crc, const uint8_t *data, size_t n);
+#endif
+#if CRC_CFG_USE_HW_CRC32 == TRUE
+  uint32_t crc32_hw(uint32_t crc, const uint8_t *data, size_t n);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* CRC_H */
+
+/** @} */
@@ -11,7 +11,12 @@ ifndef UTILSSRC
     ifneq ($(filter sglob,$(UTILSSELECT)),)
       UTILSSRC += ${CHIBIOS}/os/common/utils/src/sglob.c
     endif
+    ifneq ($(filter crc,$(UTILSSELECT)),)
+      UTILSSRC += ${CHIBIOS}/os/common/utils/src/crc.c
+    endif
   endif
+  # Some modules could be already required by other subsystems.
+  UTILSSRC := $(filter-out $(ALLCSRC),$(UTILSSRC))
   ALLCSRC += $(UTILSSRC)
 endif
  
@@ -375,6 +375,277 @@ static msg_t acc_set_full_scale(ADXL355Driver *devp, adxl355_acc_fs_t fs) {
   return msg;
 }
 
+#if (ADXL355_USE_SPI) || defined(__DOXYGEN__)
+/**
+ * @brief   Reads entries from the FIFO in a single SPI transaction.
+ * @details The device does not increment the FIFO_DATA address, data is
+ *          received in chunks through the communication buffer while the
+ *          chip stays selected. Samples are aligned on the X axis marker,
+ *          entries preceding it are discarded.
+ *
+ * @param[in] devp      pointer to @p ADXL355Driver interface.
+ * @param[out] samples  buffer for the decoded samples, @p NULL to discard
+ *                      the entries.
+ * @param[in] entries   number of entries to be read.
+ * @return              The number of complete samples.
+ */
+static size_t stream_fifo_read(ADXL355Driver *devp, int32_t samples[],
+                               size_t entries) {
+  size_t remaining, chunk, len, i, axis = 0U, cnt = 0U;
+  uint8_t *p;
+  int32_t tmp;
+
+  chunk = ((ADXL355_COMM_BUFF_SIZE - 1U) / 3U) * 3U;
+  remaining = entries * 3U;
+
+  /* Preparing a read. */
+  devp->commtxp[0] = (ADXL355_AD_FIFO_DATA << 1) | ADXL355_RW;
+
+  cacheBufferFlush(&devp->commtxp[0], ADXL355_COMM_BUFF_SIZE);
+  spiSelect(devp->config->spip);
+  spiSend(devp->config->spip, 1, devp->commtxp);
+  while(remaining > 0U) {
+    len = remaining < chunk ? remaining : chunk;
+    spiReceive(devp->config->spip, len, devp->commrxp);
+    cacheBufferInvalidate(&devp->commrxp[0], ADXL355_COMM_BUFF_SIZE);
+
+    for(i = 0U; i < len; i += 3U) {
+      p = &devp->commrxp[i];
+      if((p[2] & ADXL355_FIFO_DATA_EMPTY) != 0U) {
+        continue;
+      }
+      if((p[2] & ADXL355_FIFO_DATA_X_MARKER) != 0U) {
+        axis = 0U;
+      }
+      else if(axis == 0U) {
+        /* Waiting for an X axis entry.*/
+        continue;
+      }
+      if(samples != NULL) {
+        tmp = (p[0] << 12) | (p[1] << 4) | (p[2] >> 4);
+        if(tmp & 0x80000) {
+          tmp |= 0xFFF00000U;
+        }
+        samples[cnt * ADXL355_STREAM_NUMBER_OF_CHANNELS + axis] = tmp;
+      }
+      if(++axis == ADXL355_STREAM_NUMBER_OF_CHANNELS) {
+        axis = 0U;
+        cnt++;
+      }
+    }
+    remaining -= len;
+  }
+  spiUnselect(devp->config->spip);
+
+  return cnt;
+}
+#endif /* ADXL355_USE_SPI */
+
+/**
+ * @brief   Configures the FIFO watermark.
+ * @details The FIFO is always enabled, stale entries are discarded and the
+ *          watermark is set. The FIFO_FULL signal is routed to INT1.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[in] watermark watermark level, in samples.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ */
+static msg_t stream_start(void *ip, size_t watermark) {
+  ADXL355Driver* devp;
+  uint8_t reg_val;
+  msg_t msg = MSG_OK;
+
+  osalDbgCheck((ip != NULL) && (watermark > 0U) &&
+               (watermark <= ADXL355_STREAM_MAX_WATERMARK));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(ADXL355Driver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == ADXL355_READY),
+                "stream_start(), invalid state");
+
+#if ADXL355_USE_SPI
+#if ADXL355_SHARED_SPI
+  osalDbgAssert((devp->config->spip->state == SPI_READY),
+                "stream_start(), channel not ready");
+
+  spiAcquireBus(devp->config->spip);
+  spiStart(devp->config->spip,
+           devp->config->spicfg);
+#endif /* ADXL355_SHARED_SPI */
+
+  /* Discarding stale entries.*/
+  adxl355SPIReadRegister(devp, ADXL355_AD_FIFO_ENTRIES, 1, &reg_val);
+  reg_val &= ADXL355_FIFO_ENTRIES_MASK;
+  if(reg_val > 0U) {
+    (void)stream_fifo_read(devp, NULL, reg_val);
+  }
+
+  /* Watermark in entries.*/
+  reg_val = (uint8_t)(watermark * ADXL355_STREAM_NUMBER_OF_CHANNELS);
+  adxl355SPIWriteRegister(devp, ADXL355_AD_FIFO_SAMPLES, 1, &reg_val);
+
+  reg_val = ADXL355_INT_MAP_FULL_EN1;
+  adxl355SPIWriteRegister(devp, ADXL355_AD_INT_MAP, 1, &reg_val);
+
+#if ADXL355_SHARED_SPI
+  spiReleaseBus(devp->config->spip);
+#endif /* ADXL355_SHARED_SPI */
+#endif /* ADXL355_USE_SPI */
+  return msg;
+}
+
+/**
+ * @brief   Restores the FIFO watermark reset value and releases INT1.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ */
+static msg_t stream_stop(void *ip) {
+  ADXL355Driver* devp;
+  uint8_t reg_val;
+  msg_t msg = MSG_OK;
+
+  osalDbgCheck(ip != NULL);
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(ADXL355Driver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == ADXL355_READY),
+                "stream_stop(), invalid state");
+
+#if ADXL355_USE_SPI
+#if ADXL355_SHARED_SPI
+  osalDbgAssert((devp->config->spip->state == SPI_READY),
+                "stream_stop(), channel not ready");
+
+  spiAcquireBus(devp->config->spip);
+  spiStart(devp->config->spip,
+           devp->config->spicfg);
+#endif /* ADXL355_SHARED_SPI */
+
+  reg_val = 0;
+  adxl355SPIWriteRegister(devp, ADXL355_AD_INT_MAP, 1, &reg_val);
+
+  /* Reset value, the whole FIFO.*/
+  reg_val = ADXL355_STREAM_MAX_WATERMARK * ADXL355_STREAM_NUMBER_OF_CHANNELS;
+  adxl355SPIWriteRegister(devp, ADXL355_AD_FIFO_SAMPLES, 1, &reg_val);
+
+#if ADXL355_SHARED_SPI
+  spiReleaseBus(devp->config->spip);
+#endif /* ADXL355_SHARED_SPI */
+#endif /* ADXL355_USE_SPI */
+  return msg;
+}
+
+/**
+ * @brief   Reads a batch of raw samples from the FIFO.
+ * @details The FIFO level is read first, then the complete samples fitting
+ *          the buffer are read in a single SPI transaction.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[out] samples  a buffer which would be filled with raw samples.
+ * @param[in] n         maximum number of samples.
+ * @param[out] np       pointer to the number of samples read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ */
+static msg_t stream_read_batch_raw(void *ip, int32_t samples[], size_t n,
+                                   size_t *np) {
+  ADXL355Driver* devp;
+  uint8_t reg_val;
+  size_t entries, cnt = 0U;
+  msg_t msg = MSG_OK;
+
+  osalDbgCheck((ip != NULL) && (samples != NULL) && (np != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(ADXL355Driver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == ADXL355_READY),
+                "stream_read_batch_raw(), invalid state");
+
+#if ADXL355_USE_SPI
+#if ADXL355_SHARED_SPI
+  osalDbgAssert((devp->config->spip->state == SPI_READY),
+                "stream_read_batch_raw(), channel not ready");
+
+  spiAcquireBus(devp->config->spip);
+  spiStart(devp->config->spip,
+           devp->config->spicfg);
+#endif /* ADXL355_SHARED_SPI */
+
+  adxl355SPIReadRegister(devp, ADXL355_AD_FIFO_ENTRIES, 1, &reg_val);
+  entries = (size_t)(reg_val & ADXL355_FIFO_ENTRIES_MASK);
+  if(entries > n * ADXL355_STREAM_NUMBER_OF_CHANNELS) {
+    entries = n * ADXL355_STREAM_NUMBER_OF_CHANNELS;
+  }
+  entries -= entries % ADXL355_STREAM_NUMBER_OF_CHANNELS;
+  if(entries > 0U) {
+    cnt = stream_fifo_read(devp, samples, entries);
+  }
+
+#if ADXL355_SHARED_SPI
+  spiReleaseBus(devp->config->spip);
+#endif /* ADXL355_SHARED_SPI */
+#endif /* ADXL355_USE_SPI */
+
+  *np = cnt;
+  return msg;
+}
+
+/**
+ * @brief   Reads a batch of fixed point cooked samples from the FIFO.
+ * @note    Data is manipulated according to the formula
+ *          cooked = (raw * sensitivity) - bias.
+ * @note    Final data is expressed as milli-G with
+ *          @p SENSOR_FIXED_FRAC_BITS fractional bits.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[out] samples  a buffer which would be filled with cooked samples.
+ * @param[in] n         maximum number of samples.
+ * @param[out] np       pointer to the number of samples read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ */
+static msg_t stream_read_batch_fixed(void *ip, int32_t samples[], size_t n,
+                                     size_t *np) {
+  ADXL355Driver* devp;
+  int32_t sens[ADXL355_STREAM_NUMBER_OF_CHANNELS];
+  int32_t bias[ADXL355_STREAM_NUMBER_OF_CHANNELS];
+  int32_t *sp;
+  size_t i, j;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (samples != NULL) && (np != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(ADXL355Driver*, (BaseSensorStream*)ip);
+
+  msg = stream_read_batch_raw(ip, samples, n, np);
+
+  /* Scaling factors computed once per batch.*/
+  for(j = 0; j < ADXL355_STREAM_NUMBER_OF_CHANNELS; j++) {
+    sens[j] = SENSOR_SENS2FIXED(devp->accsensitivity[j]);
+    bias[j] = SENSOR_FLOAT2FIXED(devp->accbias[j]);
+  }
+
+  sp = samples;
+  for(i = 0; i < *np; i++) {
+    for(j = 0; j < ADXL355_STREAM_NUMBER_OF_CHANNELS; j++) {
+      sp[j] = SENSOR_COOK_FIXED(sp[j], sens[j], bias[j]);
+    }
+    sp += ADXL355_STREAM_NUMBER_OF_CHANNELS;
+  }
+  return msg;
+}
+
 static const struct ADXL355VMT vmt_device = {
   (size_t)0,
   acc_set_full_scale
@@ -386,6 +657,12 @@ static const struct BaseAccelerometerVMT vmt_accelerometer = {
   acc_set_bias, acc_reset_bias, acc_set_sensivity, acc_reset_sensivity
 };
 
+static const struct BaseSensorStreamVMT vmt_stream = {
+  sizeof(struct ADXL355VMT*) + sizeof(BaseAccelerometer),
+  acc_get_axes_number, acc_read_raw, acc_read_cooked,
+  stream_start, stream_stop, stream_read_batch_raw, stream_read_batch_fixed
+};
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -463,6 +740,7 @@ void adxl355SPIWriteRegister(ADXL355Driver *devp, uint8_t reg, size_t n,
 void adxl355ObjectInit(ADXL355Driver *devp, uint8_t* txbp, uint8_t* rxbp) {
   devp->vmt = &vmt_device;
   devp->acc_if.vmt = &vmt_accelerometer;
+  devp->stream_if.vmt = &vmt_stream;
 
   devp->config = NULL;
   devp->commtxp = txbp;
@@ -82,6 +82,18 @@
 #define ADXL355_ACC_BIAS                    0.0f
 /** @} */
 
+/**
+ * @brief   ADXL355 FIFO stream characteristics.
+ * @note    A stream sample is made of the accelerometer axes, the FIFO
+ *          holds 96 axis entries.
+ *
+ * @{
+ */
+#define ADXL355_STREAM_NUMBER_OF_CHANNELS   ADXL355_ACC_NUMBER_OF_AXES
+
+#define ADXL355_STREAM_MAX_WATERMARK        32U
+/** @} */
+
 /**
  * @name    ADXL355 communication interfaces related bit masks
  * @{
@@ -142,6 +154,22 @@
 #define ADXL355_DEVID_MST                   0x1D
 /** @} */
 
+/**
+ * @name    ADXL355_FIFO_ENTRIES register bits definitions
+ * @{
+ */
+#define ADXL355_FIFO_ENTRIES_MASK           0x7F
+/** @} */
+
+/**
+ * @name    ADXL355_FIFO_DATA entries bits definitions
+ * @note    These bits are in the last byte of each entry.
+ * @{
+ */
+#define ADXL355_FIFO_DATA_X_MARKER          (1 << 0)
+#define ADXL355_FIFO_DATA_EMPTY             (1 << 1)
+/** @} */
+
 /**
  * @name    ADXL355_FILTER register bits definitions
  * @{
@@ -485,6 +513,8 @@ struct ADXL355Driver {
   const struct ADXL355VMT     *vmt;
   /** @brief Base accelerometer interface.*/
   BaseAccelerometer           acc_if;
+  /** @brief Base sensor stream interface.*/
+  BaseSensorStream            stream_if;
   _adxl355_data
 };
 /** @} */
@@ -630,6 +660,73 @@ struct ADXL355Driver {
 #define adxl355AccelerometerSetFullScale(devp, fs)                          \
         (devp)->vmt->acc_set_full_scale(devp, fs)
 
+/**
+ * @brief   Configures the FIFO watermark.
+ * @details The ADXL355 FIFO is always enabled, stale entries are discarded
+ *          and the watermark signal is routed to the INT1 pin.
+ *
+ * @param[in] devp      pointer to @p ADXL355Driver.
+ * @param[in] wm        watermark level, in samples
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+#define adxl355StreamStart(devp, wm)                                        \
+        sensorStartStream(&((devp)->stream_if), wm)
+
+/**
+ * @brief   Restores the FIFO watermark default and releases INT1.
+ *
+ * @param[in] devp      pointer to @p ADXL355Driver.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+#define adxl355StreamStop(devp)                                             \
+        sensorStopStream(&((devp)->stream_if))
+
+/**
+ * @brief   Reads a batch of raw samples from the FIFO.
+ * @note    The samples array must be at least @p n times
+ *          @p ADXL355_STREAM_NUMBER_OF_CHANNELS large.
+ *
+ * @param[in] devp      pointer to @p ADXL355Driver.
+ * @param[out] sp       a buffer which would be filled with raw samples.
+ * @param[in] n         maximum number of samples to be read
+ * @param[out] np       pointer to the number of samples actually read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+#define adxl355StreamReadRaw(devp, sp, n, np)                               \
+        sensorReadBatchRaw(&((devp)->stream_if), sp, n, np)
+
+/**
+ * @brief   Reads a batch of fixed point cooked samples from the FIFO.
+ * @note    Data is expressed as milli-G with @p SENSOR_FIXED_FRAC_BITS
+ *          fractional bits.
+ * @note    The samples array must be at least @p n times
+ *          @p ADXL355_STREAM_NUMBER_OF_CHANNELS large.
+ *
+ * @param[in] devp      pointer to @p ADXL355Driver.
+ * @param[out] sp       a buffer which would be filled with cooked samples.
+ * @param[in] n         maximum number of samples to be read
+ * @param[out] np       pointer to the number of samples actually read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+#define adxl355StreamReadFixed(devp, sp, n, np)                             \
+        sensorReadBatchFixed(&((devp)->stream_if), sp, n, np)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -428,6 +428,232 @@ static msg_t acc_set_full_scale(LIS3DSHDriver *devp, lis3dsh_acc_fs_t fs) {
   return msg;
 }
 
+/**
+ * @brief   Enables the FIFO in stream mode.
+ * @details The FIFO is emptied by passing through the bypass mode, then
+ *          the stream mode is entered with the specified watermark.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[in] watermark watermark level, in samples.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ */
+static msg_t stream_start(void *ip, size_t watermark) {
+  LIS3DSHDriver* devp;
+  uint8_t cr;
+  msg_t msg = MSG_OK;
+
+  osalDbgCheck((ip != NULL) && (watermark > 0U) &&
+               (watermark <= LIS3DSH_STREAM_MAX_WATERMARK));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LIS3DSHDriver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == LIS3DSH_READY),
+                "stream_start(), invalid state");
+
+#if LIS3DSH_USE_SPI
+#if LIS3DSH_SHARED_SPI
+  osalDbgAssert((devp->config->spip->state == SPI_READY),
+                "stream_start(), channel not ready");
+
+  spiAcquireBus(devp->config->spip);
+  spiStart(devp->config->spip,
+           devp->config->spicfg);
+#endif /* LIS3DSH_SHARED_SPI */
+
+  /* Bypass mode, this empties the FIFO.*/
+  cr = 0;
+  lis3dshSPIWriteRegister(devp->config->spip, LIS3DSH_AD_FIFO_CTRL, 1, &cr);
+
+  /* FIFO enabled with the watermark signal on INT1.*/
+  cr = LIS3DSH_CTRL_REG6_ADD_INC | LIS3DSH_CTRL_REG6_FIFO_EN |
+       LIS3DSH_CTRL_REG6_P1_WTM;
+#if LIS3DSH_USE_ADVANCED || defined(__DOXYGEN__)
+  cr |= devp->config->accbdu;
+#endif
+  lis3dshSPIWriteRegister(devp->config->spip, LIS3DSH_AD_CTRL_REG6, 1, &cr);
+
+  cr = LIS3DSH_CTRL_REG3_INT1_EN | LIS3DSH_CTRL_REG3_IEA;
+  lis3dshSPIWriteRegister(devp->config->spip, LIS3DSH_AD_CTRL_REG3, 1, &cr);
+
+  /* Stream mode.*/
+  cr = LIS3DSH_FIFO_CTRL_FMODE_1 |
+       ((uint8_t)watermark & LIS3DSH_FIFO_CTRL_WTMP_MASK);
+  lis3dshSPIWriteRegister(devp->config->spip, LIS3DSH_AD_FIFO_CTRL, 1, &cr);
+
+#if LIS3DSH_SHARED_SPI
+  spiReleaseBus(devp->config->spip);
+#endif /* LIS3DSH_SHARED_SPI */
+#endif /* LIS3DSH_USE_SPI */
+  return msg;
+}
+
+/**
+ * @brief   Disables the FIFO.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ */
+static msg_t stream_stop(void *ip) {
+  LIS3DSHDriver* devp;
+  uint8_t cr;
+  msg_t msg = MSG_OK;
+
+  osalDbgCheck(ip != NULL);
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LIS3DSHDriver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == LIS3DSH_READY),
+                "stream_stop(), invalid state");
+
+#if LIS3DSH_USE_SPI
+#if LIS3DSH_SHARED_SPI
+  osalDbgAssert((devp->config->spip->state == SPI_READY),
+                "stream_stop(), channel not ready");
+
+  spiAcquireBus(devp->config->spip);
+  spiStart(devp->config->spip,
+           devp->config->spicfg);
+#endif /* LIS3DSH_SHARED_SPI */
+
+  cr = 0;
+  lis3dshSPIWriteRegister(devp->config->spip, LIS3DSH_AD_FIFO_CTRL, 1, &cr);
+  lis3dshSPIWriteRegister(devp->config->spip, LIS3DSH_AD_CTRL_REG3, 1, &cr);
+
+  /* Same configuration written by lis3dshStart().*/
+  cr = LIS3DSH_CTRL_REG6_ADD_INC;
+#if LIS3DSH_USE_ADVANCED || defined(__DOXYGEN__)
+  cr |= devp->config->accbdu;
+#endif
+  lis3dshSPIWriteRegister(devp->config->spip, LIS3DSH_AD_CTRL_REG6, 1, &cr);
+
+#if LIS3DSH_SHARED_SPI
+  spiReleaseBus(devp->config->spip);
+#endif /* LIS3DSH_SHARED_SPI */
+#endif /* LIS3DSH_USE_SPI */
+  return msg;
+}
+
+/**
+ * @brief   Reads a batch of raw samples from the FIFO.
+ * @details The FIFO level is read first, then the buffered samples fitting
+ *          the buffer are read in a single burst, with the FIFO enabled the
+ *          device rolls the address back from OUT_Z_H to OUT_X_L. Data is
+ *          received directly into the samples buffer and then widened in
+ *          place.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[out] samples  a buffer which would be filled with raw samples.
+ * @param[in] n         maximum number of samples.
+ * @param[out] np       pointer to the number of samples read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ */
+static msg_t stream_read_batch_raw(void *ip, int32_t samples[], size_t n,
+                                   size_t *np) {
+  LIS3DSHDriver* devp;
+  uint8_t *bp = (uint8_t *)samples;
+  uint8_t src = 0U;
+  size_t cnt = 0U, i;
+  msg_t msg = MSG_OK;
+
+  osalDbgCheck((ip != NULL) && (samples != NULL) && (np != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LIS3DSHDriver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == LIS3DSH_READY),
+                "stream_read_batch_raw(), invalid state");
+
+#if LIS3DSH_USE_SPI
+#if LIS3DSH_SHARED_SPI
+  osalDbgAssert((devp->config->spip->state == SPI_READY),
+                "stream_read_batch_raw(), channel not ready");
+
+  spiAcquireBus(devp->config->spip);
+  spiStart(devp->config->spip,
+           devp->config->spicfg);
+#endif /* LIS3DSH_SHARED_SPI */
+
+  lis3dshSPIReadRegister(devp->config->spip, LIS3DSH_AD_FIFO_SRC, 1, &src);
+  cnt = (size_t)(src & LIS3DSH_FIFO_SRC_FSS_MASK);
+  if(cnt > n) {
+    cnt = n;
+  }
+  if(cnt > 0U) {
+    lis3dshSPIReadRegister(devp->config->spip, LIS3DSH_AD_OUT_X_L,
+                           cnt * LIS3DSH_STREAM_NUMBER_OF_CHANNELS * 2U, bp);
+  }
+
+#if LIS3DSH_SHARED_SPI
+  spiReleaseBus(devp->config->spip);
+#endif /* LIS3DSH_SHARED_SPI */
+#endif /* LIS3DSH_USE_SPI */
+
+  /* Widening backward, each value is written at or after its source.*/
+  i = cnt * LIS3DSH_STREAM_NUMBER_OF_CHANNELS;
+  while(i > 0U) {
+    i--;
+    samples[i] = (int32_t)(int16_t)(bp[2 * i] + (bp[2 * i + 1] << 8));
+  }
+
+  *np = cnt;
+  return msg;
+}
+
+/**
+ * @brief   Reads a batch of fixed point cooked samples from the FIFO.
+ * @note    Data is manipulated according to the formula
+ *          cooked = (raw * sensitivity) - bias.
+ * @note    Final data is expressed as milli-G with
+ *          @p SENSOR_FIXED_FRAC_BITS fractional bits.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[out] samples  a buffer which would be filled with cooked samples.
+ * @param[in] n         maximum number of samples.
+ * @param[out] np       pointer to the number of samples read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ */
+static msg_t stream_read_batch_fixed(void *ip, int32_t samples[], size_t n,
+                                     size_t *np) {
+  LIS3DSHDriver* devp;
+  int32_t sens[LIS3DSH_STREAM_NUMBER_OF_CHANNELS];
+  int32_t bias[LIS3DSH_STREAM_NUMBER_OF_CHANNELS];
+  int32_t *sp;
+  size_t i, j;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (samples != NULL) && (np != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LIS3DSHDriver*, (BaseSensorStream*)ip);
+
+  msg = stream_read_batch_raw(ip, samples, n, np);
+
+  /* Scaling factors computed once per batch.*/
+  for(j = 0; j < LIS3DSH_STREAM_NUMBER_OF_CHANNELS; j++) {
+    sens[j] = SENSOR_SENS2FIXED(devp->accsensitivity[j]);
+    bias[j] = SENSOR_FLOAT2FIXED(devp->accbias[j]);
+  }
+
+  sp = samples;
+  for(i = 0; i < *np; i++) {
+    for(j = 0; j < LIS3DSH_STREAM_NUMBER_OF_CHANNELS; j++) {
+      sp[j] = SENSOR_COOK_FIXED(sp[j], sens[j], bias[j]);
+    }
+    sp += LIS3DSH_STREAM_NUMBER_OF_CHANNELS;
+  }
+  return msg;
+}
+
 static const struct LIS3DSHVMT vmt_device = {
   (size_t)0,
   acc_set_full_scale
@@ -439,6 +665,12 @@ static const struct BaseAccelerometerVMT vmt_accelerometer = {
   acc_set_bias, acc_reset_bias, acc_set_sensivity, acc_reset_sensivity
 };
 
+static const struct BaseSensorStreamVMT vmt_stream = {
+  sizeof(struct LIS3DSHVMT*) + sizeof(BaseAccelerometer),
+  acc_get_axes_number, acc_read_raw, acc_read_cooked,
+  stream_start, stream_stop, stream_read_batch_raw, stream_read_batch_fixed
+};
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -453,6 +685,7 @@ static const struct BaseAccelerometerVMT vmt_accelerometer = {
 void lis3dshObjectInit(LIS3DSHDriver *devp) {
   devp->vmt = &vmt_device;
   devp->acc_if.vmt = &vmt_accelerometer;
+  devp->stream_if.vmt = &vmt_stream;
 
   devp->config = NULL;
 
@@ -86,6 +86,17 @@
 #define LIS3DSH_ACC_BIAS                    0.0f
 /** @} */
 
+/**
+ * @brief   LIS3DSH FIFO stream characteristics.
+ * @note    A stream sample is made of the accelerometer axes.
+ *
+ * @{
+ */
+#define LIS3DSH_STREAM_NUMBER_OF_CHANNELS   LIS3DSH_ACC_NUMBER_OF_AXES
+
+#define LIS3DSH_STREAM_MAX_WATERMARK        31U
+/** @} */
+
 /**
  * @name    LIS3DSH communication interfaces related bit masks
  * @{
@@ -286,6 +297,28 @@
 #define LIS3DSH_CTRL_REG6_BOOT              (1 << 7)
 /** @} */
 
+/**
+ * @name    LIS3DSH_FIFO_CTRL register bits definitions
+ * @{
+ */
+#define LIS3DSH_FIFO_CTRL_MASK              0xFF
+#define LIS3DSH_FIFO_CTRL_WTMP_MASK         0x1F
+#define LIS3DSH_FIFO_CTRL_FMODE_0           (1 << 5)
+#define LIS3DSH_FIFO_CTRL_FMODE_1           (1 << 6)
+#define LIS3DSH_FIFO_CTRL_FMODE_2           (1 << 7)
+/** @} */
+
+/**
+ * @name    LIS3DSH_FIFO_SRC register bits definitions
+ * @{
+ */
+#define LIS3DSH_FIFO_SRC_MASK               0xFF
+#define LIS3DSH_FIFO_SRC_FSS_MASK           0x1F
+#define LIS3DSH_FIFO_SRC_EMPTY              (1 << 5)
+#define LIS3DSH_FIFO_SRC_OVRN_FIFO          (1 << 6)
+#define LIS3DSH_FIFO_SRC_WTM                (1 << 7)
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -543,6 +576,8 @@ struct LIS3DSHDriver {
   const struct LIS3DSHVMT     *vmt;
   /** @brief Base accelerometer interface.*/
   BaseAccelerometer           acc_if;
+  /** @brief Base sensor stream interface.*/
+  BaseSensorStream            stream_if;
   _lis3dsh_data
 };
 /** @} */
@@ -688,6 +723,74 @@ struct LIS3DSHDriver {
 #define lis3dshAccelerometerSetFullScale(devp, fs)                          \
         (devp)->vmt->acc_set_full_scale(devp, fs)
 
+/**
+ * @brief   Enables the FIFO in stream mode.
+ * @details The FIFO is emptied and then it collects accelerometer samples
+ *          at the configured output data rate. The watermark signal is
+ *          routed to the INT1 pin.
+ *
+ * @param[in] devp      pointer to @p LIS3DSHDriver.
+ * @param[in] wm        watermark level, in samples
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+#define lis3dshStreamStart(devp, wm)                                        \
+        sensorStartStream(&((devp)->stream_if), wm)
+
+/**
+ * @brief   Disables the FIFO.
+ *
+ * @param[in] devp      pointer to @p LIS3DSHDriver.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+#define lis3dshStreamStop(devp)                                             \
+        sensorStopStream(&((devp)->stream_if))
+
+/**
+ * @brief   Reads a batch of raw samples from the FIFO.
+ * @note    The samples array must be at least @p n times
+ *          @p LIS3DSH_STREAM_NUMBER_OF_CHANNELS large.
+ *
+ * @param[in] devp      pointer to @p LIS3DSHDriver.
+ * @param[out] sp       a buffer which would be filled with raw samples.
+ * @param[in] n         maximum number of samples to be read
+ * @param[out] np       pointer to the number of samples actually read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+#define lis3dshStreamReadRaw(devp, sp, n, np)                               \
+        sensorReadBatchRaw(&((devp)->stream_if), sp, n, np)
+
+/**
+ * @brief   Reads a batch of fixed point cooked samples from the FIFO.
+ * @note    Data is expressed as milli-G with @p SENSOR_FIXED_FRAC_BITS
+ *          fractional bits.
+ * @note    The samples array must be at least @p n times
+ *          @p LIS3DSH_STREAM_NUMBER_OF_CHANNELS large.
+ *
+ * @param[in] devp      pointer to @p LIS3DSHDriver.
+ * @param[out] sp       a buffer which would be filled with cooked samples.
+ * @param[in] n         maximum number of samples to be read
+ * @param[out] np       pointer to the number of samples actually read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+#define lis3dshStreamReadFixed(devp, sp, n, np)                             \
+        sensorReadBatchFixed(&((devp)->stream_if), sp, n, np)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -803,6 +803,410 @@ static msg_t gyro_set_full_scale(LSM6DSLDriver *devp, lsm6dsl_gyro_fs_t fs) {
   return msg;
 }
 
+/**
+ * @brief   Return the number of channels of the BaseSensorStream.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ *
+ * @return              the number of channels.
+ */
+static size_t stream_get_channels_number(void *ip) {
+  (void)ip;
+
+  return LSM6DSL_STREAM_NUMBER_OF_CHANNELS;
+}
+
+/**
+ * @brief   Retrieves the current raw sample from the BaseSensorStream.
+ * @note    The gyroscope and accelerometer output registers are adjacent,
+ *          the whole sample is read in a single transaction.
+ * @note    The axes array must be at least the same size of the
+ *          BaseSensorStream channels number.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[out] axes     a buffer which would be filled with raw data.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t stream_read_raw(void *ip, int32_t axes[]) {
+  LSM6DSLDriver* devp;
+  uint8_t buff [LSM6DSL_STREAM_NUMBER_OF_CHANNELS * 2], i;
+  int16_t tmp;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (axes != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM6DSLDriver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == LSM6DSL_READY),
+                "stream_read_raw(), invalid state");
+#if LSM6DSL_USE_I2C
+  osalDbgAssert((devp->config->i2cp->state == I2C_READY),
+                "stream_read_raw(), channel not ready");
+
+#if LSM6DSL_SHARED_I2C
+  i2cAcquireBus(devp->config->i2cp);
+  i2cStart(devp->config->i2cp,
+           devp->config->i2ccfg);
+#endif /* LSM6DSL_SHARED_I2C */
+
+  msg = lsm6dslI2CReadRegister(devp->config->i2cp, devp->config->slaveaddress,
+                               LSM6DSL_AD_OUTX_L_G, buff,
+                               LSM6DSL_STREAM_NUMBER_OF_CHANNELS * 2);
+
+#if LSM6DSL_SHARED_I2C
+  i2cReleaseBus(devp->config->i2cp);
+#endif /* LSM6DSL_SHARED_I2C */
+#endif /* LSM6DSL_USE_I2C */
+  if(msg == MSG_OK)
+    for(i = 0; i < LSM6DSL_STREAM_NUMBER_OF_CHANNELS; i++) {
+      tmp = buff[2 * i] + (buff[2 * i + 1] << 8);
+      axes[i] = (int32_t)tmp;
+    }
+  return msg;
+}
+
+/**
+ * @brief   Retrieves the current cooked sample from the BaseSensorStream.
+ * @note    Gyroscope data is expressed as DPS and accelerometer data as
+ *          milli-G.
+ * @note    The axes array must be at least the same size of the
+ *          BaseSensorStream channels number.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[out] axes     a buffer which would be filled with cooked data.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t stream_read_cooked(void *ip, float axes[]) {
+  LSM6DSLDriver* devp;
+  uint32_t i;
+  int32_t raw[LSM6DSL_STREAM_NUMBER_OF_CHANNELS];
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (axes != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM6DSLDriver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == LSM6DSL_READY),
+                "stream_read_cooked(), invalid state");
+
+  msg = stream_read_raw(ip, raw);
+  for(i = 0; i < LSM6DSL_GYRO_NUMBER_OF_AXES; i++) {
+    axes[i] = (raw[i] * devp->gyrosensitivity[i]) - devp->gyrobias[i];
+  }
+  for(i = 0; i < LSM6DSL_ACC_NUMBER_OF_AXES; i++) {
+    axes[LSM6DSL_GYRO_NUMBER_OF_AXES + i] =
+        (raw[LSM6DSL_GYRO_NUMBER_OF_AXES + i] * devp->accsensitivity[i]) -
+        devp->accbias[i];
+  }
+  return msg;
+}
+
+/**
+ * @brief   Enables the FIFO in continuous mode.
+ * @details The FIFO is emptied by passing through the bypass mode, then
+ *          gyroscope and accelerometer data sets are collected without
+ *          decimation at the accelerometer output data rate.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[in] watermark watermark level, in samples.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t stream_start(void *ip, size_t watermark) {
+  LSM6DSLDriver* devp;
+  uint8_t cr[6];
+  uint32_t fth;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (watermark > 0U) &&
+               (watermark <= LSM6DSL_STREAM_MAX_WATERMARK));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM6DSLDriver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == LSM6DSL_READY),
+                "stream_start(), invalid state");
+  osalDbgAssert(((uint8_t)devp->config->accodr ==
+                 (uint8_t)devp->config->gyroodr),
+                "stream_start(), mismatching data rates");
+
+  /* Threshold in words.*/
+  fth = (uint32_t)watermark * LSM6DSL_STREAM_NUMBER_OF_CHANNELS;
+
+#if LSM6DSL_USE_I2C
+  osalDbgAssert((devp->config->i2cp->state == I2C_READY),
+                "stream_start(), channel not ready");
+
+#if LSM6DSL_SHARED_I2C
+  i2cAcquireBus(devp->config->i2cp);
+  i2cStart(devp->config->i2cp,
+           devp->config->i2ccfg);
+#endif /* LSM6DSL_SHARED_I2C */
+
+  /* Bypass mode, this empties the FIFO.*/
+  cr[0] = LSM6DSL_AD_FIFO_CTRL5;
+  cr[1] = LSMDSL_FIFO_CTRL5_FIFO_MODE_BYPASS;
+  msg = lsm6dslI2CWriteRegister(devp->config->i2cp,
+                                devp->config->slaveaddress, cr, 1);
+
+  if(msg == MSG_OK) {
+    /* Threshold, no decimation and continuous mode, the FIFO ODR field has
+       the same encoding of the accelerometer ODR field.*/
+    cr[0] = LSM6DSL_AD_FIFO_CTRL1;
+    cr[1] = (uint8_t)fth;
+    cr[2] = (uint8_t)(fth >> 8) & LSMDSL_FIFO_CTRL2_FTH_MASK;
+    cr[3] = LSMDSL_FIFO_CTRL3_DEC_FIFO_G0 | LSMDSL_FIFO_CTRL3_DEC_FIFO_XL0;
+    cr[4] = 0;
+    cr[5] = (((uint8_t)devp->config->accodr >> 1) &
+             LSMDSL_FIFO_CTRL5_ODR_FIFO_MASK) |
+            LSMDSL_FIFO_CTRL5_FIFO_MODE_CONT;
+    msg = lsm6dslI2CWriteRegister(devp->config->i2cp,
+                                  devp->config->slaveaddress, cr, 5);
+  }
+
+  if(msg == MSG_OK) {
+    /* Threshold signal on INT1.*/
+    cr[0] = LSM6DSL_AD_INT1_CTRL;
+    cr[1] = LSMDSL_INT1_CTRL_FTH;
+    msg = lsm6dslI2CWriteRegister(devp->config->i2cp,
+                                  devp->config->slaveaddress, cr, 1);
+  }
+
+#if LSM6DSL_SHARED_I2C
+  i2cReleaseBus(devp->config->i2cp);
+#endif /* LSM6DSL_SHARED_I2C */
+#endif /* LSM6DSL_USE_I2C */
+  return msg;
+}
+
+/**
+ * @brief   Disables the FIFO.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t stream_stop(void *ip) {
+  LSM6DSLDriver* devp;
+  uint8_t cr[2];
+  msg_t msg;
+
+  osalDbgCheck(ip != NULL);
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM6DSLDriver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == LSM6DSL_READY),
+                "stream_stop(), invalid state");
+
+#if LSM6DSL_USE_I2C
+  osalDbgAssert((devp->config->i2cp->state == I2C_READY),
+                "stream_stop(), channel not ready");
+
+#if LSM6DSL_SHARED_I2C
+  i2cAcquireBus(devp->config->i2cp);
+  i2cStart(devp->config->i2cp,
+           devp->config->i2ccfg);
+#endif /* LSM6DSL_SHARED_I2C */
+
+  cr[0] = LSM6DSL_AD_INT1_CTRL;
+  cr[1] = 0;
+  msg = lsm6dslI2CWriteRegister(devp->config->i2cp,
+                                devp->config->slaveaddress, cr, 1);
+
+  if(msg == MSG_OK) {
+    cr[0] = LSM6DSL_AD_FIFO_CTRL5;
+    cr[1] = LSMDSL_FIFO_CTRL5_FIFO_MODE_BYPASS;
+    msg = lsm6dslI2CWriteRegister(devp->config->i2cp,
+                                  devp->config->slaveaddress, cr, 1);
+  }
+
+#if LSM6DSL_SHARED_I2C
+  i2cReleaseBus(devp->config->i2cp);
+#endif /* LSM6DSL_SHARED_I2C */
+#endif /* LSM6DSL_USE_I2C */
+  return msg;
+}
+
+/**
+ * @brief   Reads a batch of raw samples from the FIFO.
+ * @details The FIFO status is read first, then all the complete samples
+ *          fitting the buffer are read in a single burst, the device rolls
+ *          the address back on the FIFO output registers. Data is received
+ *          directly into the samples buffer and then widened in place.
+ * @note    If the FIFO read pointer is not at the beginning of a sample,
+ *          which can happen after an overrun, the partial sample is
+ *          discarded with an extra transaction.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[out] samples  a buffer which would be filled with raw samples.
+ * @param[in] n         maximum number of samples.
+ * @param[out] np       pointer to the number of samples read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t stream_read_batch_raw(void *ip, int32_t samples[], size_t n,
+                                   size_t *np) {
+  LSM6DSLDriver* devp;
+  uint8_t *bp = (uint8_t *)samples;
+  uint8_t buff[LSM6DSL_STREAM_NUMBER_OF_CHANNELS * 2];
+  uint32_t words, pattern, skip;
+  size_t cnt = 0U, i;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (samples != NULL) && (np != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM6DSLDriver*, (BaseSensorStream*)ip);
+
+  osalDbgAssert((devp->state == LSM6DSL_READY),
+                "stream_read_batch_raw(), invalid state");
+
+#if LSM6DSL_USE_I2C
+  osalDbgAssert((devp->config->i2cp->state == I2C_READY),
+                "stream_read_batch_raw(), channel not ready");
+
+#if LSM6DSL_SHARED_I2C
+  i2cAcquireBus(devp->config->i2cp);
+  i2cStart(devp->config->i2cp,
+           devp->config->i2ccfg);
+#endif /* LSM6DSL_SHARED_I2C */
+
+  /* Unread words and next word position within the sample.*/
+  msg = lsm6dslI2CReadRegister(devp->config->i2cp, devp->config->slaveaddress,
+                               LSM6DSL_AD_FIFO_STATUS1, buff, 4);
+  if(msg == MSG_OK) {
+    words = buff[0] |
+            ((uint32_t)(buff[1] & LSMDSL_FIFO_STATUS2_DIFF_FIFO_MASK) << 8);
+    pattern = buff[2] |
+              ((uint32_t)(buff[3] & LSMDSL_FIFO_STATUS4_PATTERN_MASK) << 8);
+
+    if((pattern != 0U) && (pattern < LSM6DSL_STREAM_NUMBER_OF_CHANNELS)) {
+      skip = LSM6DSL_STREAM_NUMBER_OF_CHANNELS - pattern;
+      if(skip > words) {
+        skip = words;
+      }
+      if(skip > 0U) {
+        msg = lsm6dslI2CReadRegister(devp->config->i2cp,
+                                     devp->config->slaveaddress,
+                                     LSM6DSL_AD_FIFO_DATA_OUT_L, buff,
+                                     skip * 2U);
+      }
+      words -= skip;
+    }
+
+    cnt = words / LSM6DSL_STREAM_NUMBER_OF_CHANNELS;
+    if(cnt > n) {
+      cnt = n;
+    }
+    if((msg == MSG_OK) && (cnt > 0U)) {
+      msg = lsm6dslI2CReadRegister(devp->config->i2cp,
+                                   devp->config->slaveaddress,
+                                   LSM6DSL_AD_FIFO_DATA_OUT_L, bp,
+                                   cnt * LSM6DSL_STREAM_NUMBER_OF_CHANNELS * 2U);
+    }
+  }
+
+#if LSM6DSL_SHARED_I2C
+  i2cReleaseBus(devp->config->i2cp);
+#endif /* LSM6DSL_SHARED_I2C */
+#endif /* LSM6DSL_USE_I2C */
+
+  if(msg != MSG_OK) {
+    cnt = 0U;
+  }
+
+  /* Widening backward, each value is written at or after its source.*/
+  i = cnt * LSM6DSL_STREAM_NUMBER_OF_CHANNELS;
+  while(i > 0U) {
+    i--;
+    samples[i] = (int32_t)(int16_t)(bp[2 * i] + (bp[2 * i + 1] << 8));
+  }
+
+  *np = cnt;
+  return msg;
+}
+
+/**
+ * @brief   Reads a batch of fixed point cooked samples from the FIFO.
+ * @note    Data is manipulated according to the formula
+ *          cooked = (raw * sensitivity) - bias.
+ * @note    Gyroscope data is expressed as DPS and accelerometer data as
+ *          milli-G, both with @p SENSOR_FIXED_FRAC_BITS fractional bits.
+ *
+ * @param[in] ip        pointer to @p BaseSensorStream interface.
+ * @param[out] samples  a buffer which would be filled with cooked samples.
+ * @param[in] n         maximum number of samples.
+ * @param[out] np       pointer to the number of samples read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t stream_read_batch_fixed(void *ip, int32_t samples[], size_t n,
+                                     size_t *np) {
+  LSM6DSLDriver* devp;
+  int32_t sens[LSM6DSL_STREAM_NUMBER_OF_CHANNELS];
+  int32_t bias[LSM6DSL_STREAM_NUMBER_OF_CHANNELS];
+  int32_t *sp;
+  size_t i, j;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (samples != NULL) && (np != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM6DSLDriver*, (BaseSensorStream*)ip);
+
+  msg = stream_read_batch_raw(ip, samples, n, np);
+
+  /* Scaling factors computed once per batch.*/
+  for(j = 0; j < LSM6DSL_GYRO_NUMBER_OF_AXES; j++) {
+    sens[j] = SENSOR_SENS2FIXED(devp->gyrosensitivity[j]);
+    bias[j] = SENSOR_FLOAT2FIXED(devp->gyrobias[j]);
+  }
+  for(j = 0; j < LSM6DSL_ACC_NUMBER_OF_AXES; j++) {
+    sens[LSM6DSL_GYRO_NUMBER_OF_AXES + j] =
+        SENSOR_SENS2FIXED(devp->accsensitivity[j]);
+    bias[LSM6DSL_GYRO_NUMBER_OF_AXES + j] =
+        SENSOR_FLOAT2FIXED(devp->accbias[j]);
+  }
+
+  sp = samples;
+  for(i = 0; i < *np; i++) {
+    for(j = 0; j < LSM6DSL_STREAM_NUMBER_OF_CHANNELS; j++) {
+      sp[j] = SENSOR_COOK_FIXED(sp[j], sens[j], bias[j]);
+    }
+    sp += LSM6DSL_STREAM_NUMBER_OF_CHANNELS;
+  }
+  return msg;
+}
+
 static const struct LSM6DSLVMT vmt_device = {
   (size_t)0,
   acc_set_full_scale, gyro_set_full_scale
@@ -821,6 +1225,13 @@ static const struct BaseGyroscopeVMT vmt_gyroscope = {
   gyro_set_sensivity, gyro_reset_sensivity
 };
 
+static const struct BaseSensorStreamVMT vmt_stream = {
+  sizeof(struct LSM6DSLVMT*) + sizeof(BaseAccelerometer) +
+  sizeof(BaseGyroscope),
+  stream_get_channels_number, stream_read_raw, stream_read_cooked,
+  stream_start, stream_stop, stream_read_batch_raw, stream_read_batch_fixed
+};
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -836,6 +1247,7 @@ void lsm6dslObjectInit(LSM6DSLDriver *devp) {
   devp->vmt = &vmt_device;
   devp->acc_if.vmt = &vmt_accelerometer;
   devp->gyro_if.vmt = &vmt_gyroscope;
+  devp->stream_if.vmt = &vmt_stream;
 
   devp->config = NULL;
 
@@ -109,6 +109,20 @@
 #define LSM6DSL_GYRO_BIAS                   0.0f
 /** @} */
 
+/**
+ * @brief   LSM6DSL FIFO stream characteristics.
+ * @note    A stream sample is made of the gyroscope axes followed by the
+ *          accelerometer axes, in the FIFO storage order.
+ * @note    The watermark is limited by the 11 bits FIFO threshold, which
+ *          is expressed in 16 bits words.
+ *
+ * @{
+ */
+#define LSM6DSL_STREAM_NUMBER_OF_CHANNELS   6U
+
+#define LSM6DSL_STREAM_MAX_WATERMARK        341U
+/** @} */
+
 /**
  * @name   LSM6DSL communication interfaces related bit masks
  * @{
@@ -352,6 +366,67 @@
 #define LSMDSL_CTRL10_C_WRIST_TILT          (1 << 7)
 /** @} */
 
+/**
+ * @name    LSM6DSL_AD_FIFO_CTRL2 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_CTRL2_FTH_MASK          0x07
+/** @} */
+
+/**
+ * @name    LSM6DSL_AD_FIFO_CTRL3 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_XL0      (1 << 0)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_XL1      (1 << 1)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_XL2      (1 << 2)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_G0       (1 << 3)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_G1       (1 << 4)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_G2       (1 << 5)
+/** @} */
+
+/**
+ * @name    LSM6DSL_AD_FIFO_CTRL5 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_CTRL5_FIFO_MODE_MASK    0x07
+#define LSMDSL_FIFO_CTRL5_FIFO_MODE_BYPASS  0x00
+#define LSMDSL_FIFO_CTRL5_FIFO_MODE_CONT    0x06
+#define LSMDSL_FIFO_CTRL5_ODR_FIFO_MASK     0x78
+/** @} */
+
+/**
+ * @name    LSM6DSL_AD_FIFO_STATUS2 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_STATUS2_DIFF_FIFO_MASK  0x07
+#define LSMDSL_FIFO_STATUS2_FIFO_EMPTY      (1 << 4)
+#define LSMDSL_FIFO_STATUS2_FIFO_FULL_SMART (1 << 5)
+#define LSMDSL_FIFO_STATUS2_OVER_RUN        (1 << 6)
+#define LSMDSL_FIFO_STATUS2_WATERM          (1 << 7)
+/** @} */
+
+/**
+ * @name    LSM6DSL_AD_FIFO_STATUS4 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_STATUS4_PATTERN_MASK    0x03
+/** @} */
+
+/**
+ * @name    LSM6DSL_AD_INT1_CTRL register bits definitions
+ * @{
+ */
+#define LSMDSL_INT1_CTRL_DRDY_XL            (1 << 0)
+#define LSMDSL_INT1_CTRL_DRDY_G             (1 << 1)
+#define LSMDSL_INT1_CTRL_BOOT               (1 << 2)
+#define LSMDSL_INT1_CTRL_FTH                (1 << 3)
+#define LSMDSL_INT1_CTRL_FIFO_OVR           (1 << 4)
+#define LSMDSL_INT1_CTRL_FULL_FLAG          (1 << 5)
+#define LSMDSL_INT1_CTRL_SIGN_MOT           (1 << 6)
+#define LSMDSL_INT1_CTRL_STEP_DETECTOR      (1 << 7)
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -734,6 +809,8 @@ struct LSM6DSLDriver {
   BaseAccelerometer           acc_if;
   /** @brief Base gyroscope interface.*/
   BaseGyroscope               gyro_if;
+  /** @brief Base sensor stream interface.*/
+  BaseSensorStream            stream_if;
   _lsm6dsl_data
 };
 /** @} */
@@ -1036,6 +1113,88 @@ struct LSM6DSLDriver {
 #define lsm6dslGyroscopeSetFullScale(devp, fs)                              \
         (devp)->vmt->acc_set_full_scale(devp, fs)
 
+/**
+ * @brief   Enables the FIFO in continuous mode.
+ * @details The FIFO is emptied and then it collects gyroscope and
+ *          accelerometer samples at the accelerometer output data rate.
+ *          The FIFO threshold is routed to the INT1 pin.
+ * @note    Gyroscope and accelerometer must be configured with the same
+ *          output data rate.
+ *
+ * @param[in] devp      pointer to @p LSM6DSLDriver.
+ * @param[in] wm        watermark level, in samples
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ *
+ * @api
+ */
+#define lsm6dslStreamStart(devp, wm)                                        \
+        sensorStartStream(&((devp)->stream_if), wm)
+
+/**
+ * @brief   Disables the FIFO.
+ *
+ * @param[in] devp      pointer to @p LSM6DSLDriver.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ *
+ * @api
+ */
+#define lsm6dslStreamStop(devp)                                             \
+        sensorStopStream(&((devp)->stream_if))
+
+/**
+ * @brief   Reads a batch of raw samples from the FIFO.
+ * @note    The samples array must be at least @p n times
+ *          @p LSM6DSL_STREAM_NUMBER_OF_CHANNELS large.
+ *
+ * @param[in] devp      pointer to @p LSM6DSLDriver.
+ * @param[out] sp       a buffer which would be filled with raw samples.
+ * @param[in] n         maximum number of samples to be read
+ * @param[out] np       pointer to the number of samples actually read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ *
+ * @api
+ */
+#define lsm6dslStreamReadRaw(devp, sp, n, np)                               \
+        sensorReadBatchRaw(&((devp)->stream_if), sp, n, np)
+
+/**
+ * @brief   Reads a batch of fixed point cooked samples from the FIFO.
+ * @note    Gyroscope data is expressed as DPS and accelerometer data as
+ *          milli-G, both with @p SENSOR_FIXED_FRAC_BITS fractional bits.
+ * @note    The samples array must be at least @p n times
+ *          @p LSM6DSL_STREAM_NUMBER_OF_CHANNELS large.
+ *
+ * @param[in] devp      pointer to @p LSM6DSLDriver.
+ * @param[out] sp       a buffer which would be filled with cooked samples.
+ * @param[in] n         maximum number of samples to be read
+ * @param[out] np       pointer to the number of samples actually read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ *
+ * @api
+ */
+#define lsm6dslStreamReadFixed(devp, sp, n, np)                             \
+        sensorReadBatchFixed(&((devp)->stream_if), sp, n, np)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
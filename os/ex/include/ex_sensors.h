@@ -29,6 +29,28 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @name    Fixed point cooked samples
+ * @{
+ */
+/**
+ * @brief   Number of fractional bits of the fixed point cooked samples.
+ */
+#define SENSOR_FIXED_FRAC_BITS              16
+
+/**
+ * @brief   Fixed point representation of the unit value.
+ */
+#define SENSOR_FIXED_ONE                    (1 << SENSOR_FIXED_FRAC_BITS)
+
+/**
+ * @brief   Extra fractional bits of the fixed point sensitivities.
+ * @details Sensitivities are often much smaller than one, the extra bits
+ *          preserve their precision.
+ */
+#define SENSOR_FIXED_SENS_EXTRA_BITS        8
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -87,6 +109,57 @@ typedef struct {
   _base_sensor_data
 } BaseSensor;
 
+/**
+ * @brief   BaseSensorStream specific methods.
+ */
+#define _base_sensor_stream_methods_alone                                   \
+  /* Enables the FIFO with the specified watermark.*/                       \
+  msg_t (*start_stream)(void *instance, size_t watermark);                  \
+  /* Disables the FIFO.*/                                                   \
+  msg_t (*stop_stream)(void *instance);                                     \
+  /* Reads a batch of raw samples.*/                                        \
+  msg_t (*read_batch_raw)(void *instance, int32_t samples[], size_t n,      \
+                          size_t *np);                                      \
+  /* Reads a batch of samples cooked in fixed point.*/                      \
+  msg_t (*read_batch_fixed)(void *instance, int32_t samples[], size_t n,    \
+                            size_t *np);
+
+/**
+ * @brief   BaseSensorStream specific methods with inherited ones.
+ */
+#define _base_sensor_stream_methods                                         \
+  _base_sensor_methods                                                      \
+  _base_sensor_stream_methods_alone
+
+/**
+ * @brief   @p BaseSensorStream virtual methods table.
+ */
+struct BaseSensorStreamVMT {
+  _base_sensor_stream_methods
+};
+
+/**
+ * @brief   @p BaseSensorStream specific data.
+ */
+#define _base_sensor_stream_data                                            \
+  _base_sensor_data
+
+/**
+ * @extends BaseSensor
+ *
+ * @brief   Base sensor stream class.
+ * @details This class represents a sensor able to buffer samples in an
+ *          on-chip FIFO. Samples are retrieved in batches, each batch is
+ *          read from the device in a single bus transaction.
+ * @note    A sample is made of one value per channel, samples are stored
+ *          consecutively in the caller buffers.
+ */
+typedef struct {
+  /** @brief Virtual Methods Table.*/
+  const struct BaseSensorStreamVMT *vmt;
+  _base_sensor_stream_data
+} BaseSensorStream;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -134,6 +207,129 @@ typedef struct {
 #define sensorReadCooked(ip, dp) (ip)->vmt->read_cooked(ip, dp)
 /** @} */
 
+/**
+ * @name    Macro Functions (BaseSensorStream)
+ * @{
+ */
+/**
+ * @brief   Enables the sensor FIFO.
+ * @details The FIFO is emptied and then it starts collecting samples, the
+ *          device watermark signal is raised when @p wm samples are
+ *          buffered.
+ *
+ * @param[in] ip        pointer to a @p BaseSensorStream or derived class.
+ * @param[in] wm        watermark level, in samples
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorStartStream(ip, wm) (ip)->vmt->start_stream(ip, wm)
+
+/**
+ * @brief   Disables the sensor FIFO.
+ *
+ * @param[in] ip        pointer to a @p BaseSensorStream or derived class.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorStopStream(ip) (ip)->vmt->stop_stream(ip)
+
+/**
+ * @brief   Reads a batch of raw samples from the sensor FIFO.
+ * @details Up to @p n samples, as many as currently buffered, are read in
+ *          a single bus transaction.
+ * @note    The data array must be at least @p n times the number of
+ *          channels.
+ *
+ * @param[in] ip        pointer to a @p BaseSensorStream or derived class.
+ * @param[out] dp       pointer to a data array.
+ * @param[in] n         maximum number of samples to be read
+ * @param[out] np       pointer to the number of samples actually read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorReadBatchRaw(ip, dp, n, np)                                   \
+  (ip)->vmt->read_batch_raw(ip, dp, n, np)
+
+/**
+ * @brief   Reads a batch of cooked samples from the sensor FIFO.
+ * @details Like @p sensorReadBatchRaw() but the samples are converted in
+ *          cooked units with @p SENSOR_FIXED_FRAC_BITS fractional bits,
+ *          without using floating point arithmetic on the samples.
+ * @note    The data array must be at least @p n times the number of
+ *          channels.
+ *
+ * @param[in] ip        pointer to a @p BaseSensorStream or derived class.
+ * @param[out] dp       pointer to a data array.
+ * @param[in] n         maximum number of samples to be read
+ * @param[out] np       pointer to the number of samples actually read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorReadBatchFixed(ip, dp, n, np)                                 \
+  (ip)->vmt->read_batch_fixed(ip, dp, n, np)
+/** @} */
+
+/**
+ * @name    Fixed point conversion macros
+ * @{
+ */
+/**
+ * @brief   Converts a value to fixed point.
+ *
+ * @param[in] f         the value to be converted
+ * @return              The fixed point value.
+ */
+#define SENSOR_FLOAT2FIXED(f)                                               \
+  ((int32_t)((f) * (float)SENSOR_FIXED_ONE))
+
+/**
+ * @brief   Converts a fixed point value back to floating point.
+ *
+ * @param[in] x         the fixed point value
+ * @return              The floating point value.
+ */
+#define SENSOR_FIXED2FLOAT(x)                                               \
+  ((float)(x) / (float)SENSOR_FIXED_ONE)
+
+/**
+ * @brief   Converts a sensitivity to a fixed point scaling factor.
+ *
+ * @param[in] s         the sensitivity, in cooked units per LSB
+ * @return              The scaling factor.
+ */
+#define SENSOR_SENS2FIXED(s)                                                \
+  ((int32_t)((s) * (float)(SENSOR_FIXED_ONE << SENSOR_FIXED_SENS_EXTRA_BITS)))
+
+/**
+ * @brief   Cooks a raw value in fixed point.
+ * @details The formula is cooked = (raw * sensitivity) - bias.
+ *
+ * @param[in] raw       the raw value
+ * @param[in] sf        scaling factor from @p SENSOR_SENS2FIXED()
+ * @param[in] bf        fixed point bias from @p SENSOR_FLOAT2FIXED()
+ * @return              The fixed point cooked value.
+ */
+#define SENSOR_COOK_FIXED(raw, sf, bf)                                      \
+  ((int32_t)(((int64_t)(raw) * (int64_t)(sf)) >>                            \
+             SENSOR_FIXED_SENS_EXTRA_BITS) - (bf))
+/** @} */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
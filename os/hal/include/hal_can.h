@@ -62,6 +62,19 @@
  */
 #define CAN_ANY_MAILBOX             0U
 
+/**
+ * @brief   Extended identifier flag in normalized identifiers.
+ * @details Software filters and the transmit queue represent identifiers
+ *          as 32 bits values, standard identifiers are stored as-is while
+ *          extended identifiers have this bit set.
+ */
+#define CAN_SW_IDE                  0x80000000U
+
+/**
+ * @brief   Unused slot marker in the exact-match filters hash table.
+ */
+#define CAN_SW_ID_NONE              0xFFFFFFFFU
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -86,12 +99,66 @@
 #if !defined(CAN_ENFORCE_USE_CALLBACKS) || defined(__DOXYGEN__)
 #define CAN_ENFORCE_USE_CALLBACKS   FALSE
 #endif
+
+/**
+ * @brief   Software queues inclusion switch.
+ * @details If enabled then the received frames are moved by the driver
+ *          interrupt handler from the hardware mailboxes into a software
+ *          FIFO after passing the software filters, frames to be
+ *          transmitted can also be buffered in a software queue ordered
+ *          by CAN identifier.
+ * @note    When enabled the receive APIs ignore the mailbox parameter,
+ *          all frames are fetched from the software FIFO.
+ */
+#if !defined(CAN_USE_SW_QUEUES) || defined(__DOXYGEN__)
+#define CAN_USE_SW_QUEUES           FALSE
+#endif
+
+/**
+ * @brief   Size of the software receive FIFO in frames.
+ * @note    Must be a power of two.
+ */
+#if !defined(CAN_RX_FIFO_SIZE) || defined(__DOXYGEN__)
+#define CAN_RX_FIFO_SIZE            16
+#endif
+
+/**
+ * @brief   Size of the software transmit queue in frames.
+ */
+#if !defined(CAN_TX_QUEUE_SIZE) || defined(__DOXYGEN__)
+#define CAN_TX_QUEUE_SIZE           8
+#endif
+
+/**
+ * @brief   Size of the exact-match software filters hash table.
+ * @note    Must be a power of two, it is also the maximum number of
+ *          exact-match identifiers in a filters set.
+ */
+#if !defined(CAN_SW_FILTERS_HASH_SIZE) || defined(__DOXYGEN__)
+#define CAN_SW_FILTERS_HASH_SIZE    16
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if CAN_USE_SW_QUEUES == TRUE
+#if (CAN_RX_FIFO_SIZE < 2) ||                                               \
+    ((CAN_RX_FIFO_SIZE & (CAN_RX_FIFO_SIZE - 1)) != 0)
+#error "CAN_RX_FIFO_SIZE must be a power of two"
+#endif
+
+#if CAN_TX_QUEUE_SIZE < 1
+#error "invalid CAN_TX_QUEUE_SIZE value"
+#endif
+
+#if (CAN_SW_FILTERS_HASH_SIZE < 2) || (CAN_SW_FILTERS_HASH_SIZE > 65536) || \
+    ((CAN_SW_FILTERS_HASH_SIZE & (CAN_SW_FILTERS_HASH_SIZE - 1)) != 0)
+#error "CAN_SW_FILTERS_HASH_SIZE must be a power of two"
+#endif
+#endif /* CAN_USE_SW_QUEUES == TRUE */
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -108,6 +175,78 @@ typedef enum {
   CAN_SLEEP = 5                             /**< Sleep state.               */
 } canstate_t;
 
+/**
+ * @brief   Software mask filter.
+ * @details A frame is accepted if its normalized identifier matches
+ *          @p id in all the bits set in @p mask, include @p CAN_SW_IDE
+ *          in the mask in order to discriminate the identifier type.
+ */
+typedef struct {
+  /**
+   * @brief   Normalized identifier to be matched.
+   */
+  uint32_t                  id;
+  /**
+   * @brief   Bits of the identifier to be compared.
+   */
+  uint32_t                  mask;
+} CANSwMask;
+
+/**
+ * @brief   Software filters set.
+ * @details A frame is accepted if its identifier is found in the
+ *          exact-match list or if it matches any of the mask filters.
+ */
+typedef struct {
+  /**
+   * @brief   Exact-match normalized identifiers.
+   */
+  const uint32_t            *ids;
+  /**
+   * @brief   Number of exact-match identifiers.
+   */
+  size_t                    nids;
+  /**
+   * @brief   Mask filters.
+   */
+  const CANSwMask           *masks;
+  /**
+   * @brief   Number of mask filters.
+   */
+  size_t                    nmasks;
+} CANSwFilters;
+
+#if (CAN_USE_SW_QUEUES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   @p CANDriver software queues fields.
+ * @note    This macro is expanded by the low level driver inside the
+ *          @p CANDriver structure.
+ */
+#define _can_sw_queues_data                                                 \
+  /* Active software filters or NULL.*/                                     \
+  const CANSwFilters        *swfilters;                                     \
+  /* Exact-match identifiers hash table.*/                                  \
+  uint32_t                  swhash[CAN_SW_FILTERS_HASH_SIZE];               \
+  /* Received frames FIFO.*/                                                \
+  CANRxFrame                rxfifo[CAN_RX_FIFO_SIZE];                       \
+  /* Reception time stamps of the frames in the FIFO.*/                     \
+  systime_t                 rxtime[CAN_RX_FIFO_SIZE];                       \
+  /* FIFO read counter.*/                                                   \
+  size_t                    rxrd;                                           \
+  /* FIFO write counter.*/                                                  \
+  size_t                    rxwr;                                           \
+  /* Frames lost because FIFO overflows.*/                                  \
+  size_t                    rxlost;                                         \
+  /* Transmit queue, the highest priority frame is the last one.*/          \
+  CANTxFrame                txq[CAN_TX_QUEUE_SIZE];                         \
+  /* Arbitration keys of the frames in the transmit queue.*/                \
+  uint32_t                  txkey[CAN_TX_QUEUE_SIZE];                       \
+  /* Number of frames in the transmit queue.*/                              \
+  size_t                    txcnt;
+#else
+#define _can_sw_queues_data
+#endif
+
 #include "hal_can_lld.h"
 
 /*===========================================================================*/
@@ -123,6 +262,44 @@ typedef enum {
  */
 #define CAN_MAILBOX_TO_MASK(mbx) (1U << ((mbx) - 1U))
 
+/**
+ * @brief   Normalized standard identifier.
+ *
+ * @param[in] sid       standard identifier
+ */
+#define CAN_SW_SID(sid) ((uint32_t)(sid))
+
+/**
+ * @brief   Normalized extended identifier.
+ *
+ * @param[in] eid       extended identifier
+ */
+#define CAN_SW_EID(eid) ((uint32_t)(eid) | CAN_SW_IDE)
+
+#if !defined(CAN_LLD_RX_ID) || defined(__DOXYGEN__)
+/**
+ * @brief   Normalized identifier of a received frame.
+ * @note    Low level drivers with a different frame layout override this
+ *          macro.
+ *
+ * @param[in] crfp      pointer to a @p CANRxFrame
+ */
+#define CAN_LLD_RX_ID(crfp)                                                 \
+  (((crfp)->IDE != 0U) ? CAN_SW_EID((crfp)->EID) : CAN_SW_SID((crfp)->SID))
+#endif
+
+#if !defined(CAN_LLD_TX_ID) || defined(__DOXYGEN__)
+/**
+ * @brief   Normalized identifier of a frame to be transmitted.
+ * @note    Low level drivers with a different frame layout override this
+ *          macro.
+ *
+ * @param[in] ctfp      pointer to a @p CANTxFrame
+ */
+#define CAN_LLD_TX_ID(ctfp)                                                 \
+  (((ctfp)->IDE != 0U) ? CAN_SW_EID((ctfp)->EID) : CAN_SW_SID((ctfp)->SID))
+#endif
+
 /**
  * @brief   Legacy name for @p canTransmitTimeout().
  *
@@ -144,10 +321,20 @@ typedef enum {
  * @name    Low level driver helper macros
  * @{
  */
-#if (CAN_ENFORCE_USE_CALLBACKS == FALSE) || defined(__DOXYGEN__)
+#if (CAN_USE_SW_QUEUES == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   TX mailbox empty event.
  */
+#define _can_tx_empty_isr(canp, flags) _can_sw_tx_empty_isr(canp, flags)
+
+/**
+ * @brief   RX mailbox empty full event.
+ */
+#define _can_rx_full_isr(canp, flags) _can_sw_rx_full_isr(canp, flags)
+#endif
+
+#if (CAN_ENFORCE_USE_CALLBACKS == FALSE) || defined(__DOXYGEN__)
+#if (CAN_USE_SW_QUEUES == FALSE) && !defined(__DOXYGEN__)
 #define _can_tx_empty_isr(canp, flags) {                                    \
   osalSysLockFromISR();                                                     \
   osalThreadDequeueAllI(&(canp)->txqueue, MSG_OK);                          \
@@ -155,15 +342,13 @@ typedef enum {
   osalSysUnlockFromISR();                                                   \
 }
 
-/**
- * @brief   RX mailbox empty full event.
- */
 #define _can_rx_full_isr(canp, flags) {                                     \
   osalSysLockFromISR();                                                     \
   osalThreadDequeueAllI(&(canp)->rxqueue, MSG_OK);                          \
   osalEventBroadcastFlagsI(&(canp)->rxfull_event, flags);                   \
   osalSysUnlockFromISR();                                                   \
 }
+#endif
 
 /**
  * @brief   Wakeup event.
@@ -183,6 +368,7 @@ typedef enum {
   osalSysUnlockFromISR();                                                   \
 }
 #else /* CAN_ENFORCE_USE_CALLBACKS == TRUE */
+#if CAN_USE_SW_QUEUES == FALSE
 #define _can_tx_empty_isr(canp, flags) {                                    \
   if ((canp)->txempty_cb != NULL) {                                         \
     (canp)->txempty_cb(canp, flags);                                        \
@@ -200,6 +386,7 @@ typedef enum {
   osalThreadDequeueAllI(&(canp)->rxqueue, MSG_OK);                          \
   osalSysUnlockFromISR();                                                   \
 }
+#endif
 
 #define _can_wakeup_isr(canp) {                                             \
   if ((canp)->wakeup_cb != NULL) {                                          \
@@ -246,6 +433,20 @@ extern "C" {
   void canSleep(CANDriver *canp);
   void canWakeup(CANDriver *canp);
 #endif
+#if CAN_USE_SW_QUEUES == TRUE
+  msg_t canSetSoftwareFilters(CANDriver *canp, const CANSwFilters *swfp);
+  size_t canReceiveManyTimeout(CANDriver *canp,
+                               CANRxFrame *crfp,
+                               systime_t *tsp,
+                               size_t n,
+                               sysinterval_t timeout);
+  bool canTryQueueTransmitI(CANDriver *canp, const CANTxFrame *ctfp);
+  msg_t canQueueTransmitTimeout(CANDriver *canp,
+                                const CANTxFrame *ctfp,
+                                sysinterval_t timeout);
+  void _can_sw_tx_empty_isr(CANDriver *canp, uint32_t flags);
+  void _can_sw_rx_full_isr(CANDriver *canp, uint32_t flags);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -132,12 +132,41 @@
 #if !defined(PAL_USE_WAIT) || defined(__DOXYGEN__)
 #define PAL_USE_WAIT                TRUE
 #endif
+
+/**
+ * @brief   Enables the edges capture APIs.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(PAL_USE_CAPTURE) || defined(__DOXYGEN__)
+#define PAL_USE_CAPTURE             FALSE
+#endif
+
+/**
+ * @brief   Timestamp source for captured edges.
+ * @note    The default is the OS realtime counter, it can be redefined to
+ *          a faster free running counter, the returned type must be
+ *          @p rtcnt_t.
+ * @note    If the port has no realtime counter then the default is the
+ *          system time, edges closer than one system tick get the same
+ *          timestamp.
+ */
+#if !defined(PAL_CAPTURE_GET_TIMESTAMP) || defined(__DOXYGEN__)
+#if (PORT_SUPPORTS_RT == TRUE) || defined(__DOXYGEN__)
+#define PAL_CAPTURE_GET_TIMESTAMP() osalSysGetRealtimeCounterX()
+#else
+#define PAL_CAPTURE_GET_TIMESTAMP() ((rtcnt_t)osalOsGetSystemTimeX())
+#endif
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (PAL_USE_CAPTURE == TRUE) && (PAL_USE_CALLBACKS == FALSE)
+#error "PAL_USE_CAPTURE requires PAL_USE_CALLBACKS"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -197,6 +226,76 @@ typedef struct {
   uint_fast8_t          offset;
 } IOBus;
 
+#if (PAL_USE_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a captured edge record.
+ */
+typedef struct {
+  /**
+   * @brief   Edge timestamp.
+   */
+  rtcnt_t               time;
+  /**
+   * @brief   Line where the edge has been detected.
+   */
+  ioline_t              line;
+  /**
+   * @brief   Edge type, @p PAL_EVENT_MODE_RISING_EDGE or
+   *          @p PAL_EVENT_MODE_FALLING_EDGE.
+   */
+  uint32_t              edge;
+} palcaprecord_t;
+
+/**
+ * @brief   Type of a line edges capture object.
+ * @details Edges are recorded in a ring buffer from the line event ISR,
+ *          the consumer thread is only woken when the records reach the
+ *          watermark.
+ */
+typedef struct {
+  /**
+   * @brief   Captured line.
+   */
+  ioline_t              line;
+  /**
+   * @brief   Line event mode.
+   */
+  uint32_t              mode;
+  /**
+   * @brief   Records buffer.
+   */
+  palcaprecord_t        *buffer;
+  /**
+   * @brief   Size of the records buffer.
+   */
+  size_t                size;
+  /**
+   * @brief   Number of records triggering the consumer wakeup.
+   */
+  size_t                watermark;
+  /**
+   * @brief   Records counter.
+   */
+  volatile size_t       counter;
+  /**
+   * @brief   Write index.
+   */
+  size_t                wridx;
+  /**
+   * @brief   Read index.
+   */
+  size_t                rdidx;
+  /**
+   * @brief   Edges lost because the buffer was full.
+   */
+  uint32_t              overflows;
+  /**
+   * @brief   Waiting consumer thread.
+   */
+  thread_reference_t    thread;
+} palcapture_t;
+#endif /* PAL_USE_CAPTURE == TRUE */
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -295,7 +394,7 @@ typedef struct {
  */
 #define _pal_clear_event(e)                                                 \
   do {                                                                      \
-    osalThreadDequeueAllI(&_pal_events[pad].threads, MSG_RESET);            \
+    osalThreadDequeueAllI(&_pal_events[e].threads, MSG_RESET);              \
     _pal_events[e].cb = NULL;                                               \
     _pal_events[e].arg = NULL;                                              \
   } while (false)
@@ -312,7 +411,7 @@ typedef struct {
 #if (PAL_USE_CALLBACKS == FALSE) && (PAL_USE_WAIT == TRUE)
 #define _pal_clear_event(e)                                                 \
   do {                                                                      \
-    osalThreadDequeueAllI(&_pal_events[pad].threads, MSG_RESET);            \
+    osalThreadDequeueAllI(&_pal_events[e].threads, MSG_RESET);              \
   } while (false)
 #endif /* (PAL_USE_CALLBACKS == FALSE) && (PAL_USE_WAIT == TRUE) */
 
@@ -1015,6 +1114,28 @@ typedef struct {
   } while (false)
 #endif /* PAL_USE_CALLBACKS == TRUE */
 
+#if (PAL_USE_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the number of records in a capture buffer.
+ *
+ * @param[in] cp        pointer to a @p palcapture_t object
+ * @return              The number of records.
+ *
+ * @iclass
+ */
+#define palCaptureGetCountI(cp) ((cp)->counter)
+
+/**
+ * @brief   Returns the number of edges lost because of a full buffer.
+ *
+ * @param[in] cp        pointer to a @p palcapture_t object
+ * @return              The number of lost edges.
+ *
+ * @xclass
+ */
+#define palCaptureGetOverflowsX(cp) ((cp)->overflows)
+#endif /* PAL_USE_CAPTURE == TRUE */
+
 /** @} */
 
 /*===========================================================================*/
@@ -1040,6 +1161,17 @@ extern "C" {
   msg_t palWaitLineTimeoutS(ioline_t line, sysinterval_t timeout);
   msg_t palWaitLineTimeout(ioline_t line, sysinterval_t timeout);
 #endif /* PAL_USE_WAIT == TRUE */
+#if (PAL_USE_CAPTURE == TRUE) || defined(__DOXYGEN__)
+  void palCaptureObjectInit(palcapture_t *cp, palcaprecord_t *buffer,
+                            size_t size, size_t watermark);
+  void palCaptureStartI(palcapture_t *cp, ioline_t line, uint32_t mode);
+  void palCaptureStart(palcapture_t *cp, ioline_t line, uint32_t mode);
+  void palCaptureStopI(palcapture_t *cp);
+  void palCaptureStop(palcapture_t *cp);
+  size_t palCaptureReadI(palcapture_t *cp, palcaprecord_t *rp, size_t n);
+  size_t palCaptureReadTimeout(palcapture_t *cp, palcaprecord_t *rp,
+                               size_t n, sysinterval_t timeout);
+#endif /* PAL_USE_CAPTURE == TRUE */
 #ifdef __cplusplus
 }
 #endif
@@ -308,6 +308,13 @@ extern "C" {
   size_t iqReadI(input_queue_t *iqp, uint8_t *bp, size_t n);
   size_t iqReadTimeout(input_queue_t *iqp, uint8_t *bp,
                        size_t n, sysinterval_t timeout);
+  uint8_t *iqGetEmptySpanI(input_queue_t *iqp, size_t *np);
+  void iqPostFullSpanI(input_queue_t *iqp, size_t n);
+  msg_t iqGetFullSpanTimeout(input_queue_t *iqp, uint8_t **bpp, size_t *np,
+                             sysinterval_t timeout);
+  void iqReleaseEmptySpanI(input_queue_t *iqp, size_t n);
+  void iqReleaseEmptySpan(input_queue_t *iqp, size_t n);
+  msg_t iqPeekI(input_queue_t *iqp, size_t offset);
 
   void oqObjectInit(output_queue_t *oqp, uint8_t *bp, size_t size,
                     qnotify_t onfy, void *link);
@@ -318,6 +325,12 @@ extern "C" {
   size_t oqWriteI(output_queue_t *oqp, const uint8_t *bp, size_t n);
   size_t oqWriteTimeout(output_queue_t *oqp, const uint8_t *bp,
                         size_t n, sysinterval_t timeout);
+  msg_t oqGetEmptySpanTimeout(output_queue_t *oqp, uint8_t **bpp, size_t *np,
+                              sysinterval_t timeout);
+  void oqPostFullSpanI(output_queue_t *oqp, size_t n);
+  void oqPostFullSpan(output_queue_t *oqp, size_t n);
+  uint8_t *oqGetFullSpanI(output_queue_t *oqp, size_t *np);
+  void oqReleaseEmptySpanI(output_queue_t *oqp, size_t n);
 #ifdef __cplusplus
 }
 #endif
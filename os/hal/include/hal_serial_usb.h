@@ -59,6 +59,27 @@
 #if !defined(SERIAL_USB_BUFFERS_NUMBER) || defined(__DOXYGEN__)
 #define SERIAL_USB_BUFFERS_NUMBER   2
 #endif
+
+/**
+ * @brief   Enables the zero-copy transmit API.
+ * @details If enabled then application-owned buffers can be submitted
+ *          for transmission directly on the bulk IN endpoint without
+ *          being copied into the output buffers queue.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(SERIAL_USB_USE_SUBMIT) || defined(__DOXYGEN__)
+#define SERIAL_USB_USE_SUBMIT       FALSE
+#endif
+
+/**
+ * @brief   Maximum size of a single USB transfer for submitted buffers.
+ * @details Larger submitted buffers are transmitted as multiple transfers
+ *          in order to not exceed the limits of the USB low level drivers.
+ * @note    Must be a multiple of the bulk IN endpoint maximum packet size.
+ */
+#if !defined(SERIAL_USB_MAX_TRANSFER) || defined(__DOXYGEN__)
+#define SERIAL_USB_MAX_TRANSFER     16384
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -69,6 +90,10 @@
 #error "Serial over USB Driver requires HAL_USE_USB"
 #endif
 
+#if (SERIAL_USB_USE_SUBMIT == TRUE) && ((SERIAL_USB_MAX_TRANSFER % 512) != 0)
+#error "SERIAL_USB_MAX_TRANSFER must be a multiple of 512"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -113,6 +138,70 @@ typedef struct {
   usbep_t                   int_in;
 } SerialUSBConfig;
 
+#if (SERIAL_USB_USE_SUBMIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a submitted transmit buffer descriptor.
+ */
+typedef struct sdu_txbuffer sdu_txbuffer_t;
+
+/**
+ * @brief   Type of a submitted buffer completion callback.
+ * @note    The callback is invoked with the kernel locked, from the
+ *          transmit interrupt or when pending buffers are discarded, only
+ *          I-class functions can be used.
+ * @note    The callback is invoked after the next transfer has been
+ *          started, the buffer can be submitted again from within the
+ *          callback.
+ *
+ * @param[in] sdup      pointer to the @p SerialUSBDriver object
+ * @param[in] txbp      pointer to the released buffer descriptor
+ */
+typedef void (*sdutxcb_t)(SerialUSBDriver *sdup, sdu_txbuffer_t *txbp);
+
+/**
+ * @brief   Structure representing a submitted transmit buffer.
+ * @details The descriptor and the data it points to are owned by the
+ *          driver from submission until the completion callback.
+ */
+struct sdu_txbuffer {
+  /**
+   * @brief   Next submitted buffer.
+   */
+  sdu_txbuffer_t            *next;
+  /**
+   * @brief   Data to be transmitted.
+   */
+  const uint8_t             *buf;
+  /**
+   * @brief   Size of the data, cannot be zero.
+   */
+  size_t                    size;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  sdutxcb_t                 cb;
+  /**
+   * @brief   Completion status.
+   * @details @p MSG_OK if the data has been transmitted, @p MSG_RESET if
+   *          the buffer has been discarded because a USB reset or the
+   *          driver has been stopped.
+   */
+  msg_t                     status;
+};
+
+#define _serial_usb_submit_data                                             \
+  /* Submitted buffers list, the head is the one being transmitted.*/       \
+  sdu_txbuffer_t            *txhead;                                        \
+  /* Submitted buffers list tail.*/                                         \
+  sdu_txbuffer_t            *txtail;                                        \
+  /* Amount of the head buffer already transmitted.*/                       \
+  size_t                    txoffset;                                       \
+  /* The ongoing transfer belongs to the head buffer.*/                     \
+  bool                      txsubmitted;
+#else
+#define _serial_usb_submit_data
+#endif
+
 /**
  * @brief   @p SerialDriver specific data.
  */
@@ -130,6 +219,7 @@ typedef struct {
   /* Output buffer.*/                                                       \
   uint8_t                   ob[BQ_BUFFER_SIZE(SERIAL_USB_BUFFERS_NUMBER,    \
                                               SERIAL_USB_BUFFERS_SIZE)];    \
+  _serial_usb_submit_data                                                   \
   /* End of the mandatory fields.*/                                         \
   /* Current configuration data.*/                                          \
   const SerialUSBConfig     *config;
@@ -166,6 +256,46 @@ struct SerialUSBDriver {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @name    Macro Functions
+ * @{
+ */
+/**
+ * @brief   Gets an empty buffer from the output queue.
+ * @details The buffer can be filled in place and then posted using
+ *          @p sduPostFullBuffer(), the buffer is pointed by the output
+ *          queue @p ptr field and its size is @p SERIAL_USB_BUFFERS_SIZE.
+ * @note    Must not be mixed with stream writes on the same driver without
+ *          flushing the output queue first.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been acquired.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the queue has been reset or has been put in
+ *                      suspended state.
+ *
+ * @api
+ */
+#define sduGetEmptyBufferTimeout(sdup, timeout)                             \
+  obqGetEmptyBufferTimeout(&(sdup)->obqueue, timeout)
+
+/**
+ * @brief   Posts a buffer obtained with @p sduGetEmptyBufferTimeout().
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[in] size      used size of the buffer, cannot be zero
+ *
+ * @api
+ */
+#define sduPostFullBuffer(sdup, size)                                       \
+  obqPostFullBuffer(&(sdup)->obqueue, size)
+/** @} */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -186,6 +316,10 @@ extern "C" {
   void sduDataReceived(USBDriver *usbp, usbep_t ep);
   void sduInterruptTransmitted(USBDriver *usbp, usbep_t ep);
   msg_t sduControl(USBDriver *usbp, unsigned int operation, void *arg);
+#if SERIAL_USB_USE_SUBMIT == TRUE
+  msg_t sduSubmitTransmitI(SerialUSBDriver *sdup, sdu_txbuffer_t *txbp);
+  msg_t sduSubmitTransmit(SerialUSBDriver *sdup, sdu_txbuffer_t *txbp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,7 @@
 #include "hal.h"
 
 #include "hal_mfs.h"
+#include "crc.h"
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -62,6 +63,35 @@
 #define ALIGNED_SIZEOF(t)                                                   \
   (((sizeof (t) - 1U) | MFS_ALIGN_MASK) + 1U)
 
+/**
+ * @brief   Data header magic 2 value and identifier type.
+ */
+#if MFS_CFG_SPARSE_IDS == TRUE
+#define DHDR_MAGIC_2        (uint16_t)MFS_HEADER_MAGIC_2
+#define DHDR_ID_TYPE        uint32_t
+#else
+#define DHDR_MAGIC_2        (uint32_t)MFS_HEADER_MAGIC_2
+#define DHDR_ID_TYPE        uint16_t
+#endif
+
+/**
+ * @brief   Bank magic 2 value for the configured on-flash format.
+ */
+#if MFS_CFG_SPARSE_IDS == TRUE
+#define BANK_MAGIC_2        MFS_BANK_MAGIC_2_SPARSE
+#else
+#define BANK_MAGIC_2        MFS_BANK_MAGIC_2
+#endif
+
+/**
+ * @brief   Number of descriptors to be visited when scanning records.
+ */
+#if MFS_CFG_SPARSE_IDS == TRUE
+#define DESCRIPTORS_NUM(mfsp)   ((unsigned)(mfsp)->records)
+#else
+#define DESCRIPTORS_NUM(mfsp)   ((unsigned)MFS_CFG_MAX_RECORDS)
+#endif
+
 /**
  * @brief   Combines two values (0..3) in one (0..15).
  */
@@ -105,56 +135,10 @@ static void mfs_flash_release(MFSDriver *mfsp) {
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
-static const uint16_t crc16_table[256] = {
-  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
-  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
-  0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
-  0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
-  0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
-  0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
-  0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
-  0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
-  0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-  0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
-  0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
-  0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
-  0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
-  0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
-  0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
-  0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
-  0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
-  0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-  0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
-  0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
-  0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
-  0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
-  0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
-  0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
-  0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
-  0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
-  0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-  0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
-  0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
-  0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
-  0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
-  0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
-};
-
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
-uint16_t crc16(uint16_t crc, const uint8_t *data, size_t n) {
-
-  while (n > 0U) {
-    crc = (crc << 8U) ^ crc16_table[(crc >> 8U) ^ (uint16_t)*data];
-    data++;
-    n--;
-  }
-
-  return crc;
-}
-
 static void mfs_state_reset(MFSDriver *mfsp) {
   unsigned i;
 
@@ -169,10 +153,219 @@ static void mfs_state_reset(MFSDriver *mfsp) {
   mfsp->tr_limit_offset = 0U;
 #endif
 
+#if MFS_CFG_SPARSE_IDS == TRUE
+  mfsp->records = 0U;
+  for (i = 0; i < MFS_INDEX_SIZE; i++) {
+    mfsp->index[i] = 0U;
+  }
+#else
   for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
     mfsp->descriptors[i].offset = 0U;
     mfsp->descriptors[i].size   = 0U;
   }
+#endif
+}
+
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash function for record identifiers.
+ *
+ * @param[in] id        record identifier
+ * @return              The initial index slot for the identifier.
+ *
+ * @notapi
+ */
+static inline uint32_t mfs_index_hash(mfs_id_t id) {
+  uint32_t h = (uint32_t)id * 0x9E3779B1U;
+
+  return (h ^ (h >> 16U)) & MFS_INDEX_MASK;
+}
+
+/**
+ * @brief   Locates the index slot of a record.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ * @return              The slot containing the record or the empty slot
+ *                      where the record would be inserted.
+ *
+ * @notapi
+ */
+static uint32_t mfs_index_lookup(MFSDriver *mfsp, mfs_id_t id) {
+  uint32_t slot = mfs_index_hash(id);
+
+  /* Linear probing, the index is never full so an empty slot is always
+     found.*/
+  while (mfsp->index[slot] != 0U) {
+    if (mfsp->descriptors[mfsp->index[slot] - 1U].id == id) {
+      break;
+    }
+    slot = (slot + 1U) & MFS_INDEX_MASK;
+  }
+
+  return slot;
+}
+
+/**
+ * @brief   Empties an index slot.
+ * @details Following entries of the same probe sequence are moved back in
+ *          order to not break lookups of other records.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] slot      slot to be emptied
+ *
+ * @notapi
+ */
+static void mfs_index_remove(MFSDriver *mfsp, uint32_t slot) {
+  uint32_t next = slot;
+
+  while (true) {
+    uint32_t home;
+
+    next = (next + 1U) & MFS_INDEX_MASK;
+    if (mfsp->index[next] == 0U) {
+      break;
+    }
+
+    /* The entry can be moved into the hole only if its home slot is not
+       cyclically located between the hole and the entry itself.*/
+    home = mfs_index_hash(mfsp->descriptors[mfsp->index[next] - 1U].id);
+    if (((next - home) & MFS_INDEX_MASK) >= ((next - slot) & MFS_INDEX_MASK)) {
+      mfsp->index[slot] = mfsp->index[next];
+      slot = next;
+    }
+  }
+
+  mfsp->index[slot] = 0U;
+}
+#endif /* MFS_CFG_SPARSE_IDS == TRUE */
+
+/**
+ * @brief   Retrieves the descriptor of a live record.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ * @return              Pointer to the record descriptor.
+ * @retval NULL         if the record does not exist.
+ *
+ * @notapi
+ */
+static mfs_record_descriptor_t *mfs_record_find(MFSDriver *mfsp,
+                                                mfs_id_t id) {
+#if MFS_CFG_SPARSE_IDS == TRUE
+  uint32_t slot = mfs_index_lookup(mfsp, id);
+
+  if (mfsp->index[slot] == 0U) {
+    return NULL;
+  }
+
+  return &mfsp->descriptors[mfsp->index[slot] - 1U];
+#else
+  if (mfsp->descriptors[id - 1U].offset == 0U) {
+    return NULL;
+  }
+
+  return &mfsp->descriptors[id - 1U];
+#endif
+}
+
+/**
+ * @brief   Checks if there is room for a record.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ * @param[in] pending   records possibly created by pending operations
+ * @return              The space availability.
+ *
+ * @notapi
+ */
+static bool mfs_record_has_room(MFSDriver *mfsp, mfs_id_t id,
+                                uint32_t pending) {
+#if MFS_CFG_SPARSE_IDS == TRUE
+  return (mfsp->records + pending < (uint32_t)MFS_CFG_MAX_RECORDS) ||
+         (mfs_record_find(mfsp, id) != NULL);
+#else
+  (void)mfsp;
+  (void)id;
+  (void)pending;
+
+  return true;
+#endif
+}
+
+/**
+ * @brief   Creates or updates the descriptor of a record.
+ * @pre     There must be room for the record, see
+ *          @p mfs_record_has_room().
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ * @param[in] offset    offset of the record header
+ * @param[in] size      record data size
+ *
+ * @notapi
+ */
+static void mfs_record_update(MFSDriver *mfsp, mfs_id_t id,
+                              flash_offset_t offset, uint32_t size) {
+  mfs_record_descriptor_t *dp;
+
+#if MFS_CFG_SPARSE_IDS == TRUE
+  uint32_t slot = mfs_index_lookup(mfsp, id);
+
+  if (mfsp->index[slot] == 0U) {
+    osalDbgAssert(mfsp->records < (uint32_t)MFS_CFG_MAX_RECORDS,
+                  "no room");
+
+    /* New record, it is appended to the live descriptors.*/
+    dp = &mfsp->descriptors[mfsp->records];
+    dp->id = id;
+    mfsp->records++;
+    mfsp->index[slot] = (uint16_t)mfsp->records;
+  }
+  else {
+    dp = &mfsp->descriptors[mfsp->index[slot] - 1U];
+  }
+#else
+  dp = &mfsp->descriptors[id - 1U];
+#endif
+
+  dp->offset = offset;
+  dp->size   = size;
+}
+
+/**
+ * @brief   Removes the descriptor of a record.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ *
+ * @notapi
+ */
+static void mfs_record_remove(MFSDriver *mfsp, mfs_id_t id) {
+#if MFS_CFG_SPARSE_IDS == TRUE
+  uint32_t slot, pos, last;
+
+  slot = mfs_index_lookup(mfsp, id);
+  if (mfsp->index[slot] == 0U) {
+    return;
+  }
+
+  pos = mfsp->index[slot] - 1U;
+  mfs_index_remove(mfsp, slot);
+
+  /* Keeping the live descriptors contiguous by moving the last one in the
+     freed position.*/
+  last = mfsp->records - 1U;
+  if (pos != last) {
+    mfsp->descriptors[pos] = mfsp->descriptors[last];
+    slot = mfs_index_lookup(mfsp, mfsp->descriptors[pos].id);
+    mfsp->index[slot] = (uint16_t)(pos + 1U);
+  }
+  mfsp->records = last;
+#else
+  mfsp->descriptors[id - 1U].offset = 0U;
+  mfsp->descriptors[id - 1U].size   = 0U;
+#endif
 }
 
 static flash_offset_t mfs_flash_get_bank_offset(MFSDriver *mfsp,
@@ -427,7 +620,7 @@ static mfs_error_t mfs_bank_write_header(MFSDriver *mfsp,
   }
 
   mfsp->ncbuf->bhdr.fields.magic1    = MFS_BANK_MAGIC_1;
-  mfsp->ncbuf->bhdr.fields.magic2    = MFS_BANK_MAGIC_2;
+  mfsp->ncbuf->bhdr.fields.magic2    = BANK_MAGIC_2;
   mfsp->ncbuf->bhdr.fields.counter   = cnt;
   mfsp->ncbuf->bhdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
   mfsp->ncbuf->bhdr.fields.crc       = crc16(0xFFFFU,
@@ -460,7 +653,7 @@ static mfs_bank_state_t mfs_bank_check_header(MFSDriver *mfsp) {
 
   /* Checking header fields integrity.*/
   if ((mfsp->ncbuf->bhdr.fields.magic1 != MFS_BANK_MAGIC_1) ||
-      (mfsp->ncbuf->bhdr.fields.magic2 != MFS_BANK_MAGIC_2) ||
+      (mfsp->ncbuf->bhdr.fields.magic2 != BANK_MAGIC_2) ||
       (mfsp->ncbuf->bhdr.fields.counter == mfsp->config->erased) ||
       (mfsp->ncbuf->bhdr.fields.reserved1 != (uint16_t)mfsp->config->erased)) {
     return MFS_BANK_GARBAGE;
@@ -521,9 +714,8 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
 
     /* It is not erased so checking for integrity.*/
     if ((mfsp->ncbuf->dhdr.fields.magic1 != MFS_HEADER_MAGIC_1) ||
-        (mfsp->ncbuf->dhdr.fields.magic2 != MFS_HEADER_MAGIC_2) ||
-        (mfsp->ncbuf->dhdr.fields.id < 1U) ||
-        (mfsp->ncbuf->dhdr.fields.id > (uint32_t)MFS_CFG_MAX_RECORDS) ||
+        (mfsp->ncbuf->dhdr.fields.magic2 != DHDR_MAGIC_2) ||
+        !MFS_IS_VALID_ID(mfsp->ncbuf->dhdr.fields.id) ||
         (mfsp->ncbuf->dhdr.fields.size > end_offset - hdr_offset)) {
       *wflagp = true;
       break;
@@ -562,12 +754,16 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
     else {
       /* Zero-sized records are erase markers.*/
       if (dhdr.fields.size == 0U) {
-        mfsp->descriptors[dhdr.fields.id - 1U].offset = 0U;
-        mfsp->descriptors[dhdr.fields.id - 1U].size   = 0U;
+        mfs_record_remove(mfsp, dhdr.fields.id);
       }
       else {
-        mfsp->descriptors[dhdr.fields.id - 1U].offset = hdr_offset;
-        mfsp->descriptors[dhdr.fields.id - 1U].size   = dhdr.fields.size;
+        /* Records exceeding the index capacity cannot be written by this
+           driver instance, it is a configuration mismatch.*/
+        if (!mfs_record_has_room(mfsp, dhdr.fields.id, 0U)) {
+          return MFS_ERR_OUT_OF_MEM;
+        }
+        mfs_record_update(mfsp, dhdr.fields.id,
+                          hdr_offset, dhdr.fields.size);
       }
     }
 
@@ -653,7 +849,7 @@ static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
                 ALIGNED_SIZEOF(mfs_bank_header_t);
 
   /* Copying the most recent record instances only.*/
-  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+  for (i = 0; i < DESCRIPTORS_NUM(mfsp); i++) {
     uint32_t totsize = ALIGNED_REC_SIZE(mfsp->descriptors[i].size);
     if (mfsp->descriptors[i].offset != 0) {
       RET_ON_ERROR(mfs_flash_copy(mfsp, dest_offset,
@@ -801,7 +997,7 @@ static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
 
     /* Calculating the effective used size.*/
     mfsp->used_space = ALIGNED_SIZEOF(mfs_bank_header_t);
-    for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+    for (i = 0; i < DESCRIPTORS_NUM(mfsp); i++) {
       if (mfsp->descriptors[i].offset != 0U) {
         mfsp->used_space += ALIGNED_REC_SIZE(mfsp->descriptors[i].size);
       }
@@ -844,9 +1040,9 @@ mfs_error_t mfs_mount(MFSDriver *mfsp) {
     mfs_error_t err;
 
     err = mfs_try_mount(mfsp);
-    if (err == MFS_ERR_INTERNAL) {
-      /* Special case, do not retry on internal errors but report
-         immediately.*/
+    if ((err == MFS_ERR_INTERNAL) || (err == MFS_ERR_OUT_OF_MEM)) {
+      /* Special case, do not retry on internal errors or on records
+         exceeding the configured capacity but report immediately.*/
       mfsp->state = MFS_ERROR;
       return err;
     }
@@ -963,7 +1159,8 @@ mfs_error_t mfsErase(MFSDriver *mfsp) {
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] id        record numeric identifier, the valid range is between
- *                      @p 1 and @p MFS_CFG_MAX_RECORDS
+ *                      @p 1 and @p MFS_CFG_MAX_RECORDS, in sparse mode it
+ *                      is between @p 1 and @p 0xFFFFFFFE
  * @param[in,out] np    on input is the maximum buffer size, on return it is
  *                      the size of the data copied into the buffer
  * @param[out] buffer   pointer to a buffer for record data
@@ -984,10 +1181,10 @@ mfs_error_t mfsErase(MFSDriver *mfsp) {
  */
 mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
                           size_t *np, uint8_t *buffer) {
+  const mfs_record_descriptor_t *dp;
   uint16_t crc;
 
-  osalDbgCheck((mfsp != NULL) &&
-               (id >= 1U) && (id <= (mfs_id_t)MFS_CFG_MAX_RECORDS) &&
+  osalDbgCheck((mfsp != NULL) && MFS_IS_VALID_ID(id) &&
                (np != NULL) && (*np > 0U) && (buffer != NULL));
 
   if ((mfsp->state != MFS_READY) && (mfsp->state != MFS_TRANSACTION)) {
@@ -995,25 +1192,26 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
   }
 
   /* Checking if the requested record actually exists.*/
-  if (mfsp->descriptors[id - 1U].offset == 0U) {
+  dp = mfs_record_find(mfsp, id);
+  if (dp == NULL) {
     return MFS_ERR_NOT_FOUND;
   }
 
   /* Making sure to not overflow the buffer.*/
-  if (*np < mfsp->descriptors[id - 1U].size) {
+  if (*np < dp->size) {
     return MFS_ERR_INV_SIZE;
   }
 
   /* Header read from flash.*/
   RET_ON_ERROR(mfs_flash_read(mfsp,
-                              mfsp->descriptors[id - 1U].offset,
+                              dp->offset,
                               sizeof (mfs_data_header_t),
                               mfsp->ncbuf->data8));
 
   /* Data read from flash.*/
-  *np = mfsp->descriptors[id - 1U].size;
+  *np = dp->size;
   RET_ON_ERROR(mfs_flash_read(mfsp,
-                              mfsp->descriptors[id - 1U].offset + sizeof (mfs_data_header_t),
+                              dp->offset + sizeof (mfs_data_header_t),
                               *np,
                               buffer));
 
@@ -1032,7 +1230,8 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] id        record numeric identifier, the valid range is between
- *                      @p 1 and @p MFS_CFG_MAX_RECORDS
+ *                      @p 1 and @p MFS_CFG_MAX_RECORDS, in sparse mode it
+ *                      is between @p 1 and @p 0xFFFFFFFE
  * @param[in] n         size of data to be written, it cannot be zero
  * @param[in] buffer    pointer to a buffer for record data
  * @return              The operation status.
@@ -1057,10 +1256,10 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
  */
 mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
                            size_t n, const uint8_t *buffer) {
+  const mfs_record_descriptor_t *dp;
   flash_offset_t free, asize, rspace;
 
-  osalDbgCheck((mfsp != NULL) &&
-               (id >= 1U) && (id <= (mfs_id_t)MFS_CFG_MAX_RECORDS) &&
+  osalDbgCheck((mfsp != NULL) && MFS_IS_VALID_ID(id) &&
                (n > 0U) && (buffer != NULL));
 
   /* Aligned record size.*/
@@ -1079,6 +1278,11 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
       return MFS_ERR_OUT_OF_MEM;
     }
 
+    /* There must be room for the record in the index.*/
+    if (!mfs_record_has_room(mfsp, id, 0U)) {
+      return MFS_ERR_OUT_OF_MEM;
+    }
+
     /* Checking for immediately (not compacted) available space.*/
     free = (mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
             mfsp->config->bank_size) - mfsp->next_offset;
@@ -1090,7 +1294,8 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
     }
 
     /* Writing the data header without the magic, it will be written last.*/
-    mfsp->ncbuf->dhdr.fields.id     = (uint16_t)id;
+    mfsp->ncbuf->dhdr.fields.magic2 = DHDR_MAGIC_2;
+    mfsp->ncbuf->dhdr.fields.id     = (DHDR_ID_TYPE)id;
     mfsp->ncbuf->dhdr.fields.size   = (uint32_t)n;
     mfsp->ncbuf->dhdr.fields.crc    = crc16(0xFFFFU, buffer, n);
     RET_ON_ERROR(mfs_flash_write(mfsp,
@@ -1106,7 +1311,8 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
 
     /* Finally writing the magic number, it seals the operation.*/
     mfsp->ncbuf->dhdr.fields.magic1 = (uint32_t)MFS_HEADER_MAGIC_1;
-    mfsp->ncbuf->dhdr.fields.magic2 = (uint32_t)MFS_HEADER_MAGIC_2;
+    mfsp->ncbuf->dhdr.fields.magic2 = DHDR_MAGIC_2;
+    mfsp->ncbuf->dhdr.fields.id     = (DHDR_ID_TYPE)id;
     RET_ON_ERROR(mfs_flash_write(mfsp,
                                  mfsp->next_offset,
                                  sizeof (uint32_t) * 2U,
@@ -1114,13 +1320,13 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
 
     /* The size of the old record instance, if present, must be subtracted
        to the total used size.*/
-    if (mfsp->descriptors[id - 1U].offset != 0U) {
-      mfsp->used_space -= ALIGNED_REC_SIZE(mfsp->descriptors[id - 1U].size);
+    dp = mfs_record_find(mfsp, id);
+    if (dp != NULL) {
+      mfsp->used_space -= ALIGNED_REC_SIZE(dp->size);
     }
 
     /* Adjusting bank-related metadata.*/
-    mfsp->descriptors[id - 1U].offset = mfsp->next_offset;
-    mfsp->descriptors[id - 1U].size   = (uint32_t)n;
+    mfs_record_update(mfsp, id, mfsp->next_offset, (uint32_t)n);
     mfsp->next_offset += asize;
     mfsp->used_space  += asize;
 
@@ -1147,8 +1353,15 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
       return MFS_ERR_TRANSACTION_SIZE;
     }
 
+    /* There must be room in the index for the record, all buffered
+       operations are conservatively assumed to create new records.*/
+    if (!mfs_record_has_room(mfsp, id, mfsp->tr_nops)) {
+      return MFS_ERR_OUT_OF_MEM;
+    }
+
     /* Writing the data header without the magic, it will be written last.*/
-    mfsp->ncbuf->dhdr.fields.id     = (uint16_t)id;
+    mfsp->ncbuf->dhdr.fields.magic2 = DHDR_MAGIC_2;
+    mfsp->ncbuf->dhdr.fields.id     = (DHDR_ID_TYPE)id;
     mfsp->ncbuf->dhdr.fields.size   = (uint32_t)n;
     mfsp->ncbuf->dhdr.fields.crc    = crc16(0xFFFFU, buffer, n);
     RET_ON_ERROR(mfs_flash_write(mfsp,
@@ -1185,7 +1398,8 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] id        record numeric identifier, the valid range is between
- *                      @p 1 and @p MFS_CFG_MAX_RECORDS
+ *                      @p 1 and @p MFS_CFG_MAX_RECORDS, in sparse mode it
+ *                      is between @p 1 and @p 0xFFFFFFFE
  * @return              The operation status.
  * @retval MFS_NO_ERROR             if the operation has been successfully
  *                                  completed.
@@ -1207,10 +1421,10 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
  * @api
  */
 mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
+  const mfs_record_descriptor_t *dp;
   flash_offset_t free, asize, rspace;
 
-  osalDbgCheck((mfsp != NULL) &&
-               (id >= 1U) && (id <= (mfs_id_t)MFS_CFG_MAX_RECORDS));
+  osalDbgCheck((mfsp != NULL) && MFS_IS_VALID_ID(id));
 
   /* Aligned record size.*/
   asize = ALIGNED_DHDR_SIZE;
@@ -1220,7 +1434,8 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
     bool warning = false;
 
     /* Checking if the requested record actually exists.*/
-    if (mfsp->descriptors[id - 1U].offset == 0U) {
+    dp = mfs_record_find(mfsp, id);
+    if (dp == NULL) {
       return MFS_ERR_NOT_FOUND;
     }
 
@@ -1239,13 +1454,16 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
          but it has to be freed.*/
       warning = true;
       RET_ON_ERROR(mfs_garbage_collect(mfsp));
+
+      /* Descriptors could have been moved.*/
+      dp = mfs_record_find(mfsp, id);
     }
 
     /* Writing the data header with size set to zero, it means that the
        record is logically erased.*/
     mfsp->ncbuf->dhdr.fields.magic1 = (uint32_t)MFS_HEADER_MAGIC_1;
-    mfsp->ncbuf->dhdr.fields.magic2 = (uint32_t)MFS_HEADER_MAGIC_2;
-    mfsp->ncbuf->dhdr.fields.id     = (uint16_t)id;
+    mfsp->ncbuf->dhdr.fields.magic2 = DHDR_MAGIC_2;
+    mfsp->ncbuf->dhdr.fields.id     = (DHDR_ID_TYPE)id;
     mfsp->ncbuf->dhdr.fields.size   = (uint32_t)0;
     mfsp->ncbuf->dhdr.fields.crc    = (uint16_t)0xFFFF;
     RET_ON_ERROR(mfs_flash_write(mfsp,
@@ -1254,10 +1472,9 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
                                  mfsp->ncbuf->data8));
 
     /* Adjusting bank-related metadata.*/
-    mfsp->used_space  -= ALIGNED_REC_SIZE(mfsp->descriptors[id - 1U].size);
+    mfsp->used_space  -= ALIGNED_REC_SIZE(dp->size);
     mfsp->next_offset += asize;
-    mfsp->descriptors[id - 1U].offset = 0U;
-    mfsp->descriptors[id - 1U].size   = 0U;
+    mfs_record_remove(mfsp, id);
 
     return warning ? MFS_WARN_GC : MFS_NO_ERROR;
   }
@@ -1268,7 +1485,7 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
     mfs_transaction_op_t *top;
 
     /* Checking if the requested record actually exists.*/
-    if (mfsp->descriptors[id - 1U].offset == 0U) {
+    if (mfs_record_find(mfsp, id) == NULL) {
       return MFS_ERR_NOT_FOUND;
     }
 
@@ -1289,7 +1506,8 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
 
     /* Writing the data header with size set to zero, it means that the
        record is logically erased. Note, the magic number is not set.*/
-    mfsp->ncbuf->dhdr.fields.id     = (uint16_t)id;
+    mfsp->ncbuf->dhdr.fields.magic2 = DHDR_MAGIC_2;
+    mfsp->ncbuf->dhdr.fields.id     = (DHDR_ID_TYPE)id;
     mfsp->ncbuf->dhdr.fields.size   = (uint32_t)0;
     mfsp->ncbuf->dhdr.fields.crc    = (uint16_t)0xFFFF;
     RET_ON_ERROR(mfs_flash_write(mfsp,
@@ -1441,13 +1659,14 @@ mfs_error_t mfsCommitTransaction(MFSDriver *mfsp) {
 
   /* Scanning all buffered operations in reverse order.*/
   mfsp->ncbuf->dhdr.fields.magic1 = (uint32_t)MFS_HEADER_MAGIC_1;
-  mfsp->ncbuf->dhdr.fields.magic2 = (uint32_t)MFS_HEADER_MAGIC_2;
+  mfsp->ncbuf->dhdr.fields.magic2 = DHDR_MAGIC_2;
   top = &mfsp->tr_ops[mfsp->tr_nops];
   while (top > &mfsp->tr_ops[0]) {
     /* On the previous element.*/
     top--;
 
     /* Finalizing the operation by writing the magic number.*/
+    mfsp->ncbuf->dhdr.fields.id = (DHDR_ID_TYPE)top->id;
     RET_ON_ERROR(mfs_flash_write(mfsp,
                                  top->offset,
                                  sizeof (uint32_t) * 2U,
@@ -1458,28 +1677,26 @@ mfs_error_t mfsCommitTransaction(MFSDriver *mfsp) {
      magic number, now updating the internal state using the buffered data.*/
   mfsp->next_offset = mfsp->tr_next_offset;
   while (top < &mfsp->tr_ops[mfsp->tr_nops]) {
-    unsigned i = (unsigned)top->id - 1U;
+    const mfs_record_descriptor_t *dp = mfs_record_find(mfsp, top->id);
 
     /* The calculation is a bit different depending on write or erase record
        operations.*/
     if (top->size > 0U) {
       /* It is a write.*/
-      if (mfsp->descriptors[i].offset != 0U) {
+      if (dp != NULL) {
         /* The size of the old record instance, if present, must be subtracted
            to the total used size.*/
-        mfsp->used_space -= ALIGNED_REC_SIZE(mfsp->descriptors[i].size);
+        mfsp->used_space -= ALIGNED_REC_SIZE(dp->size);
       }
 
       /* Adjusting bank-related metadata.*/
-      mfsp->used_space           += ALIGNED_REC_SIZE(top->size);
-      mfsp->descriptors[i].offset = top->offset;
-      mfsp->descriptors[i].size   = top->size;
+      mfsp->used_space += ALIGNED_REC_SIZE(top->size);
+      mfs_record_update(mfsp, top->id, top->offset, (uint32_t)top->size);
     }
-    else {
+    else if (dp != NULL) {
       /* It is an erase.*/
-      mfsp->used_space           -= ALIGNED_REC_SIZE(mfsp->descriptors[i].size);
-      mfsp->descriptors[i].offset = 0U;
-      mfsp->descriptors[i].size   = 0U;
+      mfsp->used_space -= ALIGNED_REC_SIZE(dp->size);
+      mfs_record_remove(mfsp, top->id);
     }
 
     /* On the next element.*/
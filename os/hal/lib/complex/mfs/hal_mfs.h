@@ -40,6 +40,7 @@
 
 #define MFS_BANK_MAGIC_1                    0xEC705ADEU
 #define MFS_BANK_MAGIC_2                    0xF0339CC5U
+#define MFS_BANK_MAGIC_2_SPARSE             0x0F33C95CU
 #define MFS_HEADER_MAGIC_1                  0x5FAE45F0U
 #define MFS_HEADER_MAGIC_2                  0xF045AE5FU
 
@@ -53,12 +54,26 @@
  */
 /**
  * @brief   Maximum number of indexed records in the managed storage.
- * @note    Record indexes go from 1 to @p MFS_CFG_MAX_RECORDS.
+ * @note    Record indexes go from 1 to @p MFS_CFG_MAX_RECORDS, in sparse
+ *          mode this is the maximum number of live records instead.
  */
 #if !defined(MFS_CFG_MAX_RECORDS) || defined(__DOXYGEN__)
 #define MFS_CFG_MAX_RECORDS                 32
 #endif
 
+/**
+ * @brief   Enables sparse record identifiers.
+ * @details If enabled, record identifiers can be any 32 bits value between
+ *          @p 1 and @p 0xFFFFFFFE. Records are located using an
+ *          open-addressed hash index sized on @p MFS_CFG_MAX_RECORDS and
+ *          only live records are visited on mount and garbage collection.
+ * @note    The on-flash format is different in sparse mode, banks written
+ *          using the other mode are considered garbage and reinitialized.
+ */
+#if !defined(MFS_CFG_SPARSE_IDS) || defined(__DOXYGEN__)
+#define MFS_CFG_SPARSE_IDS                  FALSE
+#endif
+
 /**
  * @brief   Maximum number of repair attempts on partition mount.
  */
@@ -132,6 +147,11 @@
 #error "invalid MFS_CFG_MAX_RECORDS value"
 #endif
 
+#if (MFS_CFG_SPARSE_IDS == TRUE) &&                                         \
+    ((MFS_CFG_MAX_RECORDS < 1) || (MFS_CFG_MAX_RECORDS > 32767))
+#error "invalid MFS_CFG_MAX_RECORDS value for sparse mode"
+#endif
+
 #if (MFS_CFG_MAX_REPAIR_ATTEMPTS < 1) ||                                    \
     (MFS_CFG_MAX_REPAIR_ATTEMPTS > 10)
 #error "invalid MFS_MAX_REPAIR_ATTEMPTS value"
@@ -159,6 +179,31 @@
 #error "invalid MFS_CFG_TRANSACTION_MAX value"
 #endif
 
+/**
+ * @name    Sparse index size
+ * @{
+ */
+#define __MFS_SMEAR1(x)     ((x) | ((x) >> 1U))
+#define __MFS_SMEAR2(x)     (__MFS_SMEAR1(x) | (__MFS_SMEAR1(x) >> 2U))
+#define __MFS_SMEAR4(x)     (__MFS_SMEAR2(x) | (__MFS_SMEAR2(x) >> 4U))
+#define __MFS_SMEAR8(x)     (__MFS_SMEAR4(x) | (__MFS_SMEAR4(x) >> 8U))
+#define __MFS_SMEAR16(x)    (__MFS_SMEAR8(x) | (__MFS_SMEAR8(x) >> 16U))
+
+/**
+ * @brief   Number of slots in the sparse records hash index.
+ * @details It is the smallest power of two not lower than twice the
+ *          maximum number of records, the load factor is kept at or
+ *          below 50%.
+ */
+#define MFS_INDEX_SIZE                                                      \
+  (__MFS_SMEAR16((2U * (uint32_t)MFS_CFG_MAX_RECORDS) - 1U) + 1U)
+
+/**
+ * @brief   Mask of the sparse records hash index.
+ */
+#define MFS_INDEX_MASK      (MFS_INDEX_SIZE - 1U)
+/** @} */
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -259,6 +304,18 @@ typedef union {
      * @brief   Data header magic 1.
      */
     uint32_t                magic1;
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+    /**
+     * @brief   Record identifier.
+     * @note    In sparse mode the record is sealed by @p magic1 and
+     *          @p id, the identifier is written last.
+     */
+    uint32_t                id;
+    /**
+     * @brief   Data header magic 2.
+     */
+    uint16_t                magic2;
+#else
     /**
      * @brief   Data header magic 2.
      */
@@ -267,6 +324,7 @@ typedef union {
      * @brief   Record identifier.
      */
     uint16_t                id;
+#endif
     /**
      * @brief   Data CRC.
      */
@@ -281,6 +339,9 @@ typedef union {
   uint32_t                  hdr32[4];
 } mfs_data_header_t;
 
+/**
+ * @brief   Type of a record descriptor.
+ */
 typedef struct {
   /**
    * @brief   Offset of the record header.
@@ -290,6 +351,12 @@ typedef struct {
    * @brief   Record data size.
    */
   uint32_t                  size;
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Record identifier.
+   */
+  mfs_id_t                  id;
+#endif
 } mfs_record_descriptor_t;
 
 /**
@@ -390,8 +457,22 @@ typedef struct {
   /**
    * @brief   Offsets of the most recent instance of the records.
    * @note    Zero means that there is not a record with that id.
+   * @note    In sparse mode the first @p records elements are the live
+   *          records, in no particular order.
    */
   mfs_record_descriptor_t   descriptors[MFS_CFG_MAX_RECORDS];
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Number of live records.
+   */
+  uint32_t                  records;
+  /**
+   * @brief   Records hash index.
+   * @note    Zero means an empty slot, any other value is the position
+   *          of the record in @p descriptors plus one.
+   */
+  uint16_t                  index[MFS_INDEX_SIZE];
+#endif
 #if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
   /**
    * @brief   Next write offset for current transaction.
@@ -428,6 +509,17 @@ typedef struct {
 #define MFS_IS_WARNING(err) ((err) > MFS_NO_ERROR)
 /** @} */
 
+/**
+ * @brief   Record identifier validity check.
+ */
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+#define MFS_IS_VALID_ID(id)                                                 \
+  (((mfs_id_t)(id) >= 1U) && ((mfs_id_t)(id) < 0xFFFFFFFFU))
+#else
+#define MFS_IS_VALID_ID(id)                                                 \
+  (((mfs_id_t)(id) >= 1U) && ((mfs_id_t)(id) <= (mfs_id_t)MFS_CFG_MAX_RECORDS))
+#endif
+
 /**
  * @name   Alignment macros
  * @{
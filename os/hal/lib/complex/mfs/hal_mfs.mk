@@ -1,8 +1,11 @@
-# List of all the MFS subsystem files.
-MFSSRC := $(CHIBIOS)/os/hal/lib/complex/mfs/hal_mfs.c
+# List of all the MFS subsystem files, the CRC module could be already
+# required by other modules.
+MFSSRC := $(CHIBIOS)/os/hal/lib/complex/mfs/hal_mfs.c \
+          $(filter-out $(ALLCSRC),$(CHIBIOS)/os/common/utils/src/crc.c)
 
 # Required include directories
-MFSINC := $(CHIBIOS)/os/hal/lib/complex/mfs
+MFSINC := $(CHIBIOS)/os/hal/lib/complex/mfs \
+          $(CHIBIOS)/os/common/utils/include
 
 # Shared variables
 ALLCSRC += $(MFSSRC)
@@ -32,101 +32,180 @@
 #include "chprintf.h"
 #include "memstreams.h"
 
-#define MAX_FILLER 11
+#include <string.h>
+
+/* Maximum number of digits of an unsigned long, octal radix is the worst
+   case.*/
+#define MAX_FILLER ((sizeof (unsigned long) * 8U + 2U) / 3U)
 #define FLOAT_PRECISION 9
 
-static char *long_to_string_with_divisor(char *p,
-                                         long num,
-                                         unsigned radix,
-                                         long divisor) {
-  int i;
-  char *q;
-  long l, ll;
-
-  l = num;
-  if (divisor == 0) {
-    ll = num;
-  } else {
-    ll = divisor;
+/**
+ * @brief   Type of the formatted output state.
+ */
+typedef struct {
+  /**
+   * @brief   Output stream.
+   */
+  BaseSequentialStream  *chp;
+#if (CHPRINTF_BUFFER_SIZE > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Number of bytes in the buffer.
+   */
+  size_t                cnt;
+  /**
+   * @brief   Output buffer.
+   */
+  uint8_t               buf[CHPRINTF_BUFFER_SIZE];
+#endif
+} output_t;
+
+static const char digits_table[] = "0123456789ABCDEF";
+
+static const char pairs_table[200] = {
+  '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+  '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+  '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+  '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+  '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+  '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+  '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+  '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+  '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+  '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+#if CHPRINTF_BUFFER_SIZE > 0
+static void out_flush(output_t *op) {
+
+  if (op->cnt > 0U) {
+    (void) streamWrite(op->chp, op->buf, op->cnt);
+    op->cnt = 0U;
   }
+}
+
+static void out_put(output_t *op, char c) {
 
-  q = p + MAX_FILLER;
-  do {
-    i = (int)(l % radix);
-    i += '0';
-    if (i > '9') {
-      i += 'A' - '0' - 10;
+  op->buf[op->cnt++] = (uint8_t)c;
+  if (op->cnt >= CHPRINTF_BUFFER_SIZE) {
+    out_flush(op);
+  }
+}
+
+static void out_write(output_t *op, const char *s, size_t n) {
+
+  while (n > 0U) {
+    size_t chunk = CHPRINTF_BUFFER_SIZE - op->cnt;
+
+    if (chunk > n) {
+      chunk = n;
+    }
+    memcpy(&op->buf[op->cnt], s, chunk);
+    op->cnt += chunk;
+    s       += chunk;
+    n       -= chunk;
+    if (op->cnt >= CHPRINTF_BUFFER_SIZE) {
+      out_flush(op);
     }
-    *--q = i;
-    l /= radix;
-  } while ((ll /= radix) != 0);
+  }
+}
+#else
+static void out_flush(output_t *op) {
+
+  (void)op;
+}
 
-  i = (int)(p + MAX_FILLER - q);
-  do
-    *p++ = *q++;
-  while (--i);
+static void out_put(output_t *op, char c) {
 
-  return p;
+  streamPut(op->chp, (uint8_t)c);
 }
 
-static char *ch_ltoa(char *p, long num, unsigned radix) {
+static void out_write(output_t *op, const char *s, size_t n) {
+
+  while (n > 0U) {
+    streamPut(op->chp, (uint8_t)*s++);
+    n--;
+  }
+}
+#endif
+
+/*
+ * Converts an unsigned number, at least @p mindigits digits are produced.
+ * Decimal conversion produces two digits per division, octal and
+ * hexadecimal conversions only use shifts and masks.
+ */
+static char *ulong_to_string(char *p, unsigned long num,
+                             unsigned radix, unsigned mindigits) {
+  char tmp[MAX_FILLER];
+  char *q = tmp + MAX_FILLER;
+  size_t i;
+
+  if (radix == 10U) {
+    while (num >= 100UL) {
+      unsigned r = (unsigned)(num % 100UL) * 2U;
+
+      num /= 100UL;
+      q -= 2;
+      q[0] = pairs_table[r];
+      q[1] = pairs_table[r + 1U];
+    }
+    if (num >= 10UL) {
+      unsigned r = (unsigned)num * 2U;
+
+      q -= 2;
+      q[0] = pairs_table[r];
+      q[1] = pairs_table[r + 1U];
+    }
+    else {
+      *--q = (char)('0' + (unsigned)num);
+    }
+  }
+  else {
+    unsigned shift = radix == 16U ? 4U : 3U;
+    unsigned long mask = (unsigned long)radix - 1UL;
+
+    do {
+      *--q = digits_table[num & mask];
+      num >>= shift;
+    } while (num != 0UL);
+  }
+
+  while ((q > tmp) && ((size_t)(tmp + MAX_FILLER - q) < mindigits)) {
+    *--q = '0';
+  }
 
-  return long_to_string_with_divisor(p, num, radix, 0);
+  i = (size_t)(tmp + MAX_FILLER - q);
+  memcpy(p, q, i);
+
+  return p + i;
 }
 
 #if CHPRINTF_USE_FLOAT
 static char *ftoa(char *p, double num, unsigned long precision) {
-  static const long chpow10[FLOAT_PRECISION] = {
+  static const unsigned long chpow10[FLOAT_PRECISION] = {
     10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
   };
-  long l;
+  unsigned long l;
 
   if ((precision == 0) || (precision > FLOAT_PRECISION)) {
     precision = FLOAT_PRECISION;
   }
-  precision = chpow10[precision - 1];
 
-  l = (long)num;
-  p = long_to_string_with_divisor(p, l, 10, 0);
+  l = (unsigned long)num;
+  p = ulong_to_string(p, l, 10U, 0U);
   *p++ = '.';
-  l = (long)((num - l) * precision);
+  l = (unsigned long)((num - (double)l) * (double)chpow10[precision - 1]);
 
-  return long_to_string_with_divisor(p, l, 10, precision / 10);
+  return ulong_to_string(p, l, 10U, (unsigned)precision);
 }
 #endif
 
-/**
- * @brief   System formatted output function.
- * @details This function implements a minimal @p vprintf()-like functionality
- *          with output on a @p BaseSequentialStream.
- *          The general parameters format is: %[-][width|*][.precision|*][l|L]p.
- *          The following parameter types (p) are supported:
- *          - <b>x</b> hexadecimal integer.
- *          - <b>X</b> hexadecimal long.
- *          - <b>o</b> octal integer.
- *          - <b>O</b> octal long.
- *          - <b>d</b> decimal signed integer.
- *          - <b>D</b> decimal signed long.
- *          - <b>u</b> decimal unsigned integer.
- *          - <b>U</b> decimal unsigned long.
- *          - <b>c</b> character.
- *          - <b>s</b> string.
- *          .
- *
- * @param[in] chp       pointer to a @p BaseSequentialStream implementing object
- * @param[in] fmt       formatting string
- * @param[in] ap        list of parameters
- * @return              The number of bytes that would have been
- *                      written to @p chp if no stream error occurs
- *
- * @api
- */
-int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
+static int do_vprintf(output_t *op, const char *fmt, va_list ap) {
   char *p, *s, c, filler;
   int i, precision, width;
   int n = 0;
   bool is_long, left_align, do_sign;
   long l;
+  unsigned long ul;
 #if CHPRINTF_USE_FLOAT
   float f;
   char tmpbuf[2*MAX_FILLER + 1];
@@ -135,17 +214,24 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
 #endif
 
   while (true) {
-    c = *fmt++;
+    c = *fmt;
     if (c == 0) {
       return n;
     }
-    
+
+    /* Literal text is emitted in runs.*/
     if (c != '%') {
-      streamPut(chp, (uint8_t)c);
-      n++;
+      const char *run = fmt;
+
+      do {
+        fmt++;
+      } while ((*fmt != 0) && (*fmt != '%'));
+      out_write(op, run, (size_t)(fmt - run));
+      n += (int)(fmt - run);
       continue;
     }
-    
+    fmt++;
+
     p = tmpbuf;
     s = tmpbuf;
 
@@ -257,13 +343,15 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
       }
       if (l < 0) {
         *p++ = '-';
-        l = -l;
+        ul = 0UL - (unsigned long)l;
       }
-      else
+      else {
         if (do_sign) {
           *p++ = '+';
         }
-      p = ch_ltoa(p, l, 10);
+        ul = (unsigned long)l;
+      }
+      p = ulong_to_string(p, ul, 10U, 0U);
       break;
 #if CHPRINTF_USE_FLOAT
     case 'f':
@@ -295,12 +383,12 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
       c = 8;
 unsigned_common:
       if (is_long) {
-        l = va_arg(ap, unsigned long);
+        ul = va_arg(ap, unsigned long);
       }
       else {
-        l = va_arg(ap, unsigned int);
+        ul = va_arg(ap, unsigned int);
       }
-      p = ch_ltoa(p, l, c);
+      p = ulong_to_string(p, ul, (unsigned)c, 0U);
       break;
     default:
       *p++ = c;
@@ -315,28 +403,68 @@ unsigned_common:
     }
     if (width < 0) {
       if ((*s == '-' || *s == '+') && filler == '0') {
-        streamPut(chp, (uint8_t)*s++);
+        out_put(op, *s++);
         n++;
         i--;
       }
       do {
-        streamPut(chp, (uint8_t)filler);
+        out_put(op, filler);
         n++;
       } while (++width != 0);
     }
-    while (--i >= 0) {
-      streamPut(chp, (uint8_t)*s++);
-      n++;
+    if (i > 0) {
+      out_write(op, s, (size_t)i);
+      n += i;
     }
 
     while (width) {
-      streamPut(chp, (uint8_t)filler);
+      out_put(op, filler);
       n++;
       width--;
     }
   }
 }
 
+/**
+ * @brief   System formatted output function.
+ * @details This function implements a minimal @p vprintf()-like functionality
+ *          with output on a @p BaseSequentialStream.
+ *          The general parameters format is: %[-][width|*][.precision|*][l|L]p.
+ *          The following parameter types (p) are supported:
+ *          - <b>x</b> hexadecimal integer.
+ *          - <b>X</b> hexadecimal long.
+ *          - <b>o</b> octal integer.
+ *          - <b>O</b> octal long.
+ *          - <b>d</b> decimal signed integer.
+ *          - <b>D</b> decimal signed long.
+ *          - <b>u</b> decimal unsigned integer.
+ *          - <b>U</b> decimal unsigned long.
+ *          - <b>c</b> character.
+ *          - <b>s</b> string.
+ *          .
+ *
+ * @param[in] chp       pointer to a @p BaseSequentialStream implementing object
+ * @param[in] fmt       formatting string
+ * @param[in] ap        list of parameters
+ * @return              The number of bytes that would have been
+ *                      written to @p chp if no stream error occurs
+ *
+ * @api
+ */
+int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
+  output_t out;
+  int n;
+
+  out.chp = chp;
+#if CHPRINTF_BUFFER_SIZE > 0
+  out.cnt = 0U;
+#endif
+  n = do_vprintf(&out, fmt, ap);
+  out_flush(&out);
+
+  return n;
+}
+
 /**
  * @brief   System formatted output function.
  * @details This function implements a minimal @p printf() like functionality
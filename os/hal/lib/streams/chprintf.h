@@ -36,6 +36,18 @@
 #define CHPRINTF_USE_FLOAT          FALSE
 #endif
 
+/**
+ * @brief   Size of the formatted output buffer.
+ * @details Formatted output is accumulated in a buffer allocated on the
+ *          caller stack and emitted using @p streamWrite() in chunks of
+ *          this size, this reduces the number of stream calls.
+ * @note    Setting this option to zero disables buffering, all characters
+ *          are emitted using @p streamPut().
+ */
+#if !defined(CHPRINTF_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define CHPRINTF_BUFFER_SIZE        32
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
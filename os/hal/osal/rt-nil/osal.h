@@ -656,6 +656,20 @@ static inline void osalSysPolledDelayX(rtcnt_t cycles) {
 }
 #endif
 
+/**
+ * @brief   Returns the current value of the realtime counter.
+ *
+ * @return              The realtime counter value.
+ *
+ * @xclass
+ */
+#if (PORT_SUPPORTS_RT == TRUE) || defined(__DOXYGEN__)
+static inline rtcnt_t osalSysGetRealtimeCounterX(void) {
+
+  return chSysGetRealtimeCounterX();
+}
+#endif
+
 /**
  * @brief   Systick callback for the underlying OS.
  * @note    This callback is only defined if the OSAL requires such a
@@ -409,6 +409,7 @@ struct hal_can_driver {
   can_callback_t            wakeup_cb;
 #endif
 #endif
+  _can_sw_queues_data
   /* End of the mandatory fields.*/
   /**
    * @brief   Pointer to the CAN registers.
@@ -551,6 +551,7 @@ struct hal_can_driver {
   can_callback_t            wakeup_cb;
 #endif
 #endif
+  _can_sw_queues_data
   /* End of the mandatory fields.*/
   /**
    * @brief   Element size (RAM words).
@@ -570,6 +571,24 @@ struct hal_can_driver {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @brief   Normalized identifier of a received frame.
+ *
+ * @param[in] crfp      pointer to a @p CANRxFrame
+ */
+#define CAN_LLD_RX_ID(crfp)                                                 \
+  (((crfp)->common.XTD != 0U) ? CAN_SW_EID((crfp)->ext.EID) :               \
+                                CAN_SW_SID((crfp)->std.SID))
+
+/**
+ * @brief   Normalized identifier of a frame to be transmitted.
+ *
+ * @param[in] ctfp      pointer to a @p CANTxFrame
+ */
+#define CAN_LLD_TX_ID(ctfp)                                                 \
+  (((ctfp)->common.XTD != 0U) ? CAN_SW_EID((ctfp)->ext.EID) :               \
+                                CAN_SW_SID((ctfp)->std.SID))
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
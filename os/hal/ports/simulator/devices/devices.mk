@@ -0,0 +1,12 @@
+# List of all the simulated device models.
+SIMDEVSRC := $(CHIBIOS)/os/hal/ports/simulator/devices/sim_lsm6dsl.c \
+             $(CHIBIOS)/os/hal/ports/simulator/devices/sim_lps22hb.c \
+             $(CHIBIOS)/os/hal/ports/simulator/devices/sim_adxl355.c \
+             $(CHIBIOS)/os/hal/ports/simulator/devices/sim_lis3dsh.c
+
+# Required include directories
+SIMDEVINC := $(CHIBIOS)/os/hal/ports/simulator/devices
+
+# Shared variables
+ALLCSRC += $(SIMDEVSRC)
+ALLINC  += $(SIMDEVINC)
@@ -0,0 +1,302 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_adxl355.c
+ * @brief   Simulated ADXL355 model code.
+ * @details The model covers identification, measurement and standby
+ *          modes, output registers, status flags, the software reset and
+ *          the FIFO. Reads of FIFO_DATA do not increment the address and
+ *          return one entry every three bytes, the X axis entries carry
+ *          the marker bit. Activity detection, filters and interrupt pins
+ *          are not modeled.
+ *
+ * @addtogroup SIM_ADXL355
+ * @{
+ */
+
+#include "hal.h"
+#include "sim_adxl355.h"
+
+#if (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define AD_DEVID_AD                         0x00U
+#define AD_DEVID_MST                        0x01U
+#define AD_PARTID                           0x02U
+#define AD_REVID                            0x03U
+#define AD_STATUS                           0x04U
+#define AD_FIFO_ENTRIES                     0x05U
+#define AD_XDATA3                           0x08U
+#define AD_FIFO_DATA                        0x11U
+#define AD_OFFSET_X_H                       0x1EU
+#define AD_ACT_COUNT                        0x27U
+#define AD_FILTER                           0x28U
+#define AD_FIFO_SAMPLES                     0x29U
+#define AD_RANGE                            0x2CU
+#define AD_POWER_CTL                        0x2DU
+#define AD_SELF_TEST                        0x2EU
+#define AD_RESET                            0x2FU
+
+#define STATUS_DATA_RDY                     0x01U
+#define STATUS_FIFO_FULL                    0x02U
+#define STATUS_FIFO_OVR                     0x04U
+
+#define POWER_CTL_STANDBY                   0x01U
+
+#define RESET_CODE                          0x52U
+
+#define FIFO_X_MARKER                       (1U << 20)
+#define FIFO_DATA_X_MARKER                  0x01U
+#define FIFO_DATA_EMPTY                     0x02U
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Sampling clock from the power mode and the ODR field.
+ */
+static void adxl355_reclock(sim_adxl355_t *devp) {
+  unsigned odr = devp->dev.regs[AD_FILTER] & 0x0FU;
+
+  if ((devp->dev.regs[AD_POWER_CTL] & POWER_CTL_STANDBY) != 0U) {
+    simClockSet(&devp->clock, 0U);
+  }
+  else {
+    simClockSet(&devp->clock, 4000000U >> (odr < 10U ? odr : 10U));
+  }
+}
+
+/**
+ * @brief   Power-on register values.
+ */
+static void adxl355_reset(sim_adxl355_t *devp) {
+  unsigned i;
+
+  for (i = 0U; i < SIM_DEVICE_NUM_REGS; i++) {
+    devp->dev.regs[i] = 0U;
+  }
+  devp->dev.regs[AD_DEVID_AD]     = 0xADU;
+  devp->dev.regs[AD_DEVID_MST]    = 0x1DU;
+  devp->dev.regs[AD_PARTID]       = 0xEDU;
+  devp->dev.regs[AD_REVID]        = 0x01U;
+  devp->dev.regs[AD_ACT_COUNT]    = 0x01U;
+  devp->dev.regs[AD_FIFO_SAMPLES] = 0x60U;
+  devp->dev.regs[AD_RANGE]        = 0x81U;
+  devp->dev.regs[AD_POWER_CTL]    = POWER_CTL_STANDBY;
+  devp->rd   = 0U;
+  devp->cnt  = 0U;
+  devp->byte = 0U;
+  adxl355_reclock(devp);
+}
+
+/**
+ * @brief   Pushes a sample in the FIFO, the oldest sample is lost if full.
+ */
+static void adxl355_push(sim_adxl355_t *devp, const uint32_t axes[]) {
+  unsigned ch;
+
+  if (devp->cnt + SIM_ADXL355_NUM_CHANNELS > SIM_ADXL355_FIFO_ENTRIES) {
+    devp->rd    = (devp->rd + SIM_ADXL355_NUM_CHANNELS) %
+                  SIM_ADXL355_FIFO_ENTRIES;
+    devp->cnt  -= SIM_ADXL355_NUM_CHANNELS;
+    devp->byte  = 0U;
+    devp->dev.regs[AD_STATUS] |= STATUS_FIFO_OVR;
+  }
+
+  for (ch = 0U; ch < SIM_ADXL355_NUM_CHANNELS; ch++) {
+    devp->fifo[(devp->rd + devp->cnt) % SIM_ADXL355_FIFO_ENTRIES] =
+        axes[ch] | (ch == 0U ? FIFO_X_MARKER : 0U);
+    devp->cnt++;
+  }
+}
+
+/**
+ * @brief   Produces the samples due, bounded to the FIFO depth.
+ */
+static void adxl355_update(sim_device_t *ip) {
+  sim_adxl355_t *devp = (sim_adxl355_t *)ip;
+  uint32_t n = simClockElapsed(&devp->clock);
+  uint32_t max = (SIM_ADXL355_FIFO_ENTRIES / SIM_ADXL355_NUM_CHANNELS) + 1U;
+  uint32_t axes[SIM_ADXL355_NUM_CHANNELS];
+  unsigned ch;
+
+  /* Partially read entries are restarted by a new transaction.*/
+  devp->byte = 0U;
+
+  if (n > max) {
+    devp->seq += n - max;
+    n = max;
+  }
+
+  while (n > 0U) {
+    for (ch = 0U; ch < SIM_ADXL355_NUM_CHANNELS; ch++) {
+      axes[ch] = (uint32_t)simDeviceSample(ip, devp->seq, ch) & 0xFFFFFU;
+      ip->regs[AD_XDATA3 + (ch * 3U)]      = (uint8_t)(axes[ch] >> 12);
+      ip->regs[AD_XDATA3 + (ch * 3U) + 1U] = (uint8_t)(axes[ch] >> 4);
+      ip->regs[AD_XDATA3 + (ch * 3U) + 2U] = (uint8_t)(axes[ch] << 4);
+    }
+    adxl355_push(devp, axes);
+    ip->regs[AD_STATUS] |= STATUS_DATA_RDY;
+    devp->seq++;
+    n--;
+  }
+}
+
+/**
+ * @brief   SPI command decoding, bit 0 is the read flag.
+ */
+static bool adxl355_command(sim_device_t *ip, uint8_t cmd, uint8_t *regp) {
+
+  (void)ip;
+
+  *regp = cmd >> 1;
+
+  return (cmd & 0x01U) != 0U;
+}
+
+/**
+ * @brief   Register read, FIFO entries are popped on their third byte.
+ */
+static uint8_t adxl355_read(sim_device_t *ip, uint8_t reg) {
+  sim_adxl355_t *devp = (sim_adxl355_t *)ip;
+  uint32_t entry;
+  uint8_t value;
+
+  switch (reg) {
+  case AD_STATUS:
+    value = ip->regs[AD_STATUS] & (STATUS_DATA_RDY | STATUS_FIFO_OVR);
+    if (devp->cnt >= ip->regs[AD_FIFO_SAMPLES]) {
+      value |= STATUS_FIFO_FULL;
+    }
+    ip->regs[AD_STATUS] = 0U;
+    return value;
+  case AD_FIFO_ENTRIES:
+    return (uint8_t)devp->cnt;
+  case AD_FIFO_DATA:
+    if (devp->cnt == 0U) {
+      value = devp->byte == 2U ? FIFO_DATA_EMPTY : 0U;
+      devp->byte = (devp->byte + 1U) % 3U;
+      return value;
+    }
+    entry = devp->fifo[devp->rd];
+    switch (devp->byte) {
+    case 0U:
+      value = (uint8_t)(entry >> 12);
+      break;
+    case 1U:
+      value = (uint8_t)(entry >> 4);
+      break;
+    default:
+      value = (uint8_t)(entry << 4);
+      if ((entry & FIFO_X_MARKER) != 0U) {
+        value |= FIFO_DATA_X_MARKER;
+      }
+      devp->rd = (devp->rd + 1U) % SIM_ADXL355_FIFO_ENTRIES;
+      devp->cnt--;
+      break;
+    }
+    devp->byte = (devp->byte + 1U) % 3U;
+    return value;
+  default:
+    break;
+  }
+
+  return ip->regs[reg];
+}
+
+/**
+ * @brief   Register write.
+ */
+static void adxl355_write(sim_device_t *ip, uint8_t reg, uint8_t value) {
+  sim_adxl355_t *devp = (sim_adxl355_t *)ip;
+
+  if (reg == AD_RESET) {
+    if (value == RESET_CODE) {
+      adxl355_reset(devp);
+    }
+    return;
+  }
+
+  /* Read-only registers are ignored.*/
+  if ((reg < AD_OFFSET_X_H) || (reg > AD_SELF_TEST)) {
+    return;
+  }
+
+  ip->regs[reg] = value;
+
+  if ((reg == AD_FILTER) || (reg == AD_POWER_CTL)) {
+    adxl355_reclock(devp);
+  }
+}
+
+/**
+ * @brief   Auto-increment, except on FIFO_DATA.
+ */
+static uint8_t adxl355_next(sim_device_t *ip, uint8_t reg) {
+
+  (void)ip;
+
+  if (reg == AD_FIFO_DATA) {
+    return reg;
+  }
+
+  return (uint8_t)((reg + 1U) & (SIM_DEVICE_NUM_REGS - 1U));
+}
+
+static const struct sim_device_vmt adxl355_vmt = {
+  adxl355_update,
+  adxl355_command,
+  adxl355_read,
+  adxl355_write,
+  adxl355_next
+};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a simulated ADXL355 in its power-on state.
+ *
+ * @param[out] devp     pointer to the @p sim_adxl355_t object
+ * @param[in] address   I2C slave address, ignored on SPI
+ *
+ * @init
+ */
+void simADXL355ObjectInit(sim_adxl355_t *devp, uint16_t address) {
+
+  simDeviceObjectInit(&devp->dev, &adxl355_vmt, address);
+  devp->clock.odr = 0U;
+  devp->seq       = 0U;
+  adxl355_reset(devp);
+}
+
+#endif /* (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) */
+
+/** @} */
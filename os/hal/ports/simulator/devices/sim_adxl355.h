@@ -0,0 +1,106 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_adxl355.h
+ * @brief   Simulated ADXL355 model header.
+ *
+ * @addtogroup SIM_ADXL355
+ * @{
+ */
+
+#ifndef SIM_ADXL355_H
+#define SIM_ADXL355_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Channels in a sample, X, Y, Z (20 bits).
+ */
+#define SIM_ADXL355_NUM_CHANNELS            3U
+
+/**
+ * @brief   FIFO depth in entries, an entry is a single axis.
+ */
+#define SIM_ADXL355_FIFO_ENTRIES            96U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Structure representing a simulated ADXL355.
+ */
+typedef struct {
+  /**
+   * @brief   Base device.
+   */
+  sim_device_t              dev;
+  /**
+   * @brief   Sampling clock.
+   */
+  sim_clock_t               clock;
+  /**
+   * @brief   Sequence number of the next sample.
+   */
+  uint32_t                  seq;
+  /**
+   * @brief   FIFO buffer, 20 bits values with the X axis marker in bit 20.
+   */
+  uint32_t                  fifo[SIM_ADXL355_FIFO_ENTRIES];
+  /**
+   * @brief   FIFO read index.
+   */
+  unsigned                  rd;
+  /**
+   * @brief   Entries in the FIFO.
+   */
+  unsigned                  cnt;
+  /**
+   * @brief   Next byte of the FIFO head entry.
+   */
+  unsigned                  byte;
+} sim_adxl355_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simADXL355ObjectInit(sim_adxl355_t *devp, uint16_t address);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_ADXL355_H */
+
+/** @} */
@@ -0,0 +1,334 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_lis3dsh.c
+ * @brief   Simulated LIS3DSH model code.
+ * @details The model covers identification, output registers, register
+ *          address auto-increment, the soft reset and the FIFO in FIFO and
+ *          stream modes. With the FIFO enabled the output registers return
+ *          the oldest sample, the burst read pointer rolls over from
+ *          OUT_Z_H to OUT_X_L and the sample is removed on OUT_Z_H. State
+ *          machines, temperature and interrupt pins are not modeled.
+ *
+ * @addtogroup SIM_LIS3DSH
+ * @{
+ */
+
+#include "hal.h"
+#include "sim_lis3dsh.h"
+
+#if (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define AD_INFO1                            0x0DU
+#define AD_INFO2                            0x0EU
+#define AD_WHO_AM_I                         0x0FU
+#define AD_OFF_X                            0x10U
+#define AD_STAT                             0x18U
+#define AD_PEAK2                            0x1AU
+#define AD_CTRL_REG4                        0x20U
+#define AD_CTRL_REG3                        0x23U
+#define AD_CTRL_REG6                        0x25U
+#define AD_STATUS                           0x27U
+#define AD_OUT_X_L                          0x28U
+#define AD_OUT_Z_H                          0x2DU
+#define AD_FIFO_CTRL                        0x2EU
+#define AD_FIFO_SRC                         0x2FU
+#define AD_OUTS1                            0x5FU
+#define AD_OUTS2                            0x7FU
+
+#define INFO1_VALUE                         0x21U
+#define WHO_AM_I_VALUE                      0x3FU
+
+#define CTRL_REG3_STRT                      0x01U
+
+#define CTRL_REG6_ADD_INC                   0x10U
+#define CTRL_REG6_FIFO_EN                   0x40U
+#define CTRL_REG6_BOOT                      0x80U
+
+#define STATUS_ZYXDA                        0x08U
+
+#define FIFO_MODE_MASK                      0xE0U
+#define FIFO_MODE_BYPASS                    0x00U
+#define FIFO_MODE_FIFO                      0x20U
+#define FIFO_WTMP_MASK                      0x1FU
+
+#define FIFO_SRC_EMPTY                      0x20U
+#define FIFO_SRC_OVRN_FIFO                  0x40U
+#define FIFO_SRC_WTM                        0x80U
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Output data rates in mHz, by ODR field value.
+ */
+static const uint32_t lis3dsh_odr[16] = {
+  0U, 3125U, 6250U, 12500U, 25000U, 50000U, 100000U, 400000U,
+  800000U, 1600000U, 0U, 0U, 0U, 0U, 0U, 0U
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   FIFO enabled and not in bypass mode.
+ */
+static bool lis3dsh_fifo_enabled(sim_lis3dsh_t *devp) {
+
+  return ((devp->dev.regs[AD_CTRL_REG6] & CTRL_REG6_FIFO_EN) != 0U) &&
+         ((devp->dev.regs[AD_FIFO_CTRL] & FIFO_MODE_MASK) !=
+          FIFO_MODE_BYPASS);
+}
+
+/**
+ * @brief   Empties the FIFO.
+ */
+static void lis3dsh_flush(sim_lis3dsh_t *devp) {
+
+  devp->rd  = 0U;
+  devp->cnt = 0U;
+}
+
+/**
+ * @brief   Power-on register values.
+ */
+static void lis3dsh_reset(sim_lis3dsh_t *devp) {
+  unsigned i;
+
+  for (i = 0U; i < SIM_DEVICE_NUM_REGS; i++) {
+    devp->dev.regs[i] = 0U;
+  }
+  devp->dev.regs[AD_INFO1]    = INFO1_VALUE;
+  devp->dev.regs[AD_WHO_AM_I] = WHO_AM_I_VALUE;
+  lis3dsh_flush(devp);
+  simClockSet(&devp->clock, 0U);
+}
+
+/**
+ * @brief   Pushes a sample in the FIFO according to the FIFO mode.
+ */
+static void lis3dsh_push(sim_lis3dsh_t *devp, const uint16_t axes[]) {
+  unsigned ch;
+
+  if (devp->cnt >= SIM_LIS3DSH_FIFO_SAMPLES) {
+    if ((devp->dev.regs[AD_FIFO_CTRL] & FIFO_MODE_MASK) == FIFO_MODE_FIFO) {
+      /* FIFO mode, stops when full.*/
+      return;
+    }
+
+    /* Stream mode, the oldest sample is overwritten.*/
+    devp->rd = (devp->rd + 1U) % SIM_LIS3DSH_FIFO_SAMPLES;
+    devp->cnt--;
+  }
+
+  for (ch = 0U; ch < SIM_LIS3DSH_NUM_CHANNELS; ch++) {
+    devp->fifo[(devp->rd + devp->cnt) % SIM_LIS3DSH_FIFO_SAMPLES][ch] =
+        axes[ch];
+  }
+  devp->cnt++;
+}
+
+/**
+ * @brief   Produces the samples due, bounded to the FIFO depth.
+ */
+static void lis3dsh_update(sim_device_t *ip) {
+  sim_lis3dsh_t *devp = (sim_lis3dsh_t *)ip;
+  uint32_t n = simClockElapsed(&devp->clock);
+  bool fifo = lis3dsh_fifo_enabled(devp);
+  uint32_t max = fifo ? SIM_LIS3DSH_FIFO_SAMPLES + 1U : 1U;
+  uint16_t axes[SIM_LIS3DSH_NUM_CHANNELS];
+  unsigned ch;
+
+  if (n > max) {
+    devp->seq += n - max;
+    n = max;
+  }
+
+  while (n > 0U) {
+    for (ch = 0U; ch < SIM_LIS3DSH_NUM_CHANNELS; ch++) {
+      axes[ch] = (uint16_t)simDeviceSample(ip, devp->seq, ch);
+      ip->regs[AD_OUT_X_L + (ch * 2U)]      = (uint8_t)axes[ch];
+      ip->regs[AD_OUT_X_L + (ch * 2U) + 1U] = (uint8_t)(axes[ch] >> 8);
+    }
+    if (fifo) {
+      lis3dsh_push(devp, axes);
+    }
+    ip->regs[AD_STATUS] |= STATUS_ZYXDA;
+    devp->seq++;
+    n--;
+  }
+}
+
+/**
+ * @brief   SPI command decoding, bit 7 is the read flag.
+ */
+static bool lis3dsh_command(sim_device_t *ip, uint8_t cmd, uint8_t *regp) {
+
+  (void)ip;
+
+  *regp = cmd & 0x7FU;
+
+  return (cmd & 0x80U) != 0U;
+}
+
+/**
+ * @brief   Register read, FIFO samples are popped on OUT_Z_H.
+ */
+static uint8_t lis3dsh_read(sim_device_t *ip, uint8_t reg) {
+  sim_lis3dsh_t *devp = (sim_lis3dsh_t *)ip;
+  unsigned wtm;
+  uint16_t word;
+  uint8_t value;
+
+  switch (reg) {
+  case AD_FIFO_SRC:
+    /* The stored data level field is 5 bits wide, a full FIFO is
+       signaled by OVRN_FIFO.*/
+    wtm = ip->regs[AD_FIFO_CTRL] & FIFO_WTMP_MASK;
+    value = (uint8_t)(devp->cnt < SIM_LIS3DSH_FIFO_SAMPLES ?
+                      devp->cnt : SIM_LIS3DSH_FIFO_SAMPLES - 1U);
+    if (devp->cnt == 0U) {
+      value |= FIFO_SRC_EMPTY;
+    }
+    if (devp->cnt >= SIM_LIS3DSH_FIFO_SAMPLES) {
+      value |= FIFO_SRC_OVRN_FIFO;
+    }
+    if ((wtm > 0U) && (devp->cnt >= wtm)) {
+      value |= FIFO_SRC_WTM;
+    }
+    return value;
+  default:
+    break;
+  }
+
+  if ((reg >= AD_OUT_X_L) && (reg <= AD_OUT_Z_H)) {
+    if (lis3dsh_fifo_enabled(devp) && (devp->cnt > 0U)) {
+      word  = devp->fifo[devp->rd][(reg - AD_OUT_X_L) / 2U];
+      value = (reg & 1U) == 0U ? (uint8_t)word : (uint8_t)(word >> 8);
+      if (reg == AD_OUT_Z_H) {
+        devp->rd = (devp->rd + 1U) % SIM_LIS3DSH_FIFO_SAMPLES;
+        devp->cnt--;
+      }
+      return value;
+    }
+    if (reg == AD_OUT_Z_H) {
+      ip->regs[AD_STATUS] &= ~STATUS_ZYXDA;
+    }
+  }
+
+  return ip->regs[reg];
+}
+
+/**
+ * @brief   Register write.
+ */
+static void lis3dsh_write(sim_device_t *ip, uint8_t reg, uint8_t value) {
+  sim_lis3dsh_t *devp = (sim_lis3dsh_t *)ip;
+
+  /* Read-only registers are ignored.*/
+  if ((reg < AD_OFF_X) || ((reg >= AD_STAT) && (reg <= AD_PEAK2)) ||
+      ((reg >= AD_STATUS) && (reg <= AD_OUT_Z_H)) || (reg == AD_FIFO_SRC) ||
+      (reg == AD_OUTS1) || (reg == AD_OUTS2) ||
+      ((reg > AD_FIFO_SRC) && (reg < 0x40U))) {
+    return;
+  }
+
+  if ((reg == AD_CTRL_REG3) && ((value & CTRL_REG3_STRT) != 0U)) {
+    lis3dsh_reset(devp);
+    return;
+  }
+
+  ip->regs[reg] = value;
+
+  switch (reg) {
+  case AD_CTRL_REG4:
+    simClockSet(&devp->clock, lis3dsh_odr[value >> 4]);
+    break;
+  case AD_CTRL_REG6:
+    ip->regs[reg] &= ~CTRL_REG6_BOOT;
+    if ((value & CTRL_REG6_FIFO_EN) == 0U) {
+      lis3dsh_flush(devp);
+    }
+    break;
+  case AD_FIFO_CTRL:
+    if ((value & FIFO_MODE_MASK) == FIFO_MODE_BYPASS) {
+      lis3dsh_flush(devp);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief   Auto-increment, rolling over on the output registers when the
+ *          FIFO is enabled.
+ */
+static uint8_t lis3dsh_next(sim_device_t *ip, uint8_t reg) {
+
+  if ((ip->regs[AD_CTRL_REG6] & CTRL_REG6_ADD_INC) == 0U) {
+    return reg;
+  }
+  if ((reg == AD_OUT_Z_H) &&
+      ((ip->regs[AD_CTRL_REG6] & CTRL_REG6_FIFO_EN) != 0U)) {
+    return AD_OUT_X_L;
+  }
+
+  return (uint8_t)((reg + 1U) & (SIM_DEVICE_NUM_REGS - 1U));
+}
+
+static const struct sim_device_vmt lis3dsh_vmt = {
+  lis3dsh_update,
+  lis3dsh_command,
+  lis3dsh_read,
+  lis3dsh_write,
+  lis3dsh_next
+};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a simulated LIS3DSH in its power-on state.
+ *
+ * @param[out] devp     pointer to the @p sim_lis3dsh_t object
+ * @param[in] address   I2C slave address, ignored on SPI
+ *
+ * @init
+ */
+void simLIS3DSHObjectInit(sim_lis3dsh_t *devp, uint16_t address) {
+
+  simDeviceObjectInit(&devp->dev, &lis3dsh_vmt, address);
+  devp->clock.odr = 0U;
+  devp->seq       = 0U;
+  lis3dsh_reset(devp);
+}
+
+#endif /* (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) */
+
+/** @} */
@@ -0,0 +1,103 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_lis3dsh.h
+ * @brief   Simulated LIS3DSH model header.
+ *
+ * @addtogroup SIM_LIS3DSH
+ * @{
+ */
+
+#ifndef SIM_LIS3DSH_H
+#define SIM_LIS3DSH_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Channels in a sample, X, Y, Z.
+ */
+#define SIM_LIS3DSH_NUM_CHANNELS            3U
+
+/**
+ * @brief   FIFO depth in samples.
+ */
+#define SIM_LIS3DSH_FIFO_SAMPLES            32U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Structure representing a simulated LIS3DSH.
+ */
+typedef struct {
+  /**
+   * @brief   Base device.
+   */
+  sim_device_t              dev;
+  /**
+   * @brief   Sampling clock.
+   */
+  sim_clock_t               clock;
+  /**
+   * @brief   Sequence number of the next sample.
+   */
+  uint32_t                  seq;
+  /**
+   * @brief   FIFO buffer.
+   */
+  uint16_t                  fifo[SIM_LIS3DSH_FIFO_SAMPLES]
+                                [SIM_LIS3DSH_NUM_CHANNELS];
+  /**
+   * @brief   FIFO read index.
+   */
+  unsigned                  rd;
+  /**
+   * @brief   Samples in the FIFO.
+   */
+  unsigned                  cnt;
+} sim_lis3dsh_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simLIS3DSHObjectInit(sim_lis3dsh_t *devp, uint16_t address);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_LIS3DSH_H */
+
+/** @} */
@@ -0,0 +1,219 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_lps22hb.c
+ * @brief   Simulated LPS22HB model code.
+ * @details The model covers identification, continuous and one-shot
+ *          conversions, data ready flags and register address
+ *          auto-increment. The FIFO, thresholds and interrupts are not
+ *          modeled.
+ *
+ * @addtogroup SIM_LPS22HB
+ * @{
+ */
+
+#include "hal.h"
+#include "sim_lps22hb.h"
+
+#if (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define AD_WHO_AM_I                         0x0FU
+#define AD_CTRL_REG1                        0x10U
+#define AD_CTRL_REG2                        0x11U
+#define AD_STATUS_REG                       0x27U
+#define AD_PRESS_OUT_XL                     0x28U
+#define AD_PRESS_OUT_H                      0x2AU
+#define AD_TEMP_OUT_L                       0x2BU
+#define AD_TEMP_OUT_H                       0x2CU
+
+#define WHO_AM_I_VALUE                      0xB1U
+
+#define CTRL_REG2_ONE_SHOT                  0x01U
+#define CTRL_REG2_SWRESET                   0x04U
+#define CTRL_REG2_IF_ADD_INC                0x10U
+#define CTRL_REG2_BOOT                      0x80U
+
+#define STATUS_P_DA                         0x01U
+#define STATUS_T_DA                         0x02U
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Output data rates in mHz, by ODR field value.
+ */
+static const uint32_t lps22hb_odr[8] = {
+  0U, 1000U, 10000U, 25000U, 50000U, 75000U, 0U, 0U
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Power-on register values.
+ */
+static void lps22hb_reset(sim_lps22hb_t *devp) {
+  unsigned i;
+
+  for (i = 0U; i < SIM_DEVICE_NUM_REGS; i++) {
+    devp->dev.regs[i] = 0U;
+  }
+  devp->dev.regs[AD_WHO_AM_I]  = WHO_AM_I_VALUE;
+  devp->dev.regs[AD_CTRL_REG2] = CTRL_REG2_IF_ADD_INC;
+  simClockSet(&devp->clock, 0U);
+}
+
+/**
+ * @brief   Stores a conversion result in the output registers.
+ */
+static void lps22hb_convert(sim_lps22hb_t *devp) {
+  uint32_t press = (uint32_t)simDeviceSample(&devp->dev, devp->seq, 0U);
+  uint32_t temp  = (uint32_t)simDeviceSample(&devp->dev, devp->seq, 1U);
+
+  devp->dev.regs[AD_PRESS_OUT_XL]      = (uint8_t)press;
+  devp->dev.regs[AD_PRESS_OUT_XL + 1U] = (uint8_t)(press >> 8);
+  devp->dev.regs[AD_PRESS_OUT_XL + 2U] = (uint8_t)(press >> 16);
+  devp->dev.regs[AD_TEMP_OUT_L]        = (uint8_t)temp;
+  devp->dev.regs[AD_TEMP_OUT_H]        = (uint8_t)(temp >> 8);
+  devp->dev.regs[AD_STATUS_REG]       |= STATUS_P_DA | STATUS_T_DA;
+  devp->seq++;
+}
+
+/**
+ * @brief   Converts the last sample due, the others are overwritten.
+ */
+static void lps22hb_update(sim_device_t *ip) {
+  sim_lps22hb_t *devp = (sim_lps22hb_t *)ip;
+  uint32_t n = simClockElapsed(&devp->clock);
+
+  if (n > 0U) {
+    devp->seq += n - 1U;
+    lps22hb_convert(devp);
+  }
+}
+
+/**
+ * @brief   SPI command decoding, bit 7 is the read flag.
+ */
+static bool lps22hb_command(sim_device_t *ip, uint8_t cmd, uint8_t *regp) {
+
+  (void)ip;
+
+  *regp = cmd & 0x7FU;
+
+  return (cmd & 0x80U) != 0U;
+}
+
+/**
+ * @brief   Register read, the high bytes clear the data ready flags.
+ */
+static uint8_t lps22hb_read(sim_device_t *ip, uint8_t reg) {
+
+  if (reg == AD_PRESS_OUT_H) {
+    ip->regs[AD_STATUS_REG] &= ~STATUS_P_DA;
+  }
+  else if (reg == AD_TEMP_OUT_H) {
+    ip->regs[AD_STATUS_REG] &= ~STATUS_T_DA;
+  }
+
+  return ip->regs[reg];
+}
+
+/**
+ * @brief   Register write.
+ */
+static void lps22hb_write(sim_device_t *ip, uint8_t reg, uint8_t value) {
+  sim_lps22hb_t *devp = (sim_lps22hb_t *)ip;
+
+  /* Read-only registers are ignored.*/
+  if (!(((reg >= 0x0BU) && (reg <= 0x0DU)) ||
+        ((reg >= AD_CTRL_REG1) && (reg <= 0x1AU))) ||
+      (reg == 0x13U)) {
+    return;
+  }
+
+  if ((reg == AD_CTRL_REG2) && ((value & CTRL_REG2_SWRESET) != 0U)) {
+    lps22hb_reset(devp);
+    return;
+  }
+
+  ip->regs[reg] = value;
+
+  if (reg == AD_CTRL_REG1) {
+    simClockSet(&devp->clock, lps22hb_odr[(value >> 4) & 0x07U]);
+  }
+  else if (reg == AD_CTRL_REG2) {
+    if ((value & CTRL_REG2_ONE_SHOT) != 0U) {
+      lps22hb_convert(devp);
+    }
+    ip->regs[reg] &= ~(CTRL_REG2_ONE_SHOT | CTRL_REG2_BOOT);
+  }
+}
+
+/**
+ * @brief   Auto-increment.
+ */
+static uint8_t lps22hb_next(sim_device_t *ip, uint8_t reg) {
+
+  if ((ip->regs[AD_CTRL_REG2] & CTRL_REG2_IF_ADD_INC) == 0U) {
+    return reg;
+  }
+
+  return (uint8_t)((reg + 1U) & (SIM_DEVICE_NUM_REGS - 1U));
+}
+
+static const struct sim_device_vmt lps22hb_vmt = {
+  lps22hb_update,
+  lps22hb_command,
+  lps22hb_read,
+  lps22hb_write,
+  lps22hb_next
+};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a simulated LPS22HB in its power-on state.
+ *
+ * @param[out] devp     pointer to the @p sim_lps22hb_t object
+ * @param[in] address   I2C slave address
+ *
+ * @init
+ */
+void simLPS22HBObjectInit(sim_lps22hb_t *devp, uint16_t address) {
+
+  simDeviceObjectInit(&devp->dev, &lps22hb_vmt, address);
+  devp->clock.odr = 0U;
+  devp->seq       = 0U;
+  lps22hb_reset(devp);
+}
+
+#endif /* (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) */
+
+/** @} */
@@ -0,0 +1,86 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_lps22hb.h
+ * @brief   Simulated LPS22HB model header.
+ *
+ * @addtogroup SIM_LPS22HB
+ * @{
+ */
+
+#ifndef SIM_LPS22HB_H
+#define SIM_LPS22HB_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Channels in a sample, pressure (24 bits) then temperature
+ *          (16 bits).
+ */
+#define SIM_LPS22HB_NUM_CHANNELS            2U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Structure representing a simulated LPS22HB.
+ */
+typedef struct {
+  /**
+   * @brief   Base device.
+   */
+  sim_device_t              dev;
+  /**
+   * @brief   Sampling clock.
+   */
+  sim_clock_t               clock;
+  /**
+   * @brief   Sequence number of the next sample.
+   */
+  uint32_t                  seq;
+} sim_lps22hb_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simLPS22HBObjectInit(sim_lps22hb_t *devp, uint16_t address);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_LPS22HB_H */
+
+/** @} */
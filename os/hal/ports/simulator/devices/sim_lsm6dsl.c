@@ -0,0 +1,358 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_lsm6dsl.c
+ * @brief   Simulated LSM6DSL model code.
+ * @details The model covers identification, output registers, register
+ *          address auto-increment and the FIFO with gyroscope and
+ *          accelerometer data at the same rate, the burst read pointer
+ *          rolls over on the FIFO output registers. Decimation, embedded
+ *          functions and interrupt pins are not modeled.
+ *
+ * @addtogroup SIM_LSM6DSL
+ * @{
+ */
+
+#include "hal.h"
+#include "sim_lsm6dsl.h"
+
+#if (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define AD_FIFO_CTRL1                       0x06U
+#define AD_FIFO_CTRL2                       0x07U
+#define AD_FIFO_CTRL5                       0x0AU
+#define AD_WHO_AM_I                         0x0FU
+#define AD_CTRL1_XL                         0x10U
+#define AD_CTRL3_C                          0x12U
+#define AD_STATUS_REG                       0x1EU
+#define AD_OUTX_L_G                         0x22U
+#define AD_OUTZ_H_G                         0x27U
+#define AD_OUTZ_H_XL                        0x2DU
+#define AD_FIFO_STATUS1                     0x3AU
+#define AD_FIFO_STATUS2                     0x3BU
+#define AD_FIFO_STATUS3                     0x3CU
+#define AD_FIFO_STATUS4                     0x3DU
+#define AD_FIFO_DATA_OUT_L                  0x3EU
+#define AD_FIFO_DATA_OUT_H                  0x3FU
+
+#define WHO_AM_I_VALUE                      0x6AU
+
+#define CTRL3_C_SW_RESET                    0x01U
+#define CTRL3_C_IF_INC                      0x04U
+#define CTRL3_C_BOOT                        0x80U
+
+#define STATUS_XLDA                         0x01U
+#define STATUS_GDA                          0x02U
+#define STATUS_TDA                          0x04U
+
+#define FIFO_MODE_MASK                      0x07U
+#define FIFO_MODE_BYPASS                    0x00U
+#define FIFO_MODE_FIFO                      0x01U
+
+#define FIFO_STATUS2_EMPTY                  0x10U
+#define FIFO_STATUS2_FULL_SMART             0x20U
+#define FIFO_STATUS2_OVER_RUN               0x40U
+#define FIFO_STATUS2_WATERM                 0x80U
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Output data rates in mHz, by ODR field value.
+ */
+static const uint32_t lsm6dsl_odr[16] = {
+  0U, 12500U, 26000U, 52000U, 104000U, 208000U, 416000U, 833000U,
+  1660000U, 3330000U, 6660000U, 0U, 0U, 0U, 0U, 0U
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   FIFO enabled with a non-zero data rate.
+ */
+static bool lsm6dsl_fifo_enabled(sim_lsm6dsl_t *devp) {
+
+  return ((devp->dev.regs[AD_FIFO_CTRL5] & FIFO_MODE_MASK) !=
+          FIFO_MODE_BYPASS) &&
+         (((devp->dev.regs[AD_FIFO_CTRL5] >> 3) & 0x0FU) != 0U);
+}
+
+/**
+ * @brief   Sampling clock from the FIFO or accelerometer data rate.
+ */
+static void lsm6dsl_reclock(sim_lsm6dsl_t *devp) {
+
+  if (lsm6dsl_fifo_enabled(devp)) {
+    simClockSet(&devp->clock,
+                lsm6dsl_odr[(devp->dev.regs[AD_FIFO_CTRL5] >> 3) & 0x0FU]);
+  }
+  else {
+    simClockSet(&devp->clock, lsm6dsl_odr[devp->dev.regs[AD_CTRL1_XL] >> 4]);
+  }
+}
+
+/**
+ * @brief   Empties the FIFO.
+ */
+static void lsm6dsl_flush(sim_lsm6dsl_t *devp) {
+
+  devp->rd      = 0U;
+  devp->cnt     = 0U;
+  devp->pattern = 0U;
+  devp->overrun = false;
+}
+
+/**
+ * @brief   Power-on register values.
+ */
+static void lsm6dsl_reset(sim_lsm6dsl_t *devp) {
+  unsigned i;
+
+  for (i = 0U; i < SIM_DEVICE_NUM_REGS; i++) {
+    devp->dev.regs[i] = 0U;
+  }
+  devp->dev.regs[AD_WHO_AM_I] = WHO_AM_I_VALUE;
+  devp->dev.regs[AD_CTRL3_C]  = CTRL3_C_IF_INC;
+  lsm6dsl_flush(devp);
+  lsm6dsl_reclock(devp);
+}
+
+/**
+ * @brief   Pushes a word in the FIFO according to the FIFO mode.
+ */
+static void lsm6dsl_push(sim_lsm6dsl_t *devp, uint16_t word) {
+
+  if (devp->cnt >= SIM_LSM6DSL_FIFO_WORDS) {
+    if ((devp->dev.regs[AD_FIFO_CTRL5] & FIFO_MODE_MASK) == FIFO_MODE_FIFO) {
+      /* FIFO mode, stops when full.*/
+      return;
+    }
+
+    /* Continuous mode, the oldest word is overwritten.*/
+    devp->rd      = (devp->rd + 1U) % SIM_LSM6DSL_FIFO_WORDS;
+    devp->cnt--;
+    devp->pattern = (devp->pattern + 1U) % SIM_LSM6DSL_NUM_CHANNELS;
+    devp->overrun = true;
+  }
+
+  devp->fifo[(devp->rd + devp->cnt) % SIM_LSM6DSL_FIFO_WORDS] = word;
+  devp->cnt++;
+}
+
+/**
+ * @brief   Produces the samples due, bounded to the FIFO depth.
+ */
+static void lsm6dsl_update(sim_device_t *ip) {
+  sim_lsm6dsl_t *devp = (sim_lsm6dsl_t *)ip;
+  uint32_t n = simClockElapsed(&devp->clock);
+  bool fifo = lsm6dsl_fifo_enabled(devp);
+  uint32_t max = fifo ? (SIM_LSM6DSL_FIFO_WORDS /
+                         SIM_LSM6DSL_NUM_CHANNELS) + 1U : 1U;
+  unsigned ch;
+
+  if (n > max) {
+    devp->seq += n - max;
+    n = max;
+  }
+
+  while (n > 0U) {
+    for (ch = 0U; ch < SIM_LSM6DSL_NUM_CHANNELS; ch++) {
+      uint16_t word = (uint16_t)simDeviceSample(ip, devp->seq, ch);
+
+      ip->regs[AD_OUTX_L_G + (ch * 2U)]      = (uint8_t)word;
+      ip->regs[AD_OUTX_L_G + (ch * 2U) + 1U] = (uint8_t)(word >> 8);
+      if (fifo) {
+        lsm6dsl_push(devp, word);
+      }
+    }
+    ip->regs[AD_STATUS_REG] |= STATUS_XLDA | STATUS_GDA | STATUS_TDA;
+    devp->seq++;
+    n--;
+  }
+}
+
+/**
+ * @brief   SPI command decoding, bit 7 is the read flag.
+ */
+static bool lsm6dsl_command(sim_device_t *ip, uint8_t cmd, uint8_t *regp) {
+
+  (void)ip;
+
+  *regp = cmd & 0x7FU;
+
+  return (cmd & 0x80U) != 0U;
+}
+
+/**
+ * @brief   Register read, FIFO words are popped on the high byte.
+ */
+static uint8_t lsm6dsl_read(sim_device_t *ip, uint8_t reg) {
+  sim_lsm6dsl_t *devp = (sim_lsm6dsl_t *)ip;
+  uint32_t fth;
+  unsigned diff;
+  uint8_t value;
+
+  /* The unread words field is 11 bits wide, a full FIFO is signaled by
+     FIFO_FULL_SMART.*/
+  diff = devp->cnt < 0x7FFU ? devp->cnt : 0x7FFU;
+
+  switch (reg) {
+  case AD_FIFO_STATUS1:
+    return (uint8_t)diff;
+  case AD_FIFO_STATUS2:
+    fth = ip->regs[AD_FIFO_CTRL1] |
+          ((uint32_t)(ip->regs[AD_FIFO_CTRL2] & 0x07U) << 8);
+    value = (uint8_t)(diff >> 8);
+    if (devp->cnt == 0U) {
+      value |= FIFO_STATUS2_EMPTY;
+    }
+    if (devp->cnt >= SIM_LSM6DSL_FIFO_WORDS) {
+      value |= FIFO_STATUS2_FULL_SMART;
+    }
+    if (devp->overrun) {
+      value |= FIFO_STATUS2_OVER_RUN;
+    }
+    if ((fth > 0U) && (devp->cnt >= fth)) {
+      value |= FIFO_STATUS2_WATERM;
+    }
+    return value;
+  case AD_FIFO_STATUS3:
+    return (uint8_t)devp->pattern;
+  case AD_FIFO_STATUS4:
+    return (uint8_t)(devp->pattern >> 8);
+  case AD_FIFO_DATA_OUT_L:
+    return devp->cnt > 0U ? (uint8_t)devp->fifo[devp->rd] : 0U;
+  case AD_FIFO_DATA_OUT_H:
+    if (devp->cnt == 0U) {
+      return 0U;
+    }
+    value = (uint8_t)(devp->fifo[devp->rd] >> 8);
+    devp->rd      = (devp->rd + 1U) % SIM_LSM6DSL_FIFO_WORDS;
+    devp->cnt--;
+    devp->pattern = (devp->pattern + 1U) % SIM_LSM6DSL_NUM_CHANNELS;
+    devp->overrun = false;
+    return value;
+  case AD_OUTZ_H_G:
+    ip->regs[AD_STATUS_REG] &= ~STATUS_GDA;
+    break;
+  case AD_OUTZ_H_XL:
+    ip->regs[AD_STATUS_REG] &= ~STATUS_XLDA;
+    break;
+  default:
+    break;
+  }
+
+  return ip->regs[reg];
+}
+
+/**
+ * @brief   Register write.
+ */
+static void lsm6dsl_write(sim_device_t *ip, uint8_t reg, uint8_t value) {
+  sim_lsm6dsl_t *devp = (sim_lsm6dsl_t *)ip;
+
+  /* Read-only registers are ignored.*/
+  if (!((reg == 0x01U) || ((reg >= 0x04U) && (reg <= 0x0EU)) ||
+        ((reg >= AD_CTRL1_XL) && (reg <= 0x1AU)) ||
+        ((reg >= 0x58U) && (reg <= 0x60U)) ||
+        ((reg >= 0x73U) && (reg <= 0x75U))) ||
+      (reg == AD_WHO_AM_I) || (reg == 0x0CU)) {
+    return;
+  }
+
+  if ((reg == AD_CTRL3_C) && ((value & CTRL3_C_SW_RESET) != 0U)) {
+    lsm6dsl_reset(devp);
+    return;
+  }
+
+  ip->regs[reg] = value;
+
+  switch (reg) {
+  case AD_CTRL3_C:
+    ip->regs[reg] &= ~CTRL3_C_BOOT;
+    break;
+  case AD_FIFO_CTRL5:
+    if ((value & FIFO_MODE_MASK) == FIFO_MODE_BYPASS) {
+      lsm6dsl_flush(devp);
+    }
+    lsm6dsl_reclock(devp);
+    break;
+  case AD_CTRL1_XL:
+    lsm6dsl_reclock(devp);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief   Auto-increment, rolling over on the FIFO output registers.
+ */
+static uint8_t lsm6dsl_next(sim_device_t *ip, uint8_t reg) {
+
+  if ((ip->regs[AD_CTRL3_C] & CTRL3_C_IF_INC) == 0U) {
+    return reg;
+  }
+  if (reg == AD_FIFO_DATA_OUT_H) {
+    return AD_FIFO_DATA_OUT_L;
+  }
+
+  return (uint8_t)((reg + 1U) & (SIM_DEVICE_NUM_REGS - 1U));
+}
+
+static const struct sim_device_vmt lsm6dsl_vmt = {
+  lsm6dsl_update,
+  lsm6dsl_command,
+  lsm6dsl_read,
+  lsm6dsl_write,
+  lsm6dsl_next
+};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a simulated LSM6DSL in its power-on state.
+ *
+ * @param[out] devp     pointer to the @p sim_lsm6dsl_t object
+ * @param[in] address   I2C slave address
+ *
+ * @init
+ */
+void simLSM6DSLObjectInit(sim_lsm6dsl_t *devp, uint16_t address) {
+
+  simDeviceObjectInit(&devp->dev, &lsm6dsl_vmt, address);
+  devp->clock.odr = 0U;
+  devp->seq       = 0U;
+  lsm6dsl_reset(devp);
+}
+
+#endif /* (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) */
+
+/** @} */
@@ -0,0 +1,111 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_lsm6dsl.h
+ * @brief   Simulated LSM6DSL model header.
+ *
+ * @addtogroup SIM_LSM6DSL
+ * @{
+ */
+
+#ifndef SIM_LSM6DSL_H
+#define SIM_LSM6DSL_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Channels in a sample, gyroscope X, Y, Z then accelerometer
+ *          X, Y, Z.
+ */
+#define SIM_LSM6DSL_NUM_CHANNELS            6U
+
+/**
+ * @brief   FIFO depth in 16 bits words.
+ */
+#define SIM_LSM6DSL_FIFO_WORDS              2048U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Structure representing a simulated LSM6DSL.
+ */
+typedef struct {
+  /**
+   * @brief   Base device.
+   */
+  sim_device_t              dev;
+  /**
+   * @brief   Sampling clock.
+   */
+  sim_clock_t               clock;
+  /**
+   * @brief   Sequence number of the next sample.
+   */
+  uint32_t                  seq;
+  /**
+   * @brief   FIFO buffer.
+   */
+  uint16_t                  fifo[SIM_LSM6DSL_FIFO_WORDS];
+  /**
+   * @brief   FIFO read index.
+   */
+  unsigned                  rd;
+  /**
+   * @brief   Words in the FIFO.
+   */
+  unsigned                  cnt;
+  /**
+   * @brief   Position of the FIFO head word within the sample.
+   */
+  unsigned                  pattern;
+  /**
+   * @brief   Samples have been lost since the last FIFO read.
+   */
+  bool                      overrun;
+} sim_lsm6dsl_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simLSM6DSLObjectInit(sim_lsm6dsl_t *devp, uint16_t address);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_LSM6DSL_H */
+
+/** @} */
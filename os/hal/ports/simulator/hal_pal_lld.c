@@ -40,22 +40,123 @@ sim_vio_port_t vio_port_1;
  */
 sim_vio_port_t vio_port_2;
 
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE) ||                \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Event records for the 64 VIO lines.
+ */
+palevent_t _pal_events[2 * PAL_IOPORTS_WIDTH];
+#endif
+
 /*===========================================================================*/
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE)
+/**
+ * @brief   Simulated edge detector of a VIO port.
+ */
+typedef struct {
+  /**
+   * @brief   Pads enabled on rising edges.
+   */
+  uint32_t          rising;
+  /**
+   * @brief   Pads enabled on falling edges.
+   */
+  uint32_t          falling;
+  /**
+   * @brief   Pads with a pending edge.
+   */
+  uint32_t          pending;
+} sim_vio_edges_t;
+
+/**
+ * @brief   Edge detectors of the VIO ports.
+ */
+static sim_vio_edges_t vio_edges[2];
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE)
+static sim_vio_edges_t *pal_get_edges(ioportid_t port) {
+
+  return port == IOPORT1 ? &vio_edges[0] : &vio_edges[1];
+}
+#endif
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
 
+/**
+ * @brief   Serves one pending VIO edge.
+ *
+ * @return              The interrupt status.
+ * @retval false        if no edge was pending.
+ * @retval true         if an edge has been served.
+ *
+ * @notapi
+ */
+bool pal_lld_interrupt_pending(void) {
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE)
+  unsigned i, pad;
+
+  for (i = 0U; i < 2U; i++) {
+    uint32_t pending = vio_edges[i].pending;
+
+    if (pending != 0U) {
+      pad = (unsigned)__builtin_ctz(pending);
+      vio_edges[i].pending &= ~(1U << pad);
+
+      OSAL_IRQ_PROLOGUE();
+      _pal_isr_code((i * (unsigned)PAL_IOPORTS_WIDTH) + pad);
+      OSAL_IRQ_EPILOGUE();
+
+      return true;
+    }
+  }
+#endif
+
+  return false;
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
 
+/**
+ * @brief   VIO ports initialization.
+ *
+ * @param[in] config    the VIO ports configuration
+ *
+ * @notapi
+ */
+void _pal_lld_init(const PALConfig *config) {
+
+  vio_port_1 = config->VP1Data;
+  vio_port_2 = config->VP2Data;
+
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE)
+  {
+    unsigned i;
+
+    for (i = 0U; i < 2U; i++) {
+      vio_edges[i].rising  = 0U;
+      vio_edges[i].falling = 0U;
+      vio_edges[i].pending = 0U;
+    }
+
+    for (i = 0U; i < 2U * (unsigned)PAL_IOPORTS_WIDTH; i++) {
+      _pal_init_event(i);
+    }
+  }
+#endif
+}
+
 /**
  * @brief Pads mode setup.
  * @details This function programs a pads group belonging to the same port
@@ -90,6 +191,115 @@ void _pal_lld_setgroupmode(ioportid_t port,
   }
 }
 
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE) ||                \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Pad event enable.
+ * @note    Programming an unknown or unsupported mode is silently ignored.
+ *
+ * @param[in] port      port identifier
+ * @param[in] pad       pad number within the port
+ * @param[in] mode      pad event mode
+ *
+ * @notapi
+ */
+void _pal_lld_enablepadevent(ioportid_t port,
+                             iopadid_t pad,
+                             iomode_t mode) {
+  sim_vio_edges_t *edp = pal_get_edges(port);
+  uint32_t padmask = 1U << pad;
+
+  /* Programming edge registers.*/
+  if (mode & PAL_EVENT_MODE_RISING_EDGE) {
+    edp->rising |= padmask;
+  }
+  else {
+    edp->rising &= ~padmask;
+  }
+  if (mode & PAL_EVENT_MODE_FALLING_EDGE) {
+    edp->falling |= padmask;
+  }
+  else {
+    edp->falling &= ~padmask;
+  }
+}
+
+/**
+ * @brief   Pad event disable.
+ * @details This function disables previously programmed event callbacks.
+ *
+ * @param[in] port      port identifier
+ * @param[in] pad       pad number within the port
+ *
+ * @notapi
+ */
+void _pal_lld_disablepadevent(ioportid_t port, iopadid_t pad) {
+  sim_vio_edges_t *edp = pal_get_edges(port);
+  uint32_t padmask = 1U << pad;
+
+  if (((edp->rising | edp->falling) & padmask) != 0U) {
+
+    /* Disabling edges and clearing a pending edge.*/
+    edp->rising  &= ~padmask;
+    edp->falling &= ~padmask;
+    edp->pending &= ~padmask;
+
+    /* Callback cleared and/or thread reset.*/
+    _pal_clear_event(_pal_lld_event_index(port, pad));
+  }
+}
+
+/**
+ * @brief   Pad event enable check.
+ *
+ * @param[in] port      port identifier
+ * @param[in] pad       pad number within the port
+ * @return              Pad event status.
+ * @retval false        if the pad event is disabled.
+ * @retval true         if the pad event is enabled.
+ *
+ * @notapi
+ */
+bool _pal_lld_ispadeventenabled(ioportid_t port, iopadid_t pad) {
+  sim_vio_edges_t *edp = pal_get_edges(port);
+
+  return ((edp->rising | edp->falling) & (1U << pad)) != 0U;
+}
+#endif /* PAL_USE_CALLBACKS == TRUE || PAL_USE_WAIT == TRUE */
+
+/**
+ * @brief   Drives the inputs of a VIO port.
+ * @details The simulated input levels are changed and the enabled edges
+ *          are latched, the events are then served by the simulated
+ *          interrupts processing, as a real edge would be.
+ *
+ * @param[in] port      port identifier
+ * @param[in] mask      mask of the pads to be driven
+ * @param[in] bits      new logical levels of the driven pads
+ *
+ * @api
+ */
+void simPalWritePins(ioportid_t port, ioportmask_t mask, ioportmask_t bits) {
+  uint32_t old;
+
+  osalSysLock();
+
+  old = port->pin;
+  port->pin = (old & ~mask) | (bits & mask);
+
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE)
+  {
+    sim_vio_edges_t *edp = pal_get_edges(port);
+    uint32_t changed = old ^ port->pin;
+
+    edp->pending |= (changed &  port->pin & edp->rising) |
+                    (changed & ~port->pin & edp->falling);
+  }
+#endif
+
+  osalSysUnlock();
+}
+
 #endif /* HAL_USE_PAL */
 
 /** @} */
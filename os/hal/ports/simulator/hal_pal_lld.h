@@ -173,9 +173,7 @@ typedef uint32_t iopadid_t;
  *
  * @notapi
  */
-#define pal_lld_init(config)                                                \
-  (vio_port_1 = (config)->VP1Data,                                          \
-   vio_port_2 = (config)->VP2Data)
+#define pal_lld_init(config) _pal_lld_init(config)
 
 /**
  * @brief   Reads the physical I/O port states.
@@ -225,6 +223,33 @@ typedef uint32_t iopadid_t;
 #define pal_lld_setgroupmode(port, mask, offset, mode)                      \
   _pal_lld_setgroupmode(port, mask << offset, mode)
 
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE) ||                \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Pad event enable.
+ * @note    Programming an unknown or unsupported mode is silently ignored.
+ *
+ * @param[in] port      port identifier
+ * @param[in] pad       pad number within the port
+ * @param[in] mode      pad event mode
+ *
+ * @notapi
+ */
+#define pal_lld_enablepadevent(port, pad, mode)                             \
+  _pal_lld_enablepadevent(port, pad, mode)
+
+/**
+ * @brief   Pad event disable.
+ * @details This function disables previously programmed event callbacks.
+ *
+ * @param[in] port      port identifier
+ * @param[in] pad       pad number within the port
+ *
+ * @notapi
+ */
+#define pal_lld_disablepadevent(port, pad)                                  \
+  _pal_lld_disablepadevent(port, pad)
+
 /**
  * @brief   Returns a PAL event structure associated to a pad.
  *
@@ -233,7 +258,8 @@ typedef uint32_t iopadid_t;
  *
  * @notapi
  */
-#define pal_lld_get_pad_event(port, pad) NULL; (void)(port); (void)pad
+#define pal_lld_get_pad_event(port, pad)                                    \
+  &_pal_events[_pal_lld_event_index(port, pad)]
 
 /**
  * @brief   Returns a PAL event structure associated to a line.
@@ -242,20 +268,74 @@ typedef uint32_t iopadid_t;
  *
  * @notapi
  */
-#define pal_lld_get_line_event(line) NULL; (void)line
+#define pal_lld_get_line_event(line)                                        \
+  &_pal_events[_pal_lld_event_index(PAL_PORT(line), PAL_PAD(line))]
+
+/**
+ * @brief   Pad event enable check.
+ *
+ * @param[in] port      port identifier
+ * @param[in] pad       pad number within the port
+ * @return              Pad event status.
+ * @retval false        if the pad event is disabled.
+ * @retval true         if the pad event is enabled.
+ *
+ * @notapi
+ */
+#define pal_lld_ispadeventenabled(port, pad)                                \
+  _pal_lld_ispadeventenabled(port, pad)
+
+/**
+ * @brief   Index of the PAL event structure associated to a pad.
+ *
+ * @param[in] port      port identifier
+ * @param[in] pad       pad number within the port
+ *
+ * @notapi
+ */
+#define _pal_lld_event_index(port, pad)                                     \
+  (((port) == IOPORT1 ? 0U : (unsigned)PAL_IOPORTS_WIDTH) + (unsigned)(pad))
+#endif /* PAL_USE_CALLBACKS == TRUE || PAL_USE_WAIT == TRUE */
+
+/**
+ * @brief   Sets the level of a simulated input line.
+ *
+ * @param[in] line      line identifier
+ * @param[in] bit       logical value, the value must be @p PAL_LOW or
+ *                      @p PAL_HIGH
+ *
+ * @api
+ */
+#define simPalWriteLinePin(line, bit)                                       \
+  simPalWritePins(PAL_PORT(line), PAL_PORT_BIT(PAL_PAD(line)),              \
+                  (ioportmask_t)(bit) << PAL_PAD(line))
 
 #if !defined(__DOXYGEN__)
 extern sim_vio_port_t vio_port_1;
 extern sim_vio_port_t vio_port_2;
 extern const PALConfig pal_default_config;
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE)
+extern palevent_t _pal_events[2 * PAL_IOPORTS_WIDTH];
+#endif
 #endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
+  void _pal_lld_init(const PALConfig *config);
   void _pal_lld_setgroupmode(ioportid_t port,
                              ioportmask_t mask,
                              iomode_t mode);
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE)
+  void _pal_lld_enablepadevent(ioportid_t port,
+                               iopadid_t pad,
+                               iomode_t mode);
+  void _pal_lld_disablepadevent(ioportid_t port, iopadid_t pad);
+  bool _pal_lld_ispadeventenabled(ioportid_t port, iopadid_t pad);
+#endif
+  void simPalWritePins(ioportid_t port, ioportmask_t mask,
+                       ioportmask_t bits);
+  bool pal_lld_interrupt_pending(void);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,396 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/posix/hal_can_lld.c
+ * @brief   Posix simulator low level CAN driver code.
+ * @details All the simulated controllers are attached to a single ideal
+ *          bus. Pending frames are arbitrated by identifier like on a
+ *          real bus and delivered to all the other active nodes, a frame
+ *          per simulated interrupt.
+ *
+ * @addtogroup POSIX_CAN
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_CAN == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Mask of all the transmit mailboxes.
+ */
+#define SIM_CAN_TX_ALL              ((1U << CAN_TX_MAILBOXES) - 1U)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   CAN1 driver identifier.
+ */
+#if (USE_SIM_CAN1 == TRUE) || defined(__DOXYGEN__)
+CANDriver CAND1;
+#endif
+
+/**
+ * @brief   CAN2 driver identifier.
+ */
+#if (USE_SIM_CAN2 == TRUE) || defined(__DOXYGEN__)
+CANDriver CAND2;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Nodes attached to the simulated bus.
+ */
+static CANDriver * const sim_can_nodes[] = {
+#if USE_SIM_CAN1 == TRUE
+  &CAND1,
+#endif
+#if USE_SIM_CAN2 == TRUE
+  &CAND2,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Transmission requests counter.
+ */
+static uint32_t sim_can_seq;
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Arbitration key of a frame, lower keys win.
+ *
+ * @param[in] ctfp      pointer to the frame
+ * @return              The arbitration key.
+ */
+static uint32_t sim_can_key(const CANTxFrame *ctfp) {
+
+  if (ctfp->IDE != 0U) {
+    return ((ctfp->EID >> 18) << 20) | (1U << 19) |
+           ((ctfp->EID & 0x3FFFFU) << 1) | ctfp->RTR;
+  }
+
+  return ((uint32_t)ctfp->SID << 20) | ctfp->RTR;
+}
+
+/**
+ * @brief   Stores a frame in the hardware FIFO of a node.
+ *
+ * @param[in] canp      pointer to the receiving @p CANDriver object
+ * @param[in] ctfp      pointer to the frame on the bus
+ * @return              The operation result.
+ * @retval false        frame stored.
+ * @retval true         FIFO overflow, the frame has been lost.
+ */
+static bool sim_can_deliver(CANDriver *canp, const CANTxFrame *ctfp) {
+  CANRxFrame *crfp;
+
+  if (canp->rxhwcnt >= SIM_CAN_RX_FIFO_SIZE) {
+    return true;
+  }
+
+  crfp = &canp->rxhw[(canp->rxhwrd + canp->rxhwcnt) % SIM_CAN_RX_FIFO_SIZE];
+  crfp->FMI  = 0U;
+  crfp->TIME = (uint16_t)osalOsGetSystemTimeX();
+  crfp->DLC  = ctfp->DLC;
+  crfp->RTR  = ctfp->RTR;
+  crfp->IDE  = ctfp->IDE;
+  if (ctfp->IDE != 0U) {
+    crfp->EID = ctfp->EID;
+  }
+  else {
+    crfp->SID = ctfp->SID;
+  }
+  crfp->data32[0] = ctfp->data32[0];
+  crfp->data32[1] = ctfp->data32[1];
+  canp->rxhwcnt++;
+
+  return false;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level CAN driver initialization.
+ *
+ * @notapi
+ */
+void can_lld_init(void) {
+
+#if USE_SIM_CAN1 == TRUE
+  canObjectInit(&CAND1);
+  CAND1.online = false;
+#endif
+#if USE_SIM_CAN2 == TRUE
+  canObjectInit(&CAND2);
+  CAND2.online = false;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the CAN peripheral.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+void can_lld_start(CANDriver *canp) {
+
+  canp->txpending = 0U;
+  canp->rxhwrd    = 0U;
+  canp->rxhwcnt   = 0U;
+  canp->online    = true;
+}
+
+/**
+ * @brief   Deactivates the CAN peripheral.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+void can_lld_stop(CANDriver *canp) {
+
+  canp->online    = false;
+  canp->txpending = 0U;
+  canp->rxhwcnt   = 0U;
+}
+
+/**
+ * @brief   Determines whether a frame can be transmitted.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] mailbox   mailbox number, @p CAN_ANY_MAILBOX for any mailbox
+ *
+ * @return              The queue space availability.
+ * @retval false        no space in the transmit queue.
+ * @retval true         transmit slot available.
+ *
+ * @notapi
+ */
+bool can_lld_is_tx_empty(CANDriver *canp, canmbx_t mailbox) {
+
+  if (mailbox == CAN_ANY_MAILBOX) {
+    return canp->txpending != SIM_CAN_TX_ALL;
+  }
+
+  return (canp->txpending & CAN_MAILBOX_TO_MASK(mailbox)) == 0U;
+}
+
+/**
+ * @brief   Inserts a frame into the transmit queue.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] ctfp      pointer to the CAN frame to be transmitted
+ * @param[in] mailbox   mailbox number,  @p CAN_ANY_MAILBOX for any mailbox
+ *
+ * @notapi
+ */
+void can_lld_transmit(CANDriver *canp,
+                      canmbx_t mailbox,
+                      const CANTxFrame *ctfp) {
+
+  if (mailbox == CAN_ANY_MAILBOX) {
+    mailbox = 1U;
+    while ((canp->txpending & CAN_MAILBOX_TO_MASK(mailbox)) != 0U) {
+      mailbox++;
+    }
+  }
+
+  canp->txmb[mailbox - 1U]  = *ctfp;
+  canp->txseq[mailbox - 1U] = sim_can_seq++;
+  canp->txpending |= CAN_MAILBOX_TO_MASK(mailbox);
+}
+
+/**
+ * @brief   Determines whether a frame has been received.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] mailbox   mailbox number, @p CAN_ANY_MAILBOX for any mailbox
+ *
+ * @return              The receive FIFO status.
+ * @retval false        no frames available.
+ * @retval true         at least one frame available.
+ *
+ * @notapi
+ */
+bool can_lld_is_rx_nonempty(CANDriver *canp, canmbx_t mailbox) {
+
+  (void)mailbox;
+
+  return canp->rxhwcnt > 0U;
+}
+
+/**
+ * @brief   Receives a frame from the input queue.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] mailbox   mailbox number, @p CAN_ANY_MAILBOX for any mailbox
+ * @param[out] crfp     pointer to the buffer where the CAN frame is copied
+ *
+ * @notapi
+ */
+void can_lld_receive(CANDriver *canp,
+                     canmbx_t mailbox,
+                     CANRxFrame *crfp) {
+
+  (void)mailbox;
+
+  *crfp = canp->rxhw[canp->rxhwrd];
+  canp->rxhwrd = (canp->rxhwrd + 1U) % SIM_CAN_RX_FIFO_SIZE;
+  canp->rxhwcnt--;
+}
+
+/**
+ * @brief   Tries to abort an ongoing transmission.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] mailbox   mailbox number
+ *
+ * @notapi
+ */
+void can_lld_abort(CANDriver *canp,
+                   canmbx_t mailbox) {
+
+  canp->txpending &= ~CAN_MAILBOX_TO_MASK(mailbox);
+}
+
+#if (CAN_USE_SLEEP_MODE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Enters the sleep mode.
+ * @note    A sleeping node neither transmits nor receives.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+void can_lld_sleep(CANDriver *canp) {
+
+  canp->online = false;
+}
+
+/**
+ * @brief   Enforces leaving the sleep mode.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+void can_lld_wakeup(CANDriver *canp) {
+
+  canp->online = true;
+}
+#endif /* CAN_USE_SLEEP_MODE == TRUE */
+
+/**
+ * @brief   Bus activity simulation.
+ * @details The highest priority pending frame among all the active nodes
+ *          wins the arbitration and is delivered to the other nodes, or
+ *          also to the sender in loopback mode. Frames with the same
+ *          identifier are transmitted in request order.
+ *
+ * @return              The interrupt activity.
+ * @retval false        no frames were pending.
+ * @retval true         a frame has been transferred on the bus.
+ *
+ * @notapi
+ */
+bool can_lld_interrupt_pending(void) {
+  CANDriver *txp = NULL;
+  canmbx_t txmbx = 0U;
+  uint32_t txkey = 0U, txseq = 0U;
+  const CANTxFrame *ctfp;
+  unsigned i;
+
+  /* Arbitration.*/
+  for (i = 0U; sim_can_nodes[i] != NULL; i++) {
+    CANDriver *canp = sim_can_nodes[i];
+    canmbx_t mbx;
+
+    if (!canp->online || (canp->state != CAN_READY)) {
+      continue;
+    }
+    for (mbx = 1U; mbx <= (canmbx_t)CAN_TX_MAILBOXES; mbx++) {
+      if ((canp->txpending & CAN_MAILBOX_TO_MASK(mbx)) != 0U) {
+        uint32_t key = sim_can_key(&canp->txmb[mbx - 1U]);
+        uint32_t seq = canp->txseq[mbx - 1U];
+
+        if ((txp == NULL) || (key < txkey) ||
+            ((key == txkey) && ((int32_t)(seq - txseq) < 0))) {
+          txp   = canp;
+          txmbx = mbx;
+          txkey = key;
+          txseq = seq;
+        }
+      }
+    }
+  }
+
+  if (txp == NULL) {
+    return false;
+  }
+
+  OSAL_IRQ_PROLOGUE();
+
+  /* Delivery to the receiving nodes.*/
+  ctfp = &txp->txmb[txmbx - 1U];
+  for (i = 0U; sim_can_nodes[i] != NULL; i++) {
+    CANDriver *canp = sim_can_nodes[i];
+
+    if (!canp->online || (canp->state != CAN_READY) ||
+        ((canp == txp) &&
+         ((txp->config == NULL) || !txp->config->loopback))) {
+      continue;
+    }
+    if (sim_can_deliver(canp, ctfp)) {
+      _can_error_isr(canp, CAN_OVERFLOW_ERROR);
+    }
+    else {
+      _can_rx_full_isr(canp, CAN_MAILBOX_TO_MASK(1U));
+    }
+  }
+
+  /* Transmission complete.*/
+  txp->txpending &= ~CAN_MAILBOX_TO_MASK(txmbx);
+  _can_tx_empty_isr(txp, CAN_MAILBOX_TO_MASK(txmbx));
+
+  OSAL_IRQ_EPILOGUE();
+
+  return true;
+}
+
+#endif /* HAL_USE_CAN == TRUE */
+
+/** @} */
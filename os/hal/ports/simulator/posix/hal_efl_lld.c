@@ -0,0 +1,368 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/posix/hal_efl_lld.c
+ * @brief   Posix simulator Embedded Flash subsystem low level driver source.
+ * @details The flash array is kept in memory and, optionally, written
+ *          through to a backing file so that its content persists across
+ *          simulator runs. Program operations can only clear bits, like
+ *          a real NOR flash.
+ *
+ * @addtogroup POSIX_EFL
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if (HAL_USE_EFL == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   EFL1 driver identifier.
+ */
+EFlashDriver EFLD1;
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+static uint8_t efl_lld_image[SIM_EFL_SIZE];
+
+static const flash_descriptor_t efl_lld_descriptor = {
+  .attributes        = FLASH_ATTR_ERASED_IS_ONE |
+                       FLASH_ATTR_REWRITABLE,
+  .page_size         = SIM_EFL_PAGE_SIZE,
+  .sectors_count     = SIM_EFL_SECTORS_COUNT,
+  .sectors           = NULL,
+  .sectors_size      = SIM_EFL_SECTOR_SIZE,
+  .address           = NULL,
+  .size              = SIM_EFL_SIZE
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static flash_error_t sim_efl_sync(EFlashDriver *eflp,
+                                  flash_offset_t offset, size_t n) {
+
+  if (eflp->fd == -1) {
+    return FLASH_NO_ERROR;
+  }
+
+  if (pwrite(eflp->fd, &eflp->image[offset], n, (off_t)offset) != (ssize_t)n) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level Embedded Flash driver initialization.
+ *
+ * @notapi
+ */
+void efl_lld_init(void) {
+
+  /* Driver initialization.*/
+  eflObjectInit(&EFLD1);
+  EFLD1.fd    = -1;
+  EFLD1.image = efl_lld_image;
+  memset(efl_lld_image, 0xFF, sizeof efl_lld_image);
+}
+
+/**
+ * @brief   Configures and activates the Embedded Flash peripheral.
+ * @details If a backing file is specified then the flash content is
+ *          loaded from it, the file is created in erased state if it
+ *          does not exist.
+ *
+ * @param[in] eflp      pointer to a @p EFlashDriver structure
+ *
+ * @notapi
+ */
+void efl_lld_start(EFlashDriver *eflp) {
+  ssize_t n;
+
+  if ((eflp->config == NULL) || (eflp->config->filename == NULL) ||
+      (eflp->fd != -1)) {
+    return;
+  }
+
+  eflp->fd = open(eflp->config->filename, O_RDWR | O_CREAT, 0644);
+  if (eflp->fd == -1) {
+    printf("EFL1: Unable to open %s\n", eflp->config->filename);
+    return;
+  }
+
+  /* Missing or partial file, the missing part is erased.*/
+  memset(eflp->image, 0xFF, SIM_EFL_SIZE);
+  n = pread(eflp->fd, eflp->image, SIM_EFL_SIZE, 0);
+  if (n < (ssize_t)SIM_EFL_SIZE) {
+    (void)sim_efl_sync(eflp, 0U, SIM_EFL_SIZE);
+  }
+}
+
+/**
+ * @brief   Deactivates the Embedded Flash peripheral.
+ *
+ * @param[in] eflp      pointer to a @p EFlashDriver structure
+ *
+ * @notapi
+ */
+void efl_lld_stop(EFlashDriver *eflp) {
+
+  if (eflp->fd != -1) {
+    close(eflp->fd);
+    eflp->fd = -1;
+  }
+}
+
+/**
+ * @brief   Gets the flash descriptor structure.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @return                          A flash device descriptor.
+ *
+ * @notapi
+ */
+const flash_descriptor_t *efl_lld_get_descriptor(void *instance) {
+
+  (void)instance;
+
+  return &efl_lld_descriptor;
+}
+
+/**
+ * @brief   Read operation.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @param[in] offset                flash offset
+ * @param[in] n                     number of bytes to be read
+ * @param[out] rp                   pointer to the data buffer
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if there is no erase operation in progress.
+ * @retval FLASH_BUSY_ERASING       if there is an erase operation in progress.
+ *
+ * @notapi
+ */
+flash_error_t efl_lld_read(void *instance, flash_offset_t offset,
+                           size_t n, uint8_t *rp) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+
+  osalDbgCheck((instance != NULL) && (rp != NULL) && (n > 0U));
+  osalDbgCheck((size_t)offset + n <= (size_t)SIM_EFL_SIZE);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  /* No reading while erasing.*/
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  memcpy((void *)rp, (const void *)&devp->image[offset], n);
+
+  return FLASH_NO_ERROR;
+}
+
+/**
+ * @brief   Program operation.
+ * @note    Programming can only clear bits, the result is the bitwise AND
+ *          of the previous content and the programmed data.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @param[in] offset                flash offset
+ * @param[in] n                     number of bytes to be programmed
+ * @param[in] pp                    pointer to the data buffer
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if there is no erase operation in progress.
+ * @retval FLASH_BUSY_ERASING       if there is an erase operation in progress.
+ * @retval FLASH_ERROR_HW_FAILURE   if the backing file cannot be written.
+ *
+ * @notapi
+ */
+flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
+                              size_t n, const uint8_t *pp) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+  size_t i;
+
+  osalDbgCheck((instance != NULL) && (pp != NULL) && (n > 0U));
+  osalDbgCheck((size_t)offset + n <= (size_t)SIM_EFL_SIZE);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  /* No programming while erasing.*/
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  for (i = 0U; i < n; i++) {
+    devp->image[offset + i] &= pp[i];
+  }
+
+  return sim_efl_sync(devp, offset, n);
+}
+
+/**
+ * @brief   Starts a whole-device erase operation.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if there is no erase operation in progress.
+ * @retval FLASH_BUSY_ERASING       if there is an erase operation in progress.
+ * @retval FLASH_ERROR_HW_FAILURE   if the backing file cannot be written.
+ *
+ * @notapi
+ */
+flash_error_t efl_lld_start_erase_all(void *instance) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  /* No erasing while erasing.*/
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  /* The erase is performed immediately, the state is left to
+     FLASH_ERASE until the operation is queried.*/
+  devp->state = FLASH_ERASE;
+  memset(devp->image, 0xFF, SIM_EFL_SIZE);
+
+  return sim_efl_sync(devp, 0U, SIM_EFL_SIZE);
+}
+
+/**
+ * @brief   Starts an sector erase operation.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @param[in] sector                sector to be erased
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if there is no erase operation in progress.
+ * @retval FLASH_BUSY_ERASING       if there is an erase operation in progress.
+ * @retval FLASH_ERROR_HW_FAILURE   if the backing file cannot be written.
+ *
+ * @notapi
+ */
+flash_error_t efl_lld_start_erase_sector(void *instance,
+                                         flash_sector_t sector) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+  flash_offset_t offset;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgCheck(sector < SIM_EFL_SECTORS_COUNT);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  /* No erasing while erasing.*/
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  /* The erase is performed immediately, the state is left to
+     FLASH_ERASE until the operation is queried.*/
+  devp->state = FLASH_ERASE;
+  offset = (flash_offset_t)sector * (flash_offset_t)SIM_EFL_SECTOR_SIZE;
+  memset(&devp->image[offset], 0xFF, SIM_EFL_SECTOR_SIZE);
+
+  return sim_efl_sync(devp, offset, SIM_EFL_SECTOR_SIZE);
+}
+
+/**
+ * @brief   Queries the driver for erase operation progress.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @param[out] msec                 recommended time, in milliseconds, that
+ *                                  should be spent before calling this
+ *                                  function again, can be @p NULL
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if there is no erase operation in progress.
+ *
+ * @notapi
+ */
+flash_error_t efl_lld_query_erase(void *instance, uint32_t *msec) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+
+  (void)msec;
+
+  /* Erase operations are always already complete.*/
+  if (devp->state == FLASH_ERASE) {
+    devp->state = FLASH_READY;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+/**
+ * @brief   Returns the erase state of a sector.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @param[in] sector                sector to be verified
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if the sector is erased.
+ * @retval FLASH_BUSY_ERASING       if there is an erase operation in progress.
+ * @retval FLASH_ERROR_VERIFY       if the verify operation failed.
+ *
+ * @notapi
+ */
+flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+  const uint8_t *p;
+  uint32_t i;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgCheck(sector < SIM_EFL_SECTORS_COUNT);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  /* No verifying while erasing.*/
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  p = &devp->image[(flash_offset_t)sector * (flash_offset_t)SIM_EFL_SECTOR_SIZE];
+  for (i = 0U; i < SIM_EFL_SECTOR_SIZE; i++) {
+    if (p[i] != 0xFFU) {
+      return FLASH_ERROR_VERIFY;
+    }
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+#endif /* HAL_USE_EFL == TRUE */
+
+/** @} */
@@ -0,0 +1,328 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/posix/hal_i2c_lld.c
+ * @brief   Posix simulator low level I2C driver code.
+ * @details Transactions are routed by slave address to the device models
+ *          attached to the bus. Data is exchanged with the model when the
+ *          transaction starts, the completion is signaled by a simulated
+ *          interrupt after the bus time computed from the configuration.
+ *
+ * @addtogroup POSIX_I2C
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_I2C == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   I2C1 driver identifier.
+ */
+#if (USE_SIM_I2C1 == TRUE) || defined(__DOXYGEN__)
+I2CDriver I2CD1;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated controllers.
+ */
+static I2CDriver * const sim_i2c_drivers[] = {
+#if USE_SIM_I2C1 == TRUE
+  &I2CD1,
+#endif
+  NULL
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Finds the device answering to an address.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] addr      slave device address
+ * @return              The device or @p NULL if no device acknowledges.
+ */
+static sim_device_t *sim_i2c_find(I2CDriver *i2cp, i2caddr_t addr) {
+  sim_device_t *devp = i2cp->devices;
+
+  while ((devp != NULL) && (devp->address != addr)) {
+    devp = devp->next;
+  }
+
+  return devp;
+}
+
+/**
+ * @brief   Accounts a transaction and schedules its completion.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] bytes     bytes on the bus, address bytes included
+ */
+static void sim_i2c_schedule(I2CDriver *i2cp, size_t bytes) {
+  struct timeval tv;
+  uint64_t ns = i2cp->config->latency;
+
+  if (i2cp->config->clock_speed > 0U) {
+    ns += ((uint64_t)bytes * 9U * 1000000000U) / i2cp->config->clock_speed;
+  }
+
+  i2cp->stats.transactions++;
+  i2cp->stats.bytes   += (uint32_t)bytes;
+  i2cp->stats.bustime += ns;
+
+  gettimeofday(&i2cp->deadline, NULL);
+  tv.tv_sec  = (time_t)(ns / 1000000000U);
+  tv.tv_usec = (suseconds_t)((ns % 1000000000U) / 1000U);
+  timeradd(&i2cp->deadline, &tv, &i2cp->deadline);
+  i2cp->pending = true;
+}
+
+/**
+ * @brief   Waits for the transaction completion.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The operation status.
+ */
+static msg_t sim_i2c_wait(I2CDriver *i2cp, sysinterval_t timeout) {
+  msg_t msg;
+
+  msg = osalThreadSuspendTimeoutS(&i2cp->thread, timeout);
+  if (msg == MSG_TIMEOUT) {
+    i2cp->pending = false;
+  }
+
+  return msg;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level I2C driver initialization.
+ *
+ * @notapi
+ */
+void i2c_lld_init(void) {
+
+#if USE_SIM_I2C1 == TRUE
+  i2cObjectInit(&I2CD1);
+  I2CD1.thread  = NULL;
+  I2CD1.devices = NULL;
+  I2CD1.pending = false;
+  I2CD1.stats.transactions = 0U;
+  I2CD1.stats.bytes        = 0U;
+  I2CD1.stats.bustime      = 0U;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the I2C peripheral.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ *
+ * @notapi
+ */
+void i2c_lld_start(I2CDriver *i2cp) {
+
+  i2cp->pending = false;
+}
+
+/**
+ * @brief   Deactivates the I2C peripheral.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ *
+ * @notapi
+ */
+void i2c_lld_stop(I2CDriver *i2cp) {
+
+  i2cp->pending = false;
+}
+
+/**
+ * @brief   Receives data via the I2C bus as master.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] addr      slave device address
+ * @param[out] rxbuf    pointer to the receive buffer
+ * @param[in] rxbytes   number of bytes to be received
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end. <b>After a
+ *                      timeout the driver must be stopped and restarted
+ *                      because the bus is in an uncertain state</b>.
+ *
+ * @notapi
+ */
+msg_t i2c_lld_master_receive_timeout(I2CDriver *i2cp, i2caddr_t addr,
+                                     uint8_t *rxbuf, size_t rxbytes,
+                                     sysinterval_t timeout) {
+  sim_device_t *devp = sim_i2c_find(i2cp, addr);
+
+  i2cp->errors = I2C_NO_ERROR;
+
+  if (devp == NULL) {
+    i2cp->errors = I2C_ACK_FAILURE;
+    sim_i2c_schedule(i2cp, 1U);
+  }
+  else {
+    simDeviceBegin(devp);
+    simDeviceI2CRead(devp, rxbuf, rxbytes);
+    simDeviceEnd(devp);
+    sim_i2c_schedule(i2cp, 1U + rxbytes);
+  }
+
+  return sim_i2c_wait(i2cp, timeout);
+}
+
+/**
+ * @brief   Transmits data via the I2C bus as master.
+ * @details The write phase and the optional read phase, after a repeated
+ *          start, form a single transaction on the device model.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] addr      slave device address
+ * @param[in] txbuf     pointer to the transmit buffer
+ * @param[in] txbytes   number of bytes to be transmitted
+ * @param[out] rxbuf    pointer to the receive buffer
+ * @param[in] rxbytes   number of bytes to be received
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end. <b>After a
+ *                      timeout the driver must be stopped and restarted
+ *                      because the bus is in an uncertain state</b>.
+ *
+ * @notapi
+ */
+msg_t i2c_lld_master_transmit_timeout(I2CDriver *i2cp, i2caddr_t addr,
+                                      const uint8_t *txbuf, size_t txbytes,
+                                      uint8_t *rxbuf, size_t rxbytes,
+                                      sysinterval_t timeout) {
+  sim_device_t *devp = sim_i2c_find(i2cp, addr);
+
+  i2cp->errors = I2C_NO_ERROR;
+
+  if (devp == NULL) {
+    i2cp->errors = I2C_ACK_FAILURE;
+    sim_i2c_schedule(i2cp, 1U);
+  }
+  else {
+    simDeviceBegin(devp);
+    simDeviceI2CWrite(devp, txbuf, txbytes);
+    if (rxbytes > 0U) {
+      simDeviceI2CRead(devp, rxbuf, rxbytes);
+    }
+    simDeviceEnd(devp);
+    sim_i2c_schedule(i2cp, 1U + txbytes + (rxbytes > 0U ? 1U + rxbytes : 0U));
+  }
+
+  return sim_i2c_wait(i2cp, timeout);
+}
+
+/**
+ * @brief   Attaches a device model to the bus.
+ * @note    The device answers to the address it has been initialized with.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] devp      pointer to the @p sim_device_t object
+ *
+ * @api
+ */
+void i2c_lld_attach_device(I2CDriver *i2cp, sim_device_t *devp) {
+
+  osalDbgCheck((i2cp != NULL) && (devp != NULL));
+
+  osalSysLock();
+  devp->next    = i2cp->devices;
+  i2cp->devices = devp;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Bus activity simulation.
+ * @details Completes the transfers whose bus time has elapsed.
+ *
+ * @return              The interrupt activity.
+ * @retval false        no transfers completed.
+ * @retval true         a transfer has been completed.
+ *
+ * @notapi
+ */
+bool i2c_lld_interrupt_pending(void) {
+  struct timeval tv;
+  unsigned i;
+
+  gettimeofday(&tv, NULL);
+  for (i = 0U; sim_i2c_drivers[i] != NULL; i++) {
+    I2CDriver *i2cp = sim_i2c_drivers[i];
+
+    if (i2cp->pending && timercmp(&tv, &i2cp->deadline, >=)) {
+      i2cp->pending = false;
+
+      OSAL_IRQ_PROLOGUE();
+
+      if (i2cp->errors != I2C_NO_ERROR) {
+        _i2c_wakeup_error_isr(i2cp);
+      }
+      else {
+        _i2c_wakeup_isr(i2cp);
+      }
+
+      OSAL_IRQ_EPILOGUE();
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#endif /* HAL_USE_I2C == TRUE */
+
+/** @} */
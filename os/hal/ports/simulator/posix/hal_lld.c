@@ -72,12 +72,36 @@ void _sim_check_for_interrupts(void) {
   struct timeval tv;
   bool int_occurred = false;
 
+#if HAL_USE_PAL
+  while (pal_lld_interrupt_pending()) {
+    int_occurred = true;
+  }
+#endif
+
 #if HAL_USE_SERIAL
   while (sd_lld_interrupt_pending()) {
     int_occurred = true;
   }
 #endif
 
+#if HAL_USE_CAN
+  while (can_lld_interrupt_pending()) {
+    int_occurred = true;
+  }
+#endif
+
+#if HAL_USE_I2C
+  while (i2c_lld_interrupt_pending()) {
+    int_occurred = true;
+  }
+#endif
+
+#if HAL_USE_SPI
+  while (spi_lld_interrupt_pending()) {
+    int_occurred = true;
+  }
+#endif
+
   gettimeofday(&tv, NULL);
   if (timercmp(&tv, &nextcnt, >=)) {
     int_occurred = true;
@@ -77,6 +77,24 @@
  */
 #define hal_lld_get_clock_point(clkpt) 0U
 
+/**
+ * @name    Cache management
+ * @note    There is no DMA in the simulator, buffers are always coherent.
+ * @{
+ */
+#define CACHE_SIZE_ALIGN(t, n) (n)
+
+#define cacheBufferInvalidate(addr, size) {                                 \
+  (void)(addr);                                                             \
+  (void)(size);                                                             \
+}
+
+#define cacheBufferFlush(addr, size) {                                      \
+  (void)(addr);                                                             \
+  (void)(size);                                                             \
+}
+/** @} */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
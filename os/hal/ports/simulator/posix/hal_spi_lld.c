@@ -0,0 +1,315 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/posix/hal_spi_lld.c
+ * @brief   Posix simulator low level SPI driver code.
+ * @details The device model selected by the active configuration takes
+ *          the role of the chip select line. Data is exchanged with the
+ *          model when an operation starts, the completion is signaled by a
+ *          simulated interrupt after the bus time computed from the
+ *          configuration.
+ *
+ * @addtogroup POSIX_SPI
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if (HAL_USE_SPI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   SPI1 driver identifier.
+ */
+#if (USE_SIM_SPI1 == TRUE) || defined(__DOXYGEN__)
+SPIDriver SPID1;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated controllers.
+ */
+static SPIDriver * const sim_spi_drivers[] = {
+#if USE_SIM_SPI1 == TRUE
+  &SPID1,
+#endif
+  NULL
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Exchanges data with the selected device and schedules the
+ *          operation completion.
+ * @note    Without a selected device the bus floats high.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of frames
+ * @param[in] txbuf     the pointer to the transmit buffer or @p NULL
+ * @param[out] rxbuf    the pointer to the receive buffer or @p NULL
+ */
+static void sim_spi_start(SPIDriver *spip, size_t n,
+                          const uint8_t *txbuf, uint8_t *rxbuf) {
+  struct timeval tv;
+  uint64_t ns = spip->config->latency;
+
+  if (spip->selected && (spip->config->device != NULL)) {
+    simDeviceSPIExchange(spip->config->device, txbuf, rxbuf, n);
+  }
+  else if (rxbuf != NULL) {
+    memset(rxbuf, 0xFF, n);
+  }
+
+  if (spip->config->bitrate > 0U) {
+    ns += ((uint64_t)n * 8U * 1000000000U) / spip->config->bitrate;
+  }
+
+  spip->stats.bytes   += (uint32_t)n;
+  spip->stats.bustime += ns;
+
+  gettimeofday(&spip->deadline, NULL);
+  tv.tv_sec  = (time_t)(ns / 1000000000U);
+  tv.tv_usec = (suseconds_t)((ns % 1000000000U) / 1000U);
+  timeradd(&spip->deadline, &tv, &spip->deadline);
+  spip->pending = true;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level SPI driver initialization.
+ *
+ * @notapi
+ */
+void spi_lld_init(void) {
+
+#if USE_SIM_SPI1 == TRUE
+  spiObjectInit(&SPID1);
+  SPID1.selected = false;
+  SPID1.pending  = false;
+  SPID1.stats.transactions = 0U;
+  SPID1.stats.bytes        = 0U;
+  SPID1.stats.bustime      = 0U;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the SPI peripheral.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_start(SPIDriver *spip) {
+
+  spip->selected = false;
+  spip->pending  = false;
+}
+
+/**
+ * @brief   Deactivates the SPI peripheral.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_stop(SPIDriver *spip) {
+
+  spip->selected = false;
+  spip->pending  = false;
+}
+
+/**
+ * @brief   Asserts the slave select signal and prepares for transfers.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_select(SPIDriver *spip) {
+
+  spip->selected = true;
+  if (spip->config->device != NULL) {
+    simDeviceBegin(spip->config->device);
+  }
+}
+
+/**
+ * @brief   Deasserts the slave select signal.
+ * @details The previously selected peripheral is unselected.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_unselect(SPIDriver *spip) {
+
+  if (spip->selected) {
+    spip->selected = false;
+    spip->stats.transactions++;
+    if (spip->config->device != NULL) {
+      simDeviceEnd(spip->config->device);
+    }
+  }
+}
+
+/**
+ * @brief   Ignores data on the SPI bus.
+ * @details This asynchronous function starts the transmission of a series of
+ *          idle words on the SPI bus and ignores the received data.
+ * @post    At the end of the operation the configured callback is invoked.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to be ignored
+ *
+ * @notapi
+ */
+void spi_lld_ignore(SPIDriver *spip, size_t n) {
+
+  sim_spi_start(spip, n, NULL, NULL);
+}
+
+/**
+ * @brief   Exchanges data on the SPI bus.
+ * @details This asynchronous function starts a simultaneous transmit/receive
+ *          operation.
+ * @post    At the end of the operation the configured callback is invoked.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to be exchanged
+ * @param[in] txbuf     the pointer to the transmit buffer
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @notapi
+ */
+void spi_lld_exchange(SPIDriver *spip, size_t n,
+                      const void *txbuf, void *rxbuf) {
+
+  sim_spi_start(spip, n, txbuf, rxbuf);
+}
+
+/**
+ * @brief   Sends data over the SPI bus.
+ * @details This asynchronous function starts a transmit operation.
+ * @post    At the end of the operation the configured callback is invoked.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to send
+ * @param[in] txbuf     the pointer to the transmit buffer
+ *
+ * @notapi
+ */
+void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf) {
+
+  sim_spi_start(spip, n, txbuf, NULL);
+}
+
+/**
+ * @brief   Receives data from the SPI bus.
+ * @details This asynchronous function starts a receive operation.
+ * @post    At the end of the operation the configured callback is invoked.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to receive
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @notapi
+ */
+void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) {
+
+  sim_spi_start(spip, n, NULL, rxbuf);
+}
+
+/**
+ * @brief   Exchanges one frame using a polled wait.
+ * @details The bus time is accounted but not waited for.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] frame     the data frame to send over the SPI bus
+ * @return              The received data frame from the SPI bus.
+ */
+uint16_t spi_lld_polled_exchange(SPIDriver *spip, uint16_t frame) {
+  uint8_t tx = (uint8_t)frame, rx = 0xFFU;
+
+  if (spip->selected && (spip->config->device != NULL)) {
+    simDeviceSPIExchange(spip->config->device, &tx, &rx, 1U);
+  }
+
+  spip->stats.bytes++;
+  if (spip->config->bitrate > 0U) {
+    spip->stats.bustime += (8U * (uint64_t)1000000000U) /
+                           spip->config->bitrate;
+  }
+
+  return (uint16_t)rx;
+}
+
+/**
+ * @brief   Bus activity simulation.
+ * @details Completes the operations whose bus time has elapsed.
+ *
+ * @return              The interrupt activity.
+ * @retval false        no operations completed.
+ * @retval true         an operation has been completed.
+ *
+ * @notapi
+ */
+bool spi_lld_interrupt_pending(void) {
+  struct timeval tv;
+  unsigned i;
+
+  gettimeofday(&tv, NULL);
+  for (i = 0U; sim_spi_drivers[i] != NULL; i++) {
+    SPIDriver *spip = sim_spi_drivers[i];
+
+    if (spip->pending && timercmp(&tv, &spip->deadline, >=)) {
+      spip->pending = false;
+
+      OSAL_IRQ_PROLOGUE();
+      _spi_isr_code(spip);
+      OSAL_IRQ_EPILOGUE();
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#endif /* HAL_USE_SPI == TRUE */
+
+/** @} */
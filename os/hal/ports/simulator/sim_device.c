@@ -0,0 +1,243 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_device.c
+ * @brief   Simulated bus devices code.
+ *
+ * @addtogroup SIM_DEVICE
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a device model.
+ * @note    Registers are cleared, the model sets its reset values after
+ *          calling this function.
+ *
+ * @param[out] devp     pointer to the @p sim_device_t object
+ * @param[in] vmt       model methods
+ * @param[in] address   I2C slave address, ignored on SPI
+ *
+ * @init
+ */
+void simDeviceObjectInit(sim_device_t *devp,
+                         const struct sim_device_vmt *vmt,
+                         uint16_t address) {
+
+  devp->vmt       = vmt;
+  devp->next      = NULL;
+  devp->address   = address;
+  devp->pointer   = 0U;
+  devp->addressed = false;
+  devp->reading   = false;
+  devp->sample_cb = NULL;
+  memset(devp->regs, 0, sizeof (devp->regs));
+}
+
+/**
+ * @brief   Returns a channel value of a sample.
+ * @details Without a generator callback the sample value is a ramp,
+ *          channel @p c of sample @p k is <tt>(k * 4) + c</tt>. This makes
+ *          lost or duplicated samples easy to detect.
+ *
+ * @param[in] devp      pointer to the @p sim_device_t object
+ * @param[in] seq       sequence number of the sample
+ * @param[in] channel   channel within the sample
+ * @return              The channel value.
+ *
+ * @notapi
+ */
+int32_t simDeviceSample(sim_device_t *devp, uint32_t seq, unsigned channel) {
+
+  if (devp->sample_cb != NULL) {
+    return devp->sample_cb(devp, seq, channel);
+  }
+
+  return (int32_t)((seq << 2) + channel);
+}
+
+/**
+ * @brief   Starts a transaction.
+ *
+ * @param[in] devp      pointer to the @p sim_device_t object
+ *
+ * @notapi
+ */
+void simDeviceBegin(sim_device_t *devp) {
+
+  devp->addressed = false;
+  devp->reading   = false;
+  devp->vmt->update(devp);
+}
+
+/**
+ * @brief   Write phase of an I2C transaction.
+ * @details The first byte sets the register pointer, the following bytes
+ *          are written to the registers.
+ *
+ * @param[in] devp      pointer to the @p sim_device_t object
+ * @param[in] txbuf     transmitted bytes
+ * @param[in] n         number of bytes
+ *
+ * @notapi
+ */
+void simDeviceI2CWrite(sim_device_t *devp, const uint8_t *txbuf, size_t n) {
+
+  while (n > 0U) {
+    if (!devp->addressed) {
+      devp->pointer   = *txbuf & (uint8_t)(SIM_DEVICE_NUM_REGS - 1U);
+      devp->addressed = true;
+    }
+    else {
+      devp->vmt->write(devp, devp->pointer, *txbuf);
+      devp->pointer = devp->vmt->next(devp, devp->pointer);
+    }
+    txbuf++;
+    n--;
+  }
+}
+
+/**
+ * @brief   Read phase of an I2C transaction.
+ *
+ * @param[in] devp      pointer to the @p sim_device_t object
+ * @param[out] rxbuf    received bytes
+ * @param[in] n         number of bytes
+ *
+ * @notapi
+ */
+void simDeviceI2CRead(sim_device_t *devp, uint8_t *rxbuf, size_t n) {
+
+  while (n > 0U) {
+    *rxbuf++ = devp->vmt->read(devp, devp->pointer);
+    devp->pointer = devp->vmt->next(devp, devp->pointer);
+    n--;
+  }
+}
+
+/**
+ * @brief   Exchanges bytes within an SPI transaction.
+ * @details The first byte of the transaction is decoded by the model into
+ *          a direction and a register pointer, then each byte is either
+ *          written or read depending on the direction.
+ *
+ * @param[in] devp      pointer to the @p sim_device_t object
+ * @param[in] txbuf     transmitted bytes or @p NULL
+ * @param[out] rxbuf    received bytes or @p NULL
+ * @param[in] n         number of bytes
+ *
+ * @notapi
+ */
+void simDeviceSPIExchange(sim_device_t *devp, const uint8_t *txbuf,
+                          uint8_t *rxbuf, size_t n) {
+
+  while (n > 0U) {
+    uint8_t tx = txbuf != NULL ? *txbuf++ : 0xFFU;
+    uint8_t rx = 0xFFU;
+
+    if (!devp->addressed) {
+      devp->reading   = devp->vmt->command(devp, tx, &devp->pointer);
+      devp->addressed = true;
+    }
+    else if (devp->reading) {
+      rx = devp->vmt->read(devp, devp->pointer);
+      devp->pointer = devp->vmt->next(devp, devp->pointer);
+    }
+    else {
+      devp->vmt->write(devp, devp->pointer, tx);
+      devp->pointer = devp->vmt->next(devp, devp->pointer);
+    }
+    if (rxbuf != NULL) {
+      *rxbuf++ = rx;
+    }
+    n--;
+  }
+}
+
+/**
+ * @brief   Changes the output data rate of a sampling clock.
+ * @details The clock restarts if the rate changes.
+ *
+ * @param[in] clkp      pointer to the @p sim_clock_t object
+ * @param[in] odr       output data rate in mHz, zero stops the clock
+ *
+ * @notapi
+ */
+void simClockSet(sim_clock_t *clkp, uint32_t odr) {
+
+  if (clkp->odr != odr) {
+    clkp->odr   = odr;
+    clkp->start = osalOsGetSystemTimeX();
+    clkp->count = 0U;
+  }
+}
+
+/**
+ * @brief   Samples due since the previous call.
+ * @note    After long periods without bus activity the result can be
+ *          large, models are expected to bound their work to their FIFO
+ *          depth.
+ *
+ * @param[in] clkp      pointer to the @p sim_clock_t object
+ * @return              The number of new samples.
+ *
+ * @notapi
+ */
+uint32_t simClockElapsed(sim_clock_t *clkp) {
+  uint64_t due;
+  uint32_t n;
+
+  if (clkp->odr == 0U) {
+    return 0U;
+  }
+
+  due = ((uint64_t)osalTimeDiffX(clkp->start, osalOsGetSystemTimeX()) *
+         (uint64_t)clkp->odr) / ((uint64_t)OSAL_ST_FREQUENCY * 1000U);
+  n = (uint32_t)due - clkp->count;
+  clkp->count = (uint32_t)due;
+
+  return n;
+}
+
+#endif /* (HAL_USE_I2C == TRUE) || (HAL_USE_SPI == TRUE) */
+
+/** @} */
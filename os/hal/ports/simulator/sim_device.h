@@ -0,0 +1,211 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sim_device.h
+ * @brief   Simulated bus devices header.
+ * @details Register-map device models attached to the simulated I2C and
+ *          SPI drivers. A model exposes a register space accessed through
+ *          a register pointer, the bus drivers only frame transactions and
+ *          move bytes.
+ *
+ * @addtogroup SIM_DEVICE
+ * @{
+ */
+
+#ifndef SIM_DEVICE_H
+#define SIM_DEVICE_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the register space of a device model.
+ */
+#define SIM_DEVICE_NUM_REGS                 128U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a simulated device.
+ */
+typedef struct sim_device sim_device_t;
+
+/**
+ * @brief   Type of a sample generator callback.
+ *
+ * @param[in] devp      pointer to the @p sim_device_t object
+ * @param[in] seq       sequence number of the sample
+ * @param[in] channel   channel within the sample
+ * @return              The channel value, truncated to the device
+ *                      resolution.
+ */
+typedef int32_t (*sim_sample_cb_t)(sim_device_t *devp, uint32_t seq,
+                                   unsigned channel);
+
+/**
+ * @brief   Device model methods.
+ */
+struct sim_device_vmt {
+  /**
+   * @brief   Brings the model up to date at the start of a transaction.
+   */
+  void (*update)(sim_device_t *devp);
+  /**
+   * @brief   Decodes the first byte of an SPI transaction.
+   * @return  @p true for a register read.
+   */
+  bool (*command)(sim_device_t *devp, uint8_t cmd, uint8_t *regp);
+  /**
+   * @brief   Register read, including read side effects.
+   */
+  uint8_t (*read)(sim_device_t *devp, uint8_t reg);
+  /**
+   * @brief   Register write, including write side effects.
+   */
+  void (*write)(sim_device_t *devp, uint8_t reg, uint8_t value);
+  /**
+   * @brief   Register pointer after an access to @p reg.
+   */
+  uint8_t (*next)(sim_device_t *devp, uint8_t reg);
+};
+
+/**
+ * @brief   Structure representing a simulated device.
+ * @note    Models embed this structure as their first member.
+ */
+struct sim_device {
+  /**
+   * @brief   Model methods.
+   */
+  const struct sim_device_vmt *vmt;
+  /**
+   * @brief   Next device on the same I2C bus.
+   */
+  sim_device_t              *next;
+  /**
+   * @brief   I2C slave address.
+   */
+  uint16_t                  address;
+  /**
+   * @brief   Register pointer.
+   */
+  uint8_t                   pointer;
+  /**
+   * @brief   The register pointer has been set in this transaction.
+   */
+  bool                      addressed;
+  /**
+   * @brief   Current SPI transaction is a read.
+   */
+  bool                      reading;
+  /**
+   * @brief   Sample generator or @p NULL for the default ramp.
+   */
+  sim_sample_cb_t           sample_cb;
+  /**
+   * @brief   Register space.
+   */
+  uint8_t                   regs[SIM_DEVICE_NUM_REGS];
+};
+
+/**
+ * @brief   Sampling clock of a device model.
+ * @details Samples are produced at the output data rate against the
+ *          system time, whole samples only.
+ */
+typedef struct {
+  /**
+   * @brief   Output data rate in mHz, zero if stopped.
+   */
+  uint32_t                  odr;
+  /**
+   * @brief   System time of the clock start.
+   */
+  systime_t                 start;
+  /**
+   * @brief   Samples produced since the clock start.
+   */
+  uint32_t                  count;
+} sim_clock_t;
+
+/**
+ * @brief   Bus activity statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Completed transactions.
+   */
+  uint32_t                  transactions;
+  /**
+   * @brief   Bytes moved on the bus, addressing included.
+   */
+  uint32_t                  bytes;
+  /**
+   * @brief   Simulated bus time in nanoseconds.
+   */
+  uint64_t                  bustime;
+} sim_bus_stats_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Terminates a transaction.
+ *
+ * @param[in] devp      pointer to the @p sim_device_t object
+ *
+ * @notapi
+ */
+#define simDeviceEnd(devp) ((devp)->addressed = false)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simDeviceObjectInit(sim_device_t *devp,
+                           const struct sim_device_vmt *vmt,
+                           uint16_t address);
+  int32_t simDeviceSample(sim_device_t *devp, uint32_t seq, unsigned channel);
+  void simDeviceBegin(sim_device_t *devp);
+  void simDeviceI2CWrite(sim_device_t *devp, const uint8_t *txbuf, size_t n);
+  void simDeviceI2CRead(sim_device_t *devp, uint8_t *rxbuf, size_t n);
+  void simDeviceSPIExchange(sim_device_t *devp, const uint8_t *txbuf,
+                            uint8_t *rxbuf, size_t n);
+  void simClockSet(sim_clock_t *clkp, uint32_t odr);
+  uint32_t simClockElapsed(sim_clock_t *clkp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_DEVICE_H */
+
+/** @} */
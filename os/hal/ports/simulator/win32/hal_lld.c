@@ -78,6 +78,12 @@ void _sim_check_for_interrupts(void) {
   LARGE_INTEGER n;
   bool int_occurred = false;
 
+#if HAL_USE_PAL
+  while (pal_lld_interrupt_pending()) {
+    int_occurred = true;
+  }
+#endif
+
 #if HAL_USE_SERIAL
   while (sd_lld_interrupt_pending()) {
     int_occurred = true;
@@ -42,6 +42,187 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (CAN_USE_SW_QUEUES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Exact-match filters hash table index of an identifier.
+ *
+ * @param[in] id        normalized identifier
+ * @return              The initial probe index.
+ *
+ * @notapi
+ */
+static inline size_t can_sw_hash(uint32_t id) {
+
+  return (size_t)((id * 0x9E3779B1U) >> 16) &
+         ((size_t)CAN_SW_FILTERS_HASH_SIZE - 1U);
+}
+
+/**
+ * @brief   Evaluates the software filters against an identifier.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] id        normalized identifier
+ * @return              The filtering result.
+ * @retval false        frame rejected.
+ * @retval true         frame accepted.
+ *
+ * @notapi
+ */
+static bool can_sw_accept(CANDriver *canp, uint32_t id) {
+  const CANSwFilters *swfp = canp->swfilters;
+  size_t i;
+
+  if (swfp == NULL) {
+    return true;
+  }
+
+  /* Exact-match identifiers, linear probing until an empty slot.*/
+  if (swfp->nids > 0U) {
+    i = can_sw_hash(id);
+    while (canp->swhash[i] != CAN_SW_ID_NONE) {
+      if (canp->swhash[i] == id) {
+        return true;
+      }
+      i = (i + 1U) & ((size_t)CAN_SW_FILTERS_HASH_SIZE - 1U);
+    }
+  }
+
+  /* Mask filters.*/
+  for (i = 0U; i < swfp->nmasks; i++) {
+    if (((id ^ swfp->masks[i].id) & swfp->masks[i].mask) == 0U) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Arbitration key of a normalized identifier.
+ * @details Lower keys win the bus arbitration, a standard frame wins
+ *          against an extended frame with the same base identifier.
+ *
+ * @param[in] id        normalized identifier
+ * @return              The arbitration key.
+ *
+ * @notapi
+ */
+static inline uint32_t can_sw_arbitration_key(uint32_t id) {
+
+  if ((id & CAN_SW_IDE) != 0U) {
+    id &= ~CAN_SW_IDE;
+    return ((id >> 18) << 19) | (1U << 18) | (id & 0x3FFFFU);
+  }
+
+  return id << 19;
+}
+
+/**
+ * @brief   Moves frames from the hardware mailboxes into the RX FIFO.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[out] ovfp     set to @p true if frames have been lost
+ * @return              The number of frames added to the FIFO.
+ *
+ * @notapi
+ */
+static size_t can_sw_rx_fill(CANDriver *canp, bool *ovfp) {
+  systime_t now = osalOsGetSystemTimeX();
+  size_t n = 0U;
+
+  *ovfp = false;
+  while (can_lld_is_rx_nonempty(canp, CAN_ANY_MAILBOX)) {
+    CANRxFrame *crfp;
+    CANRxFrame discard;
+
+    /* The frame is fetched directly into the next FIFO slot, it is
+       committed only if it passes the filters. On overflow the hardware
+       mailbox is drained anyway.*/
+    if ((canp->rxwr - canp->rxrd) >= (size_t)CAN_RX_FIFO_SIZE) {
+      crfp = &discard;
+    }
+    else {
+      crfp = &canp->rxfifo[canp->rxwr & ((size_t)CAN_RX_FIFO_SIZE - 1U)];
+    }
+    can_lld_receive(canp, CAN_ANY_MAILBOX, crfp);
+
+    if (can_sw_accept(canp, CAN_LLD_RX_ID(crfp))) {
+      if (crfp == &discard) {
+        canp->rxlost++;
+        *ovfp = true;
+      }
+      else {
+        canp->rxtime[canp->rxwr & ((size_t)CAN_RX_FIFO_SIZE - 1U)] = now;
+        canp->rxwr++;
+        n++;
+      }
+    }
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Fetches the oldest frame from the RX FIFO.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[out] crfp     pointer to the buffer where the CAN frame is copied
+ * @param[out] tsp      pointer to the time stamp buffer or @p NULL
+ *
+ * @notapi
+ */
+static void can_sw_rx_get(CANDriver *canp, CANRxFrame *crfp, systime_t *tsp) {
+  size_t i = canp->rxrd & ((size_t)CAN_RX_FIFO_SIZE - 1U);
+
+  *crfp = canp->rxfifo[i];
+  if (tsp != NULL) {
+    *tsp = canp->rxtime[i];
+  }
+  canp->rxrd++;
+}
+
+/**
+ * @brief   Inserts a frame in the transmit queue.
+ * @details The queue is kept sorted by descending arbitration key so that
+ *          the next frame to be transmitted is the last one, frames with
+ *          the same identifier are transmitted in insertion order.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] ctfp      pointer to the CAN frame to be queued
+ *
+ * @notapi
+ */
+static void can_sw_tx_insert(CANDriver *canp, const CANTxFrame *ctfp) {
+  uint32_t key = can_sw_arbitration_key(CAN_LLD_TX_ID(ctfp));
+  size_t i = canp->txcnt;
+
+  while ((i > 0U) && (canp->txkey[i - 1U] <= key)) {
+    canp->txq[i]   = canp->txq[i - 1U];
+    canp->txkey[i] = canp->txkey[i - 1U];
+    i--;
+  }
+  canp->txq[i]   = *ctfp;
+  canp->txkey[i] = key;
+  canp->txcnt++;
+}
+
+/**
+ * @brief   Moves frames from the transmit queue into free mailboxes.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @notapi
+ */
+static void can_sw_tx_flush(CANDriver *canp) {
+
+  while ((canp->txcnt > 0U) &&
+         can_lld_is_tx_empty(canp, CAN_ANY_MAILBOX)) {
+    canp->txcnt--;
+    can_lld_transmit(canp, CAN_ANY_MAILBOX, &canp->txq[canp->txcnt]);
+  }
+}
+#endif /* CAN_USE_SW_QUEUES == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -71,6 +252,13 @@ void canObjectInit(CANDriver *canp) {
   canp->config      = NULL;
   osalThreadQueueObjectInit(&canp->txqueue);
   osalThreadQueueObjectInit(&canp->rxqueue);
+#if CAN_USE_SW_QUEUES == TRUE
+  canp->swfilters   = NULL;
+  canp->rxrd        = 0U;
+  canp->rxwr        = 0U;
+  canp->rxlost      = 0U;
+  canp->txcnt       = 0U;
+#endif
 #if CAN_ENFORCE_USE_CALLBACKS == FALSE
   osalEventObjectInit(&canp->rxfull_event);
   osalEventObjectInit(&canp->txempty_event);
@@ -113,6 +301,12 @@ msg_t canStart(CANDriver *canp, const CANConfig *config) {
   /* Entering initialization mode. */
   canp->state = CAN_STARTING;
   canp->config = config;
+#if CAN_USE_SW_QUEUES == TRUE
+  canp->rxrd   = 0U;
+  canp->rxwr   = 0U;
+  canp->rxlost = 0U;
+  canp->txcnt  = 0U;
+#endif
 
   /* Low level initialization, could be a slow process and sleeps could
      be performed inside.*/
@@ -155,6 +349,11 @@ void canStop(CANDriver *canp) {
   can_lld_stop(canp);
   canp->config = NULL;
   canp->state  = CAN_STOP;
+#if CAN_USE_SW_QUEUES == TRUE
+  /* Pending frames are discarded.*/
+  canp->rxrd   = canp->rxwr;
+  canp->txcnt  = 0U;
+#endif
 
   /* Threads waiting on CAN APIs are notified that the driver has been
      stopped in order to not have stuck threads.*/
@@ -222,6 +421,15 @@ bool canTryReceiveI(CANDriver *canp,
   osalDbgAssert((canp->state == CAN_READY) || (canp->state == CAN_SLEEP),
                 "invalid state");
 
+#if CAN_USE_SW_QUEUES == TRUE
+  /* If the RX FIFO is empty then the function fails.*/
+  if (canp->rxwr == canp->rxrd) {
+    return true;
+  }
+
+  /* Fetching the frame.*/
+  can_sw_rx_get(canp, crfp, NULL);
+#else
   /* If the RX mailbox is empty then the function fails.*/
   if (!can_lld_is_rx_nonempty(canp, mailbox)) {
     return true;
@@ -229,6 +437,7 @@ bool canTryReceiveI(CANDriver *canp,
 
   /* Fetching the frame.*/
   can_lld_receive(canp, mailbox, crfp);
+#endif
 
   return false;
 }
@@ -330,6 +539,16 @@ msg_t canReceiveTimeout(CANDriver *canp,
   osalDbgAssert((canp->state == CAN_READY) || (canp->state == CAN_SLEEP),
                 "invalid state");
 
+#if CAN_USE_SW_QUEUES == TRUE
+  while ((canp->state == CAN_SLEEP) || (canp->rxwr == canp->rxrd)) {
+    msg_t msg = osalThreadEnqueueTimeoutS(&canp->rxqueue, timeout);
+    if (msg != MSG_OK) {
+      osalSysUnlock();
+      return msg;
+    }
+  }
+  can_sw_rx_get(canp, crfp, NULL);
+#else
   /*lint -save -e9007 [13.5] Right side is supposed to be pure.*/
   while ((canp->state == CAN_SLEEP) || !can_lld_is_rx_nonempty(canp, mailbox)) {
   /*lint -restore*/
@@ -340,6 +559,7 @@ msg_t canReceiveTimeout(CANDriver *canp,
     }
   }
   can_lld_receive(canp, mailbox, crfp);
+#endif
   osalSysUnlock();
   return MSG_OK;
 }
@@ -392,6 +612,15 @@ void canWakeup(CANDriver *canp) {
   if (canp->state == CAN_SLEEP) {
     can_lld_wakeup(canp);
     canp->state = CAN_READY;
+#if CAN_USE_SW_QUEUES == TRUE
+    /* Frames queued during the sleep state.*/
+    can_sw_tx_flush(canp);
+
+    /* Readers waited for the wakeup, frames could be already buffered.*/
+    if (canp->rxwr != canp->rxrd) {
+      osalThreadDequeueAllI(&canp->rxqueue, MSG_OK);
+    }
+#endif
 #if CAN_ENFORCE_USE_CALLBACKS == FALSE
     osalEventBroadcastFlagsI(&canp->wakeup_event, (eventflags_t)0);
     osalOsRescheduleS();
@@ -401,6 +630,275 @@ void canWakeup(CANDriver *canp) {
 }
 #endif /* CAN_USE_SLEEP_MODE == TRUE */
 
+#if (CAN_USE_SW_QUEUES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Installs a set of software filters.
+ * @details The filters are evaluated in the receive interrupt handler,
+ *          frames not accepted are discarded before reaching the RX FIFO.
+ *          Exact-match identifiers are looked up in a hash table, mask
+ *          filters are scanned linearly so they should be kept few.
+ * @note    The filters set is referenced, not copied, it must remain
+ *          valid while installed.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] swfp      pointer to the filters set or @p NULL for accepting
+ *                      all frames
+ * @return              The operation status.
+ * @retval HAL_RET_SUCCESS      if the filters have been installed.
+ * @retval HAL_RET_CONFIG_ERROR if there are too many exact-match
+ *                              identifiers for the hash table.
+ *
+ * @api
+ */
+msg_t canSetSoftwareFilters(CANDriver *canp, const CANSwFilters *swfp) {
+  size_t i;
+
+  osalDbgCheck(canp != NULL);
+  osalDbgCheck((swfp == NULL) ||
+               (((swfp->ids != NULL) || (swfp->nids == 0U)) &&
+                ((swfp->masks != NULL) || (swfp->nmasks == 0U))));
+
+  /* One slot must be left empty in order to terminate the probing.*/
+  if ((swfp != NULL) && (swfp->nids >= (size_t)CAN_SW_FILTERS_HASH_SIZE)) {
+    return HAL_RET_CONFIG_ERROR;
+  }
+
+  osalSysLock();
+  for (i = 0U; i < (size_t)CAN_SW_FILTERS_HASH_SIZE; i++) {
+    canp->swhash[i] = CAN_SW_ID_NONE;
+  }
+  if (swfp != NULL) {
+    for (i = 0U; i < swfp->nids; i++) {
+      size_t j = can_sw_hash(swfp->ids[i]);
+
+      while ((canp->swhash[j] != CAN_SW_ID_NONE) &&
+             (canp->swhash[j] != swfp->ids[i])) {
+        j = (j + 1U) & ((size_t)CAN_SW_FILTERS_HASH_SIZE - 1U);
+      }
+      canp->swhash[j] = swfp->ids[i];
+    }
+  }
+  canp->swfilters = swfp;
+  osalSysUnlock();
+
+  return HAL_RET_SUCCESS;
+}
+
+/**
+ * @brief   Multiple frames receive.
+ * @details The function waits until at least one frame is available in
+ *          the RX FIFO then fetches up to @p n frames without waiting
+ *          further.
+ * @note    Like @p canReceiveTimeout(), the function waits while the
+ *          driver is in sleep mode.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[out] crfp     pointer to an array of @p n frame buffers
+ * @param[out] tsp      pointer to an array of @p n time stamp buffers,
+ *                      can be @p NULL if time stamps are not required
+ * @param[in] n         maximum number of frames to be fetched
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ * @return              The number of frames fetched, zero if the
+ *                      operation timed out or the driver has been
+ *                      stopped while waiting.
+ *
+ * @api
+ */
+size_t canReceiveManyTimeout(CANDriver *canp,
+                             CANRxFrame *crfp,
+                             systime_t *tsp,
+                             size_t n,
+                             sysinterval_t timeout) {
+  size_t i;
+
+  osalDbgCheck((canp != NULL) && (crfp != NULL) && (n > 0U));
+
+  osalSysLock();
+  osalDbgAssert((canp->state == CAN_READY) || (canp->state == CAN_SLEEP),
+                "invalid state");
+
+  while ((canp->state == CAN_SLEEP) || (canp->rxwr == canp->rxrd)) {
+    msg_t msg = osalThreadEnqueueTimeoutS(&canp->rxqueue, timeout);
+    if (msg != MSG_OK) {
+      osalSysUnlock();
+      return 0U;
+    }
+  }
+
+  /* Frames are copied one at time in order to keep the critical zones
+     short.*/
+  i = 0U;
+  while ((i < n) && (canp->rxwr != canp->rxrd)) {
+    can_sw_rx_get(canp, &crfp[i], tsp != NULL ? &tsp[i] : NULL);
+    i++;
+    osalSysUnlock();
+    osalSysLock();
+  }
+  osalSysUnlock();
+
+  return i;
+}
+
+/**
+ * @brief   Can frame queuing attempt.
+ * @details The frame is inserted in the software transmit queue in
+ *          priority order, queued frames are moved into the hardware
+ *          mailboxes as they become free.
+ * @note    Frames can be queued while in sleep mode, they are transmitted
+ *          after wakeup.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] ctfp      pointer to the CAN frame to be transmitted
+ * @return              The operation result.
+ * @retval false        Frame queued.
+ * @retval true         Queue full.
+ *
+ * @iclass
+ */
+bool canTryQueueTransmitI(CANDriver *canp, const CANTxFrame *ctfp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((canp != NULL) && (ctfp != NULL));
+  osalDbgAssert((canp->state == CAN_READY) || (canp->state == CAN_SLEEP),
+                "invalid state");
+
+  if (canp->txcnt >= (size_t)CAN_TX_QUEUE_SIZE) {
+    return true;
+  }
+
+  can_sw_tx_insert(canp, ctfp);
+  if (canp->state == CAN_READY) {
+    can_sw_tx_flush(canp);
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Can frame queuing.
+ * @details The frame is inserted in the software transmit queue in
+ *          priority order, if the queue is full then the invoking thread
+ *          is queued.
+ * @note    Frames with the same identifier leave the queue in insertion
+ *          order, controllers with multiple mailboxes not arbitrating
+ *          chronologically could still reorder them.
+ * @note    Frames can be queued while in sleep mode, they are transmitted
+ *          after wakeup.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] ctfp      pointer to the CAN frame to be transmitted
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ * @return              The operation result.
+ * @retval MSG_OK       the frame has been queued for transmission.
+ * @retval MSG_TIMEOUT  The operation has timed out.
+ * @retval MSG_RESET    The driver has been stopped while waiting.
+ *
+ * @api
+ */
+msg_t canQueueTransmitTimeout(CANDriver *canp,
+                              const CANTxFrame *ctfp,
+                              sysinterval_t timeout) {
+
+  osalDbgCheck((canp != NULL) && (ctfp != NULL));
+
+  osalSysLock();
+  osalDbgAssert((canp->state == CAN_READY) || (canp->state == CAN_SLEEP),
+                "invalid state");
+
+  while (canTryQueueTransmitI(canp, ctfp)) {
+    msg_t msg = osalThreadEnqueueTimeoutS(&canp->txqueue, timeout);
+    if (msg != MSG_OK) {
+      osalSysUnlock();
+      return msg;
+    }
+  }
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   TX mailbox empty event handler.
+ * @details Queued frames are moved into the free mailboxes then waiting
+ *          threads and listeners are notified.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] flags     flags associated to the emptied mailboxes
+ *
+ * @notapi
+ */
+void _can_sw_tx_empty_isr(CANDriver *canp, uint32_t flags) {
+
+  osalSysLockFromISR();
+  if (canp->state == CAN_READY) {
+    can_sw_tx_flush(canp);
+  }
+#if CAN_ENFORCE_USE_CALLBACKS == FALSE
+  osalThreadDequeueAllI(&canp->txqueue, MSG_OK);
+  osalEventBroadcastFlagsI(&canp->txempty_event, flags);
+  osalSysUnlockFromISR();
+#else
+  osalSysUnlockFromISR();
+  if (canp->txempty_cb != NULL) {
+    canp->txempty_cb(canp, flags);
+  }
+  osalSysLockFromISR();
+  osalThreadDequeueAllI(&canp->txqueue, MSG_OK);
+  osalSysUnlockFromISR();
+#endif
+}
+
+/**
+ * @brief   RX mailbox full event handler.
+ * @details The hardware mailboxes are drained into the RX FIFO through
+ *          the software filters, waiting threads and listeners are
+ *          notified only if frames have been accepted.
+ * @note    Frames lost because a FIFO overflow are reported as a
+ *          @p CAN_OVERFLOW_ERROR error.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] flags     flags associated to the filled mailboxes
+ *
+ * @notapi
+ */
+void _can_sw_rx_full_isr(CANDriver *canp, uint32_t flags) {
+  size_t n;
+  bool ovf;
+
+  osalSysLockFromISR();
+  n = can_sw_rx_fill(canp, &ovf);
+#if CAN_ENFORCE_USE_CALLBACKS == FALSE
+  if (ovf) {
+    osalEventBroadcastFlagsI(&canp->error_event, CAN_OVERFLOW_ERROR);
+  }
+  if (n > 0U) {
+    osalThreadDequeueAllI(&canp->rxqueue, MSG_OK);
+    osalEventBroadcastFlagsI(&canp->rxfull_event, flags);
+  }
+  osalSysUnlockFromISR();
+#else
+  osalSysUnlockFromISR();
+  if (ovf && (canp->error_cb != NULL)) {
+    canp->error_cb(canp, CAN_OVERFLOW_ERROR);
+  }
+  if (n > 0U) {
+    if (canp->rxfull_cb != NULL) {
+      canp->rxfull_cb(canp, flags);
+    }
+    osalSysLockFromISR();
+    osalThreadDequeueAllI(&canp->rxqueue, MSG_OK);
+    osalSysUnlockFromISR();
+  }
+#endif
+}
+#endif /* CAN_USE_SW_QUEUES == TRUE */
+
 #endif /* HAL_USE_CAN == TRUE */
 
 /** @} */
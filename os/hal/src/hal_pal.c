@@ -42,6 +42,51 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (PAL_USE_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Line event callback recording the edges.
+ *
+ * @param[in] arg       pointer to the @p palcapture_t object
+ */
+static void pal_capture_cb(void *arg) {
+  palcapture_t *cp = (palcapture_t *)arg;
+  rtcnt_t now = PAL_CAPTURE_GET_TIMESTAMP();
+  uint32_t edge = cp->mode & PAL_EVENT_MODE_EDGES_MASK;
+
+  /* If both edges are enabled then the edge type is deduced from the line
+     state, a pulse shorter than the ISR latency is seen as two edges of
+     the same type.*/
+  if (edge == PAL_EVENT_MODE_BOTH_EDGES) {
+    edge = palReadLine(cp->line) == PAL_HIGH ? PAL_EVENT_MODE_RISING_EDGE :
+                                               PAL_EVENT_MODE_FALLING_EDGE;
+  }
+
+  osalSysLockFromISR();
+
+  if (cp->counter < cp->size) {
+    palcaprecord_t *rp = &cp->buffer[cp->wridx];
+
+    rp->time = now;
+    rp->line = cp->line;
+    rp->edge = edge;
+    if (++cp->wridx >= cp->size) {
+      cp->wridx = (size_t)0;
+    }
+    cp->counter++;
+
+    /* The consumer is only woken when the watermark is reached.*/
+    if (cp->counter >= cp->watermark) {
+      osalThreadResumeI(&cp->thread, MSG_OK);
+    }
+  }
+  else {
+    cp->overflows++;
+  }
+
+  osalSysUnlockFromISR();
+}
+#endif /* PAL_USE_CAPTURE == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -250,6 +295,194 @@ msg_t palWaitLineTimeout(ioline_t line, sysinterval_t timeout) {
 }
 #endif /* PAL_USE_WAIT == TRUE */
 
+#if (PAL_USE_CAPTURE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a line edges capture object.
+ *
+ * @param[out] cp       pointer to a @p palcapture_t object
+ * @param[in] buffer    pointer to the records buffer
+ * @param[in] size      number of records in the buffer
+ * @param[in] watermark number of records triggering the consumer wakeup,
+ *                      it must be between 1 and @p size
+ *
+ * @init
+ */
+void palCaptureObjectInit(palcapture_t *cp, palcaprecord_t *buffer,
+                          size_t size, size_t watermark) {
+
+  osalDbgCheck((cp != NULL) && (buffer != NULL) &&
+               (watermark > 0U) && (watermark <= size));
+
+  cp->line      = PAL_NOLINE;
+  cp->mode      = PAL_EVENT_MODE_DISABLED;
+  cp->buffer    = buffer;
+  cp->size      = size;
+  cp->watermark = watermark;
+  cp->counter   = (size_t)0;
+  cp->wridx     = (size_t)0;
+  cp->rdidx     = (size_t)0;
+  cp->overflows = 0U;
+  cp->thread    = NULL;
+}
+
+/**
+ * @brief   Starts capturing the edges of a line.
+ * @details The line event is enabled and its callback is taken over by
+ *          the capture object, previously captured records are discarded.
+ *
+ * @param[in] cp        pointer to a @p palcapture_t object
+ * @param[in] line      line identifier
+ * @param[in] mode      line event mode
+ *
+ * @iclass
+ */
+void palCaptureStartI(palcapture_t *cp, ioline_t line, uint32_t mode) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((cp != NULL) &&
+               ((mode & PAL_EVENT_MODE_EDGES_MASK) != PAL_EVENT_MODE_DISABLED));
+
+  cp->line      = line;
+  cp->mode      = mode;
+  cp->counter   = (size_t)0;
+  cp->wridx     = (size_t)0;
+  cp->rdidx     = (size_t)0;
+  cp->overflows = 0U;
+
+  palEnableLineEventI(line, mode);
+  palSetLineCallbackI(line, pal_capture_cb, (void *)cp);
+}
+
+/**
+ * @brief   Starts capturing the edges of a line.
+ * @details The line event is enabled and its callback is taken over by
+ *          the capture object, previously captured records are discarded.
+ *
+ * @param[in] cp        pointer to a @p palcapture_t object
+ * @param[in] line      line identifier
+ * @param[in] mode      line event mode
+ *
+ * @api
+ */
+void palCaptureStart(palcapture_t *cp, ioline_t line, uint32_t mode) {
+
+  osalSysLock();
+  palCaptureStartI(cp, line, mode);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops capturing the edges of a line.
+ * @details The line event is disabled, the records already captured can
+ *          still be read, a waiting consumer is resumed with
+ *          @p MSG_RESET.
+ *
+ * @param[in] cp        pointer to a @p palcapture_t object
+ *
+ * @iclass
+ */
+void palCaptureStopI(palcapture_t *cp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(cp != NULL);
+
+  palDisableLineEventI(cp->line);
+  osalThreadResumeI(&cp->thread, MSG_RESET);
+}
+
+/**
+ * @brief   Stops capturing the edges of a line.
+ * @details The line event is disabled, the records already captured can
+ *          still be read, a waiting consumer is resumed with
+ *          @p MSG_RESET.
+ *
+ * @param[in] cp        pointer to a @p palcapture_t object
+ *
+ * @api
+ */
+void palCaptureStop(palcapture_t *cp) {
+
+  osalSysLock();
+  palCaptureStopI(cp);
+  osalOsRescheduleS();
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Captured records non-blocking read.
+ * @details The function moves records from the capture buffer into a
+ *          records array. The operation completes immediately.
+ *
+ * @param[in] cp        pointer to a @p palcapture_t object
+ * @param[out] rp       pointer to the records array
+ * @param[in] n         maximum number of records to be read
+ * @return              The number of records effectively read.
+ *
+ * @iclass
+ */
+size_t palCaptureReadI(palcapture_t *cp, palcaprecord_t *rp, size_t n) {
+  size_t i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((cp != NULL) && (rp != NULL));
+
+  if (n > cp->counter) {
+    n = cp->counter;
+  }
+
+  for (i = (size_t)0; i < n; i++) {
+    *rp++ = cp->buffer[cp->rdidx];
+    if (++cp->rdidx >= cp->size) {
+      cp->rdidx = (size_t)0;
+    }
+  }
+  cp->counter -= n;
+
+  return n;
+}
+
+/**
+ * @brief   Captured records read with timeout.
+ * @details If the capture buffer contains less records than the watermark
+ *          then the calling thread is suspended until the watermark is
+ *          reached, the timeout expires or the capture is stopped, then
+ *          the available records are moved into the records array.
+ * @note    Only one thread at time can read from a capture object.
+ * @note    A stop resumes the waiting thread, the records captured
+ *          before the stop are returned. Later calls still wait for the
+ *          watermark, use @p palCaptureReadI() in order to drain the
+ *          buffer after a stop.
+ *
+ * @param[in] cp        pointer to a @p palcapture_t object
+ * @param[out] rp       pointer to the records array
+ * @param[in] n         maximum number of records to be read
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ * @return              The number of records effectively read.
+ * @retval 0            if no edges have been captured within the timeout
+ *                      or the capture has been stopped and no records
+ *                      are left in the buffer.
+ *
+ * @api
+ */
+size_t palCaptureReadTimeout(palcapture_t *cp, palcaprecord_t *rp,
+                             size_t n, sysinterval_t timeout) {
+
+  osalSysLock();
+
+  if (cp->counter < cp->watermark) {
+    (void) osalThreadSuspendTimeoutS(&cp->thread, timeout);
+  }
+  n = palCaptureReadI(cp, rp, n);
+
+  osalSysUnlock();
+
+  return n;
+}
+#endif /* PAL_USE_CAPTURE == TRUE */
+
 #endif /* HAL_USE_PAL == TRUE */
 
 /** @} */
@@ -78,6 +78,47 @@ static bool sdu_start_receive(SerialUSBDriver *sdup) {
   return false;
 }
 
+#if (SERIAL_USB_USE_SUBMIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the next transfer of the head submitted buffer.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ */
+static void sdu_start_submitted(SerialUSBDriver *sdup) {
+  sdu_txbuffer_t *txbp = sdup->txhead;
+  size_t n = txbp->size - sdup->txoffset;
+
+  if (n > (size_t)SERIAL_USB_MAX_TRANSFER) {
+    n = (size_t)SERIAL_USB_MAX_TRANSFER;
+  }
+  sdup->txsubmitted = true;
+  usbStartTransmitI(sdup->config->usbp, sdup->config->bulk_in,
+                    txbp->buf + sdup->txoffset, n);
+}
+
+/**
+ * @brief   Releases all the submitted buffers.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[in] msg       completion status to be reported
+ */
+static void sdu_release_submitted(SerialUSBDriver *sdup, msg_t msg) {
+
+  while (sdup->txhead != NULL) {
+    sdu_txbuffer_t *txbp = sdup->txhead;
+
+    sdup->txhead = txbp->next;
+    txbp->status = msg;
+    if (txbp->cb != NULL) {
+      txbp->cb(sdup, txbp);
+    }
+  }
+  sdup->txtail      = NULL;
+  sdup->txoffset    = 0U;
+  sdup->txsubmitted = false;
+}
+#endif /* SERIAL_USB_USE_SUBMIT == TRUE */
+
 /*
  * Interface implementation.
  */
@@ -186,7 +227,9 @@ static void obnotify(io_buffers_queue_t *bqp) {
     return;
   }
 
-  /* Checking if there is already a transaction ongoing on the endpoint.*/
+  /* Checking if there is already a transaction ongoing on the endpoint,
+     submitted buffers are always transmitted back-to-back so an idle
+     endpoint means that none is partially transmitted.*/
   if (!usbGetTransmitStatusI(sdup->config->usbp, sdup->config->bulk_in)) {
     /* Getting a full buffer, a buffer is available for sure because this
        callback is invoked when one has been inserted.*/
@@ -230,6 +273,12 @@ void sduObjectInit(SerialUSBDriver *sdup) {
   obqObjectInit(&sdup->obqueue, true, sdup->ob,
                 SERIAL_USB_BUFFERS_SIZE, SERIAL_USB_BUFFERS_NUMBER,
                 obnotify, sdup);
+#if SERIAL_USB_USE_SUBMIT == TRUE
+  sdup->txhead      = NULL;
+  sdup->txtail      = NULL;
+  sdup->txoffset    = 0U;
+  sdup->txsubmitted = false;
+#endif
 }
 
 /**
@@ -295,6 +344,9 @@ void sduStop(SerialUSBDriver *sdup) {
   chnAddFlagsI(sdup, CHN_DISCONNECTED);
   ibqResetI(&sdup->ibqueue);
   obqResetI(&sdup->obqueue);
+#if SERIAL_USB_USE_SUBMIT == TRUE
+  sdu_release_submitted(sdup, MSG_RESET);
+#endif
   osalOsRescheduleS();
 
   osalSysUnlock();
@@ -355,6 +407,10 @@ void sduConfigureHookI(SerialUSBDriver *sdup) {
   bqResumeX(&sdup->ibqueue);
   obqResetI(&sdup->obqueue);
   bqResumeX(&sdup->obqueue);
+#if SERIAL_USB_USE_SUBMIT == TRUE
+  /* Transfers do not survive a bus reset.*/
+  sdu_release_submitted(sdup, MSG_RESET);
+#endif
   chnAddFlagsI(sdup, CHN_CONNECTED);
   (void) sdu_start_receive(sdup);
 }
@@ -443,6 +499,9 @@ void sduDataTransmitted(USBDriver *usbp, usbep_t ep) {
   uint8_t *buf;
   size_t n;
   SerialUSBDriver *sdup = usbp->in_params[ep - 1U];
+#if SERIAL_USB_USE_SUBMIT == TRUE
+  sdu_txbuffer_t *donep = NULL;
+#endif
 
   if (sdup == NULL) {
     return;
@@ -450,6 +509,26 @@ void sduDataTransmitted(USBDriver *usbp, usbep_t ep) {
 
   osalSysLockFromISR();
 
+#if SERIAL_USB_USE_SUBMIT == TRUE
+  if (sdup->txsubmitted) {
+    sdu_txbuffer_t *txbp = sdup->txhead;
+
+    /* A transfer of the head submitted buffer completed, the buffer is
+       released after its last transfer.*/
+    sdup->txsubmitted = false;
+    sdup->txoffset += usbp->epc[ep]->in_state->txsize;
+    if (sdup->txoffset >= txbp->size) {
+      sdup->txhead   = txbp->next;
+      sdup->txoffset = 0U;
+      if (sdup->txhead == NULL) {
+        sdup->txtail = NULL;
+      }
+      txbp->status = MSG_OK;
+      donep = txbp;
+    }
+  }
+  else
+#endif
   /* Freeing the buffer just transmitted, if it was not a zero size packet.*/
   if (usbp->epc[ep]->in_state->txsize > 0U) {
     obqReleaseEmptyBufferI(&sdup->obqueue);
@@ -458,28 +537,53 @@ void sduDataTransmitted(USBDriver *usbp, usbep_t ep) {
     chnAddFlagsI(sdup, CHN_OUTPUT_EMPTY);
   }
 
-  /* Checking if there is a buffer ready for transmission.*/
-  buf = obqGetFullBufferI(&sdup->obqueue, &n);
-
-  if (buf != NULL) {
-    /* The endpoint cannot be busy, we are in the context of the callback,
-       so it is safe to transmit without a check.*/
-    usbStartTransmitI(usbp, ep, buf, n);
+#if SERIAL_USB_USE_SUBMIT == TRUE
+  /* A partially transmitted submitted buffer is continued before anything
+     else.*/
+  if (sdup->txoffset > 0U) {
+    sdu_start_submitted(sdup);
   }
-  else if ((usbp->epc[ep]->in_state->txsize > 0U) &&
-           ((usbp->epc[ep]->in_state->txsize &
-            ((size_t)usbp->epc[ep]->in_maxsize - 1U)) == 0U)) {
-    /* Transmit zero sized packet in case the last one has maximum allowed
-       size. Otherwise the recipient may expect more data coming soon and
-       not return buffered data to app. See section 5.8.3 Bulk Transfer
-       Packet Size Constraints of the USB Specification document.*/
-    usbStartTransmitI(usbp, ep, usbp->setup, 0);
+  else
+#endif
+  {
+    /* Checking if there is a buffer ready for transmission.*/
+    buf = obqGetFullBufferI(&sdup->obqueue, &n);
+
+    if (buf != NULL) {
+      /* The endpoint cannot be busy, we are in the context of the callback,
+         so it is safe to transmit without a check.*/
+      usbStartTransmitI(usbp, ep, buf, n);
+    }
+#if SERIAL_USB_USE_SUBMIT == TRUE
+    else if (sdup->txhead != NULL) {
+      /* Next submitted buffer.*/
+      sdu_start_submitted(sdup);
+    }
+#endif
+    else if ((usbp->epc[ep]->in_state->txsize > 0U) &&
+             ((usbp->epc[ep]->in_state->txsize &
+              ((size_t)usbp->epc[ep]->in_maxsize - 1U)) == 0U)) {
+      /* Transmit zero sized packet in case the last one has maximum allowed
+         size. Otherwise the recipient may expect more data coming soon and
+         not return buffered data to app. See section 5.8.3 Bulk Transfer
+         Packet Size Constraints of the USB Specification document.*/
+      usbStartTransmitI(usbp, ep, usbp->setup, 0);
 
+    }
+    else {
+      /* Nothing further to transmit.*/
+      chnAddFlagsI(sdup, CHN_TRANSMISSION_END);
+    }
   }
-  else {
-    /* Nothing further to transmit.*/
-    chnAddFlagsI(sdup, CHN_TRANSMISSION_END);
+
+#if SERIAL_USB_USE_SUBMIT == TRUE
+  /* The completion callback is invoked after the next transfer has been
+     started, a buffer submitted from the callback is just queued if the
+     endpoint is busy again.*/
+  if ((donep != NULL) && (donep->cb != NULL)) {
+    donep->cb(sdup, donep);
   }
+#endif
 
   osalSysUnlockFromISR();
 }
@@ -554,6 +658,93 @@ msg_t sduControl(USBDriver *usbp, unsigned int operation, void *arg) {
   return _ctl((void *)usbp, operation, arg);
 }
 
+#if (SERIAL_USB_USE_SUBMIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Submits an application buffer for transmission.
+ * @details The buffer is transmitted directly from its memory on the bulk
+ *          IN endpoint, without copies, after the buffers already submitted.
+ *          Full buffers in the output queue are transmitted before the
+ *          next submitted buffer is started, a partially filled output
+ *          buffer is not flushed by this function.
+ * @note    The descriptor and the data must not be modified until the
+ *          completion callback is invoked.
+ * @note    A zero length packet is sent after the last transfer if it is
+ *          a multiple of the endpoint packet size and nothing else is
+ *          pending.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[in] txbp      pointer to the buffer descriptor, the fields
+ *                      @p buf, @p size and @p cb must be initialized
+ * @return              The operation status.
+ * @retval MSG_OK       if the buffer has been submitted.
+ * @retval MSG_RESET    if the driver is not ready or the output is
+ *                      suspended, the callback is not invoked.
+ *
+ * @iclass
+ */
+msg_t sduSubmitTransmitI(SerialUSBDriver *sdup, sdu_txbuffer_t *txbp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((sdup != NULL) && (txbp != NULL) &&
+               (txbp->buf != NULL) && (txbp->size > 0U));
+
+  if ((sdup->state != SDU_READY) || bqIsSuspendedX(&sdup->obqueue)) {
+    return MSG_RESET;
+  }
+
+  /* Appending to the submitted buffers list.*/
+  txbp->next = NULL;
+  if (sdup->txtail == NULL) {
+    sdup->txhead = txbp;
+  }
+  else {
+    sdup->txtail->next = txbp;
+  }
+  sdup->txtail = txbp;
+
+  /* Starting the transfer if the endpoint is idle, if it is busy then
+     the buffer is picked up by the transmit callback.*/
+  if ((usbGetDriverStateI(sdup->config->usbp) == USB_ACTIVE) &&
+      !usbGetTransmitStatusI(sdup->config->usbp, sdup->config->bulk_in)) {
+    size_t n;
+    uint8_t *buf = obqGetFullBufferI(&sdup->obqueue, &n);
+
+    if (buf != NULL) {
+      usbStartTransmitI(sdup->config->usbp, sdup->config->bulk_in, buf, n);
+    }
+    else {
+      sdu_start_submitted(sdup);
+    }
+  }
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Submits an application buffer for transmission.
+ * @details See @p sduSubmitTransmitI().
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[in] txbp      pointer to the buffer descriptor, the fields
+ *                      @p buf, @p size and @p cb must be initialized
+ * @return              The operation status.
+ * @retval MSG_OK       if the buffer has been submitted.
+ * @retval MSG_RESET    if the driver is not ready or the output is
+ *                      suspended, the callback is not invoked.
+ *
+ * @api
+ */
+msg_t sduSubmitTransmit(SerialUSBDriver *sdup, sdu_txbuffer_t *txbp) {
+  msg_t msg;
+
+  osalSysLock();
+  msg = sduSubmitTransmitI(sdup, txbp);
+  osalSysUnlock();
+
+  return msg;
+}
+#endif /* SERIAL_USB_USE_SUBMIT == TRUE */
+
 #endif /* HAL_USE_SERIAL_USB == TRUE */
 
 /** @} */
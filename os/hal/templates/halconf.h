@@ -228,6 +228,15 @@
 #define PAL_USE_WAIT                        FALSE
 #endif
 
+/**
+ * @brief   Enables the edges capture APIs.
+ * @note    Requires @p PAL_USE_CALLBACKS.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(PAL_USE_CAPTURE) || defined(__DOXYGEN__)
+#define PAL_USE_CAPTURE                     FALSE
+#endif
+
 /*===========================================================================*/
 /* ADC driver related settings.                                              */
 /*===========================================================================*/
@@ -266,6 +275,34 @@
 #define CAN_ENFORCE_USE_CALLBACKS           FALSE
 #endif
 
+/**
+ * @brief   Software RX FIFO, software filters and TX queue inclusion switch.
+ */
+#if !defined(CAN_USE_SW_QUEUES) || defined(__DOXYGEN__)
+#define CAN_USE_SW_QUEUES                   FALSE
+#endif
+
+/**
+ * @brief   Size of the software RX FIFO in frames, must be a power of two.
+ */
+#if !defined(CAN_RX_FIFO_SIZE) || defined(__DOXYGEN__)
+#define CAN_RX_FIFO_SIZE                    16
+#endif
+
+/**
+ * @brief   Size of the software TX queue in frames.
+ */
+#if !defined(CAN_TX_QUEUE_SIZE) || defined(__DOXYGEN__)
+#define CAN_TX_QUEUE_SIZE                   8
+#endif
+
+/**
+ * @brief   Size of the exact-match filters hash, must be a power of two.
+ */
+#if !defined(CAN_SW_FILTERS_HASH_SIZE) || defined(__DOXYGEN__)
+#define CAN_SW_FILTERS_HASH_SIZE            16
+#endif
+
 /*===========================================================================*/
 /* CRY driver related settings.                                              */
 /*===========================================================================*/
@@ -476,6 +513,14 @@
 #define SERIAL_USB_BUFFERS_NUMBER           2
 #endif
 
+/**
+ * @brief   Serial over USB zero-copy transmit API.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(SERIAL_USB_USE_SUBMIT) || defined(__DOXYGEN__)
+#define SERIAL_USB_USE_SUBMIT               FALSE
+#endif
+
 /*===========================================================================*/
 /* SPI driver related settings.                                              */
 /*===========================================================================*/
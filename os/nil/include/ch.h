@@ -185,6 +185,14 @@
 #include "chconf.h"
 #include "chlicense.h"
 
+/**
+ * @brief   Threads bitmaps.
+ * @note    Disabled if not specified in the configuration file.
+ */
+#if !defined(CH_CFG_USE_THREADS_BITMAPS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_THREADS_BITMAPS          FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -331,9 +339,15 @@
 #error "at least one thread must be defined"
 #endif
 
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+#if CH_CFG_MAX_THREADS > 32
+#error "CH_CFG_MAX_THREADS exceeds the threads bitmaps width"
+#endif
+#else
 #if CH_CFG_MAX_THREADS > 16
 #error "ChibiOS/NIL is not recommended for thread-intensive applications,"  \
-       "consider ChibiOS/RT instead"
+       "consider ChibiOS/RT instead or enable CH_CFG_USE_THREADS_BITMAPS"
+#endif
 #endif
 
 #if (CH_CFG_ST_RESOLUTION != 16) && (CH_CFG_ST_RESOLUTION != 32)
@@ -461,6 +475,15 @@ typedef uint16_t sysinterval_t;
 typedef uint32_t time_conv_t;
 #endif
 
+#if (CH_CFG_USE_THREADS_BITMAPS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a threads bitmap.
+ * @note    Bit N represents the thread at priority N, the idle thread is
+ *          not represented.
+ */
+typedef uint32_t thdmask_t;
+#endif
+
 /**
  * @brief   Type of a structure representing the system.
  */
@@ -592,6 +615,16 @@ struct nil_os_instance {
    */
   systime_t             nexttime;
 #endif
+#if (CH_CFG_USE_THREADS_BITMAPS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Bitmap of the threads in ready state.
+   */
+  thdmask_t             rdmask;
+  /**
+   * @brief   Bitmap of the threads waiting with a timeout.
+   */
+  thdmask_t             tmmask;
+#endif
 #if (CH_DBG_SYSTEM_STATE_CHECK == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   ISR nesting level.
@@ -31,6 +31,20 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREADS_BITMAPS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Bitmap mask of a thread.
+ */
+#define NIL_THD_MASK(tp)                                                    \
+  ((thdmask_t)1 << (unsigned)((tp) - &nil.threads[0]))
+
+/**
+ * @brief   Bitmap of all the user threads.
+ */
+#define NIL_ALL_THREADS_MASK                                                \
+  ((((thdmask_t)1 << (CH_CFG_MAX_THREADS - 1)) << 1) - (thdmask_t)1)
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -48,6 +62,132 @@ os_instance_t nil;
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREADS_BITMAPS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the thread associated to the lowest bit set in a bitmap.
+ *
+ * @param[in] mask      threads bitmap, must not be zero
+ * @return              The pointer to the thread.
+ *
+ * @notapi
+ */
+static inline thread_t *nil_first_thread(thdmask_t mask) {
+
+#if defined(__GNUC__)
+  return &nil.threads[__builtin_ctzl((unsigned long)mask)];
+#else
+  thread_t *tp = &nil.threads[0];
+
+  while ((mask & (thdmask_t)1) == (thdmask_t)0) {
+    mask >>= 1;
+    tp++;
+  }
+
+  return tp;
+#endif
+}
+
+/**
+ * @brief   Returns the bitmap of the threads not in ready state.
+ * @note    Slots of threads not yet started or terminated are included.
+ *
+ * @return              The threads bitmap.
+ *
+ * @notapi
+ */
+static inline thdmask_t nil_waiting_mask(void) {
+
+  return ~nil.rdmask & NIL_ALL_THREADS_MASK;
+}
+#endif /* CH_CFG_USE_THREADS_BITMAPS == TRUE */
+
+#if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Processes a system tick for a thread.
+ *
+ * @param[in] tp        pointer to the thread
+ *
+ * @notapi
+ */
+static inline void nil_thd_tick(thread_t *tp) {
+
+  /* Is the thread in a wait state with timeout?.*/
+  if (tp->timeout > (sysinterval_t)0) {
+
+    chDbgAssert(!NIL_THD_IS_READY(tp), "is ready");
+
+    /* Did the timer reach zero?*/
+    if (--tp->timeout == (sysinterval_t)0) {
+      /* Timeout on queues/semaphores requires a special handling because
+         the counter must be incremented.*/
+      /*lint -save -e9013 [15.7] There is no else because it is not needed.*/
+#if CH_CFG_USE_SEMAPHORES == TRUE
+      if (NIL_THD_IS_WTQUEUE(tp)) {
+        tp->u1.semp->cnt++;
+      }
+      else
+#endif
+      if (NIL_THD_IS_SUSPENDED(tp)) {
+        *tp->u1.trp = NULL;
+      }
+      /*lint -restore*/
+      (void) chSchReadyI(tp, MSG_TIMEOUT);
+    }
+  }
+}
+#endif /* CH_CFG_ST_TIMEDELTA == 0 */
+
+#if (CH_CFG_ST_TIMEDELTA > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Processes an alarm event for a thread.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[in] elapsed   time elapsed since the previous alarm event
+ * @param[in] next      nearest timeout among the already processed threads,
+ *                      zero if none
+ * @return              The updated nearest timeout.
+ *
+ * @notapi
+ */
+static inline sysinterval_t nil_thd_alarm(thread_t *tp,
+                                          sysinterval_t elapsed,
+                                          sysinterval_t next) {
+  sysinterval_t timeout = tp->timeout;
+
+  /* Is the thread in a wait state with timeout?.*/
+  if (timeout > (sysinterval_t)0) {
+
+    chDbgAssert(!NIL_THD_IS_READY(tp), "is ready");
+    chDbgAssert(timeout >= elapsed, "skipped one");
+
+    /* The volatile field is updated once, here.*/
+    timeout -= elapsed;
+    tp->timeout = timeout;
+
+    if (timeout == (sysinterval_t)0) {
+      /* Timeout on thread queues requires a special handling because the
+         counter must be incremented.*/
+      if (NIL_THD_IS_WTQUEUE(tp)) {
+        tp->u1.tqp->cnt++;
+      }
+      else {
+        if (NIL_THD_IS_SUSPENDED(tp)) {
+          *tp->u1.trp = NULL;
+        }
+      }
+      (void) chSchReadyI(tp, MSG_TIMEOUT);
+    }
+    else {
+      if (timeout <= (sysinterval_t)(next - (sysinterval_t)1)) {
+        next = timeout;
+      }
+    }
+  }
+
+  return next;
+}
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+
 /*===========================================================================*/
 /* Module interrupt handlers.                                                */
 /*===========================================================================*/
@@ -68,6 +208,20 @@ os_instance_t nil;
  * @notapi
  */
 thread_t *nil_find_thread(tstate_t state, void *p) {
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+  thdmask_t mask = nil_waiting_mask();
+
+  /* Only threads not in ready state are visited, in priority order.*/
+  while (mask != (thdmask_t)0) {
+    thread_t *tp = nil_first_thread(mask);
+
+    /* Is this thread matching?*/
+    if ((tp->state == state) && (tp->u1.p == p)) {
+      return tp;
+    }
+    mask &= mask - (thdmask_t)1;
+  }
+#else
   thread_t *tp = nil.threads;
 
   while (tp < &nil.threads[CH_CFG_MAX_THREADS]) {
@@ -77,6 +231,7 @@ thread_t *nil_find_thread(tstate_t state, void *p) {
     }
     tp++;
   }
+#endif
   return NULL;
 }
 
@@ -93,7 +248,25 @@ thread_t *nil_find_thread(tstate_t state, void *p) {
  * @notapi
  */
 cnt_t nil_ready_all(void *p, cnt_t cnt, msg_t msg) {
-  thread_t *tp = nil.threads;;
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+  thdmask_t mask = nil_waiting_mask();
+
+  while (cnt < (cnt_t)0) {
+    thread_t *tp;
+
+    chDbgAssert(mask != (thdmask_t)0, "thread not found");
+
+    tp = nil_first_thread(mask);
+    mask &= mask - (thdmask_t)1;
+
+    /* Is this thread waiting on this queue?*/
+    if ((tp->state == NIL_STATE_WTQUEUE) && (tp->u1.p == p)) {
+      cnt++;
+      (void) chSchReadyI(tp, msg);
+    }
+  }
+#else
+  thread_t *tp = nil.threads;
 
   while (cnt < (cnt_t)0) {
 
@@ -107,6 +280,7 @@ cnt_t nil_ready_all(void *p, cnt_t cnt, msg_t msg) {
     }
     tp++;
   }
+#endif
 
   return cnt;
 }
@@ -357,77 +531,57 @@ void chSysTimerHandlerI(void) {
   chDbgCheckClassI();
 
 #if CH_CFG_ST_TIMEDELTA == 0
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+  /* Only the threads waiting with a timeout are visited. A bitmap copy is
+     used because threads can be readied by other ISRs while the lock is
+     released.*/
+  thdmask_t mask = nil.tmmask;
+  nil.systime++;
+  while (mask != (thdmask_t)0) {
+    nil_thd_tick(nil_first_thread(mask));
+    mask &= mask - (thdmask_t)1;
+
+    /* Lock released in order to give a preemption chance on those
+       architectures supporting IRQ preemption.*/
+    chSysUnlockFromISR();
+    chSysLockFromISR();
+  }
+#else
   thread_t *tp = &nil.threads[0];
   nil.systime++;
   do {
-    /* Is the thread in a wait state with timeout?.*/
-    if (tp->timeout > (sysinterval_t)0) {
-
-      chDbgAssert(!NIL_THD_IS_READY(tp), "is ready");
+    nil_thd_tick(tp);
 
-      /* Did the timer reach zero?*/
-      if (--tp->timeout == (sysinterval_t)0) {
-        /* Timeout on queues/semaphores requires a special handling because
-           the counter must be incremented.*/
-        /*lint -save -e9013 [15.7] There is no else because it is not needed.*/
-#if CH_CFG_USE_SEMAPHORES == TRUE
-        if (NIL_THD_IS_WTQUEUE(tp)) {
-          tp->u1.semp->cnt++;
-        }
-        else
-#endif
-        if (NIL_THD_IS_SUSPENDED(tp)) {
-          *tp->u1.trp = NULL;
-        }
-        /*lint -restore*/
-        (void) chSchReadyI(tp, MSG_TIMEOUT);
-      }
-    }
     /* Lock released in order to give a preemption chance on those
        architectures supporting IRQ preemption.*/
     chSysUnlockFromISR();
     tp++;
     chSysLockFromISR();
   } while (tp < &nil.threads[CH_CFG_MAX_THREADS]);
+#endif
 #else
-  thread_t *tp = &nil.threads[0];
+  sysinterval_t elapsed = chTimeDiffX(nil.lasttime, nil.nexttime);
   sysinterval_t next = (sysinterval_t)0;
 
   chDbgAssert(nil.nexttime == port_timer_get_alarm(), "time mismatch");
 
-  do {
-    sysinterval_t timeout = tp->timeout;
-
-    /* Is the thread in a wait state with timeout?.*/
-    if (timeout > (sysinterval_t)0) {
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+  /* Only the threads waiting with a timeout are visited, the next deadline
+     is the nearest among the remaining timeouts.*/
+  thdmask_t mask = nil.tmmask;
+  while (mask != (thdmask_t)0) {
+    next = nil_thd_alarm(nil_first_thread(mask), elapsed, next);
+    mask &= mask - (thdmask_t)1;
 
-      chDbgAssert(!NIL_THD_IS_READY(tp), "is ready");
-      chDbgAssert(timeout >= chTimeDiffX(nil.lasttime, nil.nexttime),
-                  "skipped one");
-
-      /* The volatile field is updated once, here.*/
-      timeout -= chTimeDiffX(nil.lasttime, nil.nexttime);
-      tp->timeout = timeout;
-
-      if (timeout == (sysinterval_t)0) {
-        /* Timeout on thread queues requires a special handling because the
-           counter must be incremented.*/
-        if (NIL_THD_IS_WTQUEUE(tp)) {
-          tp->u1.tqp->cnt++;
-        }
-        else {
-          if (NIL_THD_IS_SUSPENDED(tp)) {
-            *tp->u1.trp = NULL;
-          }
-        }
-        (void) chSchReadyI(tp, MSG_TIMEOUT);
-      }
-      else {
-        if (timeout <= (sysinterval_t)(next - (sysinterval_t)1)) {
-          next = timeout;
-        }
-      }
-    }
+    /* Lock released in order to give a preemption chance on those
+       architectures supporting IRQ preemption.*/
+    chSysUnlockFromISR();
+    chSysLockFromISR();
+  }
+#else
+  thread_t *tp = &nil.threads[0];
+  do {
+    next = nil_thd_alarm(tp, elapsed, next);
 
     /* Lock released in order to give a preemption chance on those
        architectures supporting IRQ preemption.*/
@@ -435,6 +589,7 @@ void chSysTimerHandlerI(void) {
     tp++;
     chSysLockFromISR();
   } while (tp < &nil.threads[CH_CFG_MAX_THREADS]);
+#endif
 
   nil.lasttime = nil.nexttime;
   if (next > (sysinterval_t)0) {
@@ -594,6 +749,10 @@ thread_t *chSchReadyI(thread_t *tp, msg_t msg) {
   tp->u1.msg = msg;
   tp->state = NIL_STATE_READY;
   tp->timeout = (sysinterval_t)0;
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+  nil.rdmask |= NIL_THD_MASK(tp);
+  nil.tmmask &= ~NIL_THD_MASK(tp);
+#endif
   if (tp < nil.next) {
     nil.next = tp;
   }
@@ -675,6 +834,9 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
 
   /* Storing the wait object for the current thread.*/
   otp->state = newstate;
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+  nil.rdmask &= ~NIL_THD_MASK(otp);
+#endif
 
 #if CH_CFG_ST_TIMEDELTA > 0
   if (timeout != TIME_INFINITE) {
@@ -705,31 +867,48 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
 
     /* Timeout settings.*/
     otp->timeout = abstime - nil.lasttime;
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+    nil.tmmask |= NIL_THD_MASK(otp);
+#endif
   }
 #else
 
   /* Timeout settings.*/
   otp->timeout = timeout;
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+  if (timeout != TIME_INFINITE) {
+    nil.tmmask |= NIL_THD_MASK(otp);
+  }
+#endif
 #endif
 
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+  /* The highest priority ready thread is the lowest bit set in the ready
+     bitmap, the idle thread if none.*/
+  if (nil.rdmask != (thdmask_t)0) {
+    ntp = nil_first_thread(nil.rdmask);
+  }
+  else {
+    ntp = &nil.threads[CH_CFG_MAX_THREADS];
+  }
+#else
   /* Scanning the whole threads array.*/
   ntp = nil.threads;
-  while (true) {
-    /* Is this thread ready to execute?*/
-    if (NIL_THD_IS_READY(ntp)) {
-      nil.current = nil.next = ntp;
-      if (ntp == &nil.threads[CH_CFG_MAX_THREADS]) {
-        CH_CFG_IDLE_ENTER_HOOK();
-      }
-      port_switch(ntp, otp);
-      return nil.current->u1.msg;
-    }
+  while (!NIL_THD_IS_READY(ntp)) {
 
     /* Points to the next thread in lowering priority order.*/
     ntp++;
     chDbgAssert(ntp <= &nil.threads[CH_CFG_MAX_THREADS],
                 "pointer out of range");
   }
+#endif
+
+  nil.current = nil.next = ntp;
+  if (ntp == &nil.threads[CH_CFG_MAX_THREADS]) {
+    CH_CFG_IDLE_ENTER_HOOK();
+  }
+  port_switch(ntp, otp);
+  return nil.current->u1.msg;
 }
 
 /**
@@ -844,6 +1023,18 @@ void chThdExit(msg_t msg) {
 #if CH_CFG_USE_WAITEXIT == TRUE
   {
     /* Waking up any waiting thread.*/
+#if CH_CFG_USE_THREADS_BITMAPS == TRUE
+    thdmask_t mask = nil_waiting_mask();
+    while (mask != (thdmask_t)0) {
+      thread_t *tp = nil_first_thread(mask);
+      mask &= mask - (thdmask_t)1;
+
+      /* Is this thread waiting for current thread termination?*/
+      if ((tp->state == NIL_STATE_WTEXIT) && (tp->u1.tp == nil.current)) {
+        (void) chSchReadyI(tp, msg);
+      }
+    }
+#else
     thread_t *tp = nil.threads;
     while (tp < &nil.threads[CH_CFG_MAX_THREADS]) {
       /* Is this thread waiting for current thread termination?*/
@@ -852,6 +1043,7 @@ void chThdExit(msg_t msg) {
       }
       tp++;
     }
+#endif
   }
 #endif
 
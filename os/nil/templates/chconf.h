@@ -58,6 +58,18 @@
 #define CH_CFG_AUTOSTART_THREADS            TRUE
 #endif
 
+/**
+ * @brief   Threads bitmaps.
+ * @details If enabled then the kernel keeps a bitmap of the ready threads
+ *          and a bitmap of the threads waiting with a timeout, scheduling
+ *          and timeouts processing only visit the relevant threads instead
+ *          of scanning the whole threads table.
+ * @note    This option raises the maximum number of threads to 32.
+ */
+#if !defined(CH_CFG_USE_THREADS_BITMAPS)
+#define CH_CFG_USE_THREADS_BITMAPS          FALSE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -364,6 +376,16 @@
 #define CH_CFG_FACTORY_PIPES                TRUE
 #endif
 
+/**
+ * @brief   Size of the objects hash tables.
+ * @details If non-zero then the factory lists are indexed by name and
+ *          registered objects by pointer, lookups become O(1) on average.
+ * @note    Must be zero or a power of two.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_SIZE)
+#define CH_CFG_FACTORY_HASH_SIZE            0
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -38,6 +38,11 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Maximum number of parameters in a delegate call frame.
+ */
+#define CH_DELEGATE_MAX_ARGS                4U
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -84,6 +89,67 @@ typedef msg_t (*delegate_fn3_t)(msg_t p1, msg_t p2, msg_t p3);
  */
 typedef msg_t (*delegate_fn4_t)(msg_t p1, msg_t p2, msg_t p3, msg_t p4);
 
+/**
+ * @brief   Type of a delegate call frame.
+ * @details A call frame carries the function pointer and its parameters
+ *          in a fixed layout, no @p va_list packing or unpacking is
+ *          involved when a frame is executed.
+ */
+typedef struct {
+  /**
+   * @brief   Function to be called, the member to be used depends on
+   *          the number of parameters.
+   */
+  union {
+    delegate_fn0_t          fn0;
+    delegate_fn1_t          fn1;
+    delegate_fn2_t          fn2;
+    delegate_fn3_t          fn3;
+    delegate_fn4_t          fn4;
+  } func;
+  /**
+   * @brief   Number of parameters.
+   */
+  unsigned                  argc;
+  /**
+   * @brief   Parameters passed as @p msg_t.
+   */
+  msg_t                     args[CH_DELEGATE_MAX_ARGS];
+} delegate_frame_t;
+
+/**
+ * @brief   Type of an asynchronous delegate calls queue.
+ * @details The queue is a ring of call frames posted by other threads or
+ *          ISRs without blocking and executed by a single dispatcher thread
+ *          using @p chDelegateDispatchQueueTimeout().
+ */
+typedef struct {
+  /**
+   * @brief   Pointer to the frames buffer.
+   */
+  delegate_frame_t          *buffer;
+  /**
+   * @brief   Pointer to the first location after the buffer.
+   */
+  delegate_frame_t          *top;
+  /**
+   * @brief   Write pointer.
+   */
+  delegate_frame_t          *wrptr;
+  /**
+   * @brief   Read pointer.
+   */
+  delegate_frame_t          *rdptr;
+  /**
+   * @brief   Frames in the queue.
+   */
+  size_t                    cnt;
+  /**
+   * @brief   Waiting dispatcher thread.
+   */
+  thread_reference_t        thread;
+} delegate_queue_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -103,6 +169,13 @@ extern "C" {
   void chDelegateDispatch(void);
   msg_t chDelegateDispatchTimeout(sysinterval_t timeout);
   msg_t chDelegateCallVeneer(thread_t *tp, delegate_veneer_t veneer, ...);
+  msg_t chDelegateCallFrame(thread_t *tp, const delegate_frame_t *dfp);
+  void chDelegateQueueObjectInit(delegate_queue_t *dqp,
+                                 delegate_frame_t *buf, size_t n);
+  msg_t chDelegatePostI(delegate_queue_t *dqp, const delegate_frame_t *dfp);
+  msg_t chDelegatePost(delegate_queue_t *dqp, const delegate_frame_t *dfp);
+  size_t chDelegateDispatchQueueTimeout(delegate_queue_t *dqp, size_t n,
+                                        sysinterval_t timeout);
 #ifdef __cplusplus
 }
 #endif
@@ -113,6 +186,8 @@ extern "C" {
 
 /**
  * @brief   Direct call to a function with no parameters.
+ * @details The call is performed using a fixed call frame, there is no
+ *          @p va_list involved.
  * @note    The return value is assumed to be not larger than a data
  *          pointer type. If you need a portable function then use
  *          @p chDelegateCallVeneer() instead.
@@ -122,12 +197,18 @@ extern "C" {
  * @return              The function return value as a @p msg_t.
  */
 static inline msg_t chDelegateCallDirect0(thread_t *tp, delegate_fn0_t func) {
+  delegate_frame_t df;
 
-  return chDelegateCallVeneer(tp, __ch_delegate_fn0, func);
+  df.func.fn0 = func;
+  df.argc     = 0U;
+
+  return chDelegateCallFrame(tp, &df);
 }
 
 /**
  * @brief   Direct call to a function with one parameter.
+ * @details The call is performed using a fixed call frame, there is no
+ *          @p va_list involved.
  * @note    The return value and parameters are assumed to be not larger
  *          than a data pointer type. If you need a portable function then use
  *          @p chDelegateCallVeneer() instead.
@@ -139,12 +220,19 @@ static inline msg_t chDelegateCallDirect0(thread_t *tp, delegate_fn0_t func) {
  */
 static inline msg_t chDelegateCallDirect1(thread_t *tp, delegate_fn1_t func,
                                           msg_t p1) {
+  delegate_frame_t df;
+
+  df.func.fn1 = func;
+  df.argc     = 1U;
+  df.args[0]  = p1;
 
-  return chDelegateCallVeneer(tp, __ch_delegate_fn1, func, p1);
+  return chDelegateCallFrame(tp, &df);
 }
 
 /**
  * @brief   Direct call to a function with two parameters.
+ * @details The call is performed using a fixed call frame, there is no
+ *          @p va_list involved.
  * @note    The return value and parameters are assumed to be not larger
  *          than a data pointer type. If you need a portable function then use
  *          @p chDelegateCallVeneer() instead.
@@ -157,12 +245,20 @@ static inline msg_t chDelegateCallDirect1(thread_t *tp, delegate_fn1_t func,
  */
 static inline msg_t chDelegateCallDirect2(thread_t *tp, delegate_fn2_t func,
                                           msg_t p1, msg_t p2) {
+  delegate_frame_t df;
 
-  return chDelegateCallVeneer(tp, __ch_delegate_fn2, func, p1, p2);
+  df.func.fn2 = func;
+  df.argc     = 2U;
+  df.args[0]  = p1;
+  df.args[1]  = p2;
+
+  return chDelegateCallFrame(tp, &df);
 }
 
 /**
  * @brief   Direct call to a function with three parameters.
+ * @details The call is performed using a fixed call frame, there is no
+ *          @p va_list involved.
  * @note    The return value and parameters are assumed to be not larger
  *          than a data pointer type. If you need a portable function then use
  *          @p chDelegateCallVeneer() instead.
@@ -176,12 +272,21 @@ static inline msg_t chDelegateCallDirect2(thread_t *tp, delegate_fn2_t func,
  */
 static inline msg_t chDelegateCallDirect3(thread_t *tp, delegate_fn3_t func,
                                           msg_t p1, msg_t p2, msg_t p3) {
+  delegate_frame_t df;
+
+  df.func.fn3 = func;
+  df.argc     = 3U;
+  df.args[0]  = p1;
+  df.args[1]  = p2;
+  df.args[2]  = p3;
 
-  return chDelegateCallVeneer(tp, __ch_delegate_fn3, func, p1, p2, p3);
+  return chDelegateCallFrame(tp, &df);
 }
 
 /**
  * @brief   Direct call to a function with four parameters.
+ * @details The call is performed using a fixed call frame, there is no
+ *          @p va_list involved.
  * @note    The return value and parameters are assumed to be not larger
  *          than a data pointer type. If you need a portable function then use
  *          @p chDelegateCallVeneer() instead.
@@ -197,8 +302,154 @@ static inline msg_t chDelegateCallDirect3(thread_t *tp, delegate_fn3_t func,
 static inline msg_t chDelegateCallDirect4(thread_t *tp, delegate_fn4_t func,
                                           msg_t p1, msg_t p2, msg_t p3,
                                           msg_t p4) {
+  delegate_frame_t df;
+
+  df.func.fn4 = func;
+  df.argc     = 4U;
+  df.args[0]  = p1;
+  df.args[1]  = p2;
+  df.args[2]  = p3;
+  df.args[3]  = p4;
+
+  return chDelegateCallFrame(tp, &df);
+}
+
+/**
+ * @brief   Asynchronous call to a function with no parameters.
+ * @details The call frame is posted into the queue and the function
+ *          returns immediately, the function return value is discarded.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t object
+ * @param[in] func      pointer to the function to be called
+ * @return              The operation status.
+ * @retval MSG_OK       if the call has been queued.
+ * @retval MSG_TIMEOUT  if the queue is full.
+ *
+ * @api
+ */
+static inline msg_t chDelegatePostDirect0(delegate_queue_t *dqp,
+                                          delegate_fn0_t func) {
+  delegate_frame_t df;
+
+  df.func.fn0 = func;
+  df.argc     = 0U;
+
+  return chDelegatePost(dqp, &df);
+}
+
+/**
+ * @brief   Asynchronous call to a function with one parameter.
+ * @details The call frame is posted into the queue and the function
+ *          returns immediately, the function return value is discarded.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t object
+ * @param[in] func      pointer to the function to be called
+ * @param[in] p1        parameter 1 passed as a @p msg_t
+ * @return              The operation status.
+ * @retval MSG_OK       if the call has been queued.
+ * @retval MSG_TIMEOUT  if the queue is full.
+ *
+ * @api
+ */
+static inline msg_t chDelegatePostDirect1(delegate_queue_t *dqp,
+                                          delegate_fn1_t func, msg_t p1) {
+  delegate_frame_t df;
+
+  df.func.fn1 = func;
+  df.argc     = 1U;
+  df.args[0]  = p1;
 
-  return chDelegateCallVeneer(tp, __ch_delegate_fn4, func, p1, p2, p3, p4);
+  return chDelegatePost(dqp, &df);
+}
+
+/**
+ * @brief   Asynchronous call to a function with two parameters.
+ * @details The call frame is posted into the queue and the function
+ *          returns immediately, the function return value is discarded.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t object
+ * @param[in] func      pointer to the function to be called
+ * @param[in] p1        parameter 1 passed as a @p msg_t
+ * @param[in] p2        parameter 2 passed as a @p msg_t
+ * @return              The operation status.
+ * @retval MSG_OK       if the call has been queued.
+ * @retval MSG_TIMEOUT  if the queue is full.
+ *
+ * @api
+ */
+static inline msg_t chDelegatePostDirect2(delegate_queue_t *dqp,
+                                          delegate_fn2_t func, msg_t p1,
+                                          msg_t p2) {
+  delegate_frame_t df;
+
+  df.func.fn2 = func;
+  df.argc     = 2U;
+  df.args[0]  = p1;
+  df.args[1]  = p2;
+
+  return chDelegatePost(dqp, &df);
+}
+
+/**
+ * @brief   Asynchronous call to a function with three parameters.
+ * @details The call frame is posted into the queue and the function
+ *          returns immediately, the function return value is discarded.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t object
+ * @param[in] func      pointer to the function to be called
+ * @param[in] p1        parameter 1 passed as a @p msg_t
+ * @param[in] p2        parameter 2 passed as a @p msg_t
+ * @param[in] p3        parameter 3 passed as a @p msg_t
+ * @return              The operation status.
+ * @retval MSG_OK       if the call has been queued.
+ * @retval MSG_TIMEOUT  if the queue is full.
+ *
+ * @api
+ */
+static inline msg_t chDelegatePostDirect3(delegate_queue_t *dqp,
+                                          delegate_fn3_t func, msg_t p1,
+                                          msg_t p2, msg_t p3) {
+  delegate_frame_t df;
+
+  df.func.fn3 = func;
+  df.argc     = 3U;
+  df.args[0]  = p1;
+  df.args[1]  = p2;
+  df.args[2]  = p3;
+
+  return chDelegatePost(dqp, &df);
+}
+
+/**
+ * @brief   Asynchronous call to a function with four parameters.
+ * @details The call frame is posted into the queue and the function
+ *          returns immediately, the function return value is discarded.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t object
+ * @param[in] func      pointer to the function to be called
+ * @param[in] p1        parameter 1 passed as a @p msg_t
+ * @param[in] p2        parameter 2 passed as a @p msg_t
+ * @param[in] p3        parameter 3 passed as a @p msg_t
+ * @param[in] p4        parameter 4 passed as a @p msg_t
+ * @return              The operation status.
+ * @retval MSG_OK       if the call has been queued.
+ * @retval MSG_TIMEOUT  if the queue is full.
+ *
+ * @api
+ */
+static inline msg_t chDelegatePostDirect4(delegate_queue_t *dqp,
+                                          delegate_fn4_t func, msg_t p1,
+                                          msg_t p2, msg_t p3, msg_t p4) {
+  delegate_frame_t df;
+
+  df.func.fn4 = func;
+  df.argc     = 4U;
+  df.args[0]  = p1;
+  df.args[1]  = p2;
+  df.args[2]  = p3;
+  df.args[3]  = p4;
+
+  return chDelegatePost(dqp, &df);
 }
 
 #endif /* CH_CFG_USE_DELEGATES == TRUE */
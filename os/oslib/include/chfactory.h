@@ -89,6 +89,20 @@
 #define CH_CFG_FACTORY_PIPES                TRUE
 #endif
 
+/**
+ * @brief   Size of the objects hash tables.
+ * @details If non-zero then each factory list is indexed by a hash table
+ *          with the specified number of buckets, names are hashed using
+ *          FNV-1a. Registered objects are also indexed by pointer in a
+ *          separate table of the same size. Lookup and release become
+ *          O(1) on average at the cost of two extra pointers per object
+ *          and per bucket.
+ * @note    Must be zero or a power of two.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_FACTORY_HASH_SIZE            0
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -138,6 +152,11 @@
 #error "CH_CFG_FACTORY_MAX_NAMES_LENGTH must be 0 or within [4..32]"
 #endif
 
+#if (CH_CFG_FACTORY_HASH_SIZE < 0) ||                                       \
+    ((CH_CFG_FACTORY_HASH_SIZE & (CH_CFG_FACTORY_HASH_SIZE - 1)) != 0)
+#error "CH_CFG_FACTORY_HASH_SIZE must be 0 or a power of two"
+#endif
+
 #if (CH_CFG_USE_MUTEXES == FALSE) && (CH_CFG_USE_SEMAPHORES == FALSE)
 #error "CH_CFG_USE_FACTORY requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
 #endif
@@ -166,6 +185,16 @@ typedef struct ch_dyn_element {
    * @brief   Next dynamic object in the list.
    */
   struct ch_dyn_element *next;
+#if (CH_CFG_FACTORY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Previous dynamic object in the list.
+   */
+  struct ch_dyn_element *prev;
+  /**
+   * @brief   Next dynamic object in the same hash bucket.
+   */
+  struct ch_dyn_element *hnext;
+#endif
   /**
    * @brief   Number of references to this object.
    */
@@ -182,6 +211,13 @@ typedef struct ch_dyn_element {
  */
 typedef struct ch_dyn_list {
     dyn_element_t       *next;
+#if (CH_CFG_FACTORY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+    dyn_element_t       *prev;
+    /**
+     * @brief   Hash buckets indexed by object name.
+     */
+    dyn_element_t       *buckets[CH_CFG_FACTORY_HASH_SIZE];
+#endif
 } dyn_list_t;
 
 #if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
@@ -198,6 +234,12 @@ typedef struct ch_registered_static_object {
    * @note    The type of the object is not stored in anyway.
    */
   void                  *objp;
+#if (CH_CFG_FACTORY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Next registered object in the same pointer hash bucket.
+   */
+  struct ch_registered_static_object *pnext;
+#endif
 } registered_object_t;
 #endif
 
@@ -293,6 +335,13 @@ typedef struct ch_objects_factory {
    * @brief   List of the registered objects.
    */
   dyn_list_t            obj_list;
+#if ((CH_CFG_FACTORY_HASH_SIZE > 0) &&                                     \
+     (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE)) || defined(__DOXYGEN__)
+  /**
+   * @brief   Registered objects hash buckets indexed by object pointer.
+   */
+  registered_object_t   *obj_ptr_buckets[CH_CFG_FACTORY_HASH_SIZE];
+#endif
   /**
    * @brief   Pool of the available registered objects.
    */
@@ -26,7 +26,10 @@
  *          by other threads. This functionality is especially useful when
  *          encapsulating a library not designed for threading into a
  *          delegate thread. Other threads have access to the library without
- *          having to worry about mutual exclusion.
+ *          having to worry about mutual exclusion.<br>
+ *          Calls can also be posted asynchronously into a
+ *          @p delegate_queue_t object, the caller does not wait and the
+ *          dispatcher thread executes the queued calls in batches.
  * @pre     In order to use the pipes APIs the @p CH_CFG_USE_DELEGATES
  *          option must be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -57,12 +60,17 @@
 typedef struct {
   /**
    * @brief   The delegate veneer function.
+   * @note    It is @p NULL for calls performed using a call frame.
    */
   delegate_veneer_t veneer;
   /**
    * @brief   Pointer to the caller @p va_list object.
    */
   va_list           *argsp;
+  /**
+   * @brief   Pointer to the caller call frame.
+   */
+  const delegate_frame_t *framep;
 } call_message_t;
 
 /*===========================================================================*/
@@ -73,6 +81,44 @@ typedef struct {
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Executes a call frame.
+ *
+ * @param[in] dfp       pointer to the call frame
+ * @return              The function return value.
+ */
+static msg_t delegate_frame_execute(const delegate_frame_t *dfp) {
+
+  switch (dfp->argc) {
+  case 0U:
+    return dfp->func.fn0();
+  case 1U:
+    return dfp->func.fn1(dfp->args[0]);
+  case 2U:
+    return dfp->func.fn2(dfp->args[0], dfp->args[1]);
+  case 3U:
+    return dfp->func.fn3(dfp->args[0], dfp->args[1], dfp->args[2]);
+  default:
+    return dfp->func.fn4(dfp->args[0], dfp->args[1], dfp->args[2],
+                         dfp->args[3]);
+  }
+}
+
+/**
+ * @brief   Executes a call message.
+ *
+ * @param[in] cmp       pointer to the call message
+ * @return              The function return value.
+ */
+static msg_t delegate_message_execute(const call_message_t *cmp) {
+
+  if (cmp->veneer == NULL) {
+    return delegate_frame_execute(cmp->framep);
+  }
+
+  return cmp->veneer(cmp->argsp);
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -165,6 +211,7 @@ msg_t chDelegateCallVeneer(thread_t *tp, delegate_veneer_t veneer, ...) {
   /* Preparing the call message.*/
   cm.veneer = veneer;
   cm.argsp  = &args;
+  cm.framep = NULL;
   (void)cm; /* Suppresses a lint warning.*/
 
   /* Sending the message to the dispatcher thread, the return value is
@@ -178,6 +225,31 @@ msg_t chDelegateCallVeneer(thread_t *tp, delegate_veneer_t veneer, ...) {
 
 /*lint -restore*/
 
+/**
+ * @brief   Triggers a function call on a delegate thread using a call frame.
+ * @details The call frame is passed by reference to the delegate thread,
+ *          parameters are not copied and no @p va_list is involved.
+ * @note    The thread must be executing @p chDelegateDispatchTimeout() in
+ *          order to have the functions called.
+ *
+ * @param[in] tp        pointer to the delegate thread
+ * @param[in] dfp       pointer to the call frame
+ * @return              The function return value.
+ *
+ * @api
+ */
+msg_t chDelegateCallFrame(thread_t *tp, const delegate_frame_t *dfp) {
+  call_message_t cm;
+
+  chDbgCheck((dfp != NULL) && (dfp->argc <= CH_DELEGATE_MAX_ARGS));
+
+  cm.veneer = NULL;
+  cm.argsp  = NULL;
+  cm.framep = dfp;
+
+  return chMsgSend(tp, (msg_t)&cm);
+}
+
 /**
  * @brief   Call messages dispatching.
  * @details The function awaits for an incoming call messages and calls the
@@ -194,7 +266,7 @@ void chDelegateDispatch(void) {
 
   tp = chMsgWait();
   cmp = (const call_message_t *)chMsgGet(tp);
-  ret = cmp->veneer(cmp->argsp);
+  ret = delegate_message_execute(cmp);
 
   chMsgRelease(tp, ret);
 }
@@ -226,13 +298,153 @@ msg_t chDelegateDispatchTimeout(sysinterval_t timeout) {
   }
 
   cmp = (const call_message_t *)chMsgGet(tp);
-  ret = cmp->veneer(cmp->argsp);
+  ret = delegate_message_execute(cmp);
 
   chMsgRelease(tp, ret);
 
   return MSG_OK;
 }
 
+/**
+ * @brief   Initializes a @p delegate_queue_t object.
+ *
+ * @param[out] dqp      pointer to a @p delegate_queue_t object
+ * @param[in] buf       pointer to the call frames buffer
+ * @param[in] n         number of frames in the buffer
+ *
+ * @init
+ */
+void chDelegateQueueObjectInit(delegate_queue_t *dqp,
+                               delegate_frame_t *buf, size_t n) {
+
+  chDbgCheck((dqp != NULL) && (buf != NULL) && (n > 0U));
+
+  dqp->buffer = buf;
+  dqp->top    = buf + n;
+  dqp->wrptr  = buf;
+  dqp->rdptr  = buf;
+  dqp->cnt    = (size_t)0;
+  dqp->thread = NULL;
+}
+
+/**
+ * @brief   Posts an asynchronous call into a delegate queue.
+ * @details The call frame is copied into the queue and the function
+ *          returns without waiting for the call to be executed. The
+ *          dispatcher thread is awakened if it is waiting.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t object
+ * @param[in] dfp       pointer to the call frame
+ * @return              The operation status.
+ * @retval MSG_OK       if the call has been queued.
+ * @retval MSG_TIMEOUT  if the queue is full.
+ *
+ * @iclass
+ */
+msg_t chDelegatePostI(delegate_queue_t *dqp, const delegate_frame_t *dfp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((dqp != NULL) && (dfp != NULL) &&
+             (dfp->argc <= CH_DELEGATE_MAX_ARGS));
+
+  if (dqp->cnt >= (size_t)(dqp->top - dqp->buffer)) {
+    return MSG_TIMEOUT;
+  }
+
+  *dqp->wrptr = *dfp;
+  if (++dqp->wrptr >= dqp->top) {
+    dqp->wrptr = dqp->buffer;
+  }
+  dqp->cnt++;
+
+  chThdResumeI(&dqp->thread, MSG_OK);
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Posts an asynchronous call into a delegate queue.
+ * @details The call frame is copied into the queue and the function
+ *          returns without waiting for the call to be executed. The
+ *          dispatcher thread is awakened if it is waiting.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t object
+ * @param[in] dfp       pointer to the call frame
+ * @return              The operation status.
+ * @retval MSG_OK       if the call has been queued.
+ * @retval MSG_TIMEOUT  if the queue is full.
+ *
+ * @api
+ */
+msg_t chDelegatePost(delegate_queue_t *dqp, const delegate_frame_t *dfp) {
+  msg_t msg;
+
+  chSysLock();
+  msg = chDelegatePostI(dqp, dfp);
+  chSchRescheduleS();
+  chSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Queued calls dispatching with timeout.
+ * @details The function awaits for queued calls then executes all the
+ *          calls found in the queue, up to the specified limit, before
+ *          returning. Calls posted while the batch is being executed are
+ *          served in the same batch without further wake-ups.
+ * @note    Only one thread can dispatch a queue.
+ * @note    Calls are executed in place, queue slots are released after
+ *          each call returns.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t object
+ * @param[in] n         maximum number of calls to be executed
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of executed calls, zero means timeout.
+ *
+ * @api
+ */
+size_t chDelegateDispatchQueueTimeout(delegate_queue_t *dqp, size_t n,
+                                      sysinterval_t timeout) {
+  size_t done;
+
+  chDbgCheck((dqp != NULL) && (n > 0U));
+
+  chSysLock();
+
+  if (dqp->cnt == (size_t)0) {
+    if (chThdSuspendTimeoutS(&dqp->thread, timeout) != MSG_OK) {
+      chSysUnlock();
+      return (size_t)0;
+    }
+  }
+
+  done = (size_t)0;
+  while ((done < n) && (dqp->cnt > (size_t)0)) {
+    const delegate_frame_t *dfp = dqp->rdptr;
+
+    /* The slot is not released during the call so producers cannot
+       overwrite it.*/
+    chSysUnlock();
+    (void) delegate_frame_execute(dfp);
+    chSysLock();
+
+    if (++dqp->rdptr >= dqp->top) {
+      dqp->rdptr = dqp->buffer;
+    }
+    dqp->cnt--;
+    done++;
+  }
+
+  chSysUnlock();
+
+  return done;
+}
+
 #endif /* CH_CFG_USE_DELEGATES == TRUE */
 
 /** @} */
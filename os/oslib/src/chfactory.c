@@ -99,53 +99,174 @@ static void copy_name(const char *sp, dyn_element_t *dep) {
 #endif
 }
 
+#if (CH_CFG_FACTORY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+static uint32_t dyn_hash_pointer(const void *p) {
+  uint32_t h = (uint32_t)((uintptr_t)p >> 2);
+
+  h ^= h >> 16;
+  h *= 0x45D9F3BU;
+  h ^= h >> 16;
+
+  return h & ((uint32_t)CH_CFG_FACTORY_HASH_SIZE - 1U);
+}
+
+static uint32_t dyn_hash_name(const char *name) {
+#if (CH_CFG_FACTORY_MAX_NAMES_LENGTH > 0) || defined(__DOXYGEN__)
+  unsigned i = CH_CFG_FACTORY_MAX_NAMES_LENGTH;
+  uint32_t h = 2166136261U;
+
+  /* FNV-1a over the same characters considered by strncmp().*/
+  while ((i > 0U) && (*name != (char)0)) {
+    h ^= (uint32_t)(uint8_t)*name++;
+    h *= 16777619U;
+    i--;
+  }
+
+  return h & ((uint32_t)CH_CFG_FACTORY_HASH_SIZE - 1U);
+#else
+  return dyn_hash_pointer((const void *)name);
+#endif
+}
+#endif /* CH_CFG_FACTORY_HASH_SIZE > 0 */
+
+static inline bool dyn_name_match(const dyn_element_t *dep, const char *name) {
+
+#if (CH_CFG_FACTORY_MAX_NAMES_LENGTH > 0) || defined(__DOXYGEN__)
+  return (bool)(strncmp(dep->name, name, CH_CFG_FACTORY_MAX_NAMES_LENGTH) == 0);
+#else
+  return (bool)(dep->name == name);
+#endif
+}
+
 static inline void dyn_list_init(dyn_list_t *dlp) {
 
   dlp->next = (dyn_element_t *)dlp;
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  {
+    unsigned i;
+
+    dlp->prev = (dyn_element_t *)dlp;
+    for (i = 0U; i < (unsigned)CH_CFG_FACTORY_HASH_SIZE; i++) {
+      dlp->buckets[i] = NULL;
+    }
+  }
+#endif
+}
+
+static void dyn_list_insert(dyn_element_t *dep, dyn_list_t *dlp) {
+
+  dep->next = dlp->next;
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  {
+    uint32_t h = dyn_hash_name(dep->name);
+
+    dep->prev       = (dyn_element_t *)dlp;
+    dep->next->prev = dep;
+    dep->hnext      = dlp->buckets[h];
+    dlp->buckets[h] = dep;
+  }
+#endif
+  dlp->next = dep;
 }
 
 static dyn_element_t *dyn_list_find(const char *name, dyn_list_t *dlp) {
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  dyn_element_t *p = dlp->buckets[dyn_hash_name(name)];
+
+  while (p != NULL) {
+    if (dyn_name_match(p, name)) {
+      return p;
+    }
+    p = p->hnext;
+  }
+#else
   dyn_element_t *p = dlp->next;
 
   while (p != (dyn_element_t *)dlp) {
-#if (CH_CFG_FACTORY_MAX_NAMES_LENGTH > 0) || defined(__DOXYGEN__)
-    if (strncmp(p->name, name, CH_CFG_FACTORY_MAX_NAMES_LENGTH) == 0) {
-#else
-    if (p->name == name) {
-#endif
+    if (dyn_name_match(p, name)) {
       return p;
     }
     p = p->next;
   }
+#endif
 
   return NULL;
 }
 
-static dyn_element_t *dyn_list_find_prev(dyn_element_t *element,
-                                      dyn_list_t *dlp) {
+/*
+ * Returns a pointer to the link referencing the specified element, NULL if
+ * the element is not part of the list. The link is in the hash bucket if
+ * hashing is enabled else in the list itself.
+ */
+static dyn_element_t **dyn_list_find_link(dyn_element_t *element,
+                                          dyn_list_t *dlp) {
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  dyn_element_t **linkp = &dlp->buckets[dyn_hash_name(element->name)];
+
+  /* Scanning the bucket.*/
+  while (*linkp != NULL) {
+    if (*linkp == element) {
+      return linkp;
+    }
+
+    /* Next element in the bucket.*/
+    linkp = &(*linkp)->hnext;
+  }
+#else
   dyn_element_t *prev = (dyn_element_t *)dlp;
 
   /* Scanning the list.*/
   while (prev->next != (dyn_element_t *)dlp) {
     if (prev->next == element) {
-      return prev;
+      return &prev->next;
     }
 
     /* Next element in the list.*/
     prev = prev->next;
   }
+#endif
 
   return NULL;
 }
 
-static dyn_element_t *dyn_list_unlink(dyn_element_t *prev) {
-  dyn_element_t *element = prev->next;
+static dyn_element_t *dyn_list_unlink(dyn_element_t **linkp) {
+  dyn_element_t *element = *linkp;
 
-  prev->next = element->next;
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  *linkp              = element->hnext;
+  element->prev->next = element->next;
+  element->next->prev = element->prev;
+#else
+  *linkp = element->next;
+#endif
 
   return element;
 }
 
+#if ((CH_CFG_FACTORY_HASH_SIZE > 0) &&                                     \
+     (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE)) || defined(__DOXYGEN__)
+static void obj_ptr_insert(registered_object_t *rop) {
+  registered_object_t **bucketp;
+
+  bucketp = &ch_factory.obj_ptr_buckets[dyn_hash_pointer(rop->objp)];
+  rop->pnext = *bucketp;
+  *bucketp = rop;
+}
+
+static void obj_ptr_remove(registered_object_t *rop) {
+  registered_object_t **linkp;
+
+  linkp = &ch_factory.obj_ptr_buckets[dyn_hash_pointer(rop->objp)];
+  while (*linkp != NULL) {
+    if (*linkp == rop) {
+      *linkp = rop->pnext;
+      return;
+    }
+    linkp = &(*linkp)->pnext;
+  }
+}
+#endif
+
 #if CH_FACTORY_REQUIRES_HEAP || defined(__DOXYGEN__)
 static dyn_element_t *dyn_create_object_heap(const char *name,
                                              dyn_list_t *dlp,
@@ -170,30 +291,29 @@ static dyn_element_t *dyn_create_object_heap(const char *name,
   /* Initializing object list element.*/
   copy_name(name, dep);
   dep->refs = (ucnt_t)1;
-  dep->next = dlp->next;
 
   /* Updating factory list.*/
-  dlp->next = dep;
+  dyn_list_insert(dep, dlp);
 
   return dep;
 }
 
 static ucnt_t dyn_release_object_heap(dyn_element_t *dep,
                                       dyn_list_t *dlp) {
-  dyn_element_t *prev;
+  dyn_element_t **linkp;
   ucnt_t refs;
 
   chDbgCheck(dep != NULL);
 
   /* Checking 1st if the object is in the list.*/
-  prev = dyn_list_find_prev(dep, dlp);
-  if (prev != NULL) {
+  linkp = dyn_list_find_link(dep, dlp);
+  if (linkp != NULL) {
 
     chDbgAssert(dep->refs > (ucnt_t)0, "invalid references number");
 
     refs = --dep->refs;
     if (refs == (ucnt_t)0) {
-      chHeapFree((void *)dyn_list_unlink(prev));
+      chHeapFree((void *)dyn_list_unlink(linkp));
     }
   }
   else {
@@ -230,10 +350,9 @@ static dyn_element_t *dyn_create_object_pool(const char *name,
   /* Initializing object list element.*/
   copy_name(name, dep);
   dep->refs = (ucnt_t)1;
-  dep->next = dlp->next;
 
   /* Updating factory list.*/
-  dlp->next = (dyn_element_t *)dep;
+  dyn_list_insert(dep, dlp);
 
   return dep;
 }
@@ -241,20 +360,20 @@ static dyn_element_t *dyn_create_object_pool(const char *name,
 static ucnt_t dyn_release_object_pool(dyn_element_t *dep,
                                       dyn_list_t *dlp,
                                       memory_pool_t *mp) {
-  dyn_element_t *prev;
+  dyn_element_t **linkp;
   ucnt_t refs;
 
   chDbgCheck(dep != NULL);
 
   /* Checking 1st if the object is in the list.*/
-  prev = dyn_list_find_prev(dep, dlp);
-  if (prev != NULL) {
+  linkp = dyn_list_find_link(dep, dlp);
+  if (linkp != NULL) {
 
     chDbgAssert(dep->refs > (ucnt_t)0, "invalid references number");
 
     refs = --dep->refs;
     if (refs == (ucnt_t)0) {
-      chPoolFree(mp, (void *)dyn_list_unlink(prev));
+      chPoolFree(mp, (void *)dyn_list_unlink(linkp));
     }
   }
   else {
@@ -302,6 +421,15 @@ void __factory_init(void) {
 
 #if CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE
   dyn_list_init(&ch_factory.obj_list);
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  {
+    unsigned i;
+
+    for (i = 0U; i < (unsigned)CH_CFG_FACTORY_HASH_SIZE; i++) {
+      ch_factory.obj_ptr_buckets[i] = NULL;
+    }
+  }
+#endif
   chPoolObjectInit(&ch_factory.obj_pool,
                    sizeof (registered_object_t),
                    chCoreAllocAlignedI);
@@ -353,6 +481,9 @@ registered_object_t *chFactoryRegisterObject(const char *name,
   if (rop != NULL) {
     /* Initializing registered object data.*/
     rop->objp = objp;
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+    obj_ptr_insert(rop);
+#endif
   }
 
   FACTORY_UNLOCK();
@@ -403,6 +534,20 @@ registered_object_t *chFactoryFindObjectByPointer(void *objp) {
 
   FACTORY_LOCK();
 
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  rop = ch_factory.obj_ptr_buckets[dyn_hash_pointer(objp)];
+
+  while (rop != NULL) {
+    if (rop->objp == objp) {
+      rop->element.refs++;
+
+      FACTORY_UNLOCK();
+
+      return rop;
+    }
+    rop = rop->pnext;
+  }
+#else
   rop = (registered_object_t *)ch_factory.obj_list.next;
 
   while ((void *)rop != (void *)&ch_factory.obj_list) {
@@ -415,6 +560,7 @@ registered_object_t *chFactoryFindObjectByPointer(void *objp) {
     }
     rop = (registered_object_t *)rop->element.next;
   }
+#endif
 
   FACTORY_UNLOCK();
 
@@ -442,6 +588,14 @@ ucnt_t chFactoryReleaseObject(registered_object_t *rop) {
 
   FACTORY_LOCK();
 
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  /* The pointer index is updated before the element is returned to the
+     pool.*/
+  if (rop->element.refs == (ucnt_t)1) {
+    obj_ptr_remove(rop);
+  }
+#endif
+
   refs = dyn_release_object_pool(&rop->element,
                                  &ch_factory.obj_list,
                                  &ch_factory.obj_pool);
@@ -59,6 +59,10 @@
 typedef struct condition_variable {
   ch_queue_t            queue;              /**< @brief Condition variable
                                                  threads queue.             */
+#if (CH_CFG_USE_CONDVARS_MORPHING == TRUE) || defined(__DOXYGEN__)
+  mutex_t               *mutex;             /**< @brief Mutex used by the
+                                                 waiting threads.           */
+#endif
 } condition_variable_t;
 
 /*===========================================================================*/
@@ -72,7 +76,11 @@ typedef struct condition_variable {
  *
  * @param[in] name      the name of the condition variable
  */
+#if (CH_CFG_USE_CONDVARS_MORPHING == TRUE) || defined(__DOXYGEN__)
+#define __CONDVAR_DATA(name) {__CH_QUEUE_DATA(name.queue), NULL}
+#else
 #define __CONDVAR_DATA(name) {__CH_QUEUE_DATA(name.queue)}
+#endif
 
 /**
  * @brief Static condition variable initializer.
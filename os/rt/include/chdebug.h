@@ -46,6 +46,22 @@
 #if !defined(CH_DBG_STACK_FILL_VALUE) || defined(__DOXYGEN__)
 #define CH_DBG_STACK_FILL_VALUE             0x55
 #endif
+
+/**
+ * @brief   Debug option, stacks profiling.
+ * @details If enabled then guard words are placed into the threads stack
+ *          areas at exponentially spaced offsets from the stack base when
+ *          a thread is created, the guards can later be inspected in order
+ *          to estimate the stack high-water mark without the cost of a full
+ *          stack fill.
+ * @note    The guard words have the same value of a stack filled with
+ *          @p CH_DBG_STACK_FILL_VALUE so the option can be combined with
+ *          @p CH_DBG_FILL_THREADS.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_DBG_STACK_PROFILING) || defined(__DOXYGEN__)
+#define CH_DBG_STACK_PROFILING              FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -38,6 +38,18 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Threads pools APIs.
+ * @details If enabled then the threads pools APIs are included in the
+ *          kernel.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#if !defined(CH_CFG_USE_THREAD_POOLS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_THREAD_POOLS             FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -57,10 +69,86 @@
 #error "CH_CFG_USE_DYNAMIC requires CH_CFG_USE_HEAP and/or CH_CFG_USE_MEMPOOLS"
 #endif
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) && (CH_CFG_USE_HEAP == FALSE)
+#error "CH_CFG_USE_THREAD_POOLS requires CH_CFG_USE_HEAP"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a threads pool work function.
+ */
+typedef void (*thdpoolfunc_t)(void *arg);
+
+/**
+ * @brief   Type of a threads pool work descriptor.
+ */
+typedef struct ch_thread_pool_work {
+  /**
+   * @brief   Pending works queue link.
+   * @note    Must be the first field.
+   */
+  ch_queue_t                    queue;
+  /**
+   * @brief   Work function.
+   */
+  thdpoolfunc_t                 func;
+  /**
+   * @brief   Work function argument.
+   */
+  void                          *arg;
+} thread_pool_work_t;
+
+/**
+ * @brief   Type of a threads pool object.
+ */
+typedef struct ch_thread_pool {
+  /**
+   * @brief   Queue of the works waiting for a worker thread.
+   */
+  ch_queue_t                    pending;
+  /**
+   * @brief   Queue of the parked worker threads.
+   */
+  threads_queue_t               idle;
+  /**
+   * @brief   List of all the worker threads.
+   */
+  ch_list_t                     workers;
+  /**
+   * @brief   Heap used for the workers working areas.
+   */
+  memory_heap_t                 *heapp;
+  /**
+   * @brief   Size of the workers working areas.
+   */
+  size_t                        size;
+  /**
+   * @brief   Name of the workers.
+   */
+  const char                    *name;
+  /**
+   * @brief   Priority of the workers.
+   */
+  tprio_t                       prio;
+  /**
+   * @brief   Current number of workers.
+   */
+  cnt_t                         n;
+  /**
+   * @brief   Maximum number of workers.
+   */
+  cnt_t                         max;
+  /**
+   * @brief   Workers termination request.
+   */
+  bool                          stop;
+} thread_pool_t;
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -84,6 +172,15 @@ extern "C" {
   thread_t *chThdCreateFromMemoryPool(memory_pool_t *mp, const char *name,
                                       tprio_t prio, tfunc_t pf, void *arg);
 #endif
+#if CH_CFG_USE_THREAD_POOLS == TRUE
+  void chThdPoolObjectInit(thread_pool_t *tpp, memory_heap_t *heapp,
+                           size_t size, const char *name, tprio_t prio,
+                           cnt_t max);
+  void chThdPoolDispose(thread_pool_t *tpp);
+  cnt_t chThdPoolPreload(thread_pool_t *tpp, cnt_t n);
+  msg_t chThdPoolDispatch(thread_pool_t *tpp, thread_pool_work_t *wp,
+                          thdpoolfunc_t func, void *arg);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,21 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Event listeners grouping and source wait queues.
+ * @details If enabled then the listeners registered on an event source are
+ *          grouped by flags mask, broadcasts skip whole groups of listeners
+ *          not interested in the broadcasted flags. Event sources also
+ *          get a queue of threads waiting directly on the source, see
+ *          @p chEvtWaitSourceTimeout().
+ * @note    Registration and unregistration become O(n), broadcasting
+ *          becomes O(groups) for the not interested listeners.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_EVENTS_GROUPING) || defined(__DOXYGEN__)
+#define CH_CFG_USE_EVENTS_GROUPING          FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -69,6 +84,10 @@ struct event_listener {
                                                     by the event source.    */
   eventflags_t          wflags;         /**< @brief Flags that this listener
                                                     interested in.          */
+#if (CH_CFG_USE_EVENTS_GROUPING == TRUE) || defined(__DOXYGEN__)
+  event_listener_t      *gnext;         /**< @brief First Event Listener of
+                                                    the next group.         */
+#endif
 };
 
 /**
@@ -78,6 +97,10 @@ typedef struct event_source {
   event_listener_t      *next;          /**< @brief First Event Listener
                                                     registered on the Event
                                                     Source.                 */
+#if (CH_CFG_USE_EVENTS_GROUPING == TRUE) || defined(__DOXYGEN__)
+  threads_queue_t       waiting;        /**< @brief Threads waiting on the
+                                                    Event Source.           */
+#endif
 } event_source_t;
 
 /**
@@ -105,7 +128,12 @@ typedef void (*evhandler_t)(eventid_t id);
  *          source that is part of a bigger structure.
  * @param name          the name of the event source variable
  */
+#if (CH_CFG_USE_EVENTS_GROUPING == TRUE) || defined(__DOXYGEN__)
+#define __EVENTSOURCE_DATA(name) {(event_listener_t *)(&name),              \
+                                  __THREADS_QUEUE_DATA(name.waiting)}
+#else
 #define __EVENTSOURCE_DATA(name) {(event_listener_t *)(&name)}
+#endif
 
 /**
  * @brief   Static event source initializer.
@@ -143,6 +171,15 @@ extern "C" {
   void chEvtSignalI(thread_t *tp, eventmask_t events);
   void chEvtBroadcastFlags(event_source_t *esp, eventflags_t flags);
   void chEvtBroadcastFlagsI(event_source_t *esp, eventflags_t flags);
+#if CH_CFG_USE_EVENTS_GROUPING == TRUE
+  void chEvtBroadcastWaitingFlagsI(event_source_t *esp, eventflags_t flags);
+  msg_t chEvtWaitSourceTimeoutS(event_source_t *esp,
+                                eventflags_t *flagsp,
+                                sysinterval_t timeout);
+  msg_t chEvtWaitSourceTimeout(event_source_t *esp,
+                               eventflags_t *flagsp,
+                               sysinterval_t timeout);
+#endif
   void chEvtDispatch(const evhandler_t *handlers, eventmask_t events);
 #if (CH_CFG_OPTIMIZE_SPEED == TRUE) || (CH_CFG_USE_EVENTS_TIMEOUT == FALSE)
   eventmask_t chEvtWaitOne(eventmask_t events);
@@ -109,6 +109,9 @@ extern "C" {
   void chMtxUnlockS(mutex_t *mp);
   void chMtxUnlockAll(void);
   void chMtxUnlockAllS(void);
+#if (CH_CFG_USE_CONDVARS == TRUE) && (CH_CFG_USE_CONDVARS_MORPHING == TRUE)
+  bool __mtx_lock_thread(mutex_t *mp, thread_t *tp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -36,6 +36,19 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Condition variables wait-morphing.
+ * @details If enabled then threads signaled on a condition variable are
+ *          moved directly on the queue of the associated mutex instead of
+ *          being made ready and then contend for the mutex.
+ * @note    The setting is defined here because it affects the thread
+ *          structure.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_CONDVARS_MORPHING) || defined(__DOXYGEN__)
+#define CH_CFG_USE_CONDVARS_MORPHING        FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -346,6 +359,15 @@ struct ch_thread {
    */
   tprio_t                       realprio;
 #endif
+#if ((CH_CFG_USE_CONDVARS == TRUE) &&                                       \
+     (CH_CFG_USE_CONDVARS_MORPHING == TRUE)) || defined(__DOXYGEN__)
+  /**
+   * @brief   Condition variable wakeup message.
+   * @note    A signaled thread waiting on the mutex queue uses the @p u
+   *          field for the mutex pointer so the message is kept here.
+   */
+  msg_t                         cndmsg;
+#endif
 #if (CH_DBG_STATISTICS == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   Thread statistics.
@@ -436,6 +436,10 @@ extern "C" {
                                tprio_t prio);
 #if CH_DBG_FILL_THREADS == TRUE
   void __thd_stackfill(uint8_t *startp, uint8_t *endp);
+#endif
+#if CH_DBG_STACK_PROFILING == TRUE
+  void __thd_stackguard(uint8_t *startp, uint8_t *endp);
+  size_t chThdGetStackHighWaterX(thread_t *tp);
 #endif
   thread_t *chThdObjectInit(thread_t *tp, const thread_descriptor_t *tdp);
   void chThdObjectDispose(thread_t *tp);
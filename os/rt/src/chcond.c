@@ -63,6 +63,34 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_CONDVARS_MORPHING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Moves a signaled thread on the mutex queue.
+ * @details The thread is removed from the condition variable queue then the
+ *          mutex used by the waiting threads is locked on its behalf, if
+ *          the mutex is not owned then the thread is made ready else it
+ *          keeps sleeping on the mutex queue.
+ *
+ * @param[in] cp        pointer to a @p condition_variable_t object
+ * @param[in] msg       the wakeup message
+ * @return              The signaled thread if made ready.
+ * @retval NULL         if the thread has been queued on the mutex.
+ *
+ * @notapi
+ */
+static thread_t *cond_morph(condition_variable_t *cp, msg_t msg) {
+  thread_t *tp = threadref(ch_queue_fifo_remove(&cp->queue));
+
+  tp->cndmsg = msg;
+  if (__mtx_lock_thread(cp->mutex, tp)) {
+    tp->u.rdymsg = msg;
+    return tp;
+  }
+
+  return NULL;
+}
+#endif /* CH_CFG_USE_CONDVARS_MORPHING == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -79,6 +107,9 @@ void chCondObjectInit(condition_variable_t *cp) {
   chDbgCheck(cp != NULL);
 
   ch_queue_init(&cp->queue);
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  cp->mutex = NULL;
+#endif
 }
 
 /**
@@ -112,6 +143,9 @@ void chCondObjectDispose(condition_variable_t *cp) {
 
 /**
  * @brief   Signals one thread that is waiting on the condition variable.
+ * @note    If @p CH_CFG_USE_CONDVARS_MORPHING is enabled and the mutex is
+ *          owned then the thread is moved on the mutex queue without
+ *          being awakened.
  *
  * @param[in] cp        pointer to a @p condition_variable_t object
  *
@@ -123,7 +157,14 @@ void chCondSignal(condition_variable_t *cp) {
 
   chSysLock();
   if (ch_queue_notempty(&cp->queue)) {
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+    thread_t *tp = cond_morph(cp, MSG_OK);
+    if (tp != NULL) {
+      chSchWakeupS(tp, MSG_OK);
+    }
+#else
     chSchWakeupS(threadref(ch_queue_fifo_remove(&cp->queue)), MSG_OK);
+#endif
   }
   chSysUnlock();
 }
@@ -145,14 +186,23 @@ void chCondSignalI(condition_variable_t *cp) {
   chDbgCheck(cp != NULL);
 
   if (ch_queue_notempty(&cp->queue)) {
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+    thread_t *tp = cond_morph(cp, MSG_OK);
+    if (tp != NULL) {
+      (void) chSchReadyI(tp);
+    }
+#else
     thread_t *tp = threadref(ch_queue_fifo_remove(&cp->queue));
     tp->u.rdymsg = MSG_OK;
     (void) chSchReadyI(tp);
+#endif
   }
 }
 
 /**
  * @brief   Signals all threads that are waiting on the condition variable.
+ * @note    If @p CH_CFG_USE_CONDVARS_MORPHING is enabled then the threads
+ *          are moved on the mutex queue, at most one thread is awakened.
  *
  * @param[in] cp        pointer to a @p condition_variable_t object
  *
@@ -182,12 +232,25 @@ void chCondBroadcastI(condition_variable_t *cp) {
   chDbgCheckClassI();
   chDbgCheck(cp != NULL);
 
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  /* Empties the condition variable queue and moves all the threads on the
+     mutex queue in FIFO order, only the first thread can get the mutex if
+     it is not owned. The wakeup message is set to @p MSG_RESET in order to
+     make a chCondBroadcast() detectable from a chCondSignal().*/
+  while (ch_queue_notempty(&cp->queue)) {
+    thread_t *tp = cond_morph(cp, MSG_RESET);
+    if (tp != NULL) {
+      (void) chSchReadyI(tp);
+    }
+  }
+#else
   /* Empties the condition variable queue and inserts all the threads into the
      ready list in FIFO order. The wakeup message is set to @p MSG_RESET in
      order to make a chCondBroadcast() detectable from a chCondSignal().*/
   while (ch_queue_notempty(&cp->queue)) {
     chSchReadyI(threadref(ch_queue_fifo_remove(&cp->queue)))->u.rdymsg = MSG_RESET;
   }
+#endif
 }
 
 /**
@@ -245,6 +308,20 @@ msg_t chCondWaitS(condition_variable_t *cp) {
   /* Releasing "current" mutex.*/
   chMtxUnlockS(mp);
 
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  chDbgAssert(ch_queue_isempty(&cp->queue) || (cp->mutex == mp),
+              "different mutex");
+  cp->mutex = mp;
+
+  /* Start waiting on the condition variable, the signaling thread takes
+     the mutex on behalf of this thread.*/
+  currtp->u.wtobjp = cp;
+  ch_sch_prio_insert(&cp->queue, &currtp->hdr.queue);
+  chSchGoSleepS(CH_STATE_WTCOND);
+  msg = currtp->cndmsg;
+
+  chDbgAssert(mp->owner == currtp, "not owner");
+#else
   /* Start waiting on the condition variable, on exit the mutex is taken
      again.*/
   currtp->u.wtobjp = cp;
@@ -252,6 +329,7 @@ msg_t chCondWaitS(condition_variable_t *cp) {
   chSchGoSleepS(CH_STATE_WTCOND);
   msg = currtp->u.rdymsg;
   chMtxLockS(mp);
+#endif
 
   return msg;
 }
@@ -333,6 +411,21 @@ msg_t chCondWaitTimeoutS(condition_variable_t *cp, sysinterval_t timeout) {
   /* Releasing "current" mutex.*/
   chMtxUnlockS(mp);
 
+#if CH_CFG_USE_CONDVARS_MORPHING == TRUE
+  chDbgAssert(ch_queue_isempty(&cp->queue) || (cp->mutex == mp),
+              "different mutex");
+  cp->mutex = mp;
+
+  /* Start waiting on the condition variable, the signaling thread takes
+     the mutex on behalf of this thread. A timeout is ignored after the
+     thread has been moved on the mutex queue.*/
+  currtp->u.wtobjp = cp;
+  ch_sch_prio_insert(&cp->queue, &currtp->hdr.queue);
+  msg = chSchGoSleepTimeoutS(CH_STATE_WTCOND, timeout);
+  if (mp->owner == currtp) {
+    msg = currtp->cndmsg;
+  }
+#else
   /* Start waiting on the condition variable, on exit the mutex is taken
      again.*/
   currtp->u.wtobjp = cp;
@@ -341,6 +434,7 @@ msg_t chCondWaitTimeoutS(condition_variable_t *cp, sysinterval_t timeout) {
   if (msg != MSG_TIMEOUT) {
     chMtxLockS(mp);
   }
+#endif
 
   return msg;
 }
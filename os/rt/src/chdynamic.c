@@ -34,6 +34,14 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Size of the worker record preceding the working area.
+ */
+#define THD_POOL_WORKER_SIZE                                                \
+  MEM_ALIGN_NEXT(sizeof (thd_pool_worker_t), PORT_WORKING_AREA_ALIGN)
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -42,6 +50,25 @@
 /* Module local types.                                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Threads pool worker record.
+ * @note    The record is allocated together with the worker working area
+ *          and placed just below it.
+ */
+typedef struct {
+  /**
+   * @brief   Pool workers list link.
+   * @note    Must be the first field.
+   */
+  ch_list_t                     list;
+  /**
+   * @brief   Worker thread.
+   */
+  thread_t                      *tp;
+} thd_pool_worker_t;
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 /*===========================================================================*/
 /* Module local variables.                                                   */
 /*===========================================================================*/
@@ -64,6 +91,86 @@ static void thd_poolfree(thread_t *tp) {
 }
 #endif /* CH_CFG_USE_MEMPOOLS == TRUE */
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+static void thd_pool_workerfree(thread_t *tp) {
+
+  chHeapFree((void *)((uint8_t *)tp->wabase - THD_POOL_WORKER_SIZE));
+}
+
+static THD_FUNCTION(thd_pool_worker, arg) {
+  thread_pool_t *tpp = (thread_pool_t *)arg;
+
+  chSysLock();
+  while (!tpp->stop) {
+    thread_pool_work_t *wp;
+    thdpoolfunc_t func;
+    void *funcarg;
+
+    /* Parking until there is some work to do.*/
+    if (ch_queue_isempty(&tpp->pending)) {
+      (void) chThdEnqueueTimeoutS(&tpp->idle, TIME_INFINITE);
+      continue;
+    }
+
+    /* The descriptor is no more accessed after being removed from the
+       pending queue, the work function can reuse or release it.*/
+    wp      = (thread_pool_work_t *)ch_queue_fifo_remove(&tpp->pending);
+    func    = wp->func;
+    funcarg = wp->arg;
+    chSysUnlock();
+
+    func(funcarg);
+
+    chSysLock();
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Adds a parked worker to a threads pool.
+ * @note    The worker slot must have been already reserved by incrementing
+ *          the workers counter.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t object
+ * @return              The operation status.
+ * @retval false        if the memory cannot be allocated.
+ * @retval true         if the worker has been created.
+ *
+ * @notapi
+ */
+static bool thd_pool_spawn(thread_pool_t *tpp) {
+  thd_pool_worker_t *wkp;
+  thread_t *tp;
+  void *wbase, *wend;
+
+  wkp = chHeapAllocAligned(tpp->heapp, THD_POOL_WORKER_SIZE + tpp->size,
+                           PORT_WORKING_AREA_ALIGN);
+  if (wkp == NULL) {
+    return false;
+  }
+  wbase = (void *)((uint8_t *)wkp + THD_POOL_WORKER_SIZE);
+  wend  = (void *)((uint8_t *)wbase + tpp->size);
+
+  thread_descriptor_t td = __THD_DECL_DATA(tpp->name, wbase, wend, tpp->prio,
+                                           thd_pool_worker, (void *)tpp,
+                                           NULL);
+
+#if CH_DBG_FILL_THREADS == TRUE
+  __thd_stackfill((uint8_t *)wbase, (uint8_t *)wend);
+#endif
+
+  chSysLock();
+  tp = chThdCreateSuspendedI(&td);
+  chThdSetCallbackX(tp, thd_pool_workerfree, NULL);
+  wkp->tp = tp;
+  ch_list_link(&tpp->workers, &wkp->list);
+  chSchWakeupS(tp, MSG_OK);
+  chSysUnlock();
+
+  return true;
+}
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -179,6 +286,190 @@ thread_t *chThdCreateFromMemoryPool(memory_pool_t *mp, const char *name,
 }
 #endif /* CH_CFG_USE_MEMPOOLS == TRUE */
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a threads pool object.
+ * @details The pool starts with no workers, workers are created on demand
+ *          or using @p chThdPoolPreload() and, once created, are never
+ *          released until the pool is disposed. Workers that completed
+ *          their work are parked and reused for the next works, this
+ *          saves the allocation, initialization and release costs of
+ *          dynamic threads.
+ * @pre     The configuration option @p CH_CFG_USE_THREAD_POOLS must be
+ *          enabled in order to use this function.
+ *
+ * @param[out] tpp      pointer to a @p thread_pool_t object
+ * @param[in] heapp     heap from which allocate the workers memory or
+ *                      @p NULL for the default heap
+ * @param[in] size      size of the workers working areas
+ * @param[in] name      name of the workers
+ * @param[in] prio      the priority level of the workers
+ * @param[in] max       maximum number of workers, it bounds the growth of
+ *                      the pool
+ *
+ * @init
+ */
+void chThdPoolObjectInit(thread_pool_t *tpp, memory_heap_t *heapp,
+                         size_t size, const char *name, tprio_t prio,
+                         cnt_t max) {
+
+  chDbgCheck((tpp != NULL) && (size >= THD_WORKING_AREA_SIZE(0)) &&
+             (prio <= HIGHPRIO) && (max > (cnt_t)0));
+
+  ch_queue_init(&tpp->pending);
+  chThdQueueObjectInit(&tpp->idle);
+  ch_list_init(&tpp->workers);
+  tpp->heapp = heapp;
+  tpp->size  = size;
+  tpp->name  = name;
+  tpp->prio  = prio;
+  tpp->n     = (cnt_t)0;
+  tpp->max   = max;
+  tpp->stop  = false;
+}
+
+/**
+ * @brief   Disposes a threads pool object.
+ * @details All the workers are terminated and their memory is returned to
+ *          the heap, workers executing a work are waited for.
+ * @pre     There must be no pending works.
+ * @note    Must not be invoked by a worker of the same pool.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t object
+ *
+ * @api
+ */
+void chThdPoolDispose(thread_pool_t *tpp) {
+
+  chDbgCheck(tpp != NULL);
+
+  chSysLock();
+  chDbgAssert(ch_queue_isempty(&tpp->pending), "pending works");
+
+  tpp->stop = true;
+  chThdDequeueAllI(&tpp->idle, MSG_RESET);
+  chSchRescheduleS();
+
+  while (ch_list_notempty(&tpp->workers)) {
+    thd_pool_worker_t *wkp;
+    thread_t *tp;
+
+    wkp = (thd_pool_worker_t *)ch_list_unlink(&tpp->workers);
+    tp  = wkp->tp;
+
+    /* The worker record is released together with the working area so it
+       must not be accessed after waiting.*/
+    chSysUnlock();
+    (void) chThdWait(tp);
+    chSysLock();
+  }
+  tpp->n = (cnt_t)0;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Creates parked workers in advance.
+ * @details Workers are created until the pool contains at least @p n
+ *          workers, the pool maximum is not exceeded.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t object
+ * @param[in] n         number of workers to be made available
+ * @return              The number of workers in the pool.
+ *
+ * @api
+ */
+cnt_t chThdPoolPreload(thread_pool_t *tpp, cnt_t n) {
+  cnt_t count;
+
+  chDbgCheck(tpp != NULL);
+
+  chSysLock();
+  while ((tpp->n < n) && (tpp->n < tpp->max)) {
+
+    /* Reserving the slot before allocating.*/
+    tpp->n++;
+    chSysUnlock();
+    if (!thd_pool_spawn(tpp)) {
+      chSysLock();
+      tpp->n--;
+      break;
+    }
+    chSysLock();
+  }
+  count = tpp->n;
+  chSysUnlock();
+
+  return count;
+}
+
+/**
+ * @brief   Dispatches a work to a threads pool.
+ * @details The work is queued then a parked worker is awakened in order to
+ *          execute it. If there are no parked workers then a new worker is
+ *          created unless the pool already reached its maximum size, in
+ *          that case the work is executed by the first worker completing
+ *          its current work.
+ * @note    The work descriptor must stay valid until the work function
+ *          is invoked.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t object
+ * @param[out] wp       pointer to a @p thread_pool_work_t descriptor
+ * @param[in] func      the work function
+ * @param[in] arg       an argument to be passed to the work function. It
+ *                      can be @p NULL.
+ * @return              The operation status.
+ * @retval MSG_OK       if the work has been queued.
+ * @retval MSG_RESET    if the pool has no workers and a worker cannot be
+ *                      created, the work has not been queued.
+ *
+ * @api
+ */
+msg_t chThdPoolDispatch(thread_pool_t *tpp, thread_pool_work_t *wp,
+                        thdpoolfunc_t func, void *arg) {
+
+  chDbgCheck((tpp != NULL) && (wp != NULL) && (func != NULL));
+
+  wp->func = func;
+  wp->arg  = arg;
+
+  chSysLock();
+  chDbgAssert(!tpp->stop, "disposed");
+
+  ch_queue_insert(&tpp->pending, &wp->queue);
+
+  /* Handing the work to a parked worker, if any, the last parked worker
+     is preferred because its stack is more likely to be cached.*/
+  if (!chThdQueueIsEmptyI(&tpp->idle)) {
+    chSchWakeupS(threadref(ch_queue_lifo_remove(&tpp->idle.queue)), MSG_OK);
+    chSysUnlock();
+
+    return MSG_OK;
+  }
+
+  /* Bounded growth, a busy pool just queues the work.*/
+  if (tpp->n < tpp->max) {
+    tpp->n++;
+    chSysUnlock();
+    if (thd_pool_spawn(tpp)) {
+      return MSG_OK;
+    }
+    chSysLock();
+    tpp->n--;
+
+    /* Without workers the work would never be executed.*/
+    if (tpp->n == (cnt_t)0) {
+      (void) ch_queue_dequeue(&wp->queue);
+      chSysUnlock();
+
+      return MSG_RESET;
+    }
+  }
+  chSysUnlock();
+
+  return MSG_OK;
+}
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 #endif /* CH_CFG_USE_DYNAMIC == TRUE */
 
 /** @} */
@@ -83,6 +83,31 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_EVENTS_GROUPING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Wakes up all the threads waiting on an event source.
+ * @details The flags are written in the variable specified by each waiting
+ *          thread, a thread only receives the first broadcast after it
+ *          started waiting.
+ *
+ * @param[in] esp       pointer to an @p event_source_t object
+ * @param[in] flags     the flags to be passed to the waiting threads
+ *
+ * @notapi
+ */
+static void evt_wakeup_waiting(event_source_t *esp, eventflags_t flags) {
+
+  while (ch_queue_notempty(&esp->waiting.queue)) {
+    thread_t *tp = threadref(esp->waiting.queue.next);
+
+    /* The pointer to the flags variable is stored in the thread while it
+       is queued, it is overwritten by the wakeup message.*/
+    *(eventflags_t *)tp->u.wtobjp = flags;
+    chThdDoDequeueNextI(&esp->waiting, MSG_OK);
+  }
+}
+#endif /* CH_CFG_USE_EVENTS_GROUPING == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -101,6 +126,9 @@ void chEvtObjectInit(event_source_t *esp) {
   chDbgCheck(esp != NULL);
 
   esp->next = (event_listener_t *)esp;
+#if CH_CFG_USE_EVENTS_GROUPING == TRUE
+  chThdQueueObjectInit(&esp->waiting);
+#endif
 }
 
 /**
@@ -122,6 +150,9 @@ void chEvtObjectDispose(event_source_t *esp) {
 
   chDbgCheck(esp != NULL);
   chDbgAssert(esp->next == (event_listener_t *)esp, "object in use");
+#if CH_CFG_USE_EVENTS_GROUPING == TRUE
+  chDbgAssert(ch_queue_isempty(&esp->waiting.queue), "object in use");
+#endif
 
 #if CH_CFG_HARDENING_LEVEL > 0
   memset((void *)esp, 0, sizeof (event_source_t));
@@ -134,6 +165,9 @@ void chEvtObjectDispose(event_source_t *esp) {
  *          will be notified of all events broadcasted there.
  * @note    Multiple Event Listeners can specify the same bits to be ORed to
  *          different threads.
+ * @note    If @p CH_CFG_USE_EVENTS_GROUPING is enabled then the listener
+ *          is appended to the group of listeners with the same flags mask,
+ *          this requires scanning the groups registered on the source.
  *
  * @param[in] esp       pointer to an @p event_source_t object
  * @param[in] elp       pointer to an @p event_listener_t structure
@@ -152,8 +186,40 @@ void chEvtRegisterMaskWithFlagsI(event_source_t *esp,
   chDbgCheckClassI();
   chDbgCheck((esp != NULL) && (elp != NULL));
 
+#if CH_CFG_USE_EVENTS_GROUPING == TRUE
+  {
+    /*lint -save -e9087 -e740 [11.3, 1.3] Cast required by list handling.*/
+    event_listener_t *p = esp->next;
+
+    /* Searching for a group with the same flags mask.*/
+    while ((p != (event_listener_t *)esp) && (p->wflags != wflags)) {
+    /*lint -restore*/
+      p = p->gnext;
+    }
+
+    /*lint -save -e9087 -e740 [11.3, 1.3] Cast required by list handling.*/
+    if (p != (event_listener_t *)esp) {
+    /*lint -restore*/
+      /* Appending at the end of the group, the links to the group head
+         from the previous group remain valid.*/
+      while (p->next != p->gnext) {
+        p = p->next;
+      }
+      elp->next  = p->next;
+      elp->gnext = p->gnext;
+      p->next    = elp;
+    }
+    else {
+      /* New group on top of the list.*/
+      elp->next  = esp->next;
+      elp->gnext = esp->next;
+      esp->next  = elp;
+    }
+  }
+#else
   elp->next     = esp->next;
   esp->next     = elp;
+#endif
   elp->listener = currtp;
   elp->events   = events;
   elp->flags    = (eventflags_t)0;
@@ -192,6 +258,8 @@ void chEvtRegisterMaskWithFlags(event_source_t *esp,
  * @note    For optimal performance it is better to perform the unregister
  *          operations in inverse order of the register operations (elements
  *          are found on top of the list).
+ * @note    If @p CH_CFG_USE_EVENTS_GROUPING is enabled then the whole list
+ *          is always scanned in order to update the groups links.
  *
  * @param[in] esp       pointer to an @p event_source_t object
  * @param[in] elp       pointer to an @p event_listener_t structure
@@ -212,9 +280,23 @@ void chEvtUnregister(event_source_t *esp, event_listener_t *elp) {
   /*lint -restore*/
     if (p->next == elp) {
       p->next = elp->next;
+#if CH_CFG_USE_EVENTS_GROUPING == FALSE
       break;
+#endif
     }
+#if CH_CFG_USE_EVENTS_GROUPING == TRUE
+    else {
+      p = p->next;
+
+      /* Links to the removed group head are moved to the next element,
+         it is either the new group head or the next group.*/
+      if (p->gnext == elp) {
+        p->gnext = elp->next;
+      }
+    }
+#else
     p = p->next;
+#endif
   }
   chSysUnlock();
 }
@@ -381,6 +463,12 @@ void chEvtSignal(thread_t *tp, eventmask_t events) {
  *          interrupt handlers always reschedule on exit so an explicit
  *          reschedule must not be performed in ISRs.
  *
+ * @note    If @p CH_CFG_USE_EVENTS_GROUPING is enabled then the threads
+ *          waiting on the source are woken up first, then the groups of
+ *          listeners not interested in the flags are skipped entirely. The
+ *          flags are not accumulated in skipped listeners, those would be
+ *          masked by @p chEvtGetAndClearFlags() anyway.
+ *
  * @param[in] esp       pointer to an @p event_source_t object
  * @param[in] flags     the flags set to be added to the listener flags mask
  *
@@ -392,10 +480,27 @@ void chEvtBroadcastFlagsI(event_source_t *esp, eventflags_t flags) {
   chDbgCheckClassI();
   chDbgCheck(esp != NULL);
 
+#if CH_CFG_USE_EVENTS_GROUPING == TRUE
+  evt_wakeup_waiting(esp, flags);
+#endif
+
   elp = esp->next;
   /*lint -save -e9087 -e740 [11.3, 1.3] Cast required by list handling.*/
   while (elp != (event_listener_t *)esp) {
   /*lint -restore*/
+#if CH_CFG_USE_EVENTS_GROUPING == TRUE
+    /* All the listeners in a group share the same flags mask so the test
+       result is the same for the whole group.*/
+    if ((flags == (eventflags_t)0) ||
+        ((flags & elp->wflags) != (eventflags_t)0)) {
+      elp->flags |= flags;
+      chEvtSignalI(elp->listener, elp->events);
+      elp = elp->next;
+    }
+    else {
+      elp = elp->gnext;
+    }
+#else
     elp->flags |= flags;
     /* When flags == 0 the thread will always be signaled because the
        source does not emit any flag.*/
@@ -404,6 +509,7 @@ void chEvtBroadcastFlagsI(event_source_t *esp, eventflags_t flags) {
       chEvtSignalI(elp->listener, elp->events);
     }
     elp = elp->next;
+#endif
   }
 }
 
@@ -428,6 +534,95 @@ void chEvtBroadcastFlags(event_source_t *esp, eventflags_t flags) {
   chSysUnlock();
 }
 
+#if (CH_CFG_USE_EVENTS_GROUPING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Signals the threads waiting on the specified Event Source.
+ * @details The flags are passed to the threads waiting using
+ *          @p chEvtWaitSourceTimeout(), the registered listeners are not
+ *          signaled. The cost of the operation only depends on the number
+ *          of waiting threads.
+ * @post    This function does not reschedule so a call to a rescheduling
+ *          function must be performed before unlocking the kernel. Note that
+ *          interrupt handlers always reschedule on exit so an explicit
+ *          reschedule must not be performed in ISRs.
+ *
+ * @param[in] esp       pointer to an @p event_source_t object
+ * @param[in] flags     the flags to be passed to the waiting threads
+ *
+ * @iclass
+ */
+void chEvtBroadcastWaitingFlagsI(event_source_t *esp, eventflags_t flags) {
+
+  chDbgCheckClassI();
+  chDbgCheck(esp != NULL);
+
+  evt_wakeup_waiting(esp, flags);
+}
+
+/**
+ * @brief   Waits for a broadcast on the specified Event Source.
+ * @details The calling thread is queued on the event source without
+ *          registering a listener, the flags of the first broadcast
+ *          happening after the call are returned.
+ *
+ * @param[in] esp       pointer to an @p event_source_t object
+ * @param[out] flagsp   pointer to a variable receiving the broadcasted flags
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The wakeup message.
+ * @retval MSG_OK       if a broadcast has been received.
+ * @retval MSG_TIMEOUT  if the timeout expired.
+ *
+ * @sclass
+ */
+msg_t chEvtWaitSourceTimeoutS(event_source_t *esp,
+                              eventflags_t *flagsp,
+                              sysinterval_t timeout) {
+
+  chDbgCheckClassS();
+  chDbgCheck((esp != NULL) && (flagsp != NULL));
+
+  /* The broadcaster writes the flags through the wait object pointer.*/
+  chThdGetSelfX()->u.wtobjp = (void *)flagsp;
+
+  return chThdEnqueueTimeoutS(&esp->waiting, timeout);
+}
+
+/**
+ * @brief   Waits for a broadcast on the specified Event Source.
+ * @details The calling thread is queued on the event source without
+ *          registering a listener, the flags of the first broadcast
+ *          happening after the call are returned.
+ *
+ * @param[in] esp       pointer to an @p event_source_t object
+ * @param[out] flagsp   pointer to a variable receiving the broadcasted flags
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The wakeup message.
+ * @retval MSG_OK       if a broadcast has been received.
+ * @retval MSG_TIMEOUT  if the timeout expired.
+ *
+ * @api
+ */
+msg_t chEvtWaitSourceTimeout(event_source_t *esp,
+                             eventflags_t *flagsp,
+                             sysinterval_t timeout) {
+  msg_t msg;
+
+  chSysLock();
+  msg = chEvtWaitSourceTimeoutS(esp, flagsp, timeout);
+  chSysUnlock();
+
+  return msg;
+}
+#endif /* CH_CFG_USE_EVENTS_GROUPING == TRUE */
+
 /**
  * @brief   Invokes the event handlers associated to an event flags mask.
  *
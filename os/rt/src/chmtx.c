@@ -91,6 +91,69 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Priority inheritance protocol.
+ * @details Explores the thread-mutex dependencies boosting the priority of
+ *          all the affected threads to equal the specified priority.
+ *
+ * @param[in] tp        the mutex owner thread
+ * @param[in] prio      priority of the thread requesting the mutex
+ *
+ * @notapi
+ */
+static void mtx_boost_owners(thread_t *tp, tprio_t prio) {
+
+  /* Does the requesting thread have higher priority than the mutex
+     owning thread? */
+  while (tp->hdr.pqueue.prio < prio) {
+    /* Make priority of thread tp match the requesting thread's priority.*/
+    tp->hdr.pqueue.prio = prio;
+
+    /* The following states need priority queues reordering.*/
+    switch (tp->state) {
+    case CH_STATE_WTMTX:
+      /* Re-enqueues the mutex owner with its new priority.*/
+      ch_sch_prio_insert(&tp->u.wtmtxp->queue,
+                         ch_queue_dequeue(&tp->hdr.queue));
+      tp = tp->u.wtmtxp->owner;
+      /*lint -e{9042} [16.1] Continues the while.*/
+      continue;
+#if (CH_CFG_USE_CONDVARS == TRUE) ||                                        \
+    ((CH_CFG_USE_SEMAPHORES == TRUE) &&                                     \
+     (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)) ||                           \
+    ((CH_CFG_USE_MESSAGES == TRUE) &&                                       \
+     (CH_CFG_USE_MESSAGES_PRIORITY == TRUE))
+#if CH_CFG_USE_CONDVARS == TRUE
+    case CH_STATE_WTCOND:
+#endif
+#if (CH_CFG_USE_SEMAPHORES == TRUE) &&                                      \
+    (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)
+    case CH_STATE_WTSEM:
+#endif
+#if (CH_CFG_USE_MESSAGES == TRUE) && (CH_CFG_USE_MESSAGES_PRIORITY == TRUE)
+    case CH_STATE_SNDMSGQ:
+#endif
+      /* Re-enqueues tp with its new priority on the queue.*/
+      ch_sch_prio_insert(&tp->u.wtmtxp->queue,
+                         ch_queue_dequeue(&tp->hdr.queue));
+      break;
+#endif
+    case CH_STATE_READY:
+#if CH_DBG_ENABLE_ASSERTS == TRUE
+      /* Prevents an assertion in chSchReadyI().*/
+      tp->state = CH_STATE_CURRENT;
+#endif
+      /* Re-enqueues tp with its new priority on the ready list.*/
+      (void) chSchReadyI(threadref(ch_queue_dequeue(&tp->hdr.queue)));
+      break;
+    default:
+      /* Nothing to do for other states.*/
+      break;
+    }
+    break;
+  }
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -192,57 +255,7 @@ void chMtxLockS(mutex_t *mp) {
       /* Priority inheritance protocol; explores the thread-mutex dependencies
          boosting the priority of all the affected threads to equal the
          priority of the running thread requesting the mutex.*/
-      thread_t *tp = mp->owner;
-
-      /* Does the running thread have higher priority than the mutex
-         owning thread? */
-      while (tp->hdr.pqueue.prio < currtp->hdr.pqueue.prio) {
-        /* Make priority of thread tp match the running thread's priority.*/
-        tp->hdr.pqueue.prio = currtp->hdr.pqueue.prio;
-
-        /* The following states need priority queues reordering.*/
-        switch (tp->state) {
-        case CH_STATE_WTMTX:
-          /* Re-enqueues the mutex owner with its new priority.*/
-          ch_sch_prio_insert(&tp->u.wtmtxp->queue,
-                             ch_queue_dequeue(&tp->hdr.queue));
-          tp = tp->u.wtmtxp->owner;
-          /*lint -e{9042} [16.1] Continues the while.*/
-          continue;
-#if (CH_CFG_USE_CONDVARS == TRUE) ||                                        \
-    ((CH_CFG_USE_SEMAPHORES == TRUE) &&                                     \
-     (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)) ||                           \
-    ((CH_CFG_USE_MESSAGES == TRUE) &&                                       \
-     (CH_CFG_USE_MESSAGES_PRIORITY == TRUE))
-#if CH_CFG_USE_CONDVARS == TRUE
-        case CH_STATE_WTCOND:
-#endif
-#if (CH_CFG_USE_SEMAPHORES == TRUE) &&                                      \
-    (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)
-        case CH_STATE_WTSEM:
-#endif
-#if (CH_CFG_USE_MESSAGES == TRUE) && (CH_CFG_USE_MESSAGES_PRIORITY == TRUE)
-        case CH_STATE_SNDMSGQ:
-#endif
-          /* Re-enqueues tp with its new priority on the queue.*/
-          ch_sch_prio_insert(&tp->u.wtmtxp->queue,
-                             ch_queue_dequeue(&tp->hdr.queue));
-          break;
-#endif
-        case CH_STATE_READY:
-#if CH_DBG_ENABLE_ASSERTS == TRUE
-          /* Prevents an assertion in chSchReadyI().*/
-          tp->state = CH_STATE_CURRENT;
-#endif
-          /* Re-enqueues tp with its new priority on the ready list.*/
-          (void) chSchReadyI(threadref(ch_queue_dequeue(&tp->hdr.queue)));
-          break;
-        default:
-          /* Nothing to do for other states.*/
-          break;
-        }
-        break;
-      }
+      mtx_boost_owners(mp->owner, currtp->hdr.pqueue.prio);
 
       /* Sleep on the mutex.*/
       ch_sch_prio_insert(&mp->queue, &currtp->hdr.queue);
@@ -569,6 +582,56 @@ void chMtxUnlockAll(void) {
   chSysUnlock();
 }
 
+#if ((CH_CFG_USE_CONDVARS == TRUE) &&                                       \
+     (CH_CFG_USE_CONDVARS_MORPHING == TRUE)) || defined(__DOXYGEN__)
+/**
+ * @brief   Locks a mutex on behalf of a sleeping thread.
+ * @details If the mutex is not owned then it is assigned to the thread,
+ *          else the thread is queued on the mutex in @p CH_STATE_WTMTX state
+ *          and the priority inheritance protocol is applied as if the
+ *          thread invoked @p chMtxLockS().
+ * @pre     The thread must not be inserted in any queue.
+ * @post    If the mutex has been assigned then the thread is still sleeping,
+ *          it is responsibility of the caller to make it ready.
+ * @post    This function does not reschedule.
+ *
+ * @param[in] mp        pointer to a @p mutex_t object
+ * @param[in] tp        pointer to the sleeping thread
+ * @return              The operation status.
+ * @retval true         if the mutex has been assigned to the thread.
+ * @retval false        if the thread has been queued on the mutex.
+ *
+ * @notapi
+ */
+bool __mtx_lock_thread(mutex_t *mp, thread_t *tp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((mp != NULL) && (tp != NULL));
+  chDbgAssert(mp->owner != tp, "already owner");
+
+  if (mp->owner != NULL) {
+    mtx_boost_owners(mp->owner, tp->hdr.pqueue.prio);
+
+    ch_sch_prio_insert(&mp->queue, &tp->hdr.queue);
+    tp->state = CH_STATE_WTMTX;
+    tp->u.wtmtxp = mp;
+
+    return false;
+  }
+
+#if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
+  chDbgAssert(mp->cnt == (cnt_t)0, "counter is not zero");
+
+  mp->cnt++;
+#endif
+  mp->owner = tp;
+  mp->next = tp->mtxlist;
+  tp->mtxlist = mp;
+
+  return true;
+}
+#endif /* CH_CFG_USE_CONDVARS_MORPHING == TRUE */
+
 #endif /* CH_CFG_USE_MUTEXES == TRUE */
 
 /** @} */
@@ -217,6 +217,16 @@ static void __sch_wakeup(virtual_timer_t *vtp, void *p) {
     /* States requiring dequeuing.*/
     (void) ch_queue_dequeue(&tp->hdr.queue);
     break;
+#if (CH_CFG_USE_CONDVARS == TRUE) &&                                        \
+    (CH_CFG_USE_CONDVARS_TIMEOUT == TRUE) &&                                \
+    (CH_CFG_USE_CONDVARS_MORPHING == TRUE)
+  case CH_STATE_WTMTX:
+    /* Only condition variable waiters moved on a mutex queue can be in this
+       state with a timeout, the thread has been signaled before the timeout
+       so it is ignored.*/
+    chSysUnlockFromISR();
+    return;
+#endif
   default:
     /* Any other state, nothing to do.*/
     break;
@@ -65,6 +65,18 @@
 #define thd_clear(tdp)
 #endif
 
+#if CH_DBG_STACK_PROFILING == TRUE
+/**
+ * @brief   Value of a stack guard word.
+ */
+#define THD_STACK_GUARD     ((uint32_t)CH_DBG_STACK_FILL_VALUE * 0x01010101U)
+
+/**
+ * @brief   Offset of the stack guard word following the one at @p o.
+ */
+#define thd_guard_next(o)   ((o) == 0U ? sizeof (uint32_t) : (o) * 2U)
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -102,6 +114,28 @@ void __thd_stackfill(uint8_t *startp, uint8_t *endp) {
 }
 #endif /* CH_DBG_FILL_THREADS */
 
+#if (CH_DBG_STACK_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Stack guards placement utility.
+ * @details Guard words are written at the stack base and then at offsets
+ *          doubling from there, the number of writes is logarithmic with
+ *          the stack size.
+ *
+ * @param[in] startp    stack base address
+ * @param[in] endp      stack top address +1
+ *
+ * @notapi
+ */
+void __thd_stackguard(uint8_t *startp, uint8_t *endp) {
+  size_t offset = 0U;
+
+  while ((size_t)(endp - startp) >= offset + sizeof (uint32_t)) {
+    *(uint32_t *)(void *)(startp + offset) = THD_STACK_GUARD;
+    offset = thd_guard_next(offset);
+  }
+}
+#endif /* CH_DBG_STACK_PROFILING */
+
 /**
  * @brief   Thread object initialization.
  * @note    This function does not create a fully initialized thread, do
@@ -257,6 +291,11 @@ thread_t *chThdSpawnSuspendedI(thread_t *tp,
   /* Thread object initialization.*/
   tp = chThdObjectInit(tp, tdp);
 
+#if CH_DBG_STACK_PROFILING == TRUE
+  /* Stack guards, the topmost ones are overwritten by the context.*/
+  __thd_stackguard((uint8_t *)tp->wabase, (uint8_t *)tp->waend);
+#endif
+
   /* Setting up the port-dependent part of the working area.*/
   PORT_SETUP_CONTEXT(tp, tp->wabase, tp->waend, tdp->funcp, tdp->arg);
 
@@ -402,6 +441,11 @@ thread_t *chThdCreateSuspendedI(const thread_descriptor_t *tdp) {
   /* The thread object is initialized but not started.*/
   tp = chThdObjectInit(threadref(stktop), tdp);
 
+#if CH_DBG_STACK_PROFILING == TRUE
+  /* Stack guards, the topmost ones are overwritten by the context.*/
+  __thd_stackguard(stkbase, stktop);
+#endif
+
   /* Setting up the port-dependent part of the working area.*/
   PORT_SETUP_CONTEXT(tp, stkbase, tp, tdp->funcp, tdp->arg);
 
@@ -565,6 +609,11 @@ thread_t *chThdCreateStatic(stkline_t *wbase, size_t wsize,
   THD_DESC_DECL(desc, "noname", wbase, wend, prio, func, arg, currcore, NULL);
   tp = chThdObjectInit(threadref(stktop), &desc);
 
+#if CH_DBG_STACK_PROFILING == TRUE
+  /* Stack guards, the topmost ones are overwritten by the context.*/
+  __thd_stackguard(stkbase, stktop);
+#endif
+
   /* Setting up the port-dependent part of the working area.*/
   PORT_SETUP_CONTEXT(tp, wbase, tp, func, arg);
 
@@ -667,6 +716,51 @@ void chThdRelease(thread_t *tp) {
 }
 #endif /* CH_CFG_USE_REGISTRY == TRUE */
 
+#if (CH_DBG_STACK_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns an estimate of the stack high-water mark of a thread.
+ * @details The stack guards are scanned starting from the stack base, the
+ *          first overwritten guard bounds the deepest stack position ever
+ *          reached by the thread. The returned value is an upper bound of
+ *          the stack usage, the accuracy improves as the usage approaches
+ *          the stack size, which is the interesting case for stack sizing.
+ * @note    The estimate is only meaningful for threads whose stack guards
+ *          have been placed at creation or, for the main thread, if the
+ *          startup code fills the stack with the same pattern.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The estimated maximum stack usage in bytes, if it
+ *                      is equal to the stack size then the stack could
+ *                      have overflowed.
+ *
+ * @xclass
+ */
+size_t chThdGetStackHighWaterX(thread_t *tp) {
+  uint8_t *stkbase, *stktop;
+  size_t offset, unused;
+
+  /* The thread structure is at the top of the stack area for threads
+     created inside a working area, spawned threads have it outside.*/
+  stkbase = (uint8_t *)tp->wabase;
+  stktop  = (uint8_t *)tp->waend;
+  if (((uint8_t *)tp >= stkbase) && ((uint8_t *)tp < stktop)) {
+    stktop = (uint8_t *)tp;
+  }
+
+  offset = 0U;
+  unused = 0U;
+  while ((size_t)(stktop - stkbase) >= offset + sizeof (uint32_t)) {
+    if (*(uint32_t *)(void *)(stkbase + offset) != THD_STACK_GUARD) {
+      break;
+    }
+    unused = offset + sizeof (uint32_t);
+    offset = thd_guard_next(offset);
+  }
+
+  return (size_t)(stktop - stkbase) - unused;
+}
+#endif /* CH_DBG_STACK_PROFILING == TRUE */
+
 /**
  * @brief   Terminates the current thread.
  * @details The thread goes in the @p CH_STATE_FINAL state holding the
@@ -0,0 +1,384 @@
+/*
+    ChibiOS - Copyright (C) 2006,2007,2008,2009,2010,2011,2012,2013,2014,
+              2015,2016,2017,2018,2019,2020,2021,2022 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    sb/common/sbring.h
+ * @brief   ARM SandBox shared memory rings macros and structures.
+ * @details A ring is a single producer, single consumer byte FIFO placed
+ *          in memory accessible to both the sandbox and the host. Each
+ *          index is written by one side only, the wait flags tell the
+ *          other side that a doorbell is required, so doorbells are only
+ *          rung when the consumer found the ring empty or the producer
+ *          found it full.
+ * @note    This module only depends on the C library.
+ *
+ * @addtogroup ARM_SANDBOX_RING
+ * @{
+ */
+
+#ifndef SBRING_H
+#define SBRING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Returned when the ring indexes are not consistent.
+ */
+#define SB_RING_FAULT                       ((int32_t)-1)
+
+/**
+ * @brief   Maximum size of a ring buffer.
+ */
+#define SB_RING_MAX_SIZE                    0x40000000U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Memory barrier between data and indexes accesses.
+ */
+#if !defined(SB_RING_BARRIER) || defined(__DOXYGEN__)
+#define SB_RING_BARRIER()                   __sync_synchronize()
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a ring header in shared memory.
+ * @note    The ring buffer immediately follows the header.
+ */
+typedef struct sb_ring {
+  /**
+   * @brief   Write index, free running, written by the producer only.
+   */
+  volatile uint32_t             wrptr;
+  /**
+   * @brief   Producer waiting for space, written by the producer only.
+   */
+  volatile uint32_t             wrwait;
+  /**
+   * @brief   Read index, free running, written by the consumer only.
+   */
+  volatile uint32_t             rdptr;
+  /**
+   * @brief   Consumer waiting for data, written by the consumer only.
+   */
+  volatile uint32_t             rdwait;
+} sb_ring_t;
+
+/**
+ * @brief   Type of a ring port.
+ * @details A port is the private view of a ring on one side, the buffer
+ *          position and size are never read back from the shared memory
+ *          so accesses are confined to the buffer whatever the other side
+ *          writes in the header.
+ */
+typedef struct {
+  /**
+   * @brief   Ring header.
+   */
+  sb_ring_t                     *rp;
+  /**
+   * @brief   Ring buffer.
+   */
+  uint8_t                       *buffer;
+  /**
+   * @brief   Ring buffer size, a power of two.
+   */
+  uint32_t                      size;
+} sb_ring_port_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Checks if a ring buffer size is valid.
+ *
+ * @param[in] n         ring buffer size
+ * @return              The size validity.
+ */
+#define SB_RING_IS_VALID_SIZE(n)                                            \
+  (((n) > 0U) && ((n) <= SB_RING_MAX_SIZE) && (((n) & ((n) - 1U)) == 0U))
+
+/**
+ * @brief   Size of the memory area of a ring, header included.
+ *
+ * @param[in] n         ring buffer size
+ * @return              The memory area size.
+ */
+#define SB_RING_AREA_SIZE(n)    (sizeof (sb_ring_t) + (size_t)(n))
+
+/**
+ * @brief   Static ring memory area declaration.
+ *
+ * @param[in] name      name of the area
+ * @param[in] n         ring buffer size
+ */
+#define SB_RING_DECL(name, n)                                               \
+  uint32_t name[SB_RING_AREA_SIZE(n) / sizeof (uint32_t)]
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Resets a ring header.
+ *
+ * @param[out] rp       pointer to the ring header
+ */
+static inline void sbRingObjectInit(sb_ring_t *rp) {
+
+  rp->wrptr  = 0U;
+  rp->wrwait = 0U;
+  rp->rdptr  = 0U;
+  rp->rdwait = 0U;
+}
+
+/**
+ * @brief   Initializes a ring port.
+ *
+ * @param[out] portp    pointer to the @p sb_ring_port_t object
+ * @param[in] rp        pointer to the ring header, the buffer follows it
+ * @param[in] size      ring buffer size, a power of two
+ */
+static inline void sbRingPortInit(sb_ring_port_t *portp,
+                                  sb_ring_t *rp,
+                                  uint32_t size) {
+
+  portp->rp     = rp;
+  portp->buffer = (uint8_t *)(void *)rp + sizeof (sb_ring_t);
+  portp->size   = size;
+}
+
+/**
+ * @brief   Number of bytes in the ring.
+ *
+ * @param[in] portp     pointer to the @p sb_ring_port_t object
+ * @return              The number of bytes.
+ * @retval SB_RING_FAULT if the ring indexes are not consistent.
+ */
+static inline int32_t sbRingGetUsed(sb_ring_port_t *portp) {
+  uint32_t used = portp->rp->wrptr - portp->rp->rdptr;
+
+  if (used > portp->size) {
+    return SB_RING_FAULT;
+  }
+
+  return (int32_t)used;
+}
+
+/**
+ * @brief   Writes data in the ring, producer side.
+ * @details Writes as much as possible without waiting.
+ *
+ * @param[in] portp     pointer to the @p sb_ring_port_t object
+ * @param[in] bp        pointer to the data
+ * @param[in] n         number of bytes to be written
+ * @param[out] notifyp  set to @p true if the consumer is waiting and has
+ *                      to be notified
+ * @return              The number of bytes written.
+ * @retval SB_RING_FAULT if the ring indexes are not consistent.
+ */
+static inline int32_t sbRingWrite(sb_ring_port_t *portp,
+                                  const uint8_t *bp,
+                                  size_t n,
+                                  bool *notifyp) {
+  sb_ring_t *rp = portp->rp;
+  uint32_t wr, used, offset, chunk;
+
+  *notifyp = false;
+
+  /* Indexes are read once, the other side could change them at any time.*/
+  wr   = rp->wrptr;
+  used = wr - rp->rdptr;
+  if (used > portp->size) {
+    return SB_RING_FAULT;
+  }
+
+  /* Writing means that this side is no more waiting for space.*/
+  if (rp->wrwait != 0U) {
+    rp->wrwait = 0U;
+  }
+
+  if (n > (size_t)(portp->size - used)) {
+    n = (size_t)(portp->size - used);
+  }
+  if (n == (size_t)0) {
+    return 0;
+  }
+
+  /* Copying data, it can wrap around the buffer end.*/
+  offset = wr & (portp->size - 1U);
+  chunk  = portp->size - offset;
+  if ((size_t)chunk > n) {
+    chunk = (uint32_t)n;
+  }
+  memcpy((void *)(portp->buffer + offset), (const void *)bp, (size_t)chunk);
+  memcpy((void *)portp->buffer, (const void *)(bp + chunk), n - (size_t)chunk);
+
+  /* Data must be visible before the index, the index before checking the
+     consumer state.*/
+  SB_RING_BARRIER();
+  rp->wrptr = wr + (uint32_t)n;
+  SB_RING_BARRIER();
+  *notifyp = rp->rdwait != 0U;
+
+  return (int32_t)n;
+}
+
+/**
+ * @brief   Reads data from the ring, consumer side.
+ * @details Reads as much as available without waiting.
+ *
+ * @param[in] portp     pointer to the @p sb_ring_port_t object
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         maximum number of bytes to be read
+ * @param[out] notifyp  set to @p true if the producer is waiting and has
+ *                      to be notified
+ * @return              The number of bytes read.
+ * @retval SB_RING_FAULT if the ring indexes are not consistent.
+ */
+static inline int32_t sbRingRead(sb_ring_port_t *portp,
+                                 uint8_t *bp,
+                                 size_t n,
+                                 bool *notifyp) {
+  sb_ring_t *rp = portp->rp;
+  uint32_t rd, used, offset, chunk;
+
+  *notifyp = false;
+
+  /* Indexes are read once, the other side could change them at any time.*/
+  rd   = rp->rdptr;
+  used = rp->wrptr - rd;
+  if (used > portp->size) {
+    return SB_RING_FAULT;
+  }
+
+  /* Reading means that this side is no more waiting for data.*/
+  if (rp->rdwait != 0U) {
+    rp->rdwait = 0U;
+  }
+
+  if (n > (size_t)used) {
+    n = (size_t)used;
+  }
+  if (n == (size_t)0) {
+    return 0;
+  }
+
+  /* Data must not be read before the index that published it.*/
+  SB_RING_BARRIER();
+
+  /* Copying data, it can wrap around the buffer end.*/
+  offset = rd & (portp->size - 1U);
+  chunk  = portp->size - offset;
+  if ((size_t)chunk > n) {
+    chunk = (uint32_t)n;
+  }
+  memcpy((void *)bp, (const void *)(portp->buffer + offset), (size_t)chunk);
+  memcpy((void *)(bp + chunk), (const void *)portp->buffer, n - (size_t)chunk);
+
+  /* Data must be consumed before releasing the space, the index updated
+     before checking the producer state.*/
+  SB_RING_BARRIER();
+  rp->rdptr = rd + (uint32_t)n;
+  SB_RING_BARRIER();
+  *notifyp = rp->wrwait != 0U;
+
+  return (int32_t)n;
+}
+
+/**
+ * @brief   Announces that the consumer is going to wait for data.
+ * @details The flag is set before checking the ring again, so data written
+ *          after the check is always followed by a doorbell. The flag is
+ *          cleared by the next @p sbRingRead().
+ *
+ * @param[in] portp     pointer to the @p sb_ring_port_t object
+ * @return              The wait requirement.
+ * @retval false        if data arrived meanwhile, no need to wait.
+ * @retval true         if the caller has to wait for a doorbell.
+ */
+static inline bool sbRingWaitData(sb_ring_port_t *portp) {
+  sb_ring_t *rp = portp->rp;
+
+  rp->rdwait = 1U;
+  SB_RING_BARRIER();
+  if (rp->wrptr != rp->rdptr) {
+    rp->rdwait = 0U;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Announces that the producer is going to wait for space.
+ * @details The flag is set before checking the ring again, so space freed
+ *          after the check is always followed by a doorbell. The flag is
+ *          cleared by the next @p sbRingWrite().
+ *
+ * @param[in] portp     pointer to the @p sb_ring_port_t object
+ * @return              The wait requirement.
+ * @retval false        if space has been freed meanwhile, no need to wait.
+ * @retval true         if the caller has to wait for a doorbell.
+ */
+static inline bool sbRingWaitSpace(sb_ring_port_t *portp) {
+  sb_ring_t *rp = portp->rp;
+
+  rp->wrwait = 1U;
+  SB_RING_BARRIER();
+  if ((rp->wrptr - rp->rdptr) != portp->size) {
+    rp->wrwait = 0U;
+    return false;
+  }
+
+  return true;
+}
+
+#endif /* SBRING_H */
+
+/** @} */
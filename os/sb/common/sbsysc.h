@@ -67,6 +67,7 @@
 #define SB_SYSC_EVENT_WAIT_ALL  136
 #define SB_SYSC_EVENT_BROADCAST 137
 #define SB_SYSC_LOADELF         138
+#define SB_SYSC_SHM             139
 #define SB_SYSC_VIO_VUART       225
 #define SB_SYSC_VIO_VSPI        226
 #define SB_SYSC_VRQ_SET_ALARM   253
@@ -94,6 +95,23 @@
 #define SB_POSIX_MKDIR          14
 #define SB_POSIX_RMDIR          15
 #define SB_POSIX_STAT           16
+#define SB_POSIX_READV          17
+#define SB_POSIX_WRITEV         18
+/** @} */
+
+/**
+ * @brief   Maximum number of elements in a vectored Posix transfer.
+ */
+#define SB_POSIX_IOV_MAX        16
+
+/**
+ * @name    Shared memory rings syscall sub-codes
+ * @{
+ */
+#define SB_SHM_ATTACH_OUT       0
+#define SB_SHM_ATTACH_IN        1
+#define SB_SHM_DETACH           2
+#define SB_SHM_NOTIFY           3
 /** @} */
 
 /**
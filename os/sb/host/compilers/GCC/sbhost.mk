@@ -1,16 +1,20 @@
-# List of the ChibiOS ARMv7-M sandbox host files.
-SBHOSTSRC = $(CHIBIOS)/os/sb/host/sbhost.c \
+# List of the ChibiOS ARMv7-M sandbox host files, the CRC module used by
+# the ELF images cache could be already required by other modules.
+SBHOSTSRC := $(CHIBIOS)/os/sb/host/sbhost.c \
 			$(CHIBIOS)/os/sb/host/sbregions.c \
 			$(CHIBIOS)/os/sb/host/sbsyscall.c \
 			$(CHIBIOS)/os/sb/host/sbapi.c \
 			$(CHIBIOS)/os/sb/host/sbvrq.c \
+			$(CHIBIOS)/os/sb/host/sbshm.c \
 			$(CHIBIOS)/os/sb/host/sbelf.c \
-			$(CHIBIOS)/os/sb/host/sbposix.c
+			$(CHIBIOS)/os/sb/host/sbposix.c \
+			$(filter-out $(ALLCSRC),$(CHIBIOS)/os/common/utils/src/crc.c)
           
 SBHOSTASM = $(CHIBIOS)/os/sb/host/compilers/GCC/sbexc.S
 
 SBHOSTINC = $(CHIBIOS)/os/sb/common \
-            $(CHIBIOS)/os/sb/host
+            $(CHIBIOS)/os/sb/host \
+            $(CHIBIOS)/os/common/utils/include
 
 # Shared variables
 ALLXASMSRC += $(SBHOSTASM)
@@ -207,6 +207,8 @@ typedef struct sb_class sb_class_t;
 #include "sbvrq.h"
 #endif
 
+#include "sbshm.h"
+
 #if (SB_CFG_ENABLE_VIO == TRUE) || defined (__DOXYGEN__)
 #include "sbvio.h"
 #endif
@@ -268,6 +270,12 @@ struct sb_class {
    */
   sb_vrqblock_t                 vrq;
 #endif
+#if (SB_CFG_SHM_RINGS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Shared memory rings-related fields.
+   */
+  sb_shmblock_t                 shm;
+#endif
 #if (SB_CFG_ENABLE_VFS == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   Posix IO-related fields.
@@ -29,6 +29,7 @@
 
 #include "ch.h"
 #include "sb.h"
+#include "crc.h"
 
 #if (SB_CFG_ENABLE_VFS == TRUE) || defined(__DOXYGEN__)
 
@@ -66,6 +67,13 @@
 #define ELF32_R_SYM(v)          ((v) >> 8)
 #define ELF32_R_TYPE(v)         ((v) & 0xFFU)
 
+/* Number of section headers and relocation entries fitting a buffer.*/
+#define ELF_SH_PER_BUFFER       (VFS_BUFFER_SIZE / sizeof (elf32_section_header_t))
+#define ELF_REL_PER_BUFFER      (VFS_BUFFER_SIZE / sizeof (elf32_rel_t))
+
+/* Initial value of the cached images check.*/
+#define ELF_CACHE_CHECK_INIT    0xFFFFFFFFU
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -90,6 +98,7 @@ typedef unsigned elf_secnum_t;
 typedef struct {
   elf_secnum_t              section;
   memory_area_t             area;
+  vfs_offset_t              data_off;
   size_t                    rel_size;
   vfs_offset_t              rel_off;
 } elf_section_info_t;
@@ -99,10 +108,13 @@ typedef struct {
  */
 typedef struct elf_load_context {
   vfs_file_node_c           *fnp;
+  vfs_offset_t              pos;
   const memory_area_t       *map;
 //  uint32_t                  entry;
   elf_secnum_t              sections_num;
   vfs_offset_t              sections_off;
+  size_t                    alloc_size;
+  bool                      zero_found;
   bool                      rel_movw_found;
   uint32_t                  rel_movw_symbol;
   uint32_t                  rel_movw_address;
@@ -157,6 +169,32 @@ typedef struct {
   uint16_t                  st_shndx;
 } elf32_symbol_t;
 
+/**
+ * @brief   Type of a section header handler.
+ */
+typedef msg_t (*elf_section_handler_t)(elf_load_context_t *ctxp,
+                                       elf_secnum_t section,
+                                       const elf32_section_header_t *shp);
+
+#if (SB_CFG_ELF_CACHE_ENTRIES > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a relocated images cache entry.
+ * @note    The path string and the image share the same heap block, the
+ *          entry is free when @p drvp is @p NULL.
+ */
+typedef struct {
+  vfs_driver_c              *drvp;
+  char                      *path;
+  vfs_offset_t              size;
+  uint32_t                  mtime;
+  uint32_t                  check;
+  uint8_t                   *base;
+  size_t                    span;
+  uint8_t                   *image;
+  uint32_t                  used;
+} elf_cache_entry_t;
+#endif
+
 /*===========================================================================*/
 /* Module local variables.                                                   */
 /*===========================================================================*/
@@ -166,10 +204,142 @@ static const uint8_t elf32_header[16] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+#if (SB_CFG_ELF_CACHE_ENTRIES > 0) || defined(__DOXYGEN__)
+static MUTEX_DECL(elf_cache_mtx);
+static uint32_t elf_cache_stamp;
+static elf_cache_entry_t elf_cache[SB_CFG_ELF_CACHE_ENTRIES];
+#endif
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+static void init_context(elf_load_context_t *ctxp,
+                         vfs_file_node_c *fnp,
+                         const memory_area_t *map) {
+
+  /* Context fully cleared.*/
+  memset((void *)ctxp, 0, sizeof (elf_load_context_t));
+
+  /* Initializing the fixed part of the context, the file position is
+     initially unknown.*/
+  ctxp->fnp  = fnp;
+  ctxp->pos  = (vfs_offset_t)-1;
+  ctxp->map  = map;
+  ctxp->next = &ctxp->allocated[0];
+}
+
+static msg_t read_file(elf_load_context_t *ctxp,
+                       vfs_offset_t offset,
+                       void *buf,
+                       size_t n) {
+  msg_t ret;
+
+  /* Seeking only when the read is not contiguous to the previous one,
+     sequential reads do not involve the file system seek logic.*/
+  if (offset != ctxp->pos) {
+    ctxp->pos = (vfs_offset_t)-1;
+    ret = vfsSetFilePosition(ctxp->fnp, offset, VFS_SEEK_SET);
+    CH_RETURN_ON_ERROR(ret);
+    ctxp->pos = offset;
+  }
+
+  ret = (msg_t)vfsReadFile(ctxp->fnp, buf, n);
+  if (CH_RET_IS_ERROR(ret)) {
+    ctxp->pos = (vfs_offset_t)-1;
+    return ret;
+  }
+  ctxp->pos += (vfs_offset_t)ret;
+
+  /* A short read means a truncated file.*/
+  if ((size_t)ret != n) {
+    return CH_RET_ENOEXEC;
+  }
+
+  return CH_RET_SUCCESS;
+}
+
+static msg_t read_header(elf_load_context_t *ctxp) {
+  elf32_header_t h;
+  msg_t ret;
+
+  /* Reading the main ELF header.*/
+  ret = read_file(ctxp, (vfs_offset_t)0, (void *)&h, sizeof (elf32_header_t));
+  CH_RETURN_ON_ERROR(ret);
+
+  /* Checking for the expected header.*/
+  if (memcmp(h.e_ident, elf32_header, 16) != 0) {
+    return CH_RET_ENOEXEC;
+  }
+
+  /* Accepting executable files only.*/
+  if (h.e_type != ET_EXEC) {
+    return CH_RET_ENOEXEC;
+  }
+
+  /* The section headers table is read in blocks, the entries size must be
+     the expected one.*/
+  if ((h.e_shnum > 0U) &&
+      (h.e_shentsize != (uint16_t)sizeof (elf32_section_header_t))) {
+    return CH_RET_ENOEXEC;
+  }
+
+  /* TODO more consistency checks.*/
+
+  /* Storing info required later.*/
+//  ctxp->entry        = h.e_entry;
+  ctxp->sections_num = (elf_secnum_t)h.e_shnum;
+  ctxp->sections_off = (vfs_offset_t)h.e_shoff;
+
+  return CH_RET_SUCCESS;
+}
+
+static msg_t scan_sections(elf_load_context_t *ctxp,
+                           elf_section_handler_t handler) {
+  vfs_shared_buffer_t *shbuf;
+  elf32_section_header_t *shp;
+  elf_secnum_t i, j, n;
+  msg_t ret;
+
+  shbuf = vfs_buffer_take_wait();
+  shp = (elf32_section_header_t *)(void *)shbuf->buf;
+
+  /* Reading the section headers table a buffer-worth at time, not making
+     a seek and a read for each header.*/
+  ret = CH_RET_SUCCESS;
+  for (i = 0U; i < ctxp->sections_num; i += n) {
+
+    n = ctxp->sections_num - i;
+    if (n > (elf_secnum_t)ELF_SH_PER_BUFFER) {
+      n = (elf_secnum_t)ELF_SH_PER_BUFFER;
+    }
+
+    ret = read_file(ctxp,
+                    ctxp->sections_off +
+                    ((vfs_offset_t)i *
+                     (vfs_offset_t)sizeof (elf32_section_header_t)),
+                    (void *)shp,
+                    (size_t)n * sizeof (elf32_section_header_t));
+    CH_BREAK_ON_ERROR(ret);
+
+    for (j = 0U; j < n; j++) {
+
+      /* Empty sections are not processed.*/
+      if (shp[j].sh_size == 0U) {
+        continue;
+      }
+
+      ret = handler(ctxp, i + j, &shp[j]);
+      CH_BREAK_ON_ERROR(ret);
+    }
+    CH_BREAK_ON_ERROR(ret);
+  }
+
+  vfs_buffer_release(shbuf);
+
+  return ret;
+}
+
 static msg_t area_is_intersecting(elf_load_context_t *ctxp,
                                  const memory_area_t *map) {
   elf_section_info_t *esip;
@@ -210,47 +380,23 @@ static msg_t allocate_section(elf_load_context_t *ctxp,
     return CH_RET_ENOEXEC;
   }
 
-  ctxp->next++;
+  /* Sections with data are loaded after the scan, the position of the
+     data in the file is recorded.*/
+  if (shp->sh_type == SHT_PROGBITS) {
 
-  return CH_RET_SUCCESS;
-}
-
-static msg_t allocate_load_section(elf_load_context_t *ctxp,
-                                   elf_secnum_t section,
-                                   const elf32_section_header_t *shp) {
-  elf_section_info_t *esip;
-  msg_t ret;
-
-  /* Checking if there is space in the sections table.*/
-  if (ctxp->next >= &ctxp->allocated[SB_CFG_ELF_MAX_ALLOCATED]) {
-    return CH_RET_ENOMEM;
-  }
-
-  /* Adding an entry for this section.*/
-  esip = ctxp->next;
-  esip->section   = section;
-  esip->area.base = ctxp->map->base + (size_t)shp->sh_addr;
-  esip->area.size = (size_t)shp->sh_size;
-
-  /* Checking if the section can fit into the destination memory area.*/
-  if (!chMemIsAreaWithinX(ctxp->map, &esip->area)) {
-    return CH_RET_ENOMEM;
+    /* Offset zero is the ELF header, it cannot be section data.*/
+    if (shp->sh_offset == 0U) {
+      return CH_RET_ENOEXEC;
+    }
+    esip->data_off = (vfs_offset_t)shp->sh_offset;
   }
-
-  /* Checking if this section is overlapping some other allocated section.*/
-  if (area_is_intersecting(ctxp, &esip->area)) {
-    return CH_RET_ENOEXEC;
+  else {
+    esip->data_off = (vfs_offset_t)0;
   }
 
-  /* Loading section data.*/
-  ret = vfsSetFilePosition(ctxp->fnp, (vfs_offset_t)shp->sh_offset, VFS_SEEK_SET);
-  CH_RETURN_ON_ERROR(ret);
-  ret = vfsReadFile(ctxp->fnp, (void *)esip->area.base, esip->area.size);
-  CH_RETURN_ON_ERROR(ret);
-
   ctxp->next++;
 
-  return ret;
+  return CH_RET_SUCCESS;
 }
 
 static elf_section_info_t *find_allocated_section(elf_load_context_t *ctxp,
@@ -363,10 +509,16 @@ static msg_t reloc_section(elf_load_context_t *ctxp,
   size_t size, done_size, remaining_size;
   msg_t ret;
 
+  /* The relocation table is read in whole entries.*/
+  if ((esip->rel_size % sizeof (elf32_rel_t)) != 0U) {
+    return CH_RET_ENOEXEC;
+  }
+
   shbuf = vfs_buffer_take_wait();
   rbuf = (elf32_rel_t *)(void *)shbuf->buf;
 
   /* Reading the relocation section data.*/
+  ret = CH_RET_SUCCESS;
   remaining_size = esip->rel_size;
   done_size = 0U;
   while (remaining_size > 0U) {
@@ -374,23 +526,22 @@ static msg_t reloc_section(elf_load_context_t *ctxp,
 
     /* Reading relocation data using buffers in order to not make continuous
        calls to the FS which could be unbuffered.*/
-    if (remaining_size > VFS_BUFFER_SIZE) {
-      size = VFS_BUFFER_SIZE;
+    if (remaining_size > (ELF_REL_PER_BUFFER * sizeof (elf32_rel_t))) {
+      size = ELF_REL_PER_BUFFER * sizeof (elf32_rel_t);
     }
     else {
       size = remaining_size;
     }
 
-    /* Reading a buffer-worth of relocation data.*/
-    ret = vfsSetFilePosition(ctxp->fnp,
-                             esip->rel_off + (vfs_offset_t)done_size,
-                             VFS_SEEK_SET);
-    CH_BREAK_ON_ERROR(ret);
-    ret = vfsReadFile(ctxp->fnp, (void *)rbuf, size);
+    /* Reading a buffer-worth of relocation data, consecutive blocks do not
+       require seeking.*/
+    ret = read_file(ctxp,
+                    esip->rel_off + (vfs_offset_t)done_size,
+                    (void *)rbuf, size);
     CH_BREAK_ON_ERROR(ret);
 
     /* Number of relocation entries in the buffer.*/
-    n = (unsigned)ret / (unsigned)sizeof (elf32_rel_t);
+    n = (unsigned)size / (unsigned)sizeof (elf32_rel_t);
     for (i = 0U; i < n; i++) {
       ret = reloc_entry(ctxp, esip, &rbuf[i]);
       CH_BREAK_ON_ERROR(ret);
@@ -406,148 +557,357 @@ static msg_t reloc_section(elf_load_context_t *ctxp,
   return ret;
 }
 
-/*===========================================================================*/
-/* Module exported functions.                                                */
-/*===========================================================================*/
-
-msg_t sbElfLoad(vfs_file_node_c *fnp, const memory_area_t *map) {
-  msg_t ret;
-  elf_load_context_t ctx;
+static msg_t load_section_handler(elf_load_context_t *ctxp,
+                                  elf_secnum_t section,
+                                  const elf32_section_header_t *shp) {
   elf_section_info_t *esip;
 
-  /* Large structures not used at same time, the compiler could optimize it
-     but it is still a problem when running the code without optimizations for
-     debug.*/
-  union {
-    elf32_header_t h;
-    elf32_section_header_t sh;
-  } u;
+  /* Deciding what to do with the section depending on type.*/
+  switch (shp->sh_type) {
+  case SHT_PROGBITS:
+  case SHT_NOBITS:
+    /* Allocatable section types, data sections are loaded after the scan,
+       for uninitialized data sections just checking address ranges.*/
+    if ((shp->sh_flags & SHF_ALLOC) != 0U) {
 
-  /* Load context initialization.*/
-  {
-    /* Context fully cleared.*/
-    memset((void *)&ctx, 0, sizeof (elf_load_context_t));
+      /* Allocating, could fail.*/
+      return allocate_section(ctxp, section, shp);
+    }
+    break;
 
-    /* Initializing the fixed part of the context.*/
-    ctx.fnp  = fnp;
-    ctx.map  = map;
-    ctx.next = &ctx.allocated[0];
+  case SHT_REL:
+    if ((shp->sh_flags & SHF_INFO_LINK) != 0U) {
 
-    /* Reading the main ELF header.*/
-    ret = vfsSetFilePosition(ctx.fnp, (vfs_offset_t)0, VFS_SEEK_SET);
-    CH_RETURN_ON_ERROR(ret);
-    ret = vfsReadFile(ctx.fnp, (void *)&u.h, sizeof (elf32_header_t));
-    CH_RETURN_ON_ERROR(ret);
+      esip = find_allocated_section(ctxp, (elf_secnum_t)shp->sh_info);
+      if (esip == NULL) {
+        /* Ignoring other relocation sections.*/
+        break;
+      }
 
-    /* Checking for the expected header.*/
-    if (memcmp(u.h.e_ident, elf32_header, 16) != 0) {
-      return CH_RET_ENOEXEC;
-    }
+      /* Multiple relocation sections associated to the same section.*/
+      if (esip->rel_size != 0U) {
+        return CH_RET_ENOEXEC;
+      }
 
-    /* Accepting executable files only.*/
-    if (u.h.e_type != ET_EXEC) {
-      return CH_RET_ENOEXEC;
+      esip->rel_size = shp->sh_size;
+      esip->rel_off  = (vfs_offset_t)shp->sh_offset;
     }
+    break;
+
+  default:
+    /* Ignoring other section types.*/
+    break;
+  }
+
+  return CH_RET_SUCCESS;
+}
+
+static msg_t size_section_handler(elf_load_context_t *ctxp,
+                                  elf_secnum_t section,
+                                  const elf32_section_header_t *shp) {
 
-    /* TODO more consistency checks.*/
+  (void)section;
 
-    /* Storing info required later.*/
-//    ctx.entry        = u.h.e_entry;
-    ctx.sections_num = (unsigned)u.h.e_shnum;
-    ctx.sections_off = (vfs_offset_t)u.h.e_shoff;
+  /* Deciding what to do with the section depending on type.*/
+  switch (shp->sh_type) {
+  case SHT_PROGBITS:
+    if (shp->sh_addr == 0U) {
+      ctxp->zero_found = true;
+    }
+    /* Falls through.*/
+  case SHT_NOBITS:
+    /* Allocatable section type, needs to be loaded.*/
+    if ((shp->sh_flags & SHF_ALLOC) != 0U) {
+      size_t top;
+
+      top = (size_t)shp->sh_addr + (size_t)shp->sh_size;
+      if (top > ctxp->alloc_size) {
+        ctxp->alloc_size = top;
+      }
+    }
+    break;
+
+  default:
+    /* Ignoring other section types.*/
+    break;
   }
 
-  /* Loading phase, scanning section headers.*/
-  {
-    elf_secnum_t i;
+  return CH_RET_SUCCESS;
+}
 
-    for (i = 0U; i < ctx.sections_num; i++) {
+static msg_t elf_load(elf_load_context_t *ctxp) {
+  elf_section_info_t *esip;
+  msg_t ret;
+
+  /* Reading the main header.*/
+  ret = read_header(ctxp);
+  CH_RETURN_ON_ERROR(ret);
 
-      /* Reading the header.*/
-      ret = vfsSetFilePosition(ctx.fnp,
-                               ctx.sections_off + ((vfs_offset_t)i *
-                                                   (vfs_offset_t)sizeof (elf32_section_header_t)),
-                               VFS_SEEK_SET);
+  /* Scanning section headers, allocating sections and associating the
+     relocation tables.*/
+  ret = scan_sections(ctxp, load_section_handler);
+  CH_RETURN_ON_ERROR(ret);
+
+  /* Loading sections data directly into their destination, the linker
+     places sections in the file in table order so the reads are mostly
+     sequential.*/
+  for (esip = &ctxp->allocated[0]; esip < ctxp->next; esip++) {
+    if (esip->data_off != (vfs_offset_t)0) {
+      ret = read_file(ctxp, esip->data_off,
+                      (void *)esip->area.base, esip->area.size);
       CH_RETURN_ON_ERROR(ret);
-      ret = vfsReadFile(ctx.fnp, (void *)&u.sh, sizeof (elf32_section_header_t));
+    }
+  }
+
+  /* Relocating all sections with an associated relocation table.*/
+  for (esip = &ctxp->allocated[0]; esip < ctxp->next; esip++) {
+    if (esip->rel_off != (vfs_offset_t)0) {
+      ret = reloc_section(ctxp, esip);
       CH_RETURN_ON_ERROR(ret);
+    }
+  }
 
-      /* Empty sections are not processed.*/
-      if (u.sh.sh_size == 0U) {
-        continue;
-      }
+  return CH_RET_SUCCESS;
+}
 
-      /* Deciding what to do with the section depending on type.*/
-      switch (u.sh.sh_type) {
-      case SHT_PROGBITS:
-        /* Allocatable section type, needs to be loaded.*/
-        if ((u.sh.sh_flags & SHF_ALLOC) != 0U) {
+#if (SB_CFG_ELF_CACHE_ENTRIES > 0) || defined(__DOXYGEN__)
+static msg_t cache_update_check(elf_load_context_t *ctxp,
+                                char *buf,
+                                vfs_offset_t offset,
+                                vfs_offset_t size,
+                                uint32_t *checkp) {
+  size_t n;
+  msg_t ret;
 
-          /* Allocating and loading, could fail.*/
-          ret = allocate_load_section(&ctx, i, &u.sh);
-          CH_RETURN_ON_ERROR(ret);
-        }
-        break;
+  while (size > (vfs_offset_t)0) {
+    n = (size_t)VFS_BUFFER_SIZE;
+    if (size < (vfs_offset_t)n) {
+      n = (size_t)size;
+    }
 
-      case SHT_NOBITS:
-        /* Uninitialized data section, we can have more than one, just checking
-           address ranges.*/
-        if ((u.sh.sh_flags & SHF_ALLOC) != 0U) {
-          ret = allocate_section(&ctx, i, &u.sh);
-          CH_RETURN_ON_ERROR(ret);
-        }
-        break;
+    ret = read_file(ctxp, offset, (void *)buf, n);
+    CH_RETURN_ON_ERROR(ret);
 
-      case SHT_REL:
-        if ((u.sh.sh_flags & SHF_INFO_LINK) != 0U) {
+    *checkp = crc32(*checkp, (const void *)buf, n);
+    offset += (vfs_offset_t)n;
+    size   -= (vfs_offset_t)n;
+  }
 
-          esip = find_allocated_section(&ctx, (elf_secnum_t)u.sh.sh_info);
-          if (esip == NULL) {
-            /* Ignoring other relocation sections.*/
-            break;
-          }
+  return CH_RET_SUCCESS;
+}
 
-          /* Multiple relocation sections associated to the same section.*/
-          if (esip->rel_size != 0U) {
-            return CH_RET_ENOEXEC;
-          }
+static msg_t cache_get_check(elf_load_context_t *ctxp, uint32_t *checkp) {
+  vfs_shared_buffer_t *shbuf;
+  msg_t ret;
 
-          esip->rel_size = u.sh.sh_size;
-          esip->rel_off  = (vfs_offset_t)u.sh.sh_offset;
-        }
-        break;
+  /* Validating the header and locating the section headers table.*/
+  ret = read_header(ctxp);
+  CH_RETURN_ON_ERROR(ret);
 
-      default:
-        /* Ignoring other section types.*/
-        break;
+  shbuf = vfs_buffer_take_wait();
+
+  /* The check covers the main header and the section headers table, a
+     rebuilt image usually differs in the sections sizes or offsets.*/
+  *checkp = ELF_CACHE_CHECK_INIT;
+  ret = cache_update_check(ctxp, shbuf->buf, (vfs_offset_t)0,
+                           (vfs_offset_t)sizeof (elf32_header_t), checkp);
+  if (!CH_RET_IS_ERROR(ret)) {
+    ret = cache_update_check(ctxp, shbuf->buf, ctxp->sections_off,
+                             (vfs_offset_t)ctxp->sections_num *
+                             (vfs_offset_t)sizeof (elf32_section_header_t),
+                             checkp);
+  }
+
+  vfs_buffer_release(shbuf);
+
+  return ret;
+}
+
+static size_t cache_get_span(elf_load_context_t *ctxp) {
+  elf_section_info_t *esip;
+  size_t span, top;
+
+  /* Sections without data are not part of the image, their content is
+     not defined after loading.*/
+  span = (size_t)0;
+  for (esip = &ctxp->allocated[0]; esip < ctxp->next; esip++) {
+    if (esip->data_off != (vfs_offset_t)0) {
+      top = (size_t)(esip->area.base - ctxp->map->base) + esip->area.size;
+      if (top > span) {
+        span = top;
       }
     }
   }
 
-  /* Relocating all sections with an associated relocation table.*/
-  for (esip = &ctx.allocated[0]; esip < ctx.next; esip++) {
-    if (esip->rel_off != (vfs_offset_t)0) {
-      ret = reloc_section(&ctx, esip);
-      CH_RETURN_ON_ERROR(ret);
+  return span;
+}
+
+static bool cache_is_matching(const elf_cache_entry_t *ecp,
+                              vfs_driver_c *drvp,
+                              const char *path,
+                              const memory_area_t *map) {
+
+  return (ecp->drvp == drvp) && (ecp->base == map->base) &&
+         (strcmp(ecp->path, path) == 0);
+}
+
+static uint32_t cache_get_age(const elf_cache_entry_t *ecp) {
+
+  /* Free entries are the oldest.*/
+  if (ecp->drvp == NULL) {
+    return (uint32_t)-1;
+  }
+
+  return elf_cache_stamp - ecp->used;
+}
+
+static void cache_free(elf_cache_entry_t *ecp) {
+
+  if (ecp->drvp != NULL) {
+    chHeapFree((void *)ecp->path);
+    ecp->drvp = NULL;
+  }
+}
+
+static bool cache_fetch(vfs_driver_c *drvp,
+                        const char *path,
+                        const vfs_stat_t *sp,
+                        uint32_t check,
+                        const memory_area_t *map) {
+  elf_cache_entry_t *ecp;
+  bool found;
+
+  chMtxLock(&elf_cache_mtx);
+
+  found = false;
+  for (ecp = &elf_cache[0]; ecp < &elf_cache[SB_CFG_ELF_CACHE_ENTRIES]; ecp++) {
+    if (cache_is_matching(ecp, drvp, path, map) &&
+        (ecp->size == sp->size) && (ecp->mtime == sp->mtime) &&
+        (ecp->check == check) && (ecp->span <= map->size)) {
+
+      /* Same unmodified file at the same address, copying the already
+         relocated image.*/
+      memcpy((void *)map->base, (const void *)ecp->image, ecp->span);
+      ecp->used = ++elf_cache_stamp;
+      found = true;
+      break;
     }
   }
 
-  return ret;
+  chMtxUnlock(&elf_cache_mtx);
+
+  return found;
+}
+
+static void cache_store(vfs_driver_c *drvp,
+                        const char *path,
+                        const vfs_stat_t *sp,
+                        uint32_t check,
+                        const memory_area_t *map,
+                        size_t span) {
+  elf_cache_entry_t *ecp, *victim;
+  size_t n;
+  char *p;
+
+  chMtxLock(&elf_cache_mtx);
+
+  /* An older image of the same file is always replaced, else the free or
+     least recently used entry.*/
+  victim = &elf_cache[0];
+  for (ecp = &elf_cache[0]; ecp < &elf_cache[SB_CFG_ELF_CACHE_ENTRIES]; ecp++) {
+    if (cache_is_matching(ecp, drvp, path, map)) {
+      victim = ecp;
+      break;
+    }
+    if (cache_get_age(ecp) > cache_get_age(victim)) {
+      victim = ecp;
+    }
+  }
+  cache_free(victim);
+
+  /* Path and image in a single heap block, if there is no memory then the
+     image is simply not cached.*/
+  n = strlen(path) + (size_t)1;
+  p = (char *)chHeapAlloc(NULL, n + span);
+  if (p != NULL) {
+    memcpy((void *)p, (const void *)path, n);
+    memcpy((void *)(p + n), (const void *)map->base, span);
+    victim->drvp  = drvp;
+    victim->path  = p;
+    victim->size  = sp->size;
+    victim->mtime = sp->mtime;
+    victim->check = check;
+    victim->base  = map->base;
+    victim->span  = span;
+    victim->image = (uint8_t *)(p + n);
+    victim->used  = ++elf_cache_stamp;
+  }
+
+  chMtxUnlock(&elf_cache_mtx);
+}
+#endif /* SB_CFG_ELF_CACHE_ENTRIES > 0 */
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+msg_t sbElfLoad(vfs_file_node_c *fnp, const memory_area_t *map) {
+  elf_load_context_t ctx;
+
+  /* Load context initialization.*/
+  init_context(&ctx, fnp, map);
+
+  return elf_load(&ctx);
 }
 
 msg_t sbElfLoadFile(vfs_driver_c *drvp,
                     const char *path,
                     const memory_area_t *map) {
   vfs_file_node_c *fnp;
+  elf_load_context_t ctx;
   msg_t ret;
+#if SB_CFG_ELF_CACHE_ENTRIES > 0
+  vfs_stat_t st;
+  uint32_t check = 0U;
+  bool cacheable = false;
+
+  /* Only files with an absolute path and with a modification time can be
+     recognized in the cache.*/
+  if (vfs_path_is_separator(*path)) {
+    ret = vfsDrvStat(drvp, path, &st);
+    CH_RETURN_ON_ERROR(ret);
+
+    cacheable = (bool)(st.mtime != 0U);
+  }
+#endif
 
   ret = vfsDrvOpenFile(drvp, path, VO_RDONLY, &fnp);
   CH_RETURN_ON_ERROR(ret);
 
   do {
-    ret = sbElfLoad(fnp, map);
+#if SB_CFG_ELF_CACHE_ENTRIES > 0
+    if (cacheable) {
+      /* The timestamp resolution can be coarse, the headers are checked
+         too before using a cached image.*/
+      init_context(&ctx, fnp, NULL);
+      ret = cache_get_check(&ctx, &check);
+      CH_BREAK_ON_ERROR(ret);
+
+      if (cache_fetch(drvp, path, &st, check, map)) {
+        break;
+      }
+    }
+#endif
+
+    init_context(&ctx, fnp, map);
+    ret = elf_load(&ctx);
     CH_BREAK_ON_ERROR(ret);
 
+#if SB_CFG_ELF_CACHE_ENTRIES > 0
+    if (cacheable) {
+      cache_store(drvp, path, &st, check, map, cache_get_span(&ctx));
+    }
+#endif
   } while (false);
 
   vfsClose((vfs_node_c *)fnp);
@@ -556,99 +916,48 @@ msg_t sbElfLoadFile(vfs_driver_c *drvp,
 }
 
 msg_t sbElfGetAllocation(vfs_file_node_c *fnp, size_t *sizep) {
+  elf_load_context_t ctx;
   msg_t ret;
-  bool zerofound = false;
 
   /* The file is assumed to be loaded at address zero, one of the loadable
      sections must start at zero.*/
   *sizep = (size_t)0;
 
-  /* Large structures not used at same time, the compiler could optimize it
-     but it is still a problem when running the code without optimizations for
-     debug.*/
-  union {
-    elf32_header_t h;
-    elf32_section_header_t sh;
-  } u;
+  /* Context used for reading only, there is no destination area.*/
+  init_context(&ctx, fnp, NULL);
 
-  /* Load context initialization.*/
-  {
-    /* Reading the main ELF header.*/
-    ret = vfsSetFilePosition(fnp, (vfs_offset_t)0, VFS_SEEK_SET);
-    CH_RETURN_ON_ERROR(ret);
-    ret = vfsReadFile(fnp, (void *)&u.h, sizeof (elf32_header_t));
-    CH_RETURN_ON_ERROR(ret);
-
-    /* Checking for the expected header.*/
-    if (memcmp(u.h.e_ident, elf32_header, 16) != 0) {
-      return CH_RET_ENOEXEC;
-    }
+  /* Reading the main header.*/
+  ret = read_header(&ctx);
+  CH_RETURN_ON_ERROR(ret);
 
-    /* Accepting executable files only.*/
-    if (u.h.e_type != ET_EXEC) {
-      return CH_RET_ENOEXEC;
-    }
+  /* Scanning section headers for the allocatable sections.*/
+  ret = scan_sections(&ctx, size_section_handler);
+  CH_RETURN_ON_ERROR(ret);
 
-    /* TODO more consistency checks.*/
+  /* Consistency check, it is expected that one of the loadable sections
+     starts from virtual address zero.*/
+  if (!ctx.zero_found) {
+    return CH_RET_ENOEXEC;
   }
 
-  /* Loading phase, scanning section headers.*/
-  {
-    elf_secnum_t i, sections_num;
-    vfs_offset_t sections_off;
-
-    sections_num = (elf_secnum_t)u.h.e_shnum;
-    sections_off = (vfs_offset_t)u.h.e_shoff;
-    for (i = 0U; i < sections_num; i++) {
+  *sizep = ctx.alloc_size;
 
-      /* Reading the header.*/
-      ret = vfsSetFilePosition(fnp,
-                               sections_off + ((vfs_offset_t)i *
-                                               (vfs_offset_t)sizeof (elf32_section_header_t)),
-                               VFS_SEEK_SET);
-      CH_RETURN_ON_ERROR(ret);
-      ret = vfsReadFile(fnp, (void *)&u.sh, sizeof (elf32_section_header_t));
-      CH_RETURN_ON_ERROR(ret);
-
-      /* Empty sections are not processed.*/
-      if (u.sh.sh_size == 0U) {
-        continue;
-      }
+  return CH_RET_SUCCESS;
+}
 
-      /* Deciding what to do with the section depending on type.*/
-      switch (u.sh.sh_type) {
-      case SHT_PROGBITS:
-        if (u.sh.sh_addr == 0U) {
-          zerofound = true;
-        }
-        /* Falls through.*/
-      case SHT_NOBITS:
-        /* Allocatable section type, needs to be loaded.*/
-        if ((u.sh.sh_flags & SHF_ALLOC) != 0U) {
-          size_t top;
-
-          top = (size_t)u.sh.sh_addr + (size_t)u.sh.sh_size;
-          if (top > *sizep) {
-            *sizep = top;
-          }
-        }
-        break;
+#if (SB_CFG_ELF_CACHE_ENTRIES > 0) || defined(__DOXYGEN__)
+void sbElfCacheFlush(void) {
+  elf_cache_entry_t *ecp;
 
-      default:
-        /* Ignoring other section types.*/
-        break;
-      }
-    }
-  }
+  chMtxLock(&elf_cache_mtx);
 
-  /* Consistency check, it is expected that one of the loadable sections
-     starts from virtual address zero.*/
-  if (!zerofound) {
-    ret = CH_RET_ENOEXEC;
+  for (ecp = &elf_cache[0]; ecp < &elf_cache[SB_CFG_ELF_CACHE_ENTRIES]; ecp++) {
+    cache_free(ecp);
   }
 
-  return ret;
+  chMtxUnlock(&elf_cache_mtx);
 }
+#endif
 
 #endif /* SB_CFG_ENABLE_VFS == TRUE */
 
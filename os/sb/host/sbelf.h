@@ -45,6 +45,28 @@
 #define SB_CFG_ELF_MAX_ALLOCATED        6
 #endif
 
+/**
+ * @brief   Number of relocated images kept in the loader cache.
+ * @details Images loaded by @p sbElfLoadFile() are copied in heap memory
+ *          after relocation, loading again the same unmodified file at the
+ *          same address is then a simple copy.
+ * @note    Only files with an absolute path on drivers reporting a
+ *          modification time are cached.
+ * @note    A cached image is used if the file size, the modification time
+ *          and a CRC of the ELF header and section headers table are all
+ *          unchanged. The time resolution can be coarse, two seconds on
+ *          FAT, so a file rewritten within the same time slot with the same
+ *          size and section layout, for example changing only a constant,
+ *          is not detected. Call @p sbElfCacheFlush() after replacing
+ *          images in place.
+ * @note    The cache requires the CRC module from @p os/common/utils, it
+ *          is added to the build by @p sbhost.mk.
+ * @note    Zero disables the cache.
+ */
+#if !defined(SB_CFG_ELF_CACHE_ENTRIES) || defined(__DOXYGEN__)
+#define SB_CFG_ELF_CACHE_ENTRIES        0
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -53,6 +75,15 @@
 #error "invalid SB_CFG_ELF_MAX_ALLOCATED value"
 #endif
 
+#if (SB_CFG_ELF_CACHE_ENTRIES < 0) || (SB_CFG_ELF_CACHE_ENTRIES > 32)
+#error "invalid SB_CFG_ELF_CACHE_ENTRIES value"
+#endif
+
+#if (SB_CFG_ELF_CACHE_ENTRIES > 0) &&                                       \
+    ((CH_CFG_USE_HEAP == FALSE) || (CH_CFG_USE_MUTEXES == FALSE))
+#error "SB_CFG_ELF_CACHE_ENTRIES requires CH_CFG_USE_HEAP and CH_CFG_USE_MUTEXES"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -74,6 +105,9 @@ extern "C" {
                       const char *path,
                       const memory_area_t *map);
   msg_t sbElfGetAllocation(vfs_file_node_c *fnp, size_t *sizep);
+#if SB_CFG_ELF_CACHE_ENTRIES > 0
+  void sbElfCacheFlush(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
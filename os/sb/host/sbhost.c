@@ -368,6 +368,11 @@ static thread_t *sb_start_unprivileged(sb_class_t *sbp,
   sbp->vrq.isr = SB_VRQ_ISR_DISABLED;
 #endif
 
+#if SB_CFG_SHM_RINGS > 0
+  /* No rings attached initially.*/
+  __sb_shm_init(sbp);
+#endif
+
   /* Creating a thread on the unprivileged handler.*/
   thread_descriptor_t td = {
     .name       = name,
@@ -29,12 +29,27 @@
 
 #if (SB_CFG_ENABLE_VFS == TRUE) || defined(__DOXYGEN__)
 
+#include <string.h>
 #include <dirent.h>
 
 /*===========================================================================*/
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+/**
+ * @brief   Size of a @p getdents() record for a name of the specified length.
+ * @note    Records are aligned so that the next one can follow directly.
+ */
+#define SB_DIRENT_SIZE(namelen)                                             \
+  MEM_ALIGN_NEXT(sizeof (struct dirent) + (size_t)(namelen) + (size_t)1,    \
+                 PORT_NATURAL_ALIGN)
+
+/**
+ * @brief   Maximum number of directory entries read in a single VFS call.
+ */
+#define SB_DIRENT_BATCH                                                     \
+  (VFS_BUFFER_SIZE / sizeof (vfs_direntry_info_t))
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -83,8 +98,9 @@ static int sb_io_stat(sb_class_t *sbp, const char *path, struct stat *statbuf) {
     memset((void *)statbuf, 0, sizeof (struct stat));
     statbuf->st_mode  = (mode_t)vstat.mode;
     statbuf->st_size  = (off_t)vstat.size;
+    statbuf->st_ino   = (ino_t)vstat.ino;
     statbuf->st_nlink = 1;
-    /* TODO st_blocks, st_blksize, st_ino, timespecs.*/
+    /* TODO st_blocks, st_blksize, timespecs.*/
   }
 
   return ret;
@@ -189,6 +205,7 @@ static int sb_io_fstat(sb_class_t *sbp, int fd, struct stat *statbuf) {
     memset((void *)statbuf, 0, sizeof (struct stat));
     statbuf->st_mode  = (mode_t)vstat.mode;
     statbuf->st_size  = (off_t)vstat.size;
+    statbuf->st_ino   = (ino_t)vstat.ino;
     statbuf->st_nlink = 1;
   }
 
@@ -237,6 +254,94 @@ static ssize_t sb_io_write(sb_class_t *sbp, int fd, const void *buf, size_t coun
   return vfsWriteFile((vfs_file_node_c *)sbp->io.vfs_nodes[fd], buf, count);
 }
 
+static ssize_t sb_io_iov_import(sb_class_t *sbp, vfs_iovec_t *viov,
+                                const vfs_iovec_t *iov, int iovcnt,
+                                bool writable) {
+  size_t total;
+  int i;
+
+  if ((iovcnt < 0) || (iovcnt > SB_POSIX_IOV_MAX)) {
+    return CH_RET_EINVAL;
+  }
+
+  if (!sb_is_valid_read_range(sbp, iov, (size_t)iovcnt * sizeof (vfs_iovec_t))) {
+    return CH_RET_EFAULT;
+  }
+
+  /* Descriptors are copied before being validated so that the sandbox
+     cannot alter them after the check.*/
+  memcpy(viov, iov, (size_t)iovcnt * sizeof (vfs_iovec_t));
+
+  total = (size_t)0;
+  for (i = 0; i < iovcnt; i++) {
+    if (viov[i].iov_len == (size_t)0) {
+      continue;
+    }
+
+    if (writable) {
+      if (!sb_is_valid_write_range(sbp, viov[i].iov_base, viov[i].iov_len)) {
+        return CH_RET_EFAULT;
+      }
+    }
+    else {
+      if (!sb_is_valid_read_range(sbp, viov[i].iov_base, viov[i].iov_len)) {
+        return CH_RET_EFAULT;
+      }
+    }
+
+    if (viov[i].iov_len > (((size_t)-1) >> 1) - total) {
+      return CH_RET_EINVAL;
+    }
+    total += viov[i].iov_len;
+  }
+
+  return (ssize_t)total;
+}
+
+static ssize_t sb_io_readv(sb_class_t *sbp, int fd,
+                           const vfs_iovec_t *iov, int iovcnt) {
+  vfs_iovec_t viov[SB_POSIX_IOV_MAX];
+  ssize_t ret;
+
+  if (!sb_is_existing_descriptor(&sbp->io, fd)) {
+    return CH_RET_EBADF;
+  }
+
+  if (VFS_MODE_S_ISDIR(sbp->io.vfs_nodes[fd]->mode)) {
+    return CH_RET_EISDIR;
+  }
+
+  ret = sb_io_iov_import(sbp, viov, iov, iovcnt, true);
+  if (ret <= (ssize_t)0) {
+    return ret;
+  }
+
+  return vfsReadFileV((vfs_file_node_c *)sbp->io.vfs_nodes[fd],
+                      viov, (unsigned)iovcnt);
+}
+
+static ssize_t sb_io_writev(sb_class_t *sbp, int fd,
+                            const vfs_iovec_t *iov, int iovcnt) {
+  vfs_iovec_t viov[SB_POSIX_IOV_MAX];
+  ssize_t ret;
+
+  if (!sb_is_existing_descriptor(&sbp->io, fd)) {
+    return CH_RET_EBADF;
+  }
+
+  if (VFS_MODE_S_ISDIR(sbp->io.vfs_nodes[fd]->mode)) {
+    return CH_RET_EISDIR;
+  }
+
+  ret = sb_io_iov_import(sbp, viov, iov, iovcnt, false);
+  if (ret <= (ssize_t)0) {
+    return ret;
+  }
+
+  return vfsWriteFileV((vfs_file_node_c *)sbp->io.vfs_nodes[fd],
+                       viov, (unsigned)iovcnt);
+}
+
 static off_t sb_io_lseek(sb_class_t *sbp, int fd, off_t offset, int whence) {
 
   if ((whence != SEEK_SET) && (whence != SEEK_CUR) && (whence != SEEK_END)) {
@@ -263,6 +368,7 @@ static off_t sb_io_lseek(sb_class_t *sbp, int fd, off_t offset, int whence) {
 static ssize_t sb_io_getdents(sb_class_t *sbp, int fd, void *buf, size_t count) {
   vfs_shared_buffer_t *shbuf;
   vfs_direntry_info_t *dip;
+  size_t used;
   msg_t ret;
 
   if (!sb_is_valid_write_range(sbp, buf, count)) {
@@ -280,34 +386,61 @@ static ssize_t sb_io_getdents(sb_class_t *sbp, int fd, void *buf, size_t count)
   shbuf = vfs_buffer_take_wait();
   dip = (vfs_direntry_info_t *)(void *)shbuf->buf;
 
+  /* Entries are requested in batches small enough to be sure they fit the
+     remaining user buffer space, an entry read from the VFS cannot be
+     pushed back.*/
+  used = (size_t)0;
   do {
-    size_t n;
-    struct dirent *dep = (struct dirent *)buf;
+    size_t i, n;
 
-    ret = vfsReadDirectoryNext((vfs_directory_node_c *)sbp->io.vfs_nodes[fd], dip);
-    if (ret <= 0) {
-      /* Note, zero means no more directory entries available.*/
-      break;
+    n = (count - used) / SB_DIRENT_SIZE(VFS_CFG_NAMELEN_MAX);
+    if (n == (size_t)0) {
+      if (used > (size_t)0) {
+        break;
+      }
+
+      /* The first entry is read anyway, it could fit.*/
+      n = (size_t)1;
+    }
+    if (n > SB_DIRENT_BATCH) {
+      n = SB_DIRENT_BATCH;
     }
 
-    n = sizeof (struct dirent) + strlen(dip->name) + (size_t)1;
-    if (count < n) {
-      ret = CH_RET_EINVAL;
+    ret = vfsReadDirectoryMany((vfs_directory_node_c *)sbp->io.vfs_nodes[fd],
+                               dip, n);
+    if (ret <= (msg_t)0) {
+      /* Note, zero means no more directory entries available.*/
       break;
     }
 
-    /* Copying data from VFS structure to the Posix one.*/
-    dep->d_ino    = (ino_t)1; /* TODO */
-    dep->d_reclen = n;
-    dep->d_type   = IFTODT(sbp->io.vfs_nodes[fd]->mode);
-    strcpy(dep->d_name, dip->name);
+    for (i = (size_t)0; i < (size_t)ret; i++) {
+      struct dirent *dep = (struct dirent *)(void *)((uint8_t *)buf + used);
+      size_t reclen = SB_DIRENT_SIZE(strlen(dip[i].name));
 
-    ret = (msg_t)n;
+      /* Only possible for the first entry, see above.*/
+      if (count - used < reclen) {
+        ret = CH_RET_EINVAL;
+        break;
+      }
 
-  } while (false);
+      /* Copying data from VFS structure to the Posix one.*/
+      dep->d_ino    = (ino_t)dip[i].ino;
+      dep->d_reclen = (unsigned short)reclen;
+      dep->d_type   = IFTODT(dip[i].mode);
+      strcpy(dep->d_name, dip[i].name);
+
+      used += reclen;
+    }
+
+    /* Fewer entries than requested, the directory end has been reached.*/
+  } while ((ret > (msg_t)0) && ((size_t)ret == n));
 
   vfs_buffer_release(shbuf);
 
+  if (used > (size_t)0) {
+    return (ssize_t)used;
+  }
+
   return (ssize_t)ret;
 }
 
@@ -430,6 +563,18 @@ void sb_sysc_stdio(sb_class_t *sbp, struct port_extctx *ectxp) {
                                       (const void *)ectxp->r2,
                                       (size_t)ectxp->r3);
     break;
+  case SB_POSIX_READV:
+    ectxp->r0 = (uint32_t)sb_io_readv(sbp,
+                                      (int)ectxp->r1,
+                                      (const vfs_iovec_t *)ectxp->r2,
+                                      (int)ectxp->r3);
+    break;
+  case SB_POSIX_WRITEV:
+    ectxp->r0 = (uint32_t)sb_io_writev(sbp,
+                                       (int)ectxp->r1,
+                                       (const vfs_iovec_t *)ectxp->r2,
+                                       (int)ectxp->r3);
+    break;
   case SB_POSIX_LSEEK:
     ectxp->r0 = (uint32_t)sb_io_lseek(sbp,
                                       (int)ectxp->r1,
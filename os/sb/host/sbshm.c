@@ -0,0 +1,402 @@
+/*
+    ChibiOS - Copyright (C) 2006,2007,2008,2009,2010,2011,2012,2013,2014,
+              2015,2016,2017,2018,2019,2020,2021,2022 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    sb/host/sbshm.c
+ * @brief   ARM SandBox host shared memory rings code.
+ * @details Rings are allocated by the sandbox in its own memory and
+ *          attached to the host using a syscall. Data is then exchanged
+ *          by both sides directly in the ring, the only privileged
+ *          transitions are the doorbells: a syscall from the sandbox and
+ *          a VRQ from the host, both only used when the other side
+ *          announced that it is waiting.
+ * @note    Host threads must not access the rings of a terminated
+ *          sandbox, the rings are detached and the waiting threads
+ *          released on termination.
+ *
+ * @addtogroup ARM_SANDBOX_HOSTAPI
+ * @{
+ */
+
+#include "ch.h"
+#include "sb.h"
+
+#if (SB_CFG_SHM_RINGS > 0) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static bool shm_get_port_s(sb_shm_ring_t *srp, bool in,
+                           sb_ring_port_t *portp) {
+
+  /* The sandbox could detach the ring at any time, working on a copy of
+     the port taken while attached.*/
+  if ((srp->port.rp == NULL) || (srp->is_in != in)) {
+    return false;
+  }
+
+  *portp = srp->port;
+
+  return true;
+}
+
+static void shm_doorbell_s(sb_class_t *sbp, unsigned n) {
+
+  sbVRQSetFlagsI(sbp, SB_CFG_SHM_VRQ, 1U << n);
+  sbVRQTriggerS(sbp, SB_CFG_SHM_VRQ);
+}
+
+static msg_t shm_wait_s(sb_shm_ring_t *srp, sysinterval_t timeout,
+                        systime_t deadline) {
+
+  /* A finite timeout is the time left before the deadline, so that the
+     waits of a single operation do not add up.*/
+  if ((timeout != TIME_INFINITE) && (timeout != TIME_IMMEDIATE)) {
+    sysinterval_t left = chTimeDiffX(chVTGetSystemTimeX(), deadline);
+
+    /* Past the deadline the difference becomes a very high number
+       because the system time is an unsigned type.*/
+    if ((left == (sysinterval_t)0) || (left > timeout)) {
+      return MSG_TIMEOUT;
+    }
+    timeout = left;
+  }
+
+  return chThdEnqueueTimeoutS(&srp->wq, timeout);
+}
+
+static msg_t shm_attach(sb_class_t *sbp, unsigned n, bool in,
+                        sb_ring_t *rp, uint32_t size) {
+  sb_shm_ring_t *srp;
+  msg_t ret;
+
+  if (n >= (unsigned)SB_CFG_SHM_RINGS) {
+    return CH_RET_EINVAL;
+  }
+
+  if (!SB_RING_IS_VALID_SIZE(size)) {
+    return CH_RET_EINVAL;
+  }
+
+  if (!MEM_IS_ALIGNED(rp, sizeof (uint32_t)) ||
+      !sb_is_valid_write_range(sbp, (void *)rp, SB_RING_AREA_SIZE(size))) {
+    return CH_RET_EFAULT;
+  }
+
+  srp = &sbp->shm.rings[n];
+
+  chSysLock();
+
+  if (srp->port.rp != NULL) {
+    ret = CH_RET_EBUSY;
+  }
+  else {
+    sbRingObjectInit(rp);
+    sbRingPortInit(&srp->port, rp, size);
+    srp->is_in = in;
+    ret = CH_RET_SUCCESS;
+  }
+
+  chSysUnlock();
+
+  return ret;
+}
+
+static msg_t shm_detach(sb_class_t *sbp, unsigned n) {
+  sb_shm_ring_t *srp;
+
+  if (n >= (unsigned)SB_CFG_SHM_RINGS) {
+    return CH_RET_EINVAL;
+  }
+
+  srp = &sbp->shm.rings[n];
+
+  chSysLock();
+
+  /* Host threads waiting on the ring are released.*/
+  srp->port.rp = NULL;
+  chThdDequeueAllI(&srp->wq, MSG_RESET);
+  chSchRescheduleS();
+
+  chSysUnlock();
+
+  return CH_RET_SUCCESS;
+}
+
+static msg_t shm_notify(sb_class_t *sbp, unsigned n) {
+
+  if (n >= (unsigned)SB_CFG_SHM_RINGS) {
+    return CH_RET_EINVAL;
+  }
+
+  chSysLock();
+
+  chThdDequeueAllI(&sbp->shm.rings[n].wq, MSG_OK);
+  chSchRescheduleS();
+
+  chSysUnlock();
+
+  return CH_RET_SUCCESS;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the shared memory rings of a sandbox.
+ *
+ * @param[in] sbp       pointer to a @p sb_class_t structure
+ *
+ * @notapi
+ */
+void __sb_shm_init(sb_class_t *sbp) {
+  unsigned n;
+
+  for (n = 0U; n < (unsigned)SB_CFG_SHM_RINGS; n++) {
+    sbp->shm.rings[n].port.rp = NULL;
+    chThdQueueObjectInit(&sbp->shm.rings[n].wq);
+  }
+}
+
+/**
+ * @brief   Detaches all the shared memory rings of a terminating sandbox.
+ *
+ * @param[in] sbp       pointer to a @p sb_class_t structure
+ *
+ * @notapi
+ */
+void __sb_shm_cleanupI(sb_class_t *sbp) {
+  unsigned n;
+
+  for (n = 0U; n < (unsigned)SB_CFG_SHM_RINGS; n++) {
+    if (sbp->shm.rings[n].port.rp != NULL) {
+      sbp->shm.rings[n].port.rp = NULL;
+      chThdDequeueAllI(&sbp->shm.rings[n].wq, MSG_RESET);
+    }
+  }
+}
+
+/**
+ * @brief   Reads from a sandbox output ring.
+ * @details The function returns as soon as some data has been read, it
+ *          waits only if the ring is empty.
+ * @note    Only one host thread at time can read from a ring.
+ *
+ * @param[in] sbp       pointer to a @p sb_class_t structure
+ * @param[in] n         ring number
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] size      maximum number of bytes to read
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of bytes read or an error.
+ * @retval 0            if the operation timed out.
+ * @retval CH_RET_EBADF if the ring is not an attached output ring.
+ * @retval CH_RET_EFAULT if the ring has been corrupted by the sandbox.
+ *
+ * @api
+ */
+msg_t sbShmReadTimeout(sb_class_t *sbp, unsigned n,
+                       uint8_t *bp, size_t size,
+                       sysinterval_t timeout) {
+  sb_shm_ring_t *srp;
+  sb_ring_port_t port;
+  int32_t ret;
+  bool notify;
+  msg_t msg;
+  systime_t deadline;
+
+  chDbgCheck((sbp != NULL) && (n < (unsigned)SB_CFG_SHM_RINGS) &&
+             (bp != NULL));
+
+  srp = &sbp->shm.rings[n];
+
+  if (size == (size_t)0) {
+    return 0;
+  }
+
+  /* Only meaningful for finite timeouts.*/
+  deadline = chTimeAddX(chVTGetSystemTimeX(),
+                        timeout == TIME_INFINITE ? (sysinterval_t)0 : timeout);
+  while (true) {
+    chSysLock();
+    if (!shm_get_port_s(srp, false, &port)) {
+      chSysUnlock();
+      return CH_RET_EBADF;
+    }
+    chSysUnlock();
+
+    /* Copying the data outside the critical zone.*/
+    ret = sbRingRead(&port, bp, size, &notify);
+    if (ret == SB_RING_FAULT) {
+      return CH_RET_EFAULT;
+    }
+
+    chSysLock();
+    if (ret > 0) {
+      /* Ringing only if the sandbox is waiting for space.*/
+      if (notify) {
+        shm_doorbell_s(sbp, n);
+      }
+      chSysUnlock();
+      return (msg_t)ret;
+    }
+
+    /* Ring empty, waiting for a doorbell unless data arrived meanwhile.*/
+    msg = MSG_OK;
+    if (sbRingWaitData(&port)) {
+      msg = shm_wait_s(srp, timeout, deadline);
+    }
+    chSysUnlock();
+
+    if (msg == MSG_TIMEOUT) {
+      return 0;
+    }
+  }
+}
+
+/**
+ * @brief   Writes into a sandbox input ring.
+ * @details The function waits for space until all data has been written
+ *          or the timeout expires.
+ * @note    Only one host thread at time can write into a ring.
+ *
+ * @param[in] sbp       pointer to a @p sb_class_t structure
+ * @param[in] n         ring number
+ * @param[in] bp        pointer to the data
+ * @param[in] size      number of bytes to write
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of bytes written or an error.
+ * @retval CH_RET_EBADF if the ring is not an attached input ring.
+ * @retval CH_RET_EFAULT if the ring has been corrupted by the sandbox.
+ *
+ * @api
+ */
+msg_t sbShmWriteTimeout(sb_class_t *sbp, unsigned n,
+                        const uint8_t *bp, size_t size,
+                        sysinterval_t timeout) {
+  sb_shm_ring_t *srp;
+  sb_ring_port_t port;
+  size_t done;
+  int32_t ret;
+  bool notify;
+  msg_t msg;
+  systime_t deadline;
+
+  chDbgCheck((sbp != NULL) && (n < (unsigned)SB_CFG_SHM_RINGS) &&
+             (bp != NULL));
+
+  srp = &sbp->shm.rings[n];
+
+  /* Only meaningful for finite timeouts.*/
+  deadline = chTimeAddX(chVTGetSystemTimeX(),
+                        timeout == TIME_INFINITE ? (sysinterval_t)0 : timeout);
+  done = (size_t)0;
+  while (true) {
+    chSysLock();
+    if (!shm_get_port_s(srp, true, &port)) {
+      chSysUnlock();
+      return done > (size_t)0 ? (msg_t)done : CH_RET_EBADF;
+    }
+    chSysUnlock();
+
+    /* Copying the data outside the critical zone.*/
+    ret = sbRingWrite(&port, bp + done, size - done, &notify);
+    if (ret == SB_RING_FAULT) {
+      return CH_RET_EFAULT;
+    }
+    done += (size_t)ret;
+
+    chSysLock();
+
+    /* Ringing only if the sandbox is waiting for data.*/
+    if (notify) {
+      shm_doorbell_s(sbp, n);
+    }
+
+    if (done >= size) {
+      chSysUnlock();
+      return (msg_t)done;
+    }
+
+    /* Ring full, waiting for a doorbell unless space was freed meanwhile.*/
+    msg = MSG_OK;
+    if (sbRingWaitSpace(&port)) {
+      msg = shm_wait_s(srp, timeout, deadline);
+    }
+    chSysUnlock();
+
+    if (msg == MSG_TIMEOUT) {
+      return (msg_t)done;
+    }
+  }
+}
+
+void sb_sysc_shm(sb_class_t *sbp, struct port_extctx *ectxp) {
+
+  switch (ectxp->r0) {
+  case SB_SHM_ATTACH_OUT:
+    ectxp->r0 = (uint32_t)shm_attach(sbp, (unsigned)ectxp->r1, false,
+                                     (sb_ring_t *)ectxp->r2,
+                                     (uint32_t)ectxp->r3);
+    break;
+  case SB_SHM_ATTACH_IN:
+    ectxp->r0 = (uint32_t)shm_attach(sbp, (unsigned)ectxp->r1, true,
+                                     (sb_ring_t *)ectxp->r2,
+                                     (uint32_t)ectxp->r3);
+    break;
+  case SB_SHM_DETACH:
+    ectxp->r0 = (uint32_t)shm_detach(sbp, (unsigned)ectxp->r1);
+    break;
+  case SB_SHM_NOTIFY:
+    ectxp->r0 = (uint32_t)shm_notify(sbp, (unsigned)ectxp->r1);
+    break;
+  default:
+    ectxp->r0 = (uint32_t)CH_RET_ENOSYS;
+    break;
+  }
+}
+
+#endif /* SB_CFG_SHM_RINGS > 0 */
+
+/** @} */
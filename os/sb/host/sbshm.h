@@ -0,0 +1,152 @@
+/*
+    ChibiOS - Copyright (C) 2006,2007,2008,2009,2010,2011,2012,2013,2014,
+              2015,2016,2017,2018,2019,2020,2021,2022 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    sb/host/sbshm.h
+ * @brief   ARM SandBox host shared memory rings macros and structures.
+ *
+ * @addtogroup ARM_SANDBOX_HOSTAPI
+ * @{
+ */
+
+#ifndef SBSHM_H
+#define SBSHM_H
+
+#include "sbring.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of shared memory rings for each sandbox.
+ * @note    Zero disables the shared memory rings support.
+ */
+#if !defined(SB_CFG_SHM_RINGS) || defined(__DOXYGEN__)
+#define SB_CFG_SHM_RINGS                0
+#endif
+
+/**
+ * @brief   VRQ used as doorbell from the host to the sandbox.
+ * @note    The VRQ flags are the mask of the rings requiring attention.
+ */
+#if !defined(SB_CFG_SHM_VRQ) || defined(__DOXYGEN__)
+#define SB_CFG_SHM_VRQ                  30
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (SB_CFG_SHM_RINGS < 0) || (SB_CFG_SHM_RINGS > 32)
+#error "invalid SB_CFG_SHM_RINGS value"
+#endif
+
+#if SB_CFG_SHM_RINGS > 0
+
+#if SB_CFG_ENABLE_VRQ == FALSE
+#error "shared memory rings require SB_CFG_ENABLE_VRQ"
+#endif
+
+#if (SB_CFG_SHM_VRQ < 0) || (SB_CFG_SHM_VRQ > 31)
+#error "invalid SB_CFG_SHM_VRQ value"
+#endif
+
+#if SB_CFG_SHM_VRQ == SB_CFG_ALARM_VRQ
+#error "SB_CFG_SHM_VRQ and SB_CFG_ALARM_VRQ must differ"
+#endif
+
+/**
+ * @brief    Shared memory rings syscall handler
+ */
+#define SB_SVC139_HANDLER       sb_sysc_shm
+
+#endif /* SB_CFG_SHM_RINGS > 0 */
+
+#if (SB_CFG_SHM_RINGS > 0) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a host-side shared memory ring.
+ */
+typedef struct {
+  /**
+   * @brief   Host port of the ring, the header is @p NULL if not attached.
+   */
+  sb_ring_port_t                port;
+  /**
+   * @brief   The host is the ring producer.
+   */
+  bool                          is_in;
+  /**
+   * @brief   Host threads waiting for a doorbell.
+   */
+  threads_queue_t               wq;
+} sb_shm_ring_t;
+
+/**
+ * @brief   Type of a sandbox shared memory rings structure.
+ */
+typedef struct {
+  /**
+   * @brief   Rings attached by the sandbox.
+   */
+  sb_shm_ring_t                 rings[SB_CFG_SHM_RINGS];
+} sb_shmblock_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void __sb_shm_init(sb_class_t *sbp);
+  void __sb_shm_cleanupI(sb_class_t *sbp);
+  msg_t sbShmReadTimeout(sb_class_t *sbp, unsigned n,
+                         uint8_t *bp, size_t size,
+                         sysinterval_t timeout);
+  msg_t sbShmWriteTimeout(sb_class_t *sbp, unsigned n,
+                          const uint8_t *bp, size_t size,
+                          sysinterval_t timeout);
+  void sb_sysc_shm(sb_class_t *sbp, struct port_extctx *ectxp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* SB_CFG_SHM_RINGS > 0 */
+
+#endif /* SBSHM_H */
+
+/** @} */
@@ -911,6 +911,10 @@ void __sb_abort(msg_t msg) {
   chSysLock();
 #endif
 
+#if SB_CFG_SHM_RINGS > 0
+  __sb_shm_cleanupI((sb_class_t *)chThdGetSelfX()->object);
+#endif
+
 #if CH_CFG_USE_EVENTS == TRUE
   chEvtBroadcastI(&sb.termination_es);
 #endif
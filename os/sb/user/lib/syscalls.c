@@ -262,6 +262,30 @@ int _rmdir_r(struct _reent *r, const char *path) {
   return 0;
 }
 
+ssize_t readv(int fd, const struct iovec *iov, int iovcnt) {
+  ssize_t n;
+
+  n = sbReadv(fd, iov, iovcnt);
+  if (CH_RET_IS_ERROR(n)) {
+    errno = CH_DECODE_ERROR(n);
+    return -1;
+  }
+
+  return n;
+}
+
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt) {
+  ssize_t n;
+
+  n = sbWritev(fd, iov, iovcnt);
+  if (CH_RET_IS_ERROR(n)) {
+    errno = CH_DECODE_ERROR(n);
+    return -1;
+  }
+
+  return n;
+}
+
 #ifdef __cplusplus
 extern "C" {
   void __cxa_pure_virtual(void) {
@@ -35,7 +35,9 @@
 
 #include "errcodes.h"
 #include "dirent.h"
+#include "uio.h"
 #include "sbsysc.h"
+#include "sbring.h"
 
 /*===========================================================================*/
 /* Module constants.                                                         */
@@ -360,6 +362,34 @@ static inline ssize_t sbWrite(int fd, const void *buf, size_t count) {
   return (ssize_t)r0;
 }
 
+/**
+ * @brief   Posix-style vectored file read.
+ *
+ * @param[in] fd        file descriptor
+ * @param[in] iov       array of buffer descriptors
+ * @param[in] iovcnt    number of elements in @p iov
+ * @return              The number of bytes really transferred or an error.
+ */
+static inline ssize_t sbReadv(int fd, const struct iovec *iov, int iovcnt) {
+
+  __syscall4r(128, SB_POSIX_READV, fd, iov, iovcnt);
+  return (ssize_t)r0;
+}
+
+/**
+ * @brief   Posix-style vectored file write.
+ *
+ * @param[in] fd        file descriptor
+ * @param[in] iov       array of buffer descriptors
+ * @param[in] iovcnt    number of elements in @p iov
+ * @return              The number of bytes really transferred or an error.
+ */
+static inline ssize_t sbWritev(int fd, const struct iovec *iov, int iovcnt) {
+
+  __syscall4r(128, SB_POSIX_WRITEV, fd, iov, iovcnt);
+  return (ssize_t)r0;
+}
+
 /**
  * @brief   Posix-style file seek.
  *
@@ -660,6 +690,136 @@ static inline int sbLoadElf(const char *fname, uint8_t *buf, size_t size) {
 
 }
 
+/**
+ * @brief   Attaches a ring for data going from the sandbox to the host.
+ * @details The host resets the ring header, the port for the sandbox side
+ *          is initialized here.
+ *
+ * @param[out] portp    pointer to the sandbox @p sb_ring_port_t object
+ * @param[in] n         ring number
+ * @param[in] rp        ring memory area, see @p SB_RING_DECL()
+ * @param[in] size      ring buffer size, a power of two
+ * @return              Operation result.
+ *
+ * @api
+ */
+static inline int sbShmAttachOut(sb_ring_port_t *portp, unsigned n,
+                                 sb_ring_t *rp, uint32_t size) {
+
+  sbRingPortInit(portp, rp, size);
+
+  __syscall4r(139, SB_SHM_ATTACH_OUT, n, rp, size);
+  return (int)r0;
+}
+
+/**
+ * @brief   Attaches a ring for data going from the host to the sandbox.
+ * @details The host resets the ring header, the port for the sandbox side
+ *          is initialized here.
+ *
+ * @param[out] portp    pointer to the sandbox @p sb_ring_port_t object
+ * @param[in] n         ring number
+ * @param[in] rp        ring memory area, see @p SB_RING_DECL()
+ * @param[in] size      ring buffer size, a power of two
+ * @return              Operation result.
+ *
+ * @api
+ */
+static inline int sbShmAttachIn(sb_ring_port_t *portp, unsigned n,
+                                sb_ring_t *rp, uint32_t size) {
+
+  sbRingPortInit(portp, rp, size);
+
+  __syscall4r(139, SB_SHM_ATTACH_IN, n, rp, size);
+  return (int)r0;
+}
+
+/**
+ * @brief   Detaches a ring, host threads waiting on it are released.
+ *
+ * @param[in] n         ring number
+ * @return              Operation result.
+ *
+ * @api
+ */
+static inline int sbShmDetach(unsigned n) {
+
+  __syscall2r(139, SB_SHM_DETACH, n);
+  return (int)r0;
+}
+
+/**
+ * @brief   Rings the doorbell of a ring, host threads waiting on it are
+ *          woken.
+ *
+ * @param[in] n         ring number
+ * @return              Operation result.
+ *
+ * @api
+ */
+static inline int sbShmNotify(unsigned n) {
+
+  __syscall2r(139, SB_SHM_NOTIFY, n);
+  return (int)r0;
+}
+
+/**
+ * @brief   Writes into an output ring without waiting.
+ * @details The host is notified only if it is waiting for data. If the
+ *          ring is full then the caller can announce the wait using
+ *          @p sbRingWaitSpace() and wait for the @p SB_CFG_SHM_VRQ
+ *          VRQ.
+ *
+ * @param[in] portp     pointer to the sandbox @p sb_ring_port_t object
+ * @param[in] n         ring number
+ * @param[in] buf       pointer to the data
+ * @param[in] size      number of bytes to write
+ * @return              The number of bytes written.
+ * @retval SB_RING_FAULT if the ring indexes are not consistent.
+ *
+ * @api
+ */
+static inline int32_t sbShmWrite(sb_ring_port_t *portp, unsigned n,
+                                 const void *buf, size_t size) {
+  int32_t ret;
+  bool notify;
+
+  ret = sbRingWrite(portp, (const uint8_t *)buf, size, &notify);
+  if (notify) {
+    (void) sbShmNotify(n);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief   Reads from an input ring without waiting.
+ * @details The host is notified only if it is waiting for space. If the
+ *          ring is empty then the caller can announce the wait using
+ *          @p sbRingWaitData() and wait for the @p SB_CFG_SHM_VRQ VRQ.
+ *
+ * @param[in] portp     pointer to the sandbox @p sb_ring_port_t object
+ * @param[in] n         ring number
+ * @param[out] buf      pointer to the data buffer
+ * @param[in] size      maximum number of bytes to read
+ * @return              The number of bytes read.
+ * @retval SB_RING_FAULT if the ring indexes are not consistent.
+ *
+ * @api
+ */
+static inline int32_t sbShmRead(sb_ring_port_t *portp, unsigned n,
+                                void *buf, size_t size) {
+  int32_t ret;
+  bool notify;
+
+  ret = sbRingRead(portp, (uint8_t *)buf, size, &notify);
+  if (notify) {
+    (void) sbShmNotify(n);
+  }
+
+  return ret;
+}
+
 /**
  * @brief   Seconds to time interval.
  * @details Converts from seconds to system ticks number.
@@ -0,0 +1,256 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    binlog.c
+ * @brief   Deferred binary logger code.
+ * @details Log records are stored in binary form, a record contains the
+ *          address of a chprintf-compatible format string, a time stamp
+ *          and the raw 32 bits arguments. Formatting is performed on the
+ *          host by the @p tools/binlog/binlog_decode.py tool which resolves
+ *          the format strings from the application ELF file.<br>
+ *          Each producer context owns a ring and writes records without
+ *          locks, the drain thread ships the records over a
+ *          @p BaseSequentialStream.
+ *          <h2>Wire format</h2>
+ *          Records are sent as sequences of 32 bits words in the target
+ *          endianness:
+ *          - Header: @p BINLOG_HDR_MAGIC, producer tag in bits 8..15,
+ *            number of arguments in bits 0..7.
+ *          - System time stamp.
+ *          - Format string address, zero for dropped records notices.
+ *          - Arguments.
+ *          .
+ * @note    Arguments for @p %s conversions must point to constant strings
+ *          located in the ELF file, arguments for @p %f conversions must
+ *          be encoded using @p binlogFloat().
+ * @note    On multi-core devices a producer ring must be written from the
+ *          same core it is drained from.
+ *
+ * @addtogroup BINLOG
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "binlog.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static size_t ring_drain(BaseSequentialStream *stream, binlog_ring_t *rp) {
+  uint32_t rd, wr, dropped;
+  size_t n = 0U;
+
+  /* Dropped records notice, if any.*/
+  dropped = rp->dropped;
+  if (dropped != rp->reported) {
+    uint32_t notice[BINLOG_HDR_WORDS + 1U];
+
+    notice[0] = BINLOG_HDR_MAGIC | ((uint32_t)rp->tag << 8) | 1U;
+    notice[1] = (uint32_t)chVTGetSystemTimeX();
+    notice[2] = 0U;
+    notice[3] = dropped - rp->reported;
+    n += streamWrite(stream, (const uint8_t *)notice, sizeof (notice));
+    rp->reported = dropped;
+  }
+
+  /* Records are shipped directly from the ring, the write position is
+     always on a record boundary.*/
+  rd = rp->rdpos;
+  wr = rp->wrpos;
+  while (rd != wr) {
+    uint32_t offset = rd & rp->mask;
+    uint32_t words = wr - rd;
+
+    if (words > (rp->mask + 1U) - offset) {
+      words = (rp->mask + 1U) - offset;
+    }
+
+    n += streamWrite(stream,
+                     (const uint8_t *)(const void *)&rp->buffer[offset],
+                     (size_t)words * sizeof (uint32_t));
+    rd += words;
+
+    /* Releasing the space to the producer.*/
+    rp->rdpos = rd;
+  }
+
+  return n;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p binlog_t object.
+ *
+ * @param[out] blp      pointer to the @p binlog_t object
+ * @param[in] stream    pointer to the output stream
+ */
+void binlogObjectInit(binlog_t *blp, BaseSequentialStream *stream) {
+
+  blp->stream = stream;
+  blp->rings  = NULL;
+}
+
+/**
+ * @brief   Initializes a @p binlog_ring_t object.
+ *
+ * @param[out] rp       pointer to the @p binlog_ring_t object
+ * @param[in] buf       pointer to the ring buffer
+ * @param[in] nwords    size of the ring buffer in words, it must be a power
+ *                      of two
+ * @param[in] tag       producer tag reported in the records
+ */
+void binlogRingObjectInit(binlog_ring_t *rp, uint32_t *buf,
+                          size_t nwords, uint8_t tag) {
+
+  chDbgCheck((buf != NULL) && (nwords >= BINLOG_HDR_WORDS + BINLOG_MAX_ARGS) &&
+             ((nwords & (nwords - 1U)) == 0U));
+
+  rp->next     = NULL;
+  rp->buffer   = buf;
+  rp->mask     = (uint32_t)nwords - 1U;
+  rp->tag      = tag;
+  rp->wrpos    = 0U;
+  rp->rdpos    = 0U;
+  rp->dropped  = 0U;
+  rp->reported = 0U;
+}
+
+/**
+ * @brief   Registers a ring into a logger.
+ * @note    Rings cannot be unregistered.
+ *
+ * @param[in] blp       pointer to the @p binlog_t object
+ * @param[in] rp        pointer to the @p binlog_ring_t object
+ */
+void binlogRegisterRing(binlog_t *blp, binlog_ring_t *rp) {
+
+  chSysLock();
+  rp->next   = blp->rings;
+  blp->rings = rp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Logs a record.
+ * @details The record is written into the ring without locking, the
+ *          function can be called from threads and ISRs as long each ring
+ *          is only used by its own producer context.
+ *
+ * @param[in] rp        pointer to the producer @p binlog_ring_t object
+ * @param[in] fmt       chprintf-compatible format string
+ * @param[in] n         number of arguments
+ * @param[in] args      pointer to the arguments array
+ * @return              The operation status.
+ * @retval false        if the record has been stored.
+ * @retval true         if the ring was full and the record was dropped.
+ *
+ * @xclass
+ */
+bool binlogWriteX(binlog_ring_t *rp, const char *fmt,
+                  unsigned n, const uint32_t *args) {
+  volatile uint32_t *buf = rp->buffer;
+  uint32_t mask = rp->mask;
+  uint32_t wr = rp->wrpos;
+  unsigned i;
+
+  chDbgCheck((fmt != NULL) && (n <= BINLOG_MAX_ARGS));
+
+  if ((mask + 1U) - (wr - rp->rdpos) < BINLOG_HDR_WORDS + n) {
+    rp->dropped++;
+    return true;
+  }
+
+  buf[wr++ & mask] = BINLOG_HDR_MAGIC | ((uint32_t)rp->tag << 8) | n;
+  buf[wr++ & mask] = (uint32_t)chVTGetSystemTimeX();
+  buf[wr++ & mask] = (uint32_t)(uintptr_t)fmt;
+  for (i = 0U; i < n; i++) {
+    buf[wr++ & mask] = args[i];
+  }
+
+  /* Publishing the record, the buffer is written before the position
+     because both are volatile.*/
+  rp->wrpos = wr;
+
+  return false;
+}
+
+/**
+ * @brief   Ships all the pending records of a logger.
+ *
+ * @param[in] blp       pointer to the @p binlog_t object
+ * @return              The number of bytes written to the stream.
+ */
+size_t binlogDrain(binlog_t *blp) {
+  binlog_ring_t *rp;
+  size_t n = 0U;
+
+  /* Rings are only added at the list head, the rest of the list is
+     stable.*/
+  chSysLock();
+  rp = blp->rings;
+  chSysUnlock();
+
+  while (rp != NULL) {
+    n += ring_drain(blp->stream, rp);
+    rp = rp->next;
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Drain thread function.
+ * @details The thread periodically ships the pending records, it should
+ *          run at low priority.
+ *
+ * @param[in] p         pointer to a @p binlog_t object
+ */
+THD_FUNCTION(binlogThread, p) {
+  binlog_t *blp = p;
+
+#if !defined(__CHIBIOS_NIL__)
+  chRegSetThreadName(BINLOG_THREAD_NAME);
+#endif
+
+  while (true) {
+    (void) binlogDrain(blp);
+    chThdSleep(BINLOG_DRAIN_INTERVAL);
+  }
+}
+
+/** @} */
@@ -0,0 +1,296 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    binlog.h
+ * @brief   Deferred binary logger header.
+ *
+ * @addtogroup BINLOG
+ * @{
+ */
+
+#ifndef BINLOG_H
+#define BINLOG_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Marker in the most significant byte of a record header.
+ */
+#define BINLOG_HDR_MAGIC            0xB1000000U
+
+/**
+ * @brief   Number of header words in a record.
+ * @note    The header words are: header, time stamp, format identifier.
+ */
+#define BINLOG_HDR_WORDS            3U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum number of arguments in a record.
+ */
+#if !defined(BINLOG_MAX_ARGS) || defined(__DOXYGEN__)
+#define BINLOG_MAX_ARGS             8
+#endif
+
+/**
+ * @brief   Drain thread polling interval.
+ */
+#if !defined(BINLOG_DRAIN_INTERVAL) || defined(__DOXYGEN__)
+#define BINLOG_DRAIN_INTERVAL       TIME_MS2I(10)
+#endif
+
+/**
+ * @brief   Default drain thread name.
+ */
+#if !defined(BINLOG_THREAD_NAME) || defined(__DOXYGEN__)
+#define BINLOG_THREAD_NAME          "binlog"
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (BINLOG_MAX_ARGS < 4) || (BINLOG_MAX_ARGS > 255)
+#error "invalid BINLOG_MAX_ARGS value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a log records ring.
+ * @details A ring has exactly one producer context, a thread or an ISR
+ *          priority level, and the drain thread as consumer. Records are
+ *          written without locks, the producer only writes @p wrpos and
+ *          @p dropped, the consumer only writes @p rdpos.
+ */
+typedef struct binlog_ring {
+  /**
+   * @brief   Next ring in the logger list.
+   */
+  struct binlog_ring        *next;
+  /**
+   * @brief   Ring buffer.
+   */
+  volatile uint32_t         *buffer;
+  /**
+   * @brief   Ring size in words minus one, the size is a power of two.
+   */
+  uint32_t                  mask;
+  /**
+   * @brief   Producer tag reported in the records.
+   */
+  uint8_t                   tag;
+  /**
+   * @brief   Free running write position.
+   */
+  volatile uint32_t         wrpos;
+  /**
+   * @brief   Free running read position.
+   */
+  volatile uint32_t         rdpos;
+  /**
+   * @brief   Records dropped because the ring was full.
+   */
+  volatile uint32_t         dropped;
+  /**
+   * @brief   Dropped records already reported by the drain thread.
+   */
+  uint32_t                  reported;
+} binlog_ring_t;
+
+/**
+ * @brief   Type of a binary logger.
+ */
+typedef struct {
+  /**
+   * @brief   Output stream.
+   */
+  BaseSequentialStream      *stream;
+  /**
+   * @brief   List of the registered rings.
+   */
+  binlog_ring_t             *rings;
+} binlog_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                   */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void binlogObjectInit(binlog_t *blp, BaseSequentialStream *stream);
+  void binlogRingObjectInit(binlog_ring_t *rp, uint32_t *buf,
+                            size_t nwords, uint8_t tag);
+  void binlogRegisterRing(binlog_t *blp, binlog_ring_t *rp);
+  bool binlogWriteX(binlog_ring_t *rp, const char *fmt,
+                    unsigned n, const uint32_t *args);
+  size_t binlogDrain(binlog_t *blp);
+  THD_FUNCTION(binlogThread, p);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Float argument encoding.
+ * @details Arguments for the @p %f conversion must be passed through this
+ *          function, the bit pattern is decoded by the host tool.
+ *
+ * @param[in] f         the float value
+ * @return              The float bit pattern.
+ *
+ * @xclass
+ */
+static inline uint32_t binlogFloat(float f) {
+  union {
+    float     f;
+    uint32_t  u;
+  } v;
+
+  v.f = f;
+
+  return v.u;
+}
+
+/**
+ * @brief   Logs a record with no arguments.
+ *
+ * @param[in] rp        pointer to the producer @p binlog_ring_t object
+ * @param[in] fmt       chprintf-compatible format string
+ * @return              The operation status.
+ * @retval false        if the record has been stored.
+ * @retval true         if the ring was full and the record was dropped.
+ *
+ * @xclass
+ */
+static inline bool binlogWrite0(binlog_ring_t *rp, const char *fmt) {
+
+  return binlogWriteX(rp, fmt, 0U, NULL);
+}
+
+/**
+ * @brief   Logs a record with one argument.
+ *
+ * @param[in] rp        pointer to the producer @p binlog_ring_t object
+ * @param[in] fmt       chprintf-compatible format string
+ * @param[in] a1        argument 1
+ * @return              The operation status.
+ * @retval false        if the record has been stored.
+ * @retval true         if the ring was full and the record was dropped.
+ *
+ * @xclass
+ */
+static inline bool binlogWrite1(binlog_ring_t *rp, const char *fmt,
+                                uint32_t a1) {
+
+  return binlogWriteX(rp, fmt, 1U, &a1);
+}
+
+/**
+ * @brief   Logs a record with two arguments.
+ *
+ * @param[in] rp        pointer to the producer @p binlog_ring_t object
+ * @param[in] fmt       chprintf-compatible format string
+ * @param[in] a1        argument 1
+ * @param[in] a2        argument 2
+ * @return              The operation status.
+ * @retval false        if the record has been stored.
+ * @retval true         if the ring was full and the record was dropped.
+ *
+ * @xclass
+ */
+static inline bool binlogWrite2(binlog_ring_t *rp, const char *fmt,
+                                uint32_t a1, uint32_t a2) {
+  uint32_t args[2];
+
+  args[0] = a1;
+  args[1] = a2;
+
+  return binlogWriteX(rp, fmt, 2U, args);
+}
+
+/**
+ * @brief   Logs a record with three arguments.
+ *
+ * @param[in] rp        pointer to the producer @p binlog_ring_t object
+ * @param[in] fmt       chprintf-compatible format string
+ * @param[in] a1        argument 1
+ * @param[in] a2        argument 2
+ * @param[in] a3        argument 3
+ * @return              The operation status.
+ * @retval false        if the record has been stored.
+ * @retval true         if the ring was full and the record was dropped.
+ *
+ * @xclass
+ */
+static inline bool binlogWrite3(binlog_ring_t *rp, const char *fmt,
+                                uint32_t a1, uint32_t a2, uint32_t a3) {
+  uint32_t args[3];
+
+  args[0] = a1;
+  args[1] = a2;
+  args[2] = a3;
+
+  return binlogWriteX(rp, fmt, 3U, args);
+}
+
+/**
+ * @brief   Logs a record with four arguments.
+ *
+ * @param[in] rp        pointer to the producer @p binlog_ring_t object
+ * @param[in] fmt       chprintf-compatible format string
+ * @param[in] a1        argument 1
+ * @param[in] a2        argument 2
+ * @param[in] a3        argument 3
+ * @param[in] a4        argument 4
+ * @return              The operation status.
+ * @retval false        if the record has been stored.
+ * @retval true         if the ring was full and the record was dropped.
+ *
+ * @xclass
+ */
+static inline bool binlogWrite4(binlog_ring_t *rp, const char *fmt,
+                                uint32_t a1, uint32_t a2, uint32_t a3,
+                                uint32_t a4) {
+  uint32_t args[4];
+
+  args[0] = a1;
+  args[1] = a2;
+  args[2] = a3;
+  args[3] = a4;
+
+  return binlogWriteX(rp, fmt, 4U, args);
+}
+
+#endif /* BINLOG_H */
+
+/** @} */
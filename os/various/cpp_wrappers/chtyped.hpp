@@ -0,0 +1,482 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    chtyped.hpp
+ * @brief   C++17 typed kernel objects.
+ * @details Header-only templates specialized at compile time. All the
+ *          methods are inline and map directly on the kernel inline APIs
+ *          or port macros, there are no virtual calls and no casts through
+ *          @p msg_t on the application side.
+ *
+ * @addtogroup cpp_library
+ * @{
+ */
+
+#include <ch.h>
+
+#ifndef _CHTYPED_HPP_
+#define _CHTYPED_HPP_
+
+#if __cplusplus < 201703L
+#error "chtyped.hpp requires C++17"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace chibios_rt {
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::toInterval                                                 *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Converts a @p std::chrono duration in system ticks.
+   * @details The conversion is performed at compile time for constant
+   *          durations, the result is rounded up like @p TIME_MS2I().
+   * @note    Floating point durations are rounded up too, a non-zero
+   *          duration shorter than a tick gives one tick.
+   *
+   * @param[in] d           the duration, it must not be negative
+   * @return                The number of ticks.
+   *
+   * @xclass
+   */
+  template <typename Rep, typename Period>
+  constexpr sysinterval_t toInterval(std::chrono::duration<Rep, Period> d) {
+    using ratio = std::ratio_multiply<Period,
+                                      std::ratio<CH_CFG_ST_FREQUENCY, 1>>;
+
+    static_assert(std::is_arithmetic_v<Rep>,
+                  "duration representation must be arithmetic");
+
+    if constexpr (std::is_floating_point_v<Rep>) {
+      const long double t = ((long double)d.count() *
+                             (long double)ratio::num) /
+                            (long double)ratio::den;
+      const std::uintmax_t n = (std::uintmax_t)t;
+
+      return (sysinterval_t)((long double)n < t ? n + 1U : n);
+    }
+    else {
+      return (sysinterval_t)((((std::uintmax_t)d.count() *
+                               (std::uintmax_t)ratio::num) +
+                              ((std::uintmax_t)ratio::den - 1U)) /
+                             (std::uintmax_t)ratio::den);
+    }
+  }
+
+  /**
+   * @brief   Converts system ticks in a @p std::chrono duration.
+   * @details The result is rounded up.
+   *
+   * @param[in] interval    the interval in ticks
+   * @return                The duration.
+   *
+   * @xclass
+   */
+  template <typename Duration = std::chrono::microseconds>
+  constexpr Duration fromInterval(sysinterval_t interval) {
+    using ratio = std::ratio_divide<std::ratio<1, CH_CFG_ST_FREQUENCY>,
+                                    typename Duration::period>;
+
+    return Duration((typename Duration::rep)
+                    ((((std::uintmax_t)interval *
+                       (std::uintmax_t)ratio::num) +
+                      ((std::uintmax_t)ratio::den - 1U)) /
+                     (std::uintmax_t)ratio::den));
+  }
+
+  /**
+   * @brief   Suspends the invoking thread for the specified duration.
+   *
+   * @param[in] d           the duration
+   *
+   * @api
+   */
+  template <typename Rep, typename Period>
+  inline void sleepFor(std::chrono::duration<Rep, Period> d) {
+
+    chThdSleep(toInterval(d));
+  }
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::CriticalZone                                               *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   RAII scoped critical zone from thread context.
+   * @details The constructor and the destructor inline to @p chSysLock()
+   *          and @p chSysUnlock().
+   */
+  class CriticalZone {
+  public:
+    /**
+     * @brief   Enters the critical zone.
+     *
+     * @special
+     */
+    CriticalZone() {
+
+      chSysLock();
+    }
+
+    /**
+     * @brief   Leaves the critical zone.
+     *
+     * @special
+     */
+    ~CriticalZone() {
+
+      chSysUnlock();
+    }
+
+    CriticalZone(const CriticalZone &) = delete;
+    CriticalZone &operator=(const CriticalZone &) = delete;
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::CriticalZoneFromISR                                        *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   RAII scoped critical zone from ISR context.
+   * @details The constructor and the destructor inline to
+   *          @p chSysLockFromISR() and @p chSysUnlockFromISR().
+   */
+  class CriticalZoneFromISR {
+  public:
+    /**
+     * @brief   Enters the critical zone.
+     *
+     * @special
+     */
+    CriticalZoneFromISR() {
+
+      chSysLockFromISR();
+    }
+
+    /**
+     * @brief   Leaves the critical zone.
+     *
+     * @special
+     */
+    ~CriticalZoneFromISR() {
+
+      chSysUnlockFromISR();
+    }
+
+    CriticalZoneFromISR(const CriticalZoneFromISR &) = delete;
+    CriticalZoneFromISR &operator=(const CriticalZoneFromISR &) = delete;
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::SpscQueue                                                  *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Typed lock-free single producer single consumer queue.
+   * @details The queue can be used between two threads, a thread and an
+   *          ISR or two ISRs as long as there is exactly one producer
+   *          context and one consumer context. There is no locking and
+   *          no waiting, the operations fail if the queue is full or
+   *          empty.
+   *
+   * @param T               type of the queued elements, it must be
+   *                        trivially copyable
+   * @param N               queue size, it must be a power of two
+   */
+  template <typename T, std::size_t N>
+  class SpscQueue {
+
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "SpscQueue type must be trivially copyable");
+    static_assert((N > 0U) && ((N & (N - 1U)) == 0U),
+                  "SpscQueue size must be a power of two");
+
+  private:
+    T                           buffer[N];
+    std::atomic<std::size_t>    wrpos{0U};
+    std::atomic<std::size_t>    rdpos{0U};
+
+  public:
+    /**
+     * @brief   Inserts an element in the queue.
+     * @note    Must be called from the producer context only.
+     *
+     * @param[in] v         the element
+     * @return              The operation status.
+     * @retval true         if the element has been queued.
+     * @retval false        if the queue is full.
+     *
+     * @xclass
+     */
+    bool push(const T &v) noexcept {
+      std::size_t wr = wrpos.load(std::memory_order_relaxed);
+
+      if (wr - rdpos.load(std::memory_order_acquire) >= N) {
+        return false;
+      }
+      buffer[wr & (N - 1U)] = v;
+      wrpos.store(wr + 1U, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * @brief   Removes an element from the queue.
+     * @note    Must be called from the consumer context only.
+     *
+     * @param[out] v        the element
+     * @return              The operation status.
+     * @retval true         if an element has been removed.
+     * @retval false        if the queue is empty.
+     *
+     * @xclass
+     */
+    bool pop(T &v) noexcept {
+      std::size_t rd = rdpos.load(std::memory_order_relaxed);
+
+      if (rd == wrpos.load(std::memory_order_acquire)) {
+        return false;
+      }
+      v = buffer[rd & (N - 1U)];
+      rdpos.store(rd + 1U, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * @brief   Returns the number of queued elements.
+     *
+     * @xclass
+     */
+    std::size_t size() const noexcept {
+
+      return wrpos.load(std::memory_order_acquire) -
+             rdpos.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief   Returns @p true if the queue is empty.
+     *
+     * @xclass
+     */
+    bool empty() const noexcept {
+
+      return size() == 0U;
+    }
+
+    /**
+     * @brief   Returns the queue capacity.
+     *
+     * @xclass
+     */
+    static constexpr std::size_t capacity() noexcept {
+
+      return N;
+    }
+  };
+
+#if (CH_CFG_USE_OBJ_FIFOS == TRUE) || defined(__DOXYGEN__)
+  /*------------------------------------------------------------------------*
+   * chibios_rt::TypedObjectsFifo                                          *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Typed objects FIFO with its objects and messages storage.
+   * @details Objects are taken from the free pool, filled and sent, the
+   *          receiver returns them to the pool after use. All the methods
+   *          inline to the @p chFifo API.
+   * @note    Objects are never constructed nor destroyed, the pool hands
+   *          out raw storage.
+   *
+   * @param T               type of the objects, it must be trivially
+   *                        copyable and trivially default constructible
+   * @param N               number of objects
+   */
+  template <typename T, std::size_t N>
+  class TypedObjectsFifo {
+
+    static_assert(N > 0U, "TypedObjectsFifo size must be non-zero");
+    static_assert(std::is_trivially_copyable_v<T> &&
+                  std::is_trivially_default_constructible_v<T>,
+                  "TypedObjectsFifo type must be trivial");
+
+  private:
+    /* Objects are stored in slots respecting both the object alignment and
+       the natural alignment required by the pool free list.*/
+    static constexpr std::size_t align = alignof (T) > PORT_NATURAL_ALIGN ?
+                                         alignof (T) : PORT_NATURAL_ALIGN;
+    static constexpr std::size_t slot  = ((sizeof (T) + align - 1U) /
+                                          align) * align;
+
+    objects_fifo_t              fifo;
+    alignas(align) std::uint8_t objects[N * slot];
+    msg_t                       msgbuf[N];
+
+  public:
+    /**
+     * @brief   TypedObjectsFifo constructor.
+     *
+     * @init
+     */
+    TypedObjectsFifo() {
+
+      chFifoObjectInitAligned(&fifo, slot, N, (unsigned)align,
+                              static_cast<void *>(objects), msgbuf);
+    }
+
+    TypedObjectsFifo(const TypedObjectsFifo &) = delete;
+    TypedObjectsFifo &operator=(const TypedObjectsFifo &) = delete;
+
+    /**
+     * @brief   Allocates a free object.
+     *
+     * @return              The pointer to the allocated object.
+     * @retval nullptr      if an object is not immediately available.
+     *
+     * @iclass
+     */
+    T *takeObjectI() {
+
+      return static_cast<T *>(chFifoTakeObjectI(&fifo));
+    }
+
+    /**
+     * @brief   Allocates a free object.
+     *
+     * @param[in] timeout   the number of ticks before the operation timeouts
+     * @return              The pointer to the allocated object.
+     * @retval nullptr      if an object is not available within the
+     *                      specified timeout.
+     *
+     * @api
+     */
+    T *takeObject(sysinterval_t timeout) {
+
+      return static_cast<T *>(chFifoTakeObjectTimeout(&fifo, timeout));
+    }
+
+    /**
+     * @brief   Releases a object without sending it.
+     *
+     * @param[in] objp      pointer to the object to be released
+     *
+     * @iclass
+     */
+    void returnObjectI(T *objp) {
+
+      chFifoReturnObjectI(&fifo, static_cast<void *>(objp));
+    }
+
+    /**
+     * @brief   Releases a object without sending it.
+     *
+     * @param[in] objp      pointer to the object to be released
+     *
+     * @api
+     */
+    void returnObject(T *objp) {
+
+      chFifoReturnObject(&fifo, static_cast<void *>(objp));
+    }
+
+    /**
+     * @brief   Posts an object.
+     *
+     * @param[in] objp      pointer to the object to be posted
+     *
+     * @iclass
+     */
+    void sendObjectI(T *objp) {
+
+      chFifoSendObjectI(&fifo, static_cast<void *>(objp));
+    }
+
+    /**
+     * @brief   Posts an object.
+     *
+     * @param[in] objp      pointer to the object to be posted
+     *
+     * @api
+     */
+    void sendObject(T *objp) {
+
+      chFifoSendObject(&fifo, static_cast<void *>(objp));
+    }
+
+    /**
+     * @brief   Fetches an object.
+     *
+     * @param[out] objpp    pointer to the fetched object reference
+     * @return              The operation status.
+     * @retval MSG_OK       if an object has been correctly fetched.
+     * @retval MSG_TIMEOUT  if the FIFO is empty.
+     *
+     * @iclass
+     */
+    msg_t receiveObjectI(T *&objpp) {
+      void *p = nullptr;
+      msg_t msg = chFifoReceiveObjectI(&fifo, &p);
+
+      objpp = static_cast<T *>(p);
+
+      return msg;
+    }
+
+    /**
+     * @brief   Fetches an object.
+     *
+     * @param[out] objpp    pointer to the fetched object reference
+     * @param[in] timeout   the number of ticks before the operation timeouts
+     * @return              The operation status.
+     * @retval MSG_OK       if an object has been correctly fetched.
+     * @retval MSG_TIMEOUT  if the operation has timed out.
+     *
+     * @api
+     */
+    msg_t receiveObject(T *&objpp, sysinterval_t timeout) {
+      void *p = nullptr;
+      msg_t msg = chFifoReceiveObjectTimeout(&fifo, &p, timeout);
+
+      objpp = static_cast<T *>(p);
+
+      return msg;
+    }
+
+    /**
+     * @brief   Fetches an object.
+     *
+     * @param[out] objpp    pointer to the fetched object reference
+     * @param[in] d         the timeout as a @p std::chrono duration
+     * @return              The operation status.
+     * @retval MSG_OK       if an object has been correctly fetched.
+     * @retval MSG_TIMEOUT  if the operation has timed out.
+     *
+     * @api
+     */
+    template <typename Rep, typename Period>
+    msg_t receiveObject(T *&objpp, std::chrono::duration<Rep, Period> d) {
+
+      return receiveObject(objpp, toInterval(d));
+    }
+  };
+#endif /* CH_CFG_USE_OBJ_FIFOS == TRUE */
+}
+
+#endif /* _CHTYPED_HPP_ */
+
+/** @} */
@@ -1,10 +1,12 @@
-# LittleFS files.
-LITTLEFSSRC = $(CHIBIOS)/os/various/littlefs_bindings/lfs_hal.c \
-              $(CHIBIOS)/ext/littlefs/lfs.c \
-              $(CHIBIOS)/ext/littlefs/lfs_util.c
+# LittleFS files, the CRC module could be already required by other modules.
+LITTLEFSSRC := $(CHIBIOS)/os/various/littlefs_bindings/lfs_hal.c \
+               $(CHIBIOS)/ext/littlefs/lfs.c \
+               $(CHIBIOS)/ext/littlefs/lfs_util.c \
+               $(filter-out $(ALLCSRC),$(CHIBIOS)/os/common/utils/src/crc.c)
 
 LITTLEFSINC = $(CHIBIOS)/os/various/littlefs_bindings \
-              $(CHIBIOS)/ext/littlefs
+              $(CHIBIOS)/ext/littlefs \
+              $(CHIBIOS)/os/common/utils/include
 
 DDEFS      += -DLFS_THREADSAFE=1 -DLFS_NO_DEBUG=0 -DLFS_CONFIG=lfs_config.h
 
@@ -161,7 +161,11 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
     shellUsage(chp, "threads");
     return;
   }
+#if defined(CH_DBG_STACK_PROFILING) && (CH_DBG_STACK_PROFILING == TRUE)
+  chprintf(chp, "core stklimit    stack     addr refs prio stkmax     state         name" SHELL_NEWLINE_STR);
+#else
   chprintf(chp, "core stklimit    stack     addr refs prio     state         name" SHELL_NEWLINE_STR);
+#endif
   tp = chRegFirstThread();
   do {
     core_id_t core_id;
@@ -176,6 +180,18 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
 #else
     uint32_t stklimit = 0U;
 #endif
+#if defined(CH_DBG_STACK_PROFILING) && (CH_DBG_STACK_PROFILING == TRUE)
+    chprintf(chp, "%4lu %08lx %08lx %08lx %4lu %4lu %6lu %9s %12s" SHELL_NEWLINE_STR,
+             core_id,
+             stklimit,
+             (uint32_t)tp->ctx.sp,
+             (uint32_t)tp,
+             (uint32_t)tp->refs - 1,
+             (uint32_t)tp->hdr.pqueue.prio,
+             (uint32_t)chThdGetStackHighWaterX(tp),
+             states[tp->state],
+             tp->name == NULL ? "" : tp->name);
+#else
     chprintf(chp, "%4lu %08lx %08lx %08lx %4lu %4lu %9s %12s" SHELL_NEWLINE_STR,
              core_id,
              stklimit,
@@ -185,6 +201,7 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
              (uint32_t)tp->hdr.pqueue.prio,
              states[tp->state],
              tp->name == NULL ? "" : tp->name);
+#endif
     tp = chRegNextThread(tp);
   } while (tp != NULL);
 }
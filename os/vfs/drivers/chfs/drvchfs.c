@@ -24,6 +24,7 @@
  */
 
 #include "vfs.h"
+#include "crc.h"
 
 #if (VFS_CFG_ENABLE_DRV_CHFS == TRUE) || defined(__DOXYGEN__)
 
@@ -38,6 +39,55 @@
 #define b32(x)      (b16(x) | (b16(x) >>16))
 #define np2(x)      (b32(x-1) + 1)
 
+/**
+ * @name    On-flash format constants
+ * @{
+ */
+#define CHFS_SEGMENT_MAGIC                  0x53464843U
+#define CHFS_RECORD_MAGIC                   0x52464843U
+#define CHFS_CHECKPOINT_MAGIC               0x43464843U
+#define CHFS_CRC_INIT                       0xFFFFFFFFU
+#define CHFS_REC_INODE                      1U
+#define CHFS_REC_DATA                       2U
+#define CHFS_REC_DELETE                     3U
+#define CHFS_TYPE_FILE                      1U
+#define CHFS_TYPE_DIR                       2U
+/** @} */
+
+/**
+ * @name    Special values
+ * @{
+ */
+#define CHFS_INO_ROOT                       0U
+#define CHFS_INO_NONE                       0xFFFFU
+#define CHFS_SEG_NONE                       0xFFFFFFFFU
+/** @} */
+
+/**
+ * @brief   Maximum flash program alignment supported.
+ */
+#define CHFS_ALIGN_MAX                      32U
+
+/**
+ * @brief   Maximum size of a single data extent.
+ */
+#define CHFS_EXTENT_SIZE_MAX                32768U
+
+/**
+ * @brief   Size of the bounce buffer used for flash-to-flash copies.
+ */
+#define CHFS_COPY_SIZE                      64U
+
+/**
+ * @brief   Number of free segments reserved to the cleaner.
+ */
+#define CHFS_RESERVED_SEGMENTS              1U
+
+/**
+ * @brief   Size of the payload of an inode record.
+ */
+#define CHFS_INODE_PAYLOAD_SIZE             offsetof(chfs_inode_t, opens)
+
 /*===========================================================================*/
 /* Module local macros.                                                      */
 /*===========================================================================*/
@@ -55,6 +105,130 @@ struct vfs_chfs_driver_static_struct vfs_chfs_driver_static;
 /* Module local types.                                                       */
 /*===========================================================================*/
 
+/**
+ * @brief       Type of a log segment header.
+ */
+typedef struct chfs_segment_header {
+  /**
+   * @brief       Segment magic number.
+   */
+  uint32_t                  magic;
+  /**
+   * @brief       Segment sequence number.
+   */
+  uint32_t                  seq;
+  /**
+   * @brief       Segment erase count.
+   */
+  uint32_t                  erases;
+  /**
+   * @brief       Header CRC.
+   */
+  uint32_t                  crc;
+} chfs_segment_header_t;
+
+/**
+ * @brief       Type of a log record header.
+ */
+typedef struct chfs_record_header {
+  /**
+   * @brief       Record magic number.
+   */
+  uint32_t                  magic;
+  /**
+   * @brief       Record sequence number.
+   */
+  uint32_t                  seq;
+  /**
+   * @brief       Record type.
+   */
+  uint16_t                  type;
+  /**
+   * @brief       Inode the record refers to.
+   */
+  uint16_t                  ino;
+  /**
+   * @brief       File offset of the payload for data records.
+   */
+  uint32_t                  offset;
+  /**
+   * @brief       Payload size.
+   */
+  uint32_t                  size;
+  /**
+   * @brief       CRC of the header and of the payload.
+   */
+  uint32_t                  crc;
+} chfs_record_header_t;
+
+/**
+ * @brief       Type of a checkpoint header.
+ * @details     The header is followed by the inodes, segments and extents
+ *              tables, each one starting at an aligned offset.
+ */
+typedef struct chfs_checkpoint_header {
+  /**
+   * @brief       Checkpoint magic number.
+   */
+  uint32_t                  magic;
+  /**
+   * @brief       Checkpoint generation.
+   */
+  uint32_t                  gen;
+  /**
+   * @brief       First record sequence number not covered.
+   */
+  uint32_t                  rseq;
+  /**
+   * @brief       Next segment sequence number.
+   */
+  uint32_t                  sseq;
+  /**
+   * @brief       Log head segment.
+   */
+  uint32_t                  head;
+  /**
+   * @brief       Log head write offset.
+   */
+  uint32_t                  hoff;
+  /**
+   * @brief       Number of inodes in the checkpoint.
+   */
+  uint32_t                  inodes;
+  /**
+   * @brief       Number of segments in the checkpoint.
+   */
+  uint32_t                  nsegs;
+  /**
+   * @brief       Number of extents in the checkpoint.
+   */
+  uint32_t                  nextents;
+  /**
+   * @brief       CRC of the header and of the tables.
+   */
+  uint32_t                  crc;
+} chfs_checkpoint_header_t;
+
+/**
+ * @brief       Type of a log record payload source.
+ * @details     The payload comes either from a RAM buffer or from a range
+ *              of an existing file when the cleaner relocates data.
+ */
+typedef struct chfs_source {
+  /**
+   * @brief       RAM buffer or @p NULL if the source is a file.
+   */
+  const uint8_t             *buf;
+  /**
+   * @brief       Source file inode.
+   */
+  chfs_ino_t                ino;
+  /**
+   * @brief       Source file offset.
+   */
+  uint32_t                  offset;
+} chfs_source_t;
+
 /**
  * @class       vfs_chfs_dir_node_c
  * @extends     vfs_directory_node_c
@@ -83,6 +257,7 @@ struct vfs_chfs_dir_node_vmt {
   /* From vfs_directory_node_c.*/
   msg_t (*first)(void *ip, vfs_direntry_info_t *dip);
   msg_t (*next)(void *ip, vfs_direntry_info_t *dip);
+  msg_t (*many)(void *ip, vfs_direntry_info_t *dip, size_t n);
   /* From vfs_chfs_dir_node_c.*/
 };
 
@@ -106,6 +281,14 @@ struct vfs_chfs_dir_node {
    * @brief       Node mode information.
    */
   vfs_mode_t                mode;
+  /**
+   * @brief       Directory inode.
+   */
+  chfs_ino_t                ino;
+  /**
+   * @brief       Next inode to be scanned.
+   */
+  uint32_t                  index;
 };
 /** @} */
 
@@ -168,17 +351,56 @@ struct vfs_chfs_file_node {
    * @brief       Implemented interface @p sequential_stream_i.
    */
   sequential_stream_i       stm;
+  /**
+   * @brief       File inode.
+   */
+  chfs_ino_t                ino;
+  /**
+   * @brief       File open flags.
+   */
+  int                       oflag;
+  /**
+   * @brief       Current file position.
+   */
+  uint32_t                  pos;
+  /**
+   * @brief       File offset of the buffered data.
+   */
+  uint32_t                  wboff;
+  /**
+   * @brief       Number of bytes in the write buffer.
+   */
+  uint32_t                  wbn;
+  /**
+   * @brief       Write buffer.
+   */
+  uint8_t                   wbuf[DRV_CFG_CHFS_WRITE_BUFFER_SIZE];
 };
 /** @} */
 
 /**
- * @brief       Global state of @p vfs_chfs_driver_c.
+ * @brief       Type of a flash objects cache buffer.
  */
-struct vfs_chfs_driver_static_struct {
+typedef struct chfs_cache_buffer chfs_cache_buffer_t;
+
+/**
+ * @brief       Structure representing a flash objects cache buffer.
+ */
+struct chfs_cache_buffer {
+  /**
+   * @brief       Cached object header.
+   */
+  oc_object_t               obj;
   /**
-   * @brief       Pool of file info objects.
+   * @brief       Buffered flash data.
    */
-  memory_pool_t             info_nodes_pool;
+  uint8_t                   data[DRV_CFG_CHFS_CACHE_BUFFER_SIZE];
+};
+
+/**
+ * @brief       Global state of @p vfs_chfs_driver_c.
+ */
+struct vfs_chfs_driver_static_struct {
   /**
    * @brief       Pool of directory nodes.
    */
@@ -206,7 +428,7 @@ struct vfs_chfs_driver_static_struct {
   /**
    * @brief       Array of cached objects.
    */
-  oc_object_t               cache_objects[DRV_CFG_CHFS_CACHE_BUFFERS_NUM];
+  chfs_cache_buffer_t       cache_objects[DRV_CFG_CHFS_CACHE_BUFFERS_NUM];
 };
 
 /*===========================================================================*/
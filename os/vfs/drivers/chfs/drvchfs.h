@@ -28,6 +28,7 @@
 
 #if (VFS_CFG_ENABLE_DRV_CHFS == TRUE) || defined(__DOXYGEN__)
 
+#include "hal.h"
 #include "oop_sequential_stream.h"
 
 /*===========================================================================*/
@@ -57,11 +58,71 @@
 #endif
 
 /**
- * @brief       Number of file nodes pre-allocated in the pool.
+ * @brief       Number of buffers in the flash objects cache.
  */
 #if !defined(DRV_CFG_CHFS_CACHE_BUFFERS_NUM) || defined(__DOXYGEN__)
 #define DRV_CFG_CHFS_CACHE_BUFFERS_NUM      2
 #endif
+
+/**
+ * @brief       Size of a flash objects cache buffer.
+ * @note        Must be a power of two and a divider of the flash sector
+ *              size.
+ */
+#if !defined(DRV_CFG_CHFS_CACHE_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_CACHE_BUFFER_SIZE      256
+#endif
+
+/**
+ * @brief       Size of the write buffer associated to each file node.
+ * @note        Small writes are gathered in this buffer and appended to
+ *              the log as a single data record.
+ */
+#if !defined(DRV_CFG_CHFS_WRITE_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_WRITE_BUFFER_SIZE      256
+#endif
+
+/**
+ * @brief       Maximum number of inodes in a volume.
+ * @note        The inode zero is reserved for the root directory.
+ */
+#if !defined(DRV_CFG_CHFS_INODES_NUM) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_INODES_NUM             32
+#endif
+
+/**
+ * @brief       Maximum number of data extents in a volume.
+ */
+#if !defined(DRV_CFG_CHFS_EXTENTS_NUM) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_EXTENTS_NUM            256
+#endif
+
+/**
+ * @brief       Maximum number of log segments in a volume.
+ * @note        A segment is a flash sector.
+ */
+#if !defined(DRV_CFG_CHFS_SEGMENTS_NUM) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_SEGMENTS_NUM           64
+#endif
+
+/**
+ * @brief       Number of log segments written between checkpoints.
+ * @details     This setting bounds the amount of log to be replayed on
+ *              mount.
+ */
+#if !defined(DRV_CFG_CHFS_CHECKPOINT_INTERVAL) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_CHECKPOINT_INTERVAL    4
+#endif
+
+/**
+ * @brief       Erase count difference triggering static wear leveling.
+ * @details     When the difference between the most and the least erased
+ *              segments exceeds this value then the cold data in the least
+ *              erased segment is moved in order to put it back in use.
+ */
+#if !defined(DRV_CFG_CHFS_WEAR_LEVELING_DELTA) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_WEAR_LEVELING_DELTA    32
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -83,6 +144,42 @@
 #error "invalid DRV_CFG_CHFS_CACHE_BUFFERS_NUM value"
 #endif
 
+/* Checks on DRV_CFG_CHFS_CACHE_BUFFER_SIZE configuration.*/
+#if (DRV_CFG_CHFS_CACHE_BUFFER_SIZE < 64) ||                                \
+    ((DRV_CFG_CHFS_CACHE_BUFFER_SIZE & (DRV_CFG_CHFS_CACHE_BUFFER_SIZE - 1)) != 0)
+#error "invalid DRV_CFG_CHFS_CACHE_BUFFER_SIZE value"
+#endif
+
+/* Checks on DRV_CFG_CHFS_WRITE_BUFFER_SIZE configuration.*/
+#if DRV_CFG_CHFS_WRITE_BUFFER_SIZE < 16
+#error "invalid DRV_CFG_CHFS_WRITE_BUFFER_SIZE value"
+#endif
+
+/* Checks on DRV_CFG_CHFS_INODES_NUM configuration.*/
+#if (DRV_CFG_CHFS_INODES_NUM < 2) || (DRV_CFG_CHFS_INODES_NUM > 65535)
+#error "invalid DRV_CFG_CHFS_INODES_NUM value"
+#endif
+
+/* Checks on DRV_CFG_CHFS_EXTENTS_NUM configuration.*/
+#if DRV_CFG_CHFS_EXTENTS_NUM < 4
+#error "invalid DRV_CFG_CHFS_EXTENTS_NUM value"
+#endif
+
+/* Checks on DRV_CFG_CHFS_SEGMENTS_NUM configuration.*/
+#if DRV_CFG_CHFS_SEGMENTS_NUM < 3
+#error "invalid DRV_CFG_CHFS_SEGMENTS_NUM value"
+#endif
+
+/* Checks on DRV_CFG_CHFS_CHECKPOINT_INTERVAL configuration.*/
+#if DRV_CFG_CHFS_CHECKPOINT_INTERVAL < 1
+#error "invalid DRV_CFG_CHFS_CHECKPOINT_INTERVAL value"
+#endif
+
+/* Checks on DRV_CFG_CHFS_WEAR_LEVELING_DELTA configuration.*/
+#if DRV_CFG_CHFS_WEAR_LEVELING_DELTA < 1
+#error "invalid DRV_CFG_CHFS_WEAR_LEVELING_DELTA value"
+#endif
+
 #if CH_CFG_USE_OBJ_CACHES != TRUE
 #error "VFS CHFS driver requires CH_CFG_USE_OBJ_CACHES"
 #endif
@@ -95,19 +192,117 @@
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief       Type of a ChibiFS inode number.
+ */
+typedef uint16_t chfs_ino_t;
+
 /**
  * @brief       Type of a ChibiFS configuration structure.
  */
 typedef struct chfs_config chfs_config_t;
 
+/**
+ * @brief       Type of a ChibiFS inode structure.
+ */
+typedef struct chfs_inode chfs_inode_t;
+
+/**
+ * @brief       Type of a ChibiFS data extent structure.
+ */
+typedef struct chfs_extent chfs_extent_t;
+
+/**
+ * @brief       Type of a ChibiFS log segment structure.
+ */
+typedef struct chfs_segment chfs_segment_t;
+
 /**
  * @brief       Structure representing a ChibiFS configuration.
  */
 struct chfs_config {
   /**
-   * @brief       Block device associated to this ChibiFS instance.
+   * @brief       Flash device associated to this ChibiFS instance.
+   */
+  BaseFlash                 *flp;
+  /**
+   * @brief       First flash sector used by the volume.
    */
-  const void                *blkdev;
+  flash_sector_t            base;
+  /**
+   * @brief       Number of flash sectors used by the volume.
+   * @note        Sectors must be contiguous and of uniform size.
+   */
+  flash_sector_t            sectors;
+};
+
+/**
+ * @brief       Structure representing a ChibiFS inode.
+ * @note        The fields up to @p name are also the payload of the inode
+ *              log records.
+ */
+struct chfs_inode {
+  /**
+   * @brief       Parent directory inode.
+   */
+  chfs_ino_t                parent;
+  /**
+   * @brief       Inode type, zero if the inode is not in use.
+   */
+  uint16_t                  type;
+  /**
+   * @brief       File size.
+   */
+  uint32_t                  size;
+  /**
+   * @brief       Node name.
+   */
+  char                      name[VFS_CFG_NAMELEN_MAX + 1];
+  /**
+   * @brief       Number of file nodes open on this inode.
+   */
+  uint16_t                  opens;
+};
+
+/**
+ * @brief       Structure representing a ChibiFS data extent.
+ * @details     An extent maps a range of a file to a range of the log.
+ */
+struct chfs_extent {
+  /**
+   * @brief       Owner inode.
+   */
+  chfs_ino_t                ino;
+  /**
+   * @brief       Extent size.
+   */
+  uint16_t                  size;
+  /**
+   * @brief       Extent offset within the file.
+   */
+  uint32_t                  offset;
+  /**
+   * @brief       Extent address within the volume.
+   */
+  uint32_t                  addr;
+};
+
+/**
+ * @brief       Structure representing a ChibiFS log segment.
+ */
+struct chfs_segment {
+  /**
+   * @brief       Segment sequence number, zero if the segment is free.
+   */
+  uint32_t                  seq;
+  /**
+   * @brief       Segment erase count.
+   */
+  uint32_t                  erases;
+  /**
+   * @brief       Live data bytes in the segment.
+   */
+  uint32_t                  live;
 };
 
 /**
@@ -160,13 +355,81 @@ struct vfs_chfs_driver {
    */
   const struct chfs_config  *cfgp;
   /**
-   * @brief       Current working directory node.
+   * @brief       Current working directory inode.
    */
-  struct vfs_chfs_dir_node  *cwd;
+  chfs_ino_t                cwd;
   /**
    * @brief       Current working directory path.
    */
   char                      path_cwd[VFS_CFG_PATHLEN_MAX + 1];
+  /**
+   * @brief       Volume offset within the flash device.
+   */
+  flash_offset_t            offset;
+  /**
+   * @brief       Segment size.
+   */
+  uint32_t                  segsize;
+  /**
+   * @brief       Flash program alignment.
+   */
+  uint32_t                  align;
+  /**
+   * @brief       Address of the first log segment.
+   */
+  uint32_t                  logbase;
+  /**
+   * @brief       Number of log segments.
+   */
+  uint32_t                  nsegs;
+  /**
+   * @brief       Current log head segment.
+   */
+  uint32_t                  head;
+  /**
+   * @brief       Next write offset within the log head segment.
+   */
+  uint32_t                  hoff;
+  /**
+   * @brief       Next log record sequence number.
+   */
+  uint32_t                  rseq;
+  /**
+   * @brief       Next log segment sequence number.
+   */
+  uint32_t                  sseq;
+  /**
+   * @brief       Last checkpoint generation.
+   */
+  uint32_t                  cpgen;
+  /**
+   * @brief       Checkpoint slot in use.
+   */
+  uint32_t                  cpslot;
+  /**
+   * @brief       Next checkpoint offset within the slot in use.
+   */
+  uint32_t                  cpoff;
+  /**
+   * @brief       Sequence number of the log head at last checkpoint.
+   */
+  uint32_t                  cpseq;
+  /**
+   * @brief       Number of extents in use.
+   */
+  uint32_t                  nextents;
+  /**
+   * @brief       Inodes table.
+   */
+  chfs_inode_t              inodes[DRV_CFG_CHFS_INODES_NUM];
+  /**
+   * @brief       Extents table ordered by inode and offset.
+   */
+  chfs_extent_t             extents[DRV_CFG_CHFS_EXTENTS_NUM];
+  /**
+   * @brief       Log segments table.
+   */
+  chfs_segment_t            segments[DRV_CFG_CHFS_SEGMENTS_NUM];
 };
 /** @} */
 
@@ -78,6 +78,7 @@ struct vfs_littlefs_dir_node_vmt {
   /* From vfs_directory_node_c.*/
   msg_t (*first)(void *ip, vfs_direntry_info_t *dip);
   msg_t (*next)(void *ip, vfs_direntry_info_t *dip);
+  msg_t (*many)(void *ip, vfs_direntry_info_t *dip, size_t n);
   /* From vfs_littlefs_dir_node_c.*/
 };
 
@@ -55,6 +55,34 @@
 #if !defined(DRV_CFG_OVERLAY_DIR_NODES_NUM) || defined(__DOXYGEN__)
 #define DRV_CFG_OVERLAY_DIR_NODES_NUM       1
 #endif
+
+/**
+ * @brief       Number of entries in the path lookup cache.
+ * @note        Zero disables the cache.
+ */
+#if !defined(DRV_CFG_OVERLAY_DCACHE_ENTRIES) || defined(__DOXYGEN__)
+#define DRV_CFG_OVERLAY_DCACHE_ENTRIES      0
+#endif
+
+/**
+ * @brief       Maximum length of a path stored in the lookup cache.
+ * @note        Lookups of longer paths are not cached.
+ */
+#if !defined(DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX) || defined(__DOXYGEN__)
+#define DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX  63
+#endif
+
+/**
+ * @brief       Lifetime of the lookup cache entries in milliseconds.
+ * @note        Entries are invalidated by the namespace operations performed
+ *              through the overlay, the lifetime bounds how long changes
+ *              performed bypassing the overlay are not seen.
+ * @note        Size and time of regular files are never served from the
+ *              cache, only the lookup of the owning driver is.
+ */
+#if !defined(DRV_CFG_OVERLAY_DCACHE_TIMEOUT) || defined(__DOXYGEN__)
+#define DRV_CFG_OVERLAY_DCACHE_TIMEOUT      1000
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -71,6 +99,22 @@
 #error "invalid DRV_CFG_OVERLAY_DIR_NODES_NUM value"
 #endif
 
+/* Checks on DRV_CFG_OVERLAY_DCACHE_ENTRIES configuration.*/
+#if DRV_CFG_OVERLAY_DCACHE_ENTRIES < 0
+#error "invalid DRV_CFG_OVERLAY_DCACHE_ENTRIES value"
+#endif
+
+/* Checks on DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX configuration.*/
+#if (DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX < 1) ||                             \
+    (DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX > VFS_CFG_PATHLEN_MAX)
+#error "invalid DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX value"
+#endif
+
+/* Checks on DRV_CFG_OVERLAY_DCACHE_TIMEOUT configuration.*/
+#if DRV_CFG_OVERLAY_DCACHE_TIMEOUT < 1
+#error "invalid DRV_CFG_OVERLAY_DCACHE_TIMEOUT value"
+#endif
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -79,6 +123,76 @@
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+#if (DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0) || defined (__DOXYGEN__)
+/**
+ * @brief       Type of a path lookup cache entry.
+ */
+typedef struct vfs_overlay_dentry vfs_overlay_dentry_t;
+
+/**
+ * @brief       Type of the path lookup cache statistics.
+ */
+typedef struct vfs_overlay_dcache_stats vfs_overlay_dcache_stats_t;
+
+/**
+ * @brief       Structure representing a path lookup cache entry.
+ * @details     An entry caches the result of a lookup of a normalized
+ *              absolute path, both positive and negative (not found)
+ *              results are cached.
+ */
+struct vfs_overlay_dentry {
+  /**
+   * @brief       Hash of the path, zero if the entry is not in use.
+   */
+  uint32_t                  hash;
+  /**
+   * @brief       Time of the lookup.
+   */
+  systime_t                 time;
+  /**
+   * @brief       Registered driver handling the path or @p NULL.
+   */
+  vfs_driver_c              *driver;
+  /**
+   * @brief       Offset of the driver-relative part of the path.
+   */
+  size_t                    offset;
+  /**
+   * @brief       Lookup result, @p CH_RET_SUCCESS or @p CH_RET_ENOENT.
+   */
+  msg_t                     result;
+  /**
+   * @brief       Node information of a positive lookup.
+   */
+  vfs_stat_t                stat;
+  /**
+   * @brief       Normalized absolute path.
+   */
+  char                      path[DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX + 1];
+};
+
+/**
+ * @brief       Structure representing the path lookup cache statistics.
+ */
+struct vfs_overlay_dcache_stats {
+  /**
+   * @brief       Lookups satisfied by the cache.
+   */
+  uint32_t                  hits;
+  /**
+   * @brief       Lookups not satisfied by the cache.
+   * @note        Regular files information is always asked to the
+   *              drivers, such lookups are misses even if the entry is
+   *              cached.
+   */
+  uint32_t                  misses;
+  /**
+   * @brief       Entries dropped because invalidated or expired.
+   */
+  uint32_t                  invalidations;
+};
+#endif /* DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0 */
+
 /**
  * @class       vfs_overlay_dir_node_c
  * @extends     vfs_directory_node_c
@@ -107,6 +221,7 @@ struct vfs_overlay_dir_node_vmt {
   /* From vfs_directory_node_c.*/
   msg_t (*first)(void *ip, vfs_direntry_info_t *dip);
   msg_t (*next)(void *ip, vfs_direntry_info_t *dip);
+  msg_t (*many)(void *ip, vfs_direntry_info_t *dip, size_t n);
   /* From vfs_overlay_dir_node_c.*/
 };
 
@@ -189,6 +304,16 @@ struct vfs_overlay_driver {
   const char                *names[DRV_CFG_OVERLAY_DRV_MAX];
   vfs_driver_c              *drivers[DRV_CFG_OVERLAY_DRV_MAX];
   char                      buf[VFS_CFG_PATHLEN_MAX + 1];
+#if (DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0) || defined (__DOXYGEN__)
+  /**
+   * @brief       Path lookup cache entries.
+   */
+  vfs_overlay_dentry_t      dcache[DRV_CFG_OVERLAY_DCACHE_ENTRIES];
+  /**
+   * @brief       Path lookup cache statistics.
+   */
+  vfs_overlay_dcache_stats_t dcache_stats;
+#endif /* DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0 */
 };
 /** @} */
 
@@ -221,6 +346,7 @@ extern "C" {
   msg_t __ovldir_stat_impl(void *ip, vfs_stat_t *sp);
   msg_t __ovldir_first_impl(void *ip, vfs_direntry_info_t *dip);
   msg_t __ovldir_next_impl(void *ip, vfs_direntry_info_t *dip);
+  msg_t __ovldir_many_impl(void *ip, vfs_direntry_info_t *dip, size_t n);
   /* Methods of vfs_overlay_driver_c.*/
   void *__ovldrv_objinit_impl(void *ip, const void *vmt,
                               vfs_driver_c *overlaid_drv,
@@ -240,6 +366,10 @@ extern "C" {
   msg_t __ovldrv_rmdir_impl(void *ip, const char *path);
   msg_t ovldrvRegisterDriver(void *ip, vfs_driver_c *vdp, const char *name);
   msg_t ovldrvUnregisterDriver(void *ip, const char *name);
+#if (DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0) || defined (__DOXYGEN__)
+  void ovldrvCacheFlush(void *ip);
+  void ovldrvCacheGetStats(void *ip, vfs_overlay_dcache_stats_t *statsp);
+#endif /* DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0 */
   /* Regular functions.*/
   void __drv_overlay_init(void);
 #ifdef __cplusplus
@@ -119,6 +119,21 @@
 #include "drvtmplfs.h"
 #endif
 
+/**
+ * @brief   Type of an I/O vector element.
+ * @note    Layout compatible with the Posix @p struct @p iovec.
+ */
+typedef struct vfs_iovec {
+  /**
+   * @brief   Pointer to the element buffer.
+   */
+  void                      *iov_base;
+  /**
+   * @brief   Size of the element buffer.
+   */
+  size_t                    iov_len;
+} vfs_iovec_t;
+
 /* Application code is supposed to export this symbol, it is expected to
    exists.*/
 extern vfs_driver_c *vfs_root;
@@ -143,8 +158,14 @@ extern "C" {
                               vfs_direntry_info_t *dip);
   msg_t vfsReadDirectoryNext(vfs_directory_node_c *vdnp,
                              vfs_direntry_info_t *dip);
+  msg_t vfsReadDirectoryMany(vfs_directory_node_c *vdnp,
+                             vfs_direntry_info_t *dip, size_t n);
   ssize_t vfsReadFile(vfs_file_node_c *vfnp, uint8_t *buf, size_t n);
   ssize_t vfsWriteFile(vfs_file_node_c *vfnp, const uint8_t *buf, size_t n);
+  ssize_t vfsReadFileV(vfs_file_node_c *vfnp,
+                       const vfs_iovec_t *iov, unsigned iovcnt);
+  ssize_t vfsWriteFileV(vfs_file_node_c *vfnp,
+                        const vfs_iovec_t *iov, unsigned iovcnt);
   msg_t vfsSetFilePosition(vfs_file_node_c *vfnp,
                            vfs_offset_t offset,
                            vfs_seekmode_t whence);
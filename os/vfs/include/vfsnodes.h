@@ -75,6 +75,14 @@
 #define VFS_SEEK_END                        SEEK_END
 /** @} */
 
+/**
+ * @name    Node serial numbers
+ * @{
+ */
+#define VFS_INO_DRIVER_MASK                 0x7FFFFFFFU
+#define VFS_INO_RESERVED_BASE               0x80000000U
+/** @} */
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -131,6 +139,14 @@ struct vfs_direntry_info {
    * @brief       Size of the node.
    */
   vfs_offset_t              size;
+  /**
+   * @brief       Serial number of the node, zero if not supported by the
+   *              driver.
+   * @note        Drivers only use the bits in @p VFS_INO_DRIVER_MASK, the
+   *              other values are reserved to nodes not backed by a file
+   *              system, like the overlay mount points.
+   */
+  uint32_t                  ino;
   /**
    * @brief       Name of the node.
    */
@@ -149,6 +165,16 @@ struct vfs_stat {
    * @brief       Size of the node.
    */
   vfs_offset_t              size;
+  /**
+   * @brief       Modification time in a driver-defined format, zero if not
+   *              supported by the driver.
+   */
+  uint32_t                  mtime;
+  /**
+   * @brief       Serial number of the node, same as in directory entries,
+   *              zero if not supported by the driver.
+   */
+  uint32_t                  ino;
 };
 
 /**
@@ -231,6 +257,7 @@ struct vfs_directory_node_vmt {
   /* From vfs_directory_node_c.*/
   msg_t (*first)(void *ip, vfs_direntry_info_t *dip);
   msg_t (*next)(void *ip, vfs_direntry_info_t *dip);
+  msg_t (*many)(void *ip, vfs_direntry_info_t *dip, size_t n);
 };
 
 /**
@@ -331,6 +358,7 @@ extern "C" {
   void __vfsdir_dispose_impl(void *ip);
   msg_t __vfsdir_first_impl(void *ip, vfs_direntry_info_t *dip);
   msg_t __vfsdir_next_impl(void *ip, vfs_direntry_info_t *dip);
+  msg_t __vfsdir_many_impl(void *ip, vfs_direntry_info_t *dip, size_t n);
   /* Methods of vfs_file_node_c.*/
   void *__vfsfile_objinit_impl(void *ip, const void *vmt, vfs_driver_c *driver,
                                vfs_mode_t mode);
@@ -405,6 +433,28 @@ static inline msg_t vfsDirReadNext(void *ip, vfs_direntry_info_t *dip) {
 
   return self->vmt->next(ip, dip);
 }
+
+/**
+ * @brief       Next directory entries.
+ * @details     Reads up to @p n entries in a single call, the default
+ *              implementation iterates @p vfsDirReadNext().
+ *
+ * @param[in,out] ip            Pointer to a @p vfs_directory_node_c instance.
+ * @param[out]    dip           Pointer to an array of @p vfs_direntry_info_t
+ *                              structures.
+ * @param[in]     n             Number of elements in the array.
+ * @return                      The number of entries read or an error, zero
+ *                              means end-of-directory.
+ *
+ * @api
+ */
+CC_FORCE_INLINE
+static inline msg_t vfsDirReadMany(void *ip, vfs_direntry_info_t *dip,
+                                   size_t n) {
+  vfs_directory_node_c *self = (vfs_directory_node_c *)ip;
+
+  return self->vmt->many(ip, dip, n);
+}
 /** @} */
 
 /**
@@ -292,6 +292,29 @@ msg_t vfsReadDirectoryNext(vfs_directory_node_c *vdnp,
   return vfsDirReadNext((void *)vdnp, dip);
 }
 
+/**
+ * @brief   Next directory entries.
+ * @details The function reads up to @p n entries in a single call, it is
+ *          equivalent to repeated calls to @p vfsReadDirectoryNext() but
+ *          drivers can implement it more efficiently.
+ *
+ * @param[in] vdnp      Pointer to the @p vfs_directory_node_c object.
+ * @param[out] dip      Pointer to an array of @p vfs_direntry_info_t
+ *                      structures.
+ * @param[in] n         Number of elements in the array.
+ * @return              The number of entries read or an error.
+ * @retval 0            Zero entries read, end-of-directory condition.
+ *
+ * @api
+ */
+msg_t vfsReadDirectoryMany(vfs_directory_node_c *vdnp,
+                           vfs_direntry_info_t *dip, size_t n) {
+
+  chDbgAssert(vdnp->references > 0U, "zero count");
+
+  return vfsDirReadMany((void *)vdnp, dip, n);
+}
+
 /**
  * @brief   File node read.
  * @details The function reads data from a file node into a buffer.
@@ -328,6 +351,97 @@ ssize_t vfsWriteFile(vfs_file_node_c *vfnp, const uint8_t *buf, size_t n) {
   return vfsFileWrite((void *)vfnp, buf, n);
 }
 
+/**
+ * @brief   File node vectored read.
+ * @details The function reads data from a file node into the buffers of an
+ *          I/O vector, the buffers are filled in order.
+ * @note    Each buffer is passed whole to the file system, large buffers
+ *          are transferred directly, bypassing the file system sector or
+ *          block buffer, when the file position is aligned.
+ *
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @param[in] iov       Pointer to the I/O vector.
+ * @param[in] iovcnt    Number of elements in the I/O vector.
+ * @return              The transferred number of bytes or an error, an error
+ *                      is returned only if no data has been transferred.
+ *
+ * @api
+ */
+ssize_t vfsReadFileV(vfs_file_node_c *vfnp,
+                     const vfs_iovec_t *iov, unsigned iovcnt) {
+  ssize_t total = 0;
+  unsigned i;
+
+  chDbgAssert(vfnp->references > 0U, "zero count");
+
+  for (i = 0U; i < iovcnt; i++) {
+    ssize_t n;
+
+    if (iov[i].iov_len == (size_t)0) {
+      continue;
+    }
+
+    n = vfsFileRead((void *)vfnp, (uint8_t *)iov[i].iov_base, iov[i].iov_len);
+    if (CH_RET_IS_ERROR(n)) {
+      return total > 0 ? total : n;
+    }
+    total += n;
+
+    /* Stopping on end-of-file.*/
+    if ((size_t)n < iov[i].iov_len) {
+      break;
+    }
+  }
+
+  return total;
+}
+
+/**
+ * @brief   File node vectored write.
+ * @details The function writes data from the buffers of an I/O vector to a
+ *          file node, the buffers are written in order.
+ * @note    Each buffer is passed whole to the file system, large buffers
+ *          are transferred directly, bypassing the file system sector or
+ *          block buffer, when the file position is aligned.
+ *
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @param[in] iov       Pointer to the I/O vector.
+ * @param[in] iovcnt    Number of elements in the I/O vector.
+ * @return              The transferred number of bytes or an error, an error
+ *                      is returned only if no data has been transferred.
+ *
+ * @api
+ */
+ssize_t vfsWriteFileV(vfs_file_node_c *vfnp,
+                      const vfs_iovec_t *iov, unsigned iovcnt) {
+  ssize_t total = 0;
+  unsigned i;
+
+  chDbgAssert(vfnp->references > 0U, "zero count");
+
+  for (i = 0U; i < iovcnt; i++) {
+    ssize_t n;
+
+    if (iov[i].iov_len == (size_t)0) {
+      continue;
+    }
+
+    n = vfsFileWrite((void *)vfnp, (const uint8_t *)iov[i].iov_base,
+                     iov[i].iov_len);
+    if (CH_RET_IS_ERROR(n)) {
+      return total > 0 ? total : n;
+    }
+    total += n;
+
+    /* Stopping on a partial write, no space left.*/
+    if ((size_t)n < iov[i].iov_len) {
+      break;
+    }
+  }
+
+  return total;
+}
+
 /**
  * @brief   Changes the current file position.
  *
@@ -115,6 +115,8 @@ msg_t __vfsnode_stat_impl(void *ip, vfs_stat_t *sp) {
 
   sp->mode = self->mode;
   sp->size = (vfs_offset_t)0;
+  sp->mtime = 0U;
+  sp->ino = 0U;
 
   return CH_RET_SUCCESS;
 }
@@ -199,6 +201,37 @@ msg_t __vfsdir_next_impl(void *ip, vfs_direntry_info_t *dip) {
 
   return CH_RET_ENOSYS;
 }
+
+/**
+ * @brief       Implementation of method @p vfsDirReadMany().
+ * @note        This function is meant to be used by derived classes.
+ *
+ * @param[in,out] ip            Pointer to a @p vfs_directory_node_c instance.
+ * @param[out]    dip           Pointer to an array of @p vfs_direntry_info_t
+ *                              structures.
+ * @param[in]     n             Number of elements in the array.
+ * @return                      The number of entries read or an error, zero
+ *                              means end-of-directory.
+ */
+msg_t __vfsdir_many_impl(void *ip, vfs_direntry_info_t *dip, size_t n) {
+  vfs_directory_node_c *self = (vfs_directory_node_c *)ip;
+  size_t i;
+
+  for (i = (size_t)0; i < n; i++) {
+    msg_t ret;
+
+    ret = self->vmt->next(ip, &dip[i]);
+    if (ret <= (msg_t)0) {
+      /* Returning the entries already read, if any.*/
+      if (i == (size_t)0) {
+        return ret;
+      }
+      break;
+    }
+  }
+
+  return (msg_t)i;
+}
 /** @} */
 
 /*===========================================================================*/
@@ -123,6 +123,28 @@
 #define DRV_CFG_OVERLAY_DIR_NODES_NUM       1
 #endif
 
+/**
+ * @brief   Number of entries in the path lookup cache.
+ * @note    Zero disables the cache.
+ */
+#if !defined(DRV_CFG_OVERLAY_DCACHE_ENTRIES) || defined(__DOXYGEN__)
+#define DRV_CFG_OVERLAY_DCACHE_ENTRIES      0
+#endif
+
+/**
+ * @brief   Maximum length of a path stored in the lookup cache.
+ */
+#if !defined(DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX) || defined(__DOXYGEN__)
+#define DRV_CFG_OVERLAY_DCACHE_PATHLEN_MAX  63
+#endif
+
+/**
+ * @brief   Lifetime of the lookup cache entries in milliseconds.
+ */
+#if !defined(DRV_CFG_OVERLAY_DCACHE_TIMEOUT) || defined(__DOXYGEN__)
+#define DRV_CFG_OVERLAY_DCACHE_TIMEOUT      1000
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -169,6 +191,62 @@
 #define DRV_CFG_CHFS_FILE_NODES_NUM         1
 #endif
 
+/**
+ * @brief   Number of buffers in the flash objects cache.
+ */
+#if !defined(DRV_CFG_CHFS_CACHE_BUFFERS_NUM) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_CACHE_BUFFERS_NUM      2
+#endif
+
+/**
+ * @brief   Size of a flash objects cache buffer.
+ */
+#if !defined(DRV_CFG_CHFS_CACHE_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_CACHE_BUFFER_SIZE      256
+#endif
+
+/**
+ * @brief   Size of the write buffer associated to each file node.
+ */
+#if !defined(DRV_CFG_CHFS_WRITE_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_WRITE_BUFFER_SIZE      256
+#endif
+
+/**
+ * @brief   Maximum number of inodes in a volume.
+ */
+#if !defined(DRV_CFG_CHFS_INODES_NUM) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_INODES_NUM             32
+#endif
+
+/**
+ * @brief   Maximum number of data extents in a volume.
+ */
+#if !defined(DRV_CFG_CHFS_EXTENTS_NUM) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_EXTENTS_NUM            256
+#endif
+
+/**
+ * @brief   Maximum number of log segments in a volume.
+ */
+#if !defined(DRV_CFG_CHFS_SEGMENTS_NUM) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_SEGMENTS_NUM           64
+#endif
+
+/**
+ * @brief   Number of log segments written between checkpoints.
+ */
+#if !defined(DRV_CFG_CHFS_CHECKPOINT_INTERVAL) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_CHECKPOINT_INTERVAL    4
+#endif
+
+/**
+ * @brief   Erase count difference triggering static wear leveling.
+ */
+#if !defined(DRV_CFG_CHFS_WEAR_LEVELING_DELTA) || defined(__DOXYGEN__)
+#define DRV_CFG_CHFS_WEAR_LEVELING_DELTA    32
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -3,7 +3,7 @@
 # Dependencies.
 include $(CHIBIOS)/os/common/oop/oop.mk
 
-# Required files.
+# Required files, the CRC module could be already required by other modules.
 VFSSRC := $(CHIBIOS)/os/vfs/src/vfspaths.c \
           $(CHIBIOS)/os/vfs/src/vfsparser.c \
           $(CHIBIOS)/os/vfs/src/vfsbuffers.c \
@@ -15,7 +15,8 @@ VFSSRC := $(CHIBIOS)/os/vfs/src/vfspaths.c \
           $(CHIBIOS)/os/vfs/drivers/fatfs/drvfatfs.c \
           $(CHIBIOS)/os/vfs/drivers/littlefs/drvlittlefs.c \
           $(CHIBIOS)/os/vfs/drivers/overlay/drvoverlay.c \
-          $(CHIBIOS)/os/vfs/drivers/streams/drvstreams.c
+          $(CHIBIOS)/os/vfs/drivers/streams/drvstreams.c \
+          $(filter-out $(ALLCSRC),$(CHIBIOS)/os/common/utils/src/crc.c)
 
 # Required include directories
 VFSINC := $(CHIBIOS)/os/common/include \
@@ -25,7 +26,8 @@ VFSINC := $(CHIBIOS)/os/common/include \
           $(CHIBIOS)/os/vfs/drivers/fatfs \
           $(CHIBIOS)/os/vfs/drivers/littlefs \
           $(CHIBIOS)/os/vfs/drivers/overlay \
-          $(CHIBIOS)/os/vfs/drivers/streams
+          $(CHIBIOS)/os/vfs/drivers/streams \
+          $(CHIBIOS)/os/common/utils/include
 
 # Shared variables
 ALLCSRC += $(VFSSRC)
@@ -753,6 +753,124 @@ struct hal_buffered_sio {
 };
 /** @} */
 
+/**
+ * @class       hal_block_buffered_sio_c
+ * @extends     hal_base_driver_c
+ * @implements  asynchronous_channel_i
+ *
+ * @brief       This class implements a buffered channel interface on top of
+ *              SIO using queues of data blocks.
+ * @details     Data is moved between the SIO FIFOs and the blocks using
+ *              multi-frame FIFO operations, threads are only involved when a
+ *              whole block has been received or transmitted. A partially
+ *              filled RX block is made available when the line goes idle, a
+ *              partially filled TX block is sent when the transmitter has
+ *              nothing else to send.
+ * @note        Blocks can also be accessed directly using the buffers queues
+ *              API on the @p ibqueue and @p obqueue fields.
+ *
+ * @name        Class @p hal_block_buffered_sio_c structures
+ * @{
+ */
+
+/**
+ * @brief       Type of a block-buffered SIO wrapper class.
+ */
+typedef struct hal_block_buffered_sio hal_block_buffered_sio_c;
+
+/**
+ * @brief       Class @p hal_block_buffered_sio_c virtual methods table.
+ */
+struct hal_block_buffered_sio_vmt {
+  /* From base_object_c.*/
+  void (*dispose)(void *ip);
+  /* From hal_base_driver_c.*/
+  msg_t (*start)(void *ip);
+  void (*stop)(void *ip);
+  const void * (*setcfg)(void *ip, const void *config);
+  const void * (*selcfg)(void *ip, unsigned cfgnum);
+  /* From hal_block_buffered_sio_c.*/
+};
+
+/**
+ * @brief       Structure representing a block-buffered SIO wrapper class.
+ */
+struct hal_block_buffered_sio {
+  /**
+   * @brief       Virtual Methods Table.
+   */
+  const struct hal_block_buffered_sio_vmt *vmt;
+  /**
+   * @brief       Driver state.
+   */
+  driver_state_t            state;
+  /**
+   * @brief       Associated configuration structure.
+   */
+  const void                *config;
+  /**
+   * @brief       Driver argument.
+   */
+  void                      *arg;
+#if (HAL_USE_MUTUAL_EXCLUSION == TRUE) || defined (__DOXYGEN__)
+  /**
+   * @brief       Driver mutex.
+   */
+  mutex_t                   mutex;
+#endif /* HAL_USE_MUTUAL_EXCLUSION == TRUE */
+#if (HAL_USE_REGISTRY == TRUE) || defined (__DOXYGEN__)
+  /**
+   * @brief       Driver identifier.
+   */
+  unsigned int              id;
+  /**
+   * @brief       Driver name.
+   */
+  const char                *name;
+  /**
+   * @brief       Registry link structure.
+   */
+  hal_regent_t              regent;
+#endif /* HAL_USE_REGISTRY == TRUE */
+  /**
+   * @brief       Implemented interface @p asynchronous_channel_i.
+   */
+  asynchronous_channel_i    chn;
+  /**
+   * @brief       Input buffers queue.
+   */
+  input_buffers_queue_t     ibqueue;
+  /**
+   * @brief       Output buffers queue.
+   */
+  output_buffers_queue_t    obqueue;
+  /**
+   * @brief       I/O condition event source.
+   */
+  event_source_t            event;
+  /**
+   * @brief       Pointer to the associated @p hal_sio_driver_c instance.
+   */
+  hal_sio_driver_c          *siop;
+  /**
+   * @brief       RX block being filled or @p NULL.
+   */
+  uint8_t                   *rxbuf;
+  /**
+   * @brief       Number of frames in the RX block being filled.
+   */
+  size_t                    rxn;
+  /**
+   * @brief       Next frame of the TX block being sent or @p NULL.
+   */
+  uint8_t                   *txptr;
+  /**
+   * @brief       Boundary of the TX block being sent.
+   */
+  uint8_t                   *txtop;
+};
+/** @} */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -787,6 +905,14 @@ extern "C" {
   msg_t __bsio_start_impl(void *ip);
   void __bsio_stop_impl(void *ip);
   const void *__bsio_setcfg_impl(void *ip, const void *config);
+  /* Methods of hal_block_buffered_sio_c.*/
+  void *__bbsio_objinit_impl(void *ip, const void *vmt, hal_sio_driver_c *siop,
+                             uint8_t *ib, size_t ibsize, size_t ibn,
+                             uint8_t *ob, size_t obsize, size_t obn);
+  void __bbsio_dispose_impl(void *ip);
+  msg_t __bbsio_start_impl(void *ip);
+  void __bbsio_stop_impl(void *ip);
+  const void *__bbsio_setcfg_impl(void *ip, const void *config);
   /* Regular functions.*/
   void sioInit(void);
 #ifdef __cplusplus
@@ -848,6 +974,67 @@ static inline hal_buffered_sio_c *bsioObjectInit(hal_buffered_sio_c *self,
 }
 /** @} */
 
+/**
+ * @name        Default constructor of hal_block_buffered_sio_c
+ * @{
+ */
+/**
+ * @brief       Default initialization function of @p
+ *              hal_block_buffered_sio_c.
+ *
+ * @param[out]    self          Pointer to a @p hal_block_buffered_sio_c
+ *                              instance to be initialized.
+ * @param[in]     siop          Pointer to the @p hal_sio_driver_c object.
+ * @param[in]     ib            Pointer to the input buffers area, it must be
+ *                              <tt>BQ_BUFFER_SIZE(ibn, ibsize)</tt> bytes.
+ * @param[in]     ibsize        Size of the input blocks.
+ * @param[in]     ibn           Number of input blocks.
+ * @param[in]     ob            Pointer to the output buffers area, it must be
+ *                              <tt>BQ_BUFFER_SIZE(obn, obsize)</tt> bytes.
+ * @param[in]     obsize        Size of the output blocks.
+ * @param[in]     obn           Number of output blocks.
+ * @return                      Pointer to the initialized object.
+ *
+ * @objinit
+ */
+CC_FORCE_INLINE
+static inline hal_block_buffered_sio_c *bbsioObjectInit(hal_block_buffered_sio_c *self,
+                                                        hal_sio_driver_c *siop,
+                                                        uint8_t *ib,
+                                                        size_t ibsize,
+                                                        size_t ibn,
+                                                        uint8_t *ob,
+                                                        size_t obsize,
+                                                        size_t obn) {
+  extern const struct hal_block_buffered_sio_vmt __hal_block_buffered_sio_vmt;
+
+  return __bbsio_objinit_impl(self, &__hal_block_buffered_sio_vmt, siop,
+                              ib, ibsize, ibn, ob, obsize, obn);
+}
+/** @} */
+
+/**
+ * @name        Inline methods of hal_block_buffered_sio_c
+ * @{
+ */
+/**
+ * @brief       Adds status flags to the flags mask.
+ * @details     This function is usually called from the I/O ISRs in order to
+ *              notify I/O conditions such as data events, errors, signal
+ *              changes etc.
+ *
+ * @param[in,out] ip            Pointer to a @p hal_block_buffered_sio_c
+ *                              instance.
+ * @param[in]     flags         Event flags to be added.
+ */
+CC_FORCE_INLINE
+static inline void bbsioAddFlagsI(void *ip, eventflags_t flags) {
+  hal_block_buffered_sio_c *self = (hal_block_buffered_sio_c *)ip;
+
+  osalEventBroadcastFlagsI(&self->event, flags);
+}
+/** @} */
+
 #endif /* HAL_USE_SIO == TRUE */
 
 #endif /* HAL_SIO_H */
@@ -428,6 +428,209 @@ size_t iqReadTimeout(input_queue_t *iqp, uint8_t *bp,
   return max - n;
 }
 
+/**
+ * @brief   Gets the contiguous empty span of an input queue.
+ * @details The function returns the largest empty region that can be
+ *          filled in place, without wrapping at the buffer end, it is meant
+ *          to be used by the low side for filling the queue without an
+ *          intermediate buffer, for example using a DMA.
+ * @note    The function always returns the same span if called repeatedly.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[out] np       size of the returned span
+ * @return              A pointer to the span to be filled.
+ * @retval NULL         if the queue is full.
+ *
+ * @iclass
+ */
+uint8_t *iqGetEmptySpanI(input_queue_t *iqp, size_t *np) {
+  size_t n;
+
+  osalDbgCheckClassI();
+
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  n = (size_t)(iqp->q_top - iqp->q_wrptr);
+  /*lint -restore*/
+  if (n > iqGetEmptyI(iqp)) {
+    n = iqGetEmptyI(iqp);
+  }
+
+  *np = n;
+  if (n == (size_t)0) {
+    return NULL;
+  }
+
+  return iqp->q_wrptr;
+}
+
+/**
+ * @brief   Posts filled data in an input queue.
+ * @details The specified amount of data, previously written in the span
+ *          returned by @p iqGetEmptySpanI(), is made available to readers
+ *          and the waiting threads are resumed.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] n         the amount of data filled, the value 0 is reserved
+ *
+ * @iclass
+ */
+void iqPostFullSpanI(input_queue_t *iqp, size_t n) {
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck(n > 0U);
+  osalDbgAssert(n <= iqGetEmptyI(iqp), "out of span");
+
+  iqp->q_counter += n;
+  iqp->q_wrptr += n;
+  if (iqp->q_wrptr >= iqp->q_top) {
+    iqp->q_wrptr -= qSizeX(iqp);
+  }
+
+  /* Readers check the queue state again when resumed.*/
+  osalThreadDequeueAllI(&iqp->q_waiting, MSG_OK);
+}
+
+/**
+ * @brief   Gets the contiguous full span of an input queue with timeout.
+ * @details The function returns the largest region of data that can be
+ *          accessed in place, without wrapping at the buffer end. If the
+ *          queue is empty then the calling thread is suspended until some
+ *          data arrives in the queue or a timeout occurs.
+ * @note    The data is not consumed, it has to be released using
+ *          @p iqReleaseEmptySpan() when no more needed. Data after the span
+ *          can be inspected using @p iqPeekI().
+ * @note    Only one thread at time can access the queue using spans.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[out] bpp      pointer to the span pointer
+ * @param[out] np       size of the returned span
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a span has been returned.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the queue has been reset.
+ *
+ * @api
+ */
+msg_t iqGetFullSpanTimeout(input_queue_t *iqp, uint8_t **bpp, size_t *np,
+                           sysinterval_t timeout) {
+  size_t n;
+
+  osalSysLock();
+
+  /* Waiting until there is some data available or a timeout occurs.*/
+  while (iqIsEmptyI(iqp)) {
+    msg_t msg = osalThreadEnqueueTimeoutS(&iqp->q_waiting, timeout);
+    if (msg < MSG_OK) {
+      osalSysUnlock();
+      return msg;
+    }
+  }
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  n = (size_t)(iqp->q_top - iqp->q_rdptr);
+  /*lint -restore*/
+  if (n > iqGetFullI(iqp)) {
+    n = iqGetFullI(iqp);
+  }
+
+  *bpp = iqp->q_rdptr;
+  *np  = n;
+
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Releases consumed data from an input queue.
+ * @details The specified amount of data is removed from the queue, it can
+ *          exceed the span returned by @p iqGetFullSpanTimeout() if more
+ *          data has been inspected using @p iqPeekI().
+ * @note    The callback is invoked after removing the data from the queue.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] n         the amount of data consumed, the value 0 is reserved
+ *
+ * @iclass
+ */
+void iqReleaseEmptySpanI(input_queue_t *iqp, size_t n) {
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck(n > 0U);
+  osalDbgAssert(n <= iqGetFullI(iqp), "out of span");
+
+  iqp->q_counter -= n;
+  iqp->q_rdptr += n;
+  if (iqp->q_rdptr >= iqp->q_top) {
+    iqp->q_rdptr -= qSizeX(iqp);
+  }
+
+  /* Inform the low side that the queue has at least one slot available.*/
+  if (iqp->q_notify != NULL) {
+    iqp->q_notify(iqp);
+  }
+}
+
+/**
+ * @brief   Releases consumed data from an input queue.
+ * @details The specified amount of data is removed from the queue, it can
+ *          exceed the span returned by @p iqGetFullSpanTimeout() if more
+ *          data has been inspected using @p iqPeekI().
+ * @note    The callback is invoked after removing the data from the queue.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] n         the amount of data consumed, the value 0 is reserved
+ *
+ * @api
+ */
+void iqReleaseEmptySpan(input_queue_t *iqp, size_t n) {
+
+  osalSysLock();
+  iqReleaseEmptySpanI(iqp, n);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Input queue peek.
+ * @details This function returns a byte value from an input queue without
+ *          removing it, the buffer end is handled transparently.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] offset    offset of the byte from the queue read position
+ * @return              A byte value from the queue.
+ * @retval MSG_TIMEOUT  if the queue does not contain enough data.
+ *
+ * @iclass
+ */
+msg_t iqPeekI(input_queue_t *iqp, size_t offset) {
+  uint8_t *p;
+
+  osalDbgCheckClassI();
+
+  if (offset >= iqGetFullI(iqp)) {
+    return MSG_TIMEOUT;
+  }
+
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  if (offset < (size_t)(iqp->q_top - iqp->q_rdptr)) {
+    p = iqp->q_rdptr + offset;
+  }
+  else {
+    p = iqp->q_rdptr + offset - qSizeX(iqp);
+  }
+  /*lint -restore*/
+
+  return (msg_t)*p;
+}
+
 /**
  * @brief   Initializes an output queue.
  * @details A Semaphore is internally initialized and works as a counter of
@@ -696,4 +899,173 @@ size_t oqWriteTimeout(output_queue_t *oqp, const uint8_t *bp,
   return max - n;
 }
 
+/**
+ * @brief   Gets the contiguous empty span of an output queue with timeout.
+ * @details The function returns the largest empty region that can be
+ *          filled in place, without wrapping at the buffer end. If the queue
+ *          is full then the calling thread is suspended until there is space
+ *          in the queue or a timeout occurs.
+ * @note    The data written in the span is not sent until it is committed
+ *          using @p oqPostFullSpan().
+ * @note    Only one thread at time can access the queue using spans.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[out] bpp      pointer to the span pointer
+ * @param[out] np       size of the returned span
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a span has been returned.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the queue has been reset.
+ *
+ * @api
+ */
+msg_t oqGetEmptySpanTimeout(output_queue_t *oqp, uint8_t **bpp, size_t *np,
+                            sysinterval_t timeout) {
+  size_t n;
+
+  osalSysLock();
+
+  /* Waiting until there is a slot available or a timeout occurs.*/
+  while (oqIsFullI(oqp)) {
+    msg_t msg = osalThreadEnqueueTimeoutS(&oqp->q_waiting, timeout);
+    if (msg < MSG_OK) {
+      osalSysUnlock();
+      return msg;
+    }
+  }
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  n = (size_t)(oqp->q_top - oqp->q_wrptr);
+  /*lint -restore*/
+  if (n > oqGetEmptyI(oqp)) {
+    n = oqGetEmptyI(oqp);
+  }
+
+  *bpp = oqp->q_wrptr;
+  *np  = n;
+
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Commits filled data in an output queue.
+ * @details The specified amount of data, previously written in the span
+ *          returned by @p oqGetEmptySpanTimeout(), is made available to the
+ *          low side.
+ * @note    The callback is invoked after committing the data.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[in] n         the amount of data filled, the value 0 is reserved
+ *
+ * @iclass
+ */
+void oqPostFullSpanI(output_queue_t *oqp, size_t n) {
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck(n > 0U);
+  osalDbgAssert(n <= oqGetEmptyI(oqp), "out of span");
+
+  oqp->q_counter -= n;
+  oqp->q_wrptr += n;
+  if (oqp->q_wrptr >= oqp->q_top) {
+    oqp->q_wrptr -= qSizeX(oqp);
+  }
+
+  /* Inform the low side that the queue has at least one character available.*/
+  if (oqp->q_notify != NULL) {
+    oqp->q_notify(oqp);
+  }
+}
+
+/**
+ * @brief   Commits filled data in an output queue.
+ * @details The specified amount of data, previously written in the span
+ *          returned by @p oqGetEmptySpanTimeout(), is made available to the
+ *          low side.
+ * @note    The callback is invoked after committing the data.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[in] n         the amount of data filled, the value 0 is reserved
+ *
+ * @api
+ */
+void oqPostFullSpan(output_queue_t *oqp, size_t n) {
+
+  osalSysLock();
+  oqPostFullSpanI(oqp, n);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Gets the contiguous full span of an output queue.
+ * @details The function returns the largest region of data that can be
+ *          read in place, without wrapping at the buffer end, it is meant
+ *          to be used by the low side for draining the queue without an
+ *          intermediate buffer, for example using a DMA.
+ * @note    The function always returns the same span if called repeatedly.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[out] np       size of the returned span
+ * @return              A pointer to the span to be sent.
+ * @retval NULL         if the queue is empty.
+ *
+ * @iclass
+ */
+uint8_t *oqGetFullSpanI(output_queue_t *oqp, size_t *np) {
+  size_t n;
+
+  osalDbgCheckClassI();
+
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  n = (size_t)(oqp->q_top - oqp->q_rdptr);
+  /*lint -restore*/
+  if (n > oqGetFullI(oqp)) {
+    n = oqGetFullI(oqp);
+  }
+
+  *np = n;
+  if (n == (size_t)0) {
+    return NULL;
+  }
+
+  return oqp->q_rdptr;
+}
+
+/**
+ * @brief   Releases sent data from an output queue.
+ * @details The specified amount of data, previously read from the span
+ *          returned by @p oqGetFullSpanI(), is removed from the queue and
+ *          the waiting threads are resumed.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[in] n         the amount of data sent, the value 0 is reserved
+ *
+ * @iclass
+ */
+void oqReleaseEmptySpanI(output_queue_t *oqp, size_t n) {
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck(n > 0U);
+  osalDbgAssert(n <= oqGetFullI(oqp), "out of span");
+
+  oqp->q_counter += n;
+  oqp->q_rdptr += n;
+  if (oqp->q_rdptr >= oqp->q_top) {
+    oqp->q_rdptr -= qSizeX(oqp);
+  }
+
+  /* Writers check the queue state again when resumed.*/
+  osalThreadDequeueAllI(&oqp->q_waiting, MSG_OK);
+}
+
 /** @} */
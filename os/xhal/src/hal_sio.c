@@ -151,6 +151,130 @@ static void __bsio_onotify(io_queue_t *qp) {
 }
 #endif /* SIO_USE_BUFFERING == TRUE */
 
+static void __bbsio_push_data(hal_block_buffered_sio_c *bbsiop) {
+
+  while (true) {
+    size_t n;
+
+    /* Fetching the next block to be sent, if there are no full blocks then
+       a partially filled one is sent, if any.*/
+    if (bbsiop->txptr == NULL) {
+      bbsiop->txptr = obqGetFullBufferI(&bbsiop->obqueue, &n);
+      if (bbsiop->txptr == NULL) {
+        if (!obqTryFlushI(&bbsiop->obqueue)) {
+          bbsioAddFlagsI(bbsiop, CHN_FL_TX_NOTFULL);
+          return;
+        }
+        continue;
+      }
+      bbsiop->txtop = bbsiop->txptr + n;
+    }
+
+    /* Writing as many frames as the TX FIFO can accept.*/
+    n = sioAsyncWriteX(bbsiop->siop, bbsiop->txptr,
+                       (size_t)(bbsiop->txtop - bbsiop->txptr));
+    bbsiop->txptr += n;
+    if (bbsiop->txptr < bbsiop->txtop) {
+      /* TX FIFO full, continuing on the next TX FIFO event.*/
+      return;
+    }
+
+    /* Block sent, returning it to the writers.*/
+    obqReleaseEmptyBufferI(&bbsiop->obqueue);
+    bbsiop->txptr = NULL;
+  }
+}
+
+static void __bbsio_post_block(hal_block_buffered_sio_c *bbsiop) {
+
+  if ((bbsiop->rxbuf != NULL) && (bbsiop->rxn > (size_t)0)) {
+    if (ibqIsEmptyI(&bbsiop->ibqueue)) {
+      bbsioAddFlagsI(bbsiop, CHN_FL_RX_NOTEMPTY);
+    }
+    ibqPostFullBufferI(&bbsiop->ibqueue, bbsiop->rxn);
+    bbsiop->rxbuf = NULL;
+  }
+}
+
+static void __bbsio_pop_data(hal_block_buffered_sio_c *bbsiop) {
+  size_t bsize = bbsiop->ibqueue.bsize - sizeof (size_t);
+
+  /* RX FIFO needs to be fully emptied or SIO will not generate more RX FIFO
+     events.*/
+  while (!sioIsRXEmptyX(bbsiop->siop)) {
+
+    /* Fetching a new block to be filled, if there are no free blocks then
+       the incoming data is discarded.*/
+    if (bbsiop->rxbuf == NULL) {
+      bbsiop->rxbuf = ibqGetEmptyBufferI(&bbsiop->ibqueue);
+      if (bbsiop->rxbuf == NULL) {
+        (void) sioGetX(bbsiop->siop);
+        bbsioAddFlagsI(bbsiop, CHN_FL_BUFFER_FULL_ERR);
+        continue;
+      }
+      bbsiop->rxn = (size_t)0;
+    }
+
+    /* Reading as many frames as the RX FIFO contains.*/
+    bbsiop->rxn += sioAsyncReadX(bbsiop->siop, bbsiop->rxbuf + bbsiop->rxn,
+                                 bsize - bbsiop->rxn);
+    if (bbsiop->rxn >= bsize) {
+      __bbsio_post_block(bbsiop);
+    }
+  }
+}
+
+static void __bbsio_start_tx(hal_block_buffered_sio_c *bbsiop) {
+
+  /* Nothing to do if a block is already being sent, it will continue with
+     the next one.*/
+  if ((bbsiop->siop->state == HAL_DRV_STATE_READY) &&
+      (bbsiop->txptr == NULL)) {
+    __bbsio_push_data(bbsiop);
+  }
+}
+
+static void __bbsio_default_cb(void *ip) {
+  hal_sio_driver_c *siop = (hal_sio_driver_c *)ip;
+  hal_block_buffered_sio_c *bbsiop = (hal_block_buffered_sio_c *)siop->arg;
+  sioevents_t events;
+
+  osalSysLockFromISR();
+
+  /* Posting the non-data SIO events as channel event flags, the masks are
+     made to match.*/
+  events = sioGetAndClearEventsX(siop, SIO_EV_ALL_EVENTS);
+  bbsioAddFlagsI(bbsiop, (eventflags_t)(events & ~SIO_EV_ALL_DATA));
+
+  /* RX FIFO or RX idle event, on idle the partially filled block is made
+     available to readers after emptying the RX FIFO.*/
+  if ((events & (SIO_EV_RX_NOTEMPTY | SIO_EV_RX_IDLE)) != (sioevents_t)0) {
+    __bbsio_pop_data(bbsiop);
+    if ((events & SIO_EV_RX_IDLE) != (sioevents_t)0) {
+      __bbsio_post_block(bbsiop);
+    }
+  }
+
+  /* TX FIFO event.*/
+  if ((events & SIO_EV_TX_NOTFULL) != (sioevents_t)0) {
+    __bbsio_push_data(bbsiop);
+  }
+
+  osalSysUnlockFromISR();
+}
+
+static void __bbsio_onotify(io_buffers_queue_t *bqp) {
+
+  __bbsio_start_tx((hal_block_buffered_sio_c *)bqGetLinkX(bqp));
+}
+
+static void __bbsio_flush(hal_block_buffered_sio_c *bbsiop) {
+
+  osalSysLock();
+  __bbsio_start_tx(bbsiop);
+  osalSysUnlock();
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -985,6 +1109,392 @@ const struct hal_buffered_sio_vmt __hal_buffered_sio_vmt = {
   .selcfg                   = NULL /* Method not found.*/
 };
 
+/*===========================================================================*/
+/* Module class "hal_block_buffered_sio_c" methods.                          */
+/*===========================================================================*/
+
+/**
+ * @name        Interfaces implementation of hal_block_buffered_sio_c
+ * @{
+ */
+/**
+ * @brief       Implementation of interface method @p stmWrite().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     bp            Pointer to the data buffer.
+ * @param[in]     n             The maximum amount of data to be transferred.
+ * @return                      The number of bytes transferred. The returned
+ *                              value can be less than the specified number of
+ *                              bytes if an end-of-file condition has been met.
+ */
+static size_t __bbsio_chn_write_impl(void *ip, const uint8_t *bp, size_t n) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+  size_t written;
+
+  written = obqWriteTimeout(&self->obqueue, bp, n, TIME_INFINITE);
+  __bbsio_flush(self);
+
+  return written;
+}
+
+/**
+ * @brief       Implementation of interface method @p stmRead().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[out]    bp            Pointer to the data buffer.
+ * @param[in]     n             The maximum amount of data to be transferred.
+ * @return                      The number of bytes transferred. The returned
+ *                              value can be less than the specified number of
+ *                              bytes if an end-of-file condition has been met.
+ */
+static size_t __bbsio_chn_read_impl(void *ip, uint8_t *bp, size_t n) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+
+  return ibqReadTimeout(&self->ibqueue, bp, n, TIME_INFINITE);
+}
+
+/**
+ * @brief       Implementation of interface method @p stmPut().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     b             The byte value to be written to the stream.
+ * @return                      The operation status.
+ */
+static int __bbsio_chn_put_impl(void *ip, uint8_t b) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+  msg_t msg;
+
+  msg = obqPutTimeout(&self->obqueue, b, TIME_INFINITE);
+  __bbsio_flush(self);
+
+  return msg;
+}
+
+/**
+ * @brief       Implementation of interface method @p stmGet().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @return                      A byte value from the stream.
+ */
+static int __bbsio_chn_get_impl(void *ip) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+
+  return ibqGetTimeout(&self->ibqueue, TIME_INFINITE);
+}
+
+/**
+ * @brief       Implementation of interface method @p stmUnget().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     b             The byte value to be pushed back to the stream.
+ * @return                      The operation status.
+ */
+static int __bbsio_chn_unget_impl(void *ip, int b) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+
+  (void)self;
+  (void)b;
+
+  return STM_RESET;
+}
+
+/**
+ * @brief       Implementation of interface method @p chnWriteTimeout().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     bp            Pointer to the data buffer.
+ * @param[in]     n             The maximum amount of data to be transferred.
+ * @param[in]     timeout       The number of ticks before the operation
+ *                              timeouts, the following special values are
+ *                              allowed:
+ *                              - @a TIME_IMMEDIATE immediate timeout.
+ *                              - @a TIME_INFINITE no timeout.
+ *                              .
+ * @return                      The number of bytes transferred.
+ */
+static size_t __bbsio_chn_writet_impl(void *ip, const uint8_t *bp, size_t n,
+                                      sysinterval_t timeout) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+  size_t written;
+
+  written = obqWriteTimeout(&self->obqueue, bp, n, timeout);
+  __bbsio_flush(self);
+
+  return written;
+}
+
+/**
+ * @brief       Implementation of interface method @p chnReadTimeout().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     bp            Pointer to the data buffer.
+ * @param[in]     n             The maximum amount of data to be transferred.
+ * @param[in]     timeout       The number of ticks before the operation
+ *                              timeouts, the following special values are
+ *                              allowed:
+ *                              - @a TIME_IMMEDIATE immediate timeout.
+ *                              - @a TIME_INFINITE no timeout.
+ *                              .
+ * @return                      The number of bytes transferred.
+ */
+static size_t __bbsio_chn_readt_impl(void *ip, uint8_t *bp, size_t n,
+                                     sysinterval_t timeout) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+
+  return ibqReadTimeout(&self->ibqueue, bp, n, timeout);
+}
+
+/**
+ * @brief       Implementation of interface method @p chnPutTimeout().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     b             The byte value to be written to the channel.
+ * @param[in]     timeout       The number of ticks before the operation
+ *                              timeouts, the following special values are
+ *                              allowed:
+ *                              - @a TIME_IMMEDIATE immediate timeout.
+ *                              - @a TIME_INFINITE no timeout.
+ *                              .
+ * @return                      The operation status.
+ */
+static msg_t __bbsio_chn_putt_impl(void *ip, uint8_t b,
+                                   sysinterval_t timeout) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+  msg_t msg;
+
+  msg = obqPutTimeout(&self->obqueue, b, timeout);
+  __bbsio_flush(self);
+
+  return msg;
+}
+
+/**
+ * @brief       Implementation of interface method @p chnGetTimeout().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     timeout       The number of ticks before the operation
+ *                              timeouts, the following special values are
+ *                              allowed:
+ *                              - @a TIME_IMMEDIATE immediate timeout.
+ *                              - @a TIME_INFINITE no timeout.
+ *                              .
+ * @return                      A byte value from the channel.
+ */
+static msg_t __bbsio_chn_gett_impl(void *ip, sysinterval_t timeout) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+
+  return ibqGetTimeout(&self->ibqueue, timeout);
+}
+
+/**
+ * @brief       Implementation of interface method @p chnGetAndClearFlags().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     mask          Mask of flags to be returned and cleared.
+ * @return                      The cleared event flags.
+ */
+static chnflags_t __bbsio_chn_getclr_impl(void *ip, chnflags_t mask) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+
+  (void)self;
+  (void)mask;
+
+  return 0;
+}
+
+/**
+ * @brief       Implementation of interface method @p chnControl().
+ *
+ * @param[in,out] ip            Pointer to the @p asynchronous_channel_i class
+ *                              interface.
+ * @param[in]     operation     Control operation code
+ * @param[in,out] arg           Operation argument.
+ * @return                      The operation status.
+ */
+static msg_t __bbsio_chn_ctl_impl(void *ip, unsigned int operation,
+                                  void *arg) {
+  hal_block_buffered_sio_c *self = oopIfGetOwner(hal_block_buffered_sio_c, ip);
+
+  switch (operation) {
+  case CHN_CTL_NOP:
+    osalDbgCheck(arg == NULL);
+    break;
+  case CHN_CTL_INVALID:
+    return HAL_RET_UNKNOWN_CTL;
+  default:
+    /* Delegating to the LLD if supported.*/
+    return sio_lld_control(self->siop, operation, arg);
+  }
+  return HAL_RET_SUCCESS;
+}
+/** @} */
+
+/**
+ * @name        Methods implementations of hal_block_buffered_sio_c
+ * @{
+ */
+/**
+ * @brief       Implementation of object creation.
+ * @note        This function is meant to be used by derived classes.
+ *
+ * @param[out]    ip            Pointer to a @p hal_block_buffered_sio_c
+ *                              instance to be initialized.
+ * @param[in]     vmt           VMT pointer for the new object.
+ * @param[in]     siop          Pointer to the @p hal_sio_driver_c object.
+ * @param[in]     ib            Pointer to the input buffers area, it must be
+ *                              <tt>BQ_BUFFER_SIZE(ibn, ibsize)</tt> bytes.
+ * @param[in]     ibsize        Size of the input blocks.
+ * @param[in]     ibn           Number of input blocks.
+ * @param[in]     ob            Pointer to the output buffers area, it must be
+ *                              <tt>BQ_BUFFER_SIZE(obn, obsize)</tt> bytes.
+ * @param[in]     obsize        Size of the output blocks.
+ * @param[in]     obn           Number of output blocks.
+ * @return                      A new reference to the object.
+ */
+void *__bbsio_objinit_impl(void *ip, const void *vmt, hal_sio_driver_c *siop,
+                           uint8_t *ib, size_t ibsize, size_t ibn,
+                           uint8_t *ob, size_t obsize, size_t obn) {
+  hal_block_buffered_sio_c *self = (hal_block_buffered_sio_c *)ip;
+
+  /* Initialization of the ancestors-defined parts.*/
+  __drv_objinit_impl(self, vmt);
+
+  /* Initialization of interface asynchronous_channel_i.*/
+  {
+    static const struct asynchronous_channel_vmt bbsio_chn_vmt = {
+      .instance_offset      = offsetof(hal_block_buffered_sio_c, chn),
+      .write                = __bbsio_chn_write_impl,
+      .read                 = __bbsio_chn_read_impl,
+      .put                  = __bbsio_chn_put_impl,
+      .get                  = __bbsio_chn_get_impl,
+      .unget                = __bbsio_chn_unget_impl,
+      .writet               = __bbsio_chn_writet_impl,
+      .readt                = __bbsio_chn_readt_impl,
+      .putt                 = __bbsio_chn_putt_impl,
+      .gett                 = __bbsio_chn_gett_impl,
+      .getclr               = __bbsio_chn_getclr_impl,
+      .ctl                  = __bbsio_chn_ctl_impl
+    };
+    oopIfObjectInit(&self->chn, &bbsio_chn_vmt);
+  }
+
+  /* Initialization code.*/
+  osalEventObjectInit(&self->event);
+  ibqObjectInit(&self->ibqueue, false, ib, ibsize, ibn,
+                NULL, (void *)self);
+  obqObjectInit(&self->obqueue, false, ob, obsize, obn,
+                __bbsio_onotify, (void *)self);
+  drvSetArgumentX(siop, self);
+  self->siop  = siop;
+  self->rxbuf = NULL;
+  self->rxn   = (size_t)0;
+  self->txptr = NULL;
+  self->txtop = NULL;
+
+  return self;
+}
+
+/**
+ * @brief       Implementation of object finalization.
+ * @note        This function is meant to be used by derived classes.
+ *
+ * @param[in,out] ip            Pointer to a @p hal_block_buffered_sio_c
+ *                              instance to be disposed.
+ */
+void __bbsio_dispose_impl(void *ip) {
+  hal_block_buffered_sio_c *self = (hal_block_buffered_sio_c *)ip;
+
+  /* No finalization code.*/
+  (void)self;
+
+  /* Finalization of the ancestors-defined parts.*/
+  __drv_dispose_impl(self);
+}
+
+/**
+ * @brief       Override of method @p __drv_start().
+ *
+ * @param[in,out] ip            Pointer to a @p hal_block_buffered_sio_c
+ *                              instance.
+ * @return                      The operation status.
+ */
+msg_t __bbsio_start_impl(void *ip) {
+  hal_block_buffered_sio_c *self = (hal_block_buffered_sio_c *)ip;
+  msg_t msg;
+
+  /* Starting the underlying SIO driver.*/
+  msg = drvStartS(self->siop);
+  if (msg == HAL_RET_SUCCESS) {
+    drvSetCallbackX(self->siop, &__bbsio_default_cb);
+    sioWriteEnableFlagsX(self->siop, SIO_EV_ALL_EVENTS);
+
+    /* Sharing the configuration of the underlying SIO driver.*/
+    self->config = self->siop->config;
+
+    /* Sending data written while stopped, if any.*/
+    __bbsio_start_tx(self);
+  }
+
+  return msg;
+}
+
+/**
+ * @brief       Override of method @p __drv_stop().
+ *
+ * @param[in,out] ip            Pointer to a @p hal_block_buffered_sio_c
+ *                              instance.
+ */
+void __bbsio_stop_impl(void *ip) {
+  hal_block_buffered_sio_c *self = (hal_block_buffered_sio_c *)ip;
+
+  drvStopS(self->siop);
+
+  /* Blocks in transit are lost, waiting threads are released.*/
+  self->rxbuf = NULL;
+  self->txptr = NULL;
+  ibqResetI(&self->ibqueue);
+  obqResetI(&self->obqueue);
+  osalOsRescheduleS();
+}
+
+/**
+ * @brief       Override of method @p __drv_set_cfg().
+ *
+ * @param[in,out] ip            Pointer to a @p hal_block_buffered_sio_c
+ *                              instance.
+ * @param[in]     config        New driver configuration.
+ * @return                      The configuration pointer.
+ */
+const void *__bbsio_setcfg_impl(void *ip, const void *config) {
+  hal_block_buffered_sio_c *self = (hal_block_buffered_sio_c *)ip;
+
+  /* Configuring the underlying SIO driver.*/
+  return __sio_setcfg_impl(self->siop, config);
+}
+/** @} */
+
+/**
+ * @brief       VMT structure of block-buffered SIO wrapper class.
+ * @note        It is public because accessed by the inlined constructor.
+ */
+const struct hal_block_buffered_sio_vmt __hal_block_buffered_sio_vmt = {
+  .dispose                  = __bbsio_dispose_impl,
+  .start                    = __bbsio_start_impl,
+  .stop                     = __bbsio_stop_impl,
+  .setcfg                   = __bbsio_setcfg_impl,
+  .selcfg                   = NULL /* Method not found.*/
+};
+
 #endif /* HAL_USE_SIO == TRUE */
 
 /** @} */
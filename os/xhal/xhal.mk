@@ -3,8 +3,6 @@
 # Dependencies.
 include $(CHIBIOS)/os/common/oop/oop.mk
 
-ifeq ($(USE_SMART_BUILD),yes)
-
 # Configuration files directory
 ifeq ($(XHALCONFDIR),)
   ifeq ($(CONFDIR),)
@@ -16,6 +14,8 @@ endif
 
 XHALCONF := $(strip $(shell cat $(XHALCONFDIR)/xhalconf.h | grep -E "\#define"))
 
+ifeq ($(USE_SMART_BUILD),yes)
+
 # Required files.
 XHALSRC := $(CHIBIOS)/os/xhal/src/hal.c \
            $(CHIBIOS)/os/xhal/src/hal_safety.c \
@@ -31,7 +31,8 @@ ifneq ($(findstring HAL_USE_PAL TRUE,$(XHALCONF)),)
 XHALSRC += $(CHIBIOS)/os/xhal/src/hal_pal.c
 endif
 ifneq ($(findstring HAL_USE_SIO TRUE,$(XHALCONF)),)
-XHALSRC += $(CHIBIOS)/os/xhal/src/hal_sio.c
+XHALSRC += $(CHIBIOS)/os/xhal/src/hal_sio.c \
+           $(CHIBIOS)/os/xhal/src/hal_buffers.c
 endif
 ifneq ($(findstring HAL_USE_SPI TRUE,$(XHALCONF)),)
 XHALSRC += $(CHIBIOS)/os/xhal/src/hal_spi.c
@@ -45,6 +46,10 @@ XHALSRC = $(CHIBIOS)/os/xhal/src/hal.c \
           $(CHIBIOS)/os/xhal/src/hal_pal.c \
           $(CHIBIOS)/os/xhal/src/hal_sio.c \
           $(CHIBIOS)/os/xhal/src/hal_spi.c
+# Buffers queues are only used by the block-buffered SIO wrapper.
+ifneq ($(findstring HAL_USE_SIO TRUE,$(XHALCONF)),)
+XHALSRC += $(CHIBIOS)/os/xhal/src/hal_buffers.c
+endif
 endif
 
 # Required include directories
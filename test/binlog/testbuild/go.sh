@@ -0,0 +1,73 @@
+#!/bin/bash
+export XOPT XDEFS
+
+XOPT="-ggdb -O2 -fomit-frame-pointer"
+XDEFS=""
+
+function clean() {
+  echo -n "  * Cleaning..."
+  make clean > /dev/null
+  rm -f binlog.bin binlog_ref.txt binlog_dec.txt
+  echo "OK"
+}
+
+function compile() {
+  echo -n "  * Building..."
+  if ! make > buildlog.txt
+  then
+    echo "failed"
+    clean
+    exit 1
+  fi
+  mv -f buildlog.txt ./reports/${1}_build.txt
+  echo "OK"
+}
+
+function execute_test() {
+  echo -n "  * Testing..."
+  if ! ./build/ch > testlog.txt
+  then
+    echo "failed"
+    clean
+    exit 1
+  fi
+  grep -e "^--- " testlog.txt
+  mv -f testlog.txt ./reports/${1}_test.txt
+  echo "OK"
+}
+
+function decode() {
+  echo -n "  * Decoding..."
+  if ! python3 ../../../tools/binlog/binlog_decode.py --no-timestamps \
+       build/ch binlog.bin > binlog_dec.txt
+  then
+    echo "failed"
+    clean
+    exit 1
+  fi
+  if ! diff binlog_ref.txt binlog_dec.txt > ./reports/${1}_diff.txt
+  then
+    echo "mismatch"
+    clean
+    exit 1
+  fi
+  echo "OK"
+}
+
+function test() {
+  msg=$1": "$2
+  XDEFS=$2
+  echo $msg
+  compile $1
+  execute_test $1
+  decode $1
+  clean
+}
+
+mkdir reports 2> /dev/null
+
+test binlog ""
+
+rm *log.txt 2> /dev/null
+echo
+echo "Done"
@@ -0,0 +1,272 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+#include "memstreams.h"
+#include "nullstreams.h"
+#include "binlog.h"
+#include "console.h"
+
+/*
+ * Output files, the binary log is decoded by go.sh and compared with the
+ * reference text formatted on the target side.
+ */
+#define LOG_FILE                "binlog.bin"
+#define REF_FILE                "binlog_ref.txt"
+
+/*
+ * Benchmark parameters, records are written in batches filling the ring
+ * and the ring is drained between batches.
+ */
+#define BENCH_RING_WORDS        65536U
+#define BENCH_BATCH             10000U
+#define BENCH_BATCHES           10U
+
+static uint8_t log_buffer[8192];
+static MemoryStream log_stream;
+static char ref_buffer[8192];
+static size_t ref_size;
+static NullStream null_stream;
+
+static binlog_t binlog;
+static binlog_ring_t ring1, ring2, ring3;
+static uint32_t ring1_buffer[32];
+static uint32_t ring2_buffer[16];
+static uint32_t ring3_buffer[32];
+
+static binlog_t bench_binlog;
+static binlog_ring_t bench_ring;
+static uint32_t bench_buffer[BENCH_RING_WORDS];
+
+static THD_WORKING_AREA(waBinlog, 1024);
+
+static bool failed;
+
+/*
+ * Appends a line to the reference text.
+ */
+static void ref_printf(const char *fmt, ...) {
+  va_list ap;
+
+  va_start(ap, fmt);
+  ref_size += (size_t)chvsnprintf(&ref_buffer[ref_size],
+                                  sizeof (ref_buffer) - ref_size, fmt, ap);
+  va_end(ap);
+}
+
+/*
+ * Checks an operation result.
+ */
+static void check(bool condition, const char *msg) {
+
+  if (!condition) {
+    chprintf((BaseSequentialStream *)&CD1, "FAILED: %s\r\n", msg);
+    failed = true;
+  }
+}
+
+/*
+ * Writes a buffer to a host file.
+ */
+static void write_file(const char *name, const void *p, size_t n) {
+  FILE *f;
+
+  f = fopen(name, "wb");
+  check(f != NULL, "file open");
+  if (f != NULL) {
+    check(fwrite(p, 1, n, f) == n, "file write");
+    fclose(f);
+  }
+}
+
+/*
+ * Records covering the conversions supported by the decoder, each record
+ * is also formatted with chprintf() as reference.
+ */
+static void log_conversions(binlog_ring_t *rp) {
+
+  check(!binlogWrite0(rp, "no arguments\n"), "dropped");
+  ref_printf("no arguments\n");
+
+  check(!binlogWrite3(rp, "%d %u %x\n", (uint32_t)-1234, 4000000000U,
+                      0xBEEFU), "dropped");
+  ref_printf("%d %u %x\n", -1234, 4000000000U, 0xBEEFU);
+  (void) binlogDrain(&binlog);
+
+  check(!binlogWrite4(rp, "[%5d][%-5d][%05d][%08x]\n", 42U, 42U,
+                      (uint32_t)-42, 0xABCU), "dropped");
+  ref_printf("[%5d][%-5d][%05d][%08x]\n", 42, 42, -42, 0xABCU);
+
+  check(!binlogWrite3(rp, "%s %.3s %c\n", (uint32_t)(uintptr_t)"constant",
+                      (uint32_t)(uintptr_t)"truncated", (uint32_t)'z'),
+        "dropped");
+  ref_printf("%s %.3s %c\n", "constant", "truncated", 'z');
+  (void) binlogDrain(&binlog);
+
+  check(!binlogWrite2(rp, "[%*d]\n", 6U, 77U), "dropped");
+  ref_printf("[%*d]\n", 6, 77);
+
+  check(!binlogWrite2(rp, "%f %.2f\n", binlogFloat(3.25f),
+                      binlogFloat(-0.5f)), "dropped");
+  ref_printf("%f %.2f\n", 3.25, -0.5);
+  (void) binlogDrain(&binlog);
+
+  /* Some more records for wrapping the ring again.*/
+  check(!binlogWrite4(rp, "%o %X %i %%\n", 8U, 0xCAFEU, 7U, 0U), "dropped");
+  ref_printf("%o %X %i %%\n", 8U, 0xCAFEU, 7);
+  check(!binlogWrite1(rp, "%u\n", 0U), "dropped");
+  ref_printf("%u\n", 0U);
+  (void) binlogDrain(&binlog);
+}
+
+/*
+ * Records are logged into a ring too small to hold them, the excess
+ * records are dropped and reported by the drain.
+ */
+static void log_drops(binlog_ring_t *rp) {
+  unsigned i;
+
+  /* The notice precedes the records in the drained stream.*/
+  ref_printf("<2 records dropped>\n");
+  for (i = 0U; i < 6U; i++) {
+    bool dropped = binlogWrite1(rp, "record %u\n", i);
+
+    /* Four records of four words fill the ring.*/
+    check(dropped == (i >= 4U), "unexpected drop status");
+    if (!dropped) {
+      ref_printf("record %u\n", i);
+    }
+  }
+  (void) binlogDrain(&binlog);
+
+  check(!binlogWrite0(rp, "after drops\n"), "dropped");
+  ref_printf("after drops\n");
+  (void) binlogDrain(&binlog);
+}
+
+/*
+ * Records are shipped by the drain thread.
+ */
+static void log_thread(binlog_ring_t *rp) {
+  size_t n;
+
+  chThdCreateStatic(waBinlog, sizeof (waBinlog), NORMALPRIO - 1,
+                    binlogThread, &binlog);
+
+  n = log_stream.eos;
+  check(!binlogWrite1(rp, "from thread %d\n", 3U), "dropped");
+  ref_printf("from thread %d\n", 3);
+  chThdSleep(BINLOG_DRAIN_INTERVAL * 2U);
+  check(log_stream.eos > n, "not drained by the thread");
+}
+
+/*
+ * Measures the cost of logging a record compared with formatting it.
+ */
+static void benchmark(void) {
+  rtcnt_t start, wrtime = 0U, drtime = 0U, fmtime;
+  unsigned i, j;
+  char buf[64];
+
+  nullObjectInit(&null_stream);
+  binlogObjectInit(&bench_binlog, (BaseSequentialStream *)&null_stream);
+  binlogRingObjectInit(&bench_ring, bench_buffer, BENCH_RING_WORDS, 0U);
+  binlogRegisterRing(&bench_binlog, &bench_ring);
+
+  for (j = 0U; j < BENCH_BATCHES; j++) {
+    start = chSysGetRealtimeCounterX();
+    for (i = 0U; i < BENCH_BATCH; i++) {
+      (void) binlogWrite3(&bench_ring, "sample %u %d %x\n", i, j, i ^ j);
+    }
+    wrtime += chSysGetRealtimeCounterX() - start;
+
+    start = chSysGetRealtimeCounterX();
+    (void) binlogDrain(&bench_binlog);
+    drtime += chSysGetRealtimeCounterX() - start;
+  }
+  check(bench_ring.dropped == 0U, "benchmark drops");
+
+  start = chSysGetRealtimeCounterX();
+  for (j = 0U; j < BENCH_BATCHES; j++) {
+    for (i = 0U; i < BENCH_BATCH; i++) {
+      (void) chsnprintf(buf, sizeof (buf), "sample %u %d %x\n", i, j, i ^ j);
+    }
+  }
+  fmtime = chSysGetRealtimeCounterX() - start;
+
+  /* The simulator realtime counter counts microseconds.*/
+  chprintf((BaseSequentialStream *)&CD1,
+           "--- Records: %u\r\n"
+           "--- binlogWrite3(): %u ns/record\r\n"
+           "--- binlogDrain():  %u ns/record\r\n"
+           "--- chsnprintf():   %u ns/record\r\n",
+           BENCH_BATCHES * BENCH_BATCH,
+           (unsigned)((wrtime * 1000U) / (BENCH_BATCHES * BENCH_BATCH)),
+           (unsigned)((drtime * 1000U) / (BENCH_BATCHES * BENCH_BATCH)),
+           (unsigned)((fmtime * 1000U) / (BENCH_BATCHES * BENCH_BATCH)));
+}
+
+/*
+ * Simulator main.
+ */
+int main(int argc, char *argv[]) {
+
+  (void)argc;
+  (void)argv;
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  conInit();
+  chSysInit();
+
+  msObjectInit(&log_stream, log_buffer, sizeof (log_buffer), 0U);
+  binlogObjectInit(&binlog, (BaseSequentialStream *)&log_stream);
+  binlogRingObjectInit(&ring1, ring1_buffer, 32U, 1U);
+  binlogRingObjectInit(&ring2, ring2_buffer, 16U, 2U);
+  binlogRingObjectInit(&ring3, ring3_buffer, 32U, 3U);
+  binlogRegisterRing(&binlog, &ring1);
+  binlogRegisterRing(&binlog, &ring2);
+  binlogRegisterRing(&binlog, &ring3);
+
+  log_conversions(&ring1);
+  log_drops(&ring2);
+  log_thread(&ring3);
+
+  write_file(LOG_FILE, log_buffer, log_stream.eos);
+  write_file(REF_FILE, ref_buffer, ref_size);
+  chprintf((BaseSequentialStream *)&CD1,
+           "--- Logged %u bytes, reference %u bytes\r\n",
+           (unsigned)log_stream.eos, (unsigned)ref_size);
+
+  benchmark();
+
+  if (failed)
+    exit(1);
+  else
+    exit(0);
+}
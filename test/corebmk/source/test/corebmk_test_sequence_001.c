@@ -45,6 +45,7 @@
  * <h2>Test Cases</h2>
  * - @subpage corebmk_test_001_001
  * - @subpage corebmk_test_001_002
+ * - @subpage corebmk_test_001_003
  * .
  */
 
@@ -70,6 +71,64 @@
 float *fdatas;
 double *fdatad;
 
+#include "chprintf.h"
+
+#define NPRINTS     10000           /* Number of formatted prints.          */
+
+static size_t bmk_calls;
+static size_t bmk_bytes;
+
+/*
+ * Stream emulating a driver taking a lock on each call.
+ */
+static size_t bmk_write(void *ip, const uint8_t *bp, size_t n) {
+
+  (void)ip;
+  (void)bp;
+
+  chSysLock();
+  bmk_calls++;
+  bmk_bytes += n;
+  chSysUnlock();
+
+  return n;
+}
+
+static size_t bmk_read(void *ip, uint8_t *bp, size_t n) {
+
+  (void)ip;
+  (void)bp;
+  (void)n;
+
+  return 0;
+}
+
+static msg_t bmk_put(void *ip, uint8_t b) {
+
+  (void)ip;
+  (void)b;
+
+  chSysLock();
+  bmk_calls++;
+  bmk_bytes++;
+  chSysUnlock();
+
+  return MSG_OK;
+}
+
+static msg_t bmk_get(void *ip) {
+
+  (void)ip;
+
+  return MSG_RESET;
+}
+
+static const struct BaseSequentialStreamVMT bmk_vmt = {
+  (size_t)0, bmk_write, bmk_read, bmk_put, bmk_get
+};
+
+static BaseSequentialStream bmk_stream = {&bmk_vmt};
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -250,6 +309,83 @@ static const testcase_t corebmk_test_001_002 = {
   corebmk_test_001_002_execute
 };
 
+/**
+ * @page corebmk_test_001_003 [1.3] Formatted output
+ *
+ * <h2>Description</h2>
+ * Formatted output benchmark, chprintf() is used on a stream taking a
+ * lock on each call, execution time and number of stream calls are
+ * reported.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] Printing setup.
+ * - [1.3.2] Running formatted output iterations.
+ * - [1.3.3] Printing execution time and stream calls.
+ * .
+ */
+
+static void corebmk_test_001_003_setup(void) {
+  bmk_calls = 0U;
+  bmk_bytes = 0U;
+}
+
+static void corebmk_test_001_003_execute(void) {
+  time_msecs_t msecs;
+
+  /* [1.3.1] Printing setup.*/
+  test_set_step(1);
+  {
+    test_print("--- Prints: ");
+    test_printn(NPRINTS);
+    test_println("");
+    test_print("--- Buffer: ");
+    test_printn(CHPRINTF_BUFFER_SIZE);
+    test_println(" bytes");
+  }
+  test_end_step(1);
+
+  /* [1.3.2] Running formatted output iterations.*/
+  test_set_step(2);
+  {
+    systime_t start, end;
+    unsigned i;
+
+    /* Time stamp for benchmark start.*/
+    start = chVTGetSystemTime();
+
+    for (i = 0U; i < NPRINTS; i++) {
+      chprintf(&bmk_stream, "%s %5u: x=%d y=%-6d id=0x%08lX\r\n",
+               "log", i, -(int)i, (int)(i * 3U), (unsigned long)i * 40503UL);
+    }
+
+    /* Time stamp for benchmark end.*/
+    end = chVTGetSystemTime();
+    msecs = chTimeI2MS(chTimeDiffX(start, end));
+
+    test_assert(bmk_bytes > (size_t)(NPRINTS * 30), "output missing");
+  }
+  test_end_step(2);
+
+  /* [1.3.3] Printing execution time and stream calls.*/
+  test_set_step(3);
+  {
+    test_print("--- Time  : ");
+    test_printn(msecs);
+    test_println(" milliseconds");
+    test_print("--- Calls : ");
+    test_printn(bmk_calls / NPRINTS);
+    test_println(" stream calls per print");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t corebmk_test_001_003 = {
+  "Formatted output",
+  corebmk_test_001_003_setup,
+  NULL,
+  corebmk_test_001_003_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -260,6 +396,7 @@ static const testcase_t corebmk_test_001_002 = {
 const testcase_t * const corebmk_test_sequence_001_array[] = {
   &corebmk_test_001_001,
   &corebmk_test_001_002,
+  &corebmk_test_001_003,
   NULL
 };
 
@@ -0,0 +1,7 @@
+# List of all the ChibiOS/RT C++ wrappers test files.
+TESTCPPSRC += ${CHIBIOS}/test/cpp/source/test/cpp_test_root.cpp \
+              ${CHIBIOS}/test/cpp/source/test/cpp_test_sequence_001.cpp
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/cpp/source/test \
+           ${CHIBIOS}/os/various/cpp_wrappers
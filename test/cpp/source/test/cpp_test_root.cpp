@@ -0,0 +1,62 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @mainpage Test Suite Specification
+ * Test suite for the ChibiOS/RT C++ wrappers. The purpose of this suite
+ * is to perform unit tests on the header-only typed kernel objects
+ * templates, the suite source files are C++ sources.
+ *
+ * <h2>Test Sequences</h2>
+ * - @subpage cpp_test_sequence_001
+ * .
+ */
+
+/**
+ * @file    cpp_test_root.cpp
+ * @brief   Test Suite root structures code.
+ */
+
+#include "hal.h"
+#include "cpp_test_root.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Array of test sequences.
+ */
+const testsequence_t * const cpp_test_suite_array[] = {
+  &cpp_test_sequence_001,
+  NULL
+};
+
+/**
+ * @brief   Test suite root structure.
+ */
+const testsuite_t cpp_test_suite = {
+  "ChibiOS/RT C++ Wrappers Test Suite",
+  cpp_test_suite_array
+};
+
+/*===========================================================================*/
+/* Shared code.                                                              */
+/*===========================================================================*/
+
+#endif /* !defined(__DOXYGEN__) */
@@ -0,0 +1,284 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "cpp_test_root.h"
+
+/**
+ * @file    cpp_test_sequence_001.cpp
+ * @brief   Test Sequence 001 code.
+ *
+ * @page cpp_test_sequence_001 [1] C++ typed objects
+ *
+ * File: @ref cpp_test_sequence_001.cpp
+ *
+ * <h2>Description</h2>
+ * This sequence tests the durations conversions, the lock-free queue
+ * and the typed objects FIFO.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage cpp_test_001_001
+ * - @subpage cpp_test_001_002
+ * - @subpage cpp_test_001_003
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+using namespace chibios_rt;
+using namespace std::chrono_literals;
+
+/* Integral durations, rounded up like the TIME_xxx2I() macros.*/
+static_assert(toInterval(10ms) == TIME_MS2I(10));
+static_assert(toInterval(1500us) == TIME_US2I(1500));
+static_assert(toInterval(2s) == TIME_S2I(2));
+static_assert(toInterval(1us) == (sysinterval_t)1);
+static_assert(toInterval(0ms) == (sysinterval_t)0);
+
+/* Floating point durations, fractions of a tick are rounded up.*/
+static_assert(toInterval(std::chrono::duration<double, std::milli>(1.5)) ==
+              TIME_US2I(1500));
+static_assert(toInterval(std::chrono::duration<double, std::milli>(2.0)) ==
+              TIME_MS2I(2));
+static_assert(toInterval(std::chrono::duration<float, std::micro>(10.0f)) ==
+              (sysinterval_t)1);
+static_assert(toInterval(std::chrono::duration<double>(0.0)) ==
+              (sysinterval_t)0);
+
+/* Back conversions.*/
+static_assert(fromInterval<std::chrono::milliseconds>(TIME_MS2I(25)) == 25ms);
+static_assert(fromInterval<std::chrono::seconds>(TIME_MS2I(1500)) == 2s);
+
+struct Sample {
+  uint16_t                      ch;
+  int32_t                       value;
+};
+
+struct Tiny {
+  uint8_t                       b;
+};
+
+static SpscQueue<Sample, 8> queue;
+
+static THD_WORKING_AREA(waProducer, 1024);
+
+static THD_FUNCTION(Producer, arg) {
+  auto *fifop = static_cast<TypedObjectsFifo<Sample, 4> *>(arg);
+
+  for (int i = 0; i < 4; i++) {
+    Sample *sp = fifop->takeObject(TIME_INFINITE);
+    sp->ch    = (uint16_t)i;
+    sp->value = i * 100;
+    fifop->sendObject(sp);
+  }
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page cpp_test_001_001 [1.1] Intervals conversion
+ *
+ * <h2>Description</h2>
+ * The intervals conversions are mostly checked at compile time, this
+ * test checks the conversion of durations not known at compile time.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.1.1] Floating point durations are converted, fractions of a tick
+ *   are rounded up.
+ * - [1.1.2] Sleeping for a sub-tick duration lasts at least one tick.
+ * .
+ */
+
+static void cpp_test_001_001_execute(void) {
+  volatile double ms = 1.5;
+  volatile double us = 0.25;
+
+  /* [1.1.1] Floating point durations are converted, fractions of a tick
+     are rounded up.*/
+  test_set_step(1);
+  {
+    test_assert(toInterval(std::chrono::duration<double, std::milli>(ms)) ==
+                TIME_US2I(1500), "wrong interval");
+    test_assert(toInterval(std::chrono::duration<double, std::micro>(us)) ==
+                (sysinterval_t)1, "sub-tick duration not rounded up");
+  }
+  test_end_step(1);
+
+  /* [1.1.2] Sleeping for a sub-tick duration lasts at least one tick.*/
+  test_set_step(2);
+  {
+    systime_t start = chVTGetSystemTimeX();
+    sleepFor(std::chrono::duration<double, std::milli>(us));
+    test_assert(chVTTimeElapsedSinceX(start) >= (sysinterval_t)1,
+                "sleep too short");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t cpp_test_001_001 = {
+  "Intervals conversion",
+  NULL,
+  NULL,
+  cpp_test_001_001_execute
+};
+
+/**
+ * @page cpp_test_001_002 [1.2] Lock-free queue
+ *
+ * <h2>Description</h2>
+ * The lock-free queue is filled, overflowed and drained.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.2.1] The queue is filled, the overflow is detected.
+ * - [1.2.2] The queue is drained, the elements come out in order.
+ * - [1.2.3] An element is pushed from within a critical zone.
+ * .
+ */
+
+static void cpp_test_001_002_execute(void) {
+  Sample s;
+
+  /* [1.2.1] The queue is filled, the overflow is detected.*/
+  test_set_step(1);
+  {
+    for (int i = 0; i < (int)queue.capacity(); i++) {
+      test_assert(queue.push(Sample{(uint16_t)i, i}), "push failed");
+    }
+    test_assert(!queue.push(Sample{99U, 99}), "overflow not detected");
+    test_assert(queue.size() == queue.capacity(), "wrong size");
+  }
+  test_end_step(1);
+
+  /* [1.2.2] The queue is drained, the elements come out in order.*/
+  test_set_step(2);
+  {
+    for (int i = 0; i < (int)queue.capacity(); i++) {
+      test_assert(queue.pop(s) && (s.value == i), "wrong element");
+    }
+    test_assert(!queue.pop(s) && queue.empty(), "not empty");
+  }
+  test_end_step(2);
+
+  /* [1.2.3] An element is pushed from within a critical zone.*/
+  test_set_step(3);
+  {
+    {
+      CriticalZone cz;
+
+      (void)queue.push(Sample{1U, 2});
+    }
+    test_assert(queue.size() == 1U, "wrong size");
+    test_assert(queue.pop(s) && (s.value == 2), "wrong element");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t cpp_test_001_002 = {
+  "Lock-free queue",
+  NULL,
+  NULL,
+  cpp_test_001_002_execute
+};
+
+/**
+ * @page cpp_test_001_003 [1.3] Typed objects FIFO
+ *
+ * <h2>Description</h2>
+ * Objects are exchanged between two threads through a typed objects
+ * FIFO.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] A producer thread sends four objects, they are received in
+ *   order and returned.
+ * - [1.3.2] Receiving from the empty FIFO times out.
+ * - [1.3.3] Two small objects are taken, they are distinct.
+ * .
+ */
+
+static void cpp_test_001_003_execute(void) {
+  /* Constructed on first use, after the kernel initialization.*/
+  static TypedObjectsFifo<Sample, 4> fifo;
+  static TypedObjectsFifo<Tiny, 3> tinyfifo;
+  Sample *sp;
+
+  /* [1.3.1] A producer thread sends four objects, they are received in
+     order and returned.*/
+  test_set_step(1);
+  {
+    thread_t *tp = chThdCreateStatic(waProducer, sizeof (waProducer),
+                                     chThdGetPriorityX() + 1,
+                                     Producer, &fifo);
+    for (int i = 0; i < 4; i++) {
+      test_assert(fifo.receiveObject(sp, 100ms) == MSG_OK, "timeout");
+      test_assert(sp->value == i * 100, "wrong object");
+      fifo.returnObject(sp);
+    }
+    chThdWait(tp);
+  }
+  test_end_step(1);
+
+  /* [1.3.2] Receiving from the empty FIFO times out.*/
+  test_set_step(2);
+  {
+    test_assert(fifo.receiveObject(sp, 1ms) == MSG_TIMEOUT, "not empty");
+  }
+  test_end_step(2);
+
+  /* [1.3.3] Two small objects are taken, they are distinct.*/
+  test_set_step(3);
+  {
+    Tiny *a = tinyfifo.takeObject(TIME_IMMEDIATE);
+    Tiny *b = tinyfifo.takeObject(TIME_IMMEDIATE);
+    test_assert((a != nullptr) && (b != nullptr) && (a != b),
+                "wrong objects");
+    tinyfifo.returnObject(a);
+    tinyfifo.returnObject(b);
+  }
+  test_end_step(3);
+}
+
+static const testcase_t cpp_test_001_003 = {
+  "Typed objects FIFO",
+  NULL,
+  NULL,
+  cpp_test_001_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const cpp_test_sequence_001_array[] = {
+  &cpp_test_001_001,
+  &cpp_test_001_002,
+  &cpp_test_001_003,
+  NULL
+};
+
+/**
+ * @brief   C++ typed objects.
+ */
+const testsequence_t cpp_test_sequence_001 = {
+  "C++ typed objects",
+  cpp_test_sequence_001_array
+};
@@ -0,0 +1,79 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @mainpage Test Suite Specification
+ * Test suite for ChibiOS/HAL. The purpose of this suite is to perform
+ * unit tests on the portable HAL drivers and high level device drivers
+ * using the Posix simulator platform, the peripherals are emulated by
+ * the simulator port.
+ *
+ * <h2>Test Sequences</h2>
+ * - @subpage hal_test_sequence_001
+ * - @subpage hal_test_sequence_002
+ * - @subpage hal_test_sequence_003
+ * - @subpage hal_test_sequence_004
+ * - @subpage hal_test_sequence_005
+ * .
+ */
+
+/**
+ * @file    hal_test_root.c
+ * @brief   Test Suite root structures code.
+ */
+
+#include "hal.h"
+#include "hal_test_root.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Array of test sequences.
+ */
+const testsequence_t * const hal_test_suite_array[] = {
+#if ((HAL_USE_CAN == TRUE) && (CAN_USE_SW_QUEUES == TRUE)) || defined(__DOXYGEN__)
+  &hal_test_sequence_001,
+#endif
+#if ((HAL_USE_SERIAL_USB == TRUE) && (SERIAL_USB_USE_SUBMIT == TRUE)) || defined(__DOXYGEN__)
+  &hal_test_sequence_002,
+#endif
+#if ((HAL_USE_I2C == TRUE) && (HAL_USE_SPI == TRUE)) || defined(__DOXYGEN__)
+  &hal_test_sequence_003,
+#endif
+#if ((HAL_USE_PAL == TRUE) && (PAL_USE_CAPTURE == TRUE)) || defined(__DOXYGEN__)
+  &hal_test_sequence_004,
+#endif
+  &hal_test_sequence_005,
+  NULL
+};
+
+/**
+ * @brief   Test suite root structure.
+ */
+const testsuite_t hal_test_suite = {
+  "ChibiOS/HAL Test Suite",
+  hal_test_suite_array
+};
+
+/*===========================================================================*/
+/* Shared code.                                                              */
+/*===========================================================================*/
+
+#endif /* !defined(__DOXYGEN__) */
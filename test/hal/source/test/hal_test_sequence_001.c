@@ -0,0 +1,641 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "hal_test_root.h"
+
+/**
+ * @file    hal_test_sequence_001.c
+ * @brief   Test Sequence 001 code.
+ *
+ * @page hal_test_sequence_001 [1] CAN software queues
+ *
+ * File: @ref hal_test_sequence_001.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the CAN driver software queues, software filters
+ * and receive time stamps, CAND1 and CAND2 are connected to the same
+ * simulated bus.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (HAL_USE_CAN == TRUE) && (CAN_USE_SW_QUEUES == TRUE)
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage hal_test_001_001
+ * - @subpage hal_test_001_002
+ * - @subpage hal_test_001_003
+ * - @subpage hal_test_001_004
+ * - @subpage hal_test_001_005
+ * .
+ */
+
+#if ((HAL_USE_CAN == TRUE) && (CAN_USE_SW_QUEUES == TRUE)) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+/*
+ * CAND1 transmits, CAND2 receives, both are on the same simulated bus.
+ */
+static const CANConfig cancfg = {false};
+
+static event_listener_t el;
+
+static THD_WORKING_AREA(waReader, 1024);
+
+static CANRxFrame rxframes[CAN_RX_FIFO_SIZE + 8];
+
+static void mkframe(CANTxFrame *ctfp, uint32_t sid, uint8_t tag) {
+
+  memset(ctfp, 0, sizeof (CANTxFrame));
+  ctfp->SID      = sid;
+  ctfp->DLC      = 1U;
+  ctfp->data8[0] = tag;
+}
+
+static void flush(void) {
+
+  while (canReceiveManyTimeout(&CAND2, rxframes, NULL,
+                               sizeof rxframes / sizeof rxframes[0],
+                               TIME_MS2I(20)) > 0U) {
+  }
+  (void)chEvtGetAndClearEvents(ALL_EVENTS);
+  (void)chEvtGetAndClearFlags(&el);
+}
+
+static void mkextframe(CANTxFrame *ctfp, uint32_t eid, uint8_t tag) {
+
+  mkframe(ctfp, 0U, tag);
+  ctfp->IDE = 1U;
+  ctfp->EID = eid;
+}
+
+static bool sendframe(const CANTxFrame *ctfp) {
+
+  return canQueueTransmitTimeout(&CAND1, ctfp, TIME_MS2I(100)) == MSG_OK;
+}
+
+static void can_setup(void) {
+
+  canStart(&CAND1, &cancfg);
+  canStart(&CAND2, &cancfg);
+  chEvtRegisterMaskWithFlags(&CAND2.error_event, &el, EVENT_MASK(0),
+                             CAN_OVERFLOW_ERROR);
+  flush();
+}
+
+static void can_teardown(void) {
+
+  chEvtUnregister(&CAND2.error_event, &el);
+  canStop(&CAND2);
+  canStop(&CAND1);
+}
+
+static THD_FUNCTION(Reader, arg) {
+  CANRxFrame *crfp = (CANRxFrame *)arg;
+
+  chThdExit(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, crfp,
+                              TIME_MS2I(500)));
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page hal_test_001_001 [1.1] Transmit queue across sleep
+ *
+ * <h2>Description</h2>
+ * Frames queued while sleeping are transmitted after wakeup in
+ * identifier priority order, the queue reports full when exhausted.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.1.1] The transmitter is put to sleep, the transmit queue is
+ *   filled with decreasing identifiers, one more frame times out.
+ * - [1.1.2] Nothing is transmitted while sleeping.
+ * - [1.1.3] The transmitter is woken up, the frames are received in
+ *   identifier priority order.
+ * - [1.1.4] A further frame is queued and received.
+ * .
+ */
+
+static void hal_test_001_001_setup(void) {
+  can_setup();
+}
+
+static void hal_test_001_001_teardown(void) {
+  can_teardown();
+}
+
+static void hal_test_001_001_execute(void) {
+  CANTxFrame txf;
+  unsigned i;
+  size_t n;
+
+  /* [1.1.1] The transmitter is put to sleep, the transmit queue is
+     filled with decreasing identifiers, one more frame times out.*/
+  test_set_step(1);
+  {
+    canSleep(&CAND1);
+    for (i = 0U; i < (unsigned)CAN_TX_QUEUE_SIZE; i++) {
+      mkframe(&txf, 0x100U + (uint32_t)CAN_TX_QUEUE_SIZE - i, (uint8_t)i);
+      test_assert(canQueueTransmitTimeout(&CAND1, &txf,
+                                          TIME_IMMEDIATE) == MSG_OK,
+                  "queue failed");
+    }
+    mkframe(&txf, 0x100U, 0xFFU);
+    test_assert(canQueueTransmitTimeout(&CAND1, &txf,
+                                        TIME_MS2I(10)) == MSG_TIMEOUT,
+                "queue not full");
+  }
+  test_end_step(1);
+
+  /* [1.1.2] Nothing is transmitted while sleeping.*/
+  test_set_step(2);
+  {
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(20)) == MSG_TIMEOUT,
+                "transmitted while sleeping");
+  }
+  test_end_step(2);
+
+  /* [1.1.3] The transmitter is woken up, the frames are received in
+     identifier priority order.*/
+  test_set_step(3);
+  {
+    canWakeup(&CAND1);
+    n = 0U;
+    while (n < (size_t)CAN_TX_QUEUE_SIZE) {
+      size_t m = canReceiveManyTimeout(&CAND2, &rxframes[n], NULL,
+                                       (size_t)CAN_TX_QUEUE_SIZE - n,
+                                       TIME_MS2I(100));
+      test_assert(m > 0U, "frames missing");
+      n += m;
+    }
+    for (i = 0U; i < (unsigned)CAN_TX_QUEUE_SIZE; i++) {
+      test_assert(rxframes[i].SID == 0x101U + i, "wrong order");
+    }
+  }
+  test_end_step(3);
+
+  /* [1.1.4] A further frame is queued and received.*/
+  test_set_step(4);
+  {
+    mkframe(&txf, 0x321U, 0x55U);
+    test_assert(canQueueTransmitTimeout(&CAND1, &txf,
+                                        TIME_IMMEDIATE) == MSG_OK,
+                "queue failed");
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(100)) == MSG_OK,
+                "not received");
+    test_assert((rxframes[0].SID == 0x321U) &&
+                (rxframes[0].data8[0] == 0x55U), "wrong frame");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t hal_test_001_001 = {
+  "Transmit queue across sleep",
+  hal_test_001_001_setup,
+  hal_test_001_001_teardown,
+  hal_test_001_001_execute
+};
+
+/**
+ * @page hal_test_001_002 [1.2] Receive across sleep
+ *
+ * <h2>Description</h2>
+ * Receivers wait while the driver is sleeping, buffered frames are
+ * delivered on wakeup.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.2.1] A frame is buffered then the receiver is put to sleep,
+ *   receive operations time out.
+ * - [1.2.2] A reader thread waits while sleeping, it receives the
+ *   buffered frame after wakeup.
+ * - [1.2.3] A further frame is queued and received.
+ * .
+ */
+
+static void hal_test_001_002_setup(void) {
+  can_setup();
+}
+
+static void hal_test_001_002_teardown(void) {
+  can_teardown();
+}
+
+static void hal_test_001_002_execute(void) {
+  CANTxFrame txf;
+  CANRxFrame rxf;
+  thread_t *tp;
+
+  /* [1.2.1] A frame is buffered then the receiver is put to sleep,
+     receive operations time out.*/
+  test_set_step(1);
+  {
+    mkframe(&txf, 0x222U, 1U);
+    test_assert(canQueueTransmitTimeout(&CAND1, &txf,
+                                        TIME_IMMEDIATE) == MSG_OK,
+                "queue failed");
+    chThdSleepMilliseconds(20);
+    canSleep(&CAND2);
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(20)) == MSG_TIMEOUT,
+                "received while sleeping");
+    test_assert(canReceiveManyTimeout(&CAND2, rxframes, NULL, 1U,
+                                      TIME_MS2I(20)) == 0U,
+                "received while sleeping");
+  }
+  test_end_step(1);
+
+  /* [1.2.2] A reader thread waits while sleeping, it receives the
+     buffered frame after wakeup.*/
+  test_set_step(2);
+  {
+    memset(&rxf, 0, sizeof rxf);
+    tp = chThdCreateStatic(waReader, sizeof waReader,
+                           chThdGetPriorityX() + 1, Reader, &rxf);
+    chThdSleepMilliseconds(20);
+    test_assert(rxf.SID == 0U, "received while sleeping");
+    canWakeup(&CAND2);
+    test_assert(chThdWait(tp) == MSG_OK, "reader not woken");
+    test_assert((rxf.SID == 0x222U) && (rxf.data8[0] == 1U), "wrong frame");
+  }
+  test_end_step(2);
+
+  /* [1.2.3] A further frame is queued and received.*/
+  test_set_step(3);
+  {
+    mkframe(&txf, 0x223U, 2U);
+    test_assert(canQueueTransmitTimeout(&CAND1, &txf,
+                                        TIME_IMMEDIATE) == MSG_OK,
+                "queue failed");
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(100)) == MSG_OK,
+                "not received");
+    test_assert(rxframes[0].SID == 0x223U, "wrong frame");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t hal_test_001_002 = {
+  "Receive across sleep",
+  hal_test_001_002_setup,
+  hal_test_001_002_teardown,
+  hal_test_001_002_execute
+};
+
+/**
+ * @page hal_test_001_003 [1.3] Receive FIFO overflow
+ *
+ * <h2>Description</h2>
+ * RX FIFO overflow, lost frames are counted and reported, the oldest
+ * frames are preserved.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] More frames than the RX FIFO size are transmitted.
+ * - [1.3.2] The overflow is reported and the lost frames are counted.
+ * - [1.3.3] The FIFO is drained, the oldest frames have been preserved.
+ * - [1.3.4] A further frame is received after the overflow.
+ * .
+ */
+
+static void hal_test_001_003_setup(void) {
+  can_setup();
+}
+
+static void hal_test_001_003_teardown(void) {
+  can_teardown();
+}
+
+static void hal_test_001_003_execute(void) {
+  CANTxFrame txf;
+  size_t i, n;
+
+  /* [1.3.1] More frames than the RX FIFO size are transmitted.*/
+  test_set_step(1);
+  {
+    for (i = 0U; i < (size_t)CAN_RX_FIFO_SIZE + 8U; i++) {
+      mkframe(&txf, 0x7FFU, (uint8_t)i);
+      test_assert(canQueueTransmitTimeout(&CAND1, &txf,
+                                          TIME_MS2I(100)) == MSG_OK,
+                  "queue failed");
+    }
+    chThdSleepMilliseconds(20);
+  }
+  test_end_step(1);
+
+  /* [1.3.2] The overflow is reported and the lost frames are counted.*/
+  test_set_step(2);
+  {
+    test_assert((chEvtGetAndClearFlags(&el) & CAN_OVERFLOW_ERROR) != 0U,
+                "overflow not reported");
+    test_assert(CAND2.rxlost == 8U, "wrong lost frames count");
+  }
+  test_end_step(2);
+
+  /* [1.3.3] The FIFO is drained, the oldest frames have been
+     preserved.*/
+  test_set_step(3);
+  {
+    n = canReceiveManyTimeout(&CAND2, rxframes, NULL,
+                              sizeof rxframes / sizeof rxframes[0],
+                              TIME_MS2I(100));
+    test_assert(n == (size_t)CAN_RX_FIFO_SIZE, "wrong FIFO content");
+    for (i = 0U; i < n; i++) {
+      test_assert(rxframes[i].data8[0] == (uint8_t)i, "wrong order");
+    }
+  }
+  test_end_step(3);
+
+  /* [1.3.4] A further frame is received after the overflow.*/
+  test_set_step(4);
+  {
+    mkframe(&txf, 0x100U, 0xAAU);
+    test_assert(canQueueTransmitTimeout(&CAND1, &txf,
+                                        TIME_IMMEDIATE) == MSG_OK,
+                "queue failed");
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(100)) == MSG_OK,
+                "not received after overflow");
+    test_assert(rxframes[0].data8[0] == 0xAAU, "wrong frame");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t hal_test_001_003 = {
+  "Receive FIFO overflow",
+  hal_test_001_003_setup,
+  hal_test_001_003_teardown,
+  hal_test_001_003_execute
+};
+
+/**
+ * @page hal_test_001_004 [1.4] Software filters
+ *
+ * <h2>Description</h2>
+ * Exact-match and mask software filters are installed on the receiver,
+ * rejected frames are discarded before reaching the RX FIFO, accepted
+ * frames are received in order.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.4.1] A filters set not leaving a free slot in the hash table is
+ *   refused, the filters are then installed.
+ * - [1.4.2] Frames matching neither the identifiers nor the mask are
+ *   rejected, an extended frame does not match a standard identifier
+ *   with the same value.
+ * - [1.4.3] Frames matching an exact identifier, standard or extended,
+ *   or the mask are accepted.
+ * - [1.4.4] Accepted and rejected frames are mixed, only the accepted
+ *   ones reach the RX FIFO.
+ * - [1.4.5] The filters are removed, a previously rejected frame is
+ *   accepted.
+ * .
+ */
+
+static void hal_test_001_004_setup(void) {
+  can_setup();
+}
+
+static void hal_test_001_004_teardown(void) {
+  (void)canSetSoftwareFilters(&CAND2, NULL);
+  can_teardown();
+}
+
+static void hal_test_001_004_execute(void) {
+  static const uint32_t ids[] = {
+    CAN_SW_SID(0x120U), CAN_SW_SID(0x345U), CAN_SW_EID(0x1ABCDEU)
+  };
+  static const CANSwMask masks[] = {
+    {CAN_SW_SID(0x700U), CAN_SW_IDE | 0x7F0U}
+  };
+  static const CANSwFilters filters = {ids, 3U, masks, 1U};
+  static uint32_t manyids[CAN_SW_FILTERS_HASH_SIZE];
+  static const CANSwFilters toomany = {manyids, CAN_SW_FILTERS_HASH_SIZE,
+                                       NULL, 0U};
+  CANTxFrame txf;
+  size_t n;
+
+  /* [1.4.1] A filters set not leaving a free slot in the hash table is
+     refused, the filters are then installed.*/
+  test_set_step(1);
+  {
+    test_assert(canSetSoftwareFilters(&CAND2, &toomany) == HAL_RET_CONFIG_ERROR,
+                "too many identifiers accepted");
+    test_assert(canSetSoftwareFilters(&CAND2, &filters) == HAL_RET_SUCCESS,
+                "filters not installed");
+  }
+  test_end_step(1);
+
+  /* [1.4.2] Frames matching neither the identifiers nor the mask are
+     rejected, an extended frame does not match a standard identifier
+     with the same value.*/
+  test_set_step(2);
+  {
+    mkframe(&txf, 0x121U, 1U);
+    test_assert(sendframe(&txf), "queue failed");
+    mkframe(&txf, 0x710U, 2U);
+    test_assert(sendframe(&txf), "queue failed");
+    mkextframe(&txf, 0x120U, 3U);
+    test_assert(sendframe(&txf), "queue failed");
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(20)) == MSG_TIMEOUT,
+                "rejected frame received");
+    test_assert(CAND2.rxlost == 0U, "rejected frame counted as lost");
+  }
+  test_end_step(2);
+
+  /* [1.4.3] Frames matching an exact identifier, standard or extended,
+     or the mask are accepted.*/
+  test_set_step(3);
+  {
+    mkframe(&txf, 0x345U, 4U);
+    test_assert(sendframe(&txf), "queue failed");
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(100)) == MSG_OK,
+                "exact-match frame not received");
+    test_assert((rxframes[0].SID == 0x345U) && (rxframes[0].data8[0] == 4U),
+                "wrong frame");
+    mkextframe(&txf, 0x1ABCDEU, 5U);
+    test_assert(sendframe(&txf), "queue failed");
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(100)) == MSG_OK,
+                "extended frame not received");
+    test_assert((rxframes[0].IDE == 1U) && (rxframes[0].EID == 0x1ABCDEU) &&
+                (rxframes[0].data8[0] == 5U), "wrong extended frame");
+    mkframe(&txf, 0x705U, 6U);
+    test_assert(sendframe(&txf), "queue failed");
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(100)) == MSG_OK,
+                "mask frame not received");
+    test_assert((rxframes[0].SID == 0x705U) && (rxframes[0].data8[0] == 6U),
+                "wrong frame");
+  }
+  test_end_step(3);
+
+  /* [1.4.4] Accepted and rejected frames are mixed, only the accepted
+     ones reach the RX FIFO.*/
+  test_set_step(4);
+  {
+    mkframe(&txf, 0x120U, 7U);
+    test_assert(sendframe(&txf), "queue failed");
+    mkframe(&txf, 0x6F0U, 8U);
+    test_assert(sendframe(&txf), "queue failed");
+    mkframe(&txf, 0x70FU, 9U);
+    test_assert(sendframe(&txf), "queue failed");
+    chThdSleepMilliseconds(20);
+    n = canReceiveManyTimeout(&CAND2, rxframes, NULL,
+                              sizeof rxframes / sizeof rxframes[0],
+                              TIME_MS2I(100));
+    test_assert(n == 2U, "wrong accepted frames number");
+    test_assert((rxframes[0].data8[0] != 8U) && (rxframes[1].data8[0] != 8U),
+                "rejected frame received");
+  }
+  test_end_step(4);
+
+  /* [1.4.5] The filters are removed, a previously rejected frame is
+     accepted.*/
+  test_set_step(5);
+  {
+    test_assert(canSetSoftwareFilters(&CAND2, NULL) == HAL_RET_SUCCESS,
+                "filters not removed");
+    mkframe(&txf, 0x121U, 10U);
+    test_assert(sendframe(&txf), "queue failed");
+    test_assert(canReceiveTimeout(&CAND2, CAN_ANY_MAILBOX, &rxframes[0],
+                                  TIME_MS2I(100)) == MSG_OK,
+                "not received");
+    test_assert((rxframes[0].SID == 0x121U) && (rxframes[0].data8[0] == 10U),
+                "wrong frame");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t hal_test_001_004 = {
+  "Software filters",
+  hal_test_001_004_setup,
+  hal_test_001_004_teardown,
+  hal_test_001_004_execute
+};
+
+/**
+ * @page hal_test_001_005 [1.5] Receive time stamps
+ *
+ * <h2>Description</h2>
+ * Frames are transmitted at intervals, the time stamps returned with
+ * the frames fall within the transmission intervals and are monotonic.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.5.1] Three frames are transmitted 5mS apart, the system time is
+ *   sampled before each transmission.
+ * - [1.5.2] The frames are received with their time stamps, each one
+ *   falls within its transmission interval.
+ * - [1.5.3] The time stamps are strictly increasing.
+ * .
+ */
+
+static void hal_test_001_005_setup(void) {
+  can_setup();
+}
+
+static void hal_test_001_005_teardown(void) {
+  can_teardown();
+}
+
+static void hal_test_001_005_execute(void) {
+  CANTxFrame txf;
+  systime_t marks[4];
+  systime_t stamps[3];
+  size_t i, n;
+
+  /* [1.5.1] Three frames are transmitted 5mS apart, the system time is
+     sampled before each transmission.*/
+  test_set_step(1);
+  {
+    for (i = 0U; i < 3U; i++) {
+      marks[i] = chVTGetSystemTimeX();
+      mkframe(&txf, 0x400U + (uint32_t)i, (uint8_t)i);
+      test_assert(sendframe(&txf), "queue failed");
+      chThdSleepMilliseconds(5);
+    }
+    marks[3] = chVTGetSystemTimeX();
+  }
+  test_end_step(1);
+
+  /* [1.5.2] The frames are received with their time stamps, each one
+     falls within its transmission interval.*/
+  test_set_step(2);
+  {
+    n = canReceiveManyTimeout(&CAND2, rxframes, stamps, 3U, TIME_MS2I(100));
+    test_assert(n == 3U, "wrong frames number");
+    for (i = 0U; i < 3U; i++) {
+      test_assert(rxframes[i].data8[0] == (uint8_t)i, "wrong order");
+      test_assert(chTimeIsInRangeX(stamps[i], marks[i], marks[i + 1U]),
+                  "time stamp out of range");
+    }
+  }
+  test_end_step(2);
+
+  /* [1.5.3] The time stamps are strictly increasing.*/
+  test_set_step(3);
+  {
+    for (i = 1U; i < 3U; i++) {
+      test_assert((chTimeDiffX(stamps[i - 1U], stamps[i]) > (sysinterval_t)0) &&
+                  (chTimeDiffX(stamps[i - 1U], stamps[i]) <= TIME_MS2I(100)),
+                  "time stamps not monotonic");
+    }
+  }
+  test_end_step(3);
+}
+
+static const testcase_t hal_test_001_005 = {
+  "Receive time stamps",
+  hal_test_001_005_setup,
+  hal_test_001_005_teardown,
+  hal_test_001_005_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const hal_test_sequence_001_array[] = {
+  &hal_test_001_001,
+  &hal_test_001_002,
+  &hal_test_001_003,
+  &hal_test_001_004,
+  &hal_test_001_005,
+  NULL
+};
+
+/**
+ * @brief   CAN software queues.
+ */
+const testsequence_t hal_test_sequence_001 = {
+  "CAN software queues",
+  hal_test_sequence_001_array
+};
+
+#endif /* (HAL_USE_CAN == TRUE) && (CAN_USE_SW_QUEUES == TRUE) */
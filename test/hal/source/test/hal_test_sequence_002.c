@@ -0,0 +1,403 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "hal_test_root.h"
+
+/**
+ * @file    hal_test_sequence_002.c
+ * @brief   Test Sequence 002 code.
+ *
+ * @page hal_test_sequence_002 [2] Serial over USB submitted buffers
+ *
+ * File: @ref hal_test_sequence_002.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the Serial over USB zero-copy transmit API, the
+ * USB low level driver is replaced by a fake one recording the IN
+ * transfers.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (HAL_USE_SERIAL_USB == TRUE) && (SERIAL_USB_USE_SUBMIT == TRUE)
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage hal_test_002_001
+ * - @subpage hal_test_002_002
+ * - @subpage hal_test_002_003
+ * .
+ */
+
+#if ((HAL_USE_SERIAL_USB == TRUE) && (SERIAL_USB_USE_SUBMIT == TRUE)) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+/*
+ * Fake USB low level driver, the IN transfers are not executed, they are
+ * recorded and completed on request by the test code.
+ */
+#define MAX_TRANSFERS       16
+
+static struct {
+  bool                      busy;
+  unsigned                  overlaps;
+  unsigned                  n;
+  const uint8_t             *buf[MAX_TRANSFERS];
+  size_t                    size[MAX_TRANSFERS];
+} fake;
+
+void usb_lld_init(void) {}
+void usb_lld_start(USBDriver *usbp) {(void)usbp;}
+void usb_lld_stop(USBDriver *usbp) {(void)usbp;}
+void usb_lld_reset(USBDriver *usbp) {(void)usbp;}
+void usb_lld_set_address(USBDriver *usbp) {(void)usbp;}
+void usb_lld_init_endpoint(USBDriver *usbp, usbep_t ep) {(void)usbp;(void)ep;}
+void usb_lld_disable_endpoints(USBDriver *usbp) {(void)usbp;}
+usbepstatus_t usb_lld_get_status_in(USBDriver *usbp, usbep_t ep) {
+  (void)usbp;(void)ep;
+  return EP_STATUS_ACTIVE;
+}
+usbepstatus_t usb_lld_get_status_out(USBDriver *usbp, usbep_t ep) {
+  (void)usbp;(void)ep;
+  return EP_STATUS_ACTIVE;
+}
+void usb_lld_read_setup(USBDriver *usbp, usbep_t ep, uint8_t *buf) {
+  (void)usbp;(void)ep;(void)buf;
+}
+void usb_lld_start_out(USBDriver *usbp, usbep_t ep) {(void)usbp;(void)ep;}
+void usb_lld_stall_out(USBDriver *usbp, usbep_t ep) {(void)usbp;(void)ep;}
+void usb_lld_stall_in(USBDriver *usbp, usbep_t ep) {(void)usbp;(void)ep;}
+void usb_lld_clear_out(USBDriver *usbp, usbep_t ep) {(void)usbp;(void)ep;}
+void usb_lld_clear_in(USBDriver *usbp, usbep_t ep) {(void)usbp;(void)ep;}
+
+void usb_lld_start_in(USBDriver *usbp, usbep_t ep) {
+  USBInEndpointState *isp = usbp->epc[ep]->in_state;
+
+  if (fake.busy) {
+    fake.overlaps++;
+  }
+  fake.busy = true;
+  if (fake.n < MAX_TRANSFERS) {
+    fake.buf[fake.n]  = isp->txbuf;
+    fake.size[fake.n] = isp->txsize;
+  }
+  fake.n++;
+}
+
+#define BULK_EP             1U
+
+static SerialUSBDriver SDU1;
+static USBDriver USBD1;
+static USBInEndpointState ep1instate;
+static USBOutEndpointState ep1outstate;
+
+static const USBEndpointConfig ep1config = {
+  USB_EP_MODE_TYPE_BULK,
+  NULL,
+  sduDataTransmitted,
+  sduDataReceived,
+  64,
+  64,
+  &ep1instate,
+  &ep1outstate
+};
+
+static const SerialUSBConfig serusbcfg = {
+  &USBD1,
+  BULK_EP,
+  BULK_EP,
+  0
+};
+
+static uint8_t data1[100], data2[60], data3[128];
+
+static sdu_txbuffer_t txb1, txb2, txb3;
+
+static unsigned completions, resubmissions;
+
+static void txcb(SerialUSBDriver *sdup, sdu_txbuffer_t *txbp) {
+
+  completions++;
+  if ((txbp->status == MSG_OK) && (resubmissions > 0U)) {
+    resubmissions--;
+    (void)sduSubmitTransmitI(sdup, txbp);
+  }
+}
+
+static void txbinit(sdu_txbuffer_t *txbp, const uint8_t *buf, size_t size) {
+
+  memset(txbp, 0, sizeof (sdu_txbuffer_t));
+  txbp->buf  = buf;
+  txbp->size = size;
+  txbp->cb   = txcb;
+}
+
+/*
+ * Completes the ongoing IN transfer, returns false if the endpoint is idle.
+ * The endpoint callback is invoked in an emulated ISR context, as a real
+ * USB LLD would do.
+ */
+static bool complete(void) {
+
+  if (!fake.busy) {
+    return false;
+  }
+  fake.busy = false;
+  OSAL_IRQ_PROLOGUE();
+  _usb_isr_invoke_in_cb(&USBD1, BULK_EP);
+  OSAL_IRQ_EPILOGUE();
+
+  return true;
+}
+
+static void sdu_setup(void) {
+
+  memset(&fake, 0, sizeof fake);
+  memset(&USBD1, 0, sizeof USBD1);
+  USBD1.state = USB_ACTIVE;
+  USBD1.epc[BULK_EP] = &ep1config;
+  sduObjectInit(&SDU1);
+  sduStart(&SDU1, &serusbcfg);
+  chSysLock();
+  sduConfigureHookI(&SDU1);
+  chSysUnlock();
+  txbinit(&txb1, data1, sizeof data1);
+  txbinit(&txb2, data2, sizeof data2);
+  txbinit(&txb3, data3, sizeof data3);
+  completions   = 0U;
+  resubmissions = 0U;
+}
+
+static void sdu_teardown(void) {
+
+  if (SDU1.state == SDU_READY) {
+    sduStop(&SDU1);
+  }
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page hal_test_002_001 [2.1] Submitted buffers
+ *
+ * <h2>Description</h2>
+ * Submitted buffers are transmitted in order, a zero length packet
+ * follows a transfer multiple of the packet size.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.1.1] Two buffers are submitted, the first one is transmitted.
+ * - [2.1.2] The first transfer is completed, the second buffer is
+ *   transmitted.
+ * - [2.1.3] The second transfer is completed, a zero length packet
+ *   follows.
+ * .
+ */
+
+static void hal_test_002_001_setup(void) {
+  sdu_setup();
+}
+
+static void hal_test_002_001_teardown(void) {
+  sdu_teardown();
+}
+
+static void hal_test_002_001_execute(void) {
+
+  /* [2.1.1] Two buffers are submitted, the first one is transmitted.*/
+  test_set_step(1);
+  {
+    test_assert(sduSubmitTransmit(&SDU1, &txb1) == MSG_OK, "submit failed");
+    test_assert(sduSubmitTransmit(&SDU1, &txb3) == MSG_OK, "submit failed");
+    test_assert((fake.n == 1U) && (fake.buf[0] == data1) &&
+                (fake.size[0] == sizeof data1), "wrong transfer");
+  }
+  test_end_step(1);
+
+  /* [2.1.2] The first transfer is completed, the second buffer is
+     transmitted.*/
+  test_set_step(2);
+  {
+    test_assert(complete(), "not transmitting");
+    test_assert((completions == 1U) && (txb1.status == MSG_OK),
+                "not completed");
+    test_assert((fake.n == 2U) && (fake.buf[1] == data3) &&
+                (fake.size[1] == sizeof data3), "wrong transfer");
+  }
+  test_end_step(2);
+
+  /* [2.1.3] The second transfer is completed, a zero length packet
+     follows.*/
+  test_set_step(3);
+  {
+    test_assert(complete(), "not transmitting");
+    test_assert(completions == 2U, "not completed");
+    test_assert((fake.n == 3U) && (fake.size[2] == 0U), "no ZLP");
+    test_assert(complete(), "not transmitting");
+    test_assert(!complete(), "still transmitting");
+    test_assert(fake.overlaps == 0U, "overlapped transfers");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t hal_test_002_001 = {
+  "Submitted buffers",
+  hal_test_002_001_setup,
+  hal_test_002_001_teardown,
+  hal_test_002_001_execute
+};
+
+/**
+ * @page hal_test_002_002 [2.2] Resubmission from the callback
+ *
+ * <h2>Description</h2>
+ * Buffers are submitted again from the completion callback, with and
+ * without other buffers pending.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.2.1] A buffer is resubmitted twice from its callback, the
+ *   transfers do not overlap.
+ * - [2.2.2] A buffer is resubmitted while another one is pending, it is
+ *   queued after it.
+ * .
+ */
+
+static void hal_test_002_002_setup(void) {
+  sdu_setup();
+}
+
+static void hal_test_002_002_teardown(void) {
+  sdu_teardown();
+}
+
+static void hal_test_002_002_execute(void) {
+
+  /* [2.2.1] A buffer is resubmitted twice from its callback, the
+     transfers do not overlap.*/
+  test_set_step(1);
+  {
+    resubmissions = 2U;
+    test_assert(sduSubmitTransmit(&SDU1, &txb1) == MSG_OK, "submit failed");
+    while (complete()) {
+    }
+    test_assert(fake.overlaps == 0U, "overlapped transfers");
+    test_assert((completions == 3U) && (fake.n == 3U), "wrong transfers");
+    test_assert((fake.buf[1] == data1) && (fake.buf[2] == data1),
+                "wrong transfers");
+  }
+  test_end_step(1);
+
+  /* [2.2.2] A buffer is resubmitted while another one is pending, it is
+     queued after it.*/
+  test_set_step(2);
+  {
+    memset(&fake, 0, sizeof fake);
+    completions   = 0U;
+    resubmissions = 1U;
+    test_assert(sduSubmitTransmit(&SDU1, &txb1) == MSG_OK, "submit failed");
+    test_assert(sduSubmitTransmit(&SDU1, &txb2) == MSG_OK, "submit failed");
+    while (complete()) {
+    }
+    test_assert(fake.overlaps == 0U, "overlapped transfers");
+    test_assert((completions == 3U) && (fake.n == 3U), "wrong transfers");
+    test_assert((fake.buf[0] == data1) && (fake.buf[1] == data2) &&
+                (fake.buf[2] == data1), "wrong order");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t hal_test_002_002 = {
+  "Resubmission from the callback",
+  hal_test_002_002_setup,
+  hal_test_002_002_teardown,
+  hal_test_002_002_execute
+};
+
+/**
+ * @page hal_test_002_003 [2.3] Release on stop
+ *
+ * <h2>Description</h2>
+ * Pending buffers are released with MSG_RESET when the driver is
+ * stopped.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.3.1] Two buffers are submitted then the driver is stopped, both
+ *   are released, further submissions are refused.
+ * .
+ */
+
+static void hal_test_002_003_setup(void) {
+  sdu_setup();
+}
+
+static void hal_test_002_003_teardown(void) {
+  sdu_teardown();
+}
+
+static void hal_test_002_003_execute(void) {
+
+  /* [2.3.1] Two buffers are submitted then the driver is stopped, both
+     are released, further submissions are refused.*/
+  test_set_step(1);
+  {
+    test_assert(sduSubmitTransmit(&SDU1, &txb1) == MSG_OK, "submit failed");
+    test_assert(sduSubmitTransmit(&SDU1, &txb2) == MSG_OK, "submit failed");
+    sduStop(&SDU1);
+    test_assert((completions == 2U) && (txb1.status == MSG_RESET) &&
+                (txb2.status == MSG_RESET), "not released");
+    test_assert(sduSubmitTransmit(&SDU1, &txb1) == MSG_RESET,
+                "submitted while stopped");
+  }
+  test_end_step(1);
+}
+
+static const testcase_t hal_test_002_003 = {
+  "Release on stop",
+  hal_test_002_003_setup,
+  hal_test_002_003_teardown,
+  hal_test_002_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const hal_test_sequence_002_array[] = {
+  &hal_test_002_001,
+  &hal_test_002_002,
+  &hal_test_002_003,
+  NULL
+};
+
+/**
+ * @brief   Serial over USB submitted buffers.
+ */
+const testsequence_t hal_test_sequence_002 = {
+  "Serial over USB submitted buffers",
+  hal_test_sequence_002_array
+};
+
+#endif /* (HAL_USE_SERIAL_USB == TRUE) && (SERIAL_USB_USE_SUBMIT == TRUE) */
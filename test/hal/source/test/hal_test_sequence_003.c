@@ -0,0 +1,611 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "hal_test_root.h"
+
+/**
+ * @file    hal_test_sequence_003.c
+ * @brief   Test Sequence 003 code.
+ *
+ * @page hal_test_sequence_003 [3] Sensors on simulated buses
+ *
+ * File: @ref hal_test_sequence_003.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the LSM6DSL, LPS22HB, ADXL355 and LIS3DSH drivers
+ * against the device models in os/hal/ports/simulator/devices, attached
+ * to the simulated I2C and SPI buses. The FIFO streaming interface, the
+ * samples order and the number of bus transactions per read are
+ * checked, including the recovery after a FIFO overrun.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (HAL_USE_I2C == TRUE) && (HAL_USE_SPI == TRUE)
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage hal_test_003_001
+ * - @subpage hal_test_003_002
+ * - @subpage hal_test_003_003
+ * - @subpage hal_test_003_004
+ * - @subpage hal_test_003_005
+ * - @subpage hal_test_003_006
+ * .
+ */
+
+#if ((HAL_USE_I2C == TRUE) && (HAL_USE_SPI == TRUE)) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "lsm6dsl.h"
+#include "lps22hb.h"
+#include "adxl355.h"
+#include "lis3dsh.h"
+#include "sim_lsm6dsl.h"
+#include "sim_lps22hb.h"
+#include "sim_adxl355.h"
+#include "sim_lis3dsh.h"
+
+/*
+ * The simulated devices produce samples where the axes of a sample are
+ * consecutive values and consecutive samples differ by four.
+ */
+#define LSM6DSL_SAD                         0x6AU
+#define LPS22HB_SAD                         0x5CU
+
+static sim_lsm6dsl_t simimu;
+static sim_lps22hb_t simbaro;
+static sim_adxl355_t simadxl;
+static sim_lis3dsh_t simlis;
+
+static const I2CConfig i2ccfg = {400000U, 2000U};
+static const I2CConfig slowcfg = {1000U, 0U};
+static const SPIConfig spicfg = {NULL, 10000000U, 1000U, &simadxl.dev};
+static const SPIConfig lisspicfg = {NULL, 10000000U, 1000U, &simlis.dev};
+
+static LSM6DSLDriver imu;
+static LPS22HBDriver baro;
+static ADXL355Driver adxl;
+static uint8_t adxltxbuf[ADXL355_COMM_BUFF_SIZE];
+static uint8_t adxlrxbuf[ADXL355_COMM_BUFF_SIZE];
+static LIS3DSHDriver lis;
+
+static const LSM6DSLConfig imucfg = {
+  &I2CD1, &i2ccfg, LSM6DSL_SAD_GND,
+  NULL, NULL, LSM6DSL_ACC_FS_2G, LSM6DSL_ACC_ODR_104HZ,
+  NULL, NULL, LSM6DSL_GYRO_FS_250DPS, LSM6DSL_GYRO_ODR_104HZ
+};
+
+static const LPS22HBConfig barocfg = {
+  &I2CD1, &i2ccfg, LPS22HB_SAD_GND, NULL, NULL, NULL, NULL, LPS22HB_ODR_10HZ
+};
+
+static const ADXL355Config adxlcfg = {
+  &SPID1, &spicfg, NULL, NULL, ADXL355_ACC_FS_2G, ADXL355_ACC_ODR_1000HZ
+};
+
+static const LIS3DSHConfig liscfg = {
+  &SPID1, &lisspicfg, NULL, NULL, LIS3DSH_ACC_FS_2G, LIS3DSH_ACC_ODR_400HZ
+};
+
+static int32_t samples[64 * 6];
+
+static void clear_stats(sim_bus_stats_t *stp) {
+
+  stp->transactions = 0U;
+  stp->bytes        = 0U;
+  stp->bustime      = 0U;
+}
+
+static bool attached = false;
+
+/*
+ * Device models attached to the simulated buses, the ADXL355 and the
+ * LIS3DSH are selected through the SPI configuration.
+ */
+static void sensors_setup(void) {
+
+  if (!attached) {
+    simLSM6DSLObjectInit(&simimu, LSM6DSL_SAD);
+    simLPS22HBObjectInit(&simbaro, LPS22HB_SAD);
+    simADXL355ObjectInit(&simadxl, 0);
+    simLIS3DSHObjectInit(&simlis, 0);
+    i2c_lld_attach_device(&I2CD1, &simimu.dev);
+    i2c_lld_attach_device(&I2CD1, &simbaro.dev);
+    attached = true;
+  }
+  i2cStart(&I2CD1, &i2ccfg);
+  spiStart(&SPID1, &spicfg);
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page hal_test_003_001 [3.1] Simulated I2C bus
+ *
+ * <h2>Description</h2>
+ * Transfers on the simulated I2C bus, addressing errors and timeouts.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.1.1] A transfer to an address without device is not
+ *   acknowledged.
+ * - [3.1.2] The LSM6DSL identification register is read.
+ * - [3.1.3] A transfer on a slow bus times out, the driver is locked
+ *   until restarted.
+ * .
+ */
+
+static void hal_test_003_001_setup(void) {
+  sensors_setup();
+}
+
+static void hal_test_003_001_execute(void) {
+  uint8_t b;
+
+  /* [3.1.1] A transfer to an address without device is not
+     acknowledged.*/
+  test_set_step(1);
+  {
+    b = 0x0FU;
+    test_assert(i2cMasterTransmitTimeout(&I2CD1, 0x10U, &b, 1, &b, 1,
+                                         TIME_INFINITE) == MSG_RESET,
+                "no NACK");
+    test_assert(i2cGetErrors(&I2CD1) == I2C_ACK_FAILURE, "wrong error");
+  }
+  test_end_step(1);
+
+  /* [3.1.2] The LSM6DSL identification register is read.*/
+  test_set_step(2);
+  {
+    b = 0x0FU;
+    test_assert(i2cMasterTransmitTimeout(&I2CD1, LSM6DSL_SAD, &b, 1, &b, 1,
+                                         TIME_INFINITE) == MSG_OK,
+                "transfer failed");
+    test_assert(b == 0x6AU, "wrong WHO_AM_I");
+  }
+  test_end_step(2);
+
+  /* [3.1.3] A transfer on a slow bus times out, the driver is locked
+     until restarted.*/
+  test_set_step(3);
+  {
+    i2cStart(&I2CD1, &slowcfg);
+    b = 0x0FU;
+    test_assert(i2cMasterTransmitTimeout(&I2CD1, LSM6DSL_SAD, &b, 1, &b, 1,
+                                         TIME_MS2I(2)) == MSG_TIMEOUT,
+                "no timeout");
+    test_assert(I2CD1.state == I2C_LOCKED, "not locked");
+    i2cStop(&I2CD1);
+    i2cStart(&I2CD1, &i2ccfg);
+  }
+  test_end_step(3);
+}
+
+static const testcase_t hal_test_003_001 = {
+  "Simulated I2C bus",
+  hal_test_003_001_setup,
+  NULL,
+  hal_test_003_001_execute
+};
+
+/**
+ * @page hal_test_003_002 [3.2] LSM6DSL stream
+ *
+ * <h2>Description</h2>
+ * LSM6DSL FIFO streaming, the samples are received in order and each
+ * read takes two bus transactions.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.2.1] The device is started, single samples are read from both
+ *   sensors.
+ * - [3.2.2] The stream is started and read periodically, no samples are
+ *   lost.
+ * - [3.2.3] The stream is stopped.
+ * .
+ */
+
+static void hal_test_003_002_setup(void) {
+  sensors_setup();
+}
+
+static void hal_test_003_002_execute(void) {
+  int32_t axes[3];
+  int32_t last;
+  size_t i, n, total;
+  unsigned k;
+
+  /* [3.2.1] The device is started, single samples are read from both
+     sensors.*/
+  test_set_step(1);
+  {
+    lsm6dslObjectInit(&imu);
+    lsm6dslStart(&imu, &imucfg);
+    chThdSleepMilliseconds(50);
+    test_assert(lsm6dslGyroscopeReadRaw(&imu, axes) == MSG_OK,
+                "read failed");
+    test_assert(((axes[1] - axes[0]) == 1) && ((axes[2] - axes[0]) == 2),
+                "wrong sample");
+    test_assert(lsm6dslAccelerometerReadRaw(&imu, axes) == MSG_OK,
+                "read failed");
+    test_assert(((axes[1] - axes[0]) == 1) && ((axes[2] - axes[0]) == 2),
+                "wrong sample");
+  }
+  test_end_step(1);
+
+  /* [3.2.2] The stream is started and read periodically, no samples are
+     lost.*/
+  test_set_step(2);
+  {
+    test_assert(lsm6dslStreamStart(&imu, 8U) == MSG_OK, "start failed");
+    clear_stats(&I2CD1.stats);
+    last  = -1;
+    total = 0U;
+    for (k = 0U; k < 10U; k++) {
+      chThdSleepMilliseconds(60);
+      test_assert(lsm6dslStreamReadRaw(&imu, samples, 64U, &n) == MSG_OK,
+                  "read failed");
+      for (i = 0U; i < n; i++) {
+        size_t c;
+
+        for (c = 0U; c < 6U; c++) {
+          test_assert(samples[i * 6U + c] == (int16_t)(samples[i * 6U] + c),
+                      "wrong sample");
+        }
+        test_assert((last < 0) || (samples[i * 6U] == (int16_t)(last + 4)),
+                    "sample lost");
+        last = samples[i * 6U];
+      }
+      total += n;
+    }
+    test_assert((total >= 55U) && (total <= 65U), "wrong samples count");
+    test_assert(I2CD1.stats.transactions == 20U,
+                "wrong transactions count");
+  }
+  test_end_step(2);
+
+  /* [3.2.3] The stream is stopped.*/
+  test_set_step(3);
+  {
+    test_assert(lsm6dslStreamStop(&imu) == MSG_OK, "stop failed");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t hal_test_003_002 = {
+  "LSM6DSL stream",
+  hal_test_003_002_setup,
+  NULL,
+  hal_test_003_002_execute
+};
+
+/**
+ * @page hal_test_003_003 [3.3] LSM6DSL stream overrun
+ *
+ * <h2>Description</h2>
+ * LSM6DSL FIFO overrun, the partial pattern is skipped and the stream
+ * restarts aligned.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.3.1] The stream is started and the FIFO overruns, the samples
+ *   read after the overrun are aligned.
+ * - [3.3.2] The stream and the device are stopped.
+ * .
+ */
+
+static void hal_test_003_003_setup(void) {
+  sensors_setup();
+}
+
+static void hal_test_003_003_execute(void) {
+  size_t i, n;
+
+  /* [3.3.1] The stream is started and the FIFO overruns, the samples
+     read after the overrun are aligned.*/
+  test_set_step(1);
+  {
+    test_assert(lsm6dslStreamStart(&imu, 8U) == MSG_OK, "start failed");
+    chThdSleepMilliseconds(3500);
+    clear_stats(&I2CD1.stats);
+    test_assert(lsm6dslStreamReadRaw(&imu, samples, 64U, &n) == MSG_OK,
+                "read failed");
+    test_assert(n == 64U, "wrong samples count");
+    /* The FIFO size is not a multiple of the sample size, after the
+       overrun the read pointer is within a sample and the partial sample
+       is discarded with an extra transaction.*/
+    test_assert(I2CD1.stats.transactions == 3U, "wrong transactions count");
+    for (i = 1U; i < n; i++) {
+      test_assert(samples[i * 6U] == (int16_t)(samples[(i - 1U) * 6U] + 4),
+                  "not aligned");
+    }
+  }
+  test_end_step(1);
+
+  /* [3.3.2] The stream and the device are stopped.*/
+  test_set_step(2);
+  {
+    test_assert(lsm6dslStreamStop(&imu) == MSG_OK, "stop failed");
+    lsm6dslStop(&imu);
+  }
+  test_end_step(2);
+}
+
+static const testcase_t hal_test_003_003 = {
+  "LSM6DSL stream overrun",
+  hal_test_003_003_setup,
+  NULL,
+  hal_test_003_003_execute
+};
+
+/**
+ * @page hal_test_003_004 [3.4] LPS22HB reads
+ *
+ * <h2>Description</h2>
+ * LPS22HB reads, each read takes a single bus transaction.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.4.1] The device is started, pressure and temperature are read.
+ * .
+ */
+
+static void hal_test_003_004_setup(void) {
+  sensors_setup();
+}
+
+static void hal_test_003_004_execute(void) {
+  int32_t value;
+
+  /* [3.4.1] The device is started, pressure and temperature are read.*/
+  test_set_step(1);
+  {
+    lps22hbObjectInit(&baro);
+    lps22hbStart(&baro, &barocfg);
+    chThdSleepMilliseconds(250);
+    clear_stats(&I2CD1.stats);
+    test_assert(lps22hbBarometerReadRaw(&baro, &value) == MSG_OK,
+                "read failed");
+    test_assert(value == (int32_t)((simbaro.seq - 1U) << 2), "wrong value");
+    test_assert(I2CD1.stats.transactions == 1U, "wrong transactions count");
+    test_assert(lps22hbThermometerReadRaw(&baro, &value) == MSG_OK,
+                "read failed");
+    test_assert(value == (int32_t)(((simbaro.seq - 1U) << 2) + 1U),
+                "wrong value");
+    lps22hbStop(&baro);
+  }
+  test_end_step(1);
+}
+
+static const testcase_t hal_test_003_004 = {
+  "LPS22HB reads",
+  hal_test_003_004_setup,
+  NULL,
+  hal_test_003_004_execute
+};
+
+/**
+ * @page hal_test_003_005 [3.5] ADXL355 stream
+ *
+ * <h2>Description</h2>
+ * ADXL355 FIFO streaming over SPI, the samples are received in order
+ * and each read takes two bus transactions.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.5.1] The device is started, a single sample is read.
+ * - [3.5.2] The stream is started and read periodically, no samples are
+ *   lost.
+ * - [3.5.3] The stream and the device are stopped.
+ * .
+ */
+
+static void hal_test_003_005_setup(void) {
+  sensors_setup();
+}
+
+static void hal_test_003_005_execute(void) {
+  int32_t axes[3];
+  int32_t last;
+  size_t i, n, total;
+  unsigned k;
+
+  /* [3.5.1] The device is started, a single sample is read.*/
+  test_set_step(1);
+  {
+    adxl355ObjectInit(&adxl, adxltxbuf, adxlrxbuf);
+    adxl355Start(&adxl, &adxlcfg);
+    chThdSleepMilliseconds(10);
+    test_assert(adxl355AccelerometerReadRaw(&adxl, axes) == MSG_OK,
+                "read failed");
+    test_assert(((axes[1] - axes[0]) == 1) && ((axes[2] - axes[0]) == 2),
+                "wrong sample");
+  }
+  test_end_step(1);
+
+  /* [3.5.2] The stream is started and read periodically, no samples are
+     lost.*/
+  test_set_step(2);
+  {
+    test_assert(adxl355StreamStart(&adxl, 16U) == MSG_OK, "start failed");
+    clear_stats(&SPID1.stats);
+    last  = -1;
+    total = 0U;
+    for (k = 0U; k < 20U; k++) {
+      chThdSleepMilliseconds(20);
+      test_assert(adxl355StreamReadRaw(&adxl, samples, 32U, &n) == MSG_OK,
+                  "read failed");
+      for (i = 0U; i < n; i++) {
+        test_assert((samples[i * 3U + 1U] == samples[i * 3U] + 1) &&
+                    (samples[i * 3U + 2U] == samples[i * 3U] + 2),
+                    "wrong sample");
+        test_assert((last < 0) || (samples[i * 3U] == last + 4),
+                    "sample lost");
+        last = samples[i * 3U];
+      }
+      total += n;
+    }
+    test_assert((total >= 380U) && (total <= 420U), "wrong samples count");
+    test_assert(SPID1.stats.transactions == 40U,
+                "wrong transactions count");
+  }
+  test_end_step(2);
+
+  /* [3.5.3] The stream and the device are stopped.*/
+  test_set_step(3);
+  {
+    test_assert(adxl355StreamStop(&adxl) == MSG_OK, "stop failed");
+    adxl355Stop(&adxl);
+  }
+  test_end_step(3);
+}
+
+static const testcase_t hal_test_003_005 = {
+  "ADXL355 stream",
+  hal_test_003_005_setup,
+  NULL,
+  hal_test_003_005_execute
+};
+
+/**
+ * @page hal_test_003_006 [3.6] LIS3DSH stream
+ *
+ * <h2>Description</h2>
+ * LIS3DSH FIFO streaming over SPI, the samples are received in order
+ * and each read takes two bus transactions, after an overrun the most
+ * recent samples are kept.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.6.1] The device is started, a single sample is read.
+ * - [3.6.2] The stream is started and read periodically, no samples are
+ *   lost.
+ * - [3.6.3] The FIFO overruns, the samples read are the most recent and
+ *   in order.
+ * - [3.6.4] The stream and the device are stopped.
+ * .
+ */
+
+static void hal_test_003_006_setup(void) {
+  sensors_setup();
+}
+
+static void hal_test_003_006_execute(void) {
+  int32_t axes[3];
+  int32_t last;
+  size_t i, n, total;
+  unsigned k;
+
+  /* [3.6.1] The device is started, a single sample is read.*/
+  test_set_step(1);
+  {
+    lis3dshObjectInit(&lis);
+    lis3dshStart(&lis, &liscfg);
+    chThdSleepMilliseconds(10);
+    test_assert(lis3dshAccelerometerReadRaw(&lis, axes) == MSG_OK,
+                "read failed");
+    test_assert(((axes[1] - axes[0]) == 1) && ((axes[2] - axes[0]) == 2),
+                "wrong sample");
+  }
+  test_end_step(1);
+
+  /* [3.6.2] The stream is started and read periodically, no samples are
+     lost.*/
+  test_set_step(2);
+  {
+    test_assert(lis3dshStreamStart(&lis, 16U) == MSG_OK, "start failed");
+    clear_stats(&SPID1.stats);
+    last  = -1;
+    total = 0U;
+    for (k = 0U; k < 20U; k++) {
+      chThdSleepMilliseconds(20);
+      test_assert(lis3dshStreamReadRaw(&lis, samples, 32U, &n) == MSG_OK,
+                  "read failed");
+      for (i = 0U; i < n; i++) {
+        test_assert((samples[i * 3U + 1U] == (int16_t)(samples[i * 3U] + 1)) &&
+                    (samples[i * 3U + 2U] == (int16_t)(samples[i * 3U] + 2)),
+                    "wrong sample");
+        test_assert((last < 0) || (samples[i * 3U] == (int16_t)(last + 4)),
+                    "sample lost");
+        last = samples[i * 3U];
+      }
+      total += n;
+    }
+    test_assert((total >= 150U) && (total <= 170U), "wrong samples count");
+    test_assert(SPID1.stats.transactions == 40U,
+                "wrong transactions count");
+  }
+  test_end_step(2);
+
+  /* [3.6.3] The FIFO overruns, the samples read are the most recent and
+     in order.*/
+  test_set_step(3);
+  {
+    chThdSleepMilliseconds(200);
+    test_assert(lis3dshStreamReadRaw(&lis, samples, 64U, &n) == MSG_OK,
+                "read failed");
+    test_assert(n == 31U, "wrong samples count");
+    test_assert(samples[0] != (int16_t)(last + 4), "samples not lost");
+    for (i = 1U; i < n; i++) {
+      test_assert(samples[i * 3U] == (int16_t)(samples[(i - 1U) * 3U] + 4),
+                  "not in order");
+    }
+  }
+  test_end_step(3);
+
+  /* [3.6.4] The stream and the device are stopped.*/
+  test_set_step(4);
+  {
+    test_assert(lis3dshStreamStop(&lis) == MSG_OK, "stop failed");
+    lis3dshStop(&lis);
+  }
+  test_end_step(4);
+}
+
+static const testcase_t hal_test_003_006 = {
+  "LIS3DSH stream",
+  hal_test_003_006_setup,
+  NULL,
+  hal_test_003_006_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const hal_test_sequence_003_array[] = {
+  &hal_test_003_001,
+  &hal_test_003_002,
+  &hal_test_003_003,
+  &hal_test_003_004,
+  &hal_test_003_005,
+  &hal_test_003_006,
+  NULL
+};
+
+/**
+ * @brief   Sensors on simulated buses.
+ */
+const testsequence_t hal_test_sequence_003 = {
+  "Sensors on simulated buses",
+  hal_test_sequence_003_array
+};
+
+#endif /* (HAL_USE_I2C == TRUE) && (HAL_USE_SPI == TRUE) */
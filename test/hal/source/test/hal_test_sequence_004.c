@@ -0,0 +1,381 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "hal_test_root.h"
+
+/**
+ * @file    hal_test_sequence_004.c
+ * @brief   Test Sequence 004 code.
+ *
+ * @page hal_test_sequence_004 [4] PAL edges capture
+ *
+ * File: @ref hal_test_sequence_004.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the PAL edges capture, the edges are injected
+ * using simPalWriteLinePin() and simPalWritePins(). The order and the
+ * timestamps of the captured edges, the watermark wakeup, the buffer
+ * overflow accounting, the edges selection on port-wide writes and the
+ * consumer release on stop are checked.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (HAL_USE_PAL == TRUE) && (PAL_USE_CAPTURE == TRUE)
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage hal_test_004_001
+ * - @subpage hal_test_004_002
+ * - @subpage hal_test_004_003
+ * .
+ */
+
+#if ((HAL_USE_PAL == TRUE) && (PAL_USE_CAPTURE == TRUE)) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#define LINE_A              PAL_LINE(IOPORT1, 3U)
+#define LINE_B              PAL_LINE(IOPORT2, 5U)
+
+#define CAP_SIZE            8U
+
+/* Upper bound between a pin change and its capture, the simulated
+   interrupts are served from the idle loop and the system tick.*/
+#define MAX_LATENCY         20000U
+
+static palcapture_t cap;
+static palcaprecord_t capbuf[CAP_SIZE];
+static palcaprecord_t records[CAP_SIZE * 2U];
+
+/* Realtime counter sampled just before each injected edge.*/
+static rtcnt_t injtimes[4];
+
+static THD_WORKING_AREA(waWorker, 1024);
+
+static void pal_setup(void) {
+
+  palCaptureObjectInit(&cap, capbuf, CAP_SIZE, 3U);
+}
+
+static void pal_teardown(void) {
+
+  palCaptureStop(&cap);
+  simPalWritePins(IOPORT1, ~(ioportmask_t)0, 0U);
+  simPalWritePins(IOPORT2, ~(ioportmask_t)0, 0U);
+  chThdSleepMilliseconds(2);
+}
+
+/*
+ * Checks a record timestamp against the time the edge has been injected.
+ */
+static bool time_ok(const palcaprecord_t *rp, rtcnt_t injected) {
+
+  return (rtcnt_t)(rp->time - injected) < (rtcnt_t)MAX_LATENCY;
+}
+
+static THD_FUNCTION(Injector, arg) {
+  unsigned i;
+
+  (void)arg;
+
+  for (i = 0U; i < 3U; i++) {
+    chThdSleepMilliseconds(2);
+    injtimes[i] = chSysGetRealtimeCounterX();
+    simPalWriteLinePin(LINE_A, (i & 1U) == 0U ? PAL_HIGH : PAL_LOW);
+  }
+}
+
+static THD_FUNCTION(Reader, arg) {
+
+  (void)arg;
+
+  chThdExit((msg_t)palCaptureReadTimeout(&cap, records, CAP_SIZE,
+                                         TIME_INFINITE));
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page hal_test_004_001 [4.1] Edges order and timestamps
+ *
+ * <h2>Description</h2>
+ * Edges on both directions are captured, the consumer is woken at the
+ * watermark and the records come in order with timestamps following the
+ * injection times.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.1.1] The capture is started, no records are returned without
+ *   edges.
+ * - [4.1.2] Three edges are injected by a thread, the consumer is woken
+ *   at the watermark.
+ * - [4.1.3] The timestamps follow the injection times.
+ * - [4.1.4] A single edge is injected, the partial records are returned
+ *   on timeout.
+ * .
+ */
+
+static void hal_test_004_001_setup(void) {
+  pal_setup();
+}
+
+static void hal_test_004_001_teardown(void) {
+  pal_teardown();
+}
+
+static void hal_test_004_001_execute(void) {
+  thread_t *tp;
+  size_t n;
+
+  /* [4.1.1] The capture is started, no records are returned without
+     edges.*/
+  test_set_step(1);
+  {
+    palCaptureStart(&cap, LINE_A, PAL_EVENT_MODE_BOTH_EDGES);
+    test_assert(palCaptureReadTimeout(&cap, records, CAP_SIZE,
+                                      TIME_MS2I(10)) == 0U,
+                "records without edges");
+  }
+  test_end_step(1);
+
+  /* [4.1.2] Three edges are injected by a thread, the consumer is woken
+     at the watermark.*/
+  test_set_step(2);
+  {
+    tp = chThdCreateStatic(waWorker, sizeof waWorker,
+                           chThdGetPriorityX() + 1, Injector, NULL);
+    n = palCaptureReadTimeout(&cap, records, CAP_SIZE, TIME_MS2I(1000));
+    chThdWait(tp);
+    test_assert(n == 3U, "watermark not reached");
+    test_assert((records[0].edge == PAL_EVENT_MODE_RISING_EDGE) &&
+                (records[1].edge == PAL_EVENT_MODE_FALLING_EDGE) &&
+                (records[2].edge == PAL_EVENT_MODE_RISING_EDGE),
+                "wrong edges");
+    test_assert((records[0].line == LINE_A) && (records[2].line == LINE_A),
+                "wrong line");
+  }
+  test_end_step(2);
+
+  /* [4.1.3] The timestamps follow the injection times.*/
+  test_set_step(3);
+  {
+    test_assert(time_ok(&records[0], injtimes[0]) &&
+                time_ok(&records[1], injtimes[1]) &&
+                time_ok(&records[2], injtimes[2]), "wrong timestamps");
+    test_assert(((rtcnt_t)(records[1].time - records[0].time) >= 1000U) &&
+                ((rtcnt_t)(records[2].time - records[1].time) >= 1000U),
+                "edges too close");
+  }
+  test_end_step(3);
+
+  /* [4.1.4] A single edge is injected, the partial records are returned
+     on timeout.*/
+  test_set_step(4);
+  {
+    injtimes[3] = chSysGetRealtimeCounterX();
+    simPalWriteLinePin(LINE_A, PAL_LOW);
+    test_assert(palCaptureReadTimeout(&cap, records, CAP_SIZE,
+                                      TIME_MS2I(10)) == 1U,
+                "partial records not returned");
+    test_assert((records[0].edge == PAL_EVENT_MODE_FALLING_EDGE) &&
+                time_ok(&records[0], injtimes[3]), "wrong record");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t hal_test_004_001 = {
+  "Edges order and timestamps",
+  hal_test_004_001_setup,
+  hal_test_004_001_teardown,
+  hal_test_004_001_execute
+};
+
+/**
+ * @page hal_test_004_002 [4.2] Buffer overflow
+ *
+ * <h2>Description</h2>
+ * Capture buffer overflow, the oldest records are preserved and the
+ * lost edges are counted.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.2.1] More edges than the buffer size are injected, the lost
+ *   edges are counted.
+ * - [4.2.2] The records are read in two parts, the oldest edges have
+ *   been preserved in order.
+ * .
+ */
+
+static void hal_test_004_002_setup(void) {
+  pal_setup();
+}
+
+static void hal_test_004_002_teardown(void) {
+  pal_teardown();
+}
+
+static void hal_test_004_002_execute(void) {
+  unsigned i;
+  size_t n;
+
+  /* [4.2.1] More edges than the buffer size are injected, the lost
+     edges are counted.*/
+  test_set_step(1);
+  {
+    palCaptureStart(&cap, LINE_A, PAL_EVENT_MODE_BOTH_EDGES);
+    for (i = 0U; i < CAP_SIZE + 4U; i++) {
+      simPalWriteLinePin(LINE_A, (i & 1U) == 0U ? PAL_HIGH : PAL_LOW);
+      chThdSleepMilliseconds(1);
+    }
+    test_assert(palCaptureGetOverflowsX(&cap) == 4U, "wrong overflows");
+  }
+  test_end_step(1);
+
+  /* [4.2.2] The records are read in two parts, the oldest edges have
+     been preserved in order.*/
+  test_set_step(2);
+  {
+    n = palCaptureReadTimeout(&cap, records, 5U, TIME_IMMEDIATE);
+    n += palCaptureReadTimeout(&cap, &records[n], CAP_SIZE, TIME_IMMEDIATE);
+    test_assert(n == CAP_SIZE, "wrong records number");
+    for (i = 0U; i < CAP_SIZE; i++) {
+      test_assert(records[i].edge == ((i & 1U) == 0U ?
+                                      PAL_EVENT_MODE_RISING_EDGE :
+                                      PAL_EVENT_MODE_FALLING_EDGE),
+                  "wrong order");
+      if (i > 0U) {
+        test_assert((rtcnt_t)(records[i].time - records[i - 1U].time) <
+                    (rtcnt_t)MAX_LATENCY, "timestamps not increasing");
+      }
+    }
+  }
+  test_end_step(2);
+}
+
+static const testcase_t hal_test_004_002 = {
+  "Buffer overflow",
+  hal_test_004_002_setup,
+  hal_test_004_002_teardown,
+  hal_test_004_002_execute
+};
+
+/**
+ * @page hal_test_004_003 [4.3] Port writes and stop
+ *
+ * <h2>Description</h2>
+ * Edges selection on a port-wide write, other pads and the disabled
+ * edge are not captured, stopping releases the consumer.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.3.1] Rising edges are captured on a pad while neighbouring pads
+ *   change, only the selected edge is recorded.
+ * - [4.3.2] A consumer is waiting, stopping the capture releases it and
+ *   disables the event.
+ * - [4.3.3] Edges after the stop are not captured.
+ * .
+ */
+
+static void hal_test_004_003_setup(void) {
+  pal_setup();
+}
+
+static void hal_test_004_003_teardown(void) {
+  pal_teardown();
+}
+
+static void hal_test_004_003_execute(void) {
+  thread_t *tp;
+  ioportmask_t mask = PAL_PORT_BIT(4) | PAL_PORT_BIT(5) | PAL_PORT_BIT(6);
+
+  /* [4.3.1] Rising edges are captured on a pad while neighbouring pads
+     change, only the selected edge is recorded.*/
+  test_set_step(1);
+  {
+    palCaptureObjectInit(&cap, capbuf, CAP_SIZE, 1U);
+    palCaptureStart(&cap, LINE_B, PAL_EVENT_MODE_RISING_EDGE);
+    simPalWritePins(IOPORT2, mask, PAL_PORT_BIT(4));
+    chThdSleepMilliseconds(2);
+    injtimes[0] = chSysGetRealtimeCounterX();
+    simPalWritePins(IOPORT2, mask, PAL_PORT_BIT(5) | PAL_PORT_BIT(6));
+    chThdSleepMilliseconds(2);
+    simPalWritePins(IOPORT2, mask, 0U);
+    chThdSleepMilliseconds(2);
+    test_assert(palCaptureReadTimeout(&cap, records, CAP_SIZE,
+                                      TIME_IMMEDIATE) == 1U,
+                "wrong records number");
+    test_assert((records[0].line == LINE_B) &&
+                (records[0].edge == PAL_EVENT_MODE_RISING_EDGE) &&
+                time_ok(&records[0], injtimes[0]), "wrong record");
+  }
+  test_end_step(1);
+
+  /* [4.3.2] A consumer is waiting, stopping the capture releases it and
+     disables the event.*/
+  test_set_step(2);
+  {
+    tp = chThdCreateStatic(waWorker, sizeof waWorker,
+                           chThdGetPriorityX() + 1, Reader, NULL);
+    chThdSleepMilliseconds(10);
+    palCaptureStop(&cap);
+    test_assert(chThdWait(tp) == 0, "consumer not released");
+    test_assert(!palIsLineEventEnabledX(LINE_B), "event still enabled");
+  }
+  test_end_step(2);
+
+  /* [4.3.3] Edges after the stop are not captured.*/
+  test_set_step(3);
+  {
+    simPalWriteLinePin(LINE_B, PAL_HIGH);
+    chThdSleepMilliseconds(2);
+    test_assert(palCaptureGetCountI(&cap) == 0U, "captured after stop");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t hal_test_004_003 = {
+  "Port writes and stop",
+  hal_test_004_003_setup,
+  hal_test_004_003_teardown,
+  hal_test_004_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const hal_test_sequence_004_array[] = {
+  &hal_test_004_001,
+  &hal_test_004_002,
+  &hal_test_004_003,
+  NULL
+};
+
+/**
+ * @brief   PAL edges capture.
+ */
+const testsequence_t hal_test_sequence_004 = {
+  "PAL edges capture",
+  hal_test_sequence_004_array
+};
+
+#endif /* (HAL_USE_PAL == TRUE) && (PAL_USE_CAPTURE == TRUE) */
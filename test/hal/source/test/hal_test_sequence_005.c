@@ -0,0 +1,481 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "hal_test_root.h"
+
+/**
+ * @file    hal_test_sequence_005.c
+ * @brief   Test Sequence 005 code.
+ *
+ * @page hal_test_sequence_005 [5] Queues
+ *
+ * File: @ref hal_test_sequence_005.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the spans access to the input and output queues.
+ * The spans are checked to never cross the buffer end while the queues
+ * are filled and drained across it, data beyond the input span is
+ * accessed using iqPeekI(), the waiting threads are resumed by the
+ * other side or by a reset.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage hal_test_005_001
+ * - @subpage hal_test_005_002
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#define QUEUE_SIZE          16U
+
+static uint8_t qbuf[QUEUE_SIZE];
+static input_queue_t iq;
+static output_queue_t oq;
+static unsigned notifications;
+
+static THD_WORKING_AREA(waWorker, 1024);
+
+static void notify(io_queue_t *qp) {
+
+  (void)qp;
+
+  notifications++;
+}
+
+static void queues_setup(void) {
+
+  notifications = 0U;
+  iqObjectInit(&iq, qbuf, QUEUE_SIZE, notify, NULL);
+  oqObjectInit(&oq, qbuf, QUEUE_SIZE, notify, NULL);
+}
+
+/*
+ * Fills a span with consecutive values starting from the specified one.
+ */
+static void fill(uint8_t *bp, size_t n, uint8_t first) {
+
+  while (n > 0U) {
+    *bp++ = first++;
+    n--;
+  }
+}
+
+/*
+ * Checks that a span contains consecutive values starting from the
+ * specified one.
+ */
+static bool check(const uint8_t *bp, size_t n, uint8_t first) {
+
+  while (n > 0U) {
+    if (*bp++ != first++) {
+      return false;
+    }
+    n--;
+  }
+
+  return true;
+}
+
+/*
+ * Low side of the input queue, a byte is posted after a delay.
+ */
+static THD_FUNCTION(Poster, arg) {
+  uint8_t *bp;
+  size_t n;
+
+  (void)arg;
+
+  chThdSleepMilliseconds(10);
+  chSysLock();
+  bp = iqGetEmptySpanI(&iq, &n);
+  *bp = 0x55U;
+  iqPostFullSpanI(&iq, 1U);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/*
+ * Low side of the output queue, a byte is sent after a delay.
+ */
+static THD_FUNCTION(Sender, arg) {
+
+  (void)arg;
+
+  chThdSleepMilliseconds(10);
+  chSysLock();
+  oqReleaseEmptySpanI(&oq, 1U);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/*
+ * The input queue is reset after a delay.
+ */
+static THD_FUNCTION(Resetter, arg) {
+
+  (void)arg;
+
+  chThdSleepMilliseconds(10);
+  chSysLock();
+  iqResetI(&iq);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page hal_test_005_001 [5.1] Input queue spans
+ *
+ * <h2>Description</h2>
+ * The input queue is filled and drained through spans across the buffer
+ * end, the spans never cross the buffer end and data after the span is
+ * reachable using iqPeekI().
+ *
+ * <h2>Test Steps</h2>
+ * - [5.1.1] The queue is empty, the empty span is the whole buffer and
+ *   there is no full span.
+ * - [5.1.2] Ten bytes are posted and six released, the consumer is
+ *   notified.
+ * - [5.1.3] The queue is filled across the buffer end, the empty spans
+ *   stop at the buffer end.
+ * - [5.1.4] The full span stops at the buffer end, the data after it is
+ *   peeked.
+ * - [5.1.5] More than the span is released, the read position wraps and
+ *   the queue is drained.
+ * - [5.1.6] The queue is filled, there is no empty span.
+ * - [5.1.7] A reader waits for a full span, it is resumed by a post.
+ * - [5.1.8] A reader waits for a full span, it is resumed by a reset.
+ * .
+ */
+
+static void hal_test_005_001_setup(void) {
+  queues_setup();
+}
+
+static void hal_test_005_001_execute(void) {
+  thread_t *tp;
+  uint8_t *bp;
+  size_t n;
+
+  /* [5.1.1] The queue is empty, the empty span is the whole buffer and
+     there is no full span.*/
+  test_set_step(1);
+  {
+    chSysLock();
+    bp = iqGetEmptySpanI(&iq, &n);
+    chSysUnlock();
+    test_assert((bp == qbuf) && (n == QUEUE_SIZE), "wrong empty span");
+    test_assert(iqGetFullSpanTimeout(&iq, &bp, &n,
+                                     TIME_IMMEDIATE) == MSG_TIMEOUT,
+                "full span on empty queue");
+  }
+  test_end_step(1);
+
+  /* [5.1.2] Ten bytes are posted and six released, the consumer is
+     notified.*/
+  test_set_step(2);
+  {
+    chSysLock();
+    bp = iqGetEmptySpanI(&iq, &n);
+    fill(bp, 10U, 0U);
+    iqPostFullSpanI(&iq, 10U);
+    chSysUnlock();
+    test_assert(iqGetFullSpanTimeout(&iq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no full span");
+    test_assert((bp == qbuf) && (n == 10U) && check(bp, n, 0U),
+                "wrong full span");
+    iqReleaseEmptySpan(&iq, 6U);
+    test_assert(notifications == 1U, "not notified");
+  }
+  test_end_step(2);
+
+  /* [5.1.3] The queue is filled across the buffer end, the empty spans
+     stop at the buffer end.*/
+  test_set_step(3);
+  {
+    chSysLock();
+    bp = iqGetEmptySpanI(&iq, &n);
+    chSysUnlock();
+    test_assert((bp == &qbuf[10]) && (n == 6U), "wrong empty span");
+    fill(bp, n, 10U);
+    chSysLock();
+    iqPostFullSpanI(&iq, n);
+    bp = iqGetEmptySpanI(&iq, &n);
+    chSysUnlock();
+    test_assert((bp == qbuf) && (n == 6U), "wrong wrapped empty span");
+    fill(bp, 4U, 16U);
+    chSysLock();
+    iqPostFullSpanI(&iq, 4U);
+    chSysUnlock();
+    test_assert(iqGetFullI(&iq) == 14U, "wrong counter");
+  }
+  test_end_step(3);
+
+  /* [5.1.4] The full span stops at the buffer end, the data after it is
+     peeked.*/
+  test_set_step(4);
+  {
+    test_assert(iqGetFullSpanTimeout(&iq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no full span");
+    test_assert((bp == &qbuf[6]) && (n == 10U) && check(bp, n, 6U),
+                "wrong full span");
+    test_assert_lock((iqPeekI(&iq, 0U) == 6) && (iqPeekI(&iq, 9U) == 15) &&
+                     (iqPeekI(&iq, 10U) == 16) && (iqPeekI(&iq, 13U) == 19),
+                     "wrong peeked data");
+    test_assert_lock(iqPeekI(&iq, 14U) == MSG_TIMEOUT, "peek beyond data");
+  }
+  test_end_step(4);
+
+  /* [5.1.5] More than the span is released, the read position wraps and
+     the queue is drained.*/
+  test_set_step(5);
+  {
+    chSysLock();
+    iqReleaseEmptySpanI(&iq, 12U);
+    chSysUnlock();
+    test_assert(iqGetFullSpanTimeout(&iq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no full span");
+    test_assert((bp == &qbuf[2]) && (n == 2U) && check(bp, n, 18U),
+                "wrong wrapped full span");
+    iqReleaseEmptySpan(&iq, 2U);
+    test_assert(iqIsEmptyI(&iq) && (notifications == 3U), "not drained");
+  }
+  test_end_step(5);
+
+  /* [5.1.6] The queue is filled, there is no empty span.*/
+  test_set_step(6);
+  {
+    chSysLock();
+    bp = iqGetEmptySpanI(&iq, &n);
+    iqPostFullSpanI(&iq, n);
+    bp = iqGetEmptySpanI(&iq, &n);
+    iqPostFullSpanI(&iq, n);
+    bp = iqGetEmptySpanI(&iq, &n);
+    chSysUnlock();
+    test_assert(iqIsFullI(&iq) && (bp == NULL) && (n == 0U),
+                "empty span on full queue");
+    chSysLock();
+    iqResetI(&iq);
+    chSysUnlock();
+  }
+  test_end_step(6);
+
+  /* [5.1.7] A reader waits for a full span, it is resumed by a post.*/
+  test_set_step(7);
+  {
+    tp = chThdCreateStatic(waWorker, sizeof waWorker,
+                           chThdGetPriorityX() + 1, Poster, NULL);
+    test_assert(iqGetFullSpanTimeout(&iq, &bp, &n, TIME_MS2I(1000)) == MSG_OK,
+                "not resumed");
+    chThdWait(tp);
+    test_assert((n == 1U) && (*bp == 0x55U), "wrong full span");
+    iqReleaseEmptySpan(&iq, 1U);
+  }
+  test_end_step(7);
+
+  /* [5.1.8] A reader waits for a full span, it is resumed by a reset.*/
+  test_set_step(8);
+  {
+    tp = chThdCreateStatic(waWorker, sizeof waWorker,
+                           chThdGetPriorityX() + 1, Resetter, NULL);
+    test_assert(iqGetFullSpanTimeout(&iq, &bp, &n,
+                                     TIME_MS2I(1000)) == MSG_RESET,
+                "not reset");
+    chThdWait(tp);
+  }
+  test_end_step(8);
+}
+
+static const testcase_t hal_test_005_001 = {
+  "Input queue spans",
+  hal_test_005_001_setup,
+  NULL,
+  hal_test_005_001_execute
+};
+
+/**
+ * @page hal_test_005_002 [5.2] Output queue spans
+ *
+ * <h2>Description</h2>
+ * The output queue is filled and drained through spans across the
+ * buffer end, the spans never cross the buffer end.
+ *
+ * <h2>Test Steps</h2>
+ * - [5.2.1] The queue is empty, the empty span is the whole buffer and
+ *   there is no full span.
+ * - [5.2.2] Ten bytes are posted, the low side is notified and six are
+ *   sent.
+ * - [5.2.3] The queue is filled across the buffer end, the empty spans
+ *   stop at the buffer end.
+ * - [5.2.4] The queue is drained across the buffer end, the full spans
+ *   stop at the buffer end.
+ * - [5.2.5] The queue is filled, there is no empty span.
+ * - [5.2.6] A writer waits for an empty span, it is resumed by a send.
+ * .
+ */
+
+static void hal_test_005_002_setup(void) {
+  queues_setup();
+}
+
+static void hal_test_005_002_execute(void) {
+  thread_t *tp;
+  uint8_t *bp;
+  size_t n;
+
+  /* [5.2.1] The queue is empty, the empty span is the whole buffer and
+     there is no full span.*/
+  test_set_step(1);
+  {
+    test_assert(oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no empty span");
+    test_assert((bp == qbuf) && (n == QUEUE_SIZE), "wrong empty span");
+    chSysLock();
+    bp = oqGetFullSpanI(&oq, &n);
+    chSysUnlock();
+    test_assert((bp == NULL) && (n == 0U), "full span on empty queue");
+  }
+  test_end_step(1);
+
+  /* [5.2.2] Ten bytes are posted, the low side is notified and six are
+     sent.*/
+  test_set_step(2);
+  {
+    test_assert(oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no empty span");
+    fill(bp, 10U, 0U);
+    oqPostFullSpan(&oq, 10U);
+    test_assert(notifications == 1U, "not notified");
+    chSysLock();
+    bp = oqGetFullSpanI(&oq, &n);
+    chSysUnlock();
+    test_assert((bp == qbuf) && (n == 10U) && check(bp, n, 0U),
+                "wrong full span");
+    chSysLock();
+    oqReleaseEmptySpanI(&oq, 6U);
+    chSysUnlock();
+  }
+  test_end_step(2);
+
+  /* [5.2.3] The queue is filled across the buffer end, the empty spans
+     stop at the buffer end.*/
+  test_set_step(3);
+  {
+    test_assert(oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no empty span");
+    test_assert((bp == &qbuf[10]) && (n == 6U), "wrong empty span");
+    fill(bp, n, 10U);
+    chSysLock();
+    oqPostFullSpanI(&oq, n);
+    chSysUnlock();
+    test_assert(oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no empty span");
+    test_assert((bp == qbuf) && (n == 6U), "wrong wrapped empty span");
+    fill(bp, 4U, 16U);
+    oqPostFullSpan(&oq, 4U);
+    test_assert((oqGetFullI(&oq) == 14U) && (notifications == 3U),
+                "wrong counter");
+  }
+  test_end_step(3);
+
+  /* [5.2.4] The queue is drained across the buffer end, the full spans
+     stop at the buffer end.*/
+  test_set_step(4);
+  {
+    chSysLock();
+    bp = oqGetFullSpanI(&oq, &n);
+    chSysUnlock();
+    test_assert((bp == &qbuf[6]) && (n == 10U) && check(bp, n, 6U),
+                "wrong full span");
+    chSysLock();
+    oqReleaseEmptySpanI(&oq, n);
+    bp = oqGetFullSpanI(&oq, &n);
+    chSysUnlock();
+    test_assert((bp == qbuf) && (n == 4U) && check(bp, n, 16U),
+                "wrong wrapped full span");
+    chSysLock();
+    oqReleaseEmptySpanI(&oq, n);
+    chSysUnlock();
+    test_assert(oqIsEmptyI(&oq), "not drained");
+  }
+  test_end_step(4);
+
+  /* [5.2.5] The queue is filled, there is no empty span.*/
+  test_set_step(5);
+  {
+    test_assert(oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no empty span");
+    test_assert((bp == &qbuf[4]) && (n == 12U), "wrong empty span");
+    oqPostFullSpan(&oq, n);
+    test_assert(oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK,
+                "no empty span");
+    test_assert((bp == qbuf) && (n == 4U), "wrong wrapped empty span");
+    oqPostFullSpan(&oq, n);
+    test_assert(oqIsFullI(&oq), "not full");
+    test_assert(oqGetEmptySpanTimeout(&oq, &bp, &n,
+                                      TIME_IMMEDIATE) == MSG_TIMEOUT,
+                "empty span on full queue");
+  }
+  test_end_step(5);
+
+  /* [5.2.6] A writer waits for an empty span, it is resumed by a
+     send.*/
+  test_set_step(6);
+  {
+    tp = chThdCreateStatic(waWorker, sizeof waWorker,
+                           chThdGetPriorityX() + 1, Sender, NULL);
+    test_assert(oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_MS2I(1000)) == MSG_OK,
+                "not resumed");
+    chThdWait(tp);
+    test_assert((bp == &qbuf[4]) && (n == 1U), "wrong empty span");
+  }
+  test_end_step(6);
+}
+
+static const testcase_t hal_test_005_002 = {
+  "Output queue spans",
+  hal_test_005_002_setup,
+  NULL,
+  hal_test_005_002_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const hal_test_sequence_005_array[] = {
+  &hal_test_005_001,
+  &hal_test_005_002,
+  NULL
+};
+
+/**
+ * @brief   Queues.
+ */
+const testsequence_t hal_test_sequence_005 = {
+  "Queues",
+  hal_test_sequence_005_array
+};
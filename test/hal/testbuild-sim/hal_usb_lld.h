@@ -0,0 +1,25 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_lld.h
+ * @brief   Simulator USB low level driver header.
+ * @details The simulator has no USB peripheral, the template header is
+ *          used and the low level functions are provided by the Serial
+ *          over USB test sequence.
+ */
+
+#include "../../../os/hal/templates/hal_usb_lld.h"
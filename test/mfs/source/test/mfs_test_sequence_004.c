@@ -0,0 +1,345 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "mfs_test_root.h"
+
+/**
+ * @file    mfs_test_sequence_004.c
+ * @brief   Test Sequence 004 code.
+ *
+ * @page mfs_test_sequence_004 [4] Benchmarks
+ *
+ * File: @ref mfs_test_sequence_004.c
+ *
+ * <h2>Description</h2>
+ * This sequence measures how mount, lookup and garbage collection
+ * scale with the number of records stored in the flash array and the
+ * throughput of the CRC kernels.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage mfs_test_004_001
+ * - @subpage mfs_test_004_002
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+#include "hal_mfs.h"
+#include "crc.h"
+
+#define BMK_RECORD_SIZE     4U
+
+static unsigned bmk_nrecords;
+
+static mfs_id_t bmk_id(unsigned i) {
+
+#if MFS_CFG_SPARSE_IDS == TRUE
+  /* Identifiers scattered over the whole 32 bits range.*/
+  return (mfs_id_t)((uint32_t)(i + 1U) * 0x9E3779B1U);
+#else
+  return (mfs_id_t)(i + 1U);
+#endif
+}
+
+static unsigned bmk_records_count(void) {
+  flash_offset_t recsize, n;
+
+  /* Records must fit in a single bank leaving space for the bank header
+     and for a spare record.*/
+  recsize = MFS_ALIGN_NEXT(sizeof (mfs_data_header_t) + BMK_RECORD_SIZE);
+  n = ((mfscfg1.bank_size - MFS_ALIGN_NEXT(sizeof (mfs_bank_header_t))) /
+       recsize) - 1U;
+  if (n > (flash_offset_t)MFS_CFG_MAX_RECORDS) {
+    n = (flash_offset_t)MFS_CFG_MAX_RECORDS;
+  }
+
+  return (unsigned)n;
+}
+
+static systime_t bmk_wait_tick(void) {
+
+  osalThreadSleep(1);
+  return osalOsGetSystemTimeX();
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page mfs_test_004_001 [4.1] Records scaling
+ *
+ * <h2>Description</h2>
+ * The flash array is filled with as many records as the configuration
+ * allows, then the number of mount, lookup and garbage collection
+ * operations performed in a one second time window is measured.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.1.1] The flash array is filled with records, the number of
+ *   records is printed.
+ * - [4.1.2] The number of mount operations performed in a one second
+ *   time window is measured and printed.
+ * - [4.1.3] The number of records read in a one second time window is
+ *   measured and printed.
+ * - [4.1.4] The number of garbage collection cycles performed in a one
+ *   second time window is measured and printed.
+ * - [4.1.5] All records are read back and verified.
+ * .
+ */
+
+static void mfs_test_004_001_setup(void) {
+  bank_erase(MFS_BANK_0);
+  bank_erase(MFS_BANK_1);
+  mfsStart(&mfs1, &mfscfg1);
+}
+
+static void mfs_test_004_001_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_004_001_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+
+  /* [4.1.1] The flash array is filled with records, the number of
+     records is printed.*/
+  test_set_step(1);
+  {
+    unsigned i;
+
+    bmk_nrecords = bmk_records_count();
+    for (i = 0U; i < bmk_nrecords; i++) {
+      mfs_error_t err;
+
+      err = mfsWriteRecord(&mfs1, bmk_id(i), BMK_RECORD_SIZE, mfs_pattern16);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+    }
+    test_print("--- Records : ");
+    test_printn(bmk_nrecords);
+    test_println("");
+  }
+  test_end_step(1);
+
+  /* [4.1.2] The number of mount operations performed in a one second
+     time window is measured and printed.*/
+  test_set_step(2);
+  {
+    n = 0;
+    start = bmk_wait_tick();
+    end = osalTimeAddX(start, TIME_MS2I(1000));
+    do {
+      mfs_error_t err;
+
+      mfsStop(&mfs1);
+      err = mfsStart(&mfs1, &mfscfg1);
+      test_assert(err == MFS_NO_ERROR, "mount failed");
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    test_print("--- Score : ");
+    test_printn(n);
+    test_println(" mounts/S");
+  }
+  test_end_step(2);
+
+  /* [4.1.3] The number of records read in a one second time window is
+     measured and printed.*/
+  test_set_step(3);
+  {
+    n = 0;
+    start = bmk_wait_tick();
+    end = osalTimeAddX(start, TIME_MS2I(1000));
+    do {
+      mfs_error_t err;
+      size_t size = sizeof __nocache_mfs_buffer;
+
+      err = mfsReadRecord(&mfs1, bmk_id(n % bmk_nrecords),
+                          &size, __nocache_mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      test_assert(size == BMK_RECORD_SIZE, "unexpected record length");
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    test_print("--- Score : ");
+    test_printn(n);
+    test_println(" reads/S");
+  }
+  test_end_step(3);
+
+  /* [4.1.4] The number of garbage collection cycles performed in a one
+     second time window is measured and printed.*/
+  test_set_step(4);
+  {
+    n = 0;
+    start = bmk_wait_tick();
+    end = osalTimeAddX(start, TIME_MS2I(1000));
+    do {
+      mfs_error_t err;
+
+      err = mfsPerformGarbageCollection(&mfs1);
+      test_assert(err == MFS_NO_ERROR, "garbage collection failed");
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    test_print("--- Score : ");
+    test_printn(n);
+    test_println(" collections/S");
+  }
+  test_end_step(4);
+
+  /* [4.1.5] All records are read back and verified.*/
+  test_set_step(5);
+  {
+    unsigned i;
+
+    for (i = 0U; i < bmk_nrecords; i++) {
+      mfs_error_t err;
+      size_t size = sizeof __nocache_mfs_buffer;
+
+      err = mfsReadRecord(&mfs1, bmk_id(i), &size, __nocache_mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      test_assert(size == BMK_RECORD_SIZE, "unexpected record length");
+      test_assert(memcmp(mfs_pattern16, __nocache_mfs_buffer, size) == 0,
+                  "wrong record content");
+    }
+  }
+  test_end_step(5);
+}
+
+static const testcase_t mfs_test_004_001 = {
+  "Records scaling",
+  mfs_test_004_001_setup,
+  mfs_test_004_001_teardown,
+  mfs_test_004_001_execute
+};
+
+/**
+ * @page mfs_test_004_002 [4.2] CRC throughput
+ *
+ * <h2>Description</h2>
+ * The CRC kernels used by MFS are checked against known values then
+ * the number of bytes processed in a one second time window is
+ * measured.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.2.1] The CRC of the standard check string is calculated and
+ *   compared with the expected values.
+ * - [4.2.2] The number of bytes processed by crc16() in a one second
+ *   time window is measured and printed.
+ * - [4.2.3] The number of bytes processed by crc32() in a one second
+ *   time window is measured and printed.
+ * .
+ */
+
+static void mfs_test_004_002_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+
+  /* [4.2.1] The CRC of the standard check string is calculated and
+     compared with the expected values.*/
+  test_set_step(1);
+  {
+    static const char check[] = "123456789";
+
+    test_assert(crc16(0xFFFFU, check, 9U) == 0x29B1U, "wrong CRC16");
+    test_assert(~crc32(0xFFFFFFFFU, check, 9U) == 0xCBF43926U, "wrong CRC32");
+  }
+  test_end_step(1);
+
+  /* [4.2.2] The number of bytes processed by crc16() in a one second
+     time window is measured and printed.*/
+  test_set_step(2);
+  {
+    uint16_t crc = 0xFFFFU;
+
+    n = 0;
+    start = bmk_wait_tick();
+    end = osalTimeAddX(start, TIME_MS2I(1000));
+    do {
+      crc = crc16(crc, mfs_pattern512, sizeof mfs_pattern512);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    (void)crc;
+    test_print("--- Score : ");
+    test_printn(n * sizeof mfs_pattern512);
+    test_println(" CRC16 bytes/S");
+  }
+  test_end_step(2);
+
+  /* [4.2.3] The number of bytes processed by crc32() in a one second
+     time window is measured and printed.*/
+  test_set_step(3);
+  {
+    uint32_t crc = 0xFFFFFFFFU;
+
+    n = 0;
+    start = bmk_wait_tick();
+    end = osalTimeAddX(start, TIME_MS2I(1000));
+    do {
+      crc = crc32(crc, mfs_pattern512, sizeof mfs_pattern512);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    (void)crc;
+    test_print("--- Score : ");
+    test_printn(n * sizeof mfs_pattern512);
+    test_println(" CRC32 bytes/S");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t mfs_test_004_002 = {
+  "CRC throughput",
+  NULL,
+  NULL,
+  mfs_test_004_002_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const mfs_test_sequence_004_array[] = {
+  &mfs_test_004_001,
+  &mfs_test_004_002,
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t mfs_test_sequence_004 = {
+  "Benchmarks",
+  mfs_test_sequence_004_array
+};
@@ -0,0 +1,62 @@
+#!/bin/bash
+export XOPT XDEFS
+
+XOPT="-ggdb -O2 -fomit-frame-pointer -DTEST_DELAY_BETWEEN_TESTS=0"
+XDEFS=""
+
+function clean() {
+  echo -n "  * Cleaning..."
+  make clean > /dev/null
+  rm -f flash.bin
+  echo "OK"
+}
+
+function compile() {
+  echo -n "  * Building..."
+  if ! make > buildlog.txt
+  then
+    echo "failed"
+    clean
+    exit
+  fi
+  mv -f buildlog.txt ./reports/${1}_build.txt
+  echo "OK"
+}
+
+function execute_test() {
+  echo -n "  * Testing..."
+  if ! ./build/ch > testlog.txt
+  then
+    echo "failed"
+    clean
+    exit
+  fi
+  grep -e "--- Records" -e "--- Score" testlog.txt
+  mv -f testlog.txt ./reports/${1}_test.txt
+  echo "OK"
+}
+
+function test() {
+  msg=$1": "$2
+  XDEFS=$2
+  echo $msg
+  compile $1
+  execute_test $1
+  clean
+}
+
+mkdir reports 2> /dev/null
+
+test dense32 "-DMFS_CFG_MAX_RECORDS=32"
+test dense512 "-DMFS_CFG_MAX_RECORDS=512"
+test dense4096 "-DMFS_CFG_MAX_RECORDS=4096"
+test sparse32 "-DMFS_CFG_SPARSE_IDS=TRUE -DMFS_CFG_MAX_RECORDS=32"
+test sparse512 "-DMFS_CFG_SPARSE_IDS=TRUE -DMFS_CFG_MAX_RECORDS=512"
+test sparse4096 "-DMFS_CFG_SPARSE_IDS=TRUE -DMFS_CFG_MAX_RECORDS=4096"
+test crc1 "-DMFS_CFG_MAX_RECORDS=512 -DCRC_CFG_SLICES=1"
+test crc4 "-DMFS_CFG_MAX_RECORDS=512 -DCRC_CFG_SLICES=4"
+test crc8 "-DMFS_CFG_MAX_RECORDS=512 -DCRC_CFG_SLICES=8"
+
+rm *log.txt 2> /dev/null
+echo
+echo "Done"
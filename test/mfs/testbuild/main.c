@@ -0,0 +1,81 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdlib.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "hal_mfs.h"
+#include "mfs_test_root.h"
+#include "console.h"
+
+/*
+ * File-backed flash, the image survives across runs.
+ */
+static const EFlashConfig eflcfg1 = {
+  .filename         = "flash.bin"
+};
+
+/*
+ * Banks size follows the number of records, the test suite requires a bank
+ * to not hold more than MFS_CFG_MAX_RECORDS 128 bytes records while the
+ * benchmarks need space for MFS_CFG_MAX_RECORDS small records.
+ */
+#if MFS_CFG_MAX_RECORDS <= 32
+#define BANK_SECTORS        1U
+#elif MFS_CFG_MAX_RECORDS <= 512
+#define BANK_SECTORS        4U
+#else
+#define BANK_SECTORS        32U
+#endif
+
+const MFSConfig mfscfg1 = {
+  .flashp           = (BaseFlash *)&EFLD1,
+  .erased           = 0xFFFFFFFFU,
+  .bank_size        = BANK_SECTORS * SIM_EFL_SECTOR_SIZE,
+  .bank0_start      = 0U,
+  .bank0_sectors    = BANK_SECTORS,
+  .bank1_start      = BANK_SECTORS,
+  .bank1_sectors    = BANK_SECTORS
+};
+
+/*
+ * Simulator main.
+ */
+int main(int argc, char *argv[]) {
+
+  (void)argc;
+  (void)argv;
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  conInit();
+  chSysInit();
+
+  eflStart(&EFLD1, &eflcfg1);
+
+  test_execute((BaseSequentialStream *)&CD1, &mfs_test_suite);
+  if (chtest.global_fail)
+    exit(1);
+  else
+    exit(0);
+}
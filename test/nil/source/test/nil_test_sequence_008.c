@@ -41,6 +41,7 @@
  * - @subpage nil_test_008_005
  * - @subpage nil_test_008_006
  * - @subpage nil_test_008_007
+ * - @subpage nil_test_008_008
  * .
  */
 
@@ -104,6 +105,19 @@ static THD_FUNCTION(bmk_thread4, p) {
   chSysUnlock();
 }
 
+#if ((CH_CFG_USE_SEMAPHORES == TRUE) && (CH_CFG_ST_TIMEDELTA == 0) &&      \
+     (PORT_SUPPORTS_RT == TRUE) && (CH_CFG_USE_WAITEXIT == TRUE)) ||       \
+    defined(__DOXYGEN__)
+CC_ALIGN_DATA(PORT_WORKING_AREA_ALIGN)
+static stkline_t wa_waiters[CH_CFG_MAX_THREADS]
+                           [THD_WORKING_AREA_SIZE(128) / sizeof (stkline_t)];
+
+static THD_FUNCTION(bmk_thread5, p) {
+
+  (void) chSemWaitTimeout(&sem1, (sysinterval_t)(uintptr_t)p);
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -541,25 +555,180 @@ static const testcase_t nil_test_008_006 = {
 };
 #endif /* CH_CFG_USE_SEMAPHORES == TRUE */
 
+#if ((CH_CFG_USE_SEMAPHORES == TRUE) && (CH_CFG_ST_TIMEDELTA == 0) &&      \
+     (PORT_SUPPORTS_RT == TRUE) && (CH_CFG_USE_WAITEXIT == TRUE)) ||       \
+    defined(__DOXYGEN__)
 /**
- * @page nil_test_008_007 [8.7] RAM Footprint
+ * @page nil_test_008_007 [8.7] System tick handler performance
  *
  * <h2>Description</h2>
- * The memory size of the various kernel objects is printed.
+ * All the free threads slots are filled with threads waiting on a
+ * semaphore, only one of them with a timeout. The time taken by the
+ * system tick handler is measured as the time stolen from the tester
+ * thread in a one second time window.<br> The test should be repeated
+ * with different @p CH_CFG_MAX_THREADS settings, with @p
+ * CH_CFG_USE_THREADS_BITMAPS enabled the score does not depend on the
+ * number of threads.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - ((CH_CFG_USE_SEMAPHORES == TRUE) && (CH_CFG_ST_TIMEDELTA == 0) &&
+ *   (PORT_SUPPORTS_RT == TRUE) && (CH_CFG_USE_WAITEXIT == TRUE))
+ * .
  *
  * <h2>Test Steps</h2>
- * - [8.7.1] The size of the system area is printed.
- * - [8.7.2] The size of a thread structure is printed.
- * - [8.7.3] The size of a semaphore structure is printed.
- * - [8.7.4] The size of an event source is printed.
- * - [8.7.5] The size of an event listener is printed.
- * - [8.7.6] The size of a mailbox is printed.
+ * - [8.7.1] The free threads slots are filled with waiting threads,
+ *   the first one waits with a timeout.
+ * - [8.7.2] The minimum duration of a realtime counter sampling loop
+ *   is measured.
+ * - [8.7.3] The realtime counter is sampled continuously in a one
+ *   second time window, loops taking longer than the minimum are
+ *   accounted as interrupts time.
+ * - [8.7.4] The waiting threads are released.
+ * - [8.7.5] Score is printed.
  * .
  */
 
+static void nil_test_008_007_setup(void) {
+  chSemObjectInit(&sem1, 0);
+}
+
+static void nil_test_008_007_teardown(void) {
+  chSemReset(&sem1, 0);
+}
+
 static void nil_test_008_007_execute(void) {
+  thread_t *waiters[CH_CFG_MAX_THREADS];
+  rtcnt_t stolen, threshold;
+  uint32_t n, nthreads;
+  tprio_t prio;
+
+  /* [8.7.1] The free threads slots are filled with waiting threads,
+     the first one waits with a timeout.*/
+  test_set_step(1);
+  {
+    nthreads = 1U;
+    for (prio = (tprio_t)0; prio < (tprio_t)CH_CFG_MAX_THREADS; prio++) {
+      thread_t *tp = &nil.threads[prio];
+
+      waiters[prio] = NULL;
+      if (NIL_THD_IS_WTSTART(tp) || NIL_THD_IS_FINAL(tp)) {
+        thread_descriptor_t td = {
+          .name  = "waiter",
+          .wbase = wa_waiters[prio],
+          .wend  = THD_WORKING_AREA_END(wa_waiters[prio]),
+          .prio  = prio,
+          .funcp = bmk_thread5,
+          .arg   = (void *)(uintptr_t)(nthreads == 1U ? TIME_S2I(10) :
+                                                        TIME_INFINITE)
+        };
+        waiters[prio] = chThdCreate(&td);
+        nthreads++;
+      }
+    }
+  }
+  test_end_step(1);
+
+  /* [8.7.2] The minimum duration of a realtime counter sampling loop
+     is measured.*/
+  test_set_step(2);
+  {
+    rtcnt_t last, now;
+    unsigned i;
+
+    threshold = (rtcnt_t)-1;
+    last = chSysGetRealtimeCounterX();
+    for (i = 0U; i < 1000U; i++) {
+      now = chSysGetRealtimeCounterX();
+      if ((rtcnt_t)(now - last) < threshold) {
+        threshold = (rtcnt_t)(now - last);
+      }
+      last = now;
+    }
+    threshold = (threshold + (rtcnt_t)1) * (rtcnt_t)4;
+  }
+  test_end_step(2);
+
+  /* [8.7.3] The realtime counter is sampled continuously in a one
+     second time window, loops taking longer than the minimum are
+     accounted as interrupts time.*/
+  test_set_step(3);
+  {
+    systime_t start, end;
+    rtcnt_t last, now;
+
+    n = 0U;
+    stolen = (rtcnt_t)0;
+    start = test_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    last = chSysGetRealtimeCounterX();
+    do {
+      now = chSysGetRealtimeCounterX();
+      if ((rtcnt_t)(now - last) > threshold) {
+        stolen += (rtcnt_t)(now - last);
+        n++;
+      }
+      last = now;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+  test_end_step(3);
+
+  /* [8.7.4] The waiting threads are released.*/
+  test_set_step(4);
+  {
+    chSemReset(&sem1, 0);
+    for (prio = (tprio_t)0; prio < (tprio_t)CH_CFG_MAX_THREADS; prio++) {
+      if (waiters[prio] != NULL) {
+        chThdWait(waiters[prio]);
+      }
+    }
+  }
+  test_end_step(4);
+
+  /* [8.7.5] Score is printed.*/
+  test_set_step(5);
+  {
+    test_print("--- Score : ");
+    test_printn(n > 0U ? (uint32_t)(stolen / (rtcnt_t)n) : 0U);
+    test_print(" RT counts/IRQ, ");
+    test_printn(nthreads);
+    test_println(" threads");
+  }
+  test_end_step(5);
+}
 
-  /* [8.7.1] The size of the system area is printed.*/
+static const testcase_t nil_test_008_007 = {
+  "System tick handler performance",
+  nil_test_008_007_setup,
+  nil_test_008_007_teardown,
+  nil_test_008_007_execute
+};
+#endif /* ((CH_CFG_USE_SEMAPHORES == TRUE) && (CH_CFG_ST_TIMEDELTA == 0) &&
+          (PORT_SUPPORTS_RT == TRUE) && (CH_CFG_USE_WAITEXIT == TRUE)) */
+
+/**
+ * @page nil_test_008_008 [8.8] RAM Footprint
+ *
+ * <h2>Description</h2>
+ * The memory size of the various kernel objects is printed.
+ *
+ * <h2>Test Steps</h2>
+ * - [8.8.1] The size of the system area is printed.
+ * - [8.8.2] The size of a thread structure is printed.
+ * - [8.8.3] The size of a semaphore structure is printed.
+ * - [8.8.4] The size of an event source is printed.
+ * - [8.8.5] The size of an event listener is printed.
+ * - [8.8.6] The size of a mailbox is printed.
+ * .
+ */
+
+static void nil_test_008_008_execute(void) {
+
+  /* [8.8.1] The size of the system area is printed.*/
   test_set_step(1);
   {
     test_print("--- OS    : ");
@@ -568,7 +737,7 @@ static void nil_test_008_007_execute(void) {
   }
   test_end_step(1);
 
-  /* [8.7.2] The size of a thread structure is printed.*/
+  /* [8.8.2] The size of a thread structure is printed.*/
   test_set_step(2);
   {
     test_print("--- Thread: ");
@@ -577,7 +746,7 @@ static void nil_test_008_007_execute(void) {
   }
   test_end_step(2);
 
-  /* [8.7.3] The size of a semaphore structure is printed.*/
+  /* [8.8.3] The size of a semaphore structure is printed.*/
   test_set_step(3);
   {
 #if CH_CFG_USE_SEMAPHORES || defined(__DOXYGEN__)
@@ -588,7 +757,7 @@ static void nil_test_008_007_execute(void) {
   }
   test_end_step(3);
 
-  /* [8.7.4] The size of an event source is printed.*/
+  /* [8.8.4] The size of an event source is printed.*/
   test_set_step(4);
   {
 #if CH_CFG_USE_EVENTS || defined(__DOXYGEN__)
@@ -599,7 +768,7 @@ static void nil_test_008_007_execute(void) {
   }
   test_end_step(4);
 
-  /* [8.7.5] The size of an event listener is printed.*/
+  /* [8.8.5] The size of an event listener is printed.*/
   test_set_step(5);
   {
 #if CH_CFG_USE_EVENTS || defined(__DOXYGEN__)
@@ -610,7 +779,7 @@ static void nil_test_008_007_execute(void) {
   }
   test_end_step(5);
 
-  /* [8.7.6] The size of a mailbox is printed.*/
+  /* [8.8.6] The size of a mailbox is printed.*/
   test_set_step(6);
   {
 #if CH_CFG_USE_MAILBOXES || defined(__DOXYGEN__)
@@ -622,11 +791,11 @@ static void nil_test_008_007_execute(void) {
   test_end_step(6);
 }
 
-static const testcase_t nil_test_008_007 = {
+static const testcase_t nil_test_008_008 = {
   "RAM Footprint",
   NULL,
   NULL,
-  nil_test_008_007_execute
+  nil_test_008_008_execute
 };
 
 /****************************************************************************
@@ -649,7 +818,12 @@ const testcase_t * const nil_test_sequence_008_array[] = {
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
   &nil_test_008_006,
 #endif
+#if ((CH_CFG_USE_SEMAPHORES == TRUE) && (CH_CFG_ST_TIMEDELTA == 0) &&      \
+     (PORT_SUPPORTS_RT == TRUE) && (CH_CFG_USE_WAITEXIT == TRUE)) ||       \
+    defined(__DOXYGEN__)
   &nil_test_008_007,
+#endif
+  &nil_test_008_008,
   NULL
 };
 
@@ -0,0 +1,174 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ch.h"
+
+/*
+ * Number of measured interrupts.
+ */
+#define ITERATIONS              1000000U
+
+static semaphore_t wsem, tsem;
+static uint64_t t0, total, best;
+static uint32_t count;
+
+static THD_WORKING_AREA(waTarget, 256);
+CC_ALIGN_DATA(PORT_WORKING_AREA_ALIGN)
+static stkline_t wa_waiters[CH_CFG_MAX_THREADS - 1]
+                           [THD_WORKING_AREA_SIZE(256) / sizeof (stkline_t)];
+
+/*
+ * Host monotonic time in nanoseconds.
+ */
+static uint64_t now_ns(void) {
+  struct timespec ts;
+
+  (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Threads filling the free slots, waiting forever.
+ */
+static THD_FUNCTION(waiter, arg) {
+
+  (void)arg;
+
+  (void) chSemWait(&wsem);
+}
+
+/*
+ * Target thread, it measures the time elapsed since the interrupt.
+ */
+static THD_FUNCTION(target, arg) {
+
+  (void)arg;
+
+  while (true) {
+    uint64_t dt;
+
+    (void) chSemWait(&tsem);
+    dt = now_ns() - t0;
+    total += dt;
+    if (dt < best) {
+      best = dt;
+    }
+    count++;
+  }
+}
+
+/*
+ * Threads table, the target thread has the lowest priority so it is the
+ * last found by any threads table scan, the other slots are filled at
+ * runtime.
+ */
+THD_TABLE_BEGIN
+  THD_TABLE_THREAD(CH_CFG_MAX_THREADS - 1, "target", waTarget, target, NULL)
+THD_TABLE_END
+
+/*
+ * There are no simulated interrupt sources, the benchmark raises its
+ * interrupts explicitly.
+ */
+void _sim_check_for_interrupts(void) {
+}
+
+/*
+ * Simulated interrupt waking the target thread, the preemption performed
+ * by the port on interrupt exit is emulated by the idle thread.
+ */
+static void interrupt(void) {
+
+  CH_IRQ_PROLOGUE();
+
+  chSysLockFromISR();
+  chSemSignalI(&tsem);
+  chSysUnlockFromISR();
+
+  CH_IRQ_EPILOGUE();
+
+  chSysLock();
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/*
+ * Simulator main.
+ */
+int main(void) {
+  uint64_t overhead, t;
+  tprio_t prio;
+  unsigned i;
+
+  /* The target thread starts waiting during the kernel initialization.*/
+  chSemObjectInit(&wsem, 0);
+  chSemObjectInit(&tsem, 0);
+
+  /*
+   * System initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  chSysInit();
+
+  /* All the remaining slots are filled by waiting threads.*/
+  for (prio = (tprio_t)0; prio < (tprio_t)(CH_CFG_MAX_THREADS - 1); prio++) {
+    thread_descriptor_t td = {
+      .name  = "waiter",
+      .wbase = wa_waiters[prio],
+      .wend  = THD_WORKING_AREA_END(wa_waiters[prio]),
+      .prio  = prio,
+      .funcp = waiter,
+      .arg   = NULL
+    };
+    (void) chThdCreate(&td);
+  }
+
+  /* Cost of the time measurement itself.*/
+  overhead = (uint64_t)-1;
+  for (i = 0U; i < 1000U; i++) {
+    t = now_ns();
+    t = now_ns() - t;
+    if (t < overhead) {
+      overhead = t;
+    }
+  }
+
+  /* This is now the idle thread, interrupts are raised from here.*/
+  best = (uint64_t)-1;
+  for (i = 0U; i < ITERATIONS; i++) {
+    t0 = now_ns();
+    interrupt();
+  }
+
+  if (count != ITERATIONS) {
+    printf("FAILED: %u wakeups out of %u\n", count, ITERATIONS);
+    exit(1);
+  }
+
+  printf("--- ISR to thread: %u threads, bitmaps %s, "
+         "%u ns average, %u ns best\n",
+         (unsigned)CH_CFG_MAX_THREADS,
+         CH_CFG_USE_THREADS_BITMAPS == TRUE ? "on" : "off",
+         (unsigned)((total / ITERATIONS) - overhead),
+         (unsigned)(best - overhead));
+
+  exit(0);
+}
@@ -0,0 +1,92 @@
+#!/bin/bash
+export XDEFS
+
+XDEFS=""
+
+function clean() {
+  echo -n "  * Cleaning..."
+  make clean > /dev/null
+  echo "OK"
+}
+
+function compile() {
+  echo -n "  * Building..."
+  if ! make > buildlog.txt
+  then
+    echo "failed"
+    clean
+    exit
+  fi
+  mv -f buildlog.txt ./reports/${1}_build.txt
+  echo "OK"
+}
+
+function misra() {
+  echo -n "  * Analysing..."
+  if ! make misra > misralog.txt 2> misraerrlog.txt
+  then
+    echo "failed"
+    clean
+    exit
+  fi
+  echo "OK"
+}
+
+function test() {
+  if [ -z "$2" ]
+  then
+    msg=$1": Default Settings"
+    XDEFS=
+  else
+    msg=$1": "$2
+    XDEFS=$2
+  fi
+  echo $msg
+  compile $1
+  misra
+  clean
+}
+
+function latency() {
+  if [ -z "$2" ]
+  then
+    XDEFS=
+  else
+    XDEFS=$2
+  fi
+  echo -n "  * ISR to thread "$1"..."
+  if ! make -C ../testbuild-sim > ../testbuild-sim/buildlog.txt
+  then
+    echo "failed"
+    make -C ../testbuild-sim clean > /dev/null
+    exit
+  fi
+  if ! ../testbuild-sim/build/ch > ./reports/${1}_latency.txt
+  then
+    echo "failed"
+    make -C ../testbuild-sim clean > /dev/null
+    exit
+  fi
+  make -C ../testbuild-sim clean > /dev/null
+  echo "OK"
+  cat ./reports/${1}_latency.txt
+}
+
+mkdir reports 2> /dev/null
+
+test cfg1 ""
+test cfg2 "-DCH_CFG_USE_THREADS_BITMAPS=TRUE"
+test cfg3 "-DCH_CFG_USE_THREADS_BITMAPS=TRUE -DCH_CFG_MAX_THREADS=32"
+test cfg4 "-DCH_CFG_FACTORY_HASH_SIZE=8"
+test cfg5 "-DCH_CFG_USE_THREADS_BITMAPS=TRUE -DCH_CFG_MAX_THREADS=16"
+
+echo "Latency"
+latency lat1 ""
+latency lat2 "-DCH_CFG_MAX_THREADS=16"
+latency lat3 "-DCH_CFG_USE_THREADS_BITMAPS=TRUE"
+latency lat4 "-DCH_CFG_USE_THREADS_BITMAPS=TRUE -DCH_CFG_MAX_THREADS=16"
+latency lat5 "-DCH_CFG_USE_THREADS_BITMAPS=TRUE -DCH_CFG_MAX_THREADS=32"
+
+rm *log.txt ../testbuild-sim/*log.txt 2> /dev/null
+echo
+echo "Done"
@@ -37,6 +37,7 @@
  *
  * <h2>Test Cases</h2>
  * - @subpage oslib_test_005_001
+ * - @subpage oslib_test_005_002
  * .
  */
 
@@ -110,6 +111,25 @@ static THD_FUNCTION(Thread1, arg) {
   chThdExit(0x0FA5);
 }
 
+static delegate_queue_t dq;
+static delegate_frame_t dq_frames[4];
+static unsigned dq_batches;
+static size_t dq_last;
+
+static THD_WORKING_AREA(waThread2, 256);
+static THD_FUNCTION(Thread2, arg) {
+
+  (void)arg;
+
+  exit_flag = false;
+  do {
+    dq_last = chDelegateDispatchQueueTimeout(&dq, 8U, TIME_INFINITE);
+    dq_batches++;
+  } while (!exit_flag);
+
+  chThdExit(0x0FA5);
+}
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -190,6 +210,130 @@ static const testcase_t oslib_test_005_001 = {
   oslib_test_005_001_execute
 };
 
+/**
+ * @page oslib_test_005_002 [5.2] Queued dispatcher test
+ *
+ * <h2>Description</h2>
+ * The asynchronous delegate queue API is tested for functionality, calls
+ * posted while the dispatcher is not running must be executed in a
+ * single batch.
+ *
+ * <h2>Test Steps</h2>
+ * - [5.2.1] Starting the dispatcher thread.
+ * - [5.2.2] Posting calls from within a critical zone until the queue is
+ *   full, the calls must be executed in a single batch after
+ *   rescheduling.
+ * - [5.2.3] Posting calls using the direct API, each call is executed on
+ *   posting.
+ * - [5.2.4] Waiting for the thread to terminate.
+ * .
+ */
+
+static void oslib_test_005_002_setup(void) {
+  chDelegateQueueObjectInit(&dq, dq_frames, 4U);
+  dq_batches = 0U;
+  dq_last    = 0U;
+}
+
+static void oslib_test_005_002_execute(void) {
+  thread_t *tp;
+
+  /* [5.2.1] Starting the dispatcher thread.*/
+  test_set_step(1);
+  {
+    thread_descriptor_t td = {
+      .name  = "dispatcher",
+      .wbase = waThread2,
+      .wend  = THD_WORKING_AREA_END(waThread2),
+      .prio  = chThdGetPriorityX() + 1,
+      .funcp = Thread2,
+      .arg   = NULL
+    };
+    tp = chThdCreate(&td);
+  }
+  test_end_step(1);
+
+  /* [5.2.2] Posting calls from within a critical zone until the queue is
+     full, the calls must be executed in a single batch after
+     rescheduling.*/
+  test_set_step(2);
+  {
+    delegate_frame_t df;
+    unsigned n = 0U;
+    msg_t msg;
+
+    chSysLock();
+    df.func.fn0 = (delegate_fn0_t)dis_func0;
+    df.argc     = 0U;
+    if (chDelegatePostI(&dq, &df) == MSG_OK) {
+      n++;
+    }
+    df.func.fn1 = dis_func1;
+    df.argc     = 1U;
+    df.args[0]  = 'A';
+    if (chDelegatePostI(&dq, &df) == MSG_OK) {
+      n++;
+    }
+    df.func.fn2 = dis_func2;
+    df.argc     = 2U;
+    df.args[0]  = 'B';
+    df.args[1]  = 'C';
+    if (chDelegatePostI(&dq, &df) == MSG_OK) {
+      n++;
+    }
+    df.func.fn3 = dis_func3;
+    df.argc     = 3U;
+    df.args[0]  = 'D';
+    df.args[1]  = 'E';
+    df.args[2]  = 'F';
+    if (chDelegatePostI(&dq, &df) == MSG_OK) {
+      n++;
+    }
+    msg = chDelegatePostI(&dq, &df);
+    chSchRescheduleS();
+    chSysUnlock();
+
+    test_assert(n == 4U, "post failed");
+    test_assert(msg == MSG_TIMEOUT, "queue not full");
+    test_assert(dq_batches == 1U, "not a single batch");
+    test_assert(dq_last == 4U, "wrong batch size");
+    test_assert_sequence("0ABCDEF", "unexpected tokens");
+  }
+  test_end_step(2);
+
+  /* [5.2.3] Posting calls using the direct API, each call is executed on
+     posting.*/
+  test_set_step(3);
+  {
+    msg_t msg;
+
+    msg = chDelegatePostDirect4(&dq, dis_func4, 'G', 'H', 'I', 'J');
+    test_assert(msg == MSG_OK, "post failed");
+    test_assert(dq_batches == 2U, "call not executed");
+
+    msg = chDelegatePostDirect0(&dq, (delegate_fn0_t)dis_func_end);
+    test_assert(msg == MSG_OK, "post failed");
+
+    test_assert_sequence("GHIJZ", "unexpected tokens");
+  }
+  test_end_step(3);
+
+  /* [5.2.4] Waiting for the thread to terminate.*/
+  test_set_step(4);
+  {
+    msg_t msg = chThdWait(tp);
+    test_assert(msg == 0x0FA5, "invalid exit code");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t oslib_test_005_002 = {
+  "Queued dispatcher test",
+  oslib_test_005_002_setup,
+  NULL,
+  oslib_test_005_002_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -199,6 +343,7 @@ static const testcase_t oslib_test_005_001 = {
  */
 const testcase_t * const oslib_test_sequence_005_array[] = {
   &oslib_test_005_001,
+  &oslib_test_005_002,
   NULL
 };
 
@@ -42,6 +42,7 @@
  * - @subpage oslib_test_009_004
  * - @subpage oslib_test_009_005
  * - @subpage oslib_test_009_006
+ * - @subpage oslib_test_009_007
  * .
  */
 
@@ -51,6 +52,17 @@
  * Shared code.
  ****************************************************************************/
 
+#if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
+#define REGISTRY_OBJECTS_NUM    17U
+
+static const char * const registry_names[REGISTRY_OBJECTS_NUM] = {
+  "obj0",  "obj1",  "obj2",  "obj3",  "obj4",  "obj5",  "obj6",  "obj7",
+  "obj8",  "obj9",  "obj10", "obj11", "obj12", "obj13", "obj14", "obj15",
+  "obj16"
+};
+
+static uint32_t registry_objects[REGISTRY_OBJECTS_NUM];
+#endif
 
 /****************************************************************************
  * Test cases.
@@ -76,9 +88,11 @@
  * - [9.1.4] Retrieving the registered object by name, must exist, then
  *   increasing the reference counter, finally releasing both
  *   references.
- * - [9.1.5] Releasing the first reference to the object, must not
+ * - [9.1.5] Retrieving the registered object by pointer, must exist,
+ *   then releasing the reference.
+ * - [9.1.6] Releasing the first reference to the object, must not
  *   trigger an assertion.
- * - [9.1.6] Retrieving the registered object by name again, must not
+ * - [9.1.7] Retrieving the registered object by name again, must not
  *   exist.
  * .
  */
@@ -152,22 +166,37 @@ static void oslib_test_009_001_execute(void) {
   }
   test_end_step(4);
 
-  /* [9.1.5] Releasing the first reference to the object, must not
-     trigger an assertion.*/
+  /* [9.1.5] Retrieving the registered object by pointer, must exist,
+     then releasing the reference.*/
   test_set_step(5);
   {
-    chFactoryReleaseObject(rop);
+    registered_object_t *rop1;
+
+    rop1 = chFactoryFindObjectByPointer(rop->objp);
+    test_assert(rop1 == rop, "object reference mismatch");
+    test_assert(rop->element.refs == 2, "object reference mismatch");
+
+    chFactoryReleaseObject(rop1);
+    test_assert(rop->element.refs == 1, "references mismatch");
   }
   test_end_step(5);
 
-  /* [9.1.6] Retrieving the registered object by name again, must not
-     exist.*/
+  /* [9.1.6] Releasing the first reference to the object, must not
+     trigger an assertion.*/
   test_set_step(6);
+  {
+    chFactoryReleaseObject(rop);
+  }
+  test_end_step(6);
+
+  /* [9.1.7] Retrieving the registered object by name again, must not
+     exist.*/
+  test_set_step(7);
   {
     rop = chFactoryFindObject("myobj");
     test_assert(rop == NULL, "found");
   }
-  test_end_step(6);
+  test_end_step(7);
 }
 
 static const testcase_t oslib_test_009_001 = {
@@ -777,6 +806,133 @@ static const testcase_t oslib_test_009_006 = {
 };
 #endif /* CH_CFG_FACTORY_PIPES == TRUE */
 
+#if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_009_007 [9.7] Objects Registry Index
+ *
+ * <h2>Description</h2>
+ * This test case verifies the objects registry lookups with more
+ * objects than the hash buckets, the lookups by name and by pointer
+ * must be correct in presence of collisions and after removals.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [9.7.1] More objects than the hash buckets are registered, each one
+ *   must be found by name and by pointer, colliding entries must not be
+ *   confused.
+ * - [9.7.2] Every other object is released, the released objects must
+ *   not be found anymore, the remaining objects must still be found.
+ * - [9.7.3] A released name is registered again then all the objects
+ *   are released, none must be found.
+ * .
+ */
+
+static void oslib_test_009_007_teardown(void) {
+  unsigned i;
+
+  for (i = 0U; i < REGISTRY_OBJECTS_NUM; i++) {
+    registered_object_t *rop = chFactoryFindObject(registry_names[i]);
+    if (rop != NULL) {
+      while (rop->element.refs > 0U) {
+        chFactoryReleaseObject(rop);
+      }
+    }
+  }
+}
+
+static void oslib_test_009_007_execute(void) {
+  registered_object_t *rop;
+  unsigned i;
+
+  /* [9.7.1] More objects than the hash buckets are registered, each one
+     must be found by name and by pointer, colliding entries must not be
+     confused.*/
+  test_set_step(1);
+  {
+    for (i = 0U; i < REGISTRY_OBJECTS_NUM; i++) {
+      rop = chFactoryRegisterObject(registry_names[i],
+                                    (void *)&registry_objects[i]);
+      test_assert(rop != NULL, "cannot register");
+    }
+    for (i = 0U; i < REGISTRY_OBJECTS_NUM; i++) {
+      rop = chFactoryFindObject(registry_names[i]);
+      test_assert(rop != NULL, "not found");
+      test_assert(rop->objp == (void *)&registry_objects[i],
+                  "object mismatch");
+      test_assert(chFactoryFindObjectByPointer(rop->objp) == rop,
+                  "object reference mismatch");
+      test_assert(rop->element.refs == 3, "references mismatch");
+      chFactoryReleaseObject(rop);
+      chFactoryReleaseObject(rop);
+    }
+  }
+  test_end_step(1);
+
+  /* [9.7.2] Every other object is released, the released objects must not
+     be found anymore, the remaining objects must still be found.*/
+  test_set_step(2);
+  {
+    for (i = 0U; i < REGISTRY_OBJECTS_NUM; i += 2U) {
+      rop = chFactoryFindObject(registry_names[i]);
+      chFactoryReleaseObject(rop);
+      chFactoryReleaseObject(rop);
+    }
+    for (i = 0U; i < REGISTRY_OBJECTS_NUM; i++) {
+      rop = chFactoryFindObject(registry_names[i]);
+      if ((i & 1U) == 0U) {
+        test_assert(rop == NULL, "found");
+        test_assert(chFactoryFindObjectByPointer(&registry_objects[i]) == NULL,
+                    "found by pointer");
+      }
+      else {
+        test_assert(rop != NULL, "not found");
+        test_assert(rop->objp == (void *)&registry_objects[i],
+                    "object mismatch");
+        chFactoryReleaseObject(rop);
+      }
+    }
+  }
+  test_end_step(2);
+
+  /* [9.7.3] A released name is registered again then all the objects are
+     released, none must be found.*/
+  test_set_step(3);
+  {
+    rop = chFactoryRegisterObject(registry_names[0],
+                                  (void *)&registry_objects[0]);
+    test_assert(rop != NULL, "cannot register");
+    test_assert(chFactoryFindObjectByPointer(&registry_objects[0]) == rop,
+                "object reference mismatch");
+    chFactoryReleaseObject(rop);
+    for (i = 0U; i < REGISTRY_OBJECTS_NUM; i++) {
+      rop = chFactoryFindObject(registry_names[i]);
+      if (rop != NULL) {
+        chFactoryReleaseObject(rop);
+        chFactoryReleaseObject(rop);
+      }
+    }
+    for (i = 0U; i < REGISTRY_OBJECTS_NUM; i++) {
+      test_assert(chFactoryFindObject(registry_names[i]) == NULL, "found");
+      test_assert(chFactoryFindObjectByPointer(&registry_objects[i]) == NULL,
+                  "found by pointer");
+    }
+  }
+  test_end_step(3);
+}
+
+static const testcase_t oslib_test_009_007 = {
+  "Objects Registry Index",
+  NULL,
+  oslib_test_009_007_teardown,
+  oslib_test_009_007_execute
+};
+#endif /* CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -802,6 +958,9 @@ const testcase_t * const oslib_test_sequence_009_array[] = {
 #endif
 #if (CH_CFG_FACTORY_PIPES == TRUE) || defined(__DOXYGEN__)
   &oslib_test_009_006,
+#endif
+#if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
+  &oslib_test_009_007,
 #endif
   NULL
 };
@@ -34,6 +34,7 @@
  * - @subpage rt_test_005_002
  * - @subpage rt_test_005_003
  * - @subpage rt_test_005_004
+ * - @subpage rt_test_005_005
  * .
  */
 
@@ -46,6 +47,18 @@ static THD_FUNCTION(thread, p) {
   test_emit_token(*(char *)p);
 }
 
+#if CH_DBG_STACK_PROFILING == TRUE
+static THD_FUNCTION(thread_stk, p) {
+  volatile uint8_t buf[THREADS_STACK_SIZE / 2];
+  unsigned i;
+
+  (void)p;
+  for (i = 0; i < sizeof (buf); i++) {
+    buf[i] = (uint8_t)i;
+  }
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -339,6 +352,68 @@ static const testcase_t rt_test_005_004 = {
 };
 #endif /* CH_CFG_USE_MUTEXES == TRUE */
 
+#if (CH_DBG_STACK_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_005_005 [5.5] Stack high-water estimate
+ *
+ * <h2>Description</h2>
+ * Threads are created and the stack high-water estimate is read after
+ * their termination. The estimate is an upper bound of the actual stack
+ * usage.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_DBG_STACK_PROFILING == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.5.1] A thread is created and terminated, the estimate is checked
+ *   to be lower than the stack size.
+ * - [5.5.2] A thread using a local buffer is created and terminated, the
+ *   estimate is checked to be not lower than the buffer size.
+ * .
+ */
+
+static void rt_test_005_005_execute(void) {
+  thread_t *tp;
+  size_t stksize;
+
+  /* [5.5.1] A thread is created and terminated, the estimate is checked
+     to be lower than the stack size.*/
+  test_set_step(1);
+  {
+    tp = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX() + 1,
+                           thread, "A");
+    (void) chThdWait(tp);
+    stksize = (size_t)((uint8_t *)tp - (uint8_t *)chThdGetWorkingAreaX(tp));
+    test_assert(chThdGetStackHighWaterX(tp) < stksize, "stack overflow");
+    test_assert_sequence("A", "invalid sequence");
+  }
+  test_end_step(1);
+
+  /* [5.5.2] A thread using a local buffer is created and terminated, the
+     estimate is checked to be not lower than the buffer size.*/
+  test_set_step(2);
+  {
+    tp = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX() + 1,
+                           thread_stk, NULL);
+    (void) chThdWait(tp);
+    test_assert(chThdGetStackHighWaterX(tp) >= THREADS_STACK_SIZE / 2,
+                "estimate too low");
+    test_assert(chThdGetStackHighWaterX(tp) < stksize, "stack overflow");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t rt_test_005_005 = {
+  "Stack high-water estimate",
+  NULL,
+  NULL,
+  rt_test_005_005_execute
+};
+#endif /* CH_DBG_STACK_PROFILING == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -352,6 +427,9 @@ const testcase_t * const rt_test_sequence_005_array[] = {
   &rt_test_005_003,
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   &rt_test_005_004,
+#endif
+#if (CH_DBG_STACK_PROFILING == TRUE) || defined(__DOXYGEN__)
+  &rt_test_005_005,
 #endif
   NULL
 };
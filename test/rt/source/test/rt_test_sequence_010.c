@@ -42,6 +42,7 @@
  * - @subpage rt_test_010_005
  * - @subpage rt_test_010_006
  * - @subpage rt_test_010_007
+ * - @subpage rt_test_010_008
  * .
  */
 
@@ -73,6 +74,17 @@ static THD_FUNCTION(evt_thread7, p) {
   chEvtBroadcast(&es2);
 }
 
+#if CH_CFG_USE_EVENTS_GROUPING == TRUE
+static THD_FUNCTION(evt_thread8, p) {
+  eventflags_t flags;
+
+  if ((chEvtWaitSourceTimeout(&es1, &flags, TIME_INFINITE) == MSG_OK) &&
+      (flags == (eventflags_t)0x55)) {
+    test_emit_token(*(char *)p);
+  }
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -573,6 +585,132 @@ static const testcase_t rt_test_010_007 = {
   rt_test_010_007_execute
 };
 
+#if (CH_CFG_USE_EVENTS_GROUPING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_010_008 [10.8] Listeners grouping and waiting on sources
+ *
+ * <h2>Description</h2>
+ * Listeners with different flags masks are registered on the same event
+ * source, broadcasts must only signal the interested listeners. Threads
+ * waiting directly on the event source are then tested.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_EVENTS_GROUPING == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [10.8.1] Registering three listeners on the same Event Source, the
+ *   first and the third listeners share the same flags mask.
+ * - [10.8.2] Broadcasting flag 1, only the first and the third
+ *   listeners must be signaled.
+ * - [10.8.3] Unregistering the first listener, then broadcasting flag
+ *   1, flag 2 and no flags, the remaining listeners must be signaled
+ *   accordingly.
+ * - [10.8.4] Unregistering the remaining listeners.
+ * - [10.8.5] Starting two threads waiting on the Event Source, then
+ *   broadcasting flags, both threads must receive the flags.
+ * - [10.8.6] Waiting on the Event Source with timeout, the timeout must
+ *   expire.
+ * .
+ */
+
+static void rt_test_010_008_setup(void) {
+  chEvtGetAndClearEvents(ALL_EVENTS);
+  chEvtObjectInit(&es1);
+}
+
+static void rt_test_010_008_execute(void) {
+  eventmask_t m;
+  event_listener_t el1, el2, el3;
+  eventflags_t flags;
+  msg_t msg;
+
+  /* [10.8.1] Registering three listeners on the same Event Source, the
+     first and the third listeners share the same flags mask.*/
+  test_set_step(1);
+  {
+    chEvtRegisterMaskWithFlags(&es1, &el1, 1, 1);
+    chEvtRegisterMaskWithFlags(&es1, &el2, 2, 2);
+    chEvtRegisterMaskWithFlags(&es1, &el3, 4, 1);
+  }
+  test_end_step(1);
+
+  /* [10.8.2] Broadcasting flag 1, only the first and the third
+     listeners must be signaled.*/
+  test_set_step(2);
+  {
+    chEvtBroadcastFlags(&es1, 1);
+    m = chEvtGetAndClearEvents(ALL_EVENTS);
+    test_assert(m == 5, "wrong events");
+    test_assert(chEvtGetAndClearFlags(&el1) == 1, "wrong flags");
+    test_assert(chEvtGetAndClearFlags(&el2) == 0, "wrong flags");
+    test_assert(chEvtGetAndClearFlags(&el3) == 1, "wrong flags");
+  }
+  test_end_step(2);
+
+  /* [10.8.3] Unregistering the first listener, then broadcasting flag
+     1, flag 2 and no flags, the remaining listeners must be signaled
+     accordingly.*/
+  test_set_step(3);
+  {
+    chEvtUnregister(&es1, &el1);
+    chEvtBroadcastFlags(&es1, 1);
+    m = chEvtGetAndClearEvents(ALL_EVENTS);
+    test_assert(m == 4, "wrong events");
+    chEvtBroadcastFlags(&es1, 2);
+    m = chEvtGetAndClearEvents(ALL_EVENTS);
+    test_assert(m == 2, "wrong events");
+    chEvtBroadcast(&es1);
+    m = chEvtGetAndClearEvents(ALL_EVENTS);
+    test_assert(m == 6, "wrong events");
+  }
+  test_end_step(3);
+
+  /* [10.8.4] Unregistering the remaining listeners.*/
+  test_set_step(4);
+  {
+    chEvtUnregister(&es1, &el3);
+    chEvtUnregister(&es1, &el2);
+    test_assert(!chEvtIsListeningI(&es1), "stuck listener");
+  }
+  test_end_step(4);
+
+  /* [10.8.5] Starting two threads waiting on the Event Source, then
+     broadcasting flags, both threads must receive the flags.*/
+  test_set_step(5);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX() + 1,
+                                   evt_thread8, "A");
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, chThdGetPriorityX() + 1,
+                                   evt_thread8, "B");
+    chEvtBroadcastFlags(&es1, 0x55);
+    test_wait_threads();
+    test_assert_sequence("AB", "invalid sequence");
+  }
+  test_end_step(5);
+
+  /* [10.8.6] Waiting on the Event Source with timeout, the timeout must
+     expire.*/
+  test_set_step(6);
+  {
+    msg = chEvtWaitSourceTimeout(&es1, &flags, TIME_IMMEDIATE);
+    test_assert(msg == MSG_TIMEOUT, "wrong wakeup message");
+    msg = chEvtWaitSourceTimeout(&es1, &flags, TIME_MS2I(10));
+    test_assert(msg == MSG_TIMEOUT, "wrong wakeup message");
+  }
+  test_end_step(6);
+}
+
+static const testcase_t rt_test_010_008 = {
+  "Listeners grouping and waiting on sources",
+  rt_test_010_008_setup,
+  NULL,
+  rt_test_010_008_execute
+};
+#endif /* CH_CFG_USE_EVENTS_GROUPING == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -590,6 +728,9 @@ const testcase_t * const rt_test_sequence_010_array[] = {
   &rt_test_010_006,
 #endif
   &rt_test_010_007,
+#if (CH_CFG_USE_EVENTS_GROUPING == TRUE) || defined(__DOXYGEN__)
+  &rt_test_010_008,
+#endif
   NULL
 };
 
@@ -46,6 +46,8 @@
  * - @subpage rt_test_012_010
  * - @subpage rt_test_012_011
  * - @subpage rt_test_012_012
+ * - @subpage rt_test_012_013
+ * - @subpage rt_test_012_014
  * .
  */
 
@@ -138,6 +140,106 @@ static THD_FUNCTION(bmk_thread8, p) {
   } while(!chThdShouldTerminateX());
 }
 
+#if ((CH_CFG_USE_CONDVARS == TRUE) && (CH_CFG_USE_DYNAMIC == TRUE) &&     \
+     (CH_CFG_USE_HEAP == TRUE)) || defined(__DOXYGEN__)
+#define BMK_CONDVAR_MAX_WAITERS     32
+
+static condition_variable_t cnd1;
+static thread_t *bmk_cond_threads[BMK_CONDVAR_MAX_WAITERS];
+
+static THD_FUNCTION(bmk_thread9, p) {
+
+  (void)p;
+  chMtxLock(&mtx1);
+  while (!chThdShouldTerminateX())
+    chCondWait(&cnd1);
+  chMtxUnlock(&mtx1);
+}
+
+NOINLINE static uint32_t cond_broadcast_test(unsigned nwaiters,
+                                             ucnt_t *ctxswcp) {
+  systime_t start, end;
+  unsigned i, nthd;
+  uint32_t n;
+
+  /* The waiters have higher priority than the tester so all of them are
+     back on the condition variable before the next broadcast.*/
+  for (nthd = 0; nthd < nwaiters; nthd++) {
+    bmk_cond_threads[nthd] = chThdCreateFromHeap(NULL, WA_SIZE, "cndwaiter",
+                                                 chThdGetPriorityX() + 1,
+                                                 bmk_thread9, NULL);
+    if (bmk_cond_threads[nthd] == NULL) {
+      break;
+    }
+  }
+
+  n = 0;
+  if (nthd == nwaiters) {
+    start = test_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+#if CH_DBG_STATISTICS == TRUE
+    *ctxswcp = currcore->kernel_stats.n_ctxswc;
+#endif
+    do {
+      chMtxLock(&mtx1);
+      chCondBroadcast(&cnd1);
+      chMtxUnlock(&mtx1);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+#if CH_DBG_STATISTICS == TRUE
+    *ctxswcp = currcore->kernel_stats.n_ctxswc - *ctxswcp;
+#endif
+  }
+  (void)ctxswcp;
+
+  for (i = 0; i < nthd; i++) {
+    chThdTerminate(bmk_cond_threads[i]);
+  }
+  chMtxLock(&mtx1);
+  chCondBroadcast(&cnd1);
+  chMtxUnlock(&mtx1);
+  for (i = 0; i < nthd; i++) {
+    (void)chThdWait(bmk_cond_threads[i]);
+  }
+
+  return n;
+}
+
+static void cond_broadcast_print(unsigned nwaiters, uint32_t n,
+                                 ucnt_t ctxswc) {
+
+  if (n == 0U) {
+    test_println("--- Score : skipped, not enough heap for the waiters");
+    return;
+  }
+  test_print("--- Score : ");
+  test_printn(n);
+  test_print(" broadcasts/S, ");
+  test_printn(nwaiters);
+  test_print(" waiters");
+#if CH_DBG_STATISTICS == TRUE
+  test_print(", ");
+  test_printn(ctxswc / n);
+  test_print(" ctxswc/broadcast");
+#endif
+  (void)ctxswc;
+  test_println("");
+}
+#endif
+
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+static thread_pool_t pool1;
+static thread_pool_work_t work1;
+
+static void bmk_work1(void *arg) {
+
+  (*(uint32_t *)arg)++;
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -916,28 +1018,218 @@ static const testcase_t rt_test_012_011 = {
 };
 #endif /* CH_CFG_USE_MUTEXES ==TRUE */
 
+#if ((CH_CFG_USE_CONDVARS == TRUE) && (CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_HEAP == TRUE)) || defined(__DOXYGEN__)
 /**
- * @page rt_test_012_012 [12.12] RAM Footprint
+ * @page rt_test_012_012 [12.12] Condition Variables broadcast performance
  *
  * <h2>Description</h2>
- * The memory size of the various kernel objects is printed.
+ * A set of threads wait on a condition variable protected by a mutex,
+ * the tester thread locks the mutex, broadcasts the condition variable
+ * and unlocks the mutex into a continuous loop. All waiters have to
+ * reacquire the mutex before going back on the condition variable, the
+ * score is the number of broadcasts in a second and, when statistics
+ * are enabled, the number of context switches per broadcast. The test
+ * is repeated with 8 and 32 waiters.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (CH_CFG_USE_CONDVARS == TRUE) && (CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_HEAP == TRUE)
+ * .
  *
  * <h2>Test Steps</h2>
- * - [12.12.1] The size of the system area is printed.
- * - [12.12.2] The size of a thread structure is printed.
- * - [12.12.3] The size of a virtual timer structure is printed.
- * - [12.12.4] The size of a semaphore structure is printed.
- * - [12.12.5] The size of a mutex is printed.
- * - [12.12.6] The size of a condition variable is printed.
- * - [12.12.7] The size of an event source is printed.
- * - [12.12.8] The size of an event listener is printed.
- * - [12.12.9] The size of a mailbox is printed.
+ * - [12.12.1] Broadcasts are performed with 8 waiters in a one-second
+ *   time window.
+ * - [12.12.2] The score is printed.
+ * - [12.12.3] Broadcasts are performed with 32 waiters in a one-second
+ *   time window.
+ * - [12.12.4] The score is printed.
  * .
  */
 
+static void rt_test_012_012_setup(void) {
+  chMtxObjectInit(&mtx1);
+  chCondObjectInit(&cnd1);
+}
+
 static void rt_test_012_012_execute(void) {
+  uint32_t n;
+  ucnt_t ctxswc = (ucnt_t)0;
 
-  /* [12.12.1] The size of the system area is printed.*/
+  /* [12.12.1] Broadcasts are performed with 8 waiters in a one-second
+     time window.*/
+  test_set_step(1);
+  {
+    n = cond_broadcast_test(8U, &ctxswc);
+  }
+  test_end_step(1);
+
+  /* [12.12.2] The score is printed.*/
+  test_set_step(2);
+  {
+    cond_broadcast_print(8U, n, ctxswc);
+  }
+  test_end_step(2);
+
+  /* [12.12.3] Broadcasts are performed with 32 waiters in a one-second
+     time window.*/
+  test_set_step(3);
+  {
+    n = cond_broadcast_test(BMK_CONDVAR_MAX_WAITERS, &ctxswc);
+  }
+  test_end_step(3);
+
+  /* [12.12.4] The score is printed.*/
+  test_set_step(4);
+  {
+    cond_broadcast_print(BMK_CONDVAR_MAX_WAITERS, n, ctxswc);
+  }
+  test_end_step(4);
+}
+
+static const testcase_t rt_test_012_012 = {
+  "Condition Variables broadcast performance",
+  rt_test_012_012_setup,
+  NULL,
+  rt_test_012_012_execute
+};
+#endif /* (CH_CFG_USE_CONDVARS == TRUE) && (CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_HEAP == TRUE) */
+
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_012_013 [12.13] Threads pool performance
+ *
+ * <h2>Description</h2>
+ * A thread is created from the heap and waited for into a continuous
+ * loop, then the same is done by dispatching a work to a threads pool
+ * with a parked worker. In both cases the spawned code has higher
+ * priority than the tester thread so it runs immediately, the score is
+ * the number of spawn and run cycles in a one-second time window.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_THREAD_POOLS == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [12.13.1] A thread is created from the heap and waited for, the
+ *   operation is repeated continuously in a one-second time window.
+ * - [12.13.2] A worker is created in the pool.
+ * - [12.13.3] A work is dispatched to the pool, the operation is
+ *   repeated continuously in a one-second time window. All the works
+ *   must have been executed.
+ * - [12.13.4] The score is printed.
+ * .
+ */
+
+static void rt_test_012_013_setup(void) {
+  chThdPoolObjectInit(&pool1, NULL, WA_SIZE, "pool",
+                      chThdGetPriorityX() + 1, 1);
+}
+
+static void rt_test_012_013_teardown(void) {
+  chThdPoolDispose(&pool1);
+}
+
+static void rt_test_012_013_execute(void) {
+  uint32_t nheap, npool, nworks;
+
+  /* [12.13.1] A thread is created from the heap and waited for, the
+     operation is repeated continuously in a one-second time window.*/
+  test_set_step(1);
+  {
+    systime_t start, end;
+    thread_t *tp;
+
+    nheap = 0;
+    start = test_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      tp = chThdCreateFromHeap(NULL, WA_SIZE, "heap",
+                               chThdGetPriorityX() + 1,
+                               bmk_thread3, NULL);
+      test_assert(tp != NULL, "heap allocation failed");
+      (void) chThdWait(tp);
+      nheap++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+  test_end_step(1);
+
+  /* [12.13.2] A worker is created in the pool.*/
+  test_set_step(2);
+  {
+    test_assert(chThdPoolPreload(&pool1, 1) == 1, "worker not created");
+  }
+  test_end_step(2);
+
+  /* [12.13.3] A work is dispatched to the pool, the operation is
+     repeated continuously in a one-second time window. All the works
+     must have been executed.*/
+  test_set_step(3);
+  {
+    systime_t start, end;
+
+    npool = 0;
+    nworks = 0;
+    start = test_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      (void) chThdPoolDispatch(&pool1, &work1, bmk_work1, (void *)&nworks);
+      npool++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+    test_assert(nworks == npool, "works not executed");
+  }
+  test_end_step(3);
+
+  /* [12.13.4] The score is printed.*/
+  test_set_step(4);
+  {
+    test_print("--- Score : ");
+    test_printn(nheap);
+    test_print(" heap threads/S, ");
+    test_printn(npool);
+    test_println(" pool works/S");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t rt_test_012_013 = {
+  "Threads pool performance",
+  rt_test_012_013_setup,
+  rt_test_012_013_teardown,
+  rt_test_012_013_execute
+};
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
+/**
+ * @page rt_test_012_014 [12.14] RAM Footprint
+ *
+ * <h2>Description</h2>
+ * The memory size of the various kernel objects is printed.
+ *
+ * <h2>Test Steps</h2>
+ * - [12.14.1] The size of the system area is printed.
+ * - [12.14.2] The size of a thread structure is printed.
+ * - [12.14.3] The size of a virtual timer structure is printed.
+ * - [12.14.4] The size of a semaphore structure is printed.
+ * - [12.14.5] The size of a mutex is printed.
+ * - [12.14.6] The size of a condition variable is printed.
+ * - [12.14.7] The size of an event source is printed.
+ * - [12.14.8] The size of an event listener is printed.
+ * - [12.14.9] The size of a mailbox is printed.
+ * .
+ */
+
+static void rt_test_012_014_execute(void) {
+
+  /* [12.14.1] The size of the system area is printed.*/
   test_set_step(1);
   {
     test_print("--- OS    : ");
@@ -946,7 +1238,7 @@ static void rt_test_012_012_execute(void) {
   }
   test_end_step(1);
 
-  /* [12.12.2] The size of a thread structure is printed.*/
+  /* [12.14.2] The size of a thread structure is printed.*/
   test_set_step(2);
   {
     test_print("--- Thread: ");
@@ -955,7 +1247,7 @@ static void rt_test_012_012_execute(void) {
   }
   test_end_step(2);
 
-  /* [12.12.3] The size of a virtual timer structure is printed.*/
+  /* [12.14.3] The size of a virtual timer structure is printed.*/
   test_set_step(3);
   {
     test_print("--- Timer : ");
@@ -964,7 +1256,7 @@ static void rt_test_012_012_execute(void) {
   }
   test_end_step(3);
 
-  /* [12.12.4] The size of a semaphore structure is printed.*/
+  /* [12.14.4] The size of a semaphore structure is printed.*/
   test_set_step(4);
   {
 #if CH_CFG_USE_SEMAPHORES || defined(__DOXYGEN__)
@@ -975,7 +1267,7 @@ static void rt_test_012_012_execute(void) {
   }
   test_end_step(4);
 
-  /* [12.12.5] The size of a mutex is printed.*/
+  /* [12.14.5] The size of a mutex is printed.*/
   test_set_step(5);
   {
 #if CH_CFG_USE_MUTEXES || defined(__DOXYGEN__)
@@ -986,7 +1278,7 @@ static void rt_test_012_012_execute(void) {
   }
   test_end_step(5);
 
-  /* [12.12.6] The size of a condition variable is printed.*/
+  /* [12.14.6] The size of a condition variable is printed.*/
   test_set_step(6);
   {
 #if CH_CFG_USE_CONDVARS || defined(__DOXYGEN__)
@@ -997,7 +1289,7 @@ static void rt_test_012_012_execute(void) {
   }
   test_end_step(6);
 
-  /* [12.12.7] The size of an event source is printed.*/
+  /* [12.14.7] The size of an event source is printed.*/
   test_set_step(7);
   {
 #if CH_CFG_USE_EVENTS || defined(__DOXYGEN__)
@@ -1008,7 +1300,7 @@ static void rt_test_012_012_execute(void) {
   }
   test_end_step(7);
 
-  /* [12.12.8] The size of an event listener is printed.*/
+  /* [12.14.8] The size of an event listener is printed.*/
   test_set_step(8);
   {
 #if CH_CFG_USE_EVENTS || defined(__DOXYGEN__)
@@ -1019,7 +1311,7 @@ static void rt_test_012_012_execute(void) {
   }
   test_end_step(8);
 
-  /* [12.12.9] The size of a mailbox is printed.*/
+  /* [12.14.9] The size of a mailbox is printed.*/
   test_set_step(9);
   {
 #if CH_CFG_USE_MAILBOXES || defined(__DOXYGEN__)
@@ -1031,11 +1323,11 @@ static void rt_test_012_012_execute(void) {
   test_end_step(9);
 }
 
-static const testcase_t rt_test_012_012 = {
+static const testcase_t rt_test_012_014 = {
   "RAM Footprint",
   NULL,
   NULL,
-  rt_test_012_012_execute
+  rt_test_012_014_execute
 };
 
 /****************************************************************************
@@ -1069,7 +1361,13 @@ const testcase_t * const rt_test_sequence_012_array[] = {
 #if (CH_CFG_USE_MUTEXES ==TRUE) || defined(__DOXYGEN__)
   &rt_test_012_011,
 #endif
+#if ((CH_CFG_USE_CONDVARS == TRUE) && (CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_HEAP == TRUE)) || defined(__DOXYGEN__)
   &rt_test_012_012,
+#endif
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+  &rt_test_012_013,
+#endif
+  &rt_test_012_014,
   NULL
 };
 
@@ -297,6 +297,21 @@
 #define CH_CFG_USE_CONDVARS_TIMEOUT         TRUE
 #endif
 
+/**
+ * @brief   Conditional Variables wait-morphing.
+ * @details If enabled then the threads signaled on a condition variable
+ *          are moved directly on the mutex queue instead of being awakened
+ *          and then contend for the mutex.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_CONDVARS.
+ * @note    All the threads waiting on a condition variable must use the
+ *          same mutex.
+ */
+#if !defined(CH_CFG_USE_CONDVARS_MORPHING)
+#define CH_CFG_USE_CONDVARS_MORPHING        TRUE
+#endif
+
 /**
  * @brief   Events Flags APIs.
  * @details If enabled then the event flags APIs are included in the kernel.
@@ -319,6 +334,20 @@
 #define CH_CFG_USE_EVENTS_TIMEOUT           TRUE
 #endif
 
+/**
+ * @brief   Events listeners grouping and source wait queues.
+ * @details If enabled then the listeners registered on an event source are
+ *          grouped by flags mask and broadcasts skip the groups not
+ *          interested in the broadcasted flags. Threads can also wait
+ *          directly on an event source.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_EVENTS.
+ */
+#if !defined(CH_CFG_USE_EVENTS_GROUPING)
+#define CH_CFG_USE_EVENTS_GROUPING          TRUE
+#endif
+
 /**
  * @brief   Synchronous Messages APIs.
  * @details If enabled then the synchronous messages APIs are included
@@ -356,6 +385,18 @@
 #define CH_CFG_USE_DYNAMIC                  TRUE
 #endif
 
+/**
+ * @brief   Threads pools APIs.
+ * @details If enabled then the threads pools APIs are included in the
+ *          kernel.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_DYNAMIC and @p CH_CFG_USE_HEAP.
+ */
+#if !defined(CH_CFG_USE_THREAD_POOLS)
+#define CH_CFG_USE_THREAD_POOLS             TRUE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -564,6 +605,16 @@
 #define CH_CFG_FACTORY_PIPES                TRUE
 #endif
 
+/**
+ * @brief   Size of the objects hash tables.
+ * @details If non-zero then the factory lists are indexed by name and
+ *          registered objects by pointer, lookups become O(1) on average.
+ * @note    Must be zero or a power of two.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_FACTORY_HASH_SIZE            0
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -661,6 +712,19 @@
 #define CH_DBG_FILL_THREADS                 FALSE
 #endif
 
+/**
+ * @brief   Debug option, stacks profiling.
+ * @details If enabled then guard words are placed into the threads stacks
+ *          at exponentially spaced offsets when a thread is created, the
+ *          stack high-water mark can be estimated from the guards without
+ *          filling the whole stack.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_DBG_STACK_PROFILING)
+#define CH_DBG_STACK_PROFILING              TRUE
+#endif
+
 /**
  * @brief   Debug option, threads profiling.
  * @details If enabled then a field is added to the @p thread_t structure that
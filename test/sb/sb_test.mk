@@ -0,0 +1,7 @@
+# List of all the ChibiOS/SB test files.
+TESTSRC += ${CHIBIOS}/test/sb/source/test/sb_test_root.c \
+           ${CHIBIOS}/test/sb/source/test/sb_test_sequence_001.c
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/sb/source/test \
+           ${CHIBIOS}/os/sb/common
@@ -0,0 +1,530 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "sb_test_root.h"
+
+/**
+ * @file    sb_test_sequence_001.c
+ * @brief   Test Sequence 001 code.
+ *
+ * @page sb_test_sequence_001 [1] Sandbox shared rings
+ *
+ * File: @ref sb_test_sequence_001.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the shared ring buffers used for exchanging data
+ * streams between the host and a sandbox. The empty/full transitions
+ * and the waiting flags, transfers wrapping around the buffer end, the
+ * free running indexes overflowing 32 bits, the detection of corrupted
+ * indexes and a producer and a consumer thread exchanging a data stream
+ * are checked.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage sb_test_001_001
+ * - @subpage sb_test_001_002
+ * - @subpage sb_test_001_003
+ * - @subpage sb_test_001_004
+ * - @subpage sb_test_001_005
+ * - @subpage sb_test_001_006
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+#include "sbring.h"
+
+#define RING_SIZE           64U
+#define STREAM_SIZE         200000U
+
+static SB_RING_DECL(ring_area, RING_SIZE);
+static sb_ring_port_t prodport, consport;
+static uint8_t src[RING_SIZE * 2U], dst[RING_SIZE * 2U];
+
+/* Doorbells, in the sandbox they are events or virtual IRQs.*/
+static binary_semaphore_t data_bell, space_bell;
+
+static THD_WORKING_AREA(waProducer, 1024);
+
+static sb_ring_t *ring(void) {
+
+  return (sb_ring_t *)(void *)ring_area;
+}
+
+static void ring_setup(void) {
+  unsigned i;
+
+  sbRingObjectInit(ring());
+  sbRingPortInit(&prodport, ring(), RING_SIZE);
+  sbRingPortInit(&consport, ring(), RING_SIZE);
+  for (i = 0U; i < sizeof src; i++) {
+    src[i] = (uint8_t)(i * 7U + 1U);
+  }
+}
+
+/*
+ * Sets both indexes to the same value, the ring is empty.
+ */
+static void ring_set_indexes(uint32_t index) {
+
+  ring()->wrptr = index;
+  ring()->rdptr = index;
+}
+
+static THD_FUNCTION(Producer, arg) {
+  uint8_t buf[23];
+  uint32_t sent = 0U;
+  size_t i, k, off;
+  bool notify;
+
+  (void)arg;
+
+  while (sent < STREAM_SIZE) {
+    k = (size_t)1 + (size_t)(sent % 23U);
+    if (k > (size_t)(STREAM_SIZE - sent)) {
+      k = (size_t)(STREAM_SIZE - sent);
+    }
+    for (i = 0U; i < k; i++) {
+      buf[i] = (uint8_t)(sent + i);
+    }
+
+    off = 0U;
+    while (off < k) {
+      int32_t n = sbRingWrite(&prodport, buf + off, k - off, &notify);
+      if (n < 0) {
+        chThdExit(MSG_RESET);
+      }
+      off += (size_t)n;
+      if (notify) {
+        chBSemSignal(&data_bell);
+      }
+      if ((off < k) && sbRingWaitSpace(&prodport)) {
+        chBSemWait(&space_bell);
+      }
+    }
+    sent += (uint32_t)k;
+  }
+
+  chThdExit(MSG_OK);
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page sb_test_001_001 [1.1] Ring declaration
+ *
+ * <h2>Description</h2>
+ * Ring sizes and area declaration.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.1.1] The valid and invalid ring sizes are checked.
+ * - [1.1.2] The area size and the buffer position are checked.
+ * .
+ */
+
+static void sb_test_001_001_setup(void) {
+  ring_setup();
+}
+
+static void sb_test_001_001_execute(void) {
+
+  /* [1.1.1] The valid and invalid ring sizes are checked.*/
+  test_set_step(1);
+  {
+    test_assert(SB_RING_IS_VALID_SIZE(1U) && SB_RING_IS_VALID_SIZE(64U) &&
+                SB_RING_IS_VALID_SIZE(SB_RING_MAX_SIZE), "valid size rejected");
+    test_assert(!SB_RING_IS_VALID_SIZE(0U) && !SB_RING_IS_VALID_SIZE(48U) &&
+                !SB_RING_IS_VALID_SIZE(SB_RING_MAX_SIZE * 2U),
+                "invalid size accepted");
+  }
+  test_end_step(1);
+
+  /* [1.1.2] The area size and the buffer position are checked.*/
+  test_set_step(2);
+  {
+    test_assert(sizeof ring_area == sizeof (sb_ring_t) + RING_SIZE,
+                "wrong area size");
+    test_assert(consport.buffer == (uint8_t *)(void *)ring_area +
+                                   sizeof (sb_ring_t), "wrong buffer");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t sb_test_001_001 = {
+  "Ring declaration",
+  sb_test_001_001_setup,
+  NULL,
+  sb_test_001_001_execute
+};
+
+/**
+ * @page sb_test_001_002 [1.2] Empty and full transitions
+ *
+ * <h2>Description</h2>
+ * Empty and full transitions, waiting flags and notifications.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.2.1] Reading from the empty ring returns nothing, the consumer
+ *   is marked as waiting.
+ * - [1.2.2] Writing notifies the waiting consumer, the data is read
+ *   back.
+ * - [1.2.3] The ring is filled, further writes return nothing, the
+ *   producer is marked as waiting.
+ * - [1.2.4] Reading notifies the waiting producer, the ring is drained.
+ * .
+ */
+
+static void sb_test_001_002_setup(void) {
+  ring_setup();
+}
+
+static void sb_test_001_002_execute(void) {
+  bool notify;
+
+  /* [1.2.1] Reading from the empty ring returns nothing, the consumer
+     is marked as waiting.*/
+  test_set_step(1);
+  {
+    test_assert(sbRingGetUsed(&consport) == 0, "not empty");
+    test_assert((sbRingRead(&consport, dst, 10U, &notify) == 0) && !notify,
+                "read from empty");
+    test_assert(sbRingWaitData(&consport) && (ring()->rdwait != 0U),
+                "no wait on empty");
+  }
+  test_end_step(1);
+
+  /* [1.2.2] Writing notifies the waiting consumer, the data is read
+     back.*/
+  test_set_step(2);
+  {
+    test_assert((sbRingWrite(&prodport, src, 10U, &notify) == 10) && notify,
+                "waiting consumer not notified");
+    test_assert(!sbRingWaitData(&consport) && (ring()->rdwait == 0U),
+                "wait with data");
+    test_assert((sbRingRead(&consport, dst, 100U, &notify) == 10) && !notify,
+                "wrong read");
+    test_assert(memcmp(src, dst, 10U) == 0, "wrong data");
+  }
+  test_end_step(2);
+
+  /* [1.2.3] The ring is filled, further writes return nothing, the
+     producer is marked as waiting.*/
+  test_set_step(3);
+  {
+    test_assert((sbRingWrite(&prodport, src, 100U, &notify) ==
+                 (int32_t)RING_SIZE) && !notify, "not filled");
+    test_assert(sbRingGetUsed(&prodport) == (int32_t)RING_SIZE, "not full");
+    test_assert(sbRingWrite(&prodport, src, 1U, &notify) == 0,
+                "write to full");
+    test_assert(sbRingWaitSpace(&prodport) && (ring()->wrwait != 0U),
+                "no wait on full");
+  }
+  test_end_step(3);
+
+  /* [1.2.4] Reading notifies the waiting producer, the ring is
+     drained.*/
+  test_set_step(4);
+  {
+    test_assert((sbRingRead(&consport, dst, 1U, &notify) == 1) && notify,
+                "waiting producer not notified");
+    test_assert(!sbRingWaitSpace(&prodport) && (ring()->wrwait == 0U),
+                "wait with space");
+    test_assert((sbRingRead(&consport, dst + 1U, 100U, &notify) ==
+                 (int32_t)RING_SIZE - 1) && !notify, "not drained");
+    test_assert(memcmp(src, dst, RING_SIZE) == 0, "wrong data");
+    test_assert(sbRingGetUsed(&consport) == 0, "not empty");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t sb_test_001_002 = {
+  "Empty and full transitions",
+  sb_test_001_002_setup,
+  NULL,
+  sb_test_001_002_execute
+};
+
+/**
+ * @page sb_test_001_003 [1.3] Wrap-around
+ *
+ * <h2>Description</h2>
+ * Transfers wrapping around the buffer end, at every starting offset.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] Transfers are performed starting at every offset of the
+ *   buffer.
+ * - [1.3.2] Split writes and reads across the buffer end.
+ * .
+ */
+
+static void sb_test_001_003_setup(void) {
+  ring_setup();
+}
+
+static void sb_test_001_003_execute(void) {
+  uint32_t start;
+  bool notify;
+
+  /* [1.3.1] Transfers are performed starting at every offset of the
+     buffer.*/
+  test_set_step(1);
+  {
+    for (start = 0U; start < RING_SIZE; start++) {
+      ring_set_indexes(start);
+      test_assert(sbRingWrite(&prodport, src + start, RING_SIZE - 1U,
+                              &notify) == (int32_t)RING_SIZE - 1,
+                  "wrong write");
+      test_assert(sbRingRead(&consport, dst, RING_SIZE, &notify) ==
+                  (int32_t)RING_SIZE - 1, "wrong read");
+      test_assert(memcmp(src + start, dst, RING_SIZE - 1U) == 0,
+                  "wrong data");
+    }
+  }
+  test_end_step(1);
+
+  /* [1.3.2] Split writes and reads across the buffer end.*/
+  test_set_step(2);
+  {
+    ring_set_indexes(RING_SIZE - 3U);
+    test_assert(sbRingWrite(&prodport, src, 5U, &notify) == 5, "wrong write");
+    test_assert(sbRingWrite(&prodport, src + 5U, 5U, &notify) == 5,
+                "wrong write");
+    test_assert(sbRingRead(&consport, dst, 2U, &notify) == 2, "wrong read");
+    test_assert(sbRingRead(&consport, dst + 2U, 8U, &notify) == 8,
+                "wrong read");
+    test_assert(memcmp(src, dst, 10U) == 0, "wrong data");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t sb_test_001_003 = {
+  "Wrap-around",
+  sb_test_001_003_setup,
+  NULL,
+  sb_test_001_003_execute
+};
+
+/**
+ * @page sb_test_001_004 [1.4] Index overflow
+ *
+ * <h2>Description</h2>
+ * Free running indexes overflowing 32 bits.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.4.1] The ring is filled with the write index overflowing 32
+ *   bits.
+ * - [1.4.2] Data is read and written with the indexes across the
+ *   overflow, the stream is checked.
+ * .
+ */
+
+static void sb_test_001_004_setup(void) {
+  ring_setup();
+}
+
+static void sb_test_001_004_execute(void) {
+  bool notify;
+
+  /* [1.4.1] The ring is filled with the write index overflowing 32
+     bits.*/
+  test_set_step(1);
+  {
+    ring_set_indexes(0xFFFFFFF0U);
+    test_assert(sbRingWrite(&prodport, src, 100U, &notify) ==
+                (int32_t)RING_SIZE, "not filled");
+    test_assert(ring()->wrptr == 0xFFFFFFF0U + RING_SIZE, "wrong index");
+    test_assert(ring()->wrptr < ring()->rdptr, "index not wrapped");
+    test_assert(sbRingGetUsed(&consport) == (int32_t)RING_SIZE, "not full");
+    test_assert(sbRingWrite(&prodport, src, 1U, &notify) == 0,
+                "write to full");
+  }
+  test_end_step(1);
+
+  /* [1.4.2] Data is read and written with the indexes across the
+     overflow, the stream is checked.*/
+  test_set_step(2);
+  {
+    test_assert(sbRingRead(&consport, dst, 30U, &notify) == 30,
+                "wrong read");
+    test_assert(sbRingWrite(&prodport, src + RING_SIZE, 100U, &notify) == 30,
+                "wrong write");
+    test_assert(sbRingRead(&consport, dst + 30U, 200U, &notify) ==
+                (int32_t)RING_SIZE, "wrong read");
+    test_assert(memcmp(src, dst, RING_SIZE + 30U) == 0, "wrong data");
+    test_assert(sbRingGetUsed(&consport) == 0, "not empty");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t sb_test_001_004 = {
+  "Index overflow",
+  sb_test_001_004_setup,
+  NULL,
+  sb_test_001_004_execute
+};
+
+/**
+ * @page sb_test_001_005 [1.5] Corrupted indexes
+ *
+ * <h2>Description</h2>
+ * Inconsistent indexes are detected on both sides.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.5.1] A read index ahead of the write index is detected.
+ * - [1.5.2] A used size larger than the ring size is detected.
+ * .
+ */
+
+static void sb_test_001_005_setup(void) {
+  ring_setup();
+}
+
+static void sb_test_001_005_execute(void) {
+  bool notify;
+
+  /* [1.5.1] A read index ahead of the write index is detected.*/
+  test_set_step(1);
+  {
+    ring()->wrptr = 0U;
+    ring()->rdptr = 1U;
+    test_assert(sbRingRead(&consport, dst, 1U, &notify) == SB_RING_FAULT,
+                "not detected");
+    test_assert(sbRingWrite(&prodport, src, 1U, &notify) == SB_RING_FAULT,
+                "not detected");
+    test_assert(sbRingGetUsed(&consport) == SB_RING_FAULT, "not detected");
+  }
+  test_end_step(1);
+
+  /* [1.5.2] A used size larger than the ring size is detected.*/
+  test_set_step(2);
+  {
+    ring()->wrptr = RING_SIZE + 1U;
+    ring()->rdptr = 0U;
+    test_assert(sbRingRead(&consport, dst, 1U, &notify) == SB_RING_FAULT,
+                "not detected");
+    test_assert(sbRingWrite(&prodport, src, 1U, &notify) == SB_RING_FAULT,
+                "not detected");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t sb_test_001_005 = {
+  "Corrupted indexes",
+  sb_test_001_005_setup,
+  NULL,
+  sb_test_001_005_execute
+};
+
+/**
+ * @page sb_test_001_006 [1.6] Producer and consumer
+ *
+ * <h2>Description</h2>
+ * Producer and consumer threads with doorbells, the indexes overflow
+ * during the transfer.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.6.1] A producer thread writes a stream in chunks of varying
+ *   sizes, the consumer reads and checks it using the doorbells for
+ *   waiting.
+ * .
+ */
+
+static void sb_test_001_006_setup(void) {
+  ring_setup();
+}
+
+static void sb_test_001_006_execute(void) {
+  uint8_t buf[50];
+  uint32_t got = 0U;
+  thread_t *tp;
+  bool notify;
+
+  /* [1.6.1] A producer thread writes a stream in chunks of varying
+     sizes, the consumer reads and checks it using the doorbells for
+     waiting.*/
+  test_set_step(1);
+  {
+    chBSemObjectInit(&data_bell, true);
+    chBSemObjectInit(&space_bell, true);
+    ring_set_indexes(0U - (STREAM_SIZE / 2U));
+    tp = chThdCreateStatic(waProducer, sizeof waProducer,
+                           chThdGetPriorityX(), Producer, NULL);
+
+    while (got < STREAM_SIZE) {
+      int32_t i, n;
+
+      n = sbRingRead(&consport, buf, (size_t)1 + (size_t)(got % 50U),
+                     &notify);
+      test_assert(n >= 0, "fault");
+      for (i = 0; i < n; i++) {
+        test_assert(buf[i] == (uint8_t)(got + (uint32_t)i), "wrong data");
+      }
+      got += (uint32_t)n;
+      if (notify) {
+        chBSemSignal(&space_bell);
+      }
+      if ((n == 0) && sbRingWaitData(&consport)) {
+        test_assert(chBSemWaitTimeout(&data_bell, TIME_MS2I(1000)) == MSG_OK,
+                    "lost doorbell");
+      }
+      else {
+        chThdYield();
+      }
+    }
+
+    test_assert(chThdWait(tp) == MSG_OK, "producer failed");
+    test_assert(sbRingGetUsed(&consport) == 0, "not empty");
+  }
+  test_end_step(1);
+}
+
+static const testcase_t sb_test_001_006 = {
+  "Producer and consumer",
+  sb_test_001_006_setup,
+  NULL,
+  sb_test_001_006_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const sb_test_sequence_001_array[] = {
+  &sb_test_001_001,
+  &sb_test_001_002,
+  &sb_test_001_003,
+  &sb_test_001_004,
+  &sb_test_001_005,
+  &sb_test_001_006,
+  NULL
+};
+
+/**
+ * @brief   Sandbox shared rings.
+ */
+const testsequence_t sb_test_sequence_001 = {
+  "Sandbox shared rings",
+  sb_test_sequence_001_array
+};
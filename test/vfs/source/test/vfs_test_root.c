@@ -0,0 +1,183 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @mainpage Test Suite Specification
+ * Test suite for ChibiOS/VFS. The purpose of this suite is to perform
+ * unit tests on the VFS file system drivers and to measure their
+ * performance.
+ *
+ * <h2>Test Sequences</h2>
+ * - @subpage vfs_test_sequence_001
+ * - @subpage vfs_test_sequence_002
+ * - @subpage vfs_test_sequence_003
+ * .
+ */
+
+/**
+ * @file    vfs_test_root.c
+ * @brief   Test Suite root structures code.
+ */
+
+#include "hal.h"
+#include "vfs_test_root.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Array of test sequences.
+ */
+const testsequence_t * const vfs_test_suite_array[] = {
+#if (VFS_CFG_ENABLE_DRV_CHFS == TRUE) || defined(__DOXYGEN__)
+  &vfs_test_sequence_001,
+#endif
+  &vfs_test_sequence_002,
+#if ((VFS_CFG_ENABLE_DRV_CHFS == TRUE) && (VFS_CFG_ENABLE_DRV_OVERLAY == TRUE) && (DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0)) || defined(__DOXYGEN__)
+  &vfs_test_sequence_003,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Test suite root structure.
+ */
+const testsuite_t vfs_test_suite = {
+  "ChibiOS/VFS Test Suite",
+  vfs_test_suite_array
+};
+
+/*===========================================================================*/
+/* Shared code.                                                              */
+/*===========================================================================*/
+
+#include "vfs.h"
+
+uint8_t vfs_test_buffer[VFS_TEST_BUFFER_SIZE];
+
+#if VFS_CFG_ENABLE_DRV_CHFS == TRUE
+vfs_chfs_driver_c chfs1;
+#endif
+
+#if VFS_CFG_ENABLE_DRV_LITTLEFS == TRUE
+vfs_littlefs_driver_c lfs1;
+#endif
+
+/* Pattern depending on the file offset, misplaced data is detected.*/
+static uint8_t vfs_test_pattern(size_t offset, uint32_t seed) {
+
+  return (uint8_t)((offset * 7U) + (offset >> 8) + seed);
+}
+
+void vfs_test_fill(uint8_t *p, size_t n, uint32_t seed) {
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    p[i] = vfs_test_pattern(i, seed);
+  }
+}
+
+bool vfs_test_check(const uint8_t *p, size_t n, uint32_t seed) {
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    if (p[i] != vfs_test_pattern(i, seed)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+msg_t vfs_test_write_file(void *drvp, const char *path, size_t size,
+                          size_t chunk, uint32_t seed) {
+  vfs_file_node_c *fnp;
+  size_t offset;
+  msg_t ret;
+
+  ret = vfsDrvOpenFile(drvp, path, VO_CREAT | VO_TRUNC | VO_WRONLY, &fnp);
+  CH_RETURN_ON_ERROR(ret);
+
+  for (offset = 0U; offset < size; offset += chunk) {
+    size_t i, n = size - offset < chunk ? size - offset : chunk;
+    ssize_t nw;
+
+    if (n > VFS_TEST_BUFFER_SIZE) {
+      n = VFS_TEST_BUFFER_SIZE;
+    }
+    for (i = 0U; i < n; i++) {
+      vfs_test_buffer[i] = vfs_test_pattern(offset + i, seed);
+    }
+    nw = vfsFileWrite(fnp, vfs_test_buffer, n);
+    if (nw != (ssize_t)n) {
+      ret = CH_RET_IS_ERROR(nw) ? (msg_t)nw : CH_RET_ENOSPC;
+      break;
+    }
+    chunk = n;
+  }
+
+  vfsClose((vfs_node_c *)fnp);
+
+  return ret;
+}
+
+msg_t vfs_test_check_file(void *drvp, const char *path, size_t size,
+                          uint32_t seed) {
+  vfs_file_node_c *fnp;
+  vfs_stat_t st;
+  size_t offset;
+  msg_t ret;
+
+  ret = vfsDrvOpenFile(drvp, path, VO_RDONLY, &fnp);
+  CH_RETURN_ON_ERROR(ret);
+
+  ret = vfsNodeStat(fnp, &st);
+  if ((ret == CH_RET_SUCCESS) && ((size_t)st.size != size)) {
+    ret = CH_RET_EIO;
+  }
+
+  for (offset = 0U; (ret == CH_RET_SUCCESS) && (offset <= size);
+       offset += VFS_TEST_BUFFER_SIZE) {
+    size_t i, n = size - offset;
+    ssize_t nr;
+
+    if (n > VFS_TEST_BUFFER_SIZE) {
+      n = VFS_TEST_BUFFER_SIZE;
+    }
+
+    /* The last read must hit the end of file.*/
+    nr = vfsFileRead(fnp, vfs_test_buffer, VFS_TEST_BUFFER_SIZE);
+    if (nr != (ssize_t)n) {
+      ret = CH_RET_IS_ERROR(nr) ? (msg_t)nr : CH_RET_EIO;
+      break;
+    }
+    for (i = 0U; i < n; i++) {
+      if (vfs_test_buffer[i] != vfs_test_pattern(offset + i, seed)) {
+        ret = CH_RET_EIO;
+        break;
+      }
+    }
+  }
+
+  vfsClose((vfs_node_c *)fnp);
+
+  return ret;
+}
+
+#endif /* !defined(__DOXYGEN__) */
@@ -0,0 +1,77 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    vfs_test_root.h
+ * @brief   Test Suite root structures header.
+ */
+
+#ifndef VFS_TEST_ROOT_H
+#define VFS_TEST_ROOT_H
+
+#include "ch_test.h"
+
+#include "vfs_test_sequence_001.h"
+#include "vfs_test_sequence_002.h"
+#include "vfs_test_sequence_003.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+extern const testsuite_t vfs_test_suite;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Shared definitions.                                                       */
+/*===========================================================================*/
+
+#include "vfs.h"
+
+#define TEST_SUITE_NAME "ChibiOS/VFS Test Suite"
+
+#define VFS_TEST_BUFFER_SIZE    4096U
+
+extern uint8_t vfs_test_buffer[VFS_TEST_BUFFER_SIZE];
+
+#if VFS_CFG_ENABLE_DRV_CHFS == TRUE
+extern const chfs_config_t chfscfg1;
+extern vfs_chfs_driver_c chfs1;
+#endif
+
+#if VFS_CFG_ENABLE_DRV_LITTLEFS == TRUE
+extern const struct lfs_config lfscfg1;
+extern vfs_littlefs_driver_c lfs1;
+#endif
+
+void vfs_test_fill(uint8_t *p, size_t n, uint32_t seed);
+bool vfs_test_check(const uint8_t *p, size_t n, uint32_t seed);
+msg_t vfs_test_write_file(void *drvp, const char *path, size_t size,
+                          size_t chunk, uint32_t seed);
+msg_t vfs_test_check_file(void *drvp, const char *path, size_t size,
+                          uint32_t seed);
+
+#endif /* !defined(__DOXYGEN__) */
+
+#endif /* VFS_TEST_ROOT_H */
@@ -0,0 +1,1010 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "vfs_test_root.h"
+
+/**
+ * @file    vfs_test_sequence_001.c
+ * @brief   Test Sequence 001 code.
+ *
+ * @page vfs_test_sequence_001 [1] ChibiFS functionality
+ *
+ * File: @ref vfs_test_sequence_001.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the ChibiFS driver functionalities on a flash
+ * volume.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - VFS_CFG_ENABLE_DRV_CHFS == TRUE
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage vfs_test_001_001
+ * - @subpage vfs_test_001_002
+ * - @subpage vfs_test_001_003
+ * - @subpage vfs_test_001_004
+ * - @subpage vfs_test_001_005
+ * - @subpage vfs_test_001_006
+ * - @subpage vfs_test_001_007
+ * .
+ */
+
+#if (VFS_CFG_ENABLE_DRV_CHFS == TRUE) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+#include "vfs.h"
+
+static void chfs_test_format_mount(void) {
+
+  chfsdrvObjectInit(&chfs1, &chfscfg1);
+  (void) chfsdrvUnmount(&chfs1);
+  (void) chfsdrvFormat(&chfs1);
+  (void) chfsdrvMount(&chfs1);
+}
+
+/* Flash wrapper injecting program failures, the failing operation
+   programs only the first half of the data as an interrupted program
+   would do.*/
+static unsigned chfs_test_program_fail;
+static chfs_config_t chfs_test_faultcfg;
+
+static const flash_descriptor_t *chfs_test_get_descriptor(void *instance) {
+
+  (void)instance;
+
+  return flashGetDescriptor(chfscfg1.flp);
+}
+
+static flash_error_t chfs_test_read(void *instance, flash_offset_t offset,
+                                    size_t n, uint8_t *rp) {
+
+  (void)instance;
+
+  return flashRead(chfscfg1.flp, offset, n, rp);
+}
+
+static flash_error_t chfs_test_program(void *instance, flash_offset_t offset,
+                                       size_t n, const uint8_t *pp) {
+
+  (void)instance;
+
+  if ((chfs_test_program_fail > 0U) && (--chfs_test_program_fail == 0U)) {
+    if (n > 1U) {
+      (void) flashProgram(chfscfg1.flp, offset, n / 2U, pp);
+    }
+    return FLASH_ERROR_PROGRAM;
+  }
+
+  return flashProgram(chfscfg1.flp, offset, n, pp);
+}
+
+static flash_error_t chfs_test_start_erase_all(void *instance) {
+
+  (void)instance;
+
+  return flashStartEraseAll(chfscfg1.flp);
+}
+
+static flash_error_t chfs_test_start_erase_sector(void *instance,
+                                                  flash_sector_t sector) {
+
+  (void)instance;
+
+  return flashStartEraseSector(chfscfg1.flp, sector);
+}
+
+static flash_error_t chfs_test_query_erase(void *instance, uint32_t *msec) {
+
+  (void)instance;
+
+  return flashQueryErase(chfscfg1.flp, msec);
+}
+
+static flash_error_t chfs_test_verify_erase(void *instance,
+                                            flash_sector_t sector) {
+
+  (void)instance;
+
+  return flashVerifyErase(chfscfg1.flp, sector);
+}
+
+static flash_error_t chfs_test_acquire_exclusive(void *instance) {
+
+  (void)instance;
+
+  return flashAcquireExclusive(chfscfg1.flp);
+}
+
+static flash_error_t chfs_test_release_exclusive(void *instance) {
+
+  (void)instance;
+
+  return flashReleaseExclusive(chfscfg1.flp);
+}
+
+static const struct BaseFlashVMT chfs_test_flash_vmt = {
+  (size_t)0,
+  chfs_test_get_descriptor,
+  chfs_test_read,
+  chfs_test_program,
+  chfs_test_start_erase_all,
+  chfs_test_start_erase_sector,
+  chfs_test_query_erase,
+  chfs_test_verify_erase,
+  chfs_test_acquire_exclusive,
+  chfs_test_release_exclusive
+};
+
+static BaseFlash chfs_test_flash = {&chfs_test_flash_vmt, FLASH_READY};
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page vfs_test_001_001 [1.1] Format and mount
+ *
+ * <h2>Description</h2>
+ * The ChibiFS volume is formatted and mounted, the mount state
+ * transitions and the empty volume state are verified.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.1.1] Operations on an unmounted volume are rejected.
+ * - [1.1.2] The volume is formatted and mounted.
+ * - [1.1.3] Mount and format are rejected while the volume is mounted.
+ * - [1.1.4] The root directory is empty and the volume holds no data.
+ * - [1.1.5] The volume is unmounted and mounted again.
+ * .
+ */
+
+static void vfs_test_001_001_setup(void) {
+  chfsdrvObjectInit(&chfs1, &chfscfg1);
+}
+
+static void vfs_test_001_001_execute(void) {
+  msg_t ret;
+
+  /* [1.1.1] Operations on an unmounted volume are rejected.*/
+  test_set_step(1);
+  {
+    vfs_stat_t st;
+
+    (void) chfsdrvUnmount(&chfs1);
+    ret = vfsDrvStat(&chfs1, "/", &st);
+    test_assert(ret == CH_RET_EIO, "not rejected");
+  }
+  test_end_step(1);
+
+  /* [1.1.2] The volume is formatted and mounted.*/
+  test_set_step(2);
+  {
+    ret = chfsdrvFormat(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "format failed");
+    ret = chfsdrvMount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "mount failed");
+  }
+  test_end_step(2);
+
+  /* [1.1.3] Mount and format are rejected while the volume is
+     mounted.*/
+  test_set_step(3);
+  {
+    ret = chfsdrvMount(&chfs1);
+    test_assert(ret == CH_RET_EBUSY, "mount not rejected");
+    ret = chfsdrvFormat(&chfs1);
+    test_assert(ret == CH_RET_EBUSY, "format not rejected");
+  }
+  test_end_step(3);
+
+  /* [1.1.4] The root directory is empty and the volume holds no data.*/
+  test_set_step(4);
+  {
+    vfs_directory_node_c *dnp;
+    vfs_direntry_info_t di;
+    vfs_stat_t st;
+
+    ret = vfsDrvStat(&chfs1, "", &st);
+    test_assert(ret == CH_RET_SUCCESS, "stat failed");
+    test_assert(st.mode == VFS_MODE_S_IFBLK, "wrong mode");
+    test_assert(st.size == 0, "not empty");
+    ret = vfsDrvOpenDirectory(&chfs1, "/", &dnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    ret = vfsDirReadFirst(dnp, &di);
+    vfsClose((vfs_node_c *)dnp);
+    test_assert(ret == (msg_t)0, "not empty");
+  }
+  test_end_step(4);
+
+  /* [1.1.5] The volume is unmounted and mounted again.*/
+  test_set_step(5);
+  {
+    ret = chfsdrvUnmount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "unmount failed");
+    ret = chfsdrvMount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "mount failed");
+    ret = chfsdrvUnmount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "unmount failed");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t vfs_test_001_001 = {
+  "Format and mount",
+  vfs_test_001_001_setup,
+  NULL,
+  vfs_test_001_001_execute
+};
+
+/**
+ * @page vfs_test_001_002 [1.2] Files write and read
+ *
+ * <h2>Description</h2>
+ * Files are created, written using different transfer sizes, read back
+ * and verified. Positioning, appending and truncation are tested.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.2.1] Opening a missing file without VO_CREAT fails.
+ * - [1.2.2] Files are written with small, buffer-sized and large writes
+ *   then verified.
+ * - [1.2.3] Creating an existing file with VO_EXCL fails.
+ * - [1.2.4] A file range is overwritten in the middle, the file content
+ *   is verified.
+ * - [1.2.5] Data is appended to a file opened with VO_APPEND.
+ * - [1.2.6] A file is truncated on open, positioning beyond the end of
+ *   file creates a hole that is read as zeros.
+ * - [1.2.7] A file is written and read back using vectored transfers,
+ *   empty elements are skipped and reads stop at the end of file.
+ * .
+ */
+
+static void vfs_test_001_002_setup(void) {
+  chfs_test_format_mount();
+}
+
+static void vfs_test_001_002_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_001_002_execute(void) {
+  vfs_file_node_c *fnp;
+  msg_t ret;
+
+  /* [1.2.1] Opening a missing file without VO_CREAT fails.*/
+  test_set_step(1);
+  {
+    ret = vfsDrvOpenFile(&chfs1, "/file1", VO_RDONLY, &fnp);
+    test_assert(ret == CH_RET_ENOENT, "wrong error");
+  }
+  test_end_step(1);
+
+  /* [1.2.2] Files are written with small, buffer-sized and large writes
+     then verified.*/
+  test_set_step(2);
+  {
+    ret = vfs_test_write_file(&chfs1, "/file1", 1000U, 7U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfs_test_write_file(&chfs1, "/file2", 3000U, DRV_CFG_CHFS_WRITE_BUFFER_SIZE, 2U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfs_test_write_file(&chfs1, "/file3", 10000U, VFS_TEST_BUFFER_SIZE, 3U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfs_test_check_file(&chfs1, "/file1", 1000U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/file2", 3000U, 2U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/file3", 10000U, 3U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+  }
+  test_end_step(2);
+
+  /* [1.2.3] Creating an existing file with VO_EXCL fails.*/
+  test_set_step(3);
+  {
+    ret = vfsDrvOpenFile(&chfs1, "/file1", VO_CREAT | VO_EXCL | VO_RDWR, &fnp);
+    test_assert(ret == CH_RET_EEXIST, "wrong error");
+  }
+  test_end_step(3);
+
+  /* [1.2.4] A file range is overwritten in the middle, the file content
+     is verified.*/
+  test_set_step(4);
+  {
+    uint8_t buf[16];
+    ssize_t n;
+
+    ret = vfsDrvOpenFile(&chfs1, "/file1", VO_RDWR, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    ret = vfsFileSetPosition(fnp, 500, VFS_SEEK_SET);
+    test_assert(ret == CH_RET_SUCCESS, "seek failed");
+    memset(buf, 0x55, sizeof buf);
+    n = vfsFileWrite(fnp, buf, sizeof buf);
+    test_assert(n == (ssize_t)sizeof buf, "write failed");
+    test_assert(vfsFileGetPosition(fnp) == 516, "wrong position");
+    ret = vfsFileSetPosition(fnp, -32, VFS_SEEK_CUR);
+    test_assert(ret == CH_RET_SUCCESS, "seek failed");
+    n = vfsFileRead(fnp, vfs_test_buffer, 64U);
+    test_assert(n == 64, "read failed");
+    test_assert(vfs_test_buffer[15] != 0x55, "wrong data");
+    test_assert(vfs_test_buffer[16] == 0x55, "wrong data");
+    test_assert(vfs_test_buffer[31] == 0x55, "wrong data");
+    test_assert(vfs_test_buffer[32] != 0x55, "wrong data");
+    ret = vfsFileSetPosition(fnp, -1, VFS_SEEK_SET);
+    test_assert(ret == CH_RET_EINVAL, "seek not rejected");
+    vfsClose((vfs_node_c *)fnp);
+  }
+  test_end_step(4);
+
+  /* [1.2.5] Data is appended to a file opened with VO_APPEND.*/
+  test_set_step(5);
+  {
+    vfs_stat_t st;
+    ssize_t n;
+
+    ret = vfsDrvOpenFile(&chfs1, "/file2", VO_WRONLY | VO_APPEND, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    vfs_test_fill(vfs_test_buffer, 100U, 9U);
+    n = vfsFileWrite(fnp, vfs_test_buffer, 100U);
+    test_assert(n == 100, "write failed");
+    test_assert(vfsFileGetPosition(fnp) == 3100, "wrong position");
+    n = vfsFileRead(fnp, vfs_test_buffer, 1U);
+    test_assert(n == CH_RET_EBADF, "read not rejected");
+    vfsClose((vfs_node_c *)fnp);
+    ret = vfsDrvStat(&chfs1, "/file2", &st);
+    test_assert(ret == CH_RET_SUCCESS, "stat failed");
+    test_assert(st.size == 3100, "wrong size");
+  }
+  test_end_step(5);
+
+  /* [1.2.6] A file is truncated on open, positioning beyond the end of
+     file creates a hole that is read as zeros.*/
+  test_set_step(6);
+  {
+    vfs_stat_t st;
+    ssize_t n;
+
+    ret = vfsDrvOpenFile(&chfs1, "/file3", VO_RDWR | VO_TRUNC, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    ret = vfsNodeStat(fnp, &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.size == 0), "not truncated");
+    ret = vfsFileSetPosition(fnp, 100, VFS_SEEK_SET);
+    test_assert(ret == CH_RET_SUCCESS, "seek failed");
+    n = vfsFileWrite(fnp, (const uint8_t *)"x", 1U);
+    test_assert(n == 1, "write failed");
+    ret = vfsFileSetPosition(fnp, 0, VFS_SEEK_SET);
+    test_assert(ret == CH_RET_SUCCESS, "seek failed");
+    n = vfsFileRead(fnp, vfs_test_buffer, VFS_TEST_BUFFER_SIZE);
+    test_assert(n == 101, "read failed");
+    test_assert((vfs_test_buffer[0] == 0) && (vfs_test_buffer[99] == 0) &&
+                (vfs_test_buffer[100] == 'x'), "wrong data");
+    vfsClose((vfs_node_c *)fnp);
+  }
+  test_end_step(6);
+
+  /* [1.2.7] A file is written and read back using vectored transfers,
+     empty elements are skipped and reads stop at the end of file.*/
+  test_set_step(7);
+  {
+    vfs_iovec_t iov[3];
+    ssize_t n;
+
+    ret = vfsDrvOpenFile(&chfs1, "/file4", VO_CREAT | VO_WRONLY, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    vfs_test_fill(vfs_test_buffer, 3100U, 4U);
+    iov[0].iov_base = &vfs_test_buffer[0];
+    iov[0].iov_len  = 100U;
+    iov[1].iov_base = NULL;
+    iov[1].iov_len  = 0U;
+    iov[2].iov_base = &vfs_test_buffer[100];
+    iov[2].iov_len  = 3000U;
+    n = vfsWriteFileV(fnp, iov, 3U);
+    vfsClose((vfs_node_c *)fnp);
+    test_assert(n == 3100, "write failed");
+    ret = vfs_test_check_file(&chfs1, "/file4", 3100U, 4U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+
+    ret = vfsDrvOpenFile(&chfs1, "/file4", VO_RDONLY, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    memset(vfs_test_buffer, 0, VFS_TEST_BUFFER_SIZE);
+    iov[0].iov_base = &vfs_test_buffer[0];
+    iov[0].iov_len  = 1000U;
+    iov[1].iov_base = &vfs_test_buffer[1000];
+    iov[1].iov_len  = VFS_TEST_BUFFER_SIZE - 1000U;
+    n = vfsReadFileV(fnp, iov, 2U);
+    vfsClose((vfs_node_c *)fnp);
+    test_assert(n == 3100, "read failed");
+    test_assert(vfs_test_check(vfs_test_buffer, 3100U, 4U), "wrong data");
+  }
+  test_end_step(7);
+}
+
+static const testcase_t vfs_test_001_002 = {
+  "Files write and read",
+  vfs_test_001_002_setup,
+  vfs_test_001_002_teardown,
+  vfs_test_001_002_execute
+};
+
+/**
+ * @page vfs_test_001_003 [1.3] Directories
+ *
+ * <h2>Description</h2>
+ * Directories are created, listed and removed, relative paths and the
+ * current directory are tested.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] A directories tree is created.
+ * - [1.3.2] The directories content is listed, one entry at a time
+ *   and in a single batch.
+ * - [1.3.3] The current directory is changed, relative paths are
+ *   resolved from there.
+ * - [1.3.4] Non-empty and busy directories cannot be removed.
+ * - [1.3.5] The tree is removed.
+ * .
+ */
+
+static void vfs_test_001_003_setup(void) {
+  chfs_test_format_mount();
+}
+
+static void vfs_test_001_003_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_001_003_execute(void) {
+  vfs_directory_node_c *dnp;
+  vfs_direntry_info_t di;
+  char buf[32];
+  msg_t ret;
+
+  /* [1.3.1] A directories tree is created.*/
+  test_set_step(1);
+  {
+    ret = vfsDrvMkdir(&chfs1, "/dir1", 0);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsDrvMkdir(&chfs1, "/dir1/sub1", 0);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsDrvMkdir(&chfs1, "/dir1/sub2", 0);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsDrvMkdir(&chfs1, "/dir1", 0);
+    test_assert(ret == CH_RET_EEXIST, "mkdir not rejected");
+    ret = vfsDrvMkdir(&chfs1, "/dir2/sub1", 0);
+    test_assert(ret == CH_RET_ENOENT, "mkdir not rejected");
+    ret = vfs_test_write_file(&chfs1, "/dir1/sub1/file1", 100U, 100U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfs_test_write_file(&chfs1, "/dir1/sub1/file1/x", 100U, 100U, 1U);
+    test_assert(ret == CH_RET_ENOTDIR, "open not rejected");
+  }
+  test_end_step(1);
+
+  /* [1.3.2] The directories content is listed, one entry at a time
+     and in a single batch.*/
+  test_set_step(2);
+  {
+    vfs_direntry_info_t dia[4];
+    unsigned n = 0U;
+
+    ret = vfsDrvOpenDirectory(&chfs1, "/dir1", &dnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    ret = vfsDirReadFirst(dnp, &di);
+    while (ret > (msg_t)0) {
+      test_assert((di.mode & VFS_MODE_S_IFDIR) != 0, "not a directory");
+      test_assert((strcmp(di.name, "sub1") == 0) ||
+                  (strcmp(di.name, "sub2") == 0), "unexpected entry");
+      n++;
+      ret = vfsDirReadNext(dnp, &di);
+    }
+    vfsClose((vfs_node_c *)dnp);
+    test_assert(n == 2U, "wrong entries count");
+    ret = vfsDrvOpenDirectory(&chfs1, "/dir1", &dnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    ret = vfsReadDirectoryMany(dnp, dia, 4U);
+    test_assert(ret == (msg_t)2, "wrong entries count");
+    test_assert((dia[0].ino != 0U) && (dia[1].ino != 0U) &&
+                (dia[0].ino != dia[1].ino), "wrong serial numbers");
+    ret = vfsReadDirectoryMany(dnp, dia, 4U);
+    vfsClose((vfs_node_c *)dnp);
+    test_assert(ret == (msg_t)0, "not at end");
+    ret = vfsDrvOpenDirectory(&chfs1, "/dir1/sub1/file1", &dnp);
+    test_assert(ret == CH_RET_ENOTDIR, "open not rejected");
+  }
+  test_end_step(2);
+
+  /* [1.3.3] The current directory is changed, relative paths are
+     resolved from there.*/
+  test_set_step(3);
+  {
+    ret = vfsDrvChangeCurrentDirectory(&chfs1, "/dir1/sub1");
+    test_assert(ret == CH_RET_SUCCESS, "chdir failed");
+    ret = vfsDrvGetCurrentDirectory(&chfs1, buf, sizeof buf);
+    test_assert(ret == CH_RET_SUCCESS, "getcwd failed");
+    test_assert(strcmp(buf, "/dir1/sub1") == 0, "wrong directory");
+    ret = vfs_test_check_file(&chfs1, "file1", 100U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "../sub1/./file1", 100U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfsDrvChangeCurrentDirectory(&chfs1, "..");
+    test_assert(ret == CH_RET_SUCCESS, "chdir failed");
+    ret = vfsDrvGetCurrentDirectory(&chfs1, buf, sizeof buf);
+    test_assert(strcmp(buf, "/dir1") == 0, "wrong directory");
+  }
+  test_end_step(3);
+
+  /* [1.3.4] Non-empty and busy directories cannot be removed.*/
+  test_set_step(4);
+  {
+    ret = vfsDrvRmdir(&chfs1, "/dir1/sub1");
+    test_assert(ret == CH_RET_EACCES, "rmdir not rejected");
+    ret = vfsDrvRmdir(&chfs1, "/dir1");
+    test_assert(ret == CH_RET_EACCES, "rmdir not rejected");
+    ret = vfsDrvRmdir(&chfs1, "/");
+    test_assert(ret == CH_RET_EACCES, "rmdir not rejected");
+    ret = vfsDrvUnlink(&chfs1, "/dir1/sub2");
+    test_assert(ret == CH_RET_EISDIR, "unlink not rejected");
+  }
+  test_end_step(4);
+
+  /* [1.3.5] The tree is removed.*/
+  test_set_step(5);
+  {
+    ret = vfsDrvUnlink(&chfs1, "/dir1/sub1/file1");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+    ret = vfsDrvRmdir(&chfs1, "sub1");
+    test_assert(ret == CH_RET_SUCCESS, "rmdir failed");
+    ret = vfsDrvRmdir(&chfs1, "sub2");
+    test_assert(ret == CH_RET_SUCCESS, "rmdir failed");
+    ret = vfsDrvRmdir(&chfs1, "/dir1");
+    test_assert(ret == CH_RET_EBUSY, "rmdir not rejected");
+    ret = vfsDrvChangeCurrentDirectory(&chfs1, "/");
+    test_assert(ret == CH_RET_SUCCESS, "chdir failed");
+    ret = vfsDrvRmdir(&chfs1, "/dir1");
+    test_assert(ret == CH_RET_SUCCESS, "rmdir failed");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t vfs_test_001_003 = {
+  "Directories",
+  vfs_test_001_003_setup,
+  vfs_test_001_003_teardown,
+  vfs_test_001_003_execute
+};
+
+/**
+ * @page vfs_test_001_004 [1.4] Rename and unlink
+ *
+ * <h2>Description</h2>
+ * Files and directories are renamed and moved, existing destinations
+ * are replaced.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.4.1] A file is renamed and moved to another directory.
+ * - [1.4.2] An existing file is replaced by a rename.
+ * - [1.4.3] Invalid renames are rejected.
+ * - [1.4.4] Open files cannot be unlinked.
+ * .
+ */
+
+static void vfs_test_001_004_setup(void) {
+  chfs_test_format_mount();
+}
+
+static void vfs_test_001_004_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_001_004_execute(void) {
+  vfs_stat_t st;
+  msg_t ret;
+
+  /* [1.4.1] A file is renamed and moved to another directory.*/
+  test_set_step(1);
+  {
+    ret = vfs_test_write_file(&chfs1, "/a", 500U, 64U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfsDrvMkdir(&chfs1, "/dir", 0);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsDrvRename(&chfs1, "/a", "/dir/b");
+    test_assert(ret == CH_RET_SUCCESS, "rename failed");
+    ret = vfsDrvStat(&chfs1, "/a", &st);
+    test_assert(ret == CH_RET_ENOENT, "still present");
+    ret = vfs_test_check_file(&chfs1, "/dir/b", 500U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+  }
+  test_end_step(1);
+
+  /* [1.4.2] An existing file is replaced by a rename.*/
+  test_set_step(2);
+  {
+    ret = vfs_test_write_file(&chfs1, "/c", 300U, 300U, 2U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfsDrvRename(&chfs1, "/c", "/dir/b");
+    test_assert(ret == CH_RET_SUCCESS, "rename failed");
+    ret = vfs_test_check_file(&chfs1, "/dir/b", 300U, 2U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfsDrvStat(&chfs1, "/c", &st);
+    test_assert(ret == CH_RET_ENOENT, "still present");
+  }
+  test_end_step(2);
+
+  /* [1.4.3] Invalid renames are rejected.*/
+  test_set_step(3);
+  {
+    ret = vfsDrvRename(&chfs1, "/dir", "/dir/sub");
+    test_assert(ret == CH_RET_EINVAL, "rename not rejected");
+    ret = vfsDrvRename(&chfs1, "/dir", "/dir/b");
+    test_assert(ret == CH_RET_EINVAL, "rename not rejected");
+    ret = vfsDrvMkdir(&chfs1, "/dir2", 0);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsDrvRename(&chfs1, "/dir2", "/dir/b");
+    test_assert(ret == CH_RET_ENOTDIR, "rename not rejected");
+    ret = vfsDrvRename(&chfs1, "/dir/b", "/dir2");
+    test_assert(ret == CH_RET_EISDIR, "rename not rejected");
+    ret = vfsDrvRename(&chfs1, "/missing", "/x");
+    test_assert(ret == CH_RET_ENOENT, "rename not rejected");
+  }
+  test_end_step(3);
+
+  /* [1.4.4] Open files cannot be unlinked.*/
+  test_set_step(4);
+  {
+    vfs_file_node_c *fnp;
+
+    ret = vfsDrvOpenFile(&chfs1, "/dir/b", VO_RDONLY, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    ret = vfsDrvUnlink(&chfs1, "/dir/b");
+    test_assert(ret == CH_RET_EBUSY, "unlink not rejected");
+    vfsClose((vfs_node_c *)fnp);
+    ret = vfsDrvUnlink(&chfs1, "/dir/b");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+    ret = vfsDrvStat(&chfs1, "", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.size == 0), "space not released");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t vfs_test_001_004 = {
+  "Rename and unlink",
+  vfs_test_001_004_setup,
+  vfs_test_001_004_teardown,
+  vfs_test_001_004_execute
+};
+
+/**
+ * @page vfs_test_001_005 [1.5] Persistence
+ *
+ * <h2>Description</h2>
+ * The volume content is verified after a clean unmount and after an
+ * unclean shutdown, in the latter case the log is replayed on mount.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.5.1] Files and directories are created then the volume is
+ *   unmounted and mounted again, the content is verified.
+ * - [1.5.2] More changes are made then the volume state is discarded
+ *   without unmounting, the log is replayed on mount.
+ * .
+ */
+
+static void vfs_test_001_005_setup(void) {
+  chfs_test_format_mount();
+}
+
+static void vfs_test_001_005_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_001_005_execute(void) {
+  msg_t ret;
+
+  /* [1.5.1] Files and directories are created then the volume is
+     unmounted and mounted again, the content is verified.*/
+  test_set_step(1);
+  {
+    ret = vfsDrvMkdir(&chfs1, "/dir", 0);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfs_test_write_file(&chfs1, "/dir/file1", 5000U, 13U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfs_test_write_file(&chfs1, "/file2", 20000U, 2000U, 2U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = chfsdrvUnmount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "unmount failed");
+    ret = chfsdrvMount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "mount failed");
+    ret = vfs_test_check_file(&chfs1, "/dir/file1", 5000U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/file2", 20000U, 2U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+  }
+  test_end_step(1);
+
+  /* [1.5.2] More changes are made then the volume state is discarded
+     without unmounting, the log is replayed on mount.*/
+  test_set_step(2);
+  {
+    ret = vfs_test_write_file(&chfs1, "/dir/file1", 7000U, 700U, 3U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfsDrvUnlink(&chfs1, "/file2");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+    ret = vfsDrvRename(&chfs1, "/dir", "/dir2");
+    test_assert(ret == CH_RET_SUCCESS, "rename failed");
+
+    /* Unclean shutdown, the RAM state is lost.*/
+    chfsdrvObjectInit(&chfs1, &chfscfg1);
+    ret = chfsdrvMount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "mount failed");
+    ret = vfs_test_check_file(&chfs1, "/dir2/file1", 7000U, 3U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/file2", 0U, 0U);
+    test_assert(ret == CH_RET_ENOENT, "still present");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t vfs_test_001_005 = {
+  "Persistence",
+  vfs_test_001_005_setup,
+  vfs_test_001_005_teardown,
+  vfs_test_001_005_execute
+};
+
+/**
+ * @page vfs_test_001_006 [1.6] Space reclaiming
+ *
+ * <h2>Description</h2>
+ * Files are rewritten many times, the total amount of written data
+ * largely exceeds the volume size, the cleaner must reclaim the space
+ * of the obsolete data.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.6.1] Two files are rewritten for many cycles, a third file is
+ *   never modified.
+ * - [1.6.2] The files content is verified.
+ * - [1.6.3] The volume is discarded without unmounting and mounted
+ *   again, the files content is verified.
+ * .
+ */
+
+static void vfs_test_001_006_setup(void) {
+  chfs_test_format_mount();
+}
+
+static void vfs_test_001_006_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_001_006_execute(void) {
+  unsigned i;
+  msg_t ret;
+
+  /* [1.6.1] Two files are rewritten for many cycles, a third file is
+     never modified.*/
+  test_set_step(1);
+  {
+    ret = vfs_test_write_file(&chfs1, "/static", 30000U, 1000U, 7U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    for (i = 0U; i < 100U; i++) {
+      ret = vfs_test_write_file(&chfs1, "/hot1", 8000U, 100U, i);
+      test_assert(ret == CH_RET_SUCCESS, "write failed");
+      ret = vfs_test_write_file(&chfs1, "/hot2", 5000U, 1000U, i + 1U);
+      test_assert(ret == CH_RET_SUCCESS, "write failed");
+    }
+  }
+  test_end_step(1);
+
+  /* [1.6.2] The files content is verified.*/
+  test_set_step(2);
+  {
+    ret = vfs_test_check_file(&chfs1, "/static", 30000U, 7U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/hot1", 8000U, 99U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/hot2", 5000U, 100U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+  }
+  test_end_step(2);
+
+  /* [1.6.3] The volume is discarded without unmounting and mounted
+     again, the files content is verified.*/
+  test_set_step(3);
+  {
+    chfsdrvObjectInit(&chfs1, &chfscfg1);
+    ret = chfsdrvMount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "mount failed");
+    ret = vfs_test_check_file(&chfs1, "/static", 30000U, 7U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/hot1", 8000U, 99U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/hot2", 5000U, 100U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t vfs_test_001_006 = {
+  "Space reclaiming",
+  vfs_test_001_006_setup,
+  vfs_test_001_006_teardown,
+  vfs_test_001_006_execute
+};
+
+/**
+ * @page vfs_test_001_007 [1.7] Program failures
+ *
+ * <h2>Description</h2>
+ * Flash program operations fail in the middle of the log, the records
+ * written after the failures must survive an unclean shutdown.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.7.1] A file is written then the creation of a second file fails
+ *   while programming its inode record.
+ * - [1.7.2] A file is created then writing its data fails, the data
+ *   record is torn.
+ * - [1.7.3] Another file is written after the failures then the volume
+ *   is discarded without unmounting and mounted again, the records
+ *   written before and after the failures are replayed.
+ * - [1.7.4] A file is rewritten until a periodic checkpoint is written,
+ *   then the next checkpoint is torn while programming its header on
+ *   unmount. The volume is mounted again from the previous checkpoint in
+ *   the same slot and the log is replayed.
+ * .
+ */
+
+static void vfs_test_001_007_setup(void) {
+  chfs_test_faultcfg = chfscfg1;
+  chfs_test_faultcfg.flp = &chfs_test_flash;
+  chfs_test_program_fail = 0U;
+  chfsdrvObjectInit(&chfs1, &chfs_test_faultcfg);
+  (void) chfsdrvUnmount(&chfs1);
+  (void) chfsdrvFormat(&chfs1);
+  (void) chfsdrvMount(&chfs1);
+}
+
+static void vfs_test_001_007_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+  chfs_test_program_fail = 0U;
+}
+
+static void vfs_test_001_007_execute(void) {
+  vfs_file_node_c *fnp;
+  uint32_t gen;
+  unsigned i;
+  msg_t ret;
+
+  /* [1.7.1] A file is written then the creation of a second file fails
+     while programming its inode record.*/
+  test_set_step(1);
+  {
+    ret = vfs_test_write_file(&chfs1, "/file1", 3000U, 300U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    chfs_test_program_fail = 1U;
+    ret = vfsDrvOpenFile(&chfs1, "/file2", VO_CREAT | VO_WRONLY, &fnp);
+    test_assert(ret == CH_RET_EIO, "failure not reported");
+  }
+  test_end_step(1);
+
+  /* [1.7.2] A file is created then writing its data fails, the data
+     record is torn.*/
+  test_set_step(2);
+  {
+    ret = vfsDrvOpenFile(&chfs1, "/file3", VO_CREAT | VO_WRONLY, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    vfs_test_fill(vfs_test_buffer, 1000U, 3U);
+    chfs_test_program_fail = 2U;
+    (void) vfsFileWrite(fnp, vfs_test_buffer, 1000U);
+    vfsClose((vfs_node_c *)fnp);
+    test_assert(chfs_test_program_fail == 0U, "failure not injected");
+  }
+  test_end_step(2);
+
+  /* [1.7.3] Another file is written after the failures then the volume
+     is discarded without unmounting and mounted again, the records
+     written before and after the failures are replayed.*/
+  test_set_step(3);
+  {
+    ret = vfs_test_write_file(&chfs1, "/file4", 1000U, 100U, 4U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+
+    /* Unclean shutdown, the RAM state is lost.*/
+    chfsdrvObjectInit(&chfs1, &chfs_test_faultcfg);
+    ret = chfsdrvMount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "mount failed");
+    ret = vfs_test_check_file(&chfs1, "/file1", 3000U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/file2", 0U, 0U);
+    test_assert(ret == CH_RET_ENOENT, "torn inode replayed");
+    ret = vfs_test_check_file(&chfs1, "/file3", 0U, 0U);
+    test_assert(ret == CH_RET_SUCCESS, "torn data replayed");
+    ret = vfs_test_check_file(&chfs1, "/file4", 1000U, 4U);
+    test_assert(ret == CH_RET_SUCCESS, "records after the failures lost");
+  }
+  test_end_step(3);
+
+  /* [1.7.4] A file is rewritten until a periodic checkpoint is written, then
+     the next checkpoint is torn while programming its header on unmount.
+     The volume is mounted again from the previous checkpoint in the same
+     slot and the log is replayed.*/
+  test_set_step(4);
+  {
+    ret = vfs_test_write_file(&chfs1, "/file5", 4000U, 400U, 0U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    gen = chfs1.cpgen;
+    for (i = 1U; (chfs1.cpgen == gen) && (i < 100U); i++) {
+      ret = vfs_test_write_file(&chfs1, "/file5", 4000U, 400U, i);
+      test_assert(ret == CH_RET_SUCCESS, "write failed");
+    }
+    test_assert(chfs1.cpgen != gen, "no checkpoint");
+    ret = vfs_test_write_file(&chfs1, "/file5", 4000U, 400U, 5U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+
+    /* The fourth program is the checkpoint header.*/
+    chfs_test_program_fail = 4U;
+    ret = chfsdrvUnmount(&chfs1);
+    test_assert(ret == CH_RET_EIO, "failure not reported");
+    test_assert(chfs_test_program_fail == 0U, "failure not injected");
+
+    chfsdrvObjectInit(&chfs1, &chfs_test_faultcfg);
+    ret = chfsdrvMount(&chfs1);
+    test_assert(ret == CH_RET_SUCCESS, "mount failed");
+    ret = vfs_test_check_file(&chfs1, "/file1", 3000U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/file4", 1000U, 4U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    ret = vfs_test_check_file(&chfs1, "/file5", 4000U, 5U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t vfs_test_001_007 = {
+  "Program failures",
+  vfs_test_001_007_setup,
+  vfs_test_001_007_teardown,
+  vfs_test_001_007_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const vfs_test_sequence_001_array[] = {
+  &vfs_test_001_001,
+  &vfs_test_001_002,
+  &vfs_test_001_003,
+  &vfs_test_001_004,
+  &vfs_test_001_005,
+  &vfs_test_001_006,
+  &vfs_test_001_007,
+  NULL
+};
+
+/**
+ * @brief   ChibiFS functionality.
+ */
+const testsequence_t vfs_test_sequence_001 = {
+  "ChibiFS functionality",
+  vfs_test_sequence_001_array
+};
+
+#endif /* VFS_CFG_ENABLE_DRV_CHFS == TRUE */
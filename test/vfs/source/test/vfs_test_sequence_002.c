@@ -0,0 +1,352 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "vfs_test_root.h"
+
+/**
+ * @file    vfs_test_sequence_002.c
+ * @brief   Test Sequence 002 code.
+ *
+ * @page vfs_test_sequence_002 [2] Benchmarks
+ *
+ * File: @ref vfs_test_sequence_002.c
+ *
+ * <h2>Description</h2>
+ * This sequence measures the performance of the flash file systems, the
+ * ChibiFS and LittleFS drivers are measured on the same flash device
+ * when both are enabled.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage vfs_test_002_001
+ * - @subpage vfs_test_002_002
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+#include "vfs.h"
+
+#define BMK_FILE_SIZE       16384U
+
+static systime_t bmk_wait_tick(void) {
+
+  osalThreadSleep(1);
+  return osalOsGetSystemTimeX();
+}
+
+static void bmk_print(uint32_t n, const char *unit) {
+
+  test_print("--- Score : ");
+  test_printn(n);
+  test_println(unit);
+}
+
+static void bmk_write(void *drvp, size_t chunk, const char *unit) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  start = bmk_wait_tick();
+  end = osalTimeAddX(start, TIME_MS2I(1000));
+  do {
+    msg_t ret;
+
+    ret = vfs_test_write_file(drvp, "/bmk", BMK_FILE_SIZE, chunk, n);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    n++;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+
+  bmk_print(n * BMK_FILE_SIZE, unit);
+}
+
+static void bmk_read(void *drvp) {
+  systime_t start, end;
+  uint32_t n = 0U;
+  msg_t ret;
+
+  ret = vfs_test_write_file(drvp, "/bmk", BMK_FILE_SIZE, 1024U, 0U);
+  test_assert(ret == CH_RET_SUCCESS, "write failed");
+
+  start = bmk_wait_tick();
+  end = osalTimeAddX(start, TIME_MS2I(1000));
+  do {
+    vfs_file_node_c *fnp;
+    ssize_t nr;
+
+    ret = vfsDrvOpenFile(drvp, "/bmk", VO_RDONLY, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    do {
+      nr = vfsFileRead(fnp, vfs_test_buffer, 512U);
+      n += (uint32_t)nr;
+    } while (nr > 0);
+    vfsClose((vfs_node_c *)fnp);
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+
+  bmk_print(n, " bytes/S (read)");
+}
+
+static void bmk_files(void *drvp) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  start = bmk_wait_tick();
+  end = osalTimeAddX(start, TIME_MS2I(1000));
+  do {
+    msg_t ret;
+
+    ret = vfs_test_write_file(drvp, "/small", 32U, 32U, n);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfsDrvUnlink(drvp, "/small");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+    n++;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+
+  bmk_print(n, " files/S");
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+#if (VFS_CFG_ENABLE_DRV_CHFS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page vfs_test_002_001 [2.1] ChibiFS throughput
+ *
+ * <h2>Description</h2>
+ * The ChibiFS sequential write and read throughput, the small files
+ * creation rate and the mount rate are measured, each measure lasts one
+ * second.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - VFS_CFG_ENABLE_DRV_CHFS == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [2.1.1] Sequential write throughput using 64 bytes writes.
+ * - [2.1.2] Sequential write throughput using 1024 bytes writes.
+ * - [2.1.3] Sequential read throughput.
+ * - [2.1.4] Small files creation and deletion rate.
+ * - [2.1.5] Mount rate.
+ * .
+ */
+
+static void vfs_test_002_001_setup(void) {
+  chfsdrvObjectInit(&chfs1, &chfscfg1);
+  (void) chfsdrvFormat(&chfs1);
+  (void) chfsdrvMount(&chfs1);
+}
+
+static void vfs_test_002_001_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_002_001_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+
+  /* [2.1.1] Sequential write throughput using 64 bytes writes.*/
+  test_set_step(1);
+  {
+    bmk_write(&chfs1, 64U, " bytes/S (write 64)");
+  }
+  test_end_step(1);
+
+  /* [2.1.2] Sequential write throughput using 1024 bytes writes.*/
+  test_set_step(2);
+  {
+    bmk_write(&chfs1, 1024U, " bytes/S (write 1024)");
+  }
+  test_end_step(2);
+
+  /* [2.1.3] Sequential read throughput.*/
+  test_set_step(3);
+  {
+    bmk_read(&chfs1);
+  }
+  test_end_step(3);
+
+  /* [2.1.4] Small files creation and deletion rate.*/
+  test_set_step(4);
+  {
+    bmk_files(&chfs1);
+  }
+  test_end_step(4);
+
+  /* [2.1.5] Mount rate.*/
+  test_set_step(5);
+  {
+    n = 0U;
+    start = bmk_wait_tick();
+    end = osalTimeAddX(start, TIME_MS2I(1000));
+    do {
+      msg_t ret;
+
+      (void) chfsdrvUnmount(&chfs1);
+      ret = chfsdrvMount(&chfs1);
+      test_assert(ret == CH_RET_SUCCESS, "mount failed");
+      n++;
+    #if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+    #endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    bmk_print(n, " mounts/S");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t vfs_test_002_001 = {
+  "ChibiFS throughput",
+  vfs_test_002_001_setup,
+  vfs_test_002_001_teardown,
+  vfs_test_002_001_execute
+};
+#endif /* VFS_CFG_ENABLE_DRV_CHFS == TRUE */
+
+#if (VFS_CFG_ENABLE_DRV_LITTLEFS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page vfs_test_002_002 [2.2] LittleFS throughput
+ *
+ * <h2>Description</h2>
+ * The LittleFS sequential write and read throughput, the small files
+ * creation rate and the mount rate are measured, each measure lasts one
+ * second.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - VFS_CFG_ENABLE_DRV_LITTLEFS == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [2.2.1] Sequential write throughput using 64 bytes writes.
+ * - [2.2.2] Sequential write throughput using 1024 bytes writes.
+ * - [2.2.3] Sequential read throughput.
+ * - [2.2.4] Small files creation and deletion rate.
+ * - [2.2.5] Mount rate.
+ * .
+ */
+
+static void vfs_test_002_002_setup(void) {
+  lfsdrvObjectInit(&lfs1, &lfscfg1);
+  (void) lfsdrvUnmount(&lfs1);
+  (void) lfsdrvFormat(&lfs1);
+  (void) lfsdrvMount(&lfs1);
+}
+
+static void vfs_test_002_002_teardown(void) {
+  (void) lfsdrvUnmount(&lfs1);
+}
+
+static void vfs_test_002_002_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+
+  /* [2.2.1] Sequential write throughput using 64 bytes writes.*/
+  test_set_step(1);
+  {
+    bmk_write(&lfs1, 64U, " bytes/S (write 64)");
+  }
+  test_end_step(1);
+
+  /* [2.2.2] Sequential write throughput using 1024 bytes writes.*/
+  test_set_step(2);
+  {
+    bmk_write(&lfs1, 1024U, " bytes/S (write 1024)");
+  }
+  test_end_step(2);
+
+  /* [2.2.3] Sequential read throughput.*/
+  test_set_step(3);
+  {
+    bmk_read(&lfs1);
+  }
+  test_end_step(3);
+
+  /* [2.2.4] Small files creation and deletion rate.*/
+  test_set_step(4);
+  {
+    bmk_files(&lfs1);
+  }
+  test_end_step(4);
+
+  /* [2.2.5] Mount rate.*/
+  test_set_step(5);
+  {
+    n = 0U;
+    start = bmk_wait_tick();
+    end = osalTimeAddX(start, TIME_MS2I(1000));
+    do {
+      msg_t ret;
+
+      (void) lfsdrvUnmount(&lfs1);
+      ret = lfsdrvMount(&lfs1);
+      test_assert(ret == CH_RET_SUCCESS, "mount failed");
+      n++;
+    #if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+    #endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    bmk_print(n, " mounts/S");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t vfs_test_002_002 = {
+  "LittleFS throughput",
+  vfs_test_002_002_setup,
+  vfs_test_002_002_teardown,
+  vfs_test_002_002_execute
+};
+#endif /* VFS_CFG_ENABLE_DRV_LITTLEFS == TRUE */
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const vfs_test_sequence_002_array[] = {
+#if (VFS_CFG_ENABLE_DRV_CHFS == TRUE) || defined(__DOXYGEN__)
+  &vfs_test_002_001,
+#endif
+#if (VFS_CFG_ENABLE_DRV_LITTLEFS == TRUE) || defined(__DOXYGEN__)
+  &vfs_test_002_002,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t vfs_test_sequence_002 = {
+  "Benchmarks",
+  vfs_test_sequence_002_array
+};
@@ -0,0 +1,419 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "vfs_test_root.h"
+
+/**
+ * @file    vfs_test_sequence_003.c
+ * @brief   Test Sequence 003 code.
+ *
+ * @page vfs_test_sequence_003 [3] Overlay path lookup cache
+ *
+ * File: @ref vfs_test_sequence_003.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the path lookup cache of the overlay driver.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (VFS_CFG_ENABLE_DRV_CHFS == TRUE) && (VFS_CFG_ENABLE_DRV_OVERLAY == TRUE) && (DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0)
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage vfs_test_003_001
+ * - @subpage vfs_test_003_002
+ * - @subpage vfs_test_003_003
+ * .
+ */
+
+#if ((VFS_CFG_ENABLE_DRV_CHFS == TRUE) && (VFS_CFG_ENABLE_DRV_OVERLAY == TRUE) && (DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0)) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "vfs.h"
+
+static vfs_overlay_driver_c ovl1;
+
+static void ovl_test_setup(vfs_driver_c *overlaid) {
+
+  chfsdrvObjectInit(&chfs1, &chfscfg1);
+  (void) chfsdrvUnmount(&chfs1);
+  (void) chfsdrvFormat(&chfs1);
+  (void) chfsdrvMount(&chfs1);
+  ovldrvObjectInit(&ovl1, overlaid, NULL);
+}
+
+static uint32_t ovl_test_hits(void) {
+  vfs_overlay_dcache_stats_t stats;
+
+  ovldrvCacheGetStats(&ovl1, &stats);
+
+  return stats.hits;
+}
+
+static uint32_t ovl_test_misses(void) {
+  vfs_overlay_dcache_stats_t stats;
+
+  ovldrvCacheGetStats(&ovl1, &stats);
+
+  return stats.misses;
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page vfs_test_003_001 [3.1] Lookups through a registered driver
+ *
+ * <h2>Description</h2>
+ * The ChibiFS driver is registered in the overlay, repeated lookups are
+ * served by the cache and the namespace operations performed through
+ * the overlay invalidate the cached results.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.1.1] A missing file is looked up twice, the second lookup is
+ *   served by the cache.
+ * - [3.1.2] The file is created through the overlay, the negative entry
+ *   is invalidated, the information of regular files is asked again to
+ *   the driver and the lookup is not a hit.
+ * - [3.1.3] The file is opened for reading, the cached driver is used.
+ * - [3.1.4] The file is rewritten through the overlay while its
+ *   information is cached, the new size is seen as soon as the file is
+ *   closed.
+ * - [3.1.5] The file is unlinked and a directory is created and renamed
+ *   through the overlay, lookups return the updated state.
+ * .
+ */
+
+static void vfs_test_003_001_setup(void) {
+  ovl_test_setup(NULL);
+  (void) ovldrvRegisterDriver(&ovl1, (vfs_driver_c *)&chfs1, "flash");
+}
+
+static void vfs_test_003_001_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_003_001_execute(void) {
+  vfs_directory_node_c *dnp;
+  vfs_file_node_c *fnp;
+  vfs_stat_t st;
+  uint32_t hits, misses;
+  msg_t ret;
+
+  /* [3.1.1] A missing file is looked up twice, the second lookup is
+     served by the cache.*/
+  test_set_step(1);
+  {
+    hits = ovl_test_hits();
+    ret = vfsDrvStat(&ovl1, "/flash/file", &st);
+    test_assert(ret == CH_RET_ENOENT, "wrong result");
+    test_assert(ovl_test_hits() == hits, "unexpected hit");
+    ret = vfsDrvStat(&ovl1, "flash/./file", &st);
+    test_assert(ret == CH_RET_ENOENT, "wrong result");
+    test_assert(ovl_test_hits() == hits + 1U, "no hit");
+    ret = vfsDrvOpenDirectory(&ovl1, "/flash/file", &dnp);
+    test_assert(ret == CH_RET_ENOENT, "wrong result");
+    test_assert(ovl_test_hits() == hits + 2U, "no hit");
+  }
+  test_end_step(1);
+
+  /* [3.1.2] The file is created through the overlay, the negative entry
+     is invalidated, the information of regular files is asked again to
+     the driver and the lookup is not a hit.*/
+  test_set_step(2);
+  {
+    ret = vfs_test_write_file(&ovl1, "/flash/file", 100U, 100U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfsDrvStat(&ovl1, "/flash/file", &st);
+    test_assert(ret == CH_RET_SUCCESS, "wrong result");
+    test_assert(st.size == 100, "wrong size");
+    hits = ovl_test_hits();
+    misses = ovl_test_misses();
+    ret = vfsDrvStat(&ovl1, "/flash/file", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.size == 100), "wrong result");
+    test_assert((ovl_test_hits() == hits) && (ovl_test_misses() == misses + 1U),
+                "counted as hit");
+  }
+  test_end_step(2);
+
+  /* [3.1.3] The file is opened for reading, the cached driver is
+     used.*/
+  test_set_step(3);
+  {
+    ret = vfs_test_check_file(&ovl1, "/flash/file", 100U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "check failed");
+    test_assert(ovl_test_hits() == hits + 1U, "no hit");
+  }
+  test_end_step(3);
+
+  /* [3.1.4] The file is rewritten through the overlay while its
+     information is cached, the new size is seen as soon as the file is
+     closed.*/
+  test_set_step(4);
+  {
+    ret = vfsDrvOpenFile(&ovl1, "/flash/file", VO_WRONLY, &fnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    ret = vfsDrvStat(&ovl1, "/flash/file", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.size == 100), "wrong result");
+    test_assert(vfsFileWrite(fnp, vfs_test_buffer, 150U) == 150, "write failed");
+    vfsClose((vfs_node_c *)fnp);
+    hits = ovl_test_hits();
+    misses = ovl_test_misses();
+    ret = vfsDrvStat(&ovl1, "/flash/file", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.size == 150), "stale size");
+    test_assert((ovl_test_hits() == hits) && (ovl_test_misses() == misses + 1U),
+                "counted as hit");
+  }
+  test_end_step(4);
+
+  /* [3.1.5] The file is unlinked and a directory is created and renamed
+     through the overlay, lookups return the updated state.*/
+  test_set_step(5);
+  {
+    ret = vfsDrvUnlink(&ovl1, "/flash/file");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+    ret = vfsDrvStat(&ovl1, "/flash/file", &st);
+    test_assert(ret == CH_RET_ENOENT, "stale entry");
+    ret = vfsDrvStat(&ovl1, "/flash/dir1", &st);
+    test_assert(ret == CH_RET_ENOENT, "wrong result");
+    ret = vfsDrvMkdir(&ovl1, "/flash/dir1", 0);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsDrvStat(&ovl1, "/flash/dir1", &st);
+    test_assert((ret == CH_RET_SUCCESS) && ((st.mode & VFS_MODE_S_IFDIR) != 0), "stale entry");
+    ret = vfsDrvRename(&ovl1, "/flash/dir1", "/flash/dir2");
+    test_assert(ret == CH_RET_SUCCESS, "rename failed");
+    ret = vfsDrvStat(&ovl1, "/flash/dir1", &st);
+    test_assert(ret == CH_RET_ENOENT, "stale entry");
+    ret = vfsDrvStat(&ovl1, "/flash/dir2", &st);
+    test_assert(ret == CH_RET_SUCCESS, "wrong result");
+    ret = vfsDrvRmdir(&ovl1, "/flash/dir2");
+    test_assert(ret == CH_RET_SUCCESS, "rmdir failed");
+    ret = vfsDrvStat(&ovl1, "/flash/dir2", &st);
+    test_assert(ret == CH_RET_ENOENT, "stale entry");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t vfs_test_003_001 = {
+  "Lookups through a registered driver",
+  vfs_test_003_001_setup,
+  vfs_test_003_001_teardown,
+  vfs_test_003_001_execute
+};
+
+/**
+ * @page vfs_test_003_002 [3.2] Lookups through the overlaid driver
+ *
+ * <h2>Description</h2>
+ * The ChibiFS driver is overlaid, namespace changes performed bypassing
+ * the overlay are visible after a cache flush or after the entries
+ * lifetime, file sizes are always current.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.2.1] A directory is looked up then created directly on the
+ *   overlaid driver, the cached result is stale until the cache is
+ *   flushed.
+ * - [3.2.2] The directory is removed directly on the overlaid driver,
+ *   the cached information expires.
+ * - [3.2.3] A file is looked up then modified directly on the overlaid
+ *   driver, the current size is returned.
+ * - [3.2.4] The hit rate is reported.
+ * .
+ */
+
+static void vfs_test_003_002_setup(void) {
+  ovl_test_setup((vfs_driver_c *)&chfs1);
+}
+
+static void vfs_test_003_002_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_003_002_execute(void) {
+  vfs_stat_t st;
+  vfs_overlay_dcache_stats_t stats;
+  msg_t ret;
+
+  /* [3.2.1] A directory is looked up then created directly on the
+     overlaid driver, the cached result is stale until the cache is
+     flushed.*/
+  test_set_step(1);
+  {
+    ret = vfsDrvStat(&ovl1, "/dir", &st);
+    test_assert(ret == CH_RET_ENOENT, "wrong result");
+    ret = vfsDrvMkdir(&chfs1, "/dir", 0);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsDrvStat(&ovl1, "/dir", &st);
+    test_assert(ret == CH_RET_ENOENT, "not cached");
+    ovldrvCacheFlush(&ovl1);
+    ret = vfsDrvStat(&ovl1, "/dir", &st);
+    test_assert((ret == CH_RET_SUCCESS) && VFS_MODE_S_ISDIR(st.mode), "stale entry");
+  }
+  test_end_step(1);
+
+  /* [3.2.2] The directory is removed directly on the overlaid driver,
+     the cached information expires.*/
+  test_set_step(2);
+  {
+    ret = vfsDrvRmdir(&chfs1, "/dir");
+    test_assert(ret == CH_RET_SUCCESS, "rmdir failed");
+    chThdSleepMilliseconds(DRV_CFG_OVERLAY_DCACHE_TIMEOUT + 10);
+    ret = vfsDrvStat(&ovl1, "/dir", &st);
+    test_assert(ret == CH_RET_ENOENT, "stale entry");
+  }
+  test_end_step(2);
+
+  /* [3.2.3] A file is looked up then modified directly on the overlaid
+     driver, the current size is returned.*/
+  test_set_step(3);
+  {
+    ret = vfs_test_write_file(&ovl1, "/file", 100U, 100U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfsDrvStat(&ovl1, "/file", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.size == 100), "wrong result");
+    ret = vfs_test_write_file(&chfs1, "/file", 200U, 200U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfsDrvStat(&ovl1, "/file", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.size == 200), "stale size");
+  }
+  test_end_step(3);
+
+  /* [3.2.4] The hit rate is reported.*/
+  test_set_step(4);
+  {
+    ovldrvCacheGetStats(&ovl1, &stats);
+    test_print("--- Hits: ");
+    test_printn(stats.hits);
+    test_print(", misses: ");
+    test_printn(stats.misses);
+    test_print(", invalidations: ");
+    test_printn(stats.invalidations);
+    test_println("");
+    test_assert((stats.hits > 0U) && (stats.misses > 0U) &&
+                (stats.invalidations > 0U), "wrong statistics");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t vfs_test_003_002 = {
+  "Lookups through the overlaid driver",
+  vfs_test_003_002_setup,
+  vfs_test_003_002_teardown,
+  vfs_test_003_002_execute
+};
+
+/**
+ * @page vfs_test_003_003 [3.3] Serial numbers
+ *
+ * <h2>Description</h2>
+ * The ChibiFS driver is both overlaid and registered in the overlay, the
+ * root directory lists a mount point and a file with distinct serial
+ * numbers, the same numbers are returned when the entries are examined.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.3.1] A file is created in the overlaid root directory, the root
+ *   directory is listed.
+ * - [3.3.2] The entries are examined, the serial numbers are the same
+ *   of the directory entries.
+ * .
+ */
+
+static void vfs_test_003_003_setup(void) {
+  ovl_test_setup((vfs_driver_c *)&chfs1);
+  (void) ovldrvRegisterDriver(&ovl1, (vfs_driver_c *)&chfs1, "flash");
+}
+
+static void vfs_test_003_003_teardown(void) {
+  (void) chfsdrvUnmount(&chfs1);
+}
+
+static void vfs_test_003_003_execute(void) {
+  vfs_directory_node_c *dnp;
+  vfs_direntry_info_t dia[4];
+  vfs_stat_t st;
+  msg_t ret;
+
+  /* [3.3.1] A file is created in the overlaid root directory, the root
+     directory is listed.*/
+  test_set_step(1);
+  {
+    ret = vfs_test_write_file(&chfs1, "/file", 100U, 100U, 1U);
+    test_assert(ret == CH_RET_SUCCESS, "write failed");
+    ret = vfsDrvOpenDirectory(&ovl1, "/", &dnp);
+    test_assert(ret == CH_RET_SUCCESS, "open failed");
+    ret = vfsReadDirectoryMany(dnp, dia, 4U);
+    vfsClose((vfs_node_c *)dnp);
+    test_assert(ret == (msg_t)2, "wrong entries count");
+    test_assert((strcmp(dia[0].name, "flash") == 0) &&
+                (strcmp(dia[1].name, "file") == 0), "unexpected entries");
+    test_assert((dia[0].ino != 0U) && (dia[1].ino != 0U) &&
+                (dia[0].ino != dia[1].ino), "wrong serial numbers");
+  }
+  test_end_step(1);
+
+  /* [3.3.2] The entries are examined, the serial numbers are the same
+     of the directory entries.*/
+  test_set_step(2);
+  {
+    ret = vfsDrvStat(&ovl1, "/flash", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.ino == dia[0].ino),
+                "wrong serial number");
+    ret = vfsDrvStat(&ovl1, "/file", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.ino == dia[1].ino),
+                "wrong serial number");
+    ret = vfsDrvStat(&ovl1, "/flash/file", &st);
+    test_assert((ret == CH_RET_SUCCESS) && (st.ino == dia[1].ino),
+                "wrong serial number");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t vfs_test_003_003 = {
+  "Serial numbers",
+  vfs_test_003_003_setup,
+  vfs_test_003_003_teardown,
+  vfs_test_003_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const vfs_test_sequence_003_array[] = {
+  &vfs_test_003_001,
+  &vfs_test_003_002,
+  &vfs_test_003_003,
+  NULL
+};
+
+/**
+ * @brief   Overlay path lookup cache.
+ */
+const testsequence_t vfs_test_sequence_003 = {
+  "Overlay path lookup cache",
+  vfs_test_sequence_003_array
+};
+
+#endif /* (VFS_CFG_ENABLE_DRV_CHFS == TRUE) && (VFS_CFG_ENABLE_DRV_OVERLAY == TRUE) && (DRV_CFG_OVERLAY_DCACHE_ENTRIES > 0) */
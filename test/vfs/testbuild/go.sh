@@ -0,0 +1,59 @@
+#!/bin/bash
+export XOPT XDEFS
+
+XOPT="-ggdb -O2 -fomit-frame-pointer -DTEST_DELAY_BETWEEN_TESTS=0"
+XDEFS=""
+
+function clean() {
+  echo -n "  * Cleaning..."
+  make clean > /dev/null
+  rm -f flash.bin
+  echo "OK"
+}
+
+function compile() {
+  echo -n "  * Building..."
+  if ! make $3 > buildlog.txt
+  then
+    echo "failed"
+    clean
+    exit
+  fi
+  mv -f buildlog.txt ./reports/${1}_build.txt
+  echo "OK"
+}
+
+function execute_test() {
+  echo -n "  * Testing..."
+  if ! ./build/ch > testlog.txt
+  then
+    echo "failed"
+    clean
+    exit
+  fi
+  grep -e "--- Score" testlog.txt
+  mv -f testlog.txt ./reports/${1}_test.txt
+  echo "OK"
+}
+
+function test() {
+  msg=$1": "$2" "$3
+  XDEFS=$2
+  echo $msg
+  compile $1 "$2" "$3"
+  execute_test $1
+  clean
+}
+
+mkdir reports 2> /dev/null
+
+test chfs "" ""
+test chfs_cache8 "-DDRV_CFG_CHFS_CACHE_BUFFERS_NUM=8" ""
+if [ -d ../../../ext/littlefs ]
+then
+  test chfs_littlefs "" "USE_LITTLEFS=yes"
+fi
+
+rm *log.txt 2> /dev/null
+echo
+echo "Done"
@@ -0,0 +1,112 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdlib.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "vfs.h"
+#include "vfs_test_root.h"
+#include "console.h"
+
+#if VFS_CFG_ENABLE_DRV_LITTLEFS == TRUE
+#include "lfs.h"
+#include "lfs_hal.h"
+#endif
+
+/*
+ * File-backed flash, the image survives across runs.
+ */
+static const EFlashConfig eflcfg1 = {
+  .filename         = "flash.bin"
+};
+
+/*
+ * ChibiFS volume on the first half of the flash array.
+ */
+const chfs_config_t chfscfg1 = {
+  .flp              = (BaseFlash *)&EFLD1,
+  .base             = 0U,
+  .sectors          = SIM_EFL_SECTORS_COUNT / 2U
+};
+
+#if VFS_CFG_ENABLE_DRV_LITTLEFS == TRUE
+/*
+ * LittleFS volume on the second half of the flash array.
+ */
+static uint8_t lfs_read_buffer[16];
+static uint8_t lfs_prog_buffer[16];
+static uint8_t lfs_lookahead_buffer[16];
+
+static const hal_lfs_binding_t binding1 = {
+  .base             = SIM_EFL_SECTORS_COUNT / 2U,
+  .flp              = (BaseFlash *)&EFLD1
+};
+
+const struct lfs_config lfscfg1 = {
+  .context          = (void *)&binding1,
+  .read             = __lfs_read,
+  .prog             = __lfs_prog,
+  .erase            = __lfs_erase,
+  .sync             = __lfs_sync,
+  .lock             = __lfs_lock,
+  .unlock           = __lfs_unlock,
+  .read_size        = 16,
+  .prog_size        = 16,
+  .block_size       = SIM_EFL_SECTOR_SIZE,
+  .block_count      = SIM_EFL_SECTORS_COUNT / 2U,
+  .block_cycles     = 500,
+  .cache_size       = 16,
+  .lookahead_size   = 16,
+  .read_buffer      = lfs_read_buffer,
+  .prog_buffer      = lfs_prog_buffer,
+  .lookahead_buffer = lfs_lookahead_buffer,
+  .name_max         = 0,
+  .file_max         = 0,
+  .attr_max         = 0,
+  .metadata_max     = 0
+};
+#endif
+
+/*
+ * Simulator main.
+ */
+int main(int argc, char *argv[]) {
+
+  (void)argc;
+  (void)argv;
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   * - VFS initialization.
+   */
+  halInit();
+  conInit();
+  chSysInit();
+  vfsInit();
+
+  eflStart(&EFLD1, &eflcfg1);
+
+  test_execute((BaseSequentialStream *)&CD1, &vfs_test_suite);
+  if (chtest.global_fail)
+    exit(1);
+  else
+    exit(0);
+}
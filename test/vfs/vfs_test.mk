@@ -0,0 +1,8 @@
+# List of all the ChibiOS/VFS test files.
+TESTSRC += ${CHIBIOS}/test/vfs/source/test/vfs_test_root.c \
+           ${CHIBIOS}/test/vfs/source/test/vfs_test_sequence_001.c \
+           ${CHIBIOS}/test/vfs/source/test/vfs_test_sequence_002.c \
+           ${CHIBIOS}/test/vfs/source/test/vfs_test_sequence_003.c
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/vfs/source/test
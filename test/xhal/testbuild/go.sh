@@ -0,0 +1,55 @@
+#!/bin/bash
+export XOPT XDEFS
+
+XOPT="-ggdb -O2 -fomit-frame-pointer"
+XDEFS=""
+
+function clean() {
+  echo -n "  * Cleaning..."
+  make clean > /dev/null
+  echo "OK"
+}
+
+function compile() {
+  echo -n "  * Building..."
+  if ! make > buildlog.txt
+  then
+    echo "failed"
+    clean
+    exit 1
+  fi
+  mv -f buildlog.txt ./reports/${1}_build.txt
+  echo "OK"
+}
+
+function execute_test() {
+  echo -n "  * Testing..."
+  if ! timeout 60 ./build/ch > testlog.txt
+  then
+    echo "failed"
+    grep -e "^FAILED" testlog.txt
+    clean
+    exit 1
+  fi
+  grep -e "^--- Result" testlog.txt
+  mv -f testlog.txt ./reports/${1}_test.txt
+  echo "OK"
+}
+
+function test() {
+  msg=$1": "$2
+  XDEFS=$2
+  echo $msg
+  compile $1
+  execute_test $1
+  clean
+}
+
+mkdir reports 2> /dev/null
+
+test bbsio ""
+test bbsio_checks "-DCH_DBG_ENABLE_ASSERTS=TRUE -DCH_DBG_ENABLE_CHECKS=TRUE"
+
+rm *log.txt 2> /dev/null
+echo
+echo "Done"
@@ -0,0 +1,330 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+
+/*
+ * Block-buffered SIO geometry, two blocks of 16 bytes in each direction.
+ */
+#define BLOCK_SIZE              16U
+#define BLOCKS_NUM              2U
+
+/*
+ * Maximum time for a transfer on the simulated lines.
+ */
+#define TRANSFER_TIMEOUT        TIME_MS2I(200)
+
+static uint8_t ib[BQ_BUFFER_SIZE(BLOCKS_NUM, BLOCK_SIZE)];
+static uint8_t ob[BQ_BUFFER_SIZE(BLOCKS_NUM, BLOCK_SIZE)];
+static hal_block_buffered_sio_c bbsio;
+static event_listener_t el;
+
+static uint8_t txbuf[64];
+static uint8_t rxbuf[64];
+
+/*
+ * Byte queues accessed through spans.
+ */
+#define QUEUE_SIZE              16U
+
+static uint8_t qbuf[QUEUE_SIZE];
+static input_queue_t iq;
+static output_queue_t oq;
+
+static bool failed;
+
+/*
+ * Checks an operation result.
+ */
+static void check(bool condition, const char *msg) {
+
+  if (!condition) {
+    printf("FAILED: %s\n", msg);
+    failed = true;
+  }
+}
+
+/*
+ * Fills a buffer with a pattern.
+ */
+static void fill(uint8_t *p, size_t n, uint8_t seed) {
+
+  while (n-- > 0U) {
+    *p++ = seed++;
+  }
+}
+
+/*
+ * Collects frames from the simulated TX line until the specified number of
+ * frames has been received or the timeout expires.
+ */
+static size_t collect(uint8_t *p, size_t n) {
+  systime_t start = chVTGetSystemTimeX();
+  size_t done = 0U;
+
+  while (done < n) {
+    done += sim_sio_collect(&SIOD1, p + done, n - done);
+    if (chVTTimeElapsedSinceX(start) >= TRANSFER_TIMEOUT) {
+      break;
+    }
+    chThdSleepMilliseconds(1);
+  }
+
+  return done;
+}
+
+/*
+ * A full block is posted as soon as it is filled, the remaining frames
+ * are posted on the RX idle condition.
+ */
+static void test_full_block_rx(void) {
+  msg_t msg;
+
+  printf("--- Full block RX\n");
+
+  fill(txbuf, 20U, 0x10U);
+  check(sim_sio_inject(&SIOD1, txbuf, 20U) == 20U, "inject");
+
+  msg = ibqGetFullBufferTimeout(&bbsio.ibqueue, TRANSFER_TIMEOUT);
+  check(msg == MSG_OK, "no full block");
+  if (msg == MSG_OK) {
+    check((size_t)(bbsio.ibqueue.top - bbsio.ibqueue.ptr) == BLOCK_SIZE,
+          "wrong full block size");
+    check(memcmp(bbsio.ibqueue.ptr, txbuf, BLOCK_SIZE) == 0,
+          "wrong full block data");
+    ibqReleaseEmptyBuffer(&bbsio.ibqueue);
+  }
+
+  msg = ibqGetFullBufferTimeout(&bbsio.ibqueue, TRANSFER_TIMEOUT);
+  check(msg == MSG_OK, "no trailing block");
+  if (msg == MSG_OK) {
+    check((size_t)(bbsio.ibqueue.top - bbsio.ibqueue.ptr) == 4U,
+          "wrong trailing block size");
+    check(memcmp(bbsio.ibqueue.ptr, txbuf + BLOCK_SIZE, 4U) == 0,
+          "wrong trailing block data");
+    ibqReleaseEmptyBuffer(&bbsio.ibqueue);
+  }
+
+  check((chEvtGetAndClearFlags(&el) & CHN_FL_RX_NOTEMPTY) != 0U,
+        "no RX not empty flag");
+}
+
+/*
+ * A partially filled block is made available to readers on the RX idle
+ * condition.
+ */
+static void test_rx_idle(void) {
+
+  printf("--- RX idle partial block\n");
+
+  fill(txbuf, 5U, 0x20U);
+  check(sim_sio_inject(&SIOD1, txbuf, 5U) == 5U, "inject");
+
+  check(chnReadTimeout(&bbsio.chn, rxbuf, 5U, TRANSFER_TIMEOUT) == 5U,
+        "partial block not posted");
+  check(memcmp(rxbuf, txbuf, 5U) == 0, "wrong partial block data");
+  check((chEvtGetAndClearFlags(&el) & CHN_FL_RX_IDLE) != 0U,
+        "no RX idle flag");
+}
+
+/*
+ * A partially filled TX block is sent without waiting for more data, a
+ * transfer larger than the whole output queue is sent in blocks.
+ */
+static void test_tx_flush(void) {
+
+  printf("--- Partial block TX flush\n");
+
+  fill(txbuf, 5U, 0x30U);
+  check(chnWriteTimeout(&bbsio.chn, txbuf, 5U, TRANSFER_TIMEOUT) == 5U,
+        "write");
+  check(collect(rxbuf, 5U) == 5U, "partial block not flushed");
+  check(memcmp(rxbuf, txbuf, 5U) == 0, "wrong partial block data");
+
+  fill(txbuf, 40U, 0x40U);
+  check(chnWriteTimeout(&bbsio.chn, txbuf, 40U, TRANSFER_TIMEOUT) == 40U,
+        "write");
+  check(collect(rxbuf, 40U) == 40U, "blocks not sent");
+  check(memcmp(rxbuf, txbuf, 40U) == 0, "wrong blocks data");
+  (void) chEvtGetAndClearFlags(&el);
+}
+
+/*
+ * Frames arriving when no free RX block is available are discarded and
+ * the buffer full error is flagged, reception restarts when blocks are
+ * freed.
+ */
+static void test_rx_drop(void) {
+
+  printf("--- RX buffer full drop\n");
+
+  fill(txbuf, 48U, 0x50U);
+  check(sim_sio_inject(&SIOD1, txbuf, 48U) == 48U, "inject");
+  chThdSleep(TRANSFER_TIMEOUT);
+
+  check((chEvtGetAndClearFlags(&el) & CHN_FL_BUFFER_FULL_ERR) != 0U,
+        "no buffer full flag");
+  check(chnReadTimeout(&bbsio.chn, rxbuf, 48U, TRANSFER_TIMEOUT) ==
+        BLOCKS_NUM * BLOCK_SIZE, "wrong amount of data kept");
+  check(memcmp(rxbuf, txbuf, BLOCKS_NUM * BLOCK_SIZE) == 0,
+        "wrong data kept");
+
+  fill(txbuf, 5U, 0x60U);
+  check(sim_sio_inject(&SIOD1, txbuf, 5U) == 5U, "inject");
+  check(chnReadTimeout(&bbsio.chn, rxbuf, 5U, TRANSFER_TIMEOUT) == 5U,
+        "no reception after drop");
+  check(memcmp(rxbuf, txbuf, 5U) == 0, "wrong data after drop");
+  (void) chEvtGetAndClearFlags(&el);
+}
+
+/*
+ * The byte queues are filled and drained through spans across the buffer
+ * end, the spans stop at the buffer end and the input queue data after
+ * the span is reached using iqPeekI().
+ */
+static void test_queue_spans(void) {
+  uint8_t *bp;
+  size_t n;
+
+  printf("--- Queue spans\n");
+
+  /* Input queue, the read and write positions are moved to 10.*/
+  iqObjectInit(&iq, qbuf, QUEUE_SIZE, NULL, NULL);
+  chSysLock();
+  bp = iqGetEmptySpanI(&iq, &n);
+  iqPostFullSpanI(&iq, 10U);
+  chSysUnlock();
+  check((bp == qbuf) && (n == QUEUE_SIZE), "wrong input empty span");
+  iqReleaseEmptySpan(&iq, 10U);
+
+  /* Filled across the buffer end.*/
+  chSysLock();
+  bp = iqGetEmptySpanI(&iq, &n);
+  chSysUnlock();
+  check((bp == &qbuf[10]) && (n == 6U), "wrong input empty span");
+  fill(bp, n, 0U);
+  chSysLock();
+  iqPostFullSpanI(&iq, n);
+  bp = iqGetEmptySpanI(&iq, &n);
+  chSysUnlock();
+  check((bp == qbuf) && (n == 10U), "wrong input wrapped empty span");
+  fill(bp, 4U, 6U);
+  chSysLock();
+  iqPostFullSpanI(&iq, 4U);
+  chSysUnlock();
+
+  /* Drained across the buffer end.*/
+  check((iqGetFullSpanTimeout(&iq, &bp, &n, TIME_IMMEDIATE) == MSG_OK) &&
+        (bp == &qbuf[10]) && (n == 6U) && (bp[0] == 0U),
+        "wrong input full span");
+  chSysLock();
+  check((iqPeekI(&iq, 5U) == 5) && (iqPeekI(&iq, 6U) == 6) &&
+        (iqPeekI(&iq, 9U) == 9) && (iqPeekI(&iq, 10U) == MSG_TIMEOUT),
+        "wrong peeked data");
+  iqReleaseEmptySpanI(&iq, 7U);
+  chSysUnlock();
+  check((iqGetFullSpanTimeout(&iq, &bp, &n, TIME_IMMEDIATE) == MSG_OK) &&
+        (bp == &qbuf[1]) && (n == 3U) && (bp[0] == 7U),
+        "wrong input wrapped full span");
+  iqReleaseEmptySpan(&iq, n);
+  check(iqGetFullSpanTimeout(&iq, &bp, &n, TIME_IMMEDIATE) == MSG_TIMEOUT,
+        "input full span on empty queue");
+
+  /* Output queue, the read and write positions are moved to 10.*/
+  oqObjectInit(&oq, qbuf, QUEUE_SIZE, NULL, NULL);
+  check((oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK) &&
+        (bp == qbuf) && (n == QUEUE_SIZE), "wrong output empty span");
+  oqPostFullSpan(&oq, 10U);
+  chSysLock();
+  oqReleaseEmptySpanI(&oq, 10U);
+  chSysUnlock();
+
+  /* Filled across the buffer end.*/
+  check((oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK) &&
+        (bp == &qbuf[10]) && (n == 6U), "wrong output empty span");
+  fill(bp, n, 0U);
+  chSysLock();
+  oqPostFullSpanI(&oq, n);
+  chSysUnlock();
+  check((oqGetEmptySpanTimeout(&oq, &bp, &n, TIME_IMMEDIATE) == MSG_OK) &&
+        (bp == qbuf) && (n == 10U), "wrong output wrapped empty span");
+  fill(bp, 4U, 6U);
+  oqPostFullSpan(&oq, 4U);
+
+  /* Drained across the buffer end.*/
+  chSysLock();
+  bp = oqGetFullSpanI(&oq, &n);
+  chSysUnlock();
+  check((bp == &qbuf[10]) && (n == 6U) && (bp[0] == 0U),
+        "wrong output full span");
+  chSysLock();
+  oqReleaseEmptySpanI(&oq, n);
+  bp = oqGetFullSpanI(&oq, &n);
+  chSysUnlock();
+  check((bp == qbuf) && (n == 4U) && (bp[3] == 9U),
+        "wrong output wrapped full span");
+  chSysLock();
+  oqReleaseEmptySpanI(&oq, n);
+  bp = oqGetFullSpanI(&oq, &n);
+  chSysUnlock();
+  check((bp == NULL) && (n == 0U), "output full span on empty queue");
+}
+
+/*
+ * Simulator main.
+ */
+int main(int argc, char *argv[]) {
+
+  (void)argc;
+  (void)argv;
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  chSysInit();
+
+  bbsioObjectInit(&bbsio, &SIOD1, ib, BLOCK_SIZE, BLOCKS_NUM,
+                  ob, BLOCK_SIZE, BLOCKS_NUM);
+  chEvtRegisterMaskWithFlags(&bbsio.event, &el, EVENT_MASK(0),
+                             CHN_FL_BUFFER_FULL_ERR | CHN_FL_RX_NOTEMPTY |
+                             CHN_FL_RX_IDLE);
+  check(drvStart(&bbsio) == HAL_RET_SUCCESS, "start");
+
+  test_full_block_rx();
+  test_rx_idle();
+  test_tx_flush();
+  test_rx_drop();
+
+  drvStop(&bbsio);
+
+  test_queue_spans();
+
+  printf("--- Result: %s\n", failed ? "FAILURE" : "SUCCESS");
+  if (failed)
+    exit(1);
+  else
+    exit(0);
+}
@@ -0,0 +1,641 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/hal_sio_lld.c
+ * @brief   XHAL simulator SIO subsystem low level driver source.
+ *
+ * @addtogroup SIO
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_SIO == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   RX-related interrupt sources.
+ */
+#define SIM_SIO_RX_SOURCES      (SIO_EV_RX_NOTEMPTY | SIO_EV_RX_IDLE)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated SIO driver identifier.
+ */
+hal_sio_driver_c SIOD1;
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Driver default configuration.
+ */
+static const hal_sio_config_t default_config = {
+  .baud = SIO_DEFAULT_BITRATE
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static void fifo_reset(sim_sio_fifo_t *fp, size_t size) {
+
+  fp->size  = size;
+  fp->rdidx = 0U;
+  fp->n     = 0U;
+}
+
+static bool fifo_put(sim_sio_fifo_t *fp, uint8_t b) {
+
+  if (fp->n >= fp->size) {
+    return false;
+  }
+  fp->buf[(fp->rdidx + fp->n) % fp->size] = b;
+  fp->n++;
+
+  return true;
+}
+
+static uint8_t fifo_get(sim_sio_fifo_t *fp) {
+  uint8_t b;
+
+  b = fp->buf[fp->rdidx];
+  fp->rdidx = (fp->rdidx + 1U) % fp->size;
+  fp->n--;
+
+  return b;
+}
+
+/**
+ * @brief   Simulates the passing of one frame time on both lines.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ */
+static void sim_sio_frame_time(hal_sio_driver_c *siop) {
+
+  /* Transmitter, the TX end condition is reached when the last frame
+     leaves the TX FIFO.*/
+  if (siop->txfifo.n > 0U) {
+    (void) fifo_put(&siop->txline, fifo_get(&siop->txfifo));
+    if (siop->txfifo.n == 0U) {
+      siop->status |= SIO_EV_TX_END;
+    }
+  }
+
+  /* Receiver, frames are held on the line while the RX FIFO is full, the
+     idle condition is reached one frame time after the last frame.*/
+  if (siop->rxline.n > 0U) {
+    if (siop->rxfifo.n < siop->rxfifo.size) {
+      (void) fifo_put(&siop->rxfifo, fifo_get(&siop->rxline));
+      siop->rxactive = true;
+    }
+  }
+  else if (siop->rxactive) {
+    siop->rxactive = false;
+    siop->status |= SIO_EV_RX_IDLE;
+  }
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated SIO interrupt check.
+ * @details Advances the simulated lines by one frame time then serves the
+ *          interrupt if an enabled source is pending.
+ *
+ * @return              The interrupt state.
+ * @retval false        if no interrupt has been served.
+ * @retval true         if an interrupt has been served.
+ *
+ * @notapi
+ */
+bool sio_lld_interrupt_pending(void) {
+  hal_sio_driver_c *siop = &SIOD1;
+
+  if (siop->state != HAL_DRV_STATE_READY) {
+    return false;
+  }
+
+  sim_sio_frame_time(siop);
+  if ((sio_lld_get_events(siop) & siop->ie) == (sioevents_t)0) {
+    return false;
+  }
+
+  OSAL_IRQ_PROLOGUE();
+
+  sio_lld_serve_interrupt(siop);
+
+  OSAL_IRQ_EPILOGUE();
+
+  return true;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level SIO driver initialization.
+ *
+ * @notapi
+ */
+void sio_lld_init(void) {
+
+  /* Driver instances initialization.*/
+  sioObjectInit(&SIOD1);
+}
+
+/**
+ * @brief   Configures and activates the SIO peripheral.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+msg_t sio_lld_start(hal_sio_driver_c *siop) {
+
+  osalDbgAssert(&SIOD1 == siop, "invalid SIO instance");
+
+  /* Simulated peripheral reset.*/
+  siop->ie       = (sioevents_t)0;
+  siop->status   = (sioevents_t)0;
+  siop->rxactive = false;
+  fifo_reset(&siop->rxfifo, SIM_SIO_FIFO_SIZE);
+  fifo_reset(&siop->txfifo, SIM_SIO_FIFO_SIZE);
+  fifo_reset(&siop->rxline, SIM_SIO_LINE_SIZE);
+  fifo_reset(&siop->txline, SIM_SIO_LINE_SIZE);
+
+  /* Configures the peripheral.*/
+  siop->config = sio_lld_setcfg(siop, &default_config);
+
+  return HAL_RET_SUCCESS;
+}
+
+/**
+ * @brief   Deactivates the SIO peripheral.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ *
+ * @notapi
+ */
+void sio_lld_stop(hal_sio_driver_c *siop) {
+
+  siop->ie = (sioevents_t)0;
+}
+
+/**
+ * @brief   SIO configuration.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @param[in] config    pointer to the @p hal_sio_config_t structure
+ * @return              A pointer to the current configuration structure.
+ *
+ * @notapi
+ */
+const hal_sio_config_t *sio_lld_setcfg(hal_sio_driver_c *siop,
+                                       const hal_sio_config_t *config) {
+
+  (void)siop;
+
+  if (config == NULL) {
+    config = &default_config;
+  }
+
+  return config;
+}
+
+/**
+ * @brief   Selects one of the pre-defined SIO configurations.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @param[in] cfgnum    driver configuration number
+ * @return              The configuration pointer.
+ *
+ * @notapi
+ */
+const hal_sio_config_t *sio_lld_selcfg(hal_sio_driver_c *siop,
+                                       unsigned cfgnum) {
+
+  if (cfgnum > 0U) {
+    return NULL;
+  }
+
+  return sio_lld_setcfg(siop, NULL);
+}
+
+/**
+ * @brief   Determines the state of the RX FIFO.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The RX FIFO state.
+ * @retval false        if RX FIFO is not empty
+ * @retval true         if RX FIFO is empty
+ *
+ * @notapi
+ */
+bool sio_lld_is_rx_empty(hal_sio_driver_c *siop) {
+
+  return (bool)(siop->rxfifo.n == 0U);
+}
+
+/**
+ * @brief   Determines the activity state of the receiver.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The RX activity state.
+ * @retval false        if RX is in active state.
+ * @retval true         if RX is in idle state.
+ *
+ * @notapi
+ */
+bool sio_lld_is_rx_idle(hal_sio_driver_c *siop) {
+
+  return (bool)(siop->rxline.n == 0U);
+}
+
+/**
+ * @brief   Determines if RX has pending error events to be read and cleared.
+ * @note    Errors are not simulated.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The RX error events.
+ * @retval false        if RX has no pending events
+ * @retval true         if RX has pending events
+ *
+ * @notapi
+ */
+bool sio_lld_has_rx_errors(hal_sio_driver_c *siop) {
+
+  (void)siop;
+
+  return false;
+}
+
+/**
+ * @brief   Determines the state of the TX FIFO.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The TX FIFO state.
+ * @retval false        if TX FIFO is not full
+ * @retval true         if TX FIFO is full
+ *
+ * @notapi
+ */
+bool sio_lld_is_tx_full(hal_sio_driver_c *siop) {
+
+  return (bool)(siop->txfifo.n >= siop->txfifo.size);
+}
+
+/**
+ * @brief   Determines the transmission state.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The TX FIFO state.
+ * @retval false        if transmission is idle
+ * @retval true         if transmission is ongoing
+ *
+ * @notapi
+ */
+bool sio_lld_is_tx_ongoing(hal_sio_driver_c *siop) {
+
+  return (bool)(siop->txfifo.n > 0U);
+}
+
+/**
+ * @brief   Enable flags change notification.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ */
+void sio_lld_update_enable_flags(hal_sio_driver_c *siop) {
+
+  siop->ie = siop->enabled;
+}
+
+/**
+ * @brief   Get and clears SIO error event flags.
+ * @note    Errors are not simulated.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The pending event flags.
+ *
+ * @notapi
+ */
+sioevents_t sio_lld_get_and_clear_errors(hal_sio_driver_c *siop) {
+
+  (void)siop;
+
+  return (sioevents_t)0;
+}
+
+/**
+ * @brief   Get and clears SIO event flags.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @param[in] events    events to be returned and cleared
+ * @return              The pending event flags.
+ *
+ * @notapi
+ */
+sioevents_t sio_lld_get_and_clear_events(hal_sio_driver_c *siop,
+                                         sioevents_t events) {
+
+  events &= sio_lld_get_events(siop);
+
+  /* Clearing captured status flags.*/
+  siop->status &= ~events;
+
+  /* Status flags cleared, now the RX-related interrupts can be enabled
+     again.*/
+  siop->ie |= siop->enabled & SIM_SIO_RX_SOURCES;
+
+  return events;
+}
+
+/**
+ * @brief   Returns the pending SIO event flags.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The pending event flags.
+ *
+ * @notapi
+ */
+sioevents_t sio_lld_get_events(hal_sio_driver_c *siop) {
+  sioevents_t events = siop->status;
+
+  if (siop->rxfifo.n > 0U) {
+    events |= SIO_EV_RX_NOTEMPTY;
+  }
+  if (siop->txfifo.n < siop->txfifo.size) {
+    events |= SIO_EV_TX_NOTFULL;
+  }
+
+  return events;
+}
+
+/**
+ * @brief   Reads data from the RX FIFO.
+ * @details The function is not blocking, it reads frames until there are
+ *          frames available without waiting.
+ *
+ * @param[in] siop          pointer to an @p hal_sio_driver_c structure
+ * @param[in] buffer        pointer to the buffer for read frames
+ * @param[in] n             maximum number of frames to be read
+ * @return                  The number of frames copied from the buffer.
+ * @retval 0                if the RX FIFO is empty.
+ */
+size_t sio_lld_read(hal_sio_driver_c *siop, uint8_t *buffer, size_t n) {
+  size_t rd;
+
+  rd = 0U;
+  while (true) {
+
+    /* If the RX FIFO has been emptied then the RX FIFO and IDLE interrupts
+       are enabled again.*/
+    if (sio_lld_is_rx_empty(siop)) {
+      siop->ie |= siop->enabled & SIM_SIO_RX_SOURCES;
+      break;
+    }
+
+    /* Buffer filled condition.*/
+    if (rd >= n) {
+      break;
+    }
+
+    *buffer++ = fifo_get(&siop->rxfifo);
+    rd++;
+  }
+
+  return rd;
+}
+
+/**
+ * @brief   Writes data into the TX FIFO.
+ * @details The function is not blocking, it writes frames until there
+ *          is space available without waiting.
+ *
+ * @param[in] siop          pointer to an @p hal_sio_driver_c structure
+ * @param[in] buffer        pointer to the buffer for read frames
+ * @param[in] n             maximum number of frames to be written
+ * @return                  The number of frames copied from the buffer.
+ * @retval 0                if the TX FIFO is full.
+ */
+size_t sio_lld_write(hal_sio_driver_c *siop, const uint8_t *buffer, size_t n) {
+  size_t wr;
+
+  wr = 0U;
+  while (true) {
+
+    /* If the TX FIFO has been filled then the interrupt is enabled again.*/
+    if (sio_lld_is_tx_full(siop)) {
+      siop->ie |= siop->enabled & SIO_EV_TX_NOTFULL;
+      break;
+    }
+
+    /* Buffer emptied condition.*/
+    if (wr >= n) {
+      break;
+    }
+
+    (void) fifo_put(&siop->txfifo, *buffer++);
+    wr++;
+  }
+
+  /* Writing clears the transmission end condition, the interrupt is always
+     re-enabled on write.*/
+  siop->status &= ~SIO_EV_TX_END;
+  siop->ie |= siop->enabled & SIO_EV_TX_END;
+
+  return wr;
+}
+
+/**
+ * @brief   Returns one frame from the RX FIFO.
+ * @note    If the FIFO is empty then the returned value is unpredictable.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @return              The frame from RX FIFO.
+ *
+ * @notapi
+ */
+msg_t sio_lld_get(hal_sio_driver_c *siop) {
+  msg_t msg;
+
+  msg = (msg_t)fifo_get(&siop->rxfifo);
+
+  /* If the RX FIFO has been emptied then the interrupt is enabled again.*/
+  if (sio_lld_is_rx_empty(siop)) {
+    siop->ie |= siop->enabled & SIM_SIO_RX_SOURCES;
+  }
+
+  return msg;
+}
+
+/**
+ * @brief   Pushes one frame into the TX FIFO.
+ * @note    If the FIFO is full then the behavior is unpredictable.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @param[in] data      frame to be written
+ *
+ * @notapi
+ */
+void sio_lld_put(hal_sio_driver_c *siop, uint_fast16_t data) {
+
+  (void) fifo_put(&siop->txfifo, (uint8_t)data);
+
+  /* If the TX FIFO has been filled then the interrupt is enabled again.*/
+  if (sio_lld_is_tx_full(siop)) {
+    siop->ie |= siop->enabled & SIO_EV_TX_NOTFULL;
+  }
+
+  /* Writing clears the transmission end condition, the interrupt is always
+     re-enabled on write.*/
+  siop->status &= ~SIO_EV_TX_END;
+  siop->ie |= siop->enabled & SIO_EV_TX_END;
+}
+
+/**
+ * @brief   Control operation on a serial port.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @param[in] operation control operation code
+ * @param[in,out] arg   operation argument
+ *
+ * @return              The control operation status.
+ * @retval MSG_OK       in case of success.
+ * @retval MSG_TIMEOUT  in case of operation timeout.
+ * @retval MSG_RESET    in case of operation reset.
+ *
+ * @notapi
+ */
+msg_t sio_lld_control(hal_sio_driver_c *siop, unsigned int operation, void *arg) {
+
+  (void)siop;
+  (void)operation;
+  (void)arg;
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Serves a simulated SIO interrupt.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ *
+ * @notapi
+ */
+void sio_lld_serve_interrupt(hal_sio_driver_c *siop) {
+  sioevents_t events;
+
+  osalDbgAssert(siop->state == HAL_DRV_STATE_READY, "invalid state");
+
+  /* Events to be processed, the served sources are disabled.*/
+  events = sio_lld_get_events(siop) & siop->ie;
+  siop->ie &= ~events;
+  if (events != (sioevents_t)0) {
+
+    /* Idle RX event.*/
+    if ((events & SIO_EV_RX_IDLE) != 0U) {
+
+      /* Waiting thread woken, if any.*/
+      __sio_wakeup_rxidle(siop);
+    }
+
+    /* RX FIFO is non-empty.*/
+    if ((events & SIO_EV_RX_NOTEMPTY) != 0U) {
+
+      /* Waiting thread woken, if any.*/
+      __sio_wakeup_rx(siop);
+    }
+
+    /* TX FIFO is non-full.*/
+    if ((events & SIO_EV_TX_NOTFULL) != 0U) {
+
+      /* Waiting thread woken, if any.*/
+      __sio_wakeup_tx(siop);
+    }
+
+    /* Physical transmission end.*/
+    if ((events & SIO_EV_TX_END) != 0U) {
+
+      /* Waiting thread woken, if any.*/
+      __sio_wakeup_txend(siop);
+    }
+
+    /* The callback is invoked.*/
+    __sio_callback(siop);
+  }
+  else {
+    osalDbgAssert(false, "spurious interrupt");
+  }
+}
+
+/**
+ * @brief   Puts frames on the simulated RX line.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @param[in] bp        pointer to the frames
+ * @param[in] n         number of frames
+ * @return              The number of frames accepted by the line.
+ */
+size_t sim_sio_inject(hal_sio_driver_c *siop, const uint8_t *bp, size_t n) {
+  size_t i;
+
+  osalSysLock();
+  for (i = 0U; i < n; i++) {
+    if (!fifo_put(&siop->rxline, *bp++)) {
+      break;
+    }
+  }
+  osalSysUnlock();
+
+  return i;
+}
+
+/**
+ * @brief   Takes the frames sent on the simulated TX line.
+ *
+ * @param[in] siop      pointer to the @p hal_sio_driver_c object
+ * @param[out] bp       pointer to the buffer for the frames
+ * @param[in] n         maximum number of frames
+ * @return              The number of frames taken from the line.
+ */
+size_t sim_sio_collect(hal_sio_driver_c *siop, uint8_t *bp, size_t n) {
+  size_t i;
+
+  osalSysLock();
+  for (i = 0U; (i < n) && (siop->txline.n > 0U); i++) {
+    *bp++ = fifo_get(&siop->txline);
+  }
+  osalSysUnlock();
+
+  return i;
+}
+
+#endif /* HAL_USE_SIO == TRUE */
+
+/** @} */
@@ -0,0 +1,155 @@
+/*
+    ChibiOS - Copyright (C) 2006..2025 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/hal_sio_lld.h
+ * @brief   XHAL simulator SIO subsystem low level driver header.
+ * @details The peripheral is a software model of an UART with small RX and
+ *          TX FIFOs, one frame moves on each line on each simulated
+ *          interrupt check. Interrupt sources are disabled when served and
+ *          enabled again by the FIFO accesses, like the STM32 USARTv3 LLD.
+ *
+ * @addtogroup SIO
+ * @{
+ */
+
+#ifndef HAL_SIO_LLD_H
+#define HAL_SIO_LLD_H
+
+#if (HAL_USE_SIO == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the simulated hardware FIFOs.
+ */
+#define SIM_SIO_FIFO_SIZE                   8U
+
+/**
+ * @brief   Size of the simulated RX and TX lines.
+ */
+#define SIM_SIO_LINE_SIZE                   256U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a simulated frames FIFO.
+ */
+typedef struct {
+  /**
+   * @brief   Capacity of the FIFO.
+   */
+  size_t                    size;
+  /**
+   * @brief   Index of the next frame to be removed.
+   */
+  size_t                    rdidx;
+  /**
+   * @brief   Number of frames in the FIFO.
+   */
+  size_t                    n;
+  /**
+   * @brief   Frames storage.
+   */
+  uint8_t                   buf[SIM_SIO_LINE_SIZE];
+} sim_sio_fifo_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level fields of the SIO driver structure.
+ */
+#define sio_lld_driver_fields                                               \
+  /* Interrupt sources currently enabled.*/                                 \
+  sioevents_t               ie;                                             \
+  /* Latched status flags.*/                                                \
+  sioevents_t               status;                                         \
+  /* Frames received since the last idle condition.*/                       \
+  bool                      rxactive;                                       \
+  /* Simulated hardware FIFOs.*/                                            \
+  sim_sio_fifo_t            rxfifo;                                         \
+  sim_sio_fifo_t            txfifo;                                         \
+  /* Frames on the RX line not yet received.*/                              \
+  sim_sio_fifo_t            rxline;                                         \
+  /* Frames sent on the TX line not yet collected.*/                        \
+  sim_sio_fifo_t            txline
+
+/**
+ * @brief   Low level fields of the SIO configuration structure.
+ */
+#define sio_lld_config_fields                                               \
+  /* Bit rate, not simulated.*/                                             \
+  uint32_t                  baud
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern hal_sio_driver_c SIOD1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void sio_lld_init(void);
+  msg_t  sio_lld_start(hal_sio_driver_c *siop);
+  void sio_lld_stop(hal_sio_driver_c *siop);
+  const hal_sio_config_t *sio_lld_setcfg(hal_sio_driver_c *siop,
+                                         const hal_sio_config_t *config);
+  const hal_sio_config_t *sio_lld_selcfg(hal_sio_driver_c *siop, unsigned cfgnum);
+  bool sio_lld_is_rx_empty(hal_sio_driver_c *siop);
+  bool sio_lld_is_rx_idle(hal_sio_driver_c *siop);
+  bool sio_lld_has_rx_errors(hal_sio_driver_c *siop);
+  bool sio_lld_is_tx_full(hal_sio_driver_c *siop);
+  bool sio_lld_is_tx_ongoing(hal_sio_driver_c *siop);
+  void sio_lld_update_enable_flags(hal_sio_driver_c *siop);
+  sioevents_t sio_lld_get_and_clear_errors(hal_sio_driver_c *siop);
+  sioevents_t sio_lld_get_and_clear_events(hal_sio_driver_c *siop,
+                                           sioevents_t events);
+  sioevents_t sio_lld_get_events(hal_sio_driver_c *siop);
+  size_t sio_lld_read(hal_sio_driver_c *siop, uint8_t *buffer, size_t n);
+  size_t sio_lld_write(hal_sio_driver_c *siop, const uint8_t *buffer, size_t n);
+  msg_t sio_lld_get(hal_sio_driver_c *siop);
+  void sio_lld_put(hal_sio_driver_c *siop, uint_fast16_t data);
+  msg_t sio_lld_control(hal_sio_driver_c *siop, unsigned int operation, void *arg);
+  void sio_lld_serve_interrupt(hal_sio_driver_c *siop);
+  bool sio_lld_interrupt_pending(void);
+  size_t sim_sio_inject(hal_sio_driver_c *siop, const uint8_t *bp, size_t n);
+  size_t sim_sio_collect(hal_sio_driver_c *siop, uint8_t *bp, size_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_SIO == TRUE */
+
+#endif /* HAL_SIO_LLD_H */
+
+/** @} */
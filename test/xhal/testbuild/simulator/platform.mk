@@ -0,0 +1,11 @@
+# Simulated XHAL platform, the SIO peripheral is a software UART model.
+PLATFORMSRC := $(CHIBIOS)/test/xhal/testbuild/simulator/hal_lld.c \
+               $(CHIBIOS)/test/xhal/testbuild/simulator/hal_st_lld.c \
+               $(CHIBIOS)/test/xhal/testbuild/simulator/hal_sio_lld.c
+
+# Required include directories.
+PLATFORMINC := $(CHIBIOS)/test/xhal/testbuild/simulator
+
+# Shared variables
+ALLCSRC += $(PLATFORMSRC)
+ALLINC  += $(PLATFORMINC)
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+
+"""
+Decodes a binary log stream produced by the ChibiOS deferred binary logger
+(os/various/binlog) into text.
+
+Format strings and constant string arguments are resolved from the
+application ELF file, the stream is read from a file or from the standard
+input.
+
+To get help on usage, possible options and their descriptions, use
+the following command:
+
+    binlog_decode.py --help
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+HDR_MAGIC = 0xB1
+HDR_WORDS = 3
+MAX_ARGS = 255
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+SPEC = re.compile(r'%([-]?)([+]?)(0?)(\*|[0-9]*)(?:\.(\*|[0-9]*))?([lL]?)(.)',
+                  re.DOTALL)
+
+
+class Elf:
+    """Minimal ELF reader, only allocated PROGBITS sections are loaded."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+        if data[:4] != b'\x7fELF':
+            raise ValueError('%s: not an ELF file' % path)
+        is64 = data[4] == 2
+        self.endian = '<' if data[5] == 1 else '>'
+        e = self.endian
+        if is64:
+            shoff, = struct.unpack_from(e + 'Q', data, 0x28)
+            shentsize, shnum = struct.unpack_from(e + 'HH', data, 0x3A)
+            fmt = e + 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(e + 'I', data, 0x20)
+            shentsize, shnum = struct.unpack_from(e + 'HH', data, 0x2E)
+            fmt = e + 'IIIIIIIIII'
+        self.sections = []
+        for i in range(shnum):
+            (_, sh_type, sh_flags, sh_addr, sh_offset, sh_size,
+             _, _, _, _) = struct.unpack_from(fmt, data, shoff + i * shentsize)
+            if sh_type == SHT_PROGBITS and sh_flags & SHF_ALLOC and sh_size:
+                self.sections.append(
+                    (sh_addr, data[sh_offset:sh_offset + sh_size]))
+
+    def string(self, addr):
+        for base, blob in self.sections:
+            if base <= addr < base + len(blob):
+                end = blob.find(b'\0', addr - base)
+                if end < 0:
+                    end = len(blob)
+                return blob[addr - base:end].decode('latin-1')
+        return None
+
+
+def to_signed(v):
+    return v - (1 << 32) if v & 0x80000000 else v
+
+
+def format_record(elf, fmt, args):
+    """Formats a record using chprintf() rules."""
+    args = list(args)
+    out = []
+    pos = 0
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    while True:
+        m = SPEC.search(fmt, pos)
+        if m is None:
+            out.append(fmt[pos:])
+            break
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        left, sign, zero, width, prec, _, conv = m.groups()
+        width = to_signed(next_arg()) if width == '*' else int(width or 0)
+        if prec == '*':
+            prec = to_signed(next_arg())
+        else:
+            prec = int(prec or 0)
+        c = conv.lower()
+        if c in 'di':
+            v = to_signed(next_arg())
+            s = ('-' if v < 0 else sign) + str(abs(v))
+        elif c in 'uxpo':
+            v = next_arg()
+            s = {'u': '%u', 'x': '%X', 'p': '%X', 'o': '%o'}[c] % v
+        elif conv == 'f':
+            v, = struct.unpack('<f', struct.pack('<I', next_arg()))
+            if prec <= 0 or prec > 9:
+                prec = 9
+            ip = int(abs(v))
+            fp = int((abs(v) - ip) * 10 ** prec)
+            s = ('-' if v < 0 else sign) + '%d.%0*d' % (ip, prec, fp)
+        elif conv == 'c':
+            s = chr(next_arg() & 0xFF)
+            zero = ''
+        elif conv == 's':
+            addr = next_arg()
+            s = '(null)' if addr == 0 else elf.string(addr)
+            if s is None:
+                s = '<0x%08X>' % addr
+            if prec > 0:
+                s = s[:prec]
+            zero = ''
+        else:
+            s = conv
+        pad = width - len(s)
+        if pad > 0:
+            if left:
+                s = s + ' ' * pad
+            elif zero and s[:1] in '+-':
+                s = s[0] + '0' * pad + s[1:]
+            else:
+                s = (zero or ' ') * pad + s
+        out.append(s)
+    return ''.join(out)
+
+
+def decode(elf, data, timestamps):
+    e = elf.endian
+    magic_index = 3 if e == '<' else 0
+    pos = 0
+    while pos + HDR_WORDS * 4 <= len(data):
+        if data[pos + magic_index] != HDR_MAGIC:
+            pos += 1
+            continue
+        hdr, ts, fmtaddr = struct.unpack_from(e + 'III', data, pos)
+        n = hdr & 0xFF
+        tag = (hdr >> 8) & 0xFF
+        end = pos + (HDR_WORDS + n) * 4
+        if end > len(data):
+            break
+        args = struct.unpack_from(e + '%dI' % n, data, pos + HDR_WORDS * 4)
+        if fmtaddr == 0:
+            text = '<%d records dropped>\n' % (args[0] if args else 0)
+        else:
+            fmt = elf.string(fmtaddr)
+            if fmt is None:
+                # Not a record header, resynchronizing.
+                pos += 1
+                continue
+            text = format_record(elf, fmt, args)
+        if timestamps:
+            text = '[%10u][%3u] %s' % (ts, tag, text)
+        yield text
+        pos = end
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a binary log')
+    parser.add_argument('elf', help='Application ELF file.')
+    parser.add_argument('input', nargs='?', default='-',
+                        help='Binary log file, standard input if omitted.')
+    parser.add_argument('--no-timestamps', action='store_true',
+                        help='Do not prefix time stamps and tags.')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if args.input == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.input, 'rb') as f:
+            data = f.read()
+    for text in decode(elf, data, not args.no_timestamps):
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
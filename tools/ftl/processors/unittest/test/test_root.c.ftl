@@ -28,8 +28,10 @@
 [#assign conf = {"instance":instance} /]
 [#assign prefix_lower = conf.instance.global_data_and_code.code_prefix.value[0]?trim?lower_case /]
 [#assign prefix_upper = conf.instance.global_data_and_code.code_prefix.value[0]?trim?upper_case /]
+[#-- Source files extension, ".cpp" for C++ test suites. --]
+[#assign source_ext = source_extension!".c" /]
 [@pp.dropOutputFile /]
-[@pp.changeOutputFile name=prefix_lower+"test_root.c" /]
+[@pp.changeOutputFile name=prefix_lower+"test_root"+source_ext /]
 [@utils.EmitIndentedCCode "" 2 conf.instance.description.copyright.value[0] /]
 
 /**
@@ -55,7 +57,7 @@
  */
 
 /**
- * @file    ${prefix_lower}test_root.c
+ * @file    ${prefix_lower}test_root${source_ext}
  * @brief   Test Suite root structures code.
  */
 
@@ -29,20 +29,22 @@
 [#assign conf = {"instance":instance} /]
 [#assign prefix_lower = conf.instance.global_data_and_code.code_prefix.value[0]?trim?lower_case /]
 [#assign prefix_upper = conf.instance.global_data_and_code.code_prefix.value[0]?trim?upper_case /]
+[#-- Source files extension, ".cpp" for C++ test suites. --]
+[#assign source_ext = source_extension!".c" /]
 [#list conf.instance.sequences.sequence as sequence]
-  [@pp.changeOutputFile name=prefix_lower+"test_sequence_" + (sequence_index + 1)?string("000") + ".c" /]
+  [@pp.changeOutputFile name=prefix_lower+"test_sequence_" + (sequence_index + 1)?string("000") + source_ext /]
 [@utils.EmitIndentedCCode "" 2 conf.instance.description.copyright.value[0] /]
 
 #include "hal.h"
 #include "${prefix_lower}test_root.h"
 
 /**
- * @file    ${prefix_lower}test_sequence_${(sequence_index + 1)?string("000")}.c
+ * @file    ${prefix_lower}test_sequence_${(sequence_index + 1)?string("000")}${source_ext}
  * @brief   Test Sequence ${(sequence_index + 1)?string("000")} code.
  *
  * @page ${prefix_lower}test_sequence_${(sequence_index + 1)?string("000")} [${(sequence_index + 1)?string}] ${utils.WithoutDot(sequence.brief.value[0]?string)}
  *
- * File: @ref ${prefix_lower}test_sequence_${(sequence_index + 1)?string("000")}.c
+ * File: @ref ${prefix_lower}test_sequence_${(sequence_index + 1)?string("000")}${source_ext}
  *
  * <h2>Description</h2>
 [@utils.FormatStringAsText " * "